@@ -20,6 +20,9 @@
 #include "include/debug/RayTracingDebugPanel.h"
 #include "include/debug/VirtualGeoDebugPanel.h"
 #include "include/asset/AssetBrowserWindow.h"
+#include "include/asset/AssetRegistry.h"
+#include "include/asset/AssetImporter.h"
+#include "include/component/MiStaticMeshComponent.h"
 
 
 //===================camera==================
@@ -553,6 +556,14 @@ bool VulkanRenderer::setupIBL(const std::string& hdriPath) {
 void VulkanRenderer::processPendingIBLUpdate() {
     if (!isIBLUpdatePending) return;
 
+    // Switching environments is built in the background and swapped in per frame slot
+    // (see IBLSystem::refreshFrameDescriptors), so frames keep rendering the old one meanwhile
+    if (iblSystem && iblSystem->isReady()) {
+        iblSystem->requestEnvironment(pendingIBLPath);
+        isIBLUpdatePending = false;
+        return;
+    }
+
     // Wait for device to be idle to ensure no resources are in use
     vkDeviceWaitIdle(device);
 
@@ -566,29 +577,10 @@ void VulkanRenderer::processPendingIBLUpdate() {
     if (success) {
         // Update skybox descriptor sets if they were already created
         if (!skyboxDescriptorSets.empty() && skyboxDescriptorSetLayout != VK_NULL_HANDLE) {
-            for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
-                VkDescriptorImageInfo skyboxImageInfo{};
-                skyboxImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                
-                // Make sure the environment map is valid
-                if (iblSystem->getEnvironmentMap()) {
-                    skyboxImageInfo.imageView = iblSystem->getEnvironmentMap()->getImageView();
-                    skyboxImageInfo.sampler = iblSystem->getEnvironmentMap()->getSampler();
-                } else {
-                    std::cerr << "Error: Environment map is null!" << std::endl;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT); ++i) {
+                if (!writeSkyboxDescriptorSet(i)) {
                     return;
                 }
-
-                VkWriteDescriptorSet skyboxWrite{};
-                skyboxWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                skyboxWrite.dstSet = skyboxDescriptorSets[i];
-                skyboxWrite.dstBinding = 0;
-                skyboxWrite.dstArrayElement = 0;
-                skyboxWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                skyboxWrite.descriptorCount = 1;
-                skyboxWrite.pImageInfo = &skyboxImageInfo;
-
-                vkUpdateDescriptorSets(device, 1, &skyboxWrite, 0, nullptr);
             }
         }
         
@@ -607,6 +599,151 @@ void VulkanRenderer::processPendingIBLUpdate() {
     isIBLUpdatePending = false;
 }
 
+bool VulkanRenderer::writeSkyboxDescriptorSet(uint32_t frameIndex) {
+    if (frameIndex >= skyboxDescriptorSets.size()) return false;
+
+    // Make sure the environment map is valid
+    if (!iblSystem || !iblSystem->getEnvironmentMap()) {
+        std::cerr << "Error: Environment map is null!" << std::endl;
+        return false;
+    }
+
+    VkDescriptorImageInfo skyboxImageInfo{};
+    skyboxImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    skyboxImageInfo.imageView = iblSystem->getEnvironmentMap()->getImageView();
+    skyboxImageInfo.sampler = iblSystem->getEnvironmentMap()->getSampler();
+
+    VkWriteDescriptorSet skyboxWrite{};
+    skyboxWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    skyboxWrite.dstSet = skyboxDescriptorSets[frameIndex];
+    skyboxWrite.dstBinding = 0;
+    skyboxWrite.dstArrayElement = 0;
+    skyboxWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    skyboxWrite.descriptorCount = 1;
+    skyboxWrite.pImageInfo = &skyboxImageInfo;
+
+    vkUpdateDescriptorSets(device, 1, &skyboxWrite, 0, nullptr);
+    return true;
+}
+
+void VulkanRenderer::processAssetFileChanges() {
+    auto& registry = MiEngine::AssetRegistry::getInstance();
+
+    // Bakes (FBX import, texture encode) run on the ThreadPool so a save never stalls the frame
+    for (const auto& uuid : registry.processFileChanges()) {
+        auto inFlight = std::find_if(pendingReimports.begin(), pendingReimports.end(),
+            [&uuid](const MiEngine::AssetImporter::PendingReimport& pending) { return pending.entry.uuid == uuid; });
+        if (inFlight != pendingReimports.end()) {
+            // The running bake may have read the old contents
+            inFlight->sourceChangedAgain = true;
+            continue;
+        }
+        MiEngine::AssetImporter::PendingReimport pending = MiEngine::AssetImporter::beginReimport(uuid);
+        if (pending.result.valid()) {
+            pendingReimports.push_back(std::move(pending));
+        }
+    }
+
+    std::vector<std::string> requeue;
+    bool finished = false;
+    for (auto it = pendingReimports.begin(); it != pendingReimports.end(); ) {
+        if (!it->isReady()) {
+            ++it;
+            continue;
+        }
+        MiEngine::AssetImporter::PendingReimport pending = std::move(*it);
+        it = pendingReimports.erase(it);
+        finished = true;
+
+        bool reimported = MiEngine::AssetImporter::finishReimport(pending);
+        if (pending.sourceChangedAgain) {
+            requeue.push_back(pending.entry.uuid);
+        }
+        if (reimported) {
+            reloadReimportedMesh(pending.entry);
+        }
+    }
+
+    for (const auto& uuid : requeue) {
+        MiEngine::AssetImporter::PendingReimport pending = MiEngine::AssetImporter::beginReimport(uuid);
+        if (pending.result.valid()) {
+            pendingReimports.push_back(std::move(pending));
+        }
+    }
+
+    if (finished && assetBrowser) {
+        assetBrowser->markDirty();
+    }
+}
+
+void VulkanRenderer::reloadReimportedMesh(const MiEngine::AssetEntry& entry) {
+    // Loaded meshes are keyed by interned path; a path that was never interned was never loaded
+    MiEngine::MiName path = MiEngine::MiName::find(entry.projectPath);
+    if (!meshLibrary || path.isNone()) {
+        return;
+    }
+
+    // Only meshes that are currently in use need reloading; others load fresh on next request
+    if (entry.type == MiEngine::AssetType::SkeletalMesh) {
+        // No component holds library skeletal meshes yet, so there is nothing to rebind
+        if (meshLibrary->isSkeletalMeshLoaded(path)) {
+            retireMesh(meshLibrary->getSkeletalMesh(path));
+            meshLibrary->reloadSkeletalMesh(path);
+        }
+        return;
+    }
+
+    if (!meshLibrary->isMeshLoaded(path)) {
+        return;
+    }
+
+    // reloadMesh only replaces the library entry; point existing components at the new mesh.
+    // The old one may still be drawn by frames in flight, so it is retired rather than dropped.
+    retireMesh(meshLibrary->getMesh(path));
+    std::shared_ptr<Mesh> mesh = meshLibrary->reloadMesh(path);
+    if (!mesh || !world) {
+        return;
+    }
+    for (MiEngine::MiStaticMeshComponent* component : world->getComponentsOfType<MiEngine::MiStaticMeshComponent>()) {
+        if (component->getMeshAssetPath() == entry.projectPath) {
+            if (component->getMesh() != mesh) {
+                retireMesh(component->getMesh());
+            }
+            component->setMesh(mesh);
+        }
+    }
+}
+
+void VulkanRenderer::retireMesh(std::shared_ptr<Mesh> mesh) {
+    if (!mesh) {
+        return;
+    }
+    for (const RetiredMesh& retired : retiredMeshes) {
+        if (retired.mesh == mesh) {
+            return;
+        }
+    }
+
+    // Once every slot's fence has been waited on, no command buffer recorded
+    // before the swap is still executing
+    RetiredMesh retired;
+    retired.mesh = std::move(mesh);
+    retired.pendingSlots = (1u << MAX_FRAMES_IN_FLIGHT) - 1;
+    retiredMeshes.push_back(std::move(retired));
+}
+
+void VulkanRenderer::releaseRetiredMeshes(uint32_t waitedSlot, bool force) {
+    auto it = retiredMeshes.begin();
+    while (it != retiredMeshes.end()) {
+        it->pendingSlots &= ~(1u << waitedSlot);
+        if (!force && it->pendingSlots != 0) {
+            ++it;
+            continue;
+        }
+        it = retiredMeshes.erase(it);
+    }
+}
+
 void VulkanRenderer::initializeWater(uint32_t resolution) {
     if (waterSystem) {
         std::cout << "Water system already initialized" << std::endl;
@@ -2239,9 +2376,30 @@ void VulkanRenderer::drawFrame() {
     // Process any pending IBL updates before starting the frame
     processPendingIBLUpdate();
 
+    // Swap in IBL data finished on worker threads
+    if (iblSystem) {
+        iblSystem->update();
+    }
+
+    // Reimport assets whose source files changed on disk
+    processAssetFileChanges();
+
+    // Upload meshes decoded on worker threads, release long-unused ones
+    if (meshLibrary) {
+        meshLibrary->update();
+    }
+
     // 1. Wait for this frame slot's fence to be available
     vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
 
+    // Meshes replaced by hot reloads whose last frame in flight just finished
+    releaseRetiredMeshes(currentFrame, false);
+
+    // The slot's sets are no longer in use: move them to a newly swapped-in environment
+    if (iblSystem && iblSystem->refreshFrameDescriptors(currentFrame)) {
+        writeSkyboxDescriptorSet(currentFrame);
+    }
+
     // 2. Acquire Image
     uint32_t imageIndex;
     VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX,
@@ -2711,11 +2869,12 @@ void VulkanRenderer::createDescriptorPool() {
     std::array<VkDescriptorPoolSize, 6> poolSizes{};
 
     // MVP Uniform buffer pool size & Light Uniform buffer pool size + Point Light Shadow Info + Bone Matrix UBOs
+    // + IBL irradiance SH
     uint32_t maxSkeletalInstances = 50;
     uint32_t maxVGeoDescriptorSets = 100;  // For Virtual Geometry culling, LOD, indirect draw
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     poolSizes[0].descriptorCount = static_cast<uint32_t>(
-        MAX_FRAMES_IN_FLIGHT * 5 +
+        MAX_FRAMES_IN_FLIGHT * 6 +
         maxSkeletalInstances * MAX_FRAMES_IN_FLIGHT +
         maxVGeoDescriptorSets * MAX_FRAMES_IN_FLIGHT  // Virtual Geo uniform buffers
     );
@@ -3599,6 +3758,11 @@ VkDescriptorSet VulkanRenderer::createMaterialDescriptorSet(const Material& mate
         throw std::runtime_error("Failed to allocate material descriptor set!");
     }
     
+    updateMaterialDescriptorSet(descriptorSet, material);
+    return descriptorSet;
+}
+
+void VulkanRenderer::updateMaterialDescriptorSet(VkDescriptorSet descriptorSet, const Material& material) {
     // Prepare descriptor image info array for all textures
     std::array<VkDescriptorImageInfo, 5> imageInfos{};
     
@@ -3700,8 +3864,6 @@ VkDescriptorSet VulkanRenderer::createMaterialDescriptorSet(const Material& mate
     
     // Update all descriptor sets at once
     vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
-    
-    return descriptorSet;
 }
 
 
@@ -3753,6 +3915,7 @@ void VulkanRenderer::cleanup() {
         meshLibrary->clear();
         meshLibrary.reset();
     }
+    releaseRetiredMeshes(0, true);
 
     if (scene) {
         scene.reset();
@@ -33,6 +33,7 @@
 #include "include/Renderer/WaterSystem.h"
 #include "include/Utils/SkeletalVertex.h"
 #include "include/asset/AssetBrowserWindow.h"
+#include "include/asset/AssetImporter.h"
 #include "include/asset/MeshLibrary.h"
 #include "include/core/MiWorld.h"
 #include "include/raytracing/RayTracingSystem.h"
@@ -259,6 +260,8 @@ public:
     void updateViewProjection(const glm::mat4& view, const glm::mat4& proj);
     // Create a descriptor set for a specific material
     VkDescriptorSet createMaterialDescriptorSet(const Material& material);
+    // Rewrite a material's texture bindings (e.g. after streaming replaced an image)
+    void updateMaterialDescriptorSet(VkDescriptorSet descriptorSet, const Material& material);
     
     // Helper methods for shadow system and other subsystems
     VkFormat findDepthFormat();
@@ -568,6 +571,23 @@ private:
     std::string pendingIBLPath;
     bool isIBLUpdatePending = false;
     void processPendingIBLUpdate();
+    bool writeSkyboxDescriptorSet(uint32_t frameIndex);
+
+    // Hot reload of assets changed on disk (AssetRegistry file watcher). Caches are
+    // rebaked on the ThreadPool; finished reimports reload their meshes here.
+    void processAssetFileChanges();
+    void reloadReimportedMesh(const MiEngine::AssetEntry& entry);
+    std::vector<MiEngine::AssetImporter::PendingReimport> pendingReimports;
+
+    // A mesh replaced by a hot reload, freed once every frame slot's fence has
+    // been waited on since (frames in flight may still draw its buffers)
+    struct RetiredMesh {
+        std::shared_ptr<Mesh> mesh;
+        uint32_t pendingSlots = 0;    // Bit per frame slot not waited on yet
+    };
+    std::vector<RetiredMesh> retiredMeshes;
+    void retireMesh(std::shared_ptr<Mesh> mesh);
+    void releaseRetiredMeshes(uint32_t waitedSlot, bool force);
 
 public:
     void drawFrame();
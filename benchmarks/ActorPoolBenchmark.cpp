@@ -0,0 +1,186 @@
+// Actor pool benchmark: spawn/destroy churn through MiWorld with pooled and recycled actors.
+//
+// Usage:
+//   ActorPoolBenchmark [liveCount] [churnPerFrame] [frames]    (defaults 2000, 500, 600)
+//
+// Keeps liveCount actors alive in a MiWorld (no renderer). Every frame destroys
+// the churnPerFrame oldest with MiWorld::destroyActor, spawns as many with
+// MiWorld::spawnActor<T>(), then runs MiWorld::tick, which unregisters the
+// destroyed actors and hands recyclable ones to the world's MiRecycleBin.
+// ns per spawn + destroy, the tick included:
+//   pooled    - not recyclable: every spawn makePooled's an actor and its root
+//   recycled  - recyclable: spawns reuse destroyed actors with their root still attached
+// "reused" is the spawns served by the recycle bin, "slabs" the pool slab count
+// after the run; "state ok" checks that every spawned actor has had onRecycled()
+// reset its state and has exactly one component.
+//
+// Before the passes, a respawn check spawns, destroys and respawns an actor that
+// adds its root in createDefaultComponents() the way MiStaticMeshActor does (the
+// real one needs the renderer to link). The respawn must be the same object with
+// exactly one component, and a MiWeakActorPtr to its first life must have expired.
+// Returns non-zero if any check fails.
+
+#include "core/MiActor.h"
+#include "core/MiComponent.h"
+#include "core/MiObjectPool.h"
+#include "core/MiSceneComponent.h"
+#include "core/MiWorld.h"
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+using namespace MiEngine;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+class BulletActor : public MiActor {
+    MI_OBJECT_BODY(BulletActor, 1101)
+
+public:
+    int hits = 0;
+    float lifetime = 0.0f;
+
+protected:
+    void onRecycled() override {
+        MiActor::onRecycled();
+        hits = 0;
+        lifetime = 0.0f;
+    }
+};
+
+class RecycledBulletActor : public BulletActor {
+    MI_OBJECT_BODY(RecycledBulletActor, 1102)
+
+public:
+    RecycledBulletActor() { setRecyclable(true); }
+};
+
+// Adds its root unconditionally, as MiStaticMeshActor adds its mesh component
+class MeshStandInActor : public MiActor {
+    MI_OBJECT_BODY(MeshStandInActor, 1103)
+
+public:
+    MeshStandInActor() { setRecyclable(true); }
+
+    void createDefaultComponents() override {
+        auto mesh = addComponent<MiSceneComponent>();
+        setRootComponent(mesh);
+    }
+};
+
+bool checkRespawn() {
+    MiWorld world;
+    world.initialize();
+
+    auto first = world.spawnActor<MeshStandInActor>();
+    const MiActor* firstObject = first.get();
+    MiWeakActorPtr firstLife(first);
+    world.destroyActor(first);
+    first.reset();
+    world.tick(0.0f);
+
+    auto second = world.spawnActor<MeshStandInActor>();
+    bool reused = second.get() == firstObject;
+    size_t componentCount = second->getAllComponents().size();
+    bool expired = firstLife.expired();
+
+    bool ok = reused && componentCount == 1 && expired;
+    std::cout << "Respawn: " << (reused ? "reused" : "not reused") << ", " << componentCount
+              << " component(s), first-life reference " << (expired ? "expired" : "STILL LOCKS")
+              << (ok ? "" : "  FAILED") << "\n";
+    return ok;
+}
+
+struct Result {
+    double nsPerActor = 0.0;
+    size_t spawned = 0;
+    uint64_t reused = 0;
+    bool stateOk = true;
+};
+
+template<typename T>
+Result run(size_t liveCount, size_t churnPerFrame, int frames) {
+    MiWorld world;
+    world.initialize();
+    world.getRecycleBin().setCapacity(churnPerFrame);
+
+    // Ids only, so the world holds the last reference when an actor is destroyed
+    std::deque<ObjectId> live;
+    for (size_t i = 0; i < liveCount; ++i) {
+        live.push_back(world.spawnActor<T>()->getObjectId());
+    }
+    world.tick(0.0f);
+
+    Result result;
+    uint64_t reusedBefore = world.getRecycleBin().getReuseCount();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < churnPerFrame && !live.empty(); ++i) {
+            world.destroyActor(live.front());
+            live.pop_front();
+        }
+        for (size_t i = 0; i < churnPerFrame; ++i) {
+            auto actor = world.spawnActor<T>();
+            result.stateOk = result.stateOk && actor->hits == 0 && !actor->isPendingDestroy() &&
+                             actor->getAllComponents().size() == 1;
+            actor->hits = frame + 1;
+            actor->lifetime = 1.0f;
+            live.push_back(actor->getObjectId());
+            ++result.spawned;
+        }
+        world.tick(1.0f / 60.0f);
+    }
+    result.nsPerActor = elapsedMs(start) * 1.0e6 / static_cast<double>(result.spawned);
+    result.reused = world.getRecycleBin().getReuseCount() - reusedBefore;
+    return result;
+}
+
+size_t poolSlabs() {
+    size_t slabs = 0;
+    for (const auto& stats : MiSlabPool::getAllStats()) {
+        slabs += stats.slabCount;
+    }
+    return slabs;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t liveCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000;
+    size_t churnPerFrame = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 500;
+    int frames = argc > 3 ? std::atoi(argv[3]) : 600;
+    if (liveCount == 0 || churnPerFrame == 0 || frames <= 0) {
+        std::cerr << "Usage: ActorPoolBenchmark [liveCount] [churnPerFrame] [frames]" << std::endl;
+        return 1;
+    }
+
+    bool ok = checkRespawn();
+
+    std::cout << "Live actors: " << liveCount << ", churn: " << churnPerFrame << "/frame, frames: " << frames
+              << "\n";
+    std::cout << std::right << std::setw(10) << "Mode" << std::setw(12) << "ns/actor" << std::setw(10) << "reused"
+              << std::setw(10) << "slabs" << std::setw(10) << "state ok" << "\n";
+
+    auto report = [&](const char* name, const Result& result) {
+        ok = ok && result.stateOk;
+        std::cout << std::setw(10) << name << std::fixed << std::setprecision(1) << std::setw(12)
+                  << result.nsPerActor << std::setw(10) << result.reused << std::setw(10) << poolSlabs()
+                  << std::setw(10) << (result.stateOk ? "yes" : "NO") << "\n";
+    };
+
+    report("pooled", run<BulletActor>(liveCount, churnPerFrame, frames));
+    report("recycled", run<RecycledBulletActor>(liveCount, churnPerFrame, frames));
+
+    for (const auto& stats : MiSlabPool::getAllStats()) {
+        std::cout << "  pool " << stats.name << ": " << stats.blockSize << " B blocks, peak " << stats.peakCount
+                  << ", " << stats.slabCount << " slabs, " << stats.allocationCount << " allocations\n";
+    }
+    return ok ? 0 : 1;
+}
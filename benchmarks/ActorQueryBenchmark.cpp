@@ -0,0 +1,142 @@
+// MiTypeIndexSet benchmark: per-type actor/component queries against the dynamic_pointer_cast scan.
+//
+// Usage:
+//   ActorQueryBenchmark [actorCount] [queries]    (defaults 100000, 200)
+//
+// Actors: 10% MeshActor (derives from GameActor), 40% GameActor, the rest plain
+// MiActor; each has one component, 10% of them a MeshComponent. Per query, us:
+//   scan      - the previous MiWorld::findActorsOfType: dynamic_pointer_cast over every
+//               actor into a new vector of shared_ptr
+//   index     - MiTypeIndexSet::get span, visiting every result
+// Queries: MeshActor, GameActor (so derived types count) and MeshComponent.
+// "register" is adding every actor and component to the index sets, ns per object.
+
+#include "core/MiActor.h"
+#include "core/MiComponent.h"
+#include "core/MiTypeIndex.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using namespace MiEngine;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+class GameActor : public MiActor {
+    MI_OBJECT_BODY(GameActor, 1201)
+};
+
+class MeshActor : public GameActor {
+    MI_OBJECT_BODY(MeshActor, 1202)
+};
+
+class PlainComponent : public MiComponent {
+    MI_OBJECT_BODY(PlainComponent, 1203)
+};
+
+class MeshComponent : public MiComponent {
+    MI_OBJECT_BODY(MeshComponent, 1204)
+};
+
+template<typename T, typename Base>
+size_t scan(const std::vector<std::shared_ptr<Base>>& objects) {
+    std::vector<std::shared_ptr<T>> result;
+    for (const auto& object : objects) {
+        if (auto cast = std::dynamic_pointer_cast<T>(object)) {
+            result.push_back(cast);
+        }
+    }
+    return result.size();
+}
+
+template<typename T>
+size_t visit(MiTypeIndexSet& set) {
+    size_t count = 0;
+    for (T* object : set.get<T>()) {
+        count += object != nullptr;
+    }
+    return count;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t actorCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    int queries = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (actorCount == 0 || queries <= 0) {
+        std::cerr << "Usage: ActorQueryBenchmark [actorCount] [queries]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::shared_ptr<MiActor>> actors;
+    std::vector<std::shared_ptr<MiComponent>> components;
+    actors.reserve(actorCount);
+    components.reserve(actorCount);
+    for (size_t i = 0; i < actorCount; ++i) {
+        std::shared_ptr<MiActor> actor;
+        if (i % 10 == 0) {
+            actor = std::make_shared<MeshActor>();
+        } else if (i % 10 < 5) {
+            actor = std::make_shared<GameActor>();
+        } else {
+            actor = std::make_shared<MiActor>();
+        }
+        if (i % 10 == 3) {
+            components.push_back(actor->addComponent<MeshComponent>());
+        } else {
+            components.push_back(actor->addComponent<PlainComponent>());
+        }
+        actors.push_back(actor);
+    }
+
+    // Index the queried types first so registering pays for them
+    MiTypeIndexSet actorIndex;
+    MiTypeIndexSet componentIndex;
+    actorIndex.get<MeshActor>();
+    actorIndex.get<GameActor>();
+    componentIndex.get<MeshComponent>();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < actorCount; ++i) {
+        actorIndex.add(actors[i].get());
+        componentIndex.add(components[i].get());
+    }
+    double registerNs = elapsedMs(start) * 1.0e6 / (2.0 * actorCount);
+
+    std::cout << "Actors: " << actorCount << ", queries: " << queries << ", register "
+              << std::fixed << std::setprecision(0) << registerNs << " ns/object\n";
+    std::cout << std::right << std::setw(15) << "Query" << std::setw(10) << "found" << std::setw(12) << "scan us"
+              << std::setw(12) << "index us" << std::setw(10) << "speedup" << "\n";
+
+    auto report = [queries](const char* name, auto scanQuery, auto indexQuery) {
+        size_t found = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int q = 0; q < queries; ++q) {
+            found = scanQuery();
+        }
+        double scanUs = elapsedMs(start) * 1000.0 / queries;
+
+        size_t indexed = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int q = 0; q < queries; ++q) {
+            indexed = indexQuery();
+        }
+        double indexUs = elapsedMs(start) * 1000.0 / queries;
+
+        std::cout << std::setw(15) << name << std::setw(10) << found << std::fixed << std::setprecision(1)
+                  << std::setw(12) << scanUs << std::setw(12) << indexUs << std::setw(9) << scanUs / indexUs << "x"
+                  << (found == indexed ? "" : "  MISMATCH") << "\n";
+    };
+
+    report("MeshActor", [&]() { return scan<MeshActor>(actors); }, [&]() { return visit<MeshActor>(actorIndex); });
+    report("GameActor", [&]() { return scan<GameActor>(actors); }, [&]() { return visit<GameActor>(actorIndex); });
+    report("MeshComponent", [&]() { return scan<MeshComponent>(components); },
+           [&]() { return visit<MeshComponent>(componentIndex); });
+    return 0;
+}
@@ -0,0 +1,158 @@
+// BRDFIntegrator benchmark: split-sum BRDF LUT for each IBLQuality resolution / sample count.
+//
+// Usage:
+//   BRDFLutBenchmark [maxResolution]    (default 1024)
+//
+// Passes per preset:
+//   scalar  - per-texel importance sampling with glm vectors, the loop TextureUtils used before
+//   simd    - BRDFIntegrator::integrate (shared row samples, 4 texels per SSE2 vector, ThreadPool rows)
+//   load    - BRDFIntegrator::load once the cache file exists (what every later startup pays)
+// "max err" is the largest R/G difference between scalar and simd. The scalar pass is
+// skipped above 512 (it takes minutes). The cache files go to a temporary directory
+// that is removed afterwards.
+
+#include "Renderer/BRDFIntegrator.h"
+#include "core/ThreadPool.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using MiEngine::BRDFIntegrator;
+using MiEngine::BRDFLutSettings;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+float radicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10f;
+}
+
+float geometrySchlick(float NdotX, float roughness) {
+    float k = (roughness * roughness) / 2.0f;
+    return NdotX / (NdotX * (1.0f - k) + k);
+}
+
+glm::vec3 importanceSampleGGX(glm::vec2 Xi, glm::vec3 N, float roughness) {
+    float a = roughness * roughness;
+    float phi = 2.0f * 3.14159265f * Xi.x;
+    float cosTheta = std::sqrt((1.0f - Xi.y) / (1.0f + (a * a - 1.0f) * Xi.y));
+    float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+    glm::vec3 H(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+
+    glm::vec3 up = std::abs(N.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 tangent = glm::normalize(glm::cross(up, N));
+    glm::vec3 bitangent = glm::cross(N, tangent);
+    return glm::normalize(tangent * H.x + bitangent * H.y + N * H.z);
+}
+
+// The pre-BRDFIntegrator LUT loop (R/G only)
+std::vector<float> integrateScalar(uint32_t resolution, uint32_t samples) {
+    std::vector<float> lut(static_cast<size_t>(resolution) * resolution * 4);
+    const glm::vec3 N(0.0f, 0.0f, 1.0f);
+    for (uint32_t y = 0; y < resolution; y++) {
+        for (uint32_t x = 0; x < resolution; x++) {
+            float NdotV = std::clamp(float(x) / float(resolution - 1), 0.0f, 1.0f);
+            float roughness = std::clamp(float(y) / float(resolution - 1), 0.001f, 1.0f);
+            glm::vec3 V(std::sqrt(std::max(0.0f, 1.0f - NdotV * NdotV)), 0.0f, std::max(0.001f, NdotV));
+
+            uint32_t sampleCount = roughness < 0.1f ? samples * 4 : samples;
+            float A = 0.0f;
+            float B = 0.0f;
+            for (uint32_t i = 0; i < sampleCount; ++i) {
+                glm::vec2 Xi(float(i) / float(sampleCount), radicalInverse(i));
+                glm::vec3 H = importanceSampleGGX(Xi, N, roughness);
+                glm::vec3 L = glm::normalize(2.0f * glm::dot(V, H) * H - V);
+                float NdotL = std::max(L.z, 0.0f);
+                float NdotH = std::max(H.z, 0.0f);
+                float VdotH = std::max(glm::dot(V, H), 0.0f);
+                if (NdotL > 0.0f && VdotH > 0.0f) {
+                    float G = geometrySchlick(NdotL, roughness) * geometrySchlick(std::max(V.z, 0.0f), roughness);
+                    float G_Vis = (G * VdotH) / (NdotH * std::max(NdotV, 0.001f));
+                    float Fc = std::pow(1.0f - VdotH, 5.0f);
+                    A += (1.0f - Fc) * G_Vis;
+                    B += Fc * G_Vis;
+                }
+            }
+
+            float* texel = lut.data() + (static_cast<size_t>(y) * resolution + x) * 4;
+            texel[0] = std::clamp(A / float(sampleCount), 0.0f, 1.0f);
+            texel[1] = std::clamp(B / float(sampleCount), 0.0f, 1.0f);
+        }
+    }
+    return lut;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t maxResolution = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1024;
+    if (maxResolution < 2) {
+        std::cerr << "Usage: BRDFLutBenchmark [maxResolution]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Threads: " << MiEngine::ThreadPool::getInstance().getThreadCount() + 1 << " (pool + caller)\n";
+    std::cout << std::right << std::setw(6) << "Res" << std::setw(9) << "Samples" << std::setw(11) << "scalar ms"
+              << std::setw(9) << "simd ms" << std::setw(9) << "load ms" << std::setw(10) << "max err" << "\n";
+
+    fs::path cacheDir = fs::temp_directory_path() / "miengine_brdf_lut";
+
+    // LOW, MEDIUM, HIGH, ULTRA brdfLutResolution / brdfLutSamples
+    const BRDFLutSettings presets[] = { { 256, 128 }, { 256, 256 }, { 512, 512 }, { 1024, 1024 } };
+    for (const BRDFLutSettings& settings : presets) {
+        if (settings.resolution > maxResolution) {
+            break;
+        }
+
+        double scalarMs = 0.0;
+        std::vector<float> scalar;
+        if (settings.resolution <= 512) {
+            auto start = std::chrono::high_resolution_clock::now();
+            scalar = integrateScalar(settings.resolution, settings.sampleCount);
+            scalarMs = elapsedMs(start);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<float> simd = BRDFIntegrator::integrate(settings);
+        double simdMs = elapsedMs(start);
+
+        // First call writes the cache file, the second is the steady state
+        BRDFIntegrator::load(settings, cacheDir);
+        start = std::chrono::high_resolution_clock::now();
+        BRDFIntegrator::load(settings, cacheDir);
+        double loadMs = elapsedMs(start);
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < scalar.size(); i += 4) {
+            maxError = std::max(maxError, std::fabs(scalar[i] - simd[i]));
+            maxError = std::max(maxError, std::fabs(scalar[i + 1] - simd[i + 1]));
+        }
+
+        // The integrator logs through std::cout too, so leave its format as it was
+        std::ios_base::fmtflags flags = std::cout.flags();
+        std::streamsize precision = std::cout.precision();
+        std::cout << std::setw(6) << settings.resolution << std::setw(9) << settings.sampleCount << std::fixed
+                  << std::setprecision(1) << std::setw(11) << scalarMs << std::setw(9) << simdMs << std::setw(9)
+                  << loadMs << std::scientific << std::setprecision(1) << std::setw(10) << maxError << "\n";
+        std::cout.flags(flags);
+        std::cout.precision(precision);
+    }
+
+    std::error_code ec;
+    fs::remove_all(cacheDir, ec);
+    return 0;
+}
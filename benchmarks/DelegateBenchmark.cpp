@@ -0,0 +1,238 @@
+// MiMulticastDelegate benchmark: slot delegate against the previous std::function one.
+//
+// Usage:
+//   DelegateBenchmark [broadcasts]    (default 1000000)
+//
+// Per broadcast to 8 bindings, ns and heap allocations:
+//   small     - 4 lambdas capturing a pointer, 4 member functions
+//   large     - 8 lambdas with 48-byte captures (heap-stored in both)
+// "add/remove" is binding 1000 lambdas then removing them in scattered order,
+// ns per add + remove. "reentrant" checks that a binding removing itself and
+// adding another during a broadcast behaves the same as before.
+
+#include "core/MiDelegate.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_Allocations{0};
+
+} // anonymous namespace
+
+void* operator new(size_t size) {
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+using MiEngine::DelegateHandle;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// The previous MiMulticastDelegate
+template<typename... Args>
+class LegacyDelegate {
+public:
+    using FunctionType = std::function<void(Args...)>;
+
+    DelegateHandle add(FunctionType func) {
+        DelegateHandle handle = m_NextHandle++;
+        m_Bindings.push_back({handle, std::move(func)});
+        return handle;
+    }
+
+    template<typename T>
+    DelegateHandle add(T* object, void (T::*memberFunc)(Args...)) {
+        return add([object, memberFunc](Args... args) {
+            (object->*memberFunc)(std::forward<Args>(args)...);
+        });
+    }
+
+    bool remove(DelegateHandle handle) {
+        auto it = std::find_if(m_Bindings.begin(), m_Bindings.end(),
+            [handle](const Binding& b) { return b.handle == handle; });
+        if (it != m_Bindings.end()) {
+            m_Bindings.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    size_t getBindingCount() const { return m_Bindings.size(); }
+
+    void broadcast(Args... args) const {
+        auto bindingsCopy = m_Bindings;
+        for (const auto& binding : bindingsCopy) {
+            if (binding.function) {
+                binding.function(args...);
+            }
+        }
+    }
+
+private:
+    struct Binding {
+        DelegateHandle handle;
+        FunctionType function;
+    };
+
+    std::vector<Binding> m_Bindings;
+    DelegateHandle m_NextHandle = 1;
+};
+
+struct Listener {
+    float sum = 0.0f;
+    void onMoved(float value) { sum += value; }
+};
+
+struct LargeCapture {
+    float weights[12];
+};
+
+struct Result {
+    double ns = 0.0;
+    double allocations = 0.0;
+    float checksum = 0.0f;
+};
+
+template<typename Delegate>
+Result runSmall(int broadcasts) {
+    Delegate delegate;
+    Listener listeners[4];
+    float total = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        delegate.add([&total](float value) { total += value; });
+        delegate.add(&listeners[i], &Listener::onMoved);
+    }
+
+    uint64_t allocations = g_Allocations.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < broadcasts; ++i) {
+        delegate.broadcast(1.0f);
+    }
+    Result result;
+    result.ns = elapsedMs(start) * 1.0e6 / broadcasts;
+    result.allocations = static_cast<double>(g_Allocations.load() - allocations) / broadcasts;
+    result.checksum = total + listeners[0].sum + listeners[3].sum;
+    return result;
+}
+
+template<typename Delegate>
+Result runLarge(int broadcasts) {
+    Delegate delegate;
+    float total = 0.0f;
+    for (int i = 0; i < 8; ++i) {
+        LargeCapture capture{};
+        capture.weights[i] = 1.0f;
+        delegate.add([capture, &total](float value) { total += capture.weights[0] * value; });
+    }
+
+    uint64_t allocations = g_Allocations.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < broadcasts; ++i) {
+        delegate.broadcast(1.0f);
+    }
+    Result result;
+    result.ns = elapsedMs(start) * 1.0e6 / broadcasts;
+    result.allocations = static_cast<double>(g_Allocations.load() - allocations) / broadcasts;
+    result.checksum = total;
+    return result;
+}
+
+template<typename Delegate>
+double runAddRemove(int rounds) {
+    constexpr int BINDINGS = 1000;
+    Delegate delegate;
+    std::vector<DelegateHandle> handles(BINDINGS);
+    float total = 0.0f;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (int i = 0; i < BINDINGS; ++i) {
+            handles[i] = delegate.add([&total](float value) { total += value; });
+        }
+        // Scattered order, so the previous linear search pays for its position
+        for (int i = 0; i < BINDINGS; ++i) {
+            delegate.remove(handles[(i * 7919) % BINDINGS]);
+        }
+    }
+    return elapsedMs(start) * 1.0e6 / (static_cast<double>(rounds) * BINDINGS);
+}
+
+// A binding that removes itself and adds another: the removed one and the
+// added one are each called once over two broadcasts
+template<typename Delegate>
+bool checkReentrant() {
+    Delegate delegate;
+    int selfCalls = 0;
+    int addedCalls = 0;
+    DelegateHandle self = 0;
+    self = delegate.add([&](float) {
+        ++selfCalls;
+        delegate.remove(self);
+        delegate.add([&addedCalls](float) { ++addedCalls; });
+    });
+    delegate.broadcast(0.0f);
+    delegate.broadcast(0.0f);
+    return selfCalls == 1 && addedCalls == 1 && delegate.getBindingCount() == 1;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    int broadcasts = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    if (broadcasts <= 0) {
+        std::cerr << "Usage: DelegateBenchmark [broadcasts]" << std::endl;
+        return 1;
+    }
+
+    using Legacy = LegacyDelegate<float>;
+    using Slots = MiEngine::MiMulticastDelegate<float>;
+
+    std::cout << "Broadcasts: " << broadcasts << " to 8 bindings (ns and allocations per broadcast)\n";
+    std::cout << std::right << std::setw(10) << "Bindings" << std::setw(12) << "previous" << std::setw(8)
+              << "allocs" << std::setw(10) << "slots" << std::setw(8) << "allocs" << std::setw(10) << "speedup"
+              << "\n";
+
+    bool ok = true;
+    auto report = [&](const char* name, Result legacy, Result slots) {
+        ok = ok && legacy.checksum == slots.checksum;
+        std::cout << std::setw(10) << name << std::fixed << std::setprecision(1) << std::setw(12) << legacy.ns
+                  << std::setw(8) << legacy.allocations << std::setw(10) << slots.ns << std::setw(8)
+                  << slots.allocations << std::setw(9) << legacy.ns / slots.ns << "x"
+                  << (legacy.checksum == slots.checksum ? "" : "  MISMATCH") << "\n";
+    };
+    report("small", runSmall<Legacy>(broadcasts), runSmall<Slots>(broadcasts));
+    report("large", runLarge<Legacy>(broadcasts), runLarge<Slots>(broadcasts));
+
+    int rounds = std::max(1, broadcasts / 10000);
+    double legacyAddRemove = runAddRemove<Legacy>(rounds);
+    double slotsAddRemove = runAddRemove<Slots>(rounds);
+    std::cout << "add/remove (1000 bindings): previous " << legacyAddRemove << " ns, slots " << slotsAddRemove
+              << " ns\n";
+
+    bool reentrant = checkReentrant<Legacy>() && checkReentrant<Slots>();
+    std::cout << "reentrant: " << (reentrant ? "ok" : "FAILED") << "\n";
+    return ok && reentrant ? 0 : 1;
+}
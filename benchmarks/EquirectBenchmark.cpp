@@ -0,0 +1,161 @@
+// EquirectConverter benchmark: equirectangular HDR to environment cubemap for each IBLQuality size.
+//
+// Usage:
+//   EquirectBenchmark [sourceWidth] [maxFaceSize]    (defaults 4096, 2048)
+//
+// The source is a procedural RGB sky of sourceWidth x sourceWidth/2. Passes per face size:
+//   scalar  - per-texel normalize + atan2/acos + bilinear, the converter TextureUtils used before
+//   cold    - EquirectConverter with the direction table built first (first HDR at this size)
+//   warm    - table reused (every later HDR switch)
+//   chain   - warm, full mip chain with box mips built inside the tiles
+//   split   - warm mip 0, then MipGenerator::generateCubemap (the unfused chain)
+// "max err" is the largest channel difference between scalar and warm mip 0.
+
+#include "Renderer/EquirectConverter.h"
+#include "texture/MipGenerator.h"
+#include "core/ThreadPool.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using MiEngine::EquirectConverter;
+using MiEngine::EquirectSettings;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+std::vector<float> makeSky(uint32_t width, uint32_t height) {
+    std::vector<float> data(static_cast<size_t>(width) * height * 3);
+    MiEngine::ThreadPool::getInstance().parallelFor(height, [&](size_t y) {
+        float elevation = 1.0f - 2.0f * (y + 0.5f) / height;
+        float* texel = data.data() + y * width * 3;
+        for (uint32_t x = 0; x < width; ++x, texel += 3) {
+            float azimuth = 6.2831853f * (x + 0.5f) / width;
+            float clouds = 0.5f + 0.5f * std::sin(azimuth * 7.0f) * std::cos(elevation * 11.0f);
+            float sky = std::max(elevation, 0.0f);
+            texel[0] = 0.1f + 0.3f * sky + 0.2f * clouds;
+            texel[1] = 0.08f + 0.5f * sky + 0.2f * clouds;
+            texel[2] = 0.05f + 1.0f * sky + 0.2f * clouds;
+        }
+    }, 16);
+    return data;
+}
+
+// The pre-EquirectConverter face conversion, one face at a time
+void convertScalar(const float* source, int width, int height, float* faces, int faceSize) {
+    for (int face = 0; face < 6; ++face) {
+        float* faceData = faces + static_cast<size_t>(face) * faceSize * faceSize * 4;
+        for (int y = 0; y < faceSize; ++y) {
+            for (int x = 0; x < faceSize; ++x) {
+                float u = 2.0f * (x + 0.5f) / faceSize - 1.0f;
+                float v = 2.0f * (y + 0.5f) / faceSize - 1.0f;
+                glm::vec3 dir;
+                switch (face) {
+                    case 0: dir = glm::vec3(1.0f, -v, -u); break;
+                    case 1: dir = glm::vec3(-1.0f, -v, u); break;
+                    case 2: dir = glm::vec3(u, 1.0f, v); break;
+                    case 3: dir = glm::vec3(u, -1.0f, -v); break;
+                    case 4: dir = glm::vec3(u, -v, 1.0f); break;
+                    default: dir = glm::vec3(-u, -v, -1.0f); break;
+                }
+                dir = glm::normalize(dir);
+
+                float eqU = (std::atan2(dir.z, dir.x) + 3.14159265f) / 6.2831853f;
+                float eqV = std::acos(std::clamp(dir.y, -1.0f, 1.0f)) / 3.14159265f;
+                eqU -= std::floor(eqU);
+                eqV = std::clamp(eqV, 0.0f, 1.0f);
+
+                float fX = eqU * (width - 1);
+                float fY = eqV * (height - 1);
+                int x0 = static_cast<int>(fX);
+                int y0 = static_cast<int>(fY);
+                int x1 = std::min(x0 + 1, width - 1);
+                int y1 = std::min(y0 + 1, height - 1);
+                float dx = fX - x0;
+                float dy = fY - y0;
+
+                float* out = faceData + (static_cast<size_t>(y) * faceSize + x) * 4;
+                for (int c = 0; c < 3; ++c) {
+                    float v0 = source[(y0 * width + x0) * 3 + c] * (1.0f - dx) + source[(y0 * width + x1) * 3 + c] * dx;
+                    float v1 = source[(y1 * width + x0) * 3 + c] * (1.0f - dx) + source[(y1 * width + x1) * 3 + c] * dx;
+                    out[c] = v0 * (1.0f - dy) + v1 * dy;
+                }
+                out[3] = 1.0f;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t sourceWidth = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 4096;
+    uint32_t maxFaceSize = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 2048;
+    if (sourceWidth < 2 || maxFaceSize == 0) {
+        std::cerr << "Usage: EquirectBenchmark [sourceWidth] [maxFaceSize]" << std::endl;
+        return 1;
+    }
+
+    uint32_t sourceHeight = sourceWidth / 2;
+    std::vector<float> source = makeSky(sourceWidth, sourceHeight);
+
+    std::cout << "Threads: " << MiEngine::ThreadPool::getInstance().getThreadCount() + 1 << " (pool + caller)\n";
+    std::cout << "Source: " << sourceWidth << "x" << sourceHeight << " RGB\n";
+    std::cout << std::right << std::setw(6) << "Face" << std::setw(11) << "scalar ms" << std::setw(9) << "cold ms"
+              << std::setw(9) << "warm ms" << std::setw(10) << "chain ms" << std::setw(10) << "split ms"
+              << std::setw(10) << "max err" << "\n";
+
+    for (uint32_t faceSize : { 256u, 1024u, 2048u, 4096u }) {
+        if (faceSize > maxFaceSize) {
+            break;
+        }
+
+        std::vector<float> scalar(static_cast<size_t>(faceSize) * faceSize * 4 * 6);
+        auto start = std::chrono::high_resolution_clock::now();
+        convertScalar(source.data(), sourceWidth, sourceHeight, scalar.data(), faceSize);
+        double scalarMs = elapsedMs(start);
+
+        EquirectSettings settings;
+        settings.faceSize = faceSize;
+
+        // A different size in between forces the table to be rebuilt
+        EquirectConverter::getDirectionTable(faceSize / 2);
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<float> cold = EquirectConverter::convert(source.data(), sourceWidth, sourceHeight, 3, settings);
+        double coldMs = elapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<float> warm = EquirectConverter::convert(source.data(), sourceWidth, sourceHeight, 3, settings);
+        double warmMs = elapsedMs(start);
+
+        EquirectSettings chainSettings = settings;
+        chainSettings.mipLevels = MiEngine::MipGenerator::getMipLevelCount(faceSize, faceSize);
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<float> chain = EquirectConverter::convert(source.data(), sourceWidth, sourceHeight, 3, chainSettings);
+        double chainMs = elapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<float> split = EquirectConverter::convert(source.data(), sourceWidth, sourceHeight, 3, settings);
+        MiEngine::MipGenerator::generateCubemap(split, faceSize, chainSettings.mipLevels, MiEngine::MipSettings{});
+        double splitMs = elapsedMs(start);
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < scalar.size(); ++i) {
+            maxError = std::max(maxError, std::fabs(scalar[i] - warm[i]));
+        }
+
+        std::cout << std::setw(6) << faceSize << std::fixed << std::setprecision(1) << std::setw(11) << scalarMs
+                  << std::setw(9) << coldMs << std::setw(9) << warmMs << std::setw(10) << chainMs << std::setw(10)
+                  << splitMs << std::scientific << std::setprecision(1) << std::setw(10) << maxError
+                  << std::defaultfloat << "\n";
+    }
+    return 0;
+}
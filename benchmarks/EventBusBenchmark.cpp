@@ -0,0 +1,193 @@
+// MiEventBus benchmark: deferred batched events against firing a delegate at the call site.
+//
+// Usage:
+//   EventBusBenchmark [producerCount] [frames]    (defaults 100000, 60)
+//
+// Every frame each producer moves (a few flops on its own state) and emits one
+// hit event on a random target. Two systems consume hits: health (subtracts
+// damage in a 64k-entry table) and stats (counts hits per producer). Passes,
+// ms per frame:
+//   immediate - MiMulticastDelegate broadcast per event, at the call site
+//   deferred  - MiEventBus::post per event, one dispatch per frame; the systems
+//               take the whole array
+//   parallel  - deferred, producers run in 1024-producer jobs under
+//               JobSystem::parallelFor, each posting its hits with postBatch
+//               (not possible with immediate: the systems aren't thread-safe)
+// "dispatch" is the MiEventBus dispatch time; "checksum" must match immediate.
+
+#include "core/MiDelegate.h"
+#include "core/MiEventBus.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <vector>
+
+namespace {
+
+using namespace MiEngine;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+constexpr uint32_t TARGET_COUNT = 65536;
+constexpr size_t CHUNK_SIZE = 1024;
+
+struct HitEvent {
+    uint32_t target;
+    uint32_t source;
+    float damage;
+};
+
+struct Producer {
+    float position[3];
+    float velocity[3];
+    uint32_t seed;
+};
+
+struct Systems {
+    std::vector<float> health;
+    std::vector<uint32_t> hitsBySource;
+
+    explicit Systems(size_t producerCount) : health(TARGET_COUNT, 1000.0f), hitsBySource(producerCount, 0) {}
+
+    void onHit(const HitEvent& hit) { health[hit.target] -= hit.damage; }
+    void onHitStats(const HitEvent& hit) { ++hitsBySource[hit.source]; }
+
+    double checksum() const {
+        double sum = 0.0;
+        for (float value : health) {
+            sum += value;
+        }
+        for (uint32_t hits : hitsBySource) {
+            sum += hits;
+        }
+        return sum;
+    }
+};
+
+// Moves the producer and returns its hit for this frame
+HitEvent updateProducer(Producer& producer, uint32_t index) {
+    for (int axis = 0; axis < 3; ++axis) {
+        producer.position[axis] += producer.velocity[axis] * 0.016f;
+        producer.velocity[axis] *= 0.99f;
+    }
+    producer.seed = producer.seed * 1664525u + 1013904223u;
+    return HitEvent{producer.seed % TARGET_COUNT, index, 0.001f + std::fabs(producer.position[0]) * 1.0e-6f};
+}
+
+std::vector<Producer> makeProducers(size_t count) {
+    std::vector<Producer> producers(count);
+    for (size_t i = 0; i < count; ++i) {
+        producers[i] = Producer{{0.0f, 0.0f, 0.0f}, {1.0f, 0.5f, 0.25f}, static_cast<uint32_t>(i * 2654435761u)};
+    }
+    return producers;
+}
+
+struct Result {
+    double frameMs = 0.0;
+    double dispatchMs = 0.0;
+    double checksum = 0.0;
+};
+
+Result runImmediate(size_t producerCount, int frames) {
+    std::vector<Producer> producers = makeProducers(producerCount);
+    Systems systems(producerCount);
+    MiMulticastDelegate<const HitEvent&> onHit;
+    onHit.add(&systems, &Systems::onHit);
+    onHit.add(&systems, &Systems::onHitStats);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < producerCount; ++i) {
+            onHit.broadcast(updateProducer(producers[i], static_cast<uint32_t>(i)));
+        }
+    }
+    Result result;
+    result.frameMs = elapsedMs(start) / frames;
+    result.checksum = systems.checksum();
+    return result;
+}
+
+Result runDeferred(size_t producerCount, int frames, bool parallel) {
+    std::vector<Producer> producers = makeProducers(producerCount);
+    Systems systems(producerCount);
+    MiEventBus bus;
+    bus.subscribe<HitEvent>([&systems](std::span<const HitEvent> hits) {
+        for (const HitEvent& hit : hits) {
+            systems.onHit(hit);
+        }
+    });
+    bus.subscribe<HitEvent>([&systems](std::span<const HitEvent> hits) {
+        for (const HitEvent& hit : hits) {
+            systems.onHitStats(hit);
+        }
+    });
+
+    JobSystem& jobs = JobSystem::getInstance();
+    double dispatchMs = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        if (parallel) {
+            // One job per chunk, posting its hits as one batch
+            size_t chunkCount = (producerCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+            jobs.parallelFor(chunkCount, [&](size_t chunk) {
+                HitEvent hits[CHUNK_SIZE];
+                size_t begin = chunk * CHUNK_SIZE;
+                size_t end = std::min(begin + CHUNK_SIZE, producerCount);
+                for (size_t i = begin; i < end; ++i) {
+                    hits[i - begin] = updateProducer(producers[i], static_cast<uint32_t>(i));
+                }
+                bus.postBatch(std::span<const HitEvent>(hits, end - begin));
+            });
+        } else {
+            for (size_t i = 0; i < producerCount; ++i) {
+                bus.post(updateProducer(producers[i], static_cast<uint32_t>(i)));
+            }
+        }
+        bus.dispatch();
+        bus.endFrame();
+        dispatchMs += bus.getLastFrameStats().dispatchMs;
+    }
+    Result result;
+    result.frameMs = elapsedMs(start) / frames;
+    result.dispatchMs = dispatchMs / frames;
+    result.checksum = systems.checksum();
+    return result;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t producerCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+    if (producerCount == 0 || frames <= 0) {
+        std::cerr << "Usage: EventBusBenchmark [producerCount] [frames]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Producers: " << producerCount << " (1 event each per frame), frames: " << frames
+              << ", workers: " << JobSystem::getInstance().getWorkerCount() << "\n";
+    std::cout << std::right << std::setw(10) << "Pass" << std::setw(10) << "ms/frame" << std::setw(10)
+              << "ns/event" << std::setw(10) << "dispatch" << std::setw(14) << "checksum" << "\n";
+
+    Result immediate = runImmediate(producerCount, frames);
+    bool ok = true;
+    auto report = [&](const char* name, const Result& result) {
+        bool match = std::fabs(result.checksum - immediate.checksum) <= 1.0e-6 * std::fabs(immediate.checksum);
+        ok = ok && match;
+        std::cout << std::setw(10) << name << std::fixed << std::setprecision(2) << std::setw(10) << result.frameMs
+                  << std::setw(10) << result.frameMs * 1.0e6 / producerCount << std::setw(10) << result.dispatchMs
+                  << std::setw(14) << std::setprecision(1) << result.checksum << (match ? "" : "  MISMATCH")
+                  << "\n";
+    };
+    report("immediate", immediate);
+    report("deferred", runDeferred(producerCount, frames, false));
+    report("parallel", runDeferred(producerCount, frames, true));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+// JobSystem benchmark: scheduling overhead and scaling with the number of threads.
+//
+// Usage:
+//   JobSystemBenchmark [maxThreads] [jobCount]    (defaults hardware_concurrency, 100000)
+//
+// Overhead (default worker count), ns per job:
+//   empty       - jobCount empty jobs on one counter, scheduled from the main thread, then wait()
+//   nested      - jobCount / 64 jobs that each schedule 64 empty children and wait for them
+//   hooked      - empty, with begin/end instrumentation hooks installed
+//   parallelFor - jobCount empty iterations, grain 1
+//   pool        - jobCount empty ThreadPool::submit tasks (Background jobs on the same system), then every
+//                 future waited on
+// Scaling: a fixed CPU-bound parallelFor (4096 items) on 1..maxThreads threads
+// (main thread + workers); "speedup" is relative to 1 thread.
+
+#include "core/JobSystem.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using MiEngine::JobCounter;
+using MiEngine::JobSystem;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+double nsPerJob(double ms, uint32_t jobCount) {
+    return ms * 1.0e6 / jobCount;
+}
+
+// Roughly a transform update's worth of arithmetic per item
+float work(size_t item) {
+    float value = static_cast<float>(item);
+    for (int i = 0; i < 2000; ++i) {
+        value = std::sin(value) * 0.5f + std::sqrt(value * value + 1.0f);
+    }
+    return value;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t hw = std::max(std::thread::hardware_concurrency(), 1u);
+    uint32_t maxThreads = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : hw;
+    uint32_t jobCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 100000;
+    if (maxThreads == 0 || jobCount < 64) {
+        std::cerr << "Usage: JobSystemBenchmark [maxThreads] [jobCount]" << std::endl;
+        return 1;
+    }
+
+    {
+        JobSystem jobs;
+        std::cout << "Threads: " << jobs.getWorkerCount() + 1 << " (workers + main)\n";
+        std::cout << std::right << std::setw(8) << "empty" << std::setw(9) << "nested" << std::setw(9) << "hooked"
+                  << std::setw(13) << "parallelFor" << std::setw(8) << "pool" << "   (ns/job)\n";
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto counter = std::make_shared<JobCounter>();
+        for (uint32_t i = 0; i < jobCount; ++i) {
+            jobs.schedule([]() {}, {}, counter);
+        }
+        jobs.wait(counter);
+        double emptyMs = elapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        counter = std::make_shared<JobCounter>();
+        for (uint32_t i = 0; i < jobCount / 64; ++i) {
+            jobs.schedule([&jobs]() {
+                auto children = std::make_shared<JobCounter>();
+                for (int child = 0; child < 64; ++child) {
+                    jobs.schedule([]() {}, {}, children);
+                }
+                jobs.wait(children);
+            }, {}, counter);
+        }
+        jobs.wait(counter);
+        double nestedMs = elapsedMs(start);
+
+        std::atomic<uint64_t> hookCalls{ 0 };
+        MiEngine::JobInstrumentation hooks;
+        hooks.onJobBegin = [&hookCalls](const MiEngine::JobEvent&) { hookCalls.fetch_add(1, std::memory_order_relaxed); };
+        hooks.onJobEnd = [&hookCalls](const MiEngine::JobEvent&) { hookCalls.fetch_add(1, std::memory_order_relaxed); };
+        jobs.setInstrumentation(hooks);
+        start = std::chrono::high_resolution_clock::now();
+        counter = std::make_shared<JobCounter>();
+        for (uint32_t i = 0; i < jobCount; ++i) {
+            jobs.schedule([]() {}, {}, counter);
+        }
+        jobs.wait(counter);
+        double hookedMs = elapsedMs(start);
+        jobs.setInstrumentation({});
+
+        start = std::chrono::high_resolution_clock::now();
+        jobs.parallelFor(jobCount, [](size_t) {}, 1);
+        double parallelForMs = elapsedMs(start);
+
+        MiEngine::ThreadPool pool(jobs);
+        std::vector<std::future<void>> futures;
+        futures.reserve(jobCount);
+        start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < jobCount; ++i) {
+            futures.push_back(pool.submit([]() {}));
+        }
+        for (auto& future : futures) {
+            future.wait();
+        }
+        double poolMs = elapsedMs(start);
+
+        std::cout << std::fixed << std::setprecision(0) << std::setw(8) << nsPerJob(emptyMs, jobCount) << std::setw(9)
+                  << nsPerJob(nestedMs, jobCount / 64 * 65) << std::setw(9) << nsPerJob(hookedMs, jobCount)
+                  << std::setw(13) << nsPerJob(parallelForMs, jobCount) << std::setw(8) << nsPerJob(poolMs, jobCount)
+                  << "\n";
+    }
+
+    std::cout << "\n" << std::setw(8) << "Threads" << std::setw(9) << "ms" << std::setw(10) << "speedup"
+              << std::setw(9) << "stolen" << "\n";
+
+    const size_t itemCount = 4096;
+    std::vector<float> results(itemCount);
+    double baseMs = 0.0;
+    for (uint32_t threads = 1; threads <= maxThreads; ++threads) {
+        JobSystem jobs(threads - 1);
+
+        // Warm up the workers before timing
+        jobs.parallelFor(itemCount, [&results](size_t i) { results[i] = 0.0f; }, 64);
+        jobs.resetStats();
+
+        auto start = std::chrono::high_resolution_clock::now();
+        jobs.parallelFor(itemCount, [&results](size_t i) { results[i] = work(i); }, 16);
+        double ms = elapsedMs(start);
+        if (threads == 1) {
+            baseMs = ms;
+        }
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(1) << std::setw(9) << ms
+                  << std::setprecision(2) << std::setw(10) << baseMs / ms << std::setw(9) << jobs.getStats().stolen
+                  << "\n";
+    }
+    return 0;
+}
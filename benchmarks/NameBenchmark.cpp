@@ -0,0 +1,278 @@
+// MiName benchmark: interned names against the std::string keys they replace.
+//
+// Usage:
+//   NameBenchmark [actorCount] [repeats]    (defaults 100000, 20)
+//
+// Passes, string then MiName:
+//   tag query   - hasTag over actorCount tag lists (0-3 of 32 tags), ms per query
+//   bone bind   - bindToSkeleton: 128 tracks looked up in a 128-bone name map,
+//                 ns per track
+//   mesh lookup - MeshLibrary cache find for 1000 asset paths held by callers,
+//                 ns per lookup
+//   intern      - MiName from text: first time, and again once interned, ns per name
+// "parallel intern" has 8 threads intern the same 10000 names in different
+// orders and checks they all get the same handles.
+
+#include "core/MiName.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using MiEngine::MiName;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+constexpr int TAG_COUNT = 32;
+constexpr int BONE_COUNT = 128;
+constexpr int PATH_COUNT = 1000;
+
+struct Row {
+    const char* name;
+    const char* unit;
+    double stringTime;
+    double nameTime;
+    bool match;
+};
+
+void printRow(const Row& row) {
+    std::cout << std::setw(12) << row.name << std::fixed << std::setprecision(2) << std::setw(12) << row.stringTime
+              << std::setw(12) << row.nameTime << std::setw(9) << row.stringTime / row.nameTime << "x"
+              << std::setw(8) << row.unit << (row.match ? "" : "  MISMATCH") << "\n";
+}
+
+Row runTagQuery(size_t actorCount, int repeats, std::mt19937& rng) {
+    std::vector<std::string> tagTexts;
+    for (int i = 0; i < TAG_COUNT; ++i) {
+        tagTexts.push_back("gameplay_tag_" + std::to_string(i));
+    }
+
+    std::vector<std::vector<std::string>> stringTags(actorCount);
+    std::vector<std::vector<MiName>> nameTags(actorCount);
+    std::uniform_int_distribution<int> pickCount(0, 3);
+    std::uniform_int_distribution<int> pickTag(0, TAG_COUNT - 1);
+    for (size_t i = 0; i < actorCount; ++i) {
+        int count = pickCount(rng);
+        for (int t = 0; t < count; ++t) {
+            const std::string& tag = tagTexts[pickTag(rng)];
+            stringTags[i].push_back(tag);
+            nameTags[i].push_back(MiName(tag));
+        }
+    }
+
+    // The previous MiActor::hasTag / MiWorld::findActorsByTag
+    size_t stringFound = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        const std::string& query = tagTexts[r % TAG_COUNT];
+        for (const auto& tags : stringTags) {
+            stringFound += std::find(tags.begin(), tags.end(), query) != tags.end();
+        }
+    }
+    double stringMs = elapsedMs(start) / repeats;
+
+    size_t nameFound = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        MiName query = MiName::find(tagTexts[r % TAG_COUNT]);
+        for (const auto& tags : nameTags) {
+            nameFound += std::find(tags.begin(), tags.end(), query) != tags.end();
+        }
+    }
+    double nameMs = elapsedMs(start) / repeats;
+
+    return Row{"tag query", "ms", stringMs, nameMs, stringFound == nameFound};
+}
+
+Row runBoneBind(int repeats) {
+    // Mixamo-style names share a long prefix
+    std::vector<std::string> boneTexts;
+    for (int i = 0; i < BONE_COUNT; ++i) {
+        boneTexts.push_back("mixamorig:Skeleton_Bone_" + std::to_string(i));
+    }
+
+    std::unordered_map<std::string, uint32_t> stringBones;
+    std::unordered_map<MiName, uint32_t> nameBones;
+    std::vector<MiName> trackNames;
+    for (int i = 0; i < BONE_COUNT; ++i) {
+        stringBones[boneTexts[i]] = i;
+        nameBones[MiName(boneTexts[i])] = i;
+    }
+    // Tracks in a different order than the bones
+    std::vector<std::string> trackTexts(boneTexts.rbegin(), boneTexts.rend());
+    for (const std::string& text : trackTexts) {
+        trackNames.push_back(MiName(text));
+    }
+
+    int passes = repeats * 1000;
+    std::vector<int32_t> stringIndices(BONE_COUNT);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        for (int t = 0; t < BONE_COUNT; ++t) {
+            auto it = stringBones.find(trackTexts[t]);
+            stringIndices[t] = it != stringBones.end() ? static_cast<int32_t>(it->second) : -1;
+        }
+    }
+    double stringNs = elapsedMs(start) * 1.0e6 / (static_cast<double>(passes) * BONE_COUNT);
+
+    std::vector<int32_t> nameIndices(BONE_COUNT);
+    start = std::chrono::high_resolution_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        for (int t = 0; t < BONE_COUNT; ++t) {
+            auto it = nameBones.find(trackNames[t]);
+            nameIndices[t] = it != nameBones.end() ? static_cast<int32_t>(it->second) : -1;
+        }
+    }
+    double nameNs = elapsedMs(start) * 1.0e6 / (static_cast<double>(passes) * BONE_COUNT);
+
+    return Row{"bone bind", "ns", stringNs, nameNs, stringIndices == nameIndices};
+}
+
+Row runMeshLookup(int repeats, std::mt19937& rng) {
+    std::vector<std::string> pathTexts;
+    for (int i = 0; i < PATH_COUNT; ++i) {
+        pathTexts.push_back("Models/Environment/Props/prop_" + std::to_string(i) + ".glb");
+    }
+
+    std::unordered_map<std::string, int> stringCache;
+    std::unordered_map<MiName, int> nameCache;
+    for (int i = 0; i < PATH_COUNT; ++i) {
+        stringCache[pathTexts[i]] = i;
+        nameCache[MiName(pathTexts[i])] = i;
+    }
+
+    // Components hold their path; lookups in random order
+    std::vector<int> order(PATH_COUNT * 10);
+    std::uniform_int_distribution<int> pickPath(0, PATH_COUNT - 1);
+    for (int& index : order) {
+        index = pickPath(rng);
+    }
+    std::vector<MiName> pathNames;
+    for (const std::string& text : pathTexts) {
+        pathNames.push_back(MiName(text));
+    }
+
+    int passes = repeats * 100;
+    long long stringSum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        for (int index : order) {
+            stringSum += stringCache.find(pathTexts[index])->second;
+        }
+    }
+    double stringNs = elapsedMs(start) * 1.0e6 / (static_cast<double>(passes) * order.size());
+
+    long long nameSum = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        for (int index : order) {
+            nameSum += nameCache.find(pathNames[index])->second;
+        }
+    }
+    double nameNs = elapsedMs(start) * 1.0e6 / (static_cast<double>(passes) * order.size());
+
+    return Row{"mesh lookup", "ns", stringNs, nameNs, stringSum == nameSum};
+}
+
+// Returns first-time and repeat ns per name
+std::pair<double, double> runIntern(size_t count) {
+    std::vector<std::string> texts;
+    texts.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        texts.push_back("Interned/Name/Benchmark_" + std::to_string(i));
+    }
+
+    std::vector<MiName> names(count);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        names[i] = MiName(texts[i]);
+    }
+    double firstNs = elapsedMs(start) * 1.0e6 / count;
+
+    size_t same = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        same += MiName(texts[i]) == names[i];
+    }
+    double repeatNs = elapsedMs(start) * 1.0e6 / count;
+
+    if (same != count) {
+        return {-1.0, -1.0};
+    }
+    return {firstNs, repeatNs};
+}
+
+bool runParallelIntern() {
+    constexpr int THREADS = 8;
+    constexpr int NAMES = 10000;
+
+    std::vector<std::vector<MiName>> results(THREADS, std::vector<MiName>(NAMES));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t, &results]() {
+            for (int i = 0; i < NAMES; ++i) {
+                // Each thread walks the names in a different order
+                int index = (i * 7919 + t * 1237) % NAMES;
+                results[t][index] = MiName("Parallel/Name_" + std::to_string(index));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 1; t < THREADS; ++t) {
+        if (results[t] != results[0]) {
+            return false;
+        }
+    }
+    for (int i = 0; i < NAMES; ++i) {
+        if (results[0][i].toString() != "Parallel/Name_" + std::to_string(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t actorCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (actorCount == 0 || repeats <= 0) {
+        std::cerr << "Usage: NameBenchmark [actorCount] [repeats]" << std::endl;
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::cout << "Actors: " << actorCount << ", repeats: " << repeats << "\n";
+    std::cout << std::right << std::setw(12) << "Pass" << std::setw(12) << "string" << std::setw(12) << "MiName"
+              << std::setw(10) << "speedup" << std::setw(8) << "unit" << "\n";
+
+    bool ok = true;
+    Row rows[] = {runTagQuery(actorCount, repeats, rng), runBoneBind(repeats), runMeshLookup(repeats, rng)};
+    for (const Row& row : rows) {
+        ok = ok && row.match;
+        printRow(row);
+    }
+
+    auto [firstNs, repeatNs] = runIntern(actorCount);
+    ok = ok && firstNs >= 0.0;
+    std::cout << "intern: first " << std::setprecision(1) << firstNs << " ns, repeat " << repeatNs
+              << " ns per name\n";
+
+    bool parallel = runParallelIntern();
+    std::cout << "parallel intern: " << (parallel ? "ok" : "FAILED") << ", " << MiName::getNameCount()
+              << " names interned\n";
+    return ok && parallel ? 0 : 1;
+}
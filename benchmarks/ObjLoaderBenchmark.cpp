@@ -0,0 +1,100 @@
+// ObjLoader throughput benchmark.
+//
+// Usage:
+//   ObjLoaderBenchmark <file.obj>              load an existing file
+//   ObjLoaderBenchmark --generate <MB> <out>   write a grid OBJ of roughly <MB> megabytes, then load it
+//
+// The generated grid has v/vt/vn for every grid point and one quad per cell, so
+// every corner welds to a shared vertex (same shape as typical scanned meshes).
+
+#include "loader/ObjLoader.h"
+#include "core/ThreadPool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+bool generateGrid(const fs::path& path, uint64_t targetMB) {
+    // ~150 bytes per grid point (v + vt + vn + one face line)
+    uint64_t points = targetMB * 1024 * 1024 / 150;
+    uint32_t side = static_cast<uint32_t>(std::sqrt(static_cast<double>(points)));
+    if (side < 2) {
+        side = 2;
+    }
+
+    FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to create " << path << std::endl;
+        return false;
+    }
+
+    std::vector<char> buffer(1 << 20);
+    std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+    std::fprintf(file, "# %ux%u grid\no grid\n", side, side);
+    for (uint32_t y = 0; y < side; ++y) {
+        for (uint32_t x = 0; x < side; ++x) {
+            float fx = static_cast<float>(x) / (side - 1);
+            float fy = static_cast<float>(y) / (side - 1);
+            float h = 0.05f * std::sin(fx * 31.0f) * std::cos(fy * 17.0f);
+            std::fprintf(file, "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0.000000 1.000000 0.000000\n",
+                         fx * 100.0f, h, fy * 100.0f, fx, fy);
+        }
+    }
+    for (uint32_t y = 0; y + 1 < side; ++y) {
+        for (uint32_t x = 0; x + 1 < side; ++x) {
+            uint32_t i0 = y * side + x + 1;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + side + 1;
+            uint32_t i3 = i0 + side;
+            std::fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n",
+                         i0, i0, i0, i3, i3, i3, i2, i2, i2, i1, i1, i1);
+        }
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    fs::path path;
+    if (argc == 4 && std::string(argv[1]) == "--generate") {
+        path = argv[3];
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!generateGrid(path, std::strtoull(argv[2], nullptr, 10))) {
+            return 1;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "Generated " << path << " (" << fs::file_size(path) / (1024 * 1024) << " MB) in "
+                  << static_cast<uint64_t>(ms) << "ms" << std::endl;
+    } else if (argc == 2) {
+        path = argv[1];
+    } else {
+        std::cerr << "Usage: ObjLoaderBenchmark <file.obj> | --generate <MB> <out.obj>" << std::endl;
+        return 1;
+    }
+
+    std::vector<MeshData> meshes;
+    MiEngine::ObjLoader::Stats stats;
+    if (!MiEngine::ObjLoader::load(path, meshes, &stats)) {
+        return 1;
+    }
+
+    double mb = stats.fileBytes / (1024.0 * 1024.0);
+    std::cout << "Threads:    " << MiEngine::ThreadPool::getInstance().getThreadCount() + 1 << " (pool + caller)\n"
+              << "File:       " << static_cast<uint64_t>(mb) << " MB, " << stats.chunkCount << " chunks\n"
+              << "Positions:  " << stats.positionCount << "\n"
+              << "Vertices:   " << stats.vertexCount << " (welded)\n"
+              << "Triangles:  " << stats.triangleCount << "\n"
+              << "Parse:      " << stats.parseMs << " ms (" << mb / (stats.parseMs / 1000.0) << " MB/s)\n"
+              << "Weld:       " << stats.weldMs << " ms\n"
+              << "Finalize:   " << stats.finalizeMs << " ms\n"
+              << "Total:      " << stats.totalMs << " ms (" << mb / (stats.totalMs / 1000.0) << " MB/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+// ObjectId benchmark: 128-bit POD ids against the previous UUID strings.
+//
+// Usage:
+//   ObjectIdBenchmark [count]    (default 100000)
+//
+// Per id, ns:
+//   generate  - string: mt19937_64 + ostringstream/setw formatting (the previous generateObjectId)
+//               pod:    generateObjectId()
+//   insert    - count inserts into an unordered_map keyed by the id (reserved)
+//   find      - count lookups of existing ids
+//   toString / fromString - the serialization boundary, pod only
+// "round trip" checks fromString(toString(id)) == id for every id.
+
+#include "core/MiObject.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using MiEngine::ObjectId;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// The previous generateObjectId
+std::string generateStringId() {
+    static std::random_device rd;
+    static std::mt19937_64 gen(rd());
+    static std::uniform_int_distribution<uint64_t> dis;
+
+    uint64_t ab = dis(gen);
+    uint64_t cd = dis(gen);
+    ab = (ab & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+    cd = (cd & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    ss << std::setw(8) << ((ab >> 32) & 0xFFFFFFFF) << "-";
+    ss << std::setw(4) << ((ab >> 16) & 0xFFFF) << "-";
+    ss << std::setw(4) << (ab & 0xFFFF) << "-";
+    ss << std::setw(4) << ((cd >> 48) & 0xFFFF) << "-";
+    ss << std::setw(12) << (cd & 0xFFFFFFFFFFFFULL);
+    return ss.str();
+}
+
+struct Timings {
+    double generate = 0.0;
+    double insert = 0.0;
+    double find = 0.0;
+};
+
+template<typename Id, typename Generate>
+Timings measure(size_t count, Generate generate, size_t& found) {
+    Timings timings;
+    std::vector<Id> ids;
+    ids.reserve(count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back(generate());
+    }
+    timings.generate = elapsedMs(start) * 1.0e6 / count;
+
+    std::unordered_map<Id, size_t> map;
+    map.reserve(count);
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        map.emplace(ids[i], i);
+    }
+    timings.insert = elapsedMs(start) * 1.0e6 / count;
+
+    found = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        found += map.count(ids[count - 1 - i]);
+    }
+    timings.find = elapsedMs(start) * 1.0e6 / count;
+    return timings;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    if (count == 0) {
+        std::cerr << "Usage: ObjectIdBenchmark [count]" << std::endl;
+        return 1;
+    }
+
+    size_t stringFound = 0;
+    size_t podFound = 0;
+    Timings stringTimings = measure<std::string>(count, generateStringId, stringFound);
+    Timings podTimings = measure<ObjectId>(count, MiEngine::generateObjectId, podFound);
+
+    std::cout << "Ids: " << count << " (ns per id)\n";
+    std::cout << std::right << std::setw(8) << "Id" << std::setw(10) << "generate" << std::setw(9) << "insert"
+              << std::setw(8) << "find" << std::setw(8) << "bytes" << std::setw(8) << "found" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << "string" << std::setw(10) << stringTimings.generate << std::setw(9)
+              << stringTimings.insert << std::setw(8) << stringTimings.find << std::setw(8) << sizeof(std::string)
+              << std::setw(8) << stringFound << "\n";
+    std::cout << std::setw(8) << "pod" << std::setw(10) << podTimings.generate << std::setw(9) << podTimings.insert
+              << std::setw(8) << podTimings.find << std::setw(8) << sizeof(ObjectId) << std::setw(8) << podFound
+              << "\n";
+
+    std::vector<ObjectId> ids(count);
+    for (auto& id : ids) {
+        id = MiEngine::generateObjectId();
+    }
+    std::vector<std::string> texts(count);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        texts[i] = ids[i].toString();
+    }
+    double toStringNs = elapsedMs(start) * 1.0e6 / count;
+
+    size_t matches = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        matches += ObjectId::fromString(texts[i]) == ids[i];
+    }
+    double fromStringNs = elapsedMs(start) * 1.0e6 / count;
+
+    std::cout << "toString " << toStringNs << " ns, fromString " << fromStringNs << " ns, round trip "
+              << matches << "/" << count << "\n";
+    return matches == count ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// SpecularPrefilter benchmark: CPU prefilter time for every IBLQuality preset.
+//
+// Usage:
+//   PrefilterBenchmark [maxSourceSize]    (default 1024)
+//
+// Each preset filters a procedural sky (gradient + sun disc) at its environmentMapSize,
+// capped at maxSourceSize to bound memory, with the mip chain from MipGenerator. Two passes:
+//   preview - sample counts divided by prefilterPreviewDivisor (the first upload)
+//   full    - preset sample counts (the background refinement)
+// "rms" is the preview's error relative to the full result.
+
+#include "Renderer/SpecularPrefilter.h"
+#include "Renderer/SphericalHarmonics.h"
+#include "Utils/TextureUtils.h"
+#include "texture/MipGenerator.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using MiEngine::PrefilterSettings;
+using MiEngine::SpecularPrefilter;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Full IBL-cache-layout chain of a sky with a bright sun (exercises the radiance clamp)
+std::vector<float> makeSky(uint32_t faceSize, uint32_t mipLevels) {
+    const glm::vec3 sunDir = glm::normalize(glm::vec3(0.3f, 0.8f, 0.2f));
+    std::vector<float> data(static_cast<size_t>(faceSize) * faceSize * 4 * 6);
+
+    MiEngine::ThreadPool::getInstance().parallelFor(static_cast<size_t>(faceSize) * 6, [&](size_t row) {
+        uint32_t face = static_cast<uint32_t>(row / faceSize);
+        float v = 2.0f * (row % faceSize + 0.5f) / faceSize - 1.0f;
+        float* texel = data.data() + row * faceSize * 4;
+        for (uint32_t x = 0; x < faceSize; ++x, texel += 4) {
+            float u = 2.0f * (x + 0.5f) / faceSize - 1.0f;
+            glm::vec3 d = MiEngine::SphericalHarmonics::faceDirection(face, u, v);
+            float sky = std::max(d.y, 0.0f);
+            float sun = glm::dot(d, sunDir) > 0.9995f ? 500.0f : 0.0f;
+            texel[0] = 0.1f + 0.3f * sky + sun;
+            texel[1] = 0.08f + 0.5f * sky + sun;
+            texel[2] = 0.05f + 1.0f * sky + sun;
+            texel[3] = 1.0f;
+        }
+    }, 8);
+
+    MiEngine::MipGenerator::generateCubemap(data, faceSize, mipLevels, MiEngine::MipSettings{});
+    return data;
+}
+
+double relativeRms(const std::vector<float>& a, const std::vector<float>& reference) {
+    double error = 0.0;
+    double energy = 0.0;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        if (i % 4 == 3) continue;
+        double d = a[i] - reference[i];
+        error += d * d;
+        energy += double(reference[i]) * reference[i];
+    }
+    return energy > 0.0 ? std::sqrt(error / energy) : 0.0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t maxSourceSize = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1024;
+    if (maxSourceSize == 0) {
+        std::cerr << "Usage: PrefilterBenchmark [maxSourceSize]" << std::endl;
+        return 1;
+    }
+
+    const std::pair<TextureUtils::IBLQuality, const char*> presets[] = {
+        { TextureUtils::IBLQuality::LOW, "LOW" },
+        { TextureUtils::IBLQuality::MEDIUM, "MEDIUM" },
+        { TextureUtils::IBLQuality::HIGH, "HIGH" },
+        { TextureUtils::IBLQuality::ULTRA, "ULTRA" },
+    };
+
+    std::cout << "Threads: " << MiEngine::ThreadPool::getInstance().getThreadCount() + 1 << " (pool + caller)\n";
+    std::cout << std::left << std::setw(8) << "Quality" << std::right << std::setw(8) << "Source" << std::setw(10)
+              << "Output" << std::setw(10) << "Samples" << std::setw(12) << "preview ms" << std::setw(10) << "full ms"
+              << std::setw(8) << "rms" << "\n";
+
+    for (const auto& [quality, name] : presets) {
+        TextureUtils::IBLConfig config(quality);
+        uint32_t sourceSize = std::min(config.environmentMapSize, maxSourceSize);
+        uint32_t sourceMips = MiEngine::MipGenerator::getMipLevelCount(sourceSize, sourceSize);
+        std::vector<float> source = makeSky(sourceSize, sourceMips);
+
+        PrefilterSettings settings;
+        settings.faceSize = config.prefilterMapSize;
+        settings.mipLevels = config.prefilterMipLevels;
+        settings.baseSamples = config.prefilterBaseSamples;
+
+        PrefilterSettings preview = settings;
+        preview.sampleDivisor = config.prefilterPreviewDivisor;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<float> previewData = SpecularPrefilter::prefilter(source.data(), sourceSize, sourceMips, preview);
+        double previewMs = elapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<float> fullData = SpecularPrefilter::prefilter(source.data(), sourceSize, sourceMips, settings);
+        double fullMs = elapsedMs(start);
+
+        std::string output = std::to_string(settings.faceSize) + "/" + std::to_string(settings.mipLevels);
+        uint32_t maxSamples = SpecularPrefilter::getSampleCount(settings, settings.mipLevels - 1);
+        std::cout << std::left << std::setw(8) << name << std::right << std::setw(8) << sourceSize << std::setw(10)
+                  << output << std::setw(10) << maxSamples << std::fixed << std::setprecision(1) << std::setw(12)
+                  << previewMs << std::setw(10) << fullMs << std::setprecision(3) << std::setw(8)
+                  << relativeRms(previewData, fullData) << std::defaultfloat << "\n";
+    }
+    return 0;
+}
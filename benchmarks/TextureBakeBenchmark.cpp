@@ -0,0 +1,148 @@
+// TextureCache bake benchmark.
+//
+// Usage:
+//   TextureBakeBenchmark <image> [<image> ...]    bake existing images (type guessed from the name)
+//   TextureBakeBenchmark --synthetic <size>       bake generated albedo/normal/roughness maps of size x size
+//
+// Bakes go to a temporary directory and are removed afterwards. Prints per-texture
+// bake time and the GPU memory of the RGBA8 mip chain vs the block-compressed one.
+
+#include "asset/TextureCache.h"
+#include "core/ThreadPool.h"
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace {
+
+using MiEngine::TextureBakeStats;
+using MiEngine::TextureCache;
+
+struct SyntheticTexture {
+    std::string name;
+    TextureType type;
+};
+
+// Smooth noise-ish patterns so the encoders see gradients and edges rather than flat colour
+std::vector<uint8_t> generatePixels(TextureType type, uint32_t size) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            float fx = static_cast<float>(x) / size;
+            float fy = static_cast<float>(y) / size;
+            float a = std::sin(fx * 23.0f + std::cos(fy * 7.0f) * 3.0f);
+            float b = std::cos(fy * 19.0f + std::sin(fx * 5.0f) * 2.0f);
+            uint8_t* p = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+
+            if (type == TextureType::Normal) {
+                float nx = 0.4f * a;
+                float ny = 0.4f * b;
+                float nz = std::sqrt(std::max(1.0f - nx * nx - ny * ny, 0.0f));
+                p[0] = static_cast<uint8_t>((nx * 0.5f + 0.5f) * 255.0f + 0.5f);
+                p[1] = static_cast<uint8_t>((ny * 0.5f + 0.5f) * 255.0f + 0.5f);
+                p[2] = static_cast<uint8_t>((nz * 0.5f + 0.5f) * 255.0f + 0.5f);
+            } else if (type == TextureType::Diffuse) {
+                p[0] = static_cast<uint8_t>(127.5f + 127.5f * a);
+                p[1] = static_cast<uint8_t>(127.5f + 127.5f * b);
+                p[2] = static_cast<uint8_t>(127.5f + 127.5f * a * b);
+            } else {
+                uint8_t v = static_cast<uint8_t>(127.5f + 127.5f * a * b);
+                p[0] = p[1] = p[2] = v;
+            }
+            p[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+void printHeader() {
+    std::cout << std::left << std::setw(24) << "Texture" << std::setw(12) << "Size" << std::setw(7) << "Format"
+              << std::right << std::setw(10) << "Bake ms" << std::setw(12) << "RGBA8 MB" << std::setw(12) << "Baked MB"
+              << std::setw(9) << "Saved" << "\n";
+}
+
+void printRow(const std::string& name, const TextureBakeStats& stats) {
+    static const char* formatNames[] = { "BC1", "BC4", "BC5", "BC7" };
+    std::string size = std::to_string(stats.width) + "x" + std::to_string(stats.height);
+    std::cout << std::left << std::setw(24) << name.substr(0, 23) << std::setw(12) << size
+              << std::setw(7) << formatNames[static_cast<uint32_t>(stats.format)]
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << stats.totalMs
+              << std::setw(12) << stats.uncompressedBytes / 1048576.0
+              << std::setw(12) << stats.bakedBytes / 1048576.0
+              << std::setw(8) << 100.0 * (1.0 - static_cast<double>(stats.bakedBytes) / stats.uncompressedBytes) << "%"
+              << std::defaultfloat << "\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: TextureBakeBenchmark <image>... | --synthetic <size>" << std::endl;
+        return 1;
+    }
+
+    fs::path outDir = fs::temp_directory_path() / "miengine_texture_bake";
+    fs::create_directories(outDir);
+
+    std::cout << "Threads: " << MiEngine::ThreadPool::getInstance().getThreadCount() + 1 << " (pool + caller)\n";
+    uint64_t totalUncompressed = 0;
+    uint64_t totalBaked = 0;
+    double totalMs = 0.0;
+    bool ok = true;
+
+    if (std::string(argv[1]) == "--synthetic") {
+        uint32_t size = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 2048;
+        const SyntheticTexture textures[] = {
+            { "albedo", TextureType::Diffuse },
+            { "normal", TextureType::Normal },
+            { "roughness", TextureType::Roughness },
+            { "metallicRoughness", TextureType::MetallicRoughness },
+        };
+
+        printHeader();
+        for (const auto& texture : textures) {
+            std::vector<uint8_t> pixels = generatePixels(texture.type, size);
+            fs::path cachePath = outDir / (texture.name + ".ktx2");
+            TextureBakeStats stats;
+            if (!TextureCache::bakePixels(pixels.data(), size, size, cachePath, texture.name, texture.type, &stats)) {
+                ok = false;
+                continue;
+            }
+            printRow(texture.name, stats);
+            totalUncompressed += stats.uncompressedBytes;
+            totalBaked += stats.bakedBytes;
+            totalMs += stats.totalMs;
+        }
+    } else {
+        printHeader();
+        for (int i = 1; i < argc; ++i) {
+            fs::path source = argv[i];
+            TextureType type = TextureCache::guessTextureType(source);
+            fs::path cachePath = outDir / (source.stem().string() + ".ktx2");
+            TextureBakeStats stats;
+            if (!TextureCache::bake(source, cachePath, type, &stats)) {
+                ok = false;
+                continue;
+            }
+            printRow(source.filename().string(), stats);
+            totalUncompressed += stats.uncompressedBytes;
+            totalBaked += stats.bakedBytes;
+            totalMs += stats.totalMs;
+        }
+    }
+
+    if (totalUncompressed > 0) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Total: " << totalMs << " ms, " << totalUncompressed / 1048576.0 << " MB -> "
+                  << totalBaked / 1048576.0 << " MB of texture memory" << std::endl;
+    }
+
+    fs::remove_all(outDir);
+    return ok ? 0 : 1;
+}
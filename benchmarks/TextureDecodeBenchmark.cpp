@@ -0,0 +1,115 @@
+// TextureDecoder benchmark: serial vs pooled decode of a model's textures.
+//
+// Usage:
+//   TextureDecodeBenchmark <image> [<image> ...]
+//
+// Each image is decoded once per pass (type guessed from the name):
+//   source serial    - stb_image decode one after another (the old Scene::loadTexture path)
+//   source parallel  - every decode queued on the ThreadPool at once, then waited for
+//   baked serial     - mapping the KTX2 bakes one after another
+//   baked parallel   - mapping the KTX2 bakes on the ThreadPool
+// Bakes are written to a temporary directory and removed afterwards. GPU upload time
+// is not included; Scene logs it per batch ("Scene: Loaded N/N textures ...").
+
+#include "texture/TextureDecoder.h"
+#include "core/ThreadPool.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace {
+
+using MiEngine::DecodedTexture;
+using MiEngine::TextureCache;
+using MiEngine::TextureDecoder;
+
+struct Source {
+    std::string path;
+    TextureType type;
+};
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Returns false if any texture failed to decode
+bool runSerial(const std::vector<Source>& sources, double& outMs) {
+    bool ok = true;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& source : sources) {
+        ok &= TextureDecoder::decode(source.path, source.type, false) != nullptr;
+    }
+    outMs = elapsedMs(start);
+    return ok;
+}
+
+bool runParallel(const std::vector<Source>& sources, double& outMs) {
+    bool ok = true;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::shared_future<std::shared_ptr<DecodedTexture>>> futures;
+    for (const auto& source : sources) {
+        futures.push_back(TextureDecoder::decodeAsync(source.path, source.type, false));
+    }
+    for (auto& future : futures) {
+        ok &= future.get() != nullptr;
+    }
+    outMs = elapsedMs(start);
+    return ok;
+}
+
+void printRow(const std::string& pass, double ms, double baselineMs) {
+    std::cout << std::left << std::setw(18) << pass << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << ms << std::setw(9) << baselineMs / ms << "x" << std::defaultfloat << "\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: TextureDecodeBenchmark <image>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<Source> sources;
+    for (int i = 1; i < argc; ++i) {
+        fs::path path = fs::absolute(argv[i]);
+        sources.push_back({ path.string(), TextureCache::guessTextureType(path) });
+    }
+
+    // With no project open the default cache directory is relative to the working directory
+    fs::path workDir = fs::temp_directory_path() / "miengine_texture_decode";
+    fs::create_directories(workDir);
+    fs::path originalDir = fs::current_path();
+    fs::current_path(workDir);
+
+    std::cout << "Threads: " << MiEngine::ThreadPool::getInstance().getThreadCount() + 1 << " (pool + caller), "
+              << sources.size() << " textures\n";
+    std::cout << std::left << std::setw(18) << "Pass" << std::right << std::setw(10) << "ms" << std::setw(10) << "Speedup"
+              << "\n";
+
+    bool ok = true;
+    double serialMs = 0.0;
+    double parallelMs = 0.0;
+    ok &= runSerial(sources, serialMs);
+    ok &= runParallel(sources, parallelMs);
+    printRow("source serial", serialMs, serialMs);
+    printRow("source parallel", parallelMs, serialMs);
+
+    for (const auto& source : sources) {
+        fs::path cachePath = TextureCache::getCachePath(source.path, TextureCache::getDefaultCacheDir(), source.type);
+        ok &= TextureCache::bake(source.path, cachePath, source.type);
+    }
+    ok &= runSerial(sources, serialMs);
+    ok &= runParallel(sources, parallelMs);
+    printRow("baked serial", serialMs, serialMs);
+    printRow("baked parallel", parallelMs, serialMs);
+
+    fs::current_path(originalDir);
+    fs::remove_all(workDir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+// TextureStreamer benchmark: a camera flying down a corridor of textured panels.
+//
+// Usage:
+//   TextureStreamerBenchmark [panelCount] [frames]    (defaults 512, 600)
+//
+// Every panel has its own 2048x2048 BC7 texture (full chain 5.3 MB). The camera moves
+// along the corridor and back; each frame every panel in front of it requests the mip
+// for its projected size, as Scene::draw() does, then update() runs. A recording
+// backend stands in for the uploader and fails every 17th change so the rollback is
+// exercised. Passes:
+//   roomy  - budget holds every visible texture at the mip it needs
+//   tight  - budget is a quarter of that; least recently used textures give up mips
+// Each pass checks after every update that:
+//   - resident bytes stay within the budget (unless the backend just failed an eviction)
+//   - the uploads of one update stay within the upload limit (a single texture may exceed it)
+//   - no texture drops below its tail mip
+//   - the backend and the streamer agree on every texture's resident mip
+// and, once the camera stops, that the roomy pass reaches every wanted mip.
+// Returns non-zero if any check fails.
+
+#include "texture/TextureStreamer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using namespace MiEngine;
+
+constexpr uint32_t TEXTURE_SIZE = 2048;
+constexpr float PANEL_SPACING = 4.0f;
+constexpr float VIEWPORT_HEIGHT = 1080.0f;
+
+// BC7: 16 bytes per 4x4 block
+std::vector<uint64_t> bc7MipBytes(uint32_t size) {
+    std::vector<uint64_t> bytes;
+    for (uint32_t s = size; ; s /= 2) {
+        uint64_t blocks = std::max(s / 4, 1u);
+        bytes.push_back(blocks * blocks * 16);
+        if (s == 1) {
+            break;
+        }
+    }
+    return bytes;
+}
+
+// Tracks residency on its own so it can check every change against what it last applied
+class RecordingBackend : public TextureStreamingBackend {
+public:
+    std::vector<uint32_t> residentMips;
+    std::vector<uint64_t> mipBytes;
+    uint64_t changeCount = 0;
+    uint64_t lastUploadBytes = 0;    // Bytes of the textures that gained mips in the last call
+    uint32_t lastUploadCount = 0;
+    uint32_t lastFailedEvictions = 0;   // A failed eviction leaves the memory in use, so over budget
+    uint32_t mismatches = 0;
+    bool failChanges = true;
+
+    void applyResidency(std::vector<TextureResidencyChange>& changes) override {
+        lastUploadBytes = 0;
+        lastUploadCount = 0;
+        lastFailedEvictions = 0;
+        for (auto& change : changes) {
+            if (change.fromMip != residentMips[change.textureId]) {
+                ++mismatches;
+            }
+            if (++changeCount % 17 == 0 && failChanges) {
+                change.applied = false;
+                lastFailedEvictions += change.toMip > change.fromMip ? 1 : 0;
+                continue;
+            }
+            if (change.toMip < change.fromMip) {
+                for (uint32_t mip = change.toMip; mip < mipBytes.size(); ++mip) {
+                    lastUploadBytes += mipBytes[mip];
+                }
+                ++lastUploadCount;
+            }
+            residentMips[change.textureId] = change.toMip;
+        }
+    }
+};
+
+struct PassResult {
+    double updateUs = 0.0;
+    uint64_t uploads = 0;
+    uint64_t evictions = 0;
+    uint64_t peakResident = 0;
+    uint32_t failures = 0;
+};
+
+// Camera z for a frame: down the corridor for the first half, back for the second
+float cameraZ(uint32_t frame, uint32_t frames, uint32_t panelCount) {
+    float length = PANEL_SPACING * static_cast<float>(panelCount);
+    float t = static_cast<float>(frame) / static_cast<float>(frames / 2);
+    return t <= 1.0f ? -t * length : -(2.0f - t) * length;
+}
+
+// Requests mips for every panel from a camera at z, looking down -z; returns the bytes they need
+uint64_t requestVisible(TextureStreamer& streamer, const std::vector<uint32_t>& ids, const std::vector<uint64_t>& mipBytes,
+                        float z, const glm::mat4& proj) {
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.5f, z + 2.0f), glm::vec3(0.0f, 1.5f, z - 1.0f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    uint64_t required = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        // Panels alternate between the two walls
+        float side = i % 2 == 0 ? -2.0f : 2.0f;
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(side, 1.5f, -PANEL_SPACING * static_cast<float>(i)));
+        float screenSize = TextureStreamer::computeScreenSize(glm::vec3(-0.5f, -1.0f, 0.0f), glm::vec3(0.5f, 1.0f, 0.0f),
+                                                              model, view, proj, VIEWPORT_HEIGHT);
+        if (screenSize <= 0.0f) {
+            continue;
+        }
+        streamer.requestScreenSize(ids[i], screenSize);
+        uint32_t mip = streamer.computeRequiredMip(TEXTURE_SIZE, TEXTURE_SIZE, static_cast<uint32_t>(mipBytes.size()),
+                                                   screenSize);
+        mip = std::min(mip, streamer.getTailMip(TEXTURE_SIZE, TEXTURE_SIZE, static_cast<uint32_t>(mipBytes.size())));
+        for (; mip < mipBytes.size(); ++mip) {
+            required += mipBytes[mip];
+        }
+    }
+    return required;
+}
+
+PassResult runPass(uint32_t panelCount, uint32_t frames, uint64_t budgetBytes, bool expectConverged) {
+    TextureStreamingSettings settings;
+    settings.budgetBytes = budgetBytes;
+
+    RecordingBackend backend;
+    backend.mipBytes = bc7MipBytes(TEXTURE_SIZE);
+    TextureStreamer streamer(backend, settings);
+
+    const uint32_t mipCount = static_cast<uint32_t>(backend.mipBytes.size());
+    const uint32_t tailMip = streamer.getTailMip(TEXTURE_SIZE, TEXTURE_SIZE, mipCount);
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < panelCount; ++i) {
+        ids.push_back(streamer.registerTexture(TEXTURE_SIZE, TEXTURE_SIZE, backend.mipBytes, tailMip));
+        backend.residentMips.push_back(tailMip);
+    }
+
+    glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    PassResult result;
+    double totalUs = 0.0;
+
+    // The camera path, then a few still frames at the end for the streamer to catch up
+    const uint32_t settleFrames = 64;
+    for (uint32_t frame = 0; frame < frames + settleFrames; ++frame) {
+        float z = cameraZ(std::min(frame, frames), frames, panelCount);
+        requestVisible(streamer, ids, backend.mipBytes, z, proj);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        streamer.update();
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+
+        const TextureStreamingStats& stats = streamer.getStats();
+        result.uploads += stats.uploads;
+        result.evictions += stats.evictions;
+        result.peakResident = std::max(result.peakResident, streamer.getResidentBytes());
+
+        if (streamer.getResidentBytes() > settings.budgetBytes && backend.lastFailedEvictions == 0) {
+            std::cerr << "  frame " << frame << ": " << streamer.getResidentBytes() << " bytes resident, budget "
+                      << settings.budgetBytes << "\n";
+            ++result.failures;
+        }
+        if (backend.lastUploadCount > 1 && backend.lastUploadBytes > settings.maxUploadBytesPerUpdate) {
+            std::cerr << "  frame " << frame << ": uploaded " << backend.lastUploadBytes << " bytes in "
+                      << backend.lastUploadCount << " textures\n";
+            ++result.failures;
+        }
+        for (size_t i = 0; i < ids.size(); ++i) {
+            uint32_t resident = streamer.getResidentMip(ids[i]);
+            if (resident > tailMip || resident != backend.residentMips[i]) {
+                std::cerr << "  frame " << frame << ": texture " << i << " resident mip " << resident
+                          << ", backend " << backend.residentMips[i] << ", tail " << tailMip << "\n";
+                ++result.failures;
+            }
+        }
+    }
+    result.failures += backend.mismatches;
+
+    // Still camera: with every change succeeding, one more frame must not leave anything wanted behind
+    if (expectConverged) {
+        backend.failChanges = false;
+        requestVisible(streamer, ids, backend.mipBytes, cameraZ(frames, frames, panelCount), proj);
+        streamer.update();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (streamer.getResidentMip(ids[i]) > streamer.getWantedMip(ids[i])) {
+                std::cerr << "  texture " << i << " stuck at mip " << streamer.getResidentMip(ids[i]) << ", wants "
+                          << streamer.getWantedMip(ids[i]) << "\n";
+                ++result.failures;
+            }
+        }
+    }
+
+    result.updateUs = totalUs / (frames + settleFrames);
+    return result;
+}
+
+void printRow(const char* pass, uint64_t budgetBytes, const PassResult& result) {
+    std::cout << std::left << std::setw(8) << pass << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << budgetBytes / (1024.0 * 1024.0) << std::setw(10) << result.peakResident / (1024.0 * 1024.0)
+              << std::setw(10) << result.updateUs << std::setw(10) << result.uploads << std::setw(10) << result.evictions
+              << std::setw(10) << result.failures << std::defaultfloat << "\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t panelCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 512;
+    uint32_t frames = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 600;
+    panelCount = std::max(panelCount, 2u);
+    frames = std::max(frames, 2u);
+
+    // Size the roomy budget from the most any camera position on the path needs
+    TextureStreamingSettings settings;
+    RecordingBackend probeBackend;
+    std::vector<uint64_t> mipBytes = bc7MipBytes(TEXTURE_SIZE);
+    TextureStreamer probe(probeBackend, settings);
+    std::vector<uint32_t> ids;
+    uint32_t tailMip = probe.getTailMip(TEXTURE_SIZE, TEXTURE_SIZE, static_cast<uint32_t>(mipBytes.size()));
+    for (uint32_t i = 0; i < panelCount; ++i) {
+        ids.push_back(probe.registerTexture(TEXTURE_SIZE, TEXTURE_SIZE, mipBytes, tailMip));
+    }
+    glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    uint64_t peakRequired = 0;
+    for (uint32_t frame = 0; frame <= frames; ++frame) {
+        peakRequired = std::max(peakRequired, requestVisible(probe, ids, mipBytes, cameraZ(frame, frames, panelCount), proj));
+    }
+
+    uint64_t tailBytes = 0;
+    for (uint32_t mip = tailMip; mip < mipBytes.size(); ++mip) {
+        tailBytes += mipBytes[mip];
+    }
+    uint64_t roomyBudget = peakRequired + tailBytes * panelCount;
+    uint64_t tightBudget = std::max(roomyBudget / 4, tailBytes * panelCount);
+
+    std::cout << panelCount << " panels, " << frames << " frames, " << TEXTURE_SIZE << "x" << TEXTURE_SIZE
+              << " BC7, tail " << (TEXTURE_SIZE >> tailMip) << " px\n";
+    std::cout << std::left << std::setw(8) << "Pass" << std::right << std::setw(10) << "budget MB" << std::setw(10)
+              << "peak MB" << std::setw(10) << "us/update" << std::setw(10) << "uploads" << std::setw(10) << "evictions"
+              << std::setw(10) << "failures" << "\n";
+
+    PassResult roomy = runPass(panelCount, frames, roomyBudget, true);
+    printRow("roomy", roomyBudget, roomy);
+    PassResult tight = runPass(panelCount, frames, tightBudget, false);
+    printRow("tight", tightBudget, tight);
+
+    return roomy.failures == 0 && tight.failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+// MiTransformSystem benchmark: world matrices of a large scene component hierarchy.
+//
+// Usage:
+//   TransformHierarchyBenchmark [componentCount] [frames]    (defaults 100000, 60)
+//
+// A forest of binary trees, 63 components each (6 levels). Every frame 10% of the
+// components get a new local rotation, then every world matrix is read once, as the
+// renderer does. Passes, ms per frame:
+//   recursive - the previous MiSceneComponent: cached world per component, rebuilt on
+//               read by recursing up, dirty marks walking the children, a mat4 per read
+//   serial    - MiTransformSystem::propagate() on one thread, then cached matrix reads
+//   parallel  - the same with large levels split across the JobSystem
+// "propagate" is the pass alone; "max err" compares the last frame's matrices with
+// recursive.
+//
+// Spawn-heavy pass: on top of the parallel pass, every frame destroys the oldest
+// spawned trees and spawns as many new ones (1% of the components), each attached
+// under a component of the live hierarchy, as a frame full of projectiles and effects does. "moved" is the slots propagate() moved deeper per
+// frame, "sorts" the full depth sorts over all frames; "max err" compares the spawned
+// trees with their parent chains composed by hand. Returns non-zero if an error
+// exceeds 1e-3.
+
+#include "core/MiSceneComponent.h"
+#include "core/MiTransformSystem.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using namespace MiEngine;
+
+constexpr size_t TREE_SIZE = 63;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+size_t parentIndex(size_t index) {
+    size_t local = index % TREE_SIZE;
+    return local == 0 ? SIZE_MAX : index - local + (local - 1) / 2;
+}
+
+MiTransform initialTransform(size_t index) {
+    float f = static_cast<float>(index);
+    return MiTransform(glm::vec3(std::sin(f) * 2.0f, 1.0f, std::cos(f) * 2.0f),
+                       glm::angleAxis(f * 0.1f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))),
+                       glm::vec3(1.0f + 0.01f * static_cast<float>(index % 5)));
+}
+
+glm::quat animatedRotation(size_t index, int frame) {
+    return glm::angleAxis(static_cast<float>(frame) * 0.05f + static_cast<float>(index), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+bool animates(size_t index, int frame) {
+    return (index + static_cast<size_t>(frame)) % 10 == 0;
+}
+
+// The previous MiSceneComponent transform cache
+struct RecursiveNode {
+    MiTransform local;
+    mutable MiTransform world;
+    mutable bool dirty = true;
+    RecursiveNode* parent = nullptr;
+    std::vector<RecursiveNode*> children;
+
+    void markDirty() {
+        dirty = true;
+        for (auto* child : children) {
+            child->markDirty();
+        }
+    }
+
+    const MiTransform& getWorld() const {
+        if (dirty) {
+            world = parent ? parent->getWorld() * local : local;
+            dirty = false;
+        }
+        return world;
+    }
+};
+
+// World matrix of component composed up its parent chain, without MiTransformSystem's cache
+glm::mat4 composedWorld(const MiSceneComponent* component) {
+    MiTransform world = component->getLocalTransform();
+    for (const MiSceneComponent* parent = component->getParent(); parent; parent = parent->getParent()) {
+        world = parent->getLocalTransform() * world;
+    }
+    return world.getMatrix();
+}
+
+using Tree = std::vector<std::shared_ptr<MiSceneComponent>>;
+
+// A new tree whose root is attached under socket (or a root itself if null)
+Tree spawnTree(size_t seed, MiSceneComponent* socket) {
+    Tree tree(TREE_SIZE);
+    for (size_t i = 0; i < TREE_SIZE; ++i) {
+        tree[i] = std::make_shared<MiSceneComponent>();
+        size_t parent = parentIndex(i);
+        tree[i]->attachTo(parent == SIZE_MAX ? socket : tree[parent].get(), false);
+        tree[i]->setLocalTransform(initialTransform(seed + i));
+    }
+    return tree;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t componentCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+    if (componentCount == 0 || frames <= 0) {
+        std::cerr << "Usage: TransformHierarchyBenchmark [componentCount] [frames]" << std::endl;
+        return 1;
+    }
+
+    JobSystem& jobSystem = JobSystem::getInstance();
+    MiTransformSystem& transforms = MiTransformSystem::getInstance();
+
+    std::cout << "Threads: " << jobSystem.getWorkerCount() + 1 << " (workers + main)\n";
+    std::cout << "Components: " << componentCount << ", frames: " << frames << "\n";
+    std::cout << std::right << std::setw(10) << "Pass" << std::setw(12) << "ms/frame" << std::setw(12) << "propagate"
+              << std::setw(10) << "updated" << std::setw(10) << "max err" << "\n";
+
+    // Sum of the matrices read each frame, so the reads can't be optimized away
+    float checksum = 0.0f;
+
+    std::vector<RecursiveNode> nodes(componentCount);
+    for (size_t i = 0; i < componentCount; ++i) {
+        nodes[i].local = initialTransform(i);
+        size_t parent = parentIndex(i);
+        if (parent != SIZE_MAX) {
+            nodes[i].parent = &nodes[parent];
+            nodes[parent].children.push_back(&nodes[i]);
+        }
+    }
+
+    std::vector<glm::mat4> reference(componentCount);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t i = 0; i < componentCount; ++i) {
+            if (animates(i, frame)) {
+                nodes[i].local.rotation = animatedRotation(i, frame);
+                nodes[i].markDirty();
+            }
+        }
+        for (size_t i = 0; i < componentCount; ++i) {
+            reference[i] = nodes[i].getWorld().getMatrix();
+            checksum += reference[i][3][0];
+        }
+    }
+    double recursiveMs = elapsedMs(start) / frames;
+
+    std::cout << std::setw(10) << "recursive" << std::fixed << std::setprecision(2) << std::setw(12) << recursiveMs
+              << std::setw(12) << "-" << std::setw(10) << "-" << std::setw(10) << "-" << "\n";
+
+    std::vector<std::shared_ptr<MiSceneComponent>> components;
+    components.reserve(componentCount);
+    for (size_t i = 0; i < componentCount; ++i) {
+        components.push_back(std::make_shared<MiSceneComponent>());
+    }
+
+    struct Pass {
+        const char* name;
+        bool parallel;
+    };
+    const Pass passes[] = { { "serial", false }, { "parallel", true } };
+
+    for (const Pass& pass : passes) {
+        for (size_t i = 0; i < componentCount; ++i) {
+            size_t parent = parentIndex(i);
+            components[i]->attachTo(parent == SIZE_MAX ? nullptr : components[parent].get(), false);
+            components[i]->setLocalTransform(initialTransform(i));
+        }
+        transforms.setParallelPropagation(pass.parallel);
+        transforms.propagate();
+
+        std::vector<glm::mat4> matrices(componentCount);
+        double propagateMs = 0.0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (size_t i = 0; i < componentCount; ++i) {
+                if (animates(i, frame)) {
+                    components[i]->setLocalRotation(animatedRotation(i, frame));
+                }
+            }
+
+            auto propagateStart = std::chrono::high_resolution_clock::now();
+            transforms.propagate();
+            propagateMs += elapsedMs(propagateStart);
+
+            for (size_t i = 0; i < componentCount; ++i) {
+                matrices[i] = components[i]->getWorldMatrix();
+                checksum += matrices[i][3][0];
+            }
+        }
+        double frameMs = elapsedMs(start) / frames;
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < componentCount; ++i) {
+            for (int column = 0; column < 4; ++column) {
+                glm::vec4 delta = glm::abs(matrices[i][column] - reference[i][column]);
+                maxError = std::max({ maxError, delta.x, delta.y, delta.z, delta.w });
+            }
+        }
+
+        std::cout << std::setw(10) << pass.name << std::fixed << std::setprecision(2) << std::setw(12) << frameMs
+                  << std::setw(12) << propagateMs / frames << std::setw(10) << transforms.getStats().updatedCount
+                  << std::scientific << std::setprecision(1) << std::setw(10) << maxError << std::defaultfloat << "\n";
+    }
+
+    // Spawn-heavy: the parallel pass's hierarchy stays live and animated underneath
+    size_t treesPerFrame = std::max<size_t>(componentCount / TREE_SIZE / 100, 1);
+    size_t liveTrees = componentCount / TREE_SIZE;
+    auto socket = [&](size_t index) -> MiSceneComponent* {
+        // Any depth of a live tree, as weapons and effects attach to bone sockets
+        return liveTrees == 0 ? nullptr : components[(index % liveTrees) * TREE_SIZE + index % TREE_SIZE].get();
+    };
+    std::deque<Tree> spawned;
+    for (size_t tree = 0; tree < treesPerFrame * 4; ++tree) {
+        spawned.push_back(spawnTree(tree * TREE_SIZE, socket(tree * 13)));
+    }
+    transforms.propagate();
+    uint32_t sortsBefore = transforms.getStats().fullSortCount;
+
+    double propagateMs = 0.0;
+    uint64_t moved = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t tree = 0; tree < treesPerFrame; ++tree) {
+            spawned.pop_front();
+            size_t seed = static_cast<size_t>(frame) * treesPerFrame + tree;
+            spawned.push_back(spawnTree(seed * 7, socket(seed * 13)));
+        }
+        for (size_t i = 0; i < componentCount; ++i) {
+            if (animates(i, frame)) {
+                components[i]->setLocalRotation(animatedRotation(i, frame));
+            }
+        }
+
+        auto propagateStart = std::chrono::high_resolution_clock::now();
+        transforms.propagate();
+        propagateMs += elapsedMs(propagateStart);
+        moved += transforms.getStats().movedCount;
+
+        for (size_t i = 0; i < componentCount; ++i) {
+            checksum += components[i]->getWorldMatrix()[3][0];
+        }
+    }
+    double frameMs = elapsedMs(start) / frames;
+    MiTransformSystem::Stats stats = transforms.getStats();
+
+    float maxError = 0.0f;
+    for (const Tree& tree : spawned) {
+        for (const auto& component : tree) {
+            glm::mat4 matrix = component->getWorldMatrix();
+            glm::mat4 expected = composedWorld(component.get());
+            for (int column = 0; column < 4; ++column) {
+                glm::vec4 delta = glm::abs(matrix[column] - expected[column]);
+                maxError = std::max({ maxError, delta.x, delta.y, delta.z, delta.w });
+            }
+        }
+    }
+
+    std::cout << "\nSpawn-heavy: " << treesPerFrame * TREE_SIZE << " components destroyed and spawned per frame\n";
+    std::cout << std::setw(10) << "ms/frame" << std::setw(12) << "propagate" << std::setw(10) << "moved"
+              << std::setw(8) << "sorts" << std::setw(10) << "slots" << std::setw(8) << "levels" << std::setw(10)
+              << "max err" << "\n";
+    std::cout << std::fixed << std::setprecision(2) << std::setw(10) << frameMs << std::setw(12) << propagateMs / frames
+              << std::setw(10) << moved / static_cast<uint64_t>(frames) << std::setw(8) << stats.fullSortCount - sortsBefore
+              << std::setw(10) << stats.slotCount << std::setw(8) << stats.levelCount << std::scientific
+              << std::setprecision(1) << std::setw(10) << maxError << std::defaultfloat << "\n";
+
+    std::cout << "(checksum " << checksum << ")\n";
+    return maxError <= 1e-3f ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+// Type hierarchy benchmark: registry ancestor bitsets against RTTI and parent walks.
+//
+// Usage:
+//   TypeCastBenchmark [objectCount] [passes]    (defaults 1024, 2000)
+//
+// Objects are a random mix of a registered 8-deep chain (Depth0..Depth7) and
+// side branches off it. Each pass downcasts every object to one target, ns per
+// object:
+//   dynamic_ptr  - std::dynamic_pointer_cast (the previous casts)
+//   Cast<T>(ptr) - MiEngine::Cast on the shared_ptr
+//   dynamic_cast - raw pointer
+//   Cast<T>      - raw pointer
+//   walk         - isDerivedFrom by following parent ids (the previous registry)
+//   bitset       - MiTypeRegistry::isDerivedFromIndex, the bit test isA uses
+// "hits" must agree across columns. The default set stays in cache; with
+// 100k+ objects every column converges on the cost of loading the object.
+// Build Release: with NDEBUG unset, Cast also runs dynamic_cast on every object
+// to assert that both agree.
+
+#include "core/MiObject.h"
+#include "core/MiTypeRegistry.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace MiEngine;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+class Depth0 : public MiObject {
+    MI_OBJECT_BODY(Depth0, 2000)
+public:
+    int value = 1;
+};
+
+class Depth1 : public Depth0 { MI_OBJECT_BODY(Depth1, 2001) };
+class Depth2 : public Depth1 { MI_OBJECT_BODY(Depth2, 2002) };
+class Depth3 : public Depth2 { MI_OBJECT_BODY(Depth3, 2003) };
+class Depth4 : public Depth3 { MI_OBJECT_BODY(Depth4, 2004) };
+class Depth5 : public Depth4 { MI_OBJECT_BODY(Depth5, 2005) };
+class Depth6 : public Depth5 { MI_OBJECT_BODY(Depth6, 2006) };
+class Depth7 : public Depth6 { MI_OBJECT_BODY(Depth7, 2007) };
+
+class Side1 : public Depth0 { MI_OBJECT_BODY(Side1, 2101) };
+class Side3 : public Depth2 { MI_OBJECT_BODY(Side3, 2103) };
+class Side5 : public Depth4 { MI_OBJECT_BODY(Side5, 2105) };
+class Side7 : public Depth6 { MI_OBJECT_BODY(Side7, 2107) };
+
+} // anonymous namespace
+
+MI_REGISTER_TYPE(Depth0)
+MI_REGISTER_TYPE_WITH_PARENT(Depth1, Depth0)
+MI_REGISTER_TYPE_WITH_PARENT(Depth2, Depth1)
+MI_REGISTER_TYPE_WITH_PARENT(Depth3, Depth2)
+MI_REGISTER_TYPE_WITH_PARENT(Depth4, Depth3)
+MI_REGISTER_TYPE_WITH_PARENT(Depth5, Depth4)
+MI_REGISTER_TYPE_WITH_PARENT(Depth6, Depth5)
+MI_REGISTER_TYPE_WITH_PARENT(Depth7, Depth6)
+MI_REGISTER_TYPE_WITH_PARENT(Side1, Depth0)
+MI_REGISTER_TYPE_WITH_PARENT(Side3, Depth2)
+MI_REGISTER_TYPE_WITH_PARENT(Side5, Depth4)
+MI_REGISTER_TYPE_WITH_PARENT(Side7, Depth6)
+
+namespace {
+
+const char* const TYPE_NAMES[] = {"Depth0", "Depth1", "Depth2", "Depth3", "Depth4", "Depth5",
+                                  "Depth6", "Depth7", "Side1",  "Side3",  "Side5",  "Side7"};
+
+// The previous MiTypeRegistry::isDerivedFrom
+bool isDerivedFromWalk(const MiTypeRegistry& registry, uint32_t typeId, uint32_t parentTypeId) {
+    if (typeId == parentTypeId) {
+        return true;
+    }
+    const TypeInfo* info = registry.getTypeInfoById(typeId);
+    if (!info) {
+        return false;
+    }
+    uint32_t currentParent = info->parentTypeId;
+    while (currentParent != 0) {
+        if (currentParent == parentTypeId) {
+            return true;
+        }
+        const TypeInfo* parentInfo = registry.getTypeInfoById(currentParent);
+        if (!parentInfo) {
+            break;
+        }
+        currentParent = parentInfo->parentTypeId;
+    }
+    return false;
+}
+
+struct Timing {
+    double ns = 0.0;
+    long long hits = 0;
+};
+
+template<typename F>
+Timing measure(const std::vector<std::shared_ptr<MiObject>>& objects, int passes, F&& test) {
+    Timing timing;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& object : objects) {
+            timing.hits += test(object);
+        }
+    }
+    timing.ns = elapsedMs(start) * 1.0e6 / (static_cast<double>(passes) * objects.size());
+    return timing;
+}
+
+template<typename T>
+bool runTarget(const std::vector<std::shared_ptr<MiObject>>& objects, int passes) {
+    const MiTypeRegistry& registry = MiTypeRegistry::getInstance();
+
+    Timing results[] = {
+        measure(objects, passes, [](const std::shared_ptr<MiObject>& object) {
+            auto cast = std::dynamic_pointer_cast<T>(object);
+            return cast ? cast->value : 0;
+        }),
+        measure(objects, passes, [](const std::shared_ptr<MiObject>& object) {
+            auto cast = Cast<T>(object);
+            return cast ? cast->value : 0;
+        }),
+        measure(objects, passes, [](const std::shared_ptr<MiObject>& object) {
+            T* cast = dynamic_cast<T*>(object.get());
+            return cast ? cast->value : 0;
+        }),
+        measure(objects, passes, [](const std::shared_ptr<MiObject>& object) {
+            T* cast = Cast<T>(object.get());
+            return cast ? cast->value : 0;
+        }),
+        measure(objects, passes, [&registry](const std::shared_ptr<MiObject>& object) {
+            return isDerivedFromWalk(registry, object->getTypeId(), T::StaticTypeId) ? 1 : 0;
+        }),
+        measure(objects, passes, [&registry](const std::shared_ptr<MiObject>& object) {
+            return registry.isDerivedFromIndex(object->getTypeIndex(), MiTypeRegistry::typeIndexOf<T>()) ? 1 : 0;
+        }),
+    };
+
+    bool match = true;
+    std::cout << std::setw(8) << T::StaticTypeName << std::fixed << std::setprecision(2);
+    for (const Timing& timing : results) {
+        match = match && timing.hits == results[0].hits;
+        std::cout << std::setw(13) << timing.ns;
+    }
+    std::cout << std::setw(10) << results[0].hits / passes << (match ? "" : "  MISMATCH") << "\n";
+    return match;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t objectCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1024;
+    int passes = argc > 2 ? std::atoi(argv[2]) : 2000;
+    if (objectCount == 0 || passes <= 0) {
+        std::cerr << "Usage: TypeCastBenchmark [objectCount] [passes]" << std::endl;
+        return 1;
+    }
+
+    MiTypeRegistry& registry = MiTypeRegistry::getInstance();
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pickType(0, std::size(TYPE_NAMES) - 1);
+    std::vector<std::shared_ptr<MiObject>> objects;
+    objects.reserve(objectCount);
+    for (size_t i = 0; i < objectCount; ++i) {
+        objects.push_back(registry.create(TYPE_NAMES[pickType(rng)]));
+    }
+
+    std::cout << "Objects: " << objectCount << " over " << std::size(TYPE_NAMES) << " types, passes: " << passes
+              << " (ns per object)\n";
+    std::cout << std::right << std::setw(8) << "Target" << std::setw(13) << "dynamic_ptr" << std::setw(13)
+              << "Cast<T>(ptr)" << std::setw(13) << "dynamic_cast" << std::setw(13) << "Cast<T>" << std::setw(13)
+              << "walk" << std::setw(13) << "bitset" << std::setw(10) << "hits" << "\n";
+
+    bool ok = runTarget<Depth0>(objects, passes);
+    ok = runTarget<Depth3>(objects, passes) && ok;
+    ok = runTarget<Depth6>(objects, passes) && ok;
+    ok = runTarget<Side5>(objects, passes) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// MiTickScheduler benchmark: a scene of ticking actors updated the way MiWorld::tick does it.
+//
+// Usage:
+//   WorldTickBenchmark [actorCount] [frames]    (defaults 100000, 60)
+//
+// Every actor has a tickable MoverComponent (integrates a velocity and a spin, a few
+// dozen flops of gameplay movement). Passes, ms per frame:
+//   loop      - the old MiWorld::tick: every actor in world order on the main thread
+//   serial    - scheduler, no actor thread-safe (same order as loop)
+//   parallel  - scheduler, every actor thread-safe
+//   mixed     - 10% not thread-safe, every 8th actor waits for the actor two before it (two levels),
+//               a quarter of the actors in PostPhysics
+// "rebuild" is the schedule build after the scene changed; "levels" adds up the levels
+// of every group (mixed: 2 in PrePhysics + 1 in PostPhysics); "max err" compares each
+// pass's final positions with loop.
+
+#include "core/MiActor.h"
+#include "core/MiComponent.h"
+#include "core/JobSystem.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using namespace MiEngine;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+class MoverComponent : public MiComponent {
+    MI_OBJECT_BODY(MoverComponent, 1000)
+
+public:
+    bool isTickable() const override { return true; }
+    bool isTickThreadSafe() const override { return true; }
+
+    void tick(float deltaTime) override {
+        for (int step = 0; step < 4; ++step) {
+            angle += spin * deltaTime;
+            glm::vec3 heading(std::cos(angle), 0.0f, std::sin(angle));
+            velocity = velocity * 0.99f + heading * (0.5f * deltaTime);
+            position += velocity * deltaTime;
+        }
+    }
+
+    void reset(size_t index) {
+        position = glm::vec3(float(index % 317), 0.0f, float(index / 317));
+        velocity = glm::vec3(0.0f);
+        angle = 0.0f;
+        spin = 0.5f + float(index % 7) * 0.1f;
+    }
+
+    glm::vec3 position;
+    glm::vec3 velocity;
+    float angle = 0.0f;
+    float spin = 1.0f;
+};
+
+class BenchActor : public MiActor {
+    MI_OBJECT_BODY(BenchActor, 1001)
+};
+
+struct Scene {
+    std::vector<std::shared_ptr<MiActor>> actors;
+    std::vector<std::shared_ptr<MoverComponent>> movers;
+
+    void reset() {
+        for (size_t i = 0; i < movers.size(); ++i) {
+            movers[i]->reset(i);
+        }
+    }
+};
+
+void configure(Scene& scene, bool threadSafe, bool mixed) {
+    for (size_t i = 0; i < scene.actors.size(); ++i) {
+        MiActor& actor = *scene.actors[i];
+        actor.setTickThreadSafe(threadSafe && !(mixed && i % 10 == 0));
+        actor.setTickGroup(mixed && i % 4 == 3 ? TickGroup::PostPhysics : TickGroup::PrePhysics);
+        if (i >= 2) {
+            actor.removeTickPrerequisite(scene.actors[i - 2]);
+            if (mixed && i % 8 == 0) {
+                actor.addTickPrerequisite(scene.actors[i - 2]);
+            }
+        }
+    }
+}
+
+float maxPositionError(const std::vector<glm::vec3>& reference, const Scene& scene) {
+    float maxError = 0.0f;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        glm::vec3 delta = glm::abs(reference[i] - scene.movers[i]->position);
+        maxError = std::max({ maxError, delta.x, delta.y, delta.z });
+    }
+    return maxError;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t actorCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+    if (actorCount == 0 || frames <= 0) {
+        std::cerr << "Usage: WorldTickBenchmark [actorCount] [frames]" << std::endl;
+        return 1;
+    }
+
+    const float deltaTime = 1.0f / 60.0f;
+    JobSystem& jobSystem = JobSystem::getInstance();
+
+    Scene scene;
+    scene.actors.reserve(actorCount);
+    scene.movers.reserve(actorCount);
+    for (size_t i = 0; i < actorCount; ++i) {
+        auto actor = std::make_shared<BenchActor>();
+        scene.movers.push_back(actor->addComponent<MoverComponent>());
+        actor->beginPlay();
+        scene.actors.push_back(actor);
+    }
+
+    std::cout << "Threads: " << jobSystem.getWorkerCount() + 1 << " (workers + main)\n";
+    std::cout << "Actors: " << actorCount << ", frames: " << frames << "\n";
+    std::cout << std::right << std::setw(10) << "Pass" << std::setw(12) << "ms/frame" << std::setw(12) << "rebuild ms"
+              << std::setw(9) << "levels" << std::setw(10) << "parallel" << std::setw(10) << "max err" << "\n";
+
+    // The old MiWorld::tick loop
+    scene.reset();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (auto& actor : scene.actors) {
+            if (!actor->isPendingDestroy() && actor->hasBegunPlay()) {
+                actor->tick(deltaTime);
+            }
+        }
+    }
+    double loopMs = elapsedMs(start) / frames;
+
+    std::vector<glm::vec3> reference(actorCount);
+    for (size_t i = 0; i < actorCount; ++i) {
+        reference[i] = scene.movers[i]->position;
+    }
+
+    std::cout << std::setw(10) << "loop" << std::fixed << std::setprecision(2) << std::setw(12) << loopMs
+              << std::setw(12) << "-" << std::setw(9) << "-" << std::setw(10) << "-" << std::setw(10) << "-" << "\n";
+
+    struct Pass {
+        const char* name;
+        bool threadSafe;
+        bool mixed;
+    };
+    const Pass passes[] = { { "serial", false, false }, { "parallel", true, false }, { "mixed", true, true } };
+
+    for (const Pass& pass : passes) {
+        configure(scene, pass.threadSafe, pass.mixed);
+        scene.reset();
+
+        MiTickScheduler scheduler;
+        start = std::chrono::high_resolution_clock::now();
+        scheduler.rebuild(scene.actors);
+        double rebuildMs = elapsedMs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (size_t group = 0; group < static_cast<size_t>(TickGroup::Count); ++group) {
+                scheduler.tickGroup(static_cast<TickGroup>(group), deltaTime);
+            }
+        }
+        double frameMs = elapsedMs(start) / frames;
+
+        uint32_t levels = 0;
+        uint32_t parallel = 0;
+        for (size_t group = 0; group < static_cast<size_t>(TickGroup::Count); ++group) {
+            MiTickScheduler::GroupStats stats = scheduler.getGroupStats(static_cast<TickGroup>(group));
+            levels += stats.levelCount;
+            parallel += stats.parallelCount;
+        }
+
+        std::cout << std::setw(10) << pass.name << std::fixed << std::setprecision(2) << std::setw(12) << frameMs
+                  << std::setw(12) << rebuildMs << std::setw(9) << levels << std::setw(10) << parallel
+                  << std::scientific << std::setprecision(1) << std::setw(10) << maxPositionError(reference, scene)
+                  << std::defaultfloat << "\n";
+    }
+    return 0;
+}
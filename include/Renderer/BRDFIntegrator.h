@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MiEngine {
+
+struct BRDFLutSettings {
+    uint32_t resolution = 512;      // NdotV along x, roughness along y
+    uint32_t sampleCount = 256;     // GGX samples per texel (four times that below roughness 0.1)
+};
+
+/**
+ * BRDFIntegrator bakes the split-sum BRDF LUT of the specular IBL.
+ *
+ * R and G are the scale and bias applied to F0. B is the cosine-weighted
+ * average albedo E_avg of the texel's roughness row, which is what the
+ * Kulla-Conty multiple scattering term needs besides R + G: shaders add the
+ * energy single scattering loses, 1 - (R + G), tinted by
+ * F_avg^2 E_avg / (1 - F_avg (1 - E_avg)).
+ *
+ * All texels of a row share its GGX half vectors, so they are generated once
+ * per row and four NdotV texels are integrated together on SSE2; rows are
+ * spread over the ThreadPool. The LUT is stored as RGBA16F in the cache
+ * directory the caller passes (the engine's, ProjectManager::getEngineCachePath(),
+ * in the renderer), keyed by resolution and sample count, and only integrated
+ * when that file is missing.
+ */
+class BRDFIntegrator {
+public:
+    static constexpr uint32_t MAGIC = 0x4452424D;   // "MBRD"
+    static constexpr uint32_t VERSION = 1;
+
+    // resolution^2 RGBA floats, row y at roughness y / (resolution - 1)
+    static std::vector<float> integrate(const BRDFLutSettings& settings);
+
+    // RGBA16F texels from the cache file in cacheDir, or integrated and saved there
+    static std::vector<uint16_t> load(const BRDFLutSettings& settings, const fs::path& cacheDir);
+
+    // <cacheDir>/brdf_lut_<resolution>_<sampleCount>.bin
+    static fs::path getCachePath(const BRDFLutSettings& settings, const fs::path& cacheDir);
+
+    static bool save(const fs::path& cachePath, const BRDFLutSettings& settings, const std::vector<uint16_t>& texels);
+    static bool open(const fs::path& cachePath, const BRDFLutSettings& settings, std::vector<uint16_t>& outTexels);
+};
+
+} // namespace MiEngine
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "texture/MipGenerator.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MiEngine {
+
+// Equirectangular coordinates of one quadrant of a cube face (u, v >= 0),
+// for the two face shapes: the four side faces share one, +Y/-Y the other.
+// Every other quadrant and face is a mirror or a rotation of these, so one
+// table serves any HDR converted at this face size.
+struct EquirectDirectionTable {
+    uint32_t faceSize = 0;
+    uint32_t quadrantSize = 0;      // (faceSize + 1) / 2
+    std::vector<float> sideU;       // atan(u) / 2PI, depends on the column only
+    std::vector<float> sideV;       // Polar angle / PI of the +X quadrant
+    std::vector<float> topU;        // atan2(v, u) / 2PI of the +Y quadrant
+    std::vector<float> topV;        // Polar angle / PI of the +Y quadrant
+};
+
+struct EquirectSettings {
+    uint32_t faceSize = 512;
+    uint32_t mipLevels = 1;         // > 1 outputs the chain (box mips are built inside each tile)
+    MipFilter mipFilter = MipFilter::Box;
+    uint32_t tileSize = 64;         // Texels per tile edge (power of two)
+};
+
+/**
+ * EquirectConverter resamples an equirectangular HDR into a cubemap.
+ *
+ * Texel directions never change for a face size, so their equirectangular
+ * coordinates come from a shared EquirectDirectionTable; a conversion only
+ * applies each face's mirror/rotation to the table and does the bilinear
+ * fetch. Tables are built four texels at a time with a polynomial atan
+ * (|error| < 1e-6 rad, well below a texel of a 16k HDR) and kept for the
+ * next HDR of the same size.
+ *
+ * Faces are split into tiles on the ThreadPool; a tile reads a compact
+ * region of the HDR, and with the box filter it also reduces itself to the
+ * mips it covers while its texels are still in cache. The remaining small
+ * mips (and other filters) go through MipGenerator.
+ *
+ * Output uses the IBL cache layout: per mip, six tightly packed RGBA float
+ * faces (+X, -X, +Y, -Y, +Z, -Z) in the face convention of CubemapData.
+ */
+class EquirectConverter {
+public:
+    // Table for faceSize, built on first use and shared until another size is requested
+    static std::shared_ptr<const EquirectDirectionTable> getDirectionTable(uint32_t faceSize);
+
+    static EquirectDirectionTable buildDirectionTable(uint32_t faceSize);
+
+    // source holds width * height texels of channels floats (1-4); missing colour
+    // channels repeat red and alpha is 1
+    static std::vector<float> convert(const float* source, uint32_t width, uint32_t height, uint32_t channels,
+                                      const EquirectSettings& settings);
+
+    // atan(x) for x >= 0 with the approximation used by the tables
+    static float atanApprox(float x);
+};
+
+} // namespace MiEngine
@@ -1,12 +1,16 @@
 ﻿#pragma once
 
 #include <vulkan/vulkan.h>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include "texture/Texture.h"
+#include "Renderer/SphericalHarmonics.h"
+#include "Utils/TextureUtils.h"
 
 // Forward declarations
 class VulkanRenderer;
@@ -42,6 +46,49 @@ public:
      */
     bool initialize(const std::string& hdriPath);
     
+    /**
+     * @brief Switch to another environment without stalling the render loop
+     * 
+     * The HDR is converted and filtered on the ThreadPool and uploaded in one
+     * transfer submission; the current environment stays bound until update()
+     * sees the upload complete. Requests made meanwhile replace each other and
+     * start once the one in flight has been swapped in.
+     * 
+     * @param hdriPath Path to the HDRI environment map
+     */
+    void requestEnvironment(const std::string& hdriPath);
+    
+    /**
+     * @brief Advance background work (call once per frame)
+     * 
+     * Uploads a finished environment build, swaps it in once its upload is
+     * complete, copies the full-quality prefilter mips over the preview when
+     * the ThreadPool has filtered them, and frees replaced environments no
+     * frame can still use.
+     */
+    void update();
+    
+    /**
+     * @brief Point a frame's descriptor set at the current environment
+     * 
+     * Call after the frame's fence wait, when its previous command buffer no
+     * longer reads the set.
+     * 
+     * @param frameIndex Frame in flight
+     * @return true if the set was rewritten (the environment changed since the frame last ran)
+     */
+    bool refreshFrameDescriptors(uint32_t frameIndex);
+    
+    /**
+     * @brief Check if an environment request is being built, uploaded or queued
+     */
+    bool isEnvironmentPending() const { return pendingBuild.valid() || pendingData || !queuedHdriPath.empty(); }
+    
+    /**
+     * @brief Incremented each time a new environment is swapped in
+     */
+    uint32_t getEnvironmentVersion() const { return environmentVersion; }
+    
     /**
      * @brief Create descriptor set layout for IBL resources
      * 
@@ -94,6 +141,13 @@ public:
      */
     std::shared_ptr<Texture> getBrdfLUT() const { return brdfLUT; }
     
+    /**
+     * @brief Get the diffuse irradiance as L2 spherical harmonics
+     * 
+     * @return const MiEngine::SHL2& Coefficients evaluating to irradiance / PI
+     */
+    const MiEngine::SHL2& getIrradianceSH() const { return irradianceSH; }
+    
     /**
      * @brief Get the descriptor set layout
      * 
@@ -117,6 +171,42 @@ private:
     std::shared_ptr<Texture> irradianceMap;     // Diffuse irradiance cubemap
     std::shared_ptr<Texture> prefilterMap;      // Prefiltered environment map for specular
     std::shared_ptr<Texture> brdfLUT;           // BRDF lookup table
+    MiEngine::SHL2 irradianceSH;                // Diffuse irradiance (binding 3 uniform)
+    
+    // Full-quality prefilter mips being filtered in the background (see update())
+    std::future<std::vector<float>> prefilterRefinement;
+    TextureUtils::UploadSubmission refinementUpload;
+    
+    // Uniform buffer holding irradianceSH for the shaders (written once per environment)
+    VkBuffer irradianceSHBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory irradianceSHMemory = VK_NULL_HANDLE;
+    
+    // Environment requested through requestEnvironment(): built on a worker, then uploaded
+    std::future<std::shared_ptr<TextureUtils::EnvironmentData>> pendingBuild;
+    std::shared_ptr<TextureUtils::EnvironmentData> pendingData;
+    std::vector<std::shared_ptr<Texture>> pendingTextures;  // Environment, irradiance, prefilter
+    TextureUtils::UploadSubmission pendingUpload;
+    VkBuffer pendingSHBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory pendingSHMemory = VK_NULL_HANDLE;
+    std::string pendingHdriPath;
+    std::string queuedHdriPath;
+    std::chrono::high_resolution_clock::time_point requestTime;
+    
+    // A replaced environment, freed once every frame has moved to version
+    struct RetiredEnvironment {
+        std::shared_ptr<Texture> environmentMap;
+        std::shared_ptr<Texture> irradianceMap;
+        std::shared_ptr<Texture> prefilterMap;
+        VkBuffer irradianceSHBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory irradianceSHMemory = VK_NULL_HANDLE;
+        TextureUtils::UploadSubmission refinementUpload;
+        uint32_t version = 0;
+    };
+    std::vector<RetiredEnvironment> retiredEnvironments;
+    
+    // Environment version each frame's descriptor set was last written for
+    uint32_t environmentVersion = 0;
+    std::vector<uint32_t> frameVersions;
     
     // Vulkan resources
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
@@ -128,12 +218,49 @@ private:
     std::string currentHdriPath;
     
     /**
-     * @brief Create IBL resources from the environment map
+     * @brief Create IBL resources from an environment built on the CPU
+     * 
+     * @param data Result of TextureUtils::buildEnvironmentData
+     * @return true if creation succeeded
+     * @return false if creation failed
+     */
+    bool createIBLResources(const std::shared_ptr<TextureUtils::EnvironmentData>& data);
+    
+    /**
+     * @brief Submit the cubemaps and SH buffer of an environment as the pending one
+     * 
+     * @return true if the upload was submitted
+     */
+    bool beginEnvironmentUpload(const std::shared_ptr<TextureUtils::EnvironmentData>& data);
+    
+    /**
+     * @brief Make the uploaded pending environment current and retire the old one
+     */
+    void swapEnvironment();
+    
+    /**
+     * @brief Start the latest request made while another was in flight
+     */
+    void startQueuedRequest();
+    
+    /**
+     * @brief Free retired environments no frame can still use (all of them if force)
+     */
+    void releaseRetiredEnvironments(bool force);
+    
+    /**
+     * @brief Write the current textures and SH buffer into a descriptor set
+     */
+    void writeDescriptorSet(VkDescriptorSet descriptorSet);
+    
+    /**
+     * @brief Create the uniform buffer holding an irradiance SH
      * 
+     * @param useSH EnvironmentData::useIrradianceSH of the environment being uploaded
      * @return true if creation succeeded
      * @return false if creation failed
      */
-    bool createIBLResources();
+    bool createIrradianceSHBuffer(const MiEngine::SHL2& sh, bool useSH, VkBuffer& buffer, VkDeviceMemory& memory);
     
     /**
      * @brief Cleanup all created resources
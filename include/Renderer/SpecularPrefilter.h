@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MiEngine {
+
+// GGX importance samples for one roughness, shared by every texel of a mip.
+// Directions are in tangent space (N = V = +Z); each texel only rotates them.
+struct PrefilterSampleTable {
+    float roughness = 0.0f;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> weight;      // NdotL, normalized to sum to 1
+    std::vector<float> lod;         // Source mip to read (filtered importance sampling)
+};
+
+struct PrefilterSettings {
+    uint32_t faceSize = 128;        // Output mip 0
+    uint32_t mipLevels = 5;         // Mip m has roughness m / (mipLevels - 1)
+    uint32_t baseSamples = 32;      // Mip m > 0 takes baseSamples * (m + 1) samples
+    uint32_t sampleDivisor = 1;     // Divides every sample count (progressive preview)
+};
+
+/**
+ * SpecularPrefilter convolves an environment cubemap with the GGX lobe for
+ * each roughness mip of the specular IBL map (split-sum, N = V).
+ *
+ * Samples come from a per-mip table built once, so texels only rotate the
+ * tangent-space directions into their frame. Each sample reads the source
+ * mip whose texel footprint matches the sample's solid angle (filtered
+ * importance sampling), which keeps the result smooth with far fewer samples
+ * than point sampling mip 0. Four texels of a row are evaluated together:
+ * the frame rotation and cube face selection run on SSE2 vectors, the
+ * bilinear fetches accumulate RGBA in one vector per texel. Rows of all six
+ * faces are spread over the ThreadPool.
+ *
+ * Cubemaps use the IBL cache layout: per mip, six tightly packed RGBA float
+ * faces (+X, -X, +Y, -Y, +Z, -Z) in the face convention of CubemapData.
+ */
+class SpecularPrefilter {
+public:
+    static uint32_t getSampleCount(const PrefilterSettings& settings, uint32_t mip);
+
+    // outputFaceSize picks the source mip read by the mirror (roughness 0) level
+    static PrefilterSampleTable buildSampleTable(float roughness, uint32_t sampleCount,
+                                                 uint32_t sourceFaceSize, uint32_t sourceMipLevels,
+                                                 uint32_t outputFaceSize);
+
+    // Every mip of the prefiltered map in the IBL cache layout
+    static std::vector<float> prefilter(const float* source, uint32_t sourceFaceSize, uint32_t sourceMipLevels,
+                                        const PrefilterSettings& settings);
+
+    // Size in floats of a cubemap chain in the IBL cache layout
+    static size_t getChainFloatCount(uint32_t faceSize, uint32_t mipLevels);
+};
+
+} // namespace MiEngine
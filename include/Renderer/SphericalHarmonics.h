@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace MiEngine {
+
+// RGB coefficients of the 9 real spherical harmonics up to band 2
+struct SHL2 {
+    std::array<glm::vec3, 9> coefficients{};
+};
+
+// Matches the IrradianceSH uniform block in pbr.frag (std140)
+struct IrradianceSHUniform {
+    alignas(16) glm::vec4 coefficients[9];  // rgb = convolved coefficient, w unused
+    alignas(4) int enabled;                 // 0 = shaders sample the irradiance cubemap instead
+};
+
+/**
+ * L2 spherical harmonics for diffuse IBL.
+ *
+ * Diffuse irradiance is smooth enough that 9 coefficients represent it with
+ * under 3% error for any environment (Ramamoorthi & Hanrahan 2001). Projecting
+ * the environment is a single solid-angle-weighted pass over a cubemap mip,
+ * replacing the per-texel hemisphere convolution.
+ *
+ * Cubemaps use the IBL cache layout: six tightly packed RGBA float faces in
+ * the order +X, -X, +Y, -Y, +Z, -Z (the face convention of CubemapData).
+ */
+class SphericalHarmonics {
+public:
+    // Real SH basis functions at a unit direction
+    static std::array<float, 9> evaluateBasis(const glm::vec3& direction);
+
+    // Project one mip of a cubemap (faceSize^2 * 6 RGBA texels) onto L2 SH.
+    // Texels are weighted by solid angle and clamped like CubemapData::sample.
+    static SHL2 projectCubemap(const float* faces, uint32_t faceSize);
+
+    // Convolve radiance with the clamped cosine lobe. The result evaluates to
+    // irradiance / PI, the value the irradiance cubemap has always stored.
+    static SHL2 convolveIrradiance(const SHL2& radiance);
+
+    // Reconstruct the function at a unit direction (negative ringing clamped to 0)
+    static glm::vec3 evaluate(const SHL2& sh, const glm::vec3& direction);
+
+    // Evaluate sh at every texel center of a cubemap (RGBA, alpha = 1)
+    static std::vector<float> rasterizeCubemap(const SHL2& sh, uint32_t faceSize);
+
+    static IrradianceSHUniform toUniform(const SHL2& irradiance, bool enabled);
+
+    // Direction through texel (u, v) in [-1, 1] of a cubemap face
+    static glm::vec3 faceDirection(uint32_t face, float u, float v);
+};
+
+} // namespace MiEngine
@@ -3,12 +3,17 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <functional>
+#include <future>
 #include <unordered_map>
 #include <glm/vec4.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
 #include <vulkan/vulkan.h>
 #include "texture/Texture.h"
+#include "texture/MipGenerator.h"
+#include "Renderer/SphericalHarmonics.h"
+#include "asset/IBLCache.h"
 
 
 // Structure to hold cached cubemap data
@@ -16,6 +21,7 @@ struct CubemapData {
     std::vector<float> data;  // RGBA float data for all 6 faces
     uint32_t faceSize;        // Width/height of each face
     uint32_t mipLevels;       // Number of mip levels
+    uint64_t sourceHash = 0;  // IBLCache::hashFile of the HDR it came from (0 if none)
     
     // Sample cubemap at given direction with bilinear filtering
     glm::vec3 sample(const glm::vec3& direction, uint32_t mipLevel = 0) const;
@@ -69,10 +75,23 @@ public:
         uint32_t prefilterMipLevels;     // Number of mip levels for prefiltered map
         
         // Sample counts for convolution
-        uint32_t irradianceSampleCount;  // Samples for irradiance convolution
         uint32_t prefilterBaseSamples;   // Base samples for prefilter (increases with roughness)
         uint32_t brdfLutSamples;         // Samples for BRDF LUT generation
         
+        // CPU mip filter for the environment cubemap (box matches the old GPU blit)
+        MiEngine::MipFilter environmentMipFilter = MiEngine::MipFilter::Box;
+        
+        // Shaders evaluate diffuse irradiance from L2 SH; the irradiance cubemap is then
+        // a 1x1 placeholder. false rasterizes the SH into an irradianceMapSize cubemap.
+        bool useIrradianceSH = true;
+        
+        // Progressive prefilter: the first upload uses sample counts divided by this and the
+        // full-quality map is filtered in the background (1 = full quality up front)
+        uint32_t prefilterPreviewDivisor = 4;
+        
+        // Payload encoding of the environment/prefilter caches (RGB9E5 is a quarter of RGBA32F)
+        MiEngine::IBLCacheEncoding cacheEncoding = MiEngine::IBLCacheEncoding::RGB9E5;
+        
         // Default constructor with medium quality
         IBLConfig() : IBLConfig(IBLQuality::MEDIUM) {}
         
@@ -95,7 +114,6 @@ public:
                     prefilterMapSize = 128;
                     brdfLutResolution = 256;
                     prefilterMipLevels = 5;
-                    irradianceSampleCount = 64;
                     prefilterBaseSamples = 32;
                     brdfLutSamples = 256;
                     break;
@@ -106,7 +124,6 @@ public:
                     prefilterMapSize = 256;
                     brdfLutResolution = 512;
                     prefilterMipLevels = 6;
-                    irradianceSampleCount = 128;
                     prefilterBaseSamples = 64;
                     brdfLutSamples = 512;
                     break;
@@ -117,7 +134,6 @@ public:
                     prefilterMapSize = 512;
                     brdfLutResolution = 1024;
                     prefilterMipLevels = 7;
-                    irradianceSampleCount = 256;
                     prefilterBaseSamples = 128;
                     brdfLutSamples = 1024;
                     break;
@@ -131,7 +147,6 @@ public:
             , prefilterMapSize(prefSize)
             , brdfLutResolution(brdfSize)
             , prefilterMipLevels(static_cast<uint32_t>(std::floor(std::log2(prefSize))) + 1)
-            , irradianceSampleCount(64)
             , prefilterBaseSamples(32)
             , brdfLutSamples(256) {}
     };
@@ -276,8 +291,14 @@ public:
         VkQueue graphicsQueue);
 
     /**
-     * Create an irradiance map from an environment map for diffuse IBL
-     * @param cacheKey
+     * Project an environment cubemap onto L2 SH and convolve it into diffuse irradiance
+     * Uses the first mip no larger than 128 per face; the result evaluates to irradiance / PI.
+     */
+    static MiEngine::SHL2 computeIrradianceSH(const CubemapData& environment);
+
+    /**
+     * Create an irradiance cubemap for diffuse IBL by rasterizing irradiance SH
+     * @param irradianceSH Result of computeIrradianceSH
      * @param customConfig Optional custom configuration for this specific map
      */
     static std::shared_ptr<Texture> createIrradianceMap(
@@ -285,18 +306,21 @@ public:
         VkPhysicalDevice physicalDevice,
         VkCommandPool commandPool,
         VkQueue graphicsQueue,
-        std::shared_ptr<Texture> environmentMap,
-        const std::string& cacheKey, const IBLConfig* customConfig = nullptr);
+        const MiEngine::SHL2& irradianceSH,
+        const IBLConfig* customConfig = nullptr);
 
     
     void static cacheEnvironmentMap(std::shared_ptr<Texture> environmentMap, std::shared_ptr<CubemapData> data);
-    std::shared_ptr<CubemapData> getCachedEnvironmentData(std::shared_ptr<Texture> environmentMap);
+    static std::shared_ptr<CubemapData> getCachedEnvironmentData(std::shared_ptr<Texture> environmentMap);
     void static setCurrentEnvironmentData(std::shared_ptr<CubemapData> data);
     
     /**
      * Create a prefiltered environment map for specular IBL
      * @param cacheKey
      * @param customConfig Optional custom configuration for this specific map
+     * @param refinedData If set (and prefilterPreviewDivisor > 1), the map starts as a
+     *        low-sample preview and this receives the full-quality chain filtered on the
+     *        ThreadPool; upload it with submitCubemapUploads once ready. Cache hits leave it empty.
      */
     static std::shared_ptr<Texture> createPrefilterMap(
         VkDevice device,
@@ -304,36 +328,106 @@ public:
         VkCommandPool commandPool,
         VkQueue graphicsQueue,
         std::shared_ptr<Texture> environmentMap,
-        const std::string& cacheKey, const IBLConfig* customConfig = nullptr);
+        const std::string& cacheKey, const IBLConfig* customConfig = nullptr,
+        std::future<std::vector<float>>* refinedData = nullptr);
+    
+    /**
+     * CPU side of one environment's IBL, built without Vulkan so it can run on a worker.
+     * Chains use the IBL cache layout.
+     */
+    struct EnvironmentData {
+        std::string hdrPath;
+        std::shared_ptr<CubemapData> environment;   // Full chain, also kept for CPU sampling
+        MiEngine::SHL2 irradianceSH;
+        bool useIrradianceSH = true;                // IBLConfig::useIrradianceSH this was built with
+        std::vector<float> irradiance;              // One mip of irradianceSize
+        uint32_t irradianceSize = 0;
+        std::vector<float> prefilter;               // Preview quality while prefilterRefinement is pending
+        uint32_t prefilterSize = 0;
+        uint32_t prefilterMipLevels = 0;
+        std::future<std::vector<float>> prefilterRefinement;
+    };
+
+    /**
+     * Load an HDR's environment chain from the IBL cache, or convert (and cache) it
+     * @return nullptr if the HDR cannot be read
+     */
+    static std::shared_ptr<CubemapData> loadEnvironmentData(const std::string& hdrFilePath, const IBLConfig& config);
+
+    /**
+     * Gradient environment chain used when no HDR can be loaded
+     */
+    static std::shared_ptr<CubemapData> createDefaultEnvironmentData(uint32_t faceSize = 256);
+
+    /**
+     * Build the irradiance and prefiltered chains of an environment on the calling thread
+     * @param environment Chain to filter (nullptr loads hdrFilePath)
+     * @return nullptr if the HDR cannot be read
+     */
+    static std::shared_ptr<EnvironmentData> buildEnvironmentData(
+        const std::string& hdrFilePath,
+        const IBLConfig& config,
+        std::shared_ptr<CubemapData> environment = nullptr);
+
+    /**
+     * One cubemap chain for submitCubemapUploads
+     */
+    struct CubemapUpload {
+        const float* data = nullptr;        // IBL cache layout, faceSize / mipLevels
+        uint32_t faceSize = 0;
+        uint32_t mipLevels = 1;
+        std::shared_ptr<Texture> target;    // Overwritten in place; nullptr creates a new cubemap
+    };
+
+    /**
+     * A submitted upload; its staging memory lives until releaseUpload
+     */
+    struct UploadSubmission {
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+    };
+
+    /**
+     * Copy cubemap chains to the GPU through one staging buffer and one submission,
+     * without waiting. Barriers order the copies after work already on the queue, so
+     * targets may still be sampled by frames in flight.
+     * @return A texture per upload (its target or the new cubemap), nullptr where it failed
+     */
+    static std::vector<std::shared_ptr<Texture>> submitCubemapUploads(
+        VkDevice device,
+        VkPhysicalDevice physicalDevice,
+        VkCommandPool commandPool,
+        VkQueue graphicsQueue,
+        const std::vector<CubemapUpload>& uploads,
+        UploadSubmission& submission);
+
+    static bool isUploadComplete(VkDevice device, const UploadSubmission& submission);
+
+    // Wait for the submission if it is still running and free its resources
+    static void releaseUpload(VkDevice device, VkCommandPool commandPool, UploadSubmission& submission);
 
 private:
     // Helper functions for IBL
-    static void equirectangularToCubemapFace(
-        float* equirectangularData, int equiWidth, int equiHeight, int channels,
-        float* faceData, int faceSize, int faceIndex);
-        
-    static glm::vec3 specularConvolution(
-        std::shared_ptr<Texture> envMap, 
-        const glm::vec3& reflection, 
-        float roughness, 
-        int sampleCount);
-        
-    static glm::vec3 diffuseConvolution(
-        std::shared_ptr<Texture> envMap, 
-        const glm::vec3& normal, 
-        int sampleCount);
-        
     static float distributionGGX(float NoH, float alphaSquared);
     
-    static std::vector<glm::vec3> generateHemisphereSamples(
-        const glm::vec3& normal, 
-        int sampleCount);
-        
-    static std::vector<glm::vec3> generateImportanceSamples(
-        const glm::vec3& reflection, 
-        float roughness, 
-        int sampleCount);
-        
+    // Equirect HDR to a cubemap chain in the IBL cache layout (empty if unreadable)
+    static std::vector<float> convertEquirectHDR(
+        const std::string& hdrFilePath,
+        const IBLConfig& config,
+        uint32_t faceSize,
+        uint32_t mipLevels);
+    
+    // Filter and cache the prefiltered chain for cacheKey. With refinedData (and a preview
+    // divisor > 1) the result is a preview and the full chain is filtered on the ThreadPool.
+    static std::vector<float> filterPrefilterChain(
+        const std::shared_ptr<CubemapData>& environment,
+        const IBLConfig& config,
+        const MiEngine::IBLCacheKey& cacheKey,
+        const fs::path& cachePath,
+        std::future<std::vector<float>>* refinedData);
+    
     static glm::vec3 sampleEnvironmentMap(
         std::shared_ptr<Texture> envMap, 
         const glm::vec3& direction);
@@ -376,4 +470,16 @@ private:
         VkPhysicalDevice physicalDevice,
         uint32_t typeFilter,
         VkMemoryPropertyFlags properties);
+    
+    // Copy a cubemap chain in the IBL cache layout into an image in TRANSFER_DST layout.
+    // writeChain fills the mapped staging buffer (every mip, RGBA float).
+    static void uploadCubemapChain(
+        VkDevice device,
+        VkPhysicalDevice physicalDevice,
+        VkCommandPool commandPool,
+        VkQueue graphicsQueue,
+        VkImage image,
+        uint32_t faceSize,
+        uint32_t mipLevels,
+        const std::function<void(float*)>& writeChain);
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/MiName.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <string>
@@ -31,7 +32,7 @@ using MatrixKey = Keyframe<glm::mat4>;
  * Contains separate tracks for position, rotation, and scale.
  */
 struct BoneAnimationTrack {
-    std::string boneName;
+    MiName boneName;
     int32_t boneIndex = -1;  // Set during skeleton binding
 
     std::vector<PositionKey> positionKeys;
@@ -63,7 +64,7 @@ struct BoneAnimationTrack {
  *   clip.name = "Walk";
  *   clip.duration = 1.0f;
  *
- *   BoneAnimationTrack& track = clip.addTrack("LeftLeg");
+ *   BoneAnimationTrack& track = clip.addTrack(MiName("LeftLeg"));
  *   track.positionKeys.push_back({0.0f, glm::vec3(0, 0, 0)});
  *   track.positionKeys.push_back({1.0f, glm::vec3(0, 1, 0)});
  *
@@ -77,15 +78,16 @@ public:
     ~AnimationClip() = default;
 
     // Track management
-    BoneAnimationTrack& addTrack(const std::string& boneName);
-    BoneAnimationTrack* getTrack(const std::string& boneName);
-    const BoneAnimationTrack* getTrack(const std::string& boneName) const;
+    BoneAnimationTrack& addTrack(MiName boneName);
+    BoneAnimationTrack* getTrack(MiName boneName);
+    const BoneAnimationTrack* getTrack(MiName boneName) const;
     BoneAnimationTrack* getTrack(uint32_t boneIndex);
     const BoneAnimationTrack* getTrack(uint32_t boneIndex) const;
 
     /**
      * Bind tracks to skeleton bone indices.
-     * Call this after loading to map bone names to indices.
+     * Call this after loading to map bone names to indices (one lookup per
+     * track on the interned name).
      */
     void bindToSkeleton(const class Skeleton& skeleton);
 
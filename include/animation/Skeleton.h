@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/MiName.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <string>
@@ -14,7 +15,7 @@ namespace MiEngine {
  * Bones are stored in a flat array with parent indices for hierarchy traversal.
  */
 struct Bone {
-    std::string name;
+    MiName name;
     int32_t parentIndex = -1;           // -1 indicates root bone
 
     // Bind pose data
@@ -33,8 +34,8 @@ struct Bone {
  *
  * Usage:
  *   auto skeleton = std::make_shared<Skeleton>();
- *   skeleton->addBone("root", -1, inverseBindPose);
- *   skeleton->addBone("spine", 0, inverseBindPose);  // Parent is root (index 0)
+ *   skeleton->addBone(MiName("root"), -1, inverseBindPose);
+ *   skeleton->addBone(MiName("spine"), 0, inverseBindPose);  // Parent is root (index 0)
  *
  *   // During animation:
  *   std::vector<glm::mat4> localPoses = animator.getLocalPoses();
@@ -49,7 +50,7 @@ public:
     ~Skeleton() = default;
 
     // Bone management
-    uint32_t addBone(const std::string& name, int32_t parentIndex,
+    uint32_t addBone(MiName name, int32_t parentIndex,
                      const glm::mat4& inverseBindPose,
                      const glm::mat4& localBindPose = glm::mat4(1.0f));
 
@@ -58,8 +59,9 @@ public:
     Bone& getBone(uint32_t index) { return m_bones[index]; }
     uint32_t getBoneCount() const { return static_cast<uint32_t>(m_bones.size()); }
 
-    int32_t getBoneIndex(const std::string& name) const;
-    bool hasBone(const std::string& name) const;
+    // Interned names: a hash lookup on the name index, no string hashing
+    int32_t getBoneIndex(MiName name) const;
+    bool hasBone(MiName name) const;
 
     const std::vector<Bone>& getBones() const { return m_bones; }
 
@@ -92,7 +94,7 @@ public:
 
 private:
     std::vector<Bone> m_bones;
-    std::unordered_map<std::string, uint32_t> m_boneNameToIndex;
+    std::unordered_map<MiName, uint32_t> m_boneNameToIndex;
 };
 
 } // namespace MiEngine
@@ -31,6 +31,9 @@ public:
     // Set the scene for adding assets
     void setScene(Scene* scene) { m_scene = scene; }
 
+    // Rebuild the displayed list on next draw (registry changed externally)
+    void markDirty() { m_needsRefresh = true; }
+
 private:
     // UI Sections
     void drawMenuBar();
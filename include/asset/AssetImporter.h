@@ -1,7 +1,9 @@
 #pragma once
 
 #include "AssetTypes.h"
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <string>
 #include <functional>
 
@@ -21,16 +23,35 @@ public:
     using ImportCallback = std::function<void(bool success, const std::string& uuid,
                                                const std::string& error)>;
 
-    // Import a model file (FBX) into the project
+    // Import a model file (FBX, glTF/GLB) into the project
     // Returns the UUID of the imported asset, or empty string on failure
     static std::string importModel(const fs::path& sourceFile);
 
+    // Import an image (PNG/JPG/TGA/BMP) and bake it to a block-compressed KTX2
+    // Returns the UUID of the imported asset, or empty string on failure
+    static std::string importTexture(const fs::path& sourceFile);
+
     // Import with callback for async operation (future enhancement)
     static void importModelAsync(const fs::path& sourceFile, ImportCallback callback);
 
-    // Re-import an existing asset (regenerate cache from source)
+    // Re-import an existing asset (regenerate cache from source). Blocks until the cache is written.
     static bool reimport(const std::string& uuid);
 
+    // Background re-import: beginReimport() snapshots the registry entry and bakes the
+    // cache on the ThreadPool; finishReimport() applies the result to the registry once
+    // isReady(). Both are main-thread calls.
+    struct PendingReimport {
+        AssetEntry entry;
+        std::future<bool> result;   // Invalid if the asset wasn't found
+        bool sourceChangedAgain = false;
+
+        bool isReady() const {
+            return !result.valid() || result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+    };
+    static PendingReimport beginReimport(const std::string& uuid);
+    static bool finishReimport(PendingReimport& pending);
+
     // Delete an asset and its cache
     static bool deleteAsset(const std::string& uuid);
 
@@ -48,6 +69,8 @@ private:
     // Internal helpers
     static bool copyToProject(const fs::path& source, const fs::path& destination);
     static bool generateCache(const AssetEntry& entry);
+    // Thread-safe part of generateCache (no registry access)
+    static bool bakeCache(AssetType type, const fs::path& sourcePath, const fs::path& cachePath);
     static std::string getRelativeProjectPath(const fs::path& absolutePath,
                                                const fs::path& projectRoot);
 };
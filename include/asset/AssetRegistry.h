@@ -1,18 +1,89 @@
 #pragma once
 
 #include "AssetTypes.h"
+#include "AssetWatcher.h"
+#include "core/MappedFile.h"
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
 namespace MiEngine {
 
+// Binary registry file header (asset_registry.mireg)
+#pragma pack(push, 1)
+struct AssetRegistryHeader {
+    char magic[8];              // "MIAREG01"
+    uint32_t version;           // Format version (2; 1 has no path table)
+    uint32_t entryCount;        // Number of AssetRegistryRecords
+    uint64_t generation;        // Bumped on every full write; the journal must match
+    uint64_t stringPoolSize;    // Bytes of string data following the record table
+    uint32_t reserved[4];       // Future expansion
+};
+
+// Fixed-size record, table is sorted by uuid. Strings live in the pool.
+// Version 2 follows the table with uint32_t[entryCount] record indices sorted by projectPath.
+struct AssetRegistryRecord {
+    uint32_t uuidOffset;
+    uint32_t uuidLength;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t projectPathOffset;
+    uint32_t projectPathLength;
+    uint32_t cachePathOffset;
+    uint32_t cachePathLength;
+    uint32_t type;              // AssetType
+    uint32_t flags;             // Bit 0: cacheValid
+    uint64_t importTime;
+    uint64_t sourceModTime;
+};
+
+// Change journal file header (asset_registry.journal)
+struct AssetJournalHeader {
+    char magic[8];              // "MIAJRN01"
+    uint32_t version;           // Format version (1)
+    uint32_t reserved;
+    uint64_t generation;        // Generation of the registry file this journal applies to
+};
+
+struct AssetJournalRecordHeader {
+    uint32_t op;                // AssetJournalOp
+    uint32_t payloadSize;       // Bytes following this header
+    uint32_t checksum;          // FNV-1a of the payload, detects torn appends
+};
+#pragma pack(pop)
+
+enum class AssetJournalOp : uint32_t {
+    Add = 1,
+    Update = 2,
+    Remove = 3
+};
+
 /**
  * AssetRegistry tracks all imported assets in a project.
- * Persisted to asset_registry.json in the project root.
+ *
+ * Persisted as a compact binary file (asset_registry.mireg) in the project root:
+ *   - AssetRegistryHeader
+ *   - AssetRegistryRecord[entryCount], sorted by uuid
+ *   - uint32_t[entryCount] record indices, sorted by projectPath
+ *   - string pool
+ *
+ * The file stays mapped and lookups binary search it in place; only the entry
+ * found is decoded. Changes since the file was written (journal replay and edits)
+ * live in an in-memory overlay that shadows the mapped records.
+ *
+ * save() appends pending changes to asset_registry.journal instead of rewriting
+ * the whole registry. The journal is folded back into the registry file once it
+ * grows past a fraction of the asset count (or on compact()), which also empties
+ * the overlay.
+ *
+ * Projects that only have the legacy asset_registry.json are still loaded and
+ * converted on the next save. JSON remains available through exportJson().
  */
 class AssetRegistry {
 public:
@@ -20,15 +91,20 @@ public:
 
     // Project lifecycle
     void loadFromProject(const fs::path& projectPath);
-    void save();
+    void save();        // Append pending changes to the journal (compacts when needed)
+    void compact();     // Rewrite the registry file and reset the journal
     void clear();
 
-    // Query methods
-    const std::vector<AssetEntry>& getAssets() const { return m_assets; }
-    const AssetEntry* findByUuid(const std::string& uuid) const;
-    const AssetEntry* findByPath(const std::string& projectPath) const;
+    // JSON interchange (legacy format, human readable)
+    bool exportJson(const fs::path& jsonPath) const;
+    bool importJson(const fs::path& jsonPath);
+
+    // Query methods (entries are decoded on demand, so they are returned by value)
+    void forEachAsset(const std::function<void(const AssetEntry&)>& callback) const;
+    std::optional<AssetEntry> findByUuid(const std::string& uuid) const;
+    std::optional<AssetEntry> findByPath(const std::string& projectPath) const;
     std::vector<AssetEntry> getAssetsByType(AssetType type) const;
-    size_t getAssetCount() const { return m_assets.size(); }
+    size_t getAssetCount() const { return m_assetCount; }
 
     // Modification
     void addAsset(const AssetEntry& entry);
@@ -38,13 +114,21 @@ public:
     // Cache management
     void invalidateCache(const std::string& uuid);
     void validateCache(const std::string& uuid);
-    void refreshAll();  // Re-validate all caches against source files
+    void refreshAll();  // Re-validate all caches against source files (parallel)
+
+    // File watching - validates only files changed under Assets/ (hot reload)
+    void setFileWatchingEnabled(bool enabled);
+    bool isFileWatching() const { return m_watcher && m_watcher->isRunning(); }
+    // Call once per frame. Returns UUIDs of assets whose source changed and need a reimport.
+    std::vector<std::string> processFileChanges();
 
     // Path helpers
     fs::path getProjectPath() const { return m_projectPath; }
     fs::path getAssetsPath() const { return m_projectPath / "Assets"; }
     fs::path getCachePath() const { return m_projectPath / "Cache"; }
-    fs::path getRegistryFilePath() const { return m_projectPath / "asset_registry.json"; }
+    fs::path getRegistryFilePath() const { return m_projectPath / "asset_registry.mireg"; }
+    fs::path getJournalFilePath() const { return m_projectPath / "asset_registry.journal"; }
+    fs::path getLegacyJsonPath() const { return m_projectPath / "asset_registry.json"; }
 
     // Resolve relative project path to absolute path
     fs::path resolveAssetPath(const std::string& projectPath) const;
@@ -53,19 +137,69 @@ public:
     // UUID generation
     static std::string generateUuid();
 
+    static constexpr char REGISTRY_MAGIC[] = "MIAREG01";
+    static constexpr char JOURNAL_MAGIC[] = "MIAJRN01";
+    static constexpr uint32_t REGISTRY_VERSION = 2;
+    static constexpr uint32_t JOURNAL_VERSION = 1;
+
 private:
     AssetRegistry() = default;
     ~AssetRegistry() = default;
     AssetRegistry(const AssetRegistry&) = delete;
     AssetRegistry& operator=(const AssetRegistry&) = delete;
 
-    void rebuildIndex();
+    struct JournalEntry {
+        AssetJournalOp op;
+        AssetEntry entry;       // Snapshot at the time of the change (only uuid for Remove)
+    };
+
+    // Binary persistence
+    bool mapRegistry(const fs::path& registryFile);
+    void unmapRegistry();
+    bool writeBinary(const fs::path& registryFile, const std::vector<AssetEntry>& entries, uint64_t generation) const;
+    size_t replayJournal(const fs::path& journalFile);
+    bool appendJournal(const std::vector<JournalEntry>& changes);
+    bool resetJournal(uint64_t generation);
+
+    // Mapped table (no copies, binary searched)
+    std::string_view recordString(uint32_t offset, uint32_t length) const { return { m_pool + offset, length }; }
+    const AssetRegistryRecord* findRecord(std::string_view uuid) const;
+    AssetEntry decodeRecord(const AssetRegistryRecord& record) const;
+
+    // Overlay maintenance (incremental, no full rebuild)
+    bool contains(const std::string& uuid) const;
+    void setOverride(const std::string& uuid, std::optional<AssetEntry> entry);
+    void recordChange(AssetJournalOp op, const AssetEntry& entry);
+
+    // Validate caches of entries on the thread pool, result[i] = cache valid
+    std::vector<uint8_t> validateEntries(const std::vector<AssetEntry>& entries) const;
+    void restartWatcher();
+
+    // Registry file as of the last full write
+    MappedFile m_file;
+    const AssetRegistryRecord* m_records = nullptr;
+    const uint32_t* m_pathOrder = nullptr;
+    std::vector<uint32_t> m_pathOrderStorage;    // Built on load for version 1 files
+    const char* m_pool = nullptr;
+    uint32_t m_recordCount = 0;
+
+    // Changes since then, keyed by uuid: the current entry, or nullopt if removed
+    std::unordered_map<std::string, std::optional<AssetEntry>> m_overrides;
+    std::unordered_map<std::string, std::string> m_overridePaths;   // projectPath -> uuid of a live override
+    size_t m_assetCount = 0;
 
-    std::vector<AssetEntry> m_assets;
-    std::unordered_map<std::string, size_t> m_uuidIndex;     // uuid -> index in m_assets
-    std::unordered_map<std::string, size_t> m_pathIndex;     // projectPath -> index
     fs::path m_projectPath;
     bool m_dirty = false;
+
+    // Journal state
+    std::vector<JournalEntry> m_pendingChanges;  // Not yet written to disk
+    uint64_t m_generation = 0;                   // Generation of the on-disk registry file
+    size_t m_journalRecordCount = 0;             // Records currently in the journal file
+    bool m_needsFullWrite = false;               // No valid registry file yet (new/legacy project)
+
+    // File watching
+    std::unique_ptr<AssetWatcher> m_watcher;
+    bool m_fileWatchingEnabled = AssetWatcher::isSupported();
 };
 
 } // namespace MiEngine
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace fs = std::filesystem;
+
+namespace MiEngine {
+
+/**
+ * AssetWatcher monitors the project Assets/ tree for file changes.
+ *
+ * A background thread collects modify/create/move/delete events; the main
+ * thread calls pollChanges() once per frame to take the paths that have been
+ * quiet for the debounce interval (editors often write a file several times
+ * on save).
+ *
+ * Backed by inotify on Linux. On other platforms start() returns false and the
+ * registry falls back to explicit refreshAll().
+ */
+class AssetWatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AssetWatcher() = default;
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    // Start watching a directory tree (recursively). Returns false if unsupported.
+    bool start(const fs::path& rootPath);
+    void stop();
+    bool isRunning() const { return m_Running.load(); }
+
+    // Paths (relative to root, forward slashes) unchanged for at least `debounce`
+    std::vector<std::string> pollChanges(std::chrono::milliseconds debounce = std::chrono::milliseconds(300));
+
+    static bool isSupported();
+
+private:
+    void threadMain();
+    void queueChange(const std::string& relativePath);
+
+#ifdef __linux__
+    void addWatchRecursive(const fs::path& dir);
+
+    int m_InotifyFd = -1;
+    int m_WakeFd = -1;                                  // eventfd used to interrupt poll() on stop
+    std::unordered_map<int, fs::path> m_WatchDirs;      // watch descriptor -> absolute dir (watcher thread only)
+#endif
+
+    fs::path m_RootPath;
+    std::thread m_Thread;
+    std::atomic<bool> m_Running{ false };
+
+    std::mutex m_Mutex;
+    std::unordered_map<std::string, Clock::time_point> m_PendingChanges;  // path -> last event time
+};
+
+} // namespace MiEngine
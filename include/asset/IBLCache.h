@@ -0,0 +1,97 @@
+#pragma once
+
+#include "core/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace MiEngine {
+
+enum class IBLCacheKind : uint32_t {
+    EnvironmentMap = 0,
+    PrefilterMap = 1
+};
+
+// Payload texel encoding (the runtime always expands to RGBA32F)
+enum class IBLCacheEncoding : uint32_t {
+    RGBA16F = 0,    // Half floats, 8 bytes per texel
+    RGB9E5 = 1      // Shared exponent like VK_FORMAT_E5B9G9R9_UFLOAT_PACK32, 4 bytes, alpha = 1
+};
+
+// IBLConfig fields that shape a cached product, stored verbatim in the header.
+// Fields that do not affect a kind stay 0 so unrelated edits keep its cache valid.
+struct IBLCacheSettings {
+    uint32_t environmentMapSize = 0;
+    uint32_t environmentMipFilter = 0;
+    uint32_t prefilterMapSize = 0;
+    uint32_t prefilterMipLevels = 0;
+    uint32_t prefilterBaseSamples = 0;
+    uint32_t reserved = 0;
+};
+
+// What a cache file must have been built from to be used
+struct IBLCacheKey {
+    IBLCacheKind kind = IBLCacheKind::EnvironmentMap;
+    uint64_t sourceHash = 0;        // IBLCache::hashFile of the source HDR
+    uint32_t faceSize = 0;
+    uint32_t mipLevels = 0;
+    IBLCacheSettings settings;
+};
+
+// A validated cache file mapped from disk
+struct IBLCacheFile {
+    MappedFile file;
+    IBLCacheEncoding encoding = IBLCacheEncoding::RGB9E5;
+    uint32_t faceSize = 0;
+    uint32_t mipLevels = 0;
+    const uint8_t* payload = nullptr;
+
+    // RGBA floats of the whole chain (all mips, six faces each)
+    size_t getFloatCount() const;
+
+    // Expand the payload to RGBA32F in the IBL cache layout, e.g. straight into
+    // a mapped staging buffer of getFloatCount() floats
+    void decode(float* dst) const;
+};
+
+/**
+ * IBLCache stores generated IBL cubemaps (environment, prefiltered specular)
+ * so later runs skip the CPU work.
+ *
+ * A file is a 64-byte header followed by the chain in the IBL cache layout
+ * (per mip, six faces +X..-Z) in a compact encoding: RGB9E5 is a quarter of
+ * the raw RGBA32F size, RGBA16F half. The header records a magic, version,
+ * a content hash of the source HDR and the IBLCacheSettings; a mismatch in
+ * any of them makes open() fail so the caller regenerates. Files are named
+ * from a stable FNV-1a hash of the source path and written through a
+ * temporary file so readers never map a partial write.
+ */
+class IBLCache {
+public:
+    static constexpr uint32_t MAGIC = 0x4C42494D;   // "MIBL"
+    static constexpr uint32_t VERSION = 1;
+
+    // 64-bit content hash of a file, 0 if it cannot be read
+    static uint64_t hashFile(const fs::path& path);
+
+    // cache/ibl/<path hash>_<kind>_<faceSize>.mibl
+    static fs::path getCachePath(const fs::path& sourcePath, IBLCacheKind kind, uint32_t faceSize);
+
+    // data holds the full RGBA float chain for key.faceSize / key.mipLevels
+    static bool save(const fs::path& cachePath, const IBLCacheKey& key, IBLCacheEncoding encoding,
+                     const float* data, size_t floatCount);
+
+    // Map cachePath if it exists and was built from key
+    static bool open(const fs::path& cachePath, const IBLCacheKey& key, IBLCacheFile& outFile);
+
+    static size_t getTexelCount(uint32_t faceSize, uint32_t mipLevels);
+    static size_t getBytesPerTexel(IBLCacheEncoding encoding);
+
+    // Channels are clamped to [0, 65408]; decoding returns alpha-less RGB
+    static uint32_t encodeRGB9E5(float r, float g, float b);
+    static void decodeRGB9E5(uint32_t packed, float* rgb);
+};
+
+} // namespace MiEngine
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "AssetTypes.h"
-#include "loader/ModelLoader.h"
+#include "loader/MeshData.h"
 #include <filesystem>
 #include <vector>
 
@@ -1,8 +1,13 @@
 #pragma once
 
+#include "core/MiName.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <functional>
+#include <vector>
+#include <atomic>
+#include <cstdint>
 
 // Forward declarations (global namespace)
 class Mesh;        // Global namespace - used as ::Mesh
@@ -13,56 +18,154 @@ namespace MiEngine {
 // Forward declaration for MiEngine namespace class
 class SkeletalMesh;
 
+enum class MeshLoadStatus : uint8_t {
+    Pending,    // Decoding on a worker or waiting for GPU upload
+    Ready,      // Mesh available via get()
+    Failed      // Source missing or decode failed
+};
+
+/**
+ * Handle to an asynchronous mesh request. Copies share the same load.
+ * The mesh becomes available after MeshLibrary::update() has uploaded it
+ * on the main thread.
+ */
+template<typename TMesh>
+class MeshHandle {
+public:
+    MeshHandle() = default;
+
+    bool isValid() const { return m_State != nullptr; }
+    MeshLoadStatus getStatus() const { return m_State ? m_State->status.load() : MeshLoadStatus::Failed; }
+    bool isReady() const { return getStatus() == MeshLoadStatus::Ready; }
+    bool isPending() const { return getStatus() == MeshLoadStatus::Pending; }
+    bool isFailed() const { return getStatus() == MeshLoadStatus::Failed; }
+
+    // nullptr until ready
+    std::shared_ptr<TMesh> get() const { return isReady() ? m_State->mesh : nullptr; }
+
+private:
+    friend class MeshLibrary;
+
+    struct State {
+        std::atomic<MeshLoadStatus> status{ MeshLoadStatus::Pending };
+        std::shared_ptr<TMesh> mesh;
+    };
+
+    std::shared_ptr<State> m_State;
+};
+
+using StaticMeshHandle = MeshHandle<::Mesh>;
+using SkeletalMeshHandle = MeshHandle<SkeletalMesh>;
+
 /**
  * MeshLibrary provides runtime caching of loaded meshes.
  * When the same model is loaded multiple times, GPU buffers are shared.
  *
- * Uses weak_ptr to allow meshes to be unloaded when no longer referenced.
+ * Loading:
+ *   - getMesh()/getSkeletalMesh() load synchronously (blocking)
+ *   - requestMesh()/requestSkeletalMesh() decode on the ThreadPool and upload
+ *     during update(). Concurrent requests for the same path share one load.
+ *
+ * Meshes are held strongly and released by collectGarbage() once nothing else
+ * has referenced them for getRetainFrames() frames, so briefly dropped meshes
+ * are not reloaded.
+ *
+ * Meshes are keyed by interned asset path (MiName): callers that keep the
+ * MiName skip string hashing. Wrap a path in MiName() to load it, or use
+ * MiName::find() to ask about a path without interning it.
+ *
+ * All methods must be called from the main (render) thread.
  */
 class MeshLibrary {
 public:
+    template<typename TMesh>
+    using ReadyCallback = std::function<void(std::shared_ptr<TMesh>)>;
+
     MeshLibrary(VulkanRenderer* renderer);
-    ~MeshLibrary() = default;
+    ~MeshLibrary();
 
     // Get or load a static mesh
     // Returns cached mesh if available, otherwise loads from cache/FBX
-    std::shared_ptr<::Mesh> getMesh(const std::string& assetPath);
+    std::shared_ptr<::Mesh> getMesh(MiName assetPath);
 
     // Get or load a skeletal mesh
-    std::shared_ptr<SkeletalMesh> getSkeletalMesh(const std::string& assetPath);
+    std::shared_ptr<SkeletalMesh> getSkeletalMesh(MiName assetPath);
+
+    // Asynchronous requests. onReady runs on the main thread (immediately if cached),
+    // with nullptr on failure.
+    StaticMeshHandle requestMesh(MiName assetPath,
+                                 ReadyCallback<::Mesh> onReady = nullptr);
+    SkeletalMeshHandle requestSkeletalMesh(MiName assetPath,
+                                           ReadyCallback<SkeletalMesh> onReady = nullptr);
+
+    // Per-frame: upload finished decodes, then collectGarbage()
+    void update();
 
     // Check if a mesh is already loaded
-    bool isMeshLoaded(const std::string& assetPath) const;
-    bool isSkeletalMeshLoaded(const std::string& assetPath) const;
+    bool isMeshLoaded(MiName assetPath) const;
+    bool isSkeletalMeshLoaded(MiName assetPath) const;
 
-    // Force reload a mesh (bypasses cache)
-    std::shared_ptr<::Mesh> reloadMesh(const std::string& assetPath);
-    std::shared_ptr<SkeletalMesh> reloadSkeletalMesh(const std::string& assetPath);
+    // Force reload a mesh (bypasses cache). Only the library entry is replaced:
+    // components and handles holding the previous mesh keep it until rebound
+    // (VulkanRenderer rebinds MiStaticMeshComponents after a hot reload).
+    std::shared_ptr<::Mesh> reloadMesh(MiName assetPath);
+    std::shared_ptr<SkeletalMesh> reloadSkeletalMesh(MiName assetPath);
 
-    // Remove expired weak pointers (cleanup)
+    // Advance one frame and release meshes unreferenced for more than getRetainFrames() frames
     void collectGarbage();
 
-    // Clear all cached meshes
+    // Clear all cached meshes (waits for in-flight decodes)
     void clear();
 
+    // Retention / upload budget
+    void setRetainFrames(uint32_t frames) { m_retainFrames = frames; }
+    uint32_t getRetainFrames() const { return m_retainFrames; }
+    void setMaxUploadsPerFrame(uint32_t count) { m_maxUploadsPerFrame = count; }
+
     // Statistics
     size_t getLoadedMeshCount() const;
     size_t getLoadedSkeletalMeshCount() const;
     size_t getTotalLoadedCount() const;
+    size_t getPendingLoadCount() const { return m_pendingMeshes.size() + m_pendingSkeletalMeshes.size(); }
 
 private:
+    template<typename TMesh>
+    struct CachedMesh {
+        std::shared_ptr<TMesh> mesh;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    // Defined in MeshLibrary.cpp
+    struct MeshSource;
+    struct PendingStaticLoad;
+    struct PendingSkeletalLoad;
+
     // Load mesh from cache or FBX file
-    std::shared_ptr<::Mesh> loadMeshInternal(const std::string& assetPath);
-    std::shared_ptr<SkeletalMesh> loadSkeletalMeshInternal(const std::string& assetPath);
+    std::shared_ptr<::Mesh> loadMeshInternal(MiName assetName);
+    std::shared_ptr<SkeletalMesh> loadSkeletalMeshInternal(MiName assetName);
+
+    // Path and registry lookups (main thread only)
+    bool resolveSource(const std::string& assetPath, MeshSource& outSource) const;
+
+    // Wait for a pending decode and upload it
+    void finishLoad(PendingStaticLoad& pending);
+    void finishLoad(PendingSkeletalLoad& pending);
 
     // Create primitive mesh (sphere, cube, plane, etc.)
     std::shared_ptr<::Mesh> createPrimitiveMesh(const std::string& primitiveType);
 
     VulkanRenderer* m_renderer;
 
-    // Weak pointers allow meshes to be unloaded when not referenced elsewhere
-    std::unordered_map<std::string, std::weak_ptr<::Mesh>> m_meshCache;
-    std::unordered_map<std::string, std::weak_ptr<SkeletalMesh>> m_skeletalMeshCache;
+    std::unordered_map<MiName, CachedMesh<::Mesh>> m_meshCache;
+    std::unordered_map<MiName, CachedMesh<SkeletalMesh>> m_skeletalMeshCache;
+
+    // In-flight loads, keyed by asset path (request coalescing)
+    std::unordered_map<MiName, std::shared_ptr<PendingStaticLoad>> m_pendingMeshes;
+    std::unordered_map<MiName, std::shared_ptr<PendingSkeletalLoad>> m_pendingSkeletalMeshes;
+
+    uint64_t m_frameIndex = 0;
+    uint32_t m_retainFrames = 120;
+    uint32_t m_maxUploadsPerFrame = 8;
 };
 
 } // namespace MiEngine
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/MappedFile.h"
+#include "material/Material.h"
+#include "texture/BlockCompression.h"
+#include <vulkan/vulkan.h>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MiEngine {
+
+// Per-texture bake report
+struct TextureBakeStats {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevels = 0;
+    BlockFormat format = BlockFormat::BC7;
+    uint64_t uncompressedBytes = 0;   // RGBA8 with full mip chain (what loadFromFile uploads)
+    uint64_t bakedBytes = 0;          // Block-compressed mip chain
+    double decodeMs = 0.0;
+    double mipMs = 0.0;
+    double encodeMs = 0.0;
+    double totalMs = 0.0;
+};
+
+// A baked texture mapped from disk; level pointers stay valid while this lives
+struct BakedTexture {
+    struct Level {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    MappedFile file;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<Level> levels;        // Level 0 is the full-resolution image
+};
+
+/**
+ * TextureCache bakes source images (PNG/JPG/...) into block-compressed,
+ * pre-mipped KTX2 files so the runtime can map and upload them directly.
+ *
+ * The block format follows the TextureType:
+ *   Diffuse, Emissive            -> BC7 (sRGB)
+ *   Normal                       -> BC5 (XY, Z rebuilt in the shader)
+ *   Metallic, Roughness, AO, Height -> BC4
+ *   MetallicRoughness            -> BC1
+ *   Specular                     -> BC1 (sRGB)
+ *
+ * Files are standard KTX2 (no supercompression, smallest mip first). A
+ * "MiEngine.source" key/value entry records the source hash, modification
+ * time and TextureType so stale bakes are detected like MeshCache.
+ */
+class TextureCache {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // Block format / colour space for a texture type
+    static BlockFormat getBlockFormat(TextureType type);
+    static bool isSrgb(TextureType type);
+    static VkFormat getVkFormat(BlockFormat format, bool srgb);
+
+    // Guess a texture type from naming conventions (_normal, _rough, _ao, ...)
+    static TextureType guessTextureType(const fs::path& sourcePath);
+
+    // Cache file for a source/type pair
+    static fs::path getCachePath(const fs::path& sourcePath, const fs::path& cacheDir, TextureType type);
+
+    // Project Cache/Textures when a project is open, otherwise cache/textures
+    static fs::path getDefaultCacheDir();
+
+    // Decode sourcePath and bake it to cachePath
+    static bool bake(const fs::path& sourcePath, const fs::path& cachePath, TextureType type,
+                     TextureBakeStats* outStats = nullptr);
+
+    // Bake tightly packed RGBA8 pixels (sourcePath is only recorded for validation)
+    static bool bakePixels(const uint8_t* rgba, uint32_t width, uint32_t height,
+                           const fs::path& cachePath, const fs::path& sourcePath, TextureType type,
+                           TextureBakeStats* outStats = nullptr);
+
+    // True if cachePath is a current bake of sourcePath for this type
+    static bool isValid(const fs::path& cachePath, const fs::path& sourcePath, TextureType type);
+
+    // Map a baked file
+    static bool load(const fs::path& cachePath, BakedTexture& outTexture);
+};
+
+} // namespace MiEngine
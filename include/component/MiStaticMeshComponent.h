@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/MiName.h"
 #include "core/MiSceneComponent.h"
 #include "material/Material.h"
 #include <memory>
@@ -33,10 +34,10 @@ public:
     void setMesh(std::shared_ptr<Mesh> mesh);
 
     // Set mesh by asset path (will load via MeshLibrary)
-    void setMeshByPath(const std::string& assetPath);
+    void setMeshByPath(MiName assetPath);
 
     // Get the asset path (for serialization)
-    const std::string& getMeshAssetPath() const { return m_MeshAssetPath; }
+    const std::string& getMeshAssetPath() const { return m_MeshAssetPath.toString(); }
 
     // Check if mesh is loaded
     bool hasMesh() const { return m_Mesh != nullptr; }
@@ -92,7 +93,7 @@ public:
 
 private:
     std::shared_ptr<Mesh> m_Mesh;
-    std::string m_MeshAssetPath;
+    MiName m_MeshAssetPath;    // Interned: the MeshLibrary key
     Material m_Material;
 
     bool m_CastShadows = true;
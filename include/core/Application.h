@@ -4,6 +4,7 @@
 #include "VulkanRenderer.h"
 #include "Game.h"
 #include "Input.h"
+#include "core/JobSystem.h"
 #include "project/ProjectManager.h"
 
 class Application {
@@ -16,6 +17,9 @@ public:
     }
 
     void Run() {
+        // The job system's main thread is the one that creates it
+        MiEngine::JobSystem& jobSystem = MiEngine::JobSystem::getInstance();
+
         // Initialize Renderer (Window, Vulkan, etc.)
         // We might need to split initWindow and initVulkan if we want to hook Input early
         m_Renderer->initWindow(); 
@@ -41,6 +45,7 @@ public:
             lastTime = currentTime;
 
             glfwPollEvents();
+            jobSystem.runMainThreadJobs();
 
             // Update Game
             m_Game->OnUpdate(deltaTime);
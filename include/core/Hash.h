@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace MiEngine {
+
+// FNV-1a, used where a hash has to be stable across runs and toolchains
+// (unlike std::hash): cache file names, journal checksums, interned names.
+// Stored values depend on these, so the constants must never change.
+constexpr uint32_t FNV1A32_OFFSET = 2166136261u;
+constexpr uint32_t FNV1A32_PRIME = 16777619u;
+constexpr uint64_t FNV1A64_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV1A64_PRIME = 1099511628211ull;
+
+inline uint32_t fnv1a32(const void* data, size_t size, uint32_t hash = FNV1A32_OFFSET) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV1A32_PRIME;
+    }
+    return hash;
+}
+
+inline uint32_t fnv1a32(std::string_view text, uint32_t hash = FNV1A32_OFFSET) {
+    return fnv1a32(text.data(), text.size(), hash);
+}
+
+inline uint64_t fnv1a64(const void* data, size_t size, uint64_t hash = FNV1A64_OFFSET) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV1A64_PRIME;
+    }
+    return hash;
+}
+
+inline uint64_t fnv1a64(std::string_view text, uint64_t hash = FNV1A64_OFFSET) {
+    return fnv1a64(text.data(), text.size(), hash);
+}
+
+} // namespace MiEngine
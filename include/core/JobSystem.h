@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MiEngine {
+
+struct Job;
+
+/**
+ * JobCounter tracks a group of scheduled jobs. Every job scheduled with the
+ * counter increments it and decrements it when done; jobs can depend on a
+ * counter and only become runnable once it drops to zero.
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+    uint32_t getPending() const { return m_Pending.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_Pending{ 0 };
+    std::mutex m_Mutex;                         // guards m_Waiters against the last decrement
+    std::vector<Job*> m_Waiters;                // jobs scheduled with this counter as dependency
+};
+
+using JobCounterRef = std::shared_ptr<JobCounter>;
+
+enum class JobAffinity {
+    Any,            // any worker, or a thread waiting on the system
+    MainThread,     // only the main thread (runMainThreadJobs or a wait on the main thread)
+    Background      // long tasks (asset loads, IBL builds): any thread but the main thread,
+                    // taken when no other work is queued. The main thread takes them only without workers
+};
+
+struct JobDesc {
+    const char* name = "Job";                   // reported to the instrumentation hooks
+    JobAffinity affinity = JobAffinity::Any;
+    JobCounterRef dependency;                   // job is queued once this counter reaches zero
+};
+
+// Passed to the instrumentation hooks around every job
+struct JobEvent {
+    const char* name = nullptr;
+    uint32_t threadIndex = 0;                   // 0 = main thread, 1..N = workers, ~0u = other threads
+    bool stolen = false;                        // taken from another thread's deque
+    std::chrono::high_resolution_clock::time_point start;
+    std::chrono::high_resolution_clock::time_point end;     // set for onJobEnd only
+};
+
+struct JobInstrumentation {
+    std::function<void(const JobEvent&)> onJobBegin;
+    std::function<void(const JobEvent&)> onJobEnd;
+};
+
+struct JobSystemStats {
+    uint64_t executed = 0;
+    uint64_t stolen = 0;
+    uint64_t mainThreadJobs = 0;
+};
+
+/**
+ * JobSystem runs fine-grained engine work (world tick, scene update,
+ * clustering) across a fixed set of workers.
+ *
+ * Each worker and the main thread own a work-stealing deque: a thread pushes
+ * and pops its own jobs LIFO at the bottom, idle threads steal FIFO from the
+ * top of others. Jobs scheduled from other threads go through a shared
+ * injection queue, MainThread jobs through a queue only the main thread
+ * drains, and Background jobs through a queue the main thread leaves alone.
+ * wait() never blocks a thread that could run jobs: it executes queued work
+ * until the counter is done, so jobs may wait on jobs.
+ *
+ * The main thread is the thread that constructs the system. ThreadPool is the
+ * future-returning front end for background tasks and has no workers of its own.
+ * Destroying the system runs every job still queued, MainThread ones included.
+ */
+class JobSystem {
+public:
+    using JobFunction = std::function<void()>;
+
+    // Shared engine job system (hardware_concurrency - 1 workers, at least 1)
+    static JobSystem& getInstance();
+
+    static constexpr uint32_t DEFAULT_WORKER_COUNT = ~0u;
+    static constexpr uint32_t EXTERNAL_THREAD_INDEX = ~0u;
+
+    // DEFAULT_WORKER_COUNT picks hardware_concurrency - 1. With 0 workers every
+    // job runs on the main thread or a thread waiting on the system.
+    explicit JobSystem(uint32_t workerCount = DEFAULT_WORKER_COUNT);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Queue func. It signals counter (created when null), which is returned.
+    JobCounterRef schedule(JobFunction func, const JobDesc& desc = {}, JobCounterRef counter = nullptr);
+
+    // Run func(i) for i in [0, count) in chunks of grainSize iterations.
+    // Blocks until all iterations finish; the calling thread participates.
+    void parallelFor(size_t count, const std::function<void(size_t)>& func, size_t grainSize = 1,
+                     const char* name = "parallelFor");
+
+    // Execute queued jobs until counter is done (null counters are done)
+    void wait(const JobCounterRef& counter);
+
+    // Run every queued MainThread job. Call once per frame from the main thread.
+    uint32_t runMainThreadJobs();
+
+    bool isMainThread() const;
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+    // Hooks are read without locking; set them while no jobs are running
+    void setInstrumentation(JobInstrumentation instrumentation) { m_Instrumentation = std::move(instrumentation); }
+
+    JobSystemStats getStats() const;
+    void resetStats();
+
+private:
+    class WorkStealingDeque;
+    struct ThreadState;
+
+    void workerLoop(uint32_t threadIndex);
+    uint32_t getCurrentThreadIndex() const;
+
+    void enqueue(Job* job);
+    Job* findJob(uint32_t threadIndex, bool& stolen);
+    static Job* popFront(std::mutex& mutex, std::deque<Job*>& queue, std::atomic<uint32_t>& size);
+    bool runOneJob();
+    void execute(Job* job, uint32_t threadIndex, bool stolen);
+    void finish(Job* job);
+    void wakeWorkers(uint32_t count);
+
+    uint32_t m_ThreadCount = 0;                                 // workers + main thread
+    std::vector<std::unique_ptr<ThreadState>> m_Threads;        // [0] main thread, [i] worker i
+    std::vector<std::thread> m_Workers;
+    std::thread::id m_MainThreadId;
+
+    std::mutex m_InjectMutex;
+    std::deque<Job*> m_InjectQueue;                             // jobs scheduled by other threads
+    std::atomic<uint32_t> m_InjectSize{ 0 };
+    std::mutex m_MainThreadMutex;
+    std::deque<Job*> m_MainThreadQueue;
+    std::atomic<uint32_t> m_MainThreadSize{ 0 };
+    std::mutex m_BackgroundMutex;
+    std::deque<Job*> m_BackgroundQueue;
+    std::atomic<uint32_t> m_BackgroundSize{ 0 };
+
+    std::atomic<int32_t> m_QueuedJobs{ 0 };                     // runnable Any/Background jobs, hint for sleeping workers
+    std::atomic<uint32_t> m_SleepingWorkers{ 0 };
+    std::mutex m_WakeMutex;
+    std::condition_variable m_WakeCondition;
+    std::atomic<bool> m_Stopping{ false };
+
+    JobInstrumentation m_Instrumentation;
+    std::atomic<uint64_t> m_ExternalExecuted{ 0 };              // jobs run by threads outside the system
+};
+
+} // namespace MiEngine
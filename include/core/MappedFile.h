@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+
+namespace MiEngine {
+
+/**
+ * MappedFile is a read-only memory mapping of a file on disk.
+ * Used by binary caches that want to read straight from the page cache
+ * instead of copying the whole file through an ifstream.
+ *
+ * Empty files open successfully with size() == 0 and data() == nullptr.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path) { open(path); }
+    ~MappedFile();
+
+    // Non-copyable, movable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    bool isOpen() const { return m_IsOpen; }
+    const uint8_t* data() const { return m_Data; }
+    size_t size() const { return m_Size; }
+
+    // Typed view at a byte offset, nullptr if [offset, offset + sizeof(T) * count) is out of range
+    template<typename T>
+    const T* at(size_t offset, size_t count = 1) const {
+        if (!m_Data || offset > m_Size || count > (m_Size - offset) / sizeof(T)) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(m_Data + offset);
+    }
+
+private:
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+    bool m_IsOpen = false;
+
+#ifdef _WIN32
+    void* m_FileHandle = nullptr;
+    void* m_MappingHandle = nullptr;
+#else
+    int m_Fd = -1;
+#endif
+};
+
+} // namespace MiEngine
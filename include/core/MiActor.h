@@ -1,13 +1,16 @@
 #pragma once
 
+#include "core/MiName.h"
 #include "core/MiObject.h"
+#include "core/MiObjectPool.h"
 #include "core/MiTransform.h"
+#include "core/MiTickScheduler.h"
+#include "core/MiTypeIndex.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <vector>
 #include <memory>
-#include <unordered_map>
-#include <typeindex>
+#include <span>
 #include <string>
 
 namespace MiEngine {
@@ -54,6 +57,22 @@ inline bool hasFlag(ActorFlags flags, ActorFlags flag) {
     return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(flag)) != 0;
 }
 
+// weak_ptr to an actor that also expires when the actor is recycled: MiRecycleBin
+// hands the same object out again as a new actor, which a plain weak_ptr would
+// still lock to. Compares the actor's generation, bumped on every recycle.
+class MiWeakActorPtr {
+public:
+    MiWeakActorPtr() = default;
+    MiWeakActorPtr(const std::shared_ptr<MiActor>& actor);
+
+    std::shared_ptr<MiActor> lock() const;
+    bool expired() const { return !lock(); }
+
+private:
+    std::weak_ptr<MiActor> m_Actor;
+    uint32_t m_Generation = 0;
+};
+
 // Base class for all actors (similar to AActor in UE5)
 // Actors are the primary entities that can be placed in a world
 class MiActor : public MiObject {
@@ -72,12 +91,15 @@ public:
     // Note: setWorld is called internally by MiWorld
     void setWorld(MiWorld* world) { m_World = world; }
 
+    // Renaming a registered actor updates the world's name index
+    void setName(const std::string& name) override;
+
     // ========================================================================
     // Transform (via root component)
     // ========================================================================
 
     // Get/set the actor's transform (delegates to root component)
-    const MiTransform& getTransform() const;
+    MiTransform getTransform() const;
     void setTransform(const MiTransform& transform);
 
     // Convenience accessors
@@ -110,9 +132,9 @@ public:
     template<typename T>
     std::shared_ptr<T> getComponent() const;
 
-    // Get all components of type T
+    // Get all components of type T, in component order. Valid until a component is added or removed
     template<typename T>
-    std::vector<std::shared_ptr<T>> getComponents() const;
+    std::span<T* const> getComponents() const;
 
     // Check if actor has component of type T
     template<typename T>
@@ -155,6 +177,28 @@ public:
     // Check if actor has begun play
     bool hasBegunPlay() const { return m_HasBegunPlay; }
 
+    // ========================================================================
+    // Tick Settings
+    // ========================================================================
+
+    TickGroup getTickGroup() const { return m_TickGroup; }
+    void setTickGroup(TickGroup group);
+
+    // Opt-in parallel ticking: tick() only touches this actor and its components
+    // (other actors only through MiWorld spawn/destroy, which are deferred).
+    // Tickable components must also be thread-safe, see canTickInParallel().
+    bool isTickThreadSafe() const { return m_TickThreadSafe; }
+    void setTickThreadSafe(bool threadSafe);
+
+    // prerequisite ticks before this actor when both are in the same tick group
+    // (an earlier group always ticks first; a later group can't be waited on)
+    void addTickPrerequisite(const std::shared_ptr<MiActor>& prerequisite);
+    void removeTickPrerequisite(const std::shared_ptr<MiActor>& prerequisite);
+    const std::vector<MiWeakActorPtr>& getTickPrerequisites() const { return m_TickPrerequisites; }
+
+    // Thread-safe actor whose tickable components are all thread-safe
+    bool canTickInParallel() const;
+
     // Called when actor is registered/unregistered from world
     // Good time for components to load resources
     virtual void onRegister();
@@ -182,10 +226,12 @@ public:
     // Tags
     // ========================================================================
 
-    void addTag(const std::string& tag);
-    void removeTag(const std::string& tag);
-    bool hasTag(const std::string& tag) const;
-    const std::vector<std::string>& getTags() const { return m_Tags; }
+    // Tags are interned, so hasTag is an integer compare per tag; pass
+    // MiName::find(text) to look one up without interning it
+    void addTag(MiName tag);
+    void removeTag(MiName tag);
+    bool hasTag(MiName tag) const;
+    const std::vector<MiName>& getTags() const { return m_Tags; }
 
     // ========================================================================
     // Layer
@@ -204,6 +250,19 @@ public:
     // Check if actor is being destroyed
     bool isBeingDestroyed() const { return hasFlag(m_Flags, ActorFlags::Destroying); }
 
+    // ========================================================================
+    // Recycling
+    // ========================================================================
+
+    // Opt in to being kept by MiWorld on destroy and reused by the next
+    // spawnActor<T>() of the same type (see MiRecycleBin)
+    bool isRecyclable() const { return m_Recyclable; }
+    void setRecyclable(bool recyclable) { m_Recyclable = recyclable; }
+
+    // Bumped each time the actor is recycled, so references from an earlier
+    // life can tell it is a different actor now (see MiWeakActorPtr)
+    uint32_t getGeneration() const { return m_Generation; }
+
     // ========================================================================
     // Serialization
     // ========================================================================
@@ -224,25 +283,46 @@ protected:
     // Called when the root component's transform changes
     virtual void onTransformChanged() {}
 
+    // Reset hook for a recycled actor, after endPlay/onUnregister and before it
+    // is reused. Put gameplay state back to its spawn values here; the engine
+    // has already cleared the destroy flags and tick prerequisites. Default
+    // calls onRecycled() on every component.
+    virtual void onRecycled();
+
 private:
+    friend class MiRecycleBin;
+
+    // Engine state cleared before onRecycled()
+    void resetForReuse();
+
     // Internal component registration
     void registerComponent(const std::shared_ptr<MiComponent>& component);
     void unregisterComponent(const std::shared_ptr<MiComponent>& component);
 
-    // Update component type cache
+    // Refill the component type index in component order
     void rebuildComponentTypeCache();
 
+    // Tick settings or tickable components changed
+    void markTickScheduleDirty();
+
     MiWorld* m_World = nullptr;
     std::shared_ptr<MiSceneComponent> m_RootComponent;
     std::vector<std::shared_ptr<MiComponent>> m_Components;
-    std::unordered_map<std::type_index, std::vector<size_t>> m_ComponentsByType;
+    mutable MiTypeIndexSet m_ComponentsByType;      // Per queried type, filled by the first query
 
     ActorFlags m_Flags = ActorFlags::None;
-    std::vector<std::string> m_Tags;
+    std::vector<MiName> m_Tags;
     uint32_t m_Layer = 0;
 
     bool m_HasBegunPlay = false;
 
+    TickGroup m_TickGroup = TickGroup::PrePhysics;
+    bool m_TickThreadSafe = false;
+    std::vector<MiWeakActorPtr> m_TickPrerequisites;
+
+    bool m_Recyclable = false;
+    uint32_t m_Generation = 0;
+
     // Default transform for actors without root component
     static MiTransform s_DefaultTransform;
 };
@@ -255,7 +335,7 @@ template<typename T, typename... Args>
 std::shared_ptr<T> MiActor::addComponent(Args&&... args) {
     static_assert(std::is_base_of<MiComponent, T>::value, "T must derive from MiComponent");
 
-    auto component = std::make_shared<T>(std::forward<Args>(args)...);
+    auto component = makePooled<T>(std::forward<Args>(args)...);
     registerComponent(component);
 
     // If this is a scene component and we don't have a root, set it as root
@@ -272,47 +352,50 @@ template<typename T>
 std::shared_ptr<T> MiActor::getComponent() const {
     static_assert(std::is_base_of<MiComponent, T>::value, "T must derive from MiComponent");
 
-    // First check the type cache for exact match
-    auto it = m_ComponentsByType.find(typeid(T));
-    if (it != m_ComponentsByType.end() && !it->second.empty()) {
-        return std::static_pointer_cast<T>(m_Components[it->second[0]]);
-    }
-
-    // Fallback: search all components for derived types
-    for (const auto& comp : m_Components) {
-        if (auto cast = std::dynamic_pointer_cast<T>(comp)) {
-            return cast;
-        }
+    std::span<T* const> components = m_ComponentsByType.get<T>();
+    if (components.empty()) {
+        return nullptr;
     }
-    return nullptr;
+    // Aliasing constructor: shares ownership with the component
+    T* component = components.front();
+    return std::shared_ptr<T>(component->shared_from_this(), component);
 }
 
 template<typename T>
-std::vector<std::shared_ptr<T>> MiActor::getComponents() const {
+std::span<T* const> MiActor::getComponents() const {
     static_assert(std::is_base_of<MiComponent, T>::value, "T must derive from MiComponent");
-
-    std::vector<std::shared_ptr<T>> result;
-    for (const auto& comp : m_Components) {
-        if (auto cast = std::dynamic_pointer_cast<T>(comp)) {
-            result.push_back(cast);
-        }
-    }
-    return result;
+    return m_ComponentsByType.get<T>();
 }
 
 template<typename T>
 bool MiActor::hasComponent() const {
-    return getComponent<T>() != nullptr;
+    static_assert(std::is_base_of<MiComponent, T>::value, "T must derive from MiComponent");
+    return !m_ComponentsByType.get<T>().empty();
 }
 
 template<typename T>
 void MiActor::removeComponents() {
     static_assert(std::is_base_of<MiComponent, T>::value, "T must derive from MiComponent");
 
-    auto compsToRemove = getComponents<T>();
+    // Each removal rebuilds the index, so take ownership of the matches first
+    std::vector<std::shared_ptr<MiComponent>> compsToRemove;
+    for (T* comp : getComponents<T>()) {
+        compsToRemove.emplace_back(comp->shared_from_this(), comp);
+    }
     for (const auto& comp : compsToRemove) {
         removeComponent(comp);
     }
 }
 
+inline MiWeakActorPtr::MiWeakActorPtr(const std::shared_ptr<MiActor>& actor)
+    : m_Actor(actor)
+    , m_Generation(actor ? actor->getGeneration() : 0)
+{
+}
+
+inline std::shared_ptr<MiActor> MiWeakActorPtr::lock() const {
+    auto actor = m_Actor.lock();
+    return actor && actor->getGeneration() == m_Generation ? actor : nullptr;
+}
+
 } // namespace MiEngine
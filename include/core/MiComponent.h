@@ -30,6 +30,10 @@ public:
     // Check if component should tick
     virtual bool isTickable() const { return false; }
 
+    // Check if tick() only touches this component and its owner, so the owner
+    // may tick on a worker (see MiActor::setTickThreadSafe)
+    virtual bool isTickThreadSafe() const { return false; }
+
     // Get tick priority (lower = earlier, default = 0)
     virtual int getTickPriority() const { return 0; }
 
@@ -40,6 +44,7 @@ public:
     virtual void onUnregister() {}   // Called when owner actor is unregistered from world
     virtual void beginPlay() {}      // Called when the game/simulation starts
     virtual void endPlay() {}        // Called when the game/simulation ends
+    virtual void onRecycled() {}     // Called when the owner actor is recycled (reset per-spawn state)
     virtual void tick(float deltaTime) {}  // Called every frame if isTickable() returns true
 
     // Called when the owner actor's transform changes
@@ -1,23 +1,229 @@
 #pragma once
 
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <algorithm>
-#include <memory>
 
 namespace MiEngine {
 
 // Handle for delegate binding (allows unbinding later)
+// Low 32 bits are the binding slot, high 32 bits its generation
 using DelegateHandle = uint64_t;
 
 // Invalid handle constant
 constexpr DelegateHandle InvalidDelegateHandle = 0;
 
+// ============================================================================
+// MiFunction
+// ============================================================================
+
+// Type-erased void(Args...) callable. Callables up to INLINE_SIZE bytes that
+// are nothrow-movable live in the object itself, so binding a lambda or a
+// member function doesn't allocate; larger ones go on the heap.
+template<typename... Args>
+class MiFunction {
+public:
+    static constexpr size_t INLINE_SIZE = 32;
+
+    MiFunction() noexcept = default;
+    MiFunction(std::nullptr_t) noexcept {}
+
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, MiFunction> &&
+                                         std::is_invocable_v<std::decay_t<F>&, Args...>>>
+    MiFunction(F&& functor) {
+        assign(std::forward<F>(functor));
+    }
+
+    // Member function: stored inline, no lambda wrapper
+    template<typename T>
+    MiFunction(T* object, void (T::*memberFunc)(Args...)) noexcept {
+        using Binding = MemberBinding<T>;
+        static_assert(sizeof(Binding) <= INLINE_SIZE, "member function pointer doesn't fit inline");
+        new (m_Storage) Binding{object, memberFunc};
+        m_Invoke = &invokeMember<T>;
+    }
+
+    MiFunction(const MiFunction& other) {
+        copyFrom(other);
+    }
+
+    MiFunction(MiFunction&& other) noexcept {
+        moveFrom(other);
+    }
+
+    MiFunction& operator=(const MiFunction& other) {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    MiFunction& operator=(MiFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    MiFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~MiFunction() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept { return m_Invoke != nullptr; }
+
+    void operator()(Args... args) const {
+        m_Invoke(m_Storage, std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept {
+        if (m_Manage) {
+            m_Manage(Operation::Destroy, m_Storage, nullptr);
+        }
+        m_Invoke = nullptr;
+        m_Manage = nullptr;
+    }
+
+private:
+    enum class Operation { Copy, Move, Destroy };
+
+    using InvokeFn = void (*)(void* storage, Args&&... args);
+    // nullptr for trivially copyable inline callables (copied with memcpy)
+    using ManageFn = void (*)(Operation operation, void* storage, void* source);
+
+    template<typename T>
+    struct MemberBinding {
+        T* object;
+        void (T::*memberFunc)(Args...);
+    };
+
+    template<typename F>
+    static constexpr bool fitsInline = sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+                                       std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    void assign(F&& functor) {
+        using Functor = std::decay_t<F>;
+        if constexpr (std::is_pointer_v<Functor> || std::is_member_pointer_v<Functor>) {
+            if (!functor) {
+                return;
+            }
+        }
+
+        if constexpr (fitsInline<Functor>) {
+            new (m_Storage) Functor(std::forward<F>(functor));
+            m_Invoke = &invokeInline<Functor>;
+            if constexpr (!std::is_trivially_copyable_v<Functor>) {
+                m_Manage = &manageInline<Functor>;
+            }
+        } else {
+            *reinterpret_cast<Functor**>(m_Storage) = new Functor(std::forward<F>(functor));
+            m_Invoke = &invokeHeap<Functor>;
+            m_Manage = &manageHeap<Functor>;
+        }
+    }
+
+    void copyFrom(const MiFunction& other) {
+        if (!other.m_Invoke) {
+            return;
+        }
+        if (other.m_Manage) {
+            other.m_Manage(Operation::Copy, m_Storage, other.m_Storage);
+        } else {
+            std::memcpy(m_Storage, other.m_Storage, INLINE_SIZE);
+        }
+        m_Invoke = other.m_Invoke;
+        m_Manage = other.m_Manage;
+    }
+
+    void moveFrom(MiFunction& other) noexcept {
+        if (!other.m_Invoke) {
+            return;
+        }
+        if (other.m_Manage) {
+            other.m_Manage(Operation::Move, m_Storage, other.m_Storage);
+        } else {
+            std::memcpy(m_Storage, other.m_Storage, INLINE_SIZE);
+        }
+        m_Invoke = other.m_Invoke;
+        m_Manage = other.m_Manage;
+        other.m_Invoke = nullptr;
+        other.m_Manage = nullptr;
+    }
+
+    template<typename T>
+    static void invokeMember(void* storage, Args&&... args) {
+        auto* binding = static_cast<MemberBinding<T>*>(storage);
+        (binding->object->*binding->memberFunc)(std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static void invokeInline(void* storage, Args&&... args) {
+        (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static void invokeHeap(void* storage, Args&&... args) {
+        (**static_cast<F**>(storage))(std::forward<Args>(args)...);
+    }
+
+    template<typename F>
+    static void manageInline(Operation operation, void* storage, void* source) {
+        switch (operation) {
+            case Operation::Copy:
+                new (storage) F(*static_cast<const F*>(source));
+                break;
+            case Operation::Move:
+                new (storage) F(std::move(*static_cast<F*>(source)));
+                static_cast<F*>(source)->~F();
+                break;
+            case Operation::Destroy:
+                static_cast<F*>(storage)->~F();
+                break;
+        }
+    }
+
+    template<typename F>
+    static void manageHeap(Operation operation, void* storage, void* source) {
+        switch (operation) {
+            case Operation::Copy:
+                *static_cast<F**>(storage) = new F(**static_cast<F* const*>(source));
+                break;
+            case Operation::Move:
+                *static_cast<F**>(storage) = *static_cast<F**>(source);
+                break;
+            case Operation::Destroy:
+                delete *static_cast<F**>(storage);
+                break;
+        }
+    }
+
+    // Callables are invoked non-const, like std::function
+    alignas(std::max_align_t) mutable unsigned char m_Storage[INLINE_SIZE];
+    InvokeFn m_Invoke = nullptr;
+    ManageFn m_Manage = nullptr;
+};
+
+// ============================================================================
+// Delegates
+// ============================================================================
+
 // Single-cast delegate (one function only)
 template<typename... Args>
 class MiSingleDelegate {
 public:
-    using FunctionType = std::function<void(Args...)>;
+    using FunctionType = MiFunction<Args...>;
 
     MiSingleDelegate() = default;
 
@@ -29,9 +235,7 @@ public:
     // Bind a member function
     template<typename T>
     void bind(T* object, void (T::*memberFunc)(Args...)) {
-        m_Function = [object, memberFunc](Args... args) {
-            (object->*memberFunc)(std::forward<Args>(args)...);
-        };
+        m_Function = FunctionType(object, memberFunc);
     }
 
     // Unbind
@@ -70,68 +274,133 @@ private:
 };
 
 // Multi-cast delegate (multiple functions)
+//
+// Bindings live in slots reused through a free list; a handle is the slot
+// index plus the slot's generation, which changes when the slot is freed, so
+// remove() is O(1) and stale handles are ignored. broadcast() calls the slots
+// in place without copying them:
+// - a binding removed during a broadcast isn't called again; its slot is
+//   freed once the outermost broadcast returns (it may be the one running)
+// - a binding added during a broadcast is called from the next broadcast on
+// Not thread-safe. Handles refer to this delegate, so it can't be copied.
 template<typename... Args>
 class MiMulticastDelegate {
 public:
-    using FunctionType = std::function<void(Args...)>;
+    using FunctionType = MiFunction<Args...>;
+
+    MiMulticastDelegate() = default;
 
-    MiMulticastDelegate() : m_NextHandle(1) {}
+    MiMulticastDelegate(const MiMulticastDelegate&) = delete;
+    MiMulticastDelegate& operator=(const MiMulticastDelegate&) = delete;
+    MiMulticastDelegate(MiMulticastDelegate&&) noexcept = default;
+    MiMulticastDelegate& operator=(MiMulticastDelegate&&) noexcept = default;
 
     // Add a function, returns handle for later removal
     DelegateHandle add(FunctionType func) {
-        DelegateHandle handle = m_NextHandle++;
-        m_Bindings.push_back({handle, std::move(func)});
-        return handle;
+        if (!func) {
+            return InvalidDelegateHandle;
+        }
+        ++m_BindingCount;
+
+        // Slots can't move while a broadcast may be running one of them
+        if (m_BroadcastDepth > 0) {
+            uint32_t index = static_cast<uint32_t>(m_Slots.size() + m_Added.size());
+            m_Added.push_back({std::move(func), 1, true});
+            return makeHandle(index, 1);
+        }
+
+        uint32_t index;
+        if (!m_FreeSlots.empty()) {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+            m_Slots[index].function = std::move(func);
+            m_Slots[index].bound = true;
+        } else {
+            index = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.push_back({std::move(func), 1, true});
+        }
+        return makeHandle(index, m_Slots[index].generation);
     }
 
     // Add a member function
     template<typename T>
     DelegateHandle add(T* object, void (T::*memberFunc)(Args...)) {
-        return add([object, memberFunc](Args... args) {
-            (object->*memberFunc)(std::forward<Args>(args)...);
-        });
+        return add(FunctionType(object, memberFunc));
     }
 
     // Add a lambda or functor
-    template<typename F>
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionType>>>
     DelegateHandle add(F&& functor) {
         return add(FunctionType(std::forward<F>(functor)));
     }
 
     // Remove by handle
     bool remove(DelegateHandle handle) {
-        auto it = std::find_if(m_Bindings.begin(), m_Bindings.end(),
-            [handle](const Binding& b) { return b.handle == handle; });
-
-        if (it != m_Bindings.end()) {
-            m_Bindings.erase(it);
+        uint32_t index = static_cast<uint32_t>(handle & 0xFFFFFFFFu);
+        uint32_t generation = static_cast<uint32_t>(handle >> 32);
+
+        if (index >= m_Slots.size()) {
+            // Added during the running broadcast
+            size_t addedIndex = index - m_Slots.size();
+            if (addedIndex >= m_Added.size() || !m_Added[addedIndex].bound ||
+                m_Added[addedIndex].generation != generation) {
+                return false;
+            }
+            m_Added[addedIndex].bound = false;
+            m_Added[addedIndex].function = nullptr;
+            --m_BindingCount;
             return true;
         }
-        return false;
+
+        Slot& slot = m_Slots[index];
+        if (!slot.bound || slot.generation != generation) {
+            return false;
+        }
+        slot.bound = false;
+        --m_BindingCount;
+
+        if (m_BroadcastDepth > 0) {
+            m_RemovedSlots.push_back(index);
+        } else {
+            freeSlot(index);
+        }
+        return true;
     }
 
     // Remove all bindings
     void clear() {
-        m_Bindings.clear();
+        for (uint32_t index = 0; index < m_Slots.size(); ++index) {
+            if (m_Slots[index].bound) {
+                remove(makeHandle(index, m_Slots[index].generation));
+            }
+        }
+        for (auto& slot : m_Added) {
+            slot.bound = false;
+            slot.function = nullptr;
+        }
+        m_BindingCount = 0;
     }
 
     // Check if any bindings
     bool isBound() const {
-        return !m_Bindings.empty();
+        return m_BindingCount > 0;
     }
 
     // Get binding count
     size_t getBindingCount() const {
-        return m_Bindings.size();
+        return m_BindingCount;
     }
 
     // Broadcast to all bindings
     void broadcast(Args... args) const {
-        // Copy bindings in case a callback modifies the list
-        auto bindingsCopy = m_Bindings;
-        for (const auto& binding : bindingsCopy) {
-            if (binding.function) {
-                binding.function(args...);
+        BroadcastScope scope(*this);
+
+        // Slots added by the callbacks are past count (or in m_Added)
+        const size_t count = m_Slots.size();
+        for (size_t i = 0; i < count; ++i) {
+            const Slot& slot = m_Slots[i];
+            if (slot.bound) {
+                slot.function(args...);
             }
         }
     }
@@ -142,13 +411,67 @@ public:
     }
 
 private:
-    struct Binding {
-        DelegateHandle handle;
+    struct Slot {
         FunctionType function;
+        uint32_t generation;
+        bool bound;
+    };
+
+    // Applies adds/removes deferred by the callbacks when the outermost broadcast
+    // returns. Those went through add/remove, so the delegate isn't const.
+    struct BroadcastScope {
+        explicit BroadcastScope(const MiMulticastDelegate& delegate)
+            : m_Delegate(delegate) {
+            ++m_Delegate.m_BroadcastDepth;
+        }
+
+        ~BroadcastScope() {
+            if (--m_Delegate.m_BroadcastDepth == 0 &&
+                (!m_Delegate.m_RemovedSlots.empty() || !m_Delegate.m_Added.empty())) {
+                const_cast<MiMulticastDelegate&>(m_Delegate).applyDeferred();
+            }
+        }
+
+        const MiMulticastDelegate& m_Delegate;
     };
 
-    std::vector<Binding> m_Bindings;
-    DelegateHandle m_NextHandle;
+    static DelegateHandle makeHandle(uint32_t index, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    void freeSlot(uint32_t index) {
+        Slot& slot = m_Slots[index];
+        slot.function = nullptr;
+        // Generation 0 would make a handle of slot 0 invalid
+        if (++slot.generation == 0) {
+            slot.generation = 1;
+        }
+        m_FreeSlots.push_back(index);
+    }
+
+    void applyDeferred() {
+        for (uint32_t index : m_RemovedSlots) {
+            freeSlot(index);
+        }
+        m_RemovedSlots.clear();
+
+        for (auto& added : m_Added) {
+            uint32_t index = static_cast<uint32_t>(m_Slots.size());
+            bool bound = added.bound;
+            m_Slots.push_back(std::move(added));
+            if (!bound) {
+                freeSlot(index);
+            }
+        }
+        m_Added.clear();
+    }
+
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+    std::vector<Slot> m_Added;              // Added during a broadcast, indices follow m_Slots
+    std::vector<uint32_t> m_RemovedSlots;   // Removed during a broadcast, freed after it
+    size_t m_BindingCount = 0;
+    mutable int m_BroadcastDepth = 0;
 };
 
 // Convenience aliases
@@ -211,7 +534,7 @@ public:
 
 private:
     DelegateHandle m_Handle;
-    std::function<void()> m_Unbinder;
+    MiFunction<> m_Unbinder;
 };
 
 // Helper to create RAII delegate handle
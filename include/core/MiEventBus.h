@@ -0,0 +1,220 @@
+#pragma once
+
+#include "core/MiDelegate.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MiEngine {
+
+// ============================================================================
+// Event Queue
+// ============================================================================
+
+class MiEventQueueBase {
+public:
+    virtual ~MiEventQueueBase() = default;
+
+    // Take the events posted so far for deliver()
+    virtual void swapPending() = 0;
+
+    // Hand the taken events to the listeners as one array; returns the event count
+    virtual size_t deliver() = 0;
+
+    virtual void clear() = 0;
+};
+
+// Events of one type E: producers append to the pending buffer under a lock,
+// dispatch swaps it with the delivery buffer. Both keep their capacity, so a
+// steady event rate stops allocating after the first frames.
+template<typename E>
+class MiEventQueue : public MiEventQueueBase {
+public:
+    using BatchDelegate = MiMulticastDelegate<std::span<const E>>;
+
+    template<typename Event>
+    void post(Event&& event) {
+        // Listeners only change on the game thread, between ticks
+        if (!m_Listeners.isBound()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Pending.push_back(std::forward<Event>(event));
+    }
+
+    void postBatch(std::span<const E> events) {
+        if (!m_Listeners.isBound() || events.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Pending.insert(m_Pending.end(), events.begin(), events.end());
+    }
+
+    void swapPending() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        // Only non-empty if a listener threw; that batch is not delivered twice
+        m_Delivering.clear();
+        m_Delivering.swap(m_Pending);
+    }
+
+    size_t deliver() override {
+        size_t count = m_Delivering.size();
+        if (count > 0) {
+            m_Listeners.broadcast(std::span<const E>(m_Delivering));
+            m_Delivering.clear();
+        }
+        return count;
+    }
+
+    void clear() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Pending.clear();
+    }
+
+    BatchDelegate& getListeners() { return m_Listeners; }
+
+private:
+    std::vector<E> m_Pending;
+    std::vector<E> m_Delivering;
+    std::mutex m_Mutex;
+    BatchDelegate m_Listeners;
+};
+
+// ============================================================================
+// Event Bus
+// ============================================================================
+
+// Deferred, typed events. post() queues an event from any thread (parallel
+// ticks included); dispatch() hands each type's queued events to its
+// listeners as one contiguous array. The world dispatches after PostPhysics
+// and again at the end of the frame, after spawns and destroys are applied.
+//
+// Events posted while dispatching (by listeners) are delivered at the next
+// dispatch; events of a type nobody subscribes to are dropped when posted.
+// Listeners run on the dispatching thread; subscribe/unsubscribe from the
+// game thread only. Events are copied into the queue, so hold ids rather
+// than raw pointers to things that may be destroyed before delivery.
+class MiEventBus {
+public:
+    static constexpr uint32_t MAX_EVENT_TYPES = 256;
+
+    // Counters for one frame (latched by endFrame)
+    struct Stats {
+        uint64_t eventCount = 0;    // Events delivered
+        uint32_t batchCount = 0;    // Non-empty per-type batches delivered
+        uint32_t dispatchCount = 0;
+        double dispatchMs = 0.0;    // Time spent in dispatch, listeners included
+    };
+
+    MiEventBus() = default;
+
+    MiEventBus(const MiEventBus&) = delete;
+    MiEventBus& operator=(const MiEventBus&) = delete;
+
+    // Queue an event (thread-safe)
+    template<typename E>
+    void post(E&& event);
+
+    // Queue several events under one lock (producers batching per job)
+    template<typename E>
+    void postBatch(std::span<const E> events);
+
+    // listener(std::span<const E>) receives every queued E at each dispatch
+    template<typename E, typename F>
+    DelegateHandle subscribe(F&& listener);
+
+    // listener(const E&) is called for each event of the batch
+    template<typename E, typename F>
+    DelegateHandle subscribeEach(F&& listener);
+
+    template<typename E>
+    bool unsubscribe(DelegateHandle handle);
+
+    // Deliver everything queued so far, type by type in first-use order
+    void dispatch();
+
+    // Latch this frame's counters into getLastFrameStats() and reset them
+    void endFrame();
+
+    // Drop queued events without delivering them
+    void clear();
+
+    const Stats& getLastFrameStats() const { return m_LastFrameStats; }
+
+private:
+    template<typename E>
+    static uint32_t eventTypeIndex() {
+        static const uint32_t index = nextEventTypeIndex();
+        return index;
+    }
+
+    static uint32_t nextEventTypeIndex();
+
+    template<typename E>
+    MiEventQueue<E>& getQueue();
+
+    MiEventQueueBase* createQueue(uint32_t typeIndex, std::unique_ptr<MiEventQueueBase> queue);
+
+    // Lookup by event type index, lock-free once the queue exists
+    std::array<std::atomic<MiEventQueueBase*>, MAX_EVENT_TYPES> m_QueuesByType{};
+    // Owning, in creation order; the first m_QueueCount are set
+    std::array<std::unique_ptr<MiEventQueueBase>, MAX_EVENT_TYPES> m_Queues;
+    std::atomic<uint32_t> m_QueueCount{0};
+    std::mutex m_CreateMutex;
+
+    bool m_Dispatching = false;
+    Stats m_FrameStats;
+    Stats m_LastFrameStats;
+};
+
+template<typename E>
+void MiEventBus::post(E&& event) {
+    getQueue<std::decay_t<E>>().post(std::forward<E>(event));
+}
+
+template<typename E>
+void MiEventBus::postBatch(std::span<const E> events) {
+    getQueue<E>().postBatch(events);
+}
+
+template<typename E, typename F>
+DelegateHandle MiEventBus::subscribe(F&& listener) {
+    return getQueue<E>().getListeners().add(std::forward<F>(listener));
+}
+
+template<typename E, typename F>
+DelegateHandle MiEventBus::subscribeEach(F&& listener) {
+    return subscribe<E>([listener = std::forward<F>(listener)](std::span<const E> events) mutable {
+        for (const E& event : events) {
+            listener(event);
+        }
+    });
+}
+
+template<typename E>
+bool MiEventBus::unsubscribe(DelegateHandle handle) {
+    return getQueue<E>().getListeners().remove(handle);
+}
+
+template<typename E>
+MiEventQueue<E>& MiEventBus::getQueue() {
+    uint32_t typeIndex = eventTypeIndex<E>();
+    if (typeIndex >= MAX_EVENT_TYPES) {
+        throw std::runtime_error("MiEventBus: too many event types");
+    }
+
+    MiEventQueueBase* queue = m_QueuesByType[typeIndex].load(std::memory_order_acquire);
+    if (!queue) {
+        queue = createQueue(typeIndex, std::make_unique<MiEventQueue<E>>());
+    }
+    return static_cast<MiEventQueue<E>&>(*queue);
+}
+
+} // namespace MiEngine
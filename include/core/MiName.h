@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace MiEngine {
+
+// Interned string (similar to FName in UE5): a 32-bit index into a global,
+// thread-safe name table. Equality and hashing are integer operations; each
+// distinct text is stored once with its hash and never freed. Use it for
+// identifiers that are compared and looked up often (tags, bone names, asset
+// paths) and convert with toString() at I/O boundaries. Case-sensitive; the
+// empty string is None (index 0).
+//
+// Constructing from text interns it, so the constructors are explicit and
+// lookups of arbitrary input use find(), which doesn't grow the table.
+class MiName {
+public:
+    MiName() = default;
+    explicit MiName(std::string_view text);
+    explicit MiName(const std::string& text) : MiName(std::string_view(text)) {}
+    explicit MiName(const char* text) : MiName(text ? std::string_view(text) : std::string_view()) {}
+
+    // The name for text if it was interned already, otherwise None
+    static MiName find(std::string_view text);
+
+    bool isNone() const { return m_Index == 0; }
+    uint32_t getIndex() const { return m_Index; }
+
+    // FNV-1a of the text, computed once when interned (stable across runs, unlike the index)
+    uint32_t getHash() const;
+
+    // The interned text; the reference stays valid for the program's lifetime
+    const std::string& toString() const;
+
+    bool operator==(const MiName& other) const { return m_Index == other.m_Index; }
+    bool operator!=(const MiName& other) const { return m_Index != other.m_Index; }
+
+    // Interning order, not alphabetical (for ordered containers)
+    bool operator<(const MiName& other) const { return m_Index < other.m_Index; }
+
+    // Distinct names interned so far, None included
+    static size_t getNameCount();
+
+private:
+    static MiName fromIndex(uint32_t index) {
+        MiName name;
+        name.m_Index = index;
+        return name;
+    }
+
+    uint32_t m_Index = 0;
+};
+
+static_assert(sizeof(MiName) == 4, "MiName is a 32-bit handle");
+
+std::ostream& operator<<(std::ostream& stream, const MiName& name);
+
+} // namespace MiEngine
+
+namespace std {
+
+// Indices are unique per text, so the index is the hash
+template<>
+struct hash<MiEngine::MiName> {
+    size_t operator()(const MiEngine::MiName& name) const noexcept {
+        return static_cast<size_t>(name.getIndex());
+    }
+};
+
+} // namespace std
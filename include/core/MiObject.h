@@ -1,7 +1,11 @@
 #pragma once
 
+#include "core/MiTypeRegistry.h"
+#include <cassert>
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 namespace MiEngine {
@@ -11,10 +15,29 @@ class JsonWriter;
 class JsonReader;
 class MiWorld;
 
-// Unique identifier type (UUID as string)
-using ObjectId = std::string;
+// Unique identifier: a 128-bit UUID v4 held as two words (16-byte POD).
+// Text form ("xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx") is only used for serialization.
+struct ObjectId {
+    uint64_t high = 0;
+    uint64_t low = 0;
 
-// Generate a new unique ID (UUID v4 format)
+    bool isValid() const { return high != 0 || low != 0; }
+
+    bool operator==(const ObjectId& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const ObjectId& other) const { return !(*this == other); }
+    bool operator<(const ObjectId& other) const { return high != other.high ? high < other.high : low < other.low; }
+
+    // Lowercase 8-4-4-4-12 hex
+    std::string toString() const;
+
+    // Parses UUID text (dashes optional). Other text, e.g. hand-written ids in old
+    // scenes, maps to a stable id hashed from it; empty text gives the invalid id.
+    static ObjectId fromString(std::string_view text);
+};
+
+static_assert(sizeof(ObjectId) == 16, "ObjectId is 16 bytes");
+
+// Generate a new unique ID (UUID v4 layout, per-thread generator)
 ObjectId generateObjectId();
 
 // Base class for all engine objects (similar to UObject in UE5)
@@ -35,17 +58,25 @@ public:
     const ObjectId& getObjectId() const { return m_ObjectId; }
     void setObjectId(const ObjectId& id) { m_ObjectId = id; }
 
-    // Display name
+    // Display name (MiActor overrides setName to keep its world's name index current)
     const std::string& getName() const { return m_Name; }
-    void setName(const std::string& name) { m_Name = name; }
+    virtual void setName(const std::string& name) { m_Name = name; }
 
     // Runtime type information
     virtual const char* getTypeName() const = 0;
     virtual uint32_t getTypeId() const = 0;
+    virtual uint32_t getTypeIndex() const = 0;    // MiTypeRegistry dense index
 
-    // Check if this object is of a specific type
+    // Check if this object is a T or derived from it. Derived matches need
+    // both types registered and linked with MI_REGISTER_TYPE_WITH_PARENT.
     template<typename T>
     bool isA() const {
+        static_assert(MiHasObjectBody<T>, "T must declare its own MI_OBJECT_BODY");
+        // One virtual call: a type's ancestor bits include itself
+        uint32_t typeIndex = getTypeIndex();
+        if (typeIndex != MiTypeRegistry::InvalidTypeIndex) {
+            return MiTypeRegistry::getInstance().isDerivedFromIndex(typeIndex, MiTypeRegistry::typeIndexOf<T>());
+        }
         return getTypeId() == T::StaticTypeId;
     }
 
@@ -81,6 +112,62 @@ public: \
     static constexpr uint32_t StaticTypeId = TypeIdValue; \
     virtual const char* getTypeName() const override { return StaticTypeName; } \
     virtual uint32_t getTypeId() const override { return StaticTypeId; } \
+    virtual uint32_t getTypeIndex() const override { return MiEngine::MiTypeRegistry::typeIndexOf<TypeName>(); } \
 private:
 
+// Downcast checked against the type registry instead of RTTI: null unless
+// object isA<T>(), then a static_cast. A registered parent link is checked at
+// compile time, so a match is always safe. A type registered without its
+// parent misses in every build; debug builds also run dynamic_cast, report the
+// missing link and assert that both agree. Objects of unregistered types
+// always use dynamic_cast.
+template<typename T>
+T* Cast(MiObject* object) {
+    static_assert(std::is_base_of<MiObject, T>::value, "T must derive from MiObject");
+    static_assert(MiHasObjectBody<T>, "T must declare its own MI_OBJECT_BODY");
+
+    if (!object) {
+        return nullptr;
+    }
+    // isA<T>() without a second virtual call
+    const uint32_t typeIndex = object->getTypeIndex();
+    if (typeIndex == MiTypeRegistry::InvalidTypeIndex) {
+        return dynamic_cast<T*>(object);
+    }
+    const bool match = MiTypeRegistry::getInstance().isDerivedFromIndex(typeIndex, MiTypeRegistry::typeIndexOf<T>());
+    T* cast = match ? static_cast<T*>(object) : nullptr;
+#ifndef NDEBUG
+    T* rttiCast = dynamic_cast<T*>(object);
+    if (rttiCast != cast) {
+        MiTypeRegistry::reportMissingParent(object->getTypeName(), T::StaticTypeName);
+    }
+    assert(rttiCast == cast && "Cast<T>: type registered without its parent link");
+#endif
+    return cast;
+}
+
+template<typename T>
+const T* Cast(const MiObject* object) {
+    return Cast<T>(const_cast<MiObject*>(object));
+}
+
+template<typename T, typename U>
+std::shared_ptr<T> Cast(const std::shared_ptr<U>& object) {
+    // Aliasing constructor: shares ownership with object
+    T* cast = Cast<T>(static_cast<MiObject*>(object.get()));
+    return cast ? std::shared_ptr<T>(object, cast) : nullptr;
+}
+
 } // namespace MiEngine
+
+namespace std {
+
+// The words are random already, so hashing is just mixing them
+template<>
+struct hash<MiEngine::ObjectId> {
+    size_t operator()(const MiEngine::ObjectId& id) const noexcept {
+        return static_cast<size_t>(id.high ^ (id.low * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+} // namespace std
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace MiEngine {
+
+class MiActor;
+
+// ============================================================================
+// Slab Pool
+// ============================================================================
+
+// Fixed-size blocks carved from 64 KB slabs. Freed blocks go on an intrusive
+// LIFO free list and are reused in place, so churning objects of one type
+// never touches the general heap once the pool has grown to its peak. Slabs
+// are kept until exit. Thread-safe (spawns can come from parallel ticks).
+class MiSlabPool {
+public:
+    static constexpr size_t SLAB_BYTES = 64 * 1024;
+
+    struct Stats {
+        std::string name;
+        size_t blockSize = 0;
+        size_t blocksPerSlab = 0;
+        size_t slabCount = 0;
+        size_t liveCount = 0;
+        size_t peakCount = 0;
+        uint64_t allocationCount = 0;
+    };
+
+    MiSlabPool(const char* name, size_t blockSize, size_t blockAlign);
+
+    MiSlabPool(const MiSlabPool&) = delete;
+    MiSlabPool& operator=(const MiSlabPool&) = delete;
+
+    void* allocate();
+    void deallocate(void* block);
+
+    Stats getStats() const;
+
+    // Every pool created so far (debug UI)
+    static std::vector<Stats> getAllStats();
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void addSlab();
+
+    const char* m_Name;
+    size_t m_BlockSize;
+    size_t m_BlockAlign;
+    size_t m_BlocksPerSlab;
+
+    std::vector<void*> m_Slabs;
+    FreeBlock* m_FreeList = nullptr;
+    size_t m_LiveCount = 0;
+    size_t m_PeakCount = 0;
+    uint64_t m_AllocationCount = 0;
+    mutable std::mutex m_Mutex;
+};
+
+// Allocator over one MiSlabPool per (rebound type, Owner). Used through
+// std::allocate_shared, which rebinds it to its control block, so object and
+// refcounts share one pooled block.
+template<typename T, typename Owner = T>
+class MiPoolAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = MiPoolAllocator<U, Owner>;
+    };
+
+    MiPoolAllocator() noexcept = default;
+
+    template<typename U>
+    MiPoolAllocator(const MiPoolAllocator<U, Owner>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count != 1) {
+            return std::allocator<T>().allocate(count);
+        }
+        return static_cast<T*>(pool().allocate());
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (count != 1) {
+            std::allocator<T>().deallocate(pointer, count);
+            return;
+        }
+        pool().deallocate(pointer);
+    }
+
+    static MiSlabPool& pool() {
+        // Never destroyed: shared_ptrs released during static destruction still free into it
+        static MiSlabPool* instance = new MiSlabPool(Owner::StaticTypeName, sizeof(T), alignof(T));
+        return *instance;
+    }
+
+    template<typename U>
+    bool operator==(const MiPoolAllocator<U, Owner>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const MiPoolAllocator<U, Owner>&) const noexcept { return false; }
+};
+
+// make_shared from T's slab pool (T needs MI_OBJECT_BODY for the pool name)
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args&&... args) {
+    return std::allocate_shared<T>(MiPoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+// ============================================================================
+// Recycle Bin
+// ============================================================================
+
+// Destroyed actors kept alive for reuse by the next spawn of the same type.
+// Only actors with setRecyclable(true) that nothing else owns are taken;
+// their components stay attached. recycle() resets the engine state, bumps
+// the actor's generation and calls onRecycled() so the actor can reset its
+// own. Weak references can't be counted: hold a MiWeakActorPtr, which
+// expires on recycle, rather than a weak_ptr, which would lock to the
+// reused actor.
+class MiRecycleBin {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    // Keeps actor (moving it out) if it can be recycled; it must be unregistered already
+    bool recycle(std::shared_ptr<MiActor>& actor);
+
+    // Actor of exactly type T from the bin, with a new ObjectId, or nullptr
+    template<typename T>
+    std::shared_ptr<T> take();
+
+    void clear();
+
+    // Actors kept per type
+    void setCapacity(size_t capacity) { m_Capacity = capacity; }
+    size_t getCapacity() const { return m_Capacity; }
+
+    size_t getCount() const;
+    uint64_t getReuseCount() const;
+
+private:
+    std::shared_ptr<MiActor> takeByType(std::type_index type);
+
+    std::unordered_map<std::type_index, std::vector<std::shared_ptr<MiActor>>> m_Bins;
+    size_t m_Capacity = DEFAULT_CAPACITY;
+    uint64_t m_ReuseCount = 0;
+    mutable std::mutex m_Mutex;
+};
+
+template<typename T>
+std::shared_ptr<T> MiRecycleBin::take() {
+    return std::static_pointer_cast<T>(takeByType(typeid(T)));
+}
+
+} // namespace MiEngine
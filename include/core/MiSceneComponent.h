@@ -2,6 +2,7 @@
 
 #include "core/MiComponent.h"
 #include "core/MiTransform.h"
+#include "core/MiTransformSystem.h"
 #include <vector>
 #include <memory>
 
@@ -9,30 +10,33 @@ namespace MiEngine {
 
 // Component with a transform that can have parent/child relationships
 // Similar to USceneComponent in UE5
+//
+// The transform itself lives in MiTransformSystem; this class is its facade.
+// World transforms are cached there and refreshed once per frame by MiWorld.
 class MiSceneComponent : public MiComponent {
     MI_OBJECT_BODY(MiSceneComponent, 201)
 
 public:
     MiSceneComponent();
-    virtual ~MiSceneComponent() = default;
+    virtual ~MiSceneComponent();
 
     // ========================================================================
     // Local Transform (relative to parent or actor if no parent)
     // ========================================================================
 
-    const MiTransform& getLocalTransform() const { return m_LocalTransform; }
+    MiTransform getLocalTransform() const;
     void setLocalTransform(const MiTransform& transform);
 
-    glm::vec3 getLocalPosition() const { return m_LocalTransform.position; }
-    glm::quat getLocalRotation() const { return m_LocalTransform.rotation; }
-    glm::vec3 getLocalScale() const { return m_LocalTransform.scale; }
+    glm::vec3 getLocalPosition() const;
+    glm::quat getLocalRotation() const;
+    glm::vec3 getLocalScale() const;
 
     void setLocalPosition(const glm::vec3& position);
     void setLocalRotation(const glm::quat& rotation);
     void setLocalScale(const glm::vec3& scale);
 
     // Euler angles in radians
-    glm::vec3 getLocalEulerAngles() const { return m_LocalTransform.getEulerAngles(); }
+    glm::vec3 getLocalEulerAngles() const { return getLocalTransform().getEulerAngles(); }
     void setLocalEulerAngles(const glm::vec3& eulerRadians);
 
     // ========================================================================
@@ -40,7 +44,7 @@ public:
     // ========================================================================
 
     MiTransform getWorldTransform() const;
-    glm::mat4 getWorldMatrix() const;
+    glm::mat4 getWorldMatrix() const;  // Cached after MiTransformSystem::propagate()
 
     glm::vec3 getWorldPosition() const;
     glm::quat getWorldRotation() const;
@@ -121,7 +125,7 @@ protected:
     // Called when local transform changes
     virtual void onTransformChanged();
 
-    // Mark world transform as needing recalculation
+    // Schedule the world transform of this subtree for recalculation
     void markTransformDirty();
 
     // Internal: add/remove child (called by attachTo/detachFromParent)
@@ -129,15 +133,10 @@ protected:
     void removeChild(MiSceneComponent* child);
 
 private:
-    // Recalculate cached world transform
-    void updateWorldTransform() const;
+    friend class MiTransformSystem;
 
-    // Local transform (relative to parent)
-    MiTransform m_LocalTransform;
-
-    // Cached world transform
-    mutable MiTransform m_CachedWorldTransform;
-    mutable bool m_WorldTransformDirty = true;
+    // Local/world transform in MiTransformSystem (moves when slots are sorted)
+    uint32_t m_TransformSlot = MiTransformSystem::INVALID_SLOT;
 
     // Hierarchy
     MiSceneComponent* m_Parent = nullptr;
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "core/MiObject.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace MiEngine {
+
+class MiActor;
+
+// Tick groups, run in this order every frame (similar to ETickingGroup in UE5)
+enum class TickGroup : uint8_t {
+    PrePhysics = 0,     // Default: gameplay that feeds the physics step
+    DuringPhysics,      // Work that doesn't need this frame's physics results
+    PostPhysics,        // Reads simulation results
+    PostUpdate,         // Cameras, attachments, anything that needs final transforms
+    Count
+};
+
+const char* getTickGroupName(TickGroup group);
+
+// Tick schedule of one world (similar to FTickTaskManager in UE5)
+//
+// Within a group, actors are split into levels by their tick prerequisites:
+// level 0 has no prerequisites in the group, level n depends on level n - 1 at
+// most. Each level ticks its thread-safe actors with JobSystem::parallelFor,
+// then the rest in world order on the calling thread. The schedule is rebuilt
+// lazily after actors are registered/unregistered or change tick settings.
+class MiTickScheduler {
+public:
+    // Actors per parallelFor chunk
+    static constexpr size_t PARALLEL_GRAIN = 64;
+
+    struct GroupStats {
+        uint32_t actorCount = 0;
+        uint32_t parallelCount = 0;
+        uint32_t levelCount = 0;
+    };
+
+    void markDirty() { m_Dirty.store(true, std::memory_order_relaxed); }
+    bool isDirty() const { return m_Dirty.load(std::memory_order_relaxed); }
+
+    // Rebuild the levels from the world's actor list (world order is kept within a level)
+    void rebuild(const std::vector<std::shared_ptr<MiActor>>& actors);
+
+    // Tick every actor of group that has begun play and isn't pending destroy
+    void tickGroup(TickGroup group, float deltaTime);
+
+    // True while thread-safe actors are ticking on workers; spawn/destroy are deferred then
+    bool isTickingParallel() const { return m_TickingParallel.load(std::memory_order_acquire); }
+
+    GroupStats getGroupStats(TickGroup group) const;
+
+private:
+    struct TickLevel {
+        std::vector<MiActor*> parallel;
+        std::vector<MiActor*> serial;
+    };
+
+    // Level of actor within its group; resolves prerequisites depth first
+    uint32_t resolveLevel(MiActor* actor, std::unordered_map<MiActor*, uint32_t>& levels);
+
+    std::array<std::vector<TickLevel>, static_cast<size_t>(TickGroup::Count)> m_Groups;
+    std::atomic<bool> m_Dirty{ true };
+    std::atomic<bool> m_TickingParallel{ false };
+
+    // Cycles already warned about (sorted member ids), so each is logged once
+    // rather than on every rebuild, whichever actor the search enters it from
+    std::set<std::vector<ObjectId>> m_ReportedCycles;
+};
+
+} // namespace MiEngine
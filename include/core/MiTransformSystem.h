@@ -0,0 +1,175 @@
+#pragma once
+
+#include "core/MiTransform.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MiEngine {
+
+class MiSceneComponent;
+
+// Transform hierarchy of every MiSceneComponent, stored data-oriented
+//
+// Local and world TRS live in structure-of-arrays pages (one float array per
+// channel) next to a cached world matrix. Slots are grouped into levels, each
+// starting on a multiple of 4, and every parent is in an earlier level than its
+// children. propagate() then recomputes the world transforms of dirty subtrees
+// in one pass per frame: level by level, four transforms per SSE step, large
+// levels split across the JobSystem.
+//
+// Structure changes are incremental. New slots take a free slot of the lowest
+// level (roots may live in any level), released slots become free in place,
+// and a slot attached to a parent that isn't in an earlier level moves with
+// its subtree to a deeper level in the next propagate(). Only when levels or
+// free slots have grown well past the hierarchy are all slots re-sorted by
+// depth and compacted.
+//
+// Setters only flag their own slot. Reads before the pass compose through the
+// dirty part of the parent chain, so they always see the current hierarchy.
+// Slots can be allocated, written and read from any thread (thread-safe actor
+// ticks); propagate() runs on the main thread while no tick is in flight.
+class MiTransformSystem {
+public:
+    static constexpr uint32_t INVALID_SLOT = ~0u;
+    static constexpr uint32_t PAGE_SIZE = 1024;             // Transforms per page (multiple of 4)
+    static constexpr uint32_t MAX_PAGES = 4096;             // Page table is fixed so pages never move
+    static constexpr uint32_t PARALLEL_MIN_SLOTS = 4096;    // Smaller levels propagate on the calling thread
+    static constexpr uint32_t PARALLEL_GRAIN = 512;         // Slots per parallelFor chunk (multiple of 4)
+
+    struct Stats {
+        uint32_t transformCount = 0;    // Live transforms
+        uint32_t slotCount = 0;         // Including free slots and level padding
+        uint32_t levelCount = 0;        // Levels propagate() walks (deepest hierarchy + 1 after a full sort)
+        uint32_t updatedCount = 0;      // World transforms recomputed by the last propagate()
+        uint32_t movedCount = 0;        // Slots moved to a deeper level by the last propagate()
+        uint32_t fullSortCount = 0;     // Full depth sorts so far
+    };
+
+    static MiTransformSystem& getInstance();
+
+    MiTransformSystem(const MiTransformSystem&) = delete;
+    MiTransformSystem& operator=(const MiTransformSystem&) = delete;
+
+    // ========================================================================
+    // Slots (one per MiSceneComponent)
+    // ========================================================================
+
+    // New identity transform owned by owner; its slot may move in propagate()
+    uint32_t allocate(MiSceneComponent* owner);
+    void release(uint32_t slot);    // The slot must have no children left
+
+    // INVALID_SLOT detaches. Under a parent that isn't in an earlier level,
+    // slot and its subtree move deeper in the next propagate().
+    void setParent(uint32_t slot, uint32_t parentSlot);
+    uint32_t getParent(uint32_t slot) const;
+
+    // ========================================================================
+    // Local Transform (call markDirty after writing)
+    // ========================================================================
+
+    MiTransform getLocalTransform(uint32_t slot) const;
+    glm::vec3 getLocalPosition(uint32_t slot) const;
+    glm::quat getLocalRotation(uint32_t slot) const;
+    glm::vec3 getLocalScale(uint32_t slot) const;
+
+    void setLocalTransform(uint32_t slot, const MiTransform& transform);
+    void setLocalPosition(uint32_t slot, const glm::vec3& position);
+    void setLocalRotation(uint32_t slot, const glm::quat& rotation);
+    void setLocalScale(uint32_t slot, const glm::vec3& scale);
+
+    // Schedule slot and its subtree for the next propagate()
+    void markDirty(uint32_t slot);
+
+    // ========================================================================
+    // World Transform
+    // ========================================================================
+
+    MiTransform getWorldTransform(uint32_t slot) const;
+    glm::mat4 getWorldMatrix(uint32_t slot) const;
+
+    // Move reparented subtrees (or re-sort), then update every dirty subtree
+    void propagate();
+    bool hasPendingChanges() const { return m_AnyDirty.load(std::memory_order_relaxed); }
+
+    // Off: every level propagates on the calling thread
+    void setParallelPropagation(bool enabled) { m_ParallelPropagation = enabled; }
+
+    Stats getStats() const;
+
+private:
+    MiTransformSystem() = default;
+
+    // TRS channels of a transform, one float array each
+    enum Channel : uint32_t {
+        POS_X, POS_Y, POS_Z,
+        ROT_X, ROT_Y, ROT_Z, ROT_W,
+        SCALE_X, SCALE_Y, SCALE_Z,
+        CHANNEL_COUNT
+    };
+
+    struct Page {
+        float local[CHANNEL_COUNT][PAGE_SIZE];
+        float world[CHANNEL_COUNT][PAGE_SIZE];
+        glm::mat4 worldMatrix[PAGE_SIZE];
+        uint32_t parent[PAGE_SIZE];
+        uint32_t firstChild[PAGE_SIZE];     // Children as a doubly linked list, so a
+        uint32_t nextSibling[PAGE_SIZE];    // moved subtree can be found and relinked
+        uint32_t prevSibling[PAGE_SIZE];    // without a scan
+        MiSceneComponent* owner[PAGE_SIZE];
+        uint8_t dirty[PAGE_SIZE];
+    };
+
+    Page& pageOf(uint32_t slot) const { return *m_Pages[slot / PAGE_SIZE]; }
+
+    // Level whose range holds slot
+    uint32_t levelOf(uint32_t slot) const;
+
+    // A free slot in the lowest level >= minLevel, growing the last level or
+    // adding one if none has room (m_Mutex held)
+    uint32_t takeSlot(uint32_t minLevel);
+    void appendSlot();
+    void addLevel();
+
+    // Child list maintenance (m_Mutex held)
+    void linkChild(uint32_t parent, uint32_t slot);
+    void unlinkChild(uint32_t slot);
+
+    // Moves the slots in m_PendingMoves whose parent isn't in an earlier level,
+    // and then their children, to the first level after their parent
+    void moveReparented();
+    void moveSlot(uint32_t from, uint32_t to);
+
+    // True once the levels or free slots have drifted far enough from the
+    // hierarchy that a full sort pays for itself
+    bool needsFullSort() const;
+
+    // World of slot composed from the cached world above top (its topmost dirty ancestor)
+    MiTransform composeWorld(uint32_t slot, uint32_t top) const;
+
+    // Reorder slots by depth (stable), with spare room in each level, padded to a multiple of 4
+    void sortByDepth();
+    void rebuildChildLists();
+
+    // World transforms of [begin, end), one depth level; returns how many were recomputed
+    uint32_t propagateRange(uint32_t begin, uint32_t end);
+
+    std::array<std::unique_ptr<Page>, MAX_PAGES> m_Pages;
+    std::vector<std::vector<uint32_t>> m_FreeSlots;     // Per level
+    std::vector<uint32_t> m_LevelStart;     // Slot range of each level, plus the end (== m_SlotCount)
+    std::vector<uint32_t> m_PendingMoves;   // Slots attached under a parent that wasn't in an earlier level
+    uint32_t m_SlotCount = 0;
+    uint32_t m_LiveCount = 0;
+    uint32_t m_SortedLevelCount = 0;        // Levels after the last full sort
+    uint32_t m_LastUpdatedCount = 0;
+    uint32_t m_LastMovedCount = 0;
+    uint32_t m_FullSortCount = 0;
+    bool m_ParallelPropagation = true;
+    std::atomic<bool> m_AnyDirty{ false };
+    mutable std::mutex m_Mutex;             // Slot allocation and parent links
+};
+
+} // namespace MiEngine
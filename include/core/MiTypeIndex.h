@@ -0,0 +1,118 @@
+#pragma once
+
+#include "core/MiObject.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace MiEngine {
+
+// Objects of one queried type T, including every type derived from it
+class MiTypeIndexBase {
+public:
+    virtual ~MiTypeIndexBase() = default;
+
+    // True if object is a T (checked once per concrete type id)
+    virtual bool matches(MiObject* object) const = 0;
+
+    virtual void add(MiObject* object) = 0;
+    virtual void remove(MiObject* object) = 0;
+};
+
+template<typename T>
+class MiTypeIndex : public MiTypeIndexBase {
+public:
+    bool matches(MiObject* object) const override {
+        return Cast<T>(object) != nullptr;
+    }
+
+    void add(MiObject* object) override {
+        m_Positions[object] = static_cast<uint32_t>(m_Items.size());
+        m_Items.push_back(static_cast<T*>(object));
+    }
+
+    // Swap-remove: order is insertion order until the first removal
+    void remove(MiObject* object) override {
+        auto it = m_Positions.find(object);
+        if (it == m_Positions.end()) {
+            return;
+        }
+        uint32_t position = it->second;
+        m_Positions.erase(it);
+        if (position + 1 != m_Items.size()) {
+            T* moved = m_Items.back();
+            m_Items[position] = moved;
+            m_Positions[moved] = position;
+        }
+        m_Items.pop_back();
+    }
+
+    std::span<T* const> items() const { return m_Items; }
+
+private:
+    std::vector<T*> m_Items;
+    std::unordered_map<const MiObject*, uint32_t> m_Positions;
+};
+
+// Per-type indices over a set of objects (a world's actors or its components)
+//
+// An index for T is created by the first query for T, filled from the objects
+// already added, then kept up to date by add/remove. Which indices an object
+// belongs to is worked out once per concrete type id (its T and every
+// ancestor that has been queried) and cached, so add/remove cost one hash
+// lookup plus one push/swap per index. Queries return non-owning spans and
+// don't allocate once the index exists.
+//
+// Indices are keyed by the queried StaticTypeId and memberships by the
+// object's type id; matching is Cast<T>, an ancestor bit test for registered
+// types. MiTypeRegistry rejects reused ids, so an id names one class.
+class MiTypeIndexSet {
+public:
+    void add(MiObject* object);
+    void remove(MiObject* object);
+    void clear();
+
+    // Valid until the next add/remove
+    template<typename T>
+    std::span<T* const> get();
+
+    size_t size() const { return m_Objects.size(); }
+
+private:
+    const std::vector<MiTypeIndexBase*>& indicesOf(MiObject* object);
+
+    std::unordered_map<uint32_t, std::unique_ptr<MiTypeIndexBase>> m_Indices;      // By queried type id
+    std::unordered_map<uint32_t, std::vector<MiTypeIndexBase*>> m_Membership;     // By concrete type id
+    std::vector<MiObject*> m_Objects;
+    std::unordered_map<const MiObject*, uint32_t> m_ObjectPositions;
+    std::mutex m_Mutex;    // Queries may come from parallel ticks
+};
+
+template<typename T>
+std::span<T* const> MiTypeIndexSet::get() {
+    static_assert(std::is_base_of<MiObject, T>::value, "T must derive from MiObject");
+    static_assert(MiHasObjectBody<T>, "T must declare its own MI_OBJECT_BODY");
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Indices.find(T::StaticTypeId);
+    if (it == m_Indices.end()) {
+        auto index = std::make_unique<MiTypeIndex<T>>();
+        for (MiObject* object : m_Objects) {
+            if (index->matches(object)) {
+                index->add(object);
+            }
+        }
+        it = m_Indices.emplace(T::StaticTypeId, std::move(index)).first;
+
+        // Concrete types seen so far may belong to the new index too
+        m_Membership.clear();
+    }
+    return static_cast<MiTypeIndex<T>&>(*it->second).items();
+}
+
+} // namespace MiEngine
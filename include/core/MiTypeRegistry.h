@@ -1,9 +1,12 @@
 #pragma once
 
+#include "core/MiObjectPool.h"
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace MiEngine {
@@ -13,17 +16,31 @@ class MiObject;
 // Factory function type for creating objects
 using ObjectFactory = std::function<std::shared_ptr<MiObject>()>;
 
+// True if T declares its own MI_OBJECT_BODY instead of inheriting its base's
+// (&T::getTypeId names the class that last declared it)
+template<typename T>
+constexpr bool MiHasObjectBody = std::is_same<decltype(&T::getTypeId), uint32_t (T::*)() const>::value;
+
 // Type metadata
 struct TypeInfo {
     std::string typeName;
     uint32_t typeId;
     ObjectFactory factory;
     uint32_t parentTypeId;  // 0 if no parent
+    uint32_t typeIndex;     // Dense, in registration order
 };
 
 // Runtime type registry - singleton for creating objects by type name
+//
+// Every registered type gets a dense index and a bitset of its ancestors
+// (itself included), rebuilt on each registration, so hierarchy queries are a
+// bit test. Only parents given to registerTypeWithParent are known: a type
+// registered without one only matches itself. Register types during static
+// initialization (MI_REGISTER_TYPE*); queries are then safe from any thread.
 class MiTypeRegistry {
 public:
+    static constexpr uint32_t InvalidTypeIndex = ~0u;
+
     // Get singleton instance
     static MiTypeRegistry& getInstance();
 
@@ -58,6 +75,27 @@ public:
     // Check if type A is derived from type B
     bool isDerivedFrom(uint32_t typeId, uint32_t parentTypeId) const;
 
+    // Same, by dense index: one bit test (false for InvalidTypeIndex)
+    bool isDerivedFromIndex(uint32_t typeIndex, uint32_t parentTypeIndex) const {
+        if (typeIndex >= m_TypesByIndex.size() || parentTypeIndex >= m_TypesByIndex.size()) {
+            return false;
+        }
+        uint64_t word = m_Ancestors[typeIndex * m_AncestorWords + parentTypeIndex / 64];
+        return (word >> (parentTypeIndex % 64)) & 1;
+    }
+
+    // Dense index of a registered type, or InvalidTypeIndex
+    uint32_t getTypeIndex(uint32_t typeId) const;
+
+    // getTypeIndex(T::StaticTypeId), cached once T is registered
+    template<typename T>
+    static uint32_t typeIndexOf();
+
+    size_t getTypeCount() const { return m_TypesByIndex.size(); }
+
+    // Cast found objectType deriving from castType without a registered link (logged once per pair)
+    static void reportMissingParent(const char* objectType, const char* castType);
+
 private:
     MiTypeRegistry() = default;
     ~MiTypeRegistry() = default;
@@ -66,37 +104,62 @@ private:
     MiTypeRegistry(const MiTypeRegistry&) = delete;
     MiTypeRegistry& operator=(const MiTypeRegistry&) = delete;
 
+    void addType(TypeInfo info);
+    void rebuildAncestors();
+
     std::unordered_map<std::string, TypeInfo> m_TypesByName;
     std::unordered_map<uint32_t, TypeInfo*> m_TypesById;
+    std::vector<TypeInfo*> m_TypesByIndex;
+
+    // m_AncestorWords words per type index; bit p of type t set if t derives from p
+    std::vector<uint64_t> m_Ancestors;
+    size_t m_AncestorWords = 0;
 };
 
 // Template implementation
 template<typename T>
 void MiTypeRegistry::registerType() {
+    static_assert(MiHasObjectBody<T>, "T must declare its own MI_OBJECT_BODY");
+
     TypeInfo info;
     info.typeName = T::StaticTypeName;
     info.typeId = T::StaticTypeId;
     info.factory = []() -> std::shared_ptr<MiObject> {
-        return std::make_shared<T>();
+        return makePooled<T>();
     };
     info.parentTypeId = 0;
 
-    m_TypesByName[info.typeName] = info;
-    m_TypesById[info.typeId] = &m_TypesByName[info.typeName];
+    addType(std::move(info));
 }
 
 template<typename T, typename TParent>
 void MiTypeRegistry::registerTypeWithParent() {
+    static_assert(MiHasObjectBody<T>, "T must declare its own MI_OBJECT_BODY");
+    // Cast<T> static_casts on the strength of this link
+    static_assert(std::is_base_of<TParent, T>::value && !std::is_same<TParent, T>::value,
+                  "TParent must be a base class of T");
+
     TypeInfo info;
     info.typeName = T::StaticTypeName;
     info.typeId = T::StaticTypeId;
     info.factory = []() -> std::shared_ptr<MiObject> {
-        return std::make_shared<T>();
+        return makePooled<T>();
     };
     info.parentTypeId = TParent::StaticTypeId;
 
-    m_TypesByName[info.typeName] = info;
-    m_TypesById[info.typeId] = &m_TypesByName[info.typeName];
+    addType(std::move(info));
+}
+
+template<typename T>
+uint32_t MiTypeRegistry::typeIndexOf() {
+    // Indices never change once assigned; unregistered types are looked up each time
+    static std::atomic<uint32_t> s_Index{InvalidTypeIndex};
+    uint32_t index = s_Index.load(std::memory_order_relaxed);
+    if (index == InvalidTypeIndex) {
+        index = getInstance().getTypeIndex(T::StaticTypeId);
+        s_Index.store(index, std::memory_order_relaxed);
+    }
+    return index;
 }
 
 // Helper macro for automatic type registration
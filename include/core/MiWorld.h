@@ -1,9 +1,15 @@
 #pragma once
 
 #include "core/MiObject.h"
+#include "core/MiEventBus.h"
+#include "core/MiName.h"
+#include "core/MiObjectPool.h"
+#include "core/MiTickScheduler.h"
+#include "core/MiTypeIndex.h"
 #include <vulkan/vulkan.h>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <unordered_map>
 #include <string>
@@ -16,6 +22,7 @@ namespace MiEngine {
 
 // Forward declarations
 class MiActor;
+class MiComponent;
 class PhysicsWorld;
 class JsonWriter;
 class JsonReader;
@@ -43,6 +50,18 @@ struct WorldSettings {
     void deserialize(const JsonReader& reader);
 };
 
+// Posted to the world's event bus when an actor is registered/unregistered.
+// Delivered at the next dispatch, by which time a destroyed actor is gone.
+struct ActorSpawnedEvent {
+    ObjectId actorId;
+    uint32_t typeId = 0;
+};
+
+struct ActorDestroyedEvent {
+    ObjectId actorId;
+    uint32_t typeId = 0;
+};
+
 // Main world class containing all actors (similar to UWorld in UE5)
 class MiWorld : public MiObject {
     MI_OBJECT_BODY(MiWorld, 50)
@@ -71,13 +90,20 @@ public:
     // Spawn an actor by type name (for serialization)
     std::shared_ptr<MiActor> spawnActorByTypeName(const std::string& typeName);
 
-    // Destroy an actor (deferred until end of frame)
+    // Destroy an actor (deferred until end of frame). Safe to call from
+    // thread-safe actor ticks; the actor's flags are set once the tick is done.
     void destroyActor(std::shared_ptr<MiActor> actor);
     void destroyActor(const ObjectId& id);
 
     // Destroy all actors
     void destroyAllActors();
 
+    // Recyclable actors (MiActor::setRecyclable) kept on destroy for reuse by
+    // spawnActor<T>() with no constructor arguments. A reused actor keeps its
+    // components, so createDefaultComponents() and onCreated() only run for
+    // new actors; onRecycled() is the reset hook.
+    MiRecycleBin& getRecycleBin() { return m_RecycleBin; }
+
     // ========================================================================
     // Actor Queries
     // ========================================================================
@@ -88,16 +114,27 @@ public:
     // Find actor by name (returns first match)
     std::shared_ptr<MiActor> findActorByName(const std::string& name) const;
 
-    // Find all actors with a specific tag
-    std::vector<std::shared_ptr<MiActor>> findActorsByTag(const std::string& tag) const;
+    // Find all actors with a specific tag (MiName::find the text to avoid interning it)
+    std::vector<std::shared_ptr<MiActor>> findActorsByTag(MiName tag) const;
 
     // Find all actors on a specific layer
     std::vector<std::shared_ptr<MiActor>> findActorsByLayer(uint32_t layer) const;
 
-    // Find all actors of type T
+    // Find all actors of type T (copies getActorsOfType into shared_ptrs)
     template<typename T>
     std::vector<std::shared_ptr<T>> findActorsOfType() const;
 
+    // Actors of type T or derived from it, from a per-type index (no cast or
+    // allocation after the first query). Valid until an actor is registered
+    // or unregistered; T needs its own MI_OBJECT_BODY.
+    template<typename T>
+    std::span<T* const> getActorsOfType() const;
+
+    // Components of type T or derived from it on this world's actors. Valid
+    // until an actor is (un)registered or a component added/removed.
+    template<typename T>
+    std::span<T* const> getComponentsOfType() const;
+
     // Get all actors
     const std::vector<std::shared_ptr<MiActor>>& getAllActors() const { return m_Actors; }
 
@@ -121,9 +158,20 @@ public:
     // Stop simulation
     void endPlay();
 
-    // Update world (call every frame)
+    // Update world (call every frame): ticks each TickGroup in order. Spawns
+    // during the tick, including from worker threads, register afterwards.
+    // World transforms are propagated before PostUpdate and at the end;
+    // queued events are dispatched after PostPhysics and at the end.
     void tick(float deltaTime);
 
+    // Tick groups, prerequisite levels and parallel ticking
+    MiTickScheduler& getTickScheduler() { return m_TickScheduler; }
+    const MiTickScheduler& getTickScheduler() const { return m_TickScheduler; }
+
+    // Deferred events, dispatched after PostPhysics and at the end of tick()
+    MiEventBus& getEventBus() { return m_EventBus; }
+    const MiEventBus& getEventBus() const { return m_EventBus; }
+
     // Check if world is playing
     bool isPlaying() const { return m_IsPlaying; }
 
@@ -211,8 +259,15 @@ private:
     void registerActor(std::shared_ptr<MiActor> actor);
     void unregisterActor(std::shared_ptr<MiActor> actor);
 
+    // Keep the component index in sync with components added to/removed from
+    // registered actors (called by MiActor)
+    friend class MiActor;
+    void indexComponent(MiComponent* component);
+    void unindexComponent(MiComponent* component);
+    void renameActor(const std::string& oldName, const std::string& newName);
+
     // Generate unique actor name
-    std::string generateUniqueActorName(const std::string& baseName) const;
+    std::string generateUniqueActorName(const std::string& baseName);
 
     VulkanRenderer* m_Renderer = nullptr;
     // std::unique_ptr<PhysicsWorld> m_PhysicsWorld;
@@ -221,6 +276,16 @@ private:
     std::unordered_map<ObjectId, std::shared_ptr<MiActor>> m_ActorMap;
     std::vector<std::shared_ptr<MiActor>> m_DestroyQueue;
     std::vector<std::shared_ptr<MiActor>> m_SpawnQueue;
+    std::mutex m_QueueMutex;    // Spawn/destroy queues and actor names, used from workers during parallel ticks
+    std::unordered_map<std::string, uint32_t> m_NameCounters;  // Next actor name suffix per base name
+    std::unordered_map<std::string, uint32_t> m_ActorNameCounts;  // Registered actors per name
+    MiRecycleBin m_RecycleBin;  // Destroyed recyclable actors awaiting reuse
+    MiEventBus m_EventBus;
+    MiTickScheduler m_TickScheduler;
+
+    // Per-type queries; the indices of a type are built by its first query
+    mutable MiTypeIndexSet m_ActorIndex;
+    mutable MiTypeIndexSet m_ComponentIndex;
 
     WorldSettings m_Settings;
     std::vector<MiLight> m_Lights;
@@ -237,18 +302,31 @@ template<typename T, typename... Args>
 std::shared_ptr<T> MiWorld::spawnActor(Args&&... args) {
     static_assert(std::is_base_of<MiActor, T>::value, "T must derive from MiActor");
 
-    auto actor = std::make_shared<T>(std::forward<Args>(args)...);
+    // Reuse a recycled actor of this exact type when constructed with defaults
+    std::shared_ptr<T> actor;
+    if constexpr (sizeof...(Args) == 0) {
+        actor = m_RecycleBin.take<T>();
+    }
 
-    // Generate unique name if it's the default
-    if (actor->getName() == "Actor" || actor->getName().empty()) {
+    // A recycled actor still has its components and was reset by onRecycled()
+    const bool recycled = actor != nullptr;
+    if (recycled) {
         actor->setName(generateUniqueActorName(T::StaticTypeName));
-    }
+    } else {
+        actor = makePooled<T>(std::forward<Args>(args)...);
+
+        // Generate unique name if it's the default
+        if (actor->getName() == "Actor" || actor->getName().empty()) {
+            actor->setName(generateUniqueActorName(T::StaticTypeName));
+        }
 
-    // Create default components
-    actor->createDefaultComponents();
+        // Create default components
+        actor->createDefaultComponents();
+    }
 
     if (m_IsUpdating) {
-        // Defer registration until after update
+        // Defer registration until after update (may be a worker thread)
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
         m_SpawnQueue.push_back(actor);
     } else {
         registerActor(actor);
@@ -259,8 +337,14 @@ std::shared_ptr<T> MiWorld::spawnActor(Args&&... args) {
         }
     }
 
-    actor->onCreated();
-    markDirty();
+    if (!recycled) {
+        actor->onCreated();
+    }
+
+    // Deferred spawns mark the world dirty when they register
+    if (!m_IsUpdating) {
+        markDirty();
+    }
 
     return actor;
 }
@@ -269,13 +353,25 @@ template<typename T>
 std::vector<std::shared_ptr<T>> MiWorld::findActorsOfType() const {
     static_assert(std::is_base_of<MiActor, T>::value, "T must derive from MiActor");
 
+    std::span<T* const> actors = getActorsOfType<T>();
     std::vector<std::shared_ptr<T>> result;
-    for (const auto& actor : m_Actors) {
-        if (auto cast = std::dynamic_pointer_cast<T>(actor)) {
-            result.push_back(cast);
-        }
+    result.reserve(actors.size());
+    for (T* actor : actors) {
+        result.push_back(std::static_pointer_cast<T>(actor->shared_from_this()));
     }
     return result;
 }
 
+template<typename T>
+std::span<T* const> MiWorld::getActorsOfType() const {
+    static_assert(std::is_base_of<MiActor, T>::value, "T must derive from MiActor");
+    return m_ActorIndex.get<T>();
+}
+
+template<typename T>
+std::span<T* const> MiWorld::getComponentsOfType() const {
+    static_assert(std::is_base_of<MiComponent, T>::value, "T must derive from MiComponent");
+    return m_ComponentIndex.get<T>();
+}
+
 } // namespace MiEngine
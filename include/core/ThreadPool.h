@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/JobSystem.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace MiEngine {
+
+/**
+ * ThreadPool is the future-returning front end of the JobSystem for CPU-bound
+ * engine work (asset validation, decoding, importing). It owns no threads:
+ * submitted tasks run as JobAffinity::Background jobs, so a long decode never
+ * stalls a main-thread wait, and parallelFor() is the JobSystem's.
+ *
+ * parallelFor() is safe to call from inside a pool task: the calling thread
+ * processes chunks itself and runs queued jobs while it waits.
+ */
+class ThreadPool {
+public:
+    // Shared engine pool on JobSystem::getInstance()
+    static ThreadPool& getInstance();
+
+    explicit ThreadPool(JobSystem& jobs);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a task, returns a future for its result
+    template<typename F>
+    auto submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+    // Run func(i) for i in [0, count). Blocks until all iterations finish;
+    // the calling thread participates. grainSize = iterations per claimed chunk.
+    void parallelFor(size_t count, const std::function<void(size_t)>& func, size_t grainSize = 1);
+
+    uint32_t getThreadCount() const { return m_Jobs.getWorkerCount(); }
+
+private:
+    void enqueue(std::function<void()> task);
+
+    JobSystem& m_Jobs;
+};
+
+// Template implementation
+template<typename F>
+auto ThreadPool::submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+    std::future<Result> future = task->get_future();
+    enqueue([task]() { (*task)(); });
+    return future;
+}
+
+} // namespace MiEngine
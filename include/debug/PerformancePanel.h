@@ -23,4 +23,6 @@ private:
     void drawFrameTimeGraph();
     void drawStatistics();
     void drawRenderStats();
+    void drawPoolStats();
+    void drawEventStats();
 };
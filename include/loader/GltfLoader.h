@@ -0,0 +1,51 @@
+#pragma once
+
+#include "loader/MeshData.h"
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MiEngine {
+
+/**
+ * GltfLoader imports glTF 2.0 models (.glb and .gltf) without the FBX SDK.
+ *
+ * The .glb file (or the .gltf and its external .bin buffers) is memory mapped
+ * and accessors are decoded straight from the mapped bytes into the final
+ * MeshData / SkeletalMeshData vertex arrays. Primitives are decoded in parallel
+ * on the shared ThreadPool; the JSON document and node hierarchy are resolved
+ * up front on the calling thread.
+ *
+ * Output conventions match the FBX path so the results can go straight into
+ * MeshCache:
+ *   - one mesh per (node, primitive), triangle winding reversed
+ *   - static meshes have node world transforms baked in
+ *   - skinned meshes stay in bind space; all skins share one Skeleton
+ *   - animation channels become local TRS tracks
+ *
+ * Supported: triangle primitives, float / normalized integer attributes,
+ * uint8/16/32 indices, buffers embedded in the GLB, in data: URIs or in
+ * external files. Not supported: sparse accessors, morph targets, Draco/meshopt
+ * compression.
+ */
+class GltfLoader {
+public:
+    // True for .gltf / .glb extensions
+    static bool isGltfFile(const fs::path& path);
+
+    // Load all static meshes (node transforms applied)
+    static bool load(const fs::path& path, std::vector<MeshData>& outMeshes);
+
+    // Load meshes, skeleton (from all skins) and animations
+    static bool loadSkeletal(const fs::path& path, SkeletalModelData& outData);
+
+    // Quick check for a skin without decoding any geometry
+    static bool hasSkin(const fs::path& path);
+
+    // Files referenced by relative URI (buffers, images), resolved against the
+    // model's directory. Empty for .glb files with an embedded buffer.
+    static std::vector<fs::path> getExternalDependencies(const fs::path& path);
+};
+
+} // namespace MiEngine
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "Utils/CommonVertex.h"
+#include "Utils/SkeletalVertex.h"
+
+// Plain mesh containers shared by all importers (FBX, glTF) and the mesh cache.
+// Kept free of any SDK headers so cache/glTF code builds without the FBX SDK.
+
+// Forward declarations
+namespace MiEngine {
+    class Skeleton;
+    class AnimationClip;
+}
+
+// Structure to hold a mesh's data (static mesh)
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+// Structure to hold skeletal mesh data
+struct SkeletalMeshData {
+    std::vector<MiEngine::SkeletalVertex> vertices;
+    std::vector<unsigned int> indices;
+    std::string name;
+};
+
+// Complete skeletal model data (FBX or glTF)
+struct SkeletalModelData {
+    std::vector<SkeletalMeshData> meshes;
+    std::shared_ptr<MiEngine::Skeleton> skeleton;
+    std::vector<std::shared_ptr<MiEngine::AnimationClip>> animations;
+    bool hasSkeleton = false;
+};
@@ -4,39 +4,14 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#ifndef MIENGINE_NO_FBX
 #include <fbxsdk.h>
+#endif
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
-#include "Utils/CommonVertex.h"
-#include "Utils/SkeletalVertex.h"
-
-// Forward declarations
-namespace MiEngine {
-    class Skeleton;
-    class AnimationClip;
-}
-
-// Structure to hold a mesh's data (static mesh)
-struct MeshData {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-};
-
-// Structure to hold skeletal mesh data
-struct SkeletalMeshData {
-    std::vector<MiEngine::SkeletalVertex> vertices;
-    std::vector<unsigned int> indices;
-    std::string name;
-};
-
-// Complete skeletal model data from FBX
-struct SkeletalModelData {
-    std::vector<SkeletalMeshData> meshes;
-    std::shared_ptr<MiEngine::Skeleton> skeleton;
-    std::vector<std::shared_ptr<MiEngine::AnimationClip>> animations;
-    bool hasSkeleton = false;
-};
+#include "loader/MeshData.h"
 
 class ModelLoader {
 public:
@@ -44,10 +19,11 @@ public:
     ModelLoader();
     ~ModelLoader();
 
-    // Loads an FBX file and populates internal mesh data (static meshes)
+    // Loads an FBX or glTF (.gltf/.glb) file and populates internal mesh data (static meshes).
+    // glTF is handled by MiEngine::GltfLoader and works without the FBX SDK.
     bool LoadModel(const std::string& filename);
 
-    // Loads an FBX file with skeletal animation data
+    // Loads an FBX or glTF file with skeletal animation data
     bool LoadSkeletalModel(const std::string& filename, SkeletalModelData& outData);
 
     // Returns the loaded meshes (static)
@@ -59,10 +35,18 @@ public:
     MeshData CreateCube(float size);
 
     // Calculate tangents for a mesh
-    void CalculateTangents(MeshData& meshData);
-    void CalculateTangents(SkeletalMeshData& meshData);
+    static void CalculateTangents(MeshData& meshData);
+    static void CalculateTangents(SkeletalMeshData& meshData);
+
+    // The FBX SDK is not thread-safe. Code that may run alongside other loads
+    // (worker decodes, background reimports) holds this for the loader's lifetime.
+    static std::mutex& GetFbxMutex();
 
 private:
+#ifndef MIENGINE_NO_FBX
+    // Create the FBX manager/scene on first FBX load so primitive and glTF use stays cheap
+    bool EnsureFbxManager();
+
     // Recursively process each node in the FBX scene (static mesh)
     void ProcessNode(FbxNode* node, int indentLevel);
 
@@ -70,6 +54,7 @@ private:
     void ProcessMesh(FbxMesh* mesh, const FbxAMatrix& transform);
 
     // Skeletal mesh processing
+    bool LoadFbxSkeletalModel(const std::string& filename, SkeletalModelData& outData);
     void ProcessSkeletalNode(FbxNode* node, SkeletalModelData& outData);
     void ProcessSkeletalMesh(FbxMesh* mesh, const FbxAMatrix& transform, SkeletalModelData& outData);
 
@@ -85,16 +70,19 @@ private:
     void ExtractAnimations(FbxScene* scene, SkeletalModelData& outData);
     void ExtractAnimationStack(FbxAnimStack* animStack, FbxScene* scene,
                                SkeletalModelData& outData);
+#endif
 
-    // Storage for the meshes loaded from the FBX file
+    // Storage for the meshes loaded from the model file
     std::vector<MeshData> meshes;
 
-    // FBX SDK objects for managing the scene
-    FbxManager* fbxManager;
-    FbxScene* fbxScene;
+#ifndef MIENGINE_NO_FBX
+    // FBX SDK objects for managing the scene (created on first FBX load)
+    FbxManager* fbxManager = nullptr;
+    FbxScene* fbxScene = nullptr;
 
     // Temporary storage during skeletal loading
     std::unordered_map<std::string, uint32_t> m_boneNameToIndex;
     std::unordered_map<std::string, std::pair<FbxAMatrix, FbxAMatrix>> m_boneClusterData;
     float m_skeletalUnitScale = 1.0f;  // Unit conversion factor for skeletal meshes
+#endif
 };
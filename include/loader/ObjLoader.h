@@ -0,0 +1,49 @@
+#pragma once
+
+#include "loader/MeshData.h"
+#include <filesystem>
+#include <vector>
+#include <cstdint>
+
+namespace fs = std::filesystem;
+
+namespace MiEngine {
+
+/**
+ * ObjLoader imports Wavefront OBJ files as static meshes without the FBX SDK.
+ *
+ * The file is memory mapped and split into newline-aligned chunks that are
+ * parsed in parallel on the ThreadPool (numbers via std::from_chars). A quick
+ * counting pass first gives every chunk its global v/vt/vn base, so absolute
+ * and relative (negative) face indices are resolved while parsing. Faces are
+ * fan-triangulated and identical v/vt/vn corners are welded into indexed
+ * MeshData, sharded by position index for large meshes.
+ *
+ * Output follows the FBX import conventions (V flipped, winding reversed,
+ * tangents generated) so MeshCache output is interchangeable.
+ * One MeshData is produced per `o` / `g` group that contains faces.
+ * Supported: v (with optional per-vertex RGB), vt, vn, f, o, g.
+ * Ignored: materials, smoothing groups, lines, points, free-form geometry.
+ */
+class ObjLoader {
+public:
+    struct Stats {
+        uint64_t fileBytes = 0;
+        uint32_t chunkCount = 0;
+        uint64_t positionCount = 0;
+        uint64_t triangleCount = 0;
+        uint64_t vertexCount = 0;     // After welding
+        double parseMs = 0.0;         // Count + parse passes
+        double weldMs = 0.0;          // Welding, index generation
+        double finalizeMs = 0.0;      // Normals, tangents
+        double totalMs = 0.0;
+    };
+
+    // True for the .obj extension
+    static bool isObjFile(const fs::path& path);
+
+    // Load all groups as static meshes. outStats is optional.
+    static bool load(const fs::path& path, std::vector<MeshData>& outMeshes, Stats* outStats = nullptr);
+};
+
+} // namespace MiEngine
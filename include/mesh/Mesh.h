@@ -3,7 +3,7 @@
 #include <vector>
 #include <limits>
 #include "material/Material.h"
-#include "loader/ModelLoader.h"  // For MeshData
+#include "loader/MeshData.h"
 
 // Axis-Aligned Bounding Box for picking
 struct AABB {
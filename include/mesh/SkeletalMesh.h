@@ -7,7 +7,7 @@
 
 #include "mesh/Mesh.h"
 #include "Utils/SkeletalVertex.h"
-#include "loader/ModelLoader.h"
+#include "loader/MeshData.h"
 
 namespace MiEngine {
 
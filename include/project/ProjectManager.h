@@ -40,6 +40,7 @@ public:
     fs::path getEngineTexturesPath() const { return m_EnginePath / "texture"; }
     fs::path getEngineShadersPath() const { return m_EnginePath / "shaders"; }
     fs::path getEngineHDRPath() const { return m_EnginePath / "hdr"; }
+    fs::path getEngineCachePath() const { return m_EnginePath / "cache"; }    // Bakes shared by all projects
 
     // User data path (for storing recent projects list, etc.)
     fs::path getUserDataPath() const;
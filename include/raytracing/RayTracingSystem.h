@@ -175,6 +175,7 @@ private:
     VulkanRenderer* m_Renderer = nullptr;
     IBLSystem* m_IBLSystem = nullptr;
     bool m_IBLEnabled = true;  // Whether IBL is enabled (can be toggled by UI)
+    std::vector<uint32_t> m_IBLFrameVersions;  // IBL environment version each frame's set was written for
 
     bool m_Initialized = false;
     RTFeatureSupport m_FeatureSupport;
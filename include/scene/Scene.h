@@ -2,6 +2,7 @@
 #include <vulkan/vulkan.h>
 #include <vector>
 #include <memory>
+#include <future>
 #include <unordered_map>
 #include <string>
 #include <glm/glm.hpp>
@@ -11,6 +12,7 @@
 #include "mesh/Mesh.h"
 #include "loader/ModelLoader.h"
 #include "texture/Texture.h"
+#include "texture/TextureStreamer.h"
 #include "physics/PhysicsWorld.h"
 #include "physics/RigidBodyComponent.h"
 #include "physics/ColliderComponent.h"
@@ -22,6 +24,7 @@ class VulkanRenderer;
 namespace MiEngine {
     class Skeleton;
     class AnimationClip;
+    class TextureStreamingUploader;
 }
 
 // Struct to hold transform data for each mesh instance
@@ -103,6 +106,20 @@ public:
                              const MaterialTexturePaths& texturePaths,
                              const Transform& transform = Transform());
     
+    // Queue a texture decode on the ThreadPool. Repeated requests for a file share
+    // one decode; the Texture is available after flushTextureRequests().
+    std::shared_future<std::shared_ptr<Texture>> requestTexture(const std::string& filename,
+                                                                TextureType type = TextureType::Diffuse);
+    void requestTextures(const MaterialTexturePaths& texturePaths);
+
+    // Wait for queued decodes and upload them together in one submission
+    void flushTextureRequests();
+
+    // Stream the mips of baked textures loaded from now on, within settings.budgetBytes.
+    // They start with their tail mips and sharpen as the instances using them grow on screen.
+    void enableTextureStreaming(const MiEngine::TextureStreamingSettings& settings = MiEngine::TextureStreamingSettings());
+    MiEngine::TextureStreamer* getTextureStreamer() { return m_TextureStreamer.get(); }
+    
     // Add a single mesh instance to the scene
     void addMeshInstance(std::shared_ptr<Mesh> mesh, const Transform& transform = Transform());
 
@@ -163,8 +180,38 @@ private:
     VulkanRenderer* renderer;// TODO: not sure if this is save
     std::vector<MeshInstance> meshInstances;
 
-    // Storage for loaded textures to prevent duplicates
-    std::unordered_map<std::string, std::shared_ptr<Texture>> textureCache;
+    // Storage for loaded textures to prevent duplicates, keyed by textureCacheKey() since
+    // the type selects the baked format. Entries become ready when their upload is flushed;
+    // failed loads are removed so they can be retried.
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<Texture>>> textureCache;
+    static std::string textureCacheKey(const std::string& filename, TextureType type) {
+        return filename + '#' + std::to_string(static_cast<int>(type));
+    }
+
+    // Decodes waiting for flushTextureRequests()
+    struct PendingTexture {
+        std::string filename;
+        TextureType type;
+        std::shared_future<std::shared_ptr<MiEngine::DecodedTexture>> decoded;
+        std::promise<std::shared_ptr<Texture>> texture;
+    };
+    std::vector<PendingTexture> pendingTextures;
+
+    // Texture streaming (null until enableTextureStreaming())
+    std::unique_ptr<MiEngine::TextureStreamingUploader> m_TextureUploader;
+    std::unique_ptr<MiEngine::TextureStreamer> m_TextureStreamer;
+    std::unordered_map<const Texture*, uint32_t> m_StreamedTextureIds;
+
+    // Report the mip each streamed texture needs for this view
+    void requestStreamedMips(const glm::mat4& view, const glm::mat4& proj);
+
+    // Apply the streamer's decisions and rewrite the affected material descriptor sets
+    void updateTextureStreaming();
+    void refreshMaterialDescriptors(const std::vector<const Texture*>& changedTextures);
+
+    // Bring a texture to full resolution and stop streaming it. Used for materials
+    // handed out of the Scene, whose descriptor sets it can't refresh.
+    void stopStreaming(const std::shared_ptr<Texture>& texture);
 
     ModelLoader modelLoader;
 
@@ -178,8 +225,10 @@ private:
     // Helper to create mesh objects from loaded mesh data
     
     
-    // Load or retrieve a cached texture
-    std::shared_ptr<Texture> loadTexture(const std::string& filename);
+    // Load or retrieve a cached texture. Uses the baked KTX2 for this type when it is
+    // up to date, otherwise decodes the source and bakes it in the background.
+    // Flushes any other queued requests along with it.
+    std::shared_ptr<Texture> loadTexture(const std::string& filename, TextureType type = TextureType::Diffuse);
     
     // Create a material with multiple textures
     Material createMaterialWithTextures(const MaterialTexturePaths& texturePaths);
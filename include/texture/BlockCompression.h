@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace MiEngine {
+
+// GPU block-compressed formats produced by the texture bake
+enum class BlockFormat : uint32_t {
+    BC1,    // RGB, 4 bpp (opaque, 4-color mode only)
+    BC4,    // R, 4 bpp
+    BC5,    // RG, 8 bpp (two BC4 blocks)
+    BC7     // RGBA, 8 bpp (mode 6)
+};
+
+/**
+ * BlockCompression encodes RGBA8 images into BCn blocks on the CPU.
+ *
+ * Endpoints come from the principal axis of each 4x4 block followed by a
+ * least-squares refit; index selection runs four pixels at a time with SSE2
+ * where available. Images are split into rows of blocks that are encoded in
+ * parallel on the ThreadPool. Edge blocks of images that are not a multiple
+ * of 4 replicate the last row/column.
+ *
+ * BC4 / BC5 read the R / RG channels. Colour data is encoded as-is; sRGB is
+ * only a matter of which VkFormat the blocks are uploaded as.
+ */
+class BlockCompression {
+public:
+    // Bytes per 4x4 block (8 or 16)
+    static uint32_t getBlockBytes(BlockFormat format);
+
+    // Size of the compressed image in bytes
+    static size_t getCompressedSize(BlockFormat format, uint32_t width, uint32_t height);
+
+    // Compress a tightly packed RGBA8 image. outBlocks is resized to getCompressedSize().
+    static void compress(const uint8_t* rgba, uint32_t width, uint32_t height,
+                         BlockFormat format, std::vector<uint8_t>& outBlocks);
+
+    // Single-block encoders; pixels are 16 RGBA8 texels in row order
+    static void encodeBC1(const uint8_t pixels[64], uint8_t out[8]);
+    static void encodeBC4(const uint8_t pixels[64], uint32_t channel, uint8_t out[8]);
+    static void encodeBC5(const uint8_t pixels[64], uint8_t out[16]);
+    static void encodeBC7(const uint8_t pixels[64], uint8_t out[16]);
+};
+
+} // namespace MiEngine
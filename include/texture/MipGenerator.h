@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace MiEngine {
+
+// Downsampling filter for CPU mip generation
+enum class MipFilter : uint32_t {
+    Box,        // Area average; matches a linear blit for power-of-two sizes
+    Kaiser,     // Kaiser-windowed sinc (radius 3, alpha 4) - sharp, little ringing
+    Lanczos     // Lanczos-3 - sharpest, rings around very bright texels
+};
+
+// Pixel layouts the generator reads and writes (always four channels)
+enum class MipPixelFormat : uint32_t {
+    RGBA8,          // UNORM
+    RGBA8_SRGB,     // RGB filtered in linear space, alpha linear
+    RGBA16F,
+    RGBA32F
+};
+
+struct MipSettings {
+    MipFilter filter = MipFilter::Box;
+    bool normalMap = false;     // Renormalize XYZ per texel (RGBA8 unpacked from [0,1], floats used as stored)
+    bool wrap = false;          // Sample across edges for tiling textures instead of clamping
+};
+
+/**
+ * MipGenerator builds mip chains on the CPU.
+ *
+ * Every level is filtered from the previous one with a separable kernel in
+ * linear float, four channels per SSE2 vector (F16C converts half floats when
+ * enabled). The destination is split into bands of rows; each band runs on
+ * the ThreadPool and only filters the source rows it needs, so the
+ * intermediate data stays in cache. Negative filter lobes are clamped
+ * (colours >= 0, RGBA8 to [0,1]) except for normal maps.
+ */
+class MipGenerator {
+public:
+    // floor(log2(max(width, height))) + 1
+    static uint32_t getMipLevelCount(uint32_t width, uint32_t height);
+
+    static uint32_t getBytesPerPixel(MipPixelFormat format);
+
+    // Filter src down to dstWidth x dstHeight (each no larger than the source)
+    static void downsample(const void* src, uint32_t srcWidth, uint32_t srcHeight,
+                           void* dst, uint32_t dstWidth, uint32_t dstHeight,
+                           MipPixelFormat format, const MipSettings& settings);
+
+    // Mips 1..levelCount-1 of a tightly packed image; outLevels[0] is mip 1.
+    // levelCount 0 means the full chain.
+    static void generate(const void* level0, uint32_t width, uint32_t height,
+                         MipPixelFormat format, const MipSettings& settings,
+                         std::vector<std::vector<uint8_t>>& outLevels, uint32_t levelCount = 0);
+
+    // Complete a float RGBA cubemap in the IBL cache layout (each mip holds all
+    // six faces). cubeData holds mip 0 on input and every level on output.
+    static void generateCubemap(std::vector<float>& cubeData, uint32_t faceSize, uint32_t levelCount,
+                                const MipSettings& settings);
+
+    // Half <-> float conversion used for RGBA16F
+    static float halfToFloat(uint16_t value);
+    static uint16_t floatToHalf(float value);
+};
+
+} // namespace MiEngine
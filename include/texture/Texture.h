@@ -2,6 +2,9 @@
 #include <vulkan/vulkan.h>
 #include <string>
 #include <memory>
+#include <vector>
+
+namespace MiEngine { struct DecodedTexture; }
 
 class Texture {
 public:
@@ -15,6 +18,17 @@ public:
     
     // Load texture from a file (use stb_image internally)
     bool loadFromFile(const std::string& filepath, VkCommandPool commandPool, VkQueue graphicsQueue);
+
+    // Load a baked, block-compressed KTX2 file (see MiEngine::TextureCache).
+    // All mip levels are uploaded in one submission. Fails if the device can't sample the format.
+    bool loadFromKtx2(const std::string& filepath, VkCommandPool commandPool, VkQueue graphicsQueue);
+
+    // Upload decoded textures through one staging buffer and one submission. Levels a
+    // DecodedTexture doesn't carry are blitted in the same command buffer. Entries that
+    // are null or use a format the device can't sample come back null.
+    static std::vector<std::shared_ptr<Texture>> uploadBatch(VkDevice device, VkPhysicalDevice physicalDevice,
+                                                             VkCommandPool commandPool, VkQueue graphicsQueue,
+                                                             const std::vector<std::shared_ptr<MiEngine::DecodedTexture>>& decoded);
     
     // For creating a texture from raw pixel data
     bool createFromPixels(const unsigned char* pixels, uint32_t width, uint32_t height, 
@@ -32,6 +46,10 @@ public:
                                uint32_t mipLevels, uint32_t layerCount, VkImageViewType viewType,
                                VkImageLayout initialLayout);
 
+    // Exchange images, views and samplers with another texture on the same device.
+    // Texture streaming uses this to resize a texture that materials already reference.
+    void swapContents(Texture& other);
+
     uint32_t getWidth() const { return width; }       // ADD THIS
     uint32_t getHeight() const { return height; } 
 
@@ -62,7 +80,11 @@ private:
                           VkCommandPool commandPool, VkQueue graphicsQueue);
     void generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels,
                        VkCommandPool commandPool, VkQueue graphicsQueue);
+    void recordMipmapBlits(VkCommandBuffer commandBuffer, VkImage image, int32_t texWidth, int32_t texHeight,
+                           uint32_t mipLevels);
                        
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+
     VkCommandBuffer beginSingleTimeCommands(VkCommandPool commandPool);
     void endSingleTimeCommands(VkCommandBuffer commandBuffer, VkCommandPool commandPool, VkQueue graphicsQueue);
 };
\ No newline at end of file
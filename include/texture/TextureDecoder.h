@@ -0,0 +1,46 @@
+#pragma once
+
+#include "asset/TextureCache.h"
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MiEngine {
+
+// A texture decoded into host memory, ready for Texture::uploadBatch()
+struct DecodedTexture {
+    using Level = BakedTexture::Level;
+
+    std::string path;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevels = 1;             // Levels the image should have
+    std::vector<Level> levels;          // Levels present here; the rest are generated on the GPU
+    double decodeMs = 0.0;
+
+    BakedTexture baked;                 // Mapped KTX2 when the bake was current
+    std::shared_ptr<uint8_t> pixels;    // RGBA8 level 0 from the source image otherwise
+};
+
+/**
+ * TextureDecoder turns texture files into DecodedTextures off the main thread.
+ *
+ * A current bake (see TextureCache) is mapped and used as-is. Otherwise the
+ * source image is decoded to RGBA8 and a bake of the decoded pixels is queued
+ * in the background, so the next load skips the decode. No Vulkan calls are
+ * made here; uploads happen in batches on the main thread.
+ */
+class TextureDecoder {
+public:
+    // Decode on the calling thread; nullptr if the file can't be read.
+    // bakeOnMiss queues a background bake when no current bake exists.
+    static std::shared_ptr<DecodedTexture> decode(const std::string& path, TextureType type, bool bakeOnMiss = true);
+
+    // Decode on the ThreadPool
+    static std::shared_future<std::shared_ptr<DecodedTexture>> decodeAsync(const std::string& path, TextureType type,
+                                                                           bool bakeOnMiss = true);
+};
+
+} // namespace MiEngine
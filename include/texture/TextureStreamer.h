@@ -0,0 +1,138 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace MiEngine {
+
+struct TextureStreamingSettings {
+    uint64_t budgetBytes = 512ull << 20;              // GPU memory for all streamed textures
+    uint64_t maxUploadBytesPerUpdate = 32ull << 20;   // Bounds the hitch of a single update
+    uint32_t tailSize = 64;                           // Mips this size and smaller are always resident
+    float mipBias = 0.0f;                             // Added to every required mip (positive = blurrier)
+};
+
+// One texture moving to a new first resident mip
+struct TextureResidencyChange {
+    uint32_t textureId = 0;
+    uint32_t fromMip = 0;
+    uint32_t toMip = 0;       // Mips [toMip, mipCount) should be resident afterwards
+    bool applied = true;      // Cleared by the backend if the change failed
+};
+
+// Performs residency changes; the engine uploads from baked KTX2 files,
+// TextureStreamerBenchmark records them
+class TextureStreamingBackend {
+public:
+    virtual ~TextureStreamingBackend() = default;
+
+    // Called once per update with every change of that update
+    virtual void applyResidency(std::vector<TextureResidencyChange>& changes) = 0;
+};
+
+struct TextureStreamingStats {
+    uint32_t textureCount = 0;
+    uint64_t residentBytes = 0;
+    uint64_t requiredBytes = 0;       // What the last requests would need with no budget
+    uint32_t uploads = 0;             // Textures gaining mips in the last update
+    uint32_t evictions = 0;           // Textures losing mips in the last update
+    uint64_t uploadedBytes = 0;
+    uint32_t deferred = 0;            // Upgrades left for later (upload limit or budget)
+};
+
+/**
+ * TextureStreamer decides which mips of each texture are resident.
+ *
+ * Every frame the renderer reports the mip each visible texture needs
+ * (computeRequiredMip() from the screen-space size of the instances using
+ * it). update() then raises residency for the most blurred textures first,
+ * within the upload limit, and makes room under the budget by dropping mips
+ * from the least recently used textures. Textures in use only drop below
+ * what they need when they alone exceed the budget, and tail mips
+ * (<= tailSize) are never evicted.
+ *
+ * No graphics API is touched here; all changes go through the backend.
+ */
+class TextureStreamer {
+public:
+    static constexpr uint32_t INVALID_ID = ~0u;
+
+    explicit TextureStreamer(TextureStreamingBackend& backend,
+                             const TextureStreamingSettings& settings = TextureStreamingSettings());
+
+    // mipBytes[i] is the GPU size of mip i. residentMip is the first mip already uploaded.
+    uint32_t registerTexture(uint32_t width, uint32_t height, const std::vector<uint64_t>& mipBytes,
+                             uint32_t residentMip);
+    void unregisterTexture(uint32_t id);
+
+    // First mip that always stays resident for a texture of this size
+    uint32_t getTailMip(uint32_t width, uint32_t height, uint32_t mipCount) const;
+
+    // Projected diameter in pixels of local-space bounds under model/view/proj.
+    // Returns 0 if the bounds are entirely behind the camera.
+    static float computeScreenSize(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& model,
+                                   const glm::mat4& view, const glm::mat4& proj, float viewportHeight);
+
+    // Mip whose size matches screenSize pixels (assumes the UVs cover the texture once across the bounds)
+    uint32_t computeRequiredMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenSize) const;
+
+    // Report that a texture is visible this frame and needs at least this mip
+    void requestMip(uint32_t id, uint32_t mip);
+
+    // requestMip() with the mip for screenSize pixels
+    void requestScreenSize(uint32_t id, float screenSize);
+
+    // Apply the requests since the last update. Returns the changes the backend applied.
+    const std::vector<TextureResidencyChange>& update();
+
+    uint32_t getResidentMip(uint32_t id) const;
+    uint32_t getWantedMip(uint32_t id) const;
+    uint64_t getResidentBytes() const { return m_ResidentBytes; }
+
+    const TextureStreamingStats& getStats() const { return m_Stats; }
+    const TextureStreamingSettings& getSettings() const { return m_Settings; }
+    void setSettings(const TextureStreamingSettings& settings) { m_Settings = settings; }
+
+private:
+    struct Entry {
+        bool alive = false;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipCount = 0;
+        uint32_t tailMip = 0;
+        uint32_t residentMip = 0;
+        uint32_t wantedMip = 0;
+        uint32_t requestedMip = INVALID_ID;   // Smallest mip requested this frame
+        uint64_t lastUsedFrame = 0;
+        std::vector<uint64_t> bytesFrom;      // bytesFrom[m] = size of mips [m, mipCount)
+    };
+
+    uint64_t bytesFrom(const Entry& entry, uint32_t mip) const { return entry.bytesFrom[mip]; }
+
+    // Sharpest mip an eviction has to keep (inUse: textures needed this frame may go down to their tail)
+    uint32_t evictionFloor(const Entry& entry, bool inUse) const;
+
+    // Bytes evict() could free right now
+    uint64_t getEvictableBytes() const;
+
+    // Drop mips from least recently used textures until `needed` bytes are free; returns bytes freed
+    uint64_t evict(uint64_t needed, bool inUse = false);
+
+    void setResident(uint32_t id, uint32_t mip);
+
+    TextureStreamingBackend& m_Backend;
+    TextureStreamingSettings m_Settings;
+
+    std::vector<Entry> m_Entries;
+    std::vector<uint32_t> m_FreeIds;
+    uint64_t m_Frame = 0;
+    uint64_t m_ResidentBytes = 0;
+
+    // Per-update scratch
+    std::vector<TextureResidencyChange> m_Changes;
+    std::vector<uint32_t> m_ChangeIndex;     // Entry id -> index in m_Changes, or INVALID_ID
+    TextureStreamingStats m_Stats;
+};
+
+} // namespace MiEngine
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "texture/TextureStreamer.h"
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <unordered_map>
+
+class Texture;
+
+namespace MiEngine {
+
+struct DecodedTexture;
+
+/**
+ * Vulkan backend for TextureStreamer.
+ *
+ * Each streamed texture keeps its bake mapped. A residency change rebuilds
+ * the image from the new first mip, and all changes of one update share a
+ * single Texture::uploadBatch(). Texture objects are updated in place, so
+ * materials keep their pointers but must rewrite their descriptor sets.
+ */
+class TextureStreamingUploader : public TextureStreamingBackend {
+public:
+    TextureStreamingUploader(VkDevice device, VkPhysicalDevice physicalDevice,
+                             VkCommandPool commandPool, VkQueue graphicsQueue);
+
+    // source must hold every mip level (a mapped bake)
+    void addTexture(uint32_t id, const std::shared_ptr<Texture>& texture,
+                    const std::shared_ptr<DecodedTexture>& source);
+    void removeTexture(uint32_t id);
+
+    std::shared_ptr<Texture> getTexture(uint32_t id) const;
+
+    // Levels [firstMip, end) of source; the level data stays owned by source
+    static std::shared_ptr<DecodedTexture> selectMips(const DecodedTexture& source, uint32_t firstMip);
+
+    void applyResidency(std::vector<TextureResidencyChange>& changes) override;
+
+private:
+    struct StreamedTexture {
+        std::shared_ptr<Texture> texture;
+        std::shared_ptr<DecodedTexture> source;
+    };
+
+    VkDevice m_Device;
+    VkPhysicalDevice m_PhysicalDevice;
+    VkCommandPool m_CommandPool;
+    VkQueue m_GraphicsQueue;
+
+    std::unordered_map<uint32_t, StreamedTexture> m_Textures;
+};
+
+} // namespace MiEngine
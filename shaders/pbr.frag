@@ -86,12 +86,34 @@ layout(set = 2, binding = 0) uniform LightBuffer {
 layout(set = 3, binding = 0) uniform samplerCube irradianceMap;
 layout(set = 3, binding = 1) uniform samplerCube prefilterMap;
 layout(set = 3, binding = 2) uniform sampler2D brdfLUT;
+layout(set = 3, binding = 3) uniform IrradianceSH {
+    vec4 coefficients[9];   // rgb = cosine-convolved L2 coefficients
+    int enabled;            // 0 = sample irradianceMap instead
+} irradianceSH;
 
 // Ray Tracing outputs (optional - only used when RT is enabled)
 // Set 5 to avoid conflict with skeletal bone matrices (Set 4)
 layout(set = 5, binding = 0) uniform sampler2D rtReflections;
 layout(set = 5, binding = 1) uniform sampler2D rtShadows;
 
+// Diffuse irradiance / PI from L2 spherical harmonics (IBLSystem::getIrradianceSH)
+vec3 evaluateIrradianceSH(vec3 n) {
+    vec3 result = irradianceSH.coefficients[0].rgb * 0.282095
+                + irradianceSH.coefficients[1].rgb * (0.488603 * n.y)
+                + irradianceSH.coefficients[2].rgb * (0.488603 * n.z)
+                + irradianceSH.coefficients[3].rgb * (0.488603 * n.x)
+                + irradianceSH.coefficients[4].rgb * (1.092548 * n.x * n.y)
+                + irradianceSH.coefficients[5].rgb * (1.092548 * n.y * n.z)
+                + irradianceSH.coefficients[6].rgb * (0.315392 * (3.0 * n.z * n.z - 1.0))
+                + irradianceSH.coefficients[7].rgb * (1.092548 * n.x * n.z)
+                + irradianceSH.coefficients[8].rgb * (0.546274 * (n.x * n.x - n.y * n.y));
+    return max(result, vec3(0.0));
+}
+
+vec3 sampleIrradiance(vec3 n) {
+    return irradianceSH.enabled > 0 ? evaluateIrradianceSH(n) : texture(irradianceMap, n).rgb;
+}
+
 vec3 fresnelSchlick(float cosTheta, vec3 F0) {
     return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
@@ -253,7 +275,9 @@ void main() {
     // Calculate vectors
     vec3 N = normalize(fragNormal);
     if (pushConstants.hasNormalMap > 0) {
-        vec3 tangentNormal = texture(normalMap, fragTexCoord).rgb * 2.0 - 1.0;
+        // Rebuild Z from XY so two-channel (BC5) normal maps work as well as RGB ones
+        vec2 tangentXY = texture(normalMap, fragTexCoord).rg * 2.0 - 1.0;
+        vec3 tangentNormal = vec3(tangentXY, sqrt(max(1.0 - dot(tangentXY, tangentXY), 0.0)));
         N = normalize(TBN * tangentNormal);
     }
     
@@ -348,8 +372,8 @@ void main() {
         kD = 1.0 - kS;
         kD *= 1.0 - metallic;
 
-        // Diffuse IBL from irradiance map
-        vec3 irradiance = texture(irradianceMap, N).rgb;
+        // Diffuse IBL from irradiance SH (or map)
+        vec3 irradiance = sampleIrradiance(N);
         diffuse = irradiance * albedo.rgb;
 
         // Calculate proper mip level based on roughness (perceptual mapping)
@@ -359,11 +383,19 @@ void main() {
 
         prefilteredColor = textureLod(prefilterMap, R, mipLevel).rgb;
         // Sample BRDF LUT with correct coordinates (match generation range)
-        envBRDF = texture(brdfLUT, vec2(NdotV, roughness)).rg; // R=scale, G=bias
+        vec3 brdfSample = texture(brdfLUT, vec2(NdotV, roughness)).rgb; // R=scale, G=bias, B=E_avg
+        envBRDF = brdfSample.rg;
 
         // Apply split-sum approximation
         specular = prefilteredColor * (F0 * envBRDF.x + envBRDF.y);
 
+        // Kulla-Conty multiple scattering: energy lost by single scattering, tinted by the average Fresnel
+        float Ess = envBRDF.x + envBRDF.y;
+        float Eavg = brdfSample.b;
+        vec3 Favg = F0 + (1.0 - F0) / 21.0;
+        vec3 Fms = Favg * Favg * Eavg / (1.0 - Favg * (1.0 - Eavg));
+        specular += prefilteredColor * (1.0 - Ess) * Fms;
+
         // Replace with ray traced reflections if enabled
         if (pushConstants.useRTReflections > 0 && metallic > 0.1) {
             vec2 screenUV = gl_FragCoord.xy / vec2(textureSize(rtReflections, 0));
@@ -439,8 +471,8 @@ void main() {
         // Layer 7: Full ambient (diffuse + specular IBL)
         color = ambient;
     } else if (pushConstants.debugLayer == 8) {
-        // Layer 8: Irradiance map only (raw)
-        color = texture(irradianceMap, N).rgb;
+        // Layer 8: Irradiance only (raw)
+        color = sampleIrradiance(N);
     } else if (pushConstants.debugLayer == 9) {
         // Layer 9: NdotV visualization
         color = vec3(NdotV);
@@ -35,6 +35,10 @@ layout(set = 0, binding = 2) uniform sampler2D normalMap;
 layout(set = 1, binding = 0) uniform samplerCube irradianceMap;
 layout(set = 1, binding = 1) uniform samplerCube prefilterMap;
 layout(set = 1, binding = 2) uniform sampler2D brdfLUT;
+layout(set = 1, binding = 3) uniform IrradianceSH {
+    vec4 coefficients[9];   // rgb = cosine-convolved L2 coefficients
+    int enabled;            // 0 = sample irradianceMap instead
+} irradianceSH;
 
 // Fresnel-Schlick approximation
 vec3 fresnelSchlick(float cosTheta, vec3 F0) {
@@ -46,6 +50,23 @@ vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness) {
     return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 
+// Diffuse irradiance / PI from L2 spherical harmonics (same as pbr.frag)
+vec3 sampleIrradiance(vec3 n) {
+    if (irradianceSH.enabled == 0) {
+        return texture(irradianceMap, n).rgb;
+    }
+    vec3 result = irradianceSH.coefficients[0].rgb * 0.282095
+                + irradianceSH.coefficients[1].rgb * (0.488603 * n.y)
+                + irradianceSH.coefficients[2].rgb * (0.488603 * n.z)
+                + irradianceSH.coefficients[3].rgb * (0.488603 * n.x)
+                + irradianceSH.coefficients[4].rgb * (1.092548 * n.x * n.y)
+                + irradianceSH.coefficients[5].rgb * (1.092548 * n.y * n.z)
+                + irradianceSH.coefficients[6].rgb * (0.315392 * (3.0 * n.z * n.z - 1.0))
+                + irradianceSH.coefficients[7].rgb * (1.092548 * n.x * n.z)
+                + irradianceSH.coefficients[8].rgb * (0.546274 * (n.x * n.x - n.y * n.y));
+    return max(result, vec3(0.0));
+}
+
 void main() {
     // Normalize interpolated values
     vec3 N = normalize(fragNormal);
@@ -98,8 +119,8 @@ void main() {
     float diffuse = max(dot(N, lightDir), 0.0) * 0.5 + 0.5;
     vec3 litWater = waterColor * diffuse * lightColor;
 
-    // Add subtle ambient from irradiance map
-    vec3 irradiance = texture(irradianceMap, N).rgb;
+    // Add subtle ambient from irradiance
+    vec3 irradiance = sampleIrradiance(N);
     litWater += waterColor * irradiance * 0.1;
 
     // Blend reflection with water color based on Fresnel
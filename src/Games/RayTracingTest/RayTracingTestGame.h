@@ -78,9 +78,15 @@ public:
     void OnUpdate(float deltaTime) override {
         m_Time += deltaTime;
 
-        // Update world if playing
+        // Update world if playing; tick() dispatches the event bus after
+        // PostPhysics and again after spawns and destroys are applied
         if (m_World && m_World->isPlaying()) {
             m_World->tick(deltaTime);
+        } else if (m_World) {
+            // Paused: still deliver what editor spawns posted this frame
+            // instead of holding it until play resumes
+            m_World->getEventBus().dispatch();
+            m_World->getEventBus().endFrame();
         }
     }
 
@@ -0,0 +1,285 @@
+#include "Renderer/BRDFIntegrator.h"
+#include "core/ThreadPool.h"
+#include "texture/MipGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MI_BRDF_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MiEngine {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float MIN_NDOTV = 0.001f;         // V.z floor, matches the shader's grazing clamp
+constexpr float MIN_ROUGHNESS = 0.001f;
+
+struct BRDFLutHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t resolution;
+    uint32_t sampleCount;
+};
+
+static_assert(sizeof(BRDFLutHeader) == 16, "BRDF LUT header is 16 bytes");
+
+// ----------------------------------------------------------------------------
+// One float for each of four texels (masks have all bits set where true)
+// ----------------------------------------------------------------------------
+
+#ifdef MI_BRDF_SSE2
+struct Lanes { __m128 v; };
+inline Lanes lanes(float s) { return { _mm_set1_ps(s) }; }
+inline Lanes loadLanes(const float* p) { return { _mm_loadu_ps(p) }; }
+inline void storeLanes(float* p, Lanes a) { _mm_storeu_ps(p, a.v); }
+inline Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Lanes operator/(Lanes a, Lanes b) { return { _mm_div_ps(a.v, b.v) }; }
+inline Lanes greater(Lanes a, Lanes b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline Lanes maskAnd(Lanes a, Lanes b) { return { _mm_and_ps(a.v, b.v) }; }
+inline Lanes maskedOrZero(Lanes mask, Lanes a) { return { _mm_and_ps(mask.v, a.v) }; }
+#else
+struct Lanes { float v[4]; };
+template <typename Op>
+inline Lanes mapLanes(Lanes a, Lanes b, Op op) {
+    Lanes r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+inline Lanes lanes(float s) { return { { s, s, s, s } }; }
+inline Lanes loadLanes(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void storeLanes(float* p, Lanes a) { std::memcpy(p, a.v, sizeof(a.v)); }
+inline Lanes operator+(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x + y; }); }
+inline Lanes operator-(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x - y; }); }
+inline Lanes operator*(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x * y; }); }
+inline Lanes operator/(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x / y; }); }
+inline Lanes greater(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x > y ? 1.0f : 0.0f; }); }
+inline Lanes maskAnd(Lanes a, Lanes b) { return a * b; }
+inline Lanes maskedOrZero(Lanes mask, Lanes a) { return mapLanes(mask, a, [](float m, float x) { return m != 0.0f ? x : 0.0f; }); }
+#endif
+
+float radicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10f;
+}
+
+// Integrate one roughness row into RGBA texels (B is filled in by the caller)
+void integrateRow(float roughness, uint32_t sampleCount, uint32_t resolution, float* row) {
+    // Hammersley GGX half vectors in the frame TextureUtils used (N = +Z, V in the XZ
+    // plane); only their X and Z components reach the integrand
+    const float alpha = roughness * roughness;
+    std::vector<float> hx(sampleCount);
+    std::vector<float> hz(sampleCount);
+    for (uint32_t i = 0; i < sampleCount; ++i) {
+        float u = radicalInverse(i);
+        float phi = 2.0f * PI * float(i) / float(sampleCount);
+        float cosTheta = std::sqrt((1.0f - u) / (1.0f + (alpha * alpha - 1.0f) * u));
+        float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+        hx[i] = std::sin(phi) * sinTheta;
+        hz[i] = cosTheta;
+    }
+
+    // Schlick-GGX with the IBL k
+    const float k = alpha / 2.0f;
+    const Lanes kLanes = lanes(k);
+    const Lanes oneMinusK = lanes(1.0f - k);
+    const Lanes one = lanes(1.0f);
+    const Lanes zero = lanes(0.0f);
+    const Lanes two = lanes(2.0f);
+    const float invSamples = 1.0f / float(sampleCount);
+    const float invLast = resolution > 1 ? 1.0f / float(resolution - 1) : 0.0f;
+
+    for (uint32_t x0 = 0; x0 < resolution; x0 += 4) {
+        float vxIn[4];
+        float vzIn[4];
+        for (uint32_t l = 0; l < 4; ++l) {
+            float NdotV = std::min(float(std::min(x0 + l, resolution - 1)) * invLast, 1.0f);
+            vxIn[l] = std::sqrt(std::max(0.0f, 1.0f - NdotV * NdotV));
+            vzIn[l] = std::max(MIN_NDOTV, NdotV);
+        }
+        const Lanes vx = loadLanes(vxIn);
+        const Lanes vz = loadLanes(vzIn);
+        const Lanes geometryV = vz / (vz * oneMinusK + kLanes);
+        // G_Vis = G * VdotH / (NdotH * NdotV); the per-texel factors come out of the loop
+        const Lanes visScale = geometryV / vz;
+
+        Lanes sumA = zero;
+        Lanes sumB = zero;
+        for (uint32_t i = 0; i < sampleCount; ++i) {
+            const Lanes h_x = lanes(hx[i]);
+            const Lanes h_z = lanes(hz[i]);
+            const Lanes VdotH = vx * h_x + vz * h_z;
+            const Lanes NdotL = two * VdotH * h_z - vz;
+            const Lanes valid = maskAnd(greater(NdotL, zero), greater(VdotH, zero));
+
+            const Lanes geometryL = NdotL / (NdotL * oneMinusK + kLanes);
+            const Lanes vis = maskedOrZero(valid, geometryL * VdotH / h_z);
+
+            const Lanes c = one - VdotH;
+            const Lanes c2 = c * c;
+            const Lanes fresnel = c2 * c2 * c;
+            sumA = sumA + vis * (one - fresnel);
+            sumB = sumB + vis * fresnel;
+        }
+
+        float a[4];
+        float b[4];
+        storeLanes(a, sumA * visScale * lanes(invSamples));
+        storeLanes(b, sumB * visScale * lanes(invSamples));
+        for (uint32_t l = 0; l < 4 && x0 + l < resolution; ++l) {
+            float* texel = row + (x0 + l) * 4;
+            texel[0] = std::clamp(a[l], 0.0f, 1.0f);
+            texel[1] = std::clamp(b[l], 0.0f, 1.0f);
+            texel[3] = 1.0f;
+        }
+    }
+
+    // E_avg = 2 * integral of E(mu) mu dmu over the row (trapezoid rule)
+    float averageAlbedo = 0.0f;
+    if (resolution > 1) {
+        for (uint32_t x = 0; x < resolution; ++x) {
+            float weight = (x == 0 || x == resolution - 1) ? 0.5f : 1.0f;
+            float albedo = row[x * 4 + 0] + row[x * 4 + 1];
+            averageAlbedo += weight * albedo * float(x) * invLast;
+        }
+        averageAlbedo = std::clamp(2.0f * averageAlbedo * invLast, 0.0f, 1.0f);
+    } else {
+        averageAlbedo = row[0] + row[1];
+    }
+    for (uint32_t x = 0; x < resolution; ++x) {
+        row[x * 4 + 2] = averageAlbedo;
+    }
+}
+
+} // anonymous namespace
+
+std::vector<float> BRDFIntegrator::integrate(const BRDFLutSettings& settings) {
+    const uint32_t resolution = settings.resolution;
+    const uint32_t baseSamples = std::max(settings.sampleCount, 1u);
+    std::vector<float> lut(static_cast<size_t>(resolution) * resolution * 4);
+    if (resolution == 0) {
+        return lut;
+    }
+
+    ThreadPool::getInstance().parallelFor(resolution, [&](size_t y) {
+        float roughness = resolution > 1 ? float(y) / float(resolution - 1) : 1.0f;
+        roughness = std::clamp(roughness, MIN_ROUGHNESS, 1.0f);
+
+        // Near-mirror lobes need more samples to converge
+        uint32_t sampleCount = roughness < 0.1f ? baseSamples * 4 : baseSamples;
+        integrateRow(roughness, sampleCount, resolution, lut.data() + y * resolution * 4);
+    });
+    return lut;
+}
+
+fs::path BRDFIntegrator::getCachePath(const BRDFLutSettings& settings, const fs::path& cacheDir) {
+    return cacheDir / ("brdf_lut_" + std::to_string(settings.resolution) + "_" +
+                       std::to_string(settings.sampleCount) + ".bin");
+}
+
+std::vector<uint16_t> BRDFIntegrator::load(const BRDFLutSettings& settings, const fs::path& cacheDir) {
+    const fs::path cachePath = getCachePath(settings, cacheDir);
+
+    std::vector<uint16_t> texels;
+    if (open(cachePath, settings, texels)) {
+        std::cout << "Loaded BRDF LUT from cache: " << cachePath.string() << std::endl;
+        return texels;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::vector<float> lut = integrate(settings);
+    std::cout << "Integrated BRDF LUT (" << settings.resolution << "x" << settings.resolution << ", "
+              << settings.sampleCount << " samples) in "
+              << std::chrono::duration<double, std::milli>(
+                     std::chrono::high_resolution_clock::now() - startTime).count()
+              << " ms" << std::endl;
+
+    texels.resize(lut.size());
+    for (size_t i = 0; i < lut.size(); ++i) {
+        texels[i] = MipGenerator::floatToHalf(lut[i]);
+    }
+    save(cachePath, settings, texels);
+    return texels;
+}
+
+bool BRDFIntegrator::save(const fs::path& cachePath, const BRDFLutSettings& settings,
+                          const std::vector<uint16_t>& texels) {
+    if (texels.size() != static_cast<size_t>(settings.resolution) * settings.resolution * 4) {
+        return false;
+    }
+
+    BRDFLutHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.resolution = settings.resolution;
+    header.sampleCount = settings.sampleCount;
+
+    // Write to a temporary file first so an interrupted bake is never loaded
+    std::error_code ec;
+    fs::create_directories(cachePath.parent_path(), ec);
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Warning: Failed to save BRDF LUT cache " << tempPath << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(texels.data()),
+                  static_cast<std::streamsize>(texels.size() * sizeof(uint16_t)));
+        if (!out.good()) {
+            std::cerr << "Warning: Failed to write BRDF LUT cache " << tempPath << std::endl;
+            return false;
+        }
+    }
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "Warning: Failed to replace " << cachePath << ": " << ec.message() << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool BRDFIntegrator::open(const fs::path& cachePath, const BRDFLutSettings& settings,
+                          std::vector<uint16_t>& outTexels) {
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    BRDFLutHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file.good() || header.magic != MAGIC || header.version != VERSION ||
+        header.resolution != settings.resolution || header.sampleCount != settings.sampleCount) {
+        return false;
+    }
+
+    std::vector<uint16_t> texels(static_cast<size_t>(settings.resolution) * settings.resolution * 4);
+    file.read(reinterpret_cast<char*>(texels.data()), static_cast<std::streamsize>(texels.size() * sizeof(uint16_t)));
+    if (!file.good()) {
+        std::cerr << "BRDF LUT cache " << cachePath << " is truncated" << std::endl;
+        return false;
+    }
+
+    outTexels = std::move(texels);
+    return true;
+}
+
+} // namespace MiEngine
@@ -0,0 +1,476 @@
+#include "Renderer/EquirectConverter.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MI_EQUIRECT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MiEngine {
+
+namespace {
+
+constexpr float HALF_PI = 1.57079632679490f;
+constexpr float INV_PI = 0.318309886183791f;
+constexpr float INV_TWO_PI = 0.159154943091895f;
+
+// ----------------------------------------------------------------------------
+// One float for each of four texels
+// ----------------------------------------------------------------------------
+
+#ifdef MI_EQUIRECT_SSE2
+struct Lanes { __m128 v; };
+inline Lanes lanes(float s) { return { _mm_set1_ps(s) }; }
+inline Lanes loadLanes(const float* p) { return { _mm_loadu_ps(p) }; }
+inline void storeLanes(float* p, Lanes a) { _mm_storeu_ps(p, a.v); }
+inline Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Lanes operator/(Lanes a, Lanes b) { return { _mm_div_ps(a.v, b.v) }; }
+inline Lanes lanesMin(Lanes a, Lanes b) { return { _mm_min_ps(a.v, b.v) }; }
+inline Lanes lanesMax(Lanes a, Lanes b) { return { _mm_max_ps(a.v, b.v) }; }
+inline Lanes lanesSqrt(Lanes a) { return { _mm_sqrt_ps(a.v) }; }
+inline Lanes reverseLanes(Lanes a) { return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(0, 1, 2, 3)) }; }
+inline Lanes select(Lanes mask, Lanes a, Lanes b) {
+    return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+}
+inline Lanes greater(Lanes a, Lanes b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+// Values in a small range around [0, 1] (no int overflow)
+inline Lanes lanesFloor(Lanes a) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    return { _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f))) };
+}
+// Truncate non-negative lanes to int
+inline void storeIndices(int32_t* p, Lanes a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(a.v));
+}
+#else
+struct Lanes { float v[4]; };
+template <typename Op>
+inline Lanes mapLanes(Lanes a, Lanes b, Op op) {
+    Lanes r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+inline Lanes lanes(float s) { return { { s, s, s, s } }; }
+inline Lanes loadLanes(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void storeLanes(float* p, Lanes a) { std::memcpy(p, a.v, sizeof(a.v)); }
+inline Lanes operator+(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x + y; }); }
+inline Lanes operator-(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x - y; }); }
+inline Lanes operator*(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x * y; }); }
+inline Lanes operator/(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x / y; }); }
+inline Lanes lanesMin(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return std::min(x, y); }); }
+inline Lanes lanesMax(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return std::max(x, y); }); }
+inline Lanes lanesSqrt(Lanes a) { return mapLanes(a, a, [](float x, float) { return std::sqrt(x); }); }
+inline Lanes reverseLanes(Lanes a) { return { { a.v[3], a.v[2], a.v[1], a.v[0] } }; }
+inline Lanes select(Lanes mask, Lanes a, Lanes b) {
+    Lanes r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+inline Lanes greater(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x > y ? 1.0f : 0.0f; }); }
+inline Lanes lanesFloor(Lanes a) { return mapLanes(a, a, [](float x, float) { return std::floor(x); }); }
+inline void storeIndices(int32_t* p, Lanes a) {
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<int32_t>(a.v[i]);
+    }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// One RGBA texel in a vector register
+// ----------------------------------------------------------------------------
+
+#ifdef MI_EQUIRECT_SSE2
+using Vec4 = __m128;
+inline Vec4 vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 vlerp(Vec4 a, Vec4 b, float t) {
+    return _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(1.0f - t)), _mm_mul_ps(b, _mm_set1_ps(t)));
+}
+inline Vec4 vaverage4(Vec4 a, Vec4 b, Vec4 c, Vec4 d) {
+    return _mm_mul_ps(_mm_add_ps(_mm_add_ps(a, b), _mm_add_ps(c, d)), _mm_set1_ps(0.25f));
+}
+// RGB of v with alpha 1
+inline Vec4 vopaque(Vec4 v) {
+    const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    return _mm_or_ps(_mm_and_ps(v, rgbMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+}
+#else
+struct Vec4 { float v[4]; };
+inline Vec4 vload(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void vstore(float* p, Vec4 v) { std::memcpy(p, v.v, sizeof(v.v)); }
+inline Vec4 vlerp(Vec4 a, Vec4 b, float t) {
+    Vec4 r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = a.v[i] * (1.0f - t) + b.v[i] * t;
+    }
+    return r;
+}
+inline Vec4 vaverage4(Vec4 a, Vec4 b, Vec4 c, Vec4 d) {
+    Vec4 r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = ((a.v[i] + b.v[i]) + (c.v[i] + d.v[i])) * 0.25f;
+    }
+    return r;
+}
+inline Vec4 vopaque(Vec4 v) {
+    v.v[3] = 1.0f;
+    return v;
+}
+#endif
+
+// atan(x) for x >= 0: reduce to [0, 1] with atan(x) = PI/2 - atan(1/x), then the
+// Abramowitz & Stegun 4.4.49 polynomial (2e-8 rad before float rounding)
+Lanes atanLanes(Lanes x) {
+    Lanes one = lanes(1.0f);
+    Lanes inverted = greater(x, one);
+    Lanes t = select(inverted, one / lanesMax(x, one), x);
+    Lanes t2 = t * t;
+    Lanes p = lanes(0.0028662257f);
+    p = p * t2 + lanes(-0.0161657367f);
+    p = p * t2 + lanes(0.0429096138f);
+    p = p * t2 + lanes(-0.0752896400f);
+    p = p * t2 + lanes(0.1065626393f);
+    p = p * t2 + lanes(-0.1420889944f);
+    p = p * t2 + lanes(0.1999355085f);
+    p = p * t2 + lanes(-0.3333314528f);
+    Lanes a = t + t * t2 * p;
+    return select(inverted, lanes(HALF_PI) - a, a);
+}
+
+// How a face quadrant reads the table: eqU = fract(uOffset + uScale * T.u),
+// eqV = vOffset + vScale * T.v, with T the side or top quadrant table
+struct QuadrantMap {
+    bool top = false;
+    float uOffset = 0.0f;
+    float uScale = 1.0f;
+    float vOffset = 0.0f;
+    float vScale = 1.0f;
+};
+
+// Face directions (unnormalized, u and v in [-1, 1]):
+//   +X (1, -v, -u)   -X (-1, -v, u)   +Y (u, 1, v)
+//   -Y (u, -1, -v)   +Z (u, -v, 1)    -Z (-u, -v, -1)
+// with theta = atan2(z, x), phi = acos(y), eqU = theta / 2PI + 0.5, eqV = phi / PI
+QuadrantMap getQuadrantMap(uint32_t face, bool positiveU, bool positiveV) {
+    float su = positiveU ? 1.0f : -1.0f;
+    float sv = positiveV ? 1.0f : -1.0f;
+    QuadrantMap map;
+
+    if (face == 2 || face == 3) {
+        // theta = atan2(+-v, u); the polar angle only depends on the radius
+        float sz = face == 2 ? sv : -sv;
+        map.top = true;
+        map.uScale = sz * su;
+        map.uOffset = positiveU ? 0.5f : 0.5f + 0.5f * sz;
+        map.vOffset = face == 2 ? 0.0f : 1.0f;
+        map.vScale = face == 2 ? 1.0f : -1.0f;
+        return map;
+    }
+
+    // Side faces: theta = faceAngle - atan(u), y = -v on every face
+    static const float faceOffsets[6] = { 0.5f, 0.0f, 0.0f, 0.0f, 0.75f, 0.25f };
+    map.uOffset = faceOffsets[face];
+    map.uScale = -su;
+    map.vOffset = positiveV ? 0.0f : 1.0f;
+    map.vScale = sv;
+    return map;
+}
+
+struct SourceImage {
+    const float* data = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;
+    size_t lastVectorTexel = 0;     // Texels below this can be read as four floats
+};
+
+// Bilinear fetch, weights as the scalar converter used to apply them
+void fetchTexel(const SourceImage& image, int32_t x0, int32_t y0, float dx, float dy, float* out) {
+    int32_t x1 = std::min(x0 + 1, static_cast<int32_t>(image.width) - 1);
+    int32_t y1 = std::min(y0 + 1, static_cast<int32_t>(image.height) - 1);
+    size_t i00 = static_cast<size_t>(y0) * image.width + x0;
+    size_t i10 = static_cast<size_t>(y0) * image.width + x1;
+    size_t i01 = static_cast<size_t>(y1) * image.width + x0;
+    size_t i11 = static_cast<size_t>(y1) * image.width + x1;
+    uint32_t channels = image.channels;
+
+    if (channels >= 3 && i11 < image.lastVectorTexel) {
+        Vec4 top = vlerp(vload(image.data + i00 * channels), vload(image.data + i10 * channels), dx);
+        Vec4 bottom = vlerp(vload(image.data + i01 * channels), vload(image.data + i11 * channels), dx);
+        vstore(out, vopaque(vlerp(top, bottom, dy)));
+        return;
+    }
+
+    uint32_t colourChannels = std::min(channels, 3u);
+    for (uint32_t c = 0; c < colourChannels; ++c) {
+        float v0 = image.data[i00 * channels + c] * (1.0f - dx) + image.data[i10 * channels + c] * dx;
+        float v1 = image.data[i01 * channels + c] * (1.0f - dx) + image.data[i11 * channels + c] * dx;
+        out[c] = v0 * (1.0f - dy) + v1 * dy;
+    }
+    for (uint32_t c = colourChannels; c < 3; ++c) {
+        out[c] = out[0];
+    }
+    out[3] = 1.0f;
+}
+
+// Table values of count texels starting at qx, walking forward or (mirrored half) backward
+Lanes loadTable(const float* row, uint32_t qx, bool forward, uint32_t count) {
+    if (count == 4) {
+        return forward ? loadLanes(row + qx) : reverseLanes(loadLanes(row + qx - 3));
+    }
+    float values[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (uint32_t i = 0; i < count; ++i) {
+        values[i] = row[forward ? qx + i : qx - i];
+    }
+    return loadLanes(values);
+}
+
+// Convert texels [xBegin, xEnd) of one row, all in the same horizontal half
+void convertSpan(const SourceImage& image, const EquirectDirectionTable& table, uint32_t face,
+                 uint32_t y, uint32_t xBegin, uint32_t xEnd, float* rowOut) {
+    const uint32_t size = table.faceSize;
+    const uint32_t half = size / 2;
+    const uint32_t q = table.quadrantSize;
+    const bool positiveU = xBegin >= half;
+    const bool positiveV = y >= half;
+    const QuadrantMap map = getQuadrantMap(face, positiveU, positiveV);
+
+    // Mirrored halves count quadrant indices down from the centre
+    uint32_t qy = positiveV ? y - half : size - 1 - y - half;
+    const float* uRow = map.top ? table.topU.data() + static_cast<size_t>(qy) * q : table.sideU.data();
+    const float* vRow = (map.top ? table.topV.data() : table.sideV.data()) + static_cast<size_t>(qy) * q;
+
+    const Lanes uOffset = lanes(map.uOffset);
+    const Lanes uScale = lanes(map.uScale);
+    const Lanes vOffset = lanes(map.vOffset);
+    const Lanes vScale = lanes(map.vScale);
+    const Lanes zero = lanes(0.0f);
+    const Lanes one = lanes(1.0f);
+    const Lanes maxX = lanes(static_cast<float>(image.width - 1));
+    const Lanes maxY = lanes(static_cast<float>(image.height - 1));
+
+    alignas(16) int32_t x0[4];
+    alignas(16) int32_t y0[4];
+    alignas(16) float dx[4];
+    alignas(16) float dy[4];
+
+    for (uint32_t x = xBegin; x < xEnd; x += 4) {
+        uint32_t count = std::min(4u, xEnd - x);
+        uint32_t qx = positiveU ? x - half : size - 1 - x - half;
+
+        Lanes eqU = uOffset + uScale * loadTable(uRow, qx, positiveU, count);
+        eqU = eqU - lanesFloor(eqU);
+        Lanes eqV = lanesMin(lanesMax(vOffset + vScale * loadTable(vRow, qx, positiveU, count), zero), one);
+
+        Lanes fx = eqU * maxX;
+        Lanes fy = eqV * maxY;
+        Lanes ix = lanesFloor(fx);
+        Lanes iy = lanesFloor(fy);
+        storeIndices(x0, ix);
+        storeIndices(y0, iy);
+        storeLanes(dx, fx - ix);
+        storeLanes(dy, fy - iy);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            fetchTexel(image, x0[i], y0[i], dx[i], dy[i], rowOut + static_cast<size_t>(x + i) * 4);
+        }
+    }
+}
+
+// The most recently used table
+std::mutex g_TableMutex;
+std::shared_ptr<const EquirectDirectionTable> g_Table;
+
+} // anonymous namespace
+
+float EquirectConverter::atanApprox(float x) {
+    float result[4];
+    storeLanes(result, atanLanes(lanes(x)));
+    return result[0];
+}
+
+EquirectDirectionTable EquirectConverter::buildDirectionTable(uint32_t faceSize) {
+    EquirectDirectionTable table;
+    table.faceSize = faceSize;
+    table.quadrantSize = (faceSize + 1) / 2;
+    const uint32_t q = table.quadrantSize;
+    table.sideU.resize(q);
+    table.sideV.resize(static_cast<size_t>(q) * q);
+    table.topU.resize(static_cast<size_t>(q) * q);
+    table.topV.resize(static_cast<size_t>(q) * q);
+
+    // Texel centre |u| of quadrant column i (odd sizes have a centre column at 0)
+    const float firstCentre = (faceSize % 2 == 0) ? 1.0f : 0.0f;
+    const float scale = 2.0f / static_cast<float>(faceSize);
+    auto coordinate = [&](uint32_t i) { return (static_cast<float>(i) + 0.5f * firstCentre) * scale; };
+
+    ThreadPool::getInstance().parallelFor(q, [&](size_t qy) {
+        const float v = coordinate(static_cast<uint32_t>(qy));
+        const Lanes lv = lanes(v);
+        const Lanes one = lanes(1.0f);
+        const Lanes tiny = lanes(1e-20f);
+        size_t rowOffset = qy * q;
+
+        for (uint32_t qx = 0; qx < q; qx += 4) {
+            uint32_t count = std::min(4u, q - qx);
+            float us[4];
+            for (uint32_t i = 0; i < 4; ++i) {
+                us[i] = coordinate(qx + i);
+            }
+            Lanes u = loadLanes(us);
+
+            // Side (+X): polar angle = PI/2 + asin(v / r) = PI/2 + atan(v / sqrt(1 + u^2))
+            Lanes sideV = lanes(0.5f) + atanLanes(lv / lanesSqrt(one + u * u)) * lanes(INV_PI);
+
+            // Top (+Y): atan2(v, u) from the ratio below 1; polar angle = atan(sqrt(u^2 + v^2))
+            Lanes swap = greater(lv, u);
+            Lanes ratio = select(swap, u / lanesMax(lv, tiny), lv / lanesMax(u, tiny));
+            Lanes azimuth = atanLanes(ratio);
+            azimuth = select(swap, lanes(HALF_PI) - azimuth, azimuth);
+            Lanes topU = azimuth * lanes(INV_TWO_PI);
+            Lanes topV = atanLanes(lanesSqrt(u * u + lv * lv)) * lanes(INV_PI);
+
+            float values[3][4];
+            storeLanes(values[0], sideV);
+            storeLanes(values[1], topU);
+            storeLanes(values[2], topV);
+            for (uint32_t i = 0; i < count; ++i) {
+                table.sideV[rowOffset + qx + i] = values[0][i];
+                table.topU[rowOffset + qx + i] = values[1][i];
+                table.topV[rowOffset + qx + i] = values[2][i];
+            }
+
+            if (qy == 0) {
+                float sideU[4];
+                storeLanes(sideU, atanLanes(u) * lanes(INV_TWO_PI));
+                std::copy(sideU, sideU + count, table.sideU.begin() + qx);
+            }
+        }
+    }, 16);
+
+    return table;
+}
+
+std::shared_ptr<const EquirectDirectionTable> EquirectConverter::getDirectionTable(uint32_t faceSize) {
+    std::lock_guard<std::mutex> lock(g_TableMutex);
+    if (!g_Table || g_Table->faceSize != faceSize) {
+        g_Table = std::make_shared<const EquirectDirectionTable>(buildDirectionTable(faceSize));
+    }
+    return g_Table;
+}
+
+std::vector<float> EquirectConverter::convert(const float* source, uint32_t width, uint32_t height,
+                                              uint32_t channels, const EquirectSettings& settings) {
+    const uint32_t size = settings.faceSize;
+    if (!source || width == 0 || height == 0 || channels == 0 || channels > 4 || size == 0) {
+        return {};
+    }
+
+    const uint32_t levelCount = std::clamp(settings.mipLevels, 1u, MipGenerator::getMipLevelCount(size, size));
+    std::vector<size_t> levelOffsets(levelCount);
+    size_t total = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        uint32_t levelSize = std::max(size >> level, 1u);
+        levelOffsets[level] = total;
+        total += static_cast<size_t>(levelSize) * levelSize * 4 * 6;
+    }
+    std::vector<float> chain(total);
+
+    std::shared_ptr<const EquirectDirectionTable> table = getDirectionTable(size);
+
+    SourceImage image;
+    image.data = source;
+    image.width = width;
+    image.height = height;
+    image.channels = channels;
+    image.lastVectorTexel = static_cast<size_t>(width) * height - (channels == 4 ? 0 : 1);
+
+    // Box mips stay inside power-of-two tiles when the face is a power of two
+    uint32_t tileSize = std::max(settings.tileSize, 4u);
+    while (tileSize & (tileSize - 1)) {
+        tileSize &= tileSize - 1;
+    }
+    tileSize = std::min(tileSize, size);
+    const bool powerOfTwo = (size & (size - 1)) == 0;
+    const bool fusedMips = levelCount > 1 && powerOfTwo && settings.mipFilter == MipFilter::Box;
+    const uint32_t tileLevels = fusedMips ? std::min(levelCount, MipGenerator::getMipLevelCount(tileSize, tileSize)) : 1;
+
+    const uint32_t tilesPerEdge = (size + tileSize - 1) / tileSize;
+    const size_t tilesPerFace = static_cast<size_t>(tilesPerEdge) * tilesPerEdge;
+    const uint32_t half = size / 2;
+
+    ThreadPool::getInstance().parallelFor(tilesPerFace * 6, [&](size_t tile) {
+        uint32_t face = static_cast<uint32_t>(tile / tilesPerFace);
+        uint32_t tileX = static_cast<uint32_t>(tile % tilesPerFace % tilesPerEdge) * tileSize;
+        uint32_t tileY = static_cast<uint32_t>(tile % tilesPerFace / tilesPerEdge) * tileSize;
+        uint32_t xEnd = std::min(tileX + tileSize, size);
+        uint32_t yEnd = std::min(tileY + tileSize, size);
+        float* faceOut = chain.data() + static_cast<size_t>(face) * size * size * 4;
+
+        for (uint32_t y = tileY; y < yEnd; ++y) {
+            float* rowOut = faceOut + static_cast<size_t>(y) * size * 4;
+            // A tile can straddle the vertical centre line only when it covers the face
+            uint32_t split = std::clamp(half, tileX, xEnd);
+            if (tileX < split) {
+                convertSpan(image, *table, face, y, tileX, split, rowOut);
+            }
+            if (split < xEnd) {
+                convertSpan(image, *table, face, y, split, xEnd, rowOut);
+            }
+        }
+
+        // 2x2 averages of the tile while it is in cache
+        for (uint32_t level = 1; level < tileLevels; ++level) {
+            uint32_t srcSize = size >> (level - 1);
+            uint32_t dstSize = size >> level;
+            uint32_t dstTile = tileSize >> level;
+            const float* src = chain.data() + levelOffsets[level - 1] + static_cast<size_t>(face) * srcSize * srcSize * 4;
+            float* dst = chain.data() + levelOffsets[level] + static_cast<size_t>(face) * dstSize * dstSize * 4;
+            uint32_t dstX = tileX >> level;
+            uint32_t dstY = tileY >> level;
+
+            for (uint32_t y = dstY; y < dstY + dstTile; ++y) {
+                const float* row0 = src + static_cast<size_t>(2 * y) * srcSize * 4;
+                const float* row1 = row0 + static_cast<size_t>(srcSize) * 4;
+                float* rowOut = dst + static_cast<size_t>(y) * dstSize * 4;
+                for (uint32_t x = dstX; x < dstX + dstTile; ++x) {
+                    vstore(rowOut + x * 4, vaverage4(vload(row0 + x * 8), vload(row0 + x * 8 + 4),
+                                                     vload(row1 + x * 8), vload(row1 + x * 8 + 4)));
+                }
+            }
+        }
+    }, 1);
+
+    MipSettings mipSettings;
+    mipSettings.filter = settings.mipFilter;
+    if (!fusedMips) {
+        MipGenerator::generateCubemap(chain, size, levelCount, mipSettings);
+        return chain;
+    }
+
+    // Levels smaller than a tile
+    for (uint32_t level = tileLevels; level < levelCount; ++level) {
+        uint32_t srcSize = std::max(size >> (level - 1), 1u);
+        uint32_t dstSize = std::max(size >> level, 1u);
+        size_t srcFaceFloats = static_cast<size_t>(srcSize) * srcSize * 4;
+        size_t dstFaceFloats = static_cast<size_t>(dstSize) * dstSize * 4;
+        for (uint32_t face = 0; face < 6; ++face) {
+            MipGenerator::downsample(chain.data() + levelOffsets[level - 1] + face * srcFaceFloats, srcSize, srcSize,
+                                     chain.data() + levelOffsets[level] + face * dstFaceFloats, dstSize, dstSize,
+                                     MipPixelFormat::RGBA32F, mipSettings);
+        }
+    }
+    return chain;
+}
+
+} // namespace MiEngine
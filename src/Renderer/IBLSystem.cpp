@@ -3,6 +3,10 @@
 
 #include "VulkanRenderer.h"
 #include "Utils/TextureUtils.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 
 IBLSystem::IBLSystem(VulkanRenderer* renderer) : renderer(renderer) {
@@ -21,41 +25,22 @@ bool IBLSystem::initialize(const std::string& hdriPath) {
     // Reset state
     cleanup();
     this->currentHdriPath = hdriPath;
-    VkDevice device = renderer->getDevice();
-    VkPhysicalDevice physicalDevice = renderer->getPhysicalDevice();
-    VkCommandPool commandPool = renderer->getCommandPool();
-    VkQueue graphicsQueue = renderer->getGraphicsQueue();
     
     // Load environment map from HDRI
     std::cout << "Loading environment map from: " << hdriPath << std::endl;
-    environmentMap = TextureUtils::createEnvironmentCubemap(
-        device, 
-        physicalDevice, 
-        commandPool, 
-        graphicsQueue, 
-        hdriPath
-    );
+    const TextureUtils::IBLConfig config = TextureUtils::getIBLConfig();
+    auto data = TextureUtils::buildEnvironmentData(hdriPath, config);
     
-    if (!environmentMap) {
+    if (!data) {
         std::cerr << "Failed to load environment map: " << hdriPath << std::endl;
         std::cout << "Creating default environment map instead" << std::endl;
         
-        // Use default environment map if loading fails
-        environmentMap = TextureUtils::createDefaultEnvironmentCubemap(
-            device,
-            physicalDevice,
-            commandPool,
-            graphicsQueue
-        );
-        
-        if (!environmentMap) {
-            std::cerr << "Failed to create default environment map" << std::endl;
-            return false;
-        }
+        // Use default environment map if loading fails (no path, so nothing is cached for it)
+        data = TextureUtils::buildEnvironmentData("", config, TextureUtils::createDefaultEnvironmentData());
     }
     
     // Create IBL resources
-    bool success = createIBLResources();
+    bool success = data && createIBLResources(data);
     if (!success) {
         std::cerr << "Failed to create IBL resources" << std::endl;
         cleanup();
@@ -77,6 +62,7 @@ bool IBLSystem::initialize(const std::string& hdriPath) {
         cleanup();
         return false;
     }
+    frameVersions.assign(descriptorSets.size(), environmentVersion);
     
     initialized = true;
     std::cout << "IBL system initialized successfully" << std::endl;
@@ -85,82 +71,266 @@ bool IBLSystem::initialize(const std::string& hdriPath) {
 
 
 
-bool IBLSystem::createIBLResources() {
-    if (!environmentMap) {
-        std::cerr << "Environment map not loaded" << std::endl;
+bool IBLSystem::createIBLResources(const std::shared_ptr<TextureUtils::EnvironmentData>& data) {
+    // Same path as a background switch, waiting for the upload instead of polling it
+    if (!beginEnvironmentUpload(data)) {
+        std::cerr << "Failed to upload environment map" << std::endl;
         return false;
     }
-
-    // Read and cache the environment map data for CPU sampling
-    std::cout << "Reading environment map data from GPU..." << std::endl;
-    auto envData = TextureUtils::readCubemapFromGPU(
+    swapEnvironment();
+    std::cout << "Environment map data cached for CPU sampling" << std::endl;
+    
+    // Create BRDF lookup table (independent of the environment, kept across switches)
+    std::cout << "Creating BRDF lookup table..." << std::endl;
+    brdfLUT = TextureUtils::createBRDFLookUpTexture(
         renderer->getDevice(),
         renderer->getPhysicalDevice(),
         renderer->getCommandPool(),
         renderer->getGraphicsQueue(),
-        environmentMap
+        512  // Resolution of LUT
     );
     
-    if (envData) {
-        TextureUtils::cacheEnvironmentMap(environmentMap, envData);
-        TextureUtils::setCurrentEnvironmentData(envData);
-        std::cout << "Environment map data cached for CPU sampling" << std::endl;
-    } else {
-        std::cerr << "Warning: Failed to cache environment map data" << std::endl;
+    if (!brdfLUT) {
+        std::cerr << "Failed to create BRDF lookup table" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+void IBLSystem::requestEnvironment(const std::string& hdriPath) {
+    if (!initialized) {
+        return;
+    }
+    
+    if (isEnvironmentPending()) {
+        queuedHdriPath = hdriPath;
+        return;
+    }
+    
+    std::cout << "Building environment map in the background: " << hdriPath << std::endl;
+    pendingHdriPath = hdriPath;
+    requestTime = std::chrono::high_resolution_clock::now();
+    
+    // The config is copied so later edits don't race the worker
+    TextureUtils::IBLConfig config = TextureUtils::getIBLConfig();
+    pendingBuild = MiEngine::ThreadPool::getInstance().submit([hdriPath, config]() {
+        return TextureUtils::buildEnvironmentData(hdriPath, config);
+    });
+}
+
+void IBLSystem::update() {
+    if (!initialized) {
+        return;
     }
     
     VkDevice device = renderer->getDevice();
-    VkPhysicalDevice physicalDevice = renderer->getPhysicalDevice();
     VkCommandPool commandPool = renderer->getCommandPool();
-    VkQueue graphicsQueue = renderer->getGraphicsQueue();
     
-    // Create irradiance map for diffuse lighting
-    std::cout << "Creating irradiance map..." << std::endl;
-    irradianceMap = TextureUtils::createIrradianceMap(
-       device, physicalDevice, commandPool, graphicsQueue,
-       environmentMap, currentHdriPath // <--- Pass Key
-   );
+    // CPU work done: submit every cubemap of the new environment at once
+    if (pendingBuild.valid() && pendingBuild.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        std::shared_ptr<TextureUtils::EnvironmentData> data = pendingBuild.get();
+        if (!data || !beginEnvironmentUpload(data)) {
+            std::cerr << "Failed to load environment map: " << pendingHdriPath
+                      << ", keeping the current one" << std::endl;
+            startQueuedRequest();
+        }
+    }
     
-    if (!irradianceMap) {
-        std::cerr << "Failed to create irradiance map" << std::endl;
-        return false;
+    // Upload landed: frames pick the new environment up in refreshFrameDescriptors
+    if (pendingData && TextureUtils::isUploadComplete(device, pendingUpload)) {
+        swapEnvironment();
+        std::cout << "Switched environment map to " << currentHdriPath << " after "
+                  << std::chrono::duration<double, std::milli>(
+                         std::chrono::high_resolution_clock::now() - requestTime).count()
+                  << " ms" << std::endl;
+        startQueuedRequest();
     }
     
-    // Create prefiltered environment map for specular reflections
-    std::cout << "Creating prefiltered environment map..." << std::endl;
-    prefilterMap = TextureUtils::createPrefilterMap(
-       device, physicalDevice, commandPool, graphicsQueue,
-       environmentMap, currentHdriPath // <--- Pass Key
-   );
+    // Full-quality prefilter mips replace the preview in place, ordered by the upload's barriers
+    if (refinementUpload.fence != VK_NULL_HANDLE && TextureUtils::isUploadComplete(device, refinementUpload)) {
+        TextureUtils::releaseUpload(device, commandPool, refinementUpload);
+        std::cout << "Prefiltered environment map refined to full quality" << std::endl;
+    }
+    
+    if (refinementUpload.fence == VK_NULL_HANDLE && prefilterRefinement.valid() &&
+        prefilterRefinement.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        std::vector<float> refined = prefilterRefinement.get();
+        if (prefilterMap && refined.size() == MiEngine::IBLCache::getTexelCount(
+                prefilterMap->getWidth(), prefilterMap->getMipLevels()) * 4) {
+            TextureUtils::CubemapUpload upload;
+            upload.data = refined.data();
+            upload.faceSize = prefilterMap->getWidth();
+            upload.mipLevels = prefilterMap->getMipLevels();
+            upload.target = prefilterMap;
+            TextureUtils::submitCubemapUploads(device, renderer->getPhysicalDevice(), commandPool,
+                                               renderer->getGraphicsQueue(), { upload }, refinementUpload);
+        }
+    }
     
-    if (!prefilterMap) {
-        std::cerr << "Failed to create prefiltered environment map" << std::endl;
+    releaseRetiredEnvironments(false);
+}
+
+bool IBLSystem::refreshFrameDescriptors(uint32_t frameIndex) {
+    if (!initialized || frameIndex >= frameVersions.size() || frameVersions[frameIndex] == environmentVersion) {
         return false;
     }
     
-    // Create BRDF lookup table
-    std::cout << "Creating BRDF lookup table..." << std::endl;
-    brdfLUT = TextureUtils::createBRDFLookUpTexture(
-        device,
-        physicalDevice,
-        commandPool,
-        graphicsQueue,
-        512  // Resolution of LUT
-    );
+    writeDescriptorSet(descriptorSets[frameIndex]);
+    frameVersions[frameIndex] = environmentVersion;
+    return true;
+}
+
+bool IBLSystem::beginEnvironmentUpload(const std::shared_ptr<TextureUtils::EnvironmentData>& data) {
+    VkDevice device = renderer->getDevice();
+    VkCommandPool commandPool = renderer->getCommandPool();
+    const CubemapData& environment = *data->environment;
+    
+    std::vector<TextureUtils::CubemapUpload> uploads(3);
+    uploads[0].data = environment.data.data();
+    uploads[0].faceSize = environment.faceSize;
+    uploads[0].mipLevels = environment.mipLevels;
+    uploads[1].data = data->irradiance.data();
+    uploads[1].faceSize = data->irradianceSize;
+    uploads[2].data = data->prefilter.data();
+    uploads[2].faceSize = data->prefilterSize;
+    uploads[2].mipLevels = data->prefilterMipLevels;
+    
+    pendingTextures = TextureUtils::submitCubemapUploads(device, renderer->getPhysicalDevice(), commandPool,
+                                                         renderer->getGraphicsQueue(), uploads, pendingUpload);
+    
+    bool complete = std::all_of(pendingTextures.begin(), pendingTextures.end(),
+                                [](const std::shared_ptr<Texture>& texture) { return texture != nullptr; });
+    if (complete) {
+        complete = createIrradianceSHBuffer(data->irradianceSH, data->useIrradianceSH, pendingSHBuffer,
+                                            pendingSHMemory);
+    }
     
-    if (!brdfLUT) {
-        std::cerr << "Failed to create BRDF lookup table" << std::endl;
+    if (!complete) {
+        TextureUtils::releaseUpload(device, commandPool, pendingUpload);
+        pendingTextures.clear();
+        if (pendingSHBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device, pendingSHBuffer, nullptr);
+            pendingSHBuffer = VK_NULL_HANDLE;
+        }
+        if (pendingSHMemory != VK_NULL_HANDLE) {
+            vkFreeMemory(device, pendingSHMemory, nullptr);
+            pendingSHMemory = VK_NULL_HANDLE;
+        }
         return false;
     }
     
+    // The GPU copies are in the staging buffer; only the environment stays for CPU sampling
+    data->irradiance = {};
+    data->prefilter = {};
+    pendingData = data;
+    return true;
+}
+
+void IBLSystem::swapEnvironment() {
+    VkDevice device = renderer->getDevice();
+    
+    // Frames still in flight keep the old textures until refreshFrameDescriptors moves them on
+    if (environmentMap) {
+        RetiredEnvironment retired;
+        retired.environmentMap = environmentMap;
+        retired.irradianceMap = irradianceMap;
+        retired.prefilterMap = prefilterMap;
+        retired.irradianceSHBuffer = irradianceSHBuffer;
+        retired.irradianceSHMemory = irradianceSHMemory;
+        retired.refinementUpload = refinementUpload;
+        retired.version = environmentVersion + 1;
+        retiredEnvironments.push_back(std::move(retired));
+        refinementUpload = {};
+    }
+    environmentVersion++;
+    
+    environmentMap = pendingTextures[0];
+    irradianceMap = pendingTextures[1];
+    prefilterMap = pendingTextures[2];
+    irradianceSHBuffer = pendingSHBuffer;
+    irradianceSHMemory = pendingSHMemory;
+    irradianceSH = pendingData->irradianceSH;
+    currentHdriPath = pendingData->hdrPath;
+    
+    // A refinement of the old environment is dropped (it still finishes its cache write)
+    prefilterRefinement = std::move(pendingData->prefilterRefinement);
+    
+    TextureUtils::cacheEnvironmentMap(environmentMap, pendingData->environment);
+    TextureUtils::setCurrentEnvironmentData(pendingData->environment);
+    
+    TextureUtils::releaseUpload(device, renderer->getCommandPool(), pendingUpload);
+    pendingTextures.clear();
+    pendingSHBuffer = VK_NULL_HANDLE;
+    pendingSHMemory = VK_NULL_HANDLE;
+    pendingData = nullptr;
+}
+
+void IBLSystem::startQueuedRequest() {
+    pendingHdriPath.clear();
+    if (queuedHdriPath.empty()) {
+        return;
+    }
+    
+    std::string hdriPath = std::move(queuedHdriPath);
+    queuedHdriPath.clear();
+    requestEnvironment(hdriPath);
+}
+
+void IBLSystem::releaseRetiredEnvironments(bool force) {
+    VkDevice device = renderer->getDevice();
+    
+    // The oldest environment any frame's descriptor set can still reference
+    uint32_t oldestVersion = environmentVersion;
+    if (!frameVersions.empty()) {
+        oldestVersion = *std::min_element(frameVersions.begin(), frameVersions.end());
+    }
+    
+    auto it = retiredEnvironments.begin();
+    while (it != retiredEnvironments.end()) {
+        if (!force && it->version > oldestVersion) {
+            ++it;
+            continue;
+        }
+        
+        TextureUtils::releaseUpload(device, renderer->getCommandPool(), it->refinementUpload);
+        TextureUtils::cacheEnvironmentMap(it->environmentMap, nullptr);
+        if (it->irradianceSHBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device, it->irradianceSHBuffer, nullptr);
+        }
+        if (it->irradianceSHMemory != VK_NULL_HANDLE) {
+            vkFreeMemory(device, it->irradianceSHMemory, nullptr);
+        }
+        it = retiredEnvironments.erase(it);
+    }
+}
+
+bool IBLSystem::createIrradianceSHBuffer(const MiEngine::SHL2& sh, bool useSH, VkBuffer& buffer,
+                                         VkDeviceMemory& memory) {
+    VkDevice device = renderer->getDevice();
+    VkDeviceSize bufferSize = sizeof(MiEngine::IrradianceSHUniform);
+    
+    renderer->createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                           buffer, memory);
+    
+    // The flag the environment was built with: the irradiance cubemap size depends on it
+    MiEngine::IrradianceSHUniform uniform = MiEngine::SphericalHarmonics::toUniform(sh, useSH);
+    
+    void* data;
+    if (vkMapMemory(device, memory, 0, bufferSize, 0, &data) != VK_SUCCESS) {
+        return false;
+    }
+    memcpy(data, &uniform, sizeof(uniform));
+    vkUnmapMemory(device, memory);
     return true;
 }
 
 VkDescriptorSetLayout IBLSystem::createDescriptorSetLayout() {
     VkDevice device = renderer->getDevice();
     
-    // Create bindings for IBL textures (2 cubemaps + 1 2D texture)
-    std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+    // Create bindings for IBL textures (2 cubemaps + 1 2D texture) and the irradiance SH
+    std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
     
     // Binding 0: Irradiance cubemap
     bindings[0].binding = 0;
@@ -183,6 +353,13 @@ VkDescriptorSetLayout IBLSystem::createDescriptorSetLayout() {
     bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
     bindings[2].pImmutableSamplers = nullptr;
     
+    // Binding 3: Irradiance SH uniform
+    bindings[3].binding = 3;
+    bindings[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[3].descriptorCount = 1;
+    bindings[3].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    bindings[3].pImmutableSamplers = nullptr;
+    
     VkDescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
@@ -203,7 +380,7 @@ std::vector<VkDescriptorSet> IBLSystem::createDescriptorSets(VkDescriptorPool de
         return {};
     }
     
-    if (!irradianceMap || !prefilterMap || !brdfLUT) {
+    if (!irradianceMap || !prefilterMap || !brdfLUT || irradianceSHBuffer == VK_NULL_HANDLE) {
         std::cerr << "IBL textures not created" << std::endl;
         return {};
     }
@@ -227,58 +404,79 @@ std::vector<VkDescriptorSet> IBLSystem::createDescriptorSets(VkDescriptorPool de
     
     // Update descriptor sets
     for (uint32_t i = 0; i < frameCount; i++) {
-        std::array<VkDescriptorImageInfo, 3> imageInfos{};
-        
-        // Irradiance map
-        imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[0].imageView = irradianceMap->getImageView();
-        imageInfos[0].sampler = irradianceMap->getSampler();
-        
-        // Prefiltered environment map
-        imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[1].imageView = prefilterMap->getImageView();
-        imageInfos[1].sampler = prefilterMap->getSampler();
-        
-        // BRDF LUT
-        imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfos[2].imageView = brdfLUT->getImageView();
-        imageInfos[2].sampler = brdfLUT->getSampler();
-        
-        std::array<VkWriteDescriptorSet, 3> descriptorWrites{};
-        
-        // Irradiance map
-        descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = sets[i];
-        descriptorWrites[0].dstBinding = 0;
-        descriptorWrites[0].dstArrayElement = 0;
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWrites[0].descriptorCount = 1;
-        descriptorWrites[0].pImageInfo = &imageInfos[0];
-        
-        // Prefiltered environment map
-        descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = sets[i];
-        descriptorWrites[1].dstBinding = 1;
-        descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWrites[1].descriptorCount = 1;
-        descriptorWrites[1].pImageInfo = &imageInfos[1];
-        
-        // BRDF LUT
-        descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[2].dstSet = sets[i];
-        descriptorWrites[2].dstBinding = 2;
-        descriptorWrites[2].dstArrayElement = 0;
-        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWrites[2].descriptorCount = 1;
-        descriptorWrites[2].pImageInfo = &imageInfos[2];
-        
-        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+        writeDescriptorSet(sets[i]);
     }
     
     return sets;
 }
 
+void IBLSystem::writeDescriptorSet(VkDescriptorSet descriptorSet) {
+    VkDevice device = renderer->getDevice();
+    
+    std::array<VkDescriptorImageInfo, 3> imageInfos{};
+    
+    // Irradiance map
+    imageInfos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[0].imageView = irradianceMap->getImageView();
+    imageInfos[0].sampler = irradianceMap->getSampler();
+    
+    // Prefiltered environment map
+    imageInfos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[1].imageView = prefilterMap->getImageView();
+    imageInfos[1].sampler = prefilterMap->getSampler();
+    
+    // BRDF LUT
+    imageInfos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfos[2].imageView = brdfLUT->getImageView();
+    imageInfos[2].sampler = brdfLUT->getSampler();
+    
+    // Irradiance SH (one buffer per environment, never written after creation)
+    VkDescriptorBufferInfo shBufferInfo{};
+    shBufferInfo.buffer = irradianceSHBuffer;
+    shBufferInfo.offset = 0;
+    shBufferInfo.range = sizeof(MiEngine::IrradianceSHUniform);
+    
+    std::array<VkWriteDescriptorSet, 4> descriptorWrites{};
+    
+    // Irradiance map
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[0].dstSet = descriptorSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].dstArrayElement = 0;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].pImageInfo = &imageInfos[0];
+    
+    // Prefiltered environment map
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].dstSet = descriptorSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].dstArrayElement = 0;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].pImageInfo = &imageInfos[1];
+    
+    // BRDF LUT
+    descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[2].dstSet = descriptorSet;
+    descriptorWrites[2].dstBinding = 2;
+    descriptorWrites[2].dstArrayElement = 0;
+    descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrites[2].descriptorCount = 1;
+    descriptorWrites[2].pImageInfo = &imageInfos[2];
+    
+    // Irradiance SH
+    descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[3].dstSet = descriptorSet;
+    descriptorWrites[3].dstBinding = 3;
+    descriptorWrites[3].dstArrayElement = 0;
+    descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[3].descriptorCount = 1;
+    descriptorWrites[3].pBufferInfo = &shBufferInfo;
+    
+    vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+}
+
 void IBLSystem::cleanup() {
     VkDevice device = renderer->getDevice();
     
@@ -291,6 +489,42 @@ void IBLSystem::cleanup() {
     // Descriptor sets will be freed when the descriptor pool is destroyed
     descriptorSets.clear();
     
+    // Let a running refinement finish (it also writes the cache file) and drop its result
+    if (prefilterRefinement.valid()) {
+        prefilterRefinement.wait();
+        prefilterRefinement = {};
+    }
+    TextureUtils::releaseUpload(device, renderer->getCommandPool(), refinementUpload);
+    
+    // Drop an environment still in flight (a worker build only touches the CPU and the cache)
+    pendingBuild = {};
+    pendingHdriPath.clear();
+    queuedHdriPath.clear();
+    TextureUtils::releaseUpload(device, renderer->getCommandPool(), pendingUpload);
+    pendingTextures.clear();
+    pendingData = nullptr;
+    if (pendingSHBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, pendingSHBuffer, nullptr);
+        pendingSHBuffer = VK_NULL_HANDLE;
+    }
+    if (pendingSHMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, pendingSHMemory, nullptr);
+        pendingSHMemory = VK_NULL_HANDLE;
+    }
+    
+    releaseRetiredEnvironments(true);
+    frameVersions.clear();
+    TextureUtils::cacheEnvironmentMap(environmentMap, nullptr);
+    
+    if (irradianceSHBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, irradianceSHBuffer, nullptr);
+        irradianceSHBuffer = VK_NULL_HANDLE;
+    }
+    if (irradianceSHMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, irradianceSHMemory, nullptr);
+        irradianceSHMemory = VK_NULL_HANDLE;
+    }
+    
     // Reset textures (smart pointers will handle resource cleanup)
     environmentMap = nullptr;
     irradianceMap = nullptr;
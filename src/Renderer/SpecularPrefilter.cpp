@@ -0,0 +1,364 @@
+#include "Renderer/SpecularPrefilter.h"
+#include "Renderer/SphericalHarmonics.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MI_PREFILTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MiEngine {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float MAX_RADIANCE = 100.0f;      // Same clamp as CubemapData::sample
+constexpr uint32_t MIN_SAMPLES = 4;
+
+// ----------------------------------------------------------------------------
+// One float for each of four texels (masks have all bits set where true)
+// ----------------------------------------------------------------------------
+
+#ifdef MI_PREFILTER_SSE2
+struct Lanes { __m128 v; };
+inline Lanes lanes(float s) { return { _mm_set1_ps(s) }; }
+inline Lanes loadLanes(const float* p) { return { _mm_loadu_ps(p) }; }
+inline void storeLanes(float* p, Lanes a) { _mm_storeu_ps(p, a.v); }
+inline Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Lanes operator/(Lanes a, Lanes b) { return { _mm_div_ps(a.v, b.v) }; }
+inline Lanes lanesAbs(Lanes a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline Lanes greaterEqual(Lanes a, Lanes b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline Lanes greater(Lanes a, Lanes b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline Lanes maskAnd(Lanes a, Lanes b) { return { _mm_and_ps(a.v, b.v) }; }
+inline Lanes select(Lanes mask, Lanes a, Lanes b) {
+    return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+}
+#else
+struct Lanes { float v[4]; };
+template <typename Op>
+inline Lanes mapLanes(Lanes a, Lanes b, Op op) {
+    Lanes r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+inline Lanes lanes(float s) { return { { s, s, s, s } }; }
+inline Lanes loadLanes(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void storeLanes(float* p, Lanes a) { std::memcpy(p, a.v, sizeof(a.v)); }
+inline Lanes operator+(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x + y; }); }
+inline Lanes operator-(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x - y; }); }
+inline Lanes operator*(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x * y; }); }
+inline Lanes operator/(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x / y; }); }
+inline Lanes lanesAbs(Lanes a) { return mapLanes(a, a, [](float x, float) { return std::fabs(x); }); }
+inline Lanes greaterEqual(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x >= y ? 1.0f : 0.0f; }); }
+inline Lanes greater(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x > y ? 1.0f : 0.0f; }); }
+inline Lanes maskAnd(Lanes a, Lanes b) { return a * b; }
+inline Lanes select(Lanes mask, Lanes a, Lanes b) {
+    Lanes r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+    }
+    return r;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// One RGBA texel in a vector register
+// ----------------------------------------------------------------------------
+
+#ifdef MI_PREFILTER_SSE2
+using Vec4 = __m128;
+inline Vec4 vzero() { return _mm_setzero_ps(); }
+inline Vec4 vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 vmadd(Vec4 acc, Vec4 v, float w) { return _mm_add_ps(acc, _mm_mul_ps(v, _mm_set1_ps(w))); }
+inline Vec4 vmin(Vec4 v, float limit) { return _mm_min_ps(v, _mm_set1_ps(limit)); }
+#else
+struct Vec4 { float v[4]; };
+inline Vec4 vzero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+inline Vec4 vload(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void vstore(float* p, Vec4 v) { std::memcpy(p, v.v, sizeof(v.v)); }
+inline Vec4 vmadd(Vec4 acc, Vec4 v, float w) {
+    for (int i = 0; i < 4; ++i) {
+        acc.v[i] += v.v[i] * w;
+    }
+    return acc;
+}
+inline Vec4 vmin(Vec4 v, float limit) {
+    for (int i = 0; i < 4; ++i) {
+        v.v[i] = std::min(v.v[i], limit);
+    }
+    return v;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Sampling helpers
+// ----------------------------------------------------------------------------
+
+float radicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10f;
+}
+
+// A source cubemap chain in the IBL cache layout
+struct SourceChain {
+    const float* data = nullptr;
+    uint32_t mipLevels = 0;
+    std::vector<size_t> levelOffsets;
+    std::vector<uint32_t> levelSizes;
+
+    const float* face(uint32_t mip, uint32_t faceIndex) const {
+        return data + levelOffsets[mip] + static_cast<size_t>(faceIndex) * levelSizes[mip] * levelSizes[mip] * 4;
+    }
+};
+
+// Bilinear fetch at s, t in [0, 1], clamped to the face
+Vec4 fetchBilinear(const float* face, uint32_t size, float s, float t) {
+    float maxCoord = static_cast<float>(size - 1);
+    float fx = std::clamp(s * size - 0.5f, 0.0f, maxCoord);
+    float fy = std::clamp(t * size - 0.5f, 0.0f, maxCoord);
+    uint32_t x0 = static_cast<uint32_t>(fx);
+    uint32_t y0 = static_cast<uint32_t>(fy);
+    uint32_t x1 = std::min(x0 + 1, size - 1);
+    uint32_t y1 = std::min(y0 + 1, size - 1);
+    float dx = fx - x0;
+    float dy = fy - y0;
+
+    const float* row0 = face + static_cast<size_t>(y0) * size * 4;
+    const float* row1 = face + static_cast<size_t>(y1) * size * 4;
+    Vec4 c = vzero();
+    c = vmadd(c, vload(row0 + x0 * 4), (1.0f - dx) * (1.0f - dy));
+    c = vmadd(c, vload(row0 + x1 * 4), dx * (1.0f - dy));
+    c = vmadd(c, vload(row1 + x0 * 4), (1.0f - dx) * dy);
+    c = vmadd(c, vload(row1 + x1 * 4), dx * dy);
+    return c;
+}
+
+// Filter texels [x, x + count) of one row, count <= 4
+void filterTexels(const SourceChain& source, const PrefilterSampleTable& table,
+                  uint32_t face, uint32_t y, uint32_t x, uint32_t count, uint32_t size, float* out) {
+    // Per-texel tangent frame around N (= V)
+    alignas(16) float nx[4], ny[4], nz[4], tx[4], ty[4], tz[4], bx[4], by[4], bz[4];
+    for (uint32_t lane = 0; lane < 4; ++lane) {
+        uint32_t texel = x + std::min(lane, count - 1);
+        float u = 2.0f * (texel + 0.5f) / size - 1.0f;
+        float v = 2.0f * (y + 0.5f) / size - 1.0f;
+        glm::vec3 n = SphericalHarmonics::faceDirection(face, u, v);
+        nx[lane] = n.x;
+        ny[lane] = n.y;
+        nz[lane] = n.z;
+
+        // tangent = normalize(cross(up, N)), up = +Z unless N is close to it
+        float t0, t1, t2;
+        if (std::fabs(nz[lane]) < 0.999f) {
+            t0 = -ny[lane]; t1 = nx[lane]; t2 = 0.0f;
+        } else {
+            t0 = 0.0f; t1 = -nz[lane]; t2 = ny[lane];
+        }
+        float invLength = 1.0f / std::sqrt(t0 * t0 + t1 * t1 + t2 * t2);
+        tx[lane] = t0 * invLength;
+        ty[lane] = t1 * invLength;
+        tz[lane] = t2 * invLength;
+        bx[lane] = ny[lane] * tz[lane] - nz[lane] * ty[lane];
+        by[lane] = nz[lane] * tx[lane] - nx[lane] * tz[lane];
+        bz[lane] = nx[lane] * ty[lane] - ny[lane] * tx[lane];
+    }
+
+    const Lanes Nx = loadLanes(nx), Ny = loadLanes(ny), Nz = loadLanes(nz);
+    const Lanes Tx = loadLanes(tx), Ty = loadLanes(ty), Tz = loadLanes(tz);
+    const Lanes Bx = loadLanes(bx), By = loadLanes(by), Bz = loadLanes(bz);
+    const Lanes zero = lanes(0.0f);
+    const Lanes half = lanes(0.5f);
+
+    Vec4 accum[4] = { vzero(), vzero(), vzero(), vzero() };
+    alignas(16) float faceIndex[4], sCoord[4], tCoord[4];
+    const uint32_t maxMip = source.mipLevels - 1;
+
+    for (size_t i = 0; i < table.weight.size(); ++i) {
+        // Rotate the sample into each texel's frame
+        Lanes sx = lanes(table.x[i]), sy = lanes(table.y[i]), sz = lanes(table.z[i]);
+        Lanes Lx = Tx * sx + Bx * sy + Nx * sz;
+        Lanes Ly = Ty * sx + By * sy + Ny * sz;
+        Lanes Lz = Tz * sx + Bz * sy + Nz * sz;
+
+        // Cube face and face coordinates
+        Lanes ax = lanesAbs(Lx), ay = lanesAbs(Ly), az = lanesAbs(Lz);
+        Lanes xMajor = maskAnd(greaterEqual(ax, ay), greaterEqual(ax, az));
+        Lanes yMajor = greaterEqual(ay, az);
+        Lanes posX = greater(Lx, zero), posY = greater(Ly, zero), posZ = greater(Lz, zero);
+        Lanes negLx = zero - Lx, negLy = zero - Ly, negLz = zero - Lz;
+
+        Lanes major = select(xMajor, ax, select(yMajor, ay, az));
+        Lanes uNum = select(xMajor, select(posX, negLz, Lz), select(yMajor, Lx, select(posZ, Lx, negLx)));
+        Lanes vNum = select(xMajor, negLy, select(yMajor, select(posY, Lz, negLz), negLy));
+        Lanes faces = select(xMajor, select(posX, lanes(0.0f), lanes(1.0f)),
+                             select(yMajor, select(posY, lanes(2.0f), lanes(3.0f)),
+                                    select(posZ, lanes(4.0f), lanes(5.0f))));
+
+        storeLanes(faceIndex, faces);
+        storeLanes(sCoord, uNum / major * half + half);
+        storeLanes(tCoord, vNum / major * half + half);
+
+        // Trilinear between the two source mips around the sample's lod
+        float lod = table.lod[i];
+        uint32_t mip0 = std::min(static_cast<uint32_t>(lod), maxMip);
+        uint32_t mip1 = std::min(mip0 + 1, maxMip);
+        float frac = mip0 == mip1 ? 0.0f : lod - mip0;
+        float weight = table.weight[i];
+
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            uint32_t f = static_cast<uint32_t>(faceIndex[lane]);
+            Vec4 color = fetchBilinear(source.face(mip0, f), source.levelSizes[mip0], sCoord[lane], tCoord[lane]);
+            if (frac > 0.0f) {
+                Vec4 upper = fetchBilinear(source.face(mip1, f), source.levelSizes[mip1], sCoord[lane], tCoord[lane]);
+                color = vmadd(vmadd(vzero(), color, 1.0f - frac), upper, frac);
+            }
+            accum[lane] = vmadd(accum[lane], vmin(color, MAX_RADIANCE), weight);
+        }
+    }
+
+    for (uint32_t lane = 0; lane < count; ++lane) {
+        vstore(out + lane * 4, accum[lane]);
+        out[lane * 4 + 3] = 1.0f;
+    }
+}
+
+} // anonymous namespace
+
+uint32_t SpecularPrefilter::getSampleCount(const PrefilterSettings& settings, uint32_t mip) {
+    if (mip == 0) {
+        return 1;
+    }
+    uint32_t count = settings.baseSamples * (mip + 1);
+    return std::max(count / std::max(settings.sampleDivisor, 1u), std::min(count, MIN_SAMPLES));
+}
+
+size_t SpecularPrefilter::getChainFloatCount(uint32_t faceSize, uint32_t mipLevels) {
+    size_t total = 0;
+    for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+        size_t size = std::max(faceSize >> mip, 1u);
+        total += size * size * 4 * 6;
+    }
+    return total;
+}
+
+PrefilterSampleTable SpecularPrefilter::buildSampleTable(float roughness, uint32_t sampleCount,
+                                                         uint32_t sourceFaceSize, uint32_t sourceMipLevels,
+                                                         uint32_t outputFaceSize) {
+    PrefilterSampleTable table;
+    table.roughness = roughness;
+
+    // The mirror level reads the source mip matching its own resolution
+    const float maxLod = static_cast<float>(std::max(sourceMipLevels, 1u) - 1);
+    const float mirrorLod = std::clamp(std::log2(static_cast<float>(sourceFaceSize) / std::max(outputFaceSize, 1u)),
+                                       0.0f, maxLod);
+
+    auto addSample = [&table](float x, float y, float z, float weight, float lod) {
+        table.x.push_back(x);
+        table.y.push_back(y);
+        table.z.push_back(z);
+        table.weight.push_back(weight);
+        table.lod.push_back(lod);
+    };
+
+    if (roughness <= 0.0f || sampleCount <= 1) {
+        addSample(0.0f, 0.0f, 1.0f, 1.0f, mirrorLod);
+        return table;
+    }
+
+    const float alpha = roughness * roughness;
+    const float alpha2 = alpha * alpha;
+    const float texelSolidAngle = 4.0f * PI / (6.0f * sourceFaceSize * sourceFaceSize);
+    float totalWeight = 0.0f;
+
+    for (uint32_t i = 0; i < sampleCount; ++i) {
+        // Hammersley point -> GGX half vector around +Z
+        float phi = 2.0f * PI * (static_cast<float>(i) / sampleCount);
+        float xi = radicalInverse(i);
+        float cosTheta = std::sqrt((1.0f - xi) / (1.0f + (alpha2 - 1.0f) * xi));
+        float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+        float hx = std::cos(phi) * sinTheta;
+        float hy = std::sin(phi) * sinTheta;
+
+        // Reflect V = +Z about H
+        float lx = 2.0f * cosTheta * hx;
+        float ly = 2.0f * cosTheta * hy;
+        float lz = 2.0f * cosTheta * cosTheta - 1.0f;
+        if (lz <= 0.0f) {
+            continue;
+        }
+
+        // pdf(L) = D * NdotH / (4 * VdotH) = D / 4 with N = V
+        float d = cosTheta * cosTheta * (alpha2 - 1.0f) + 1.0f;
+        float pdf = alpha2 / (PI * d * d) * 0.25f;
+        float sampleSolidAngle = 1.0f / (sampleCount * pdf + 0.0001f);
+        float lod = std::clamp(0.5f * std::log2(sampleSolidAngle / texelSolidAngle), 0.0f, maxLod);
+
+        addSample(lx, ly, lz, lz, lod);
+        totalWeight += lz;
+    }
+
+    if (totalWeight <= 0.0f) {
+        table = PrefilterSampleTable();
+        table.roughness = roughness;
+        addSample(0.0f, 0.0f, 1.0f, 1.0f, mirrorLod);
+        return table;
+    }
+    for (float& weight : table.weight) {
+        weight /= totalWeight;
+    }
+    return table;
+}
+
+std::vector<float> SpecularPrefilter::prefilter(const float* source, uint32_t sourceFaceSize, uint32_t sourceMipLevels,
+                                                const PrefilterSettings& settings) {
+    std::vector<float> output(getChainFloatCount(settings.faceSize, settings.mipLevels));
+    if (!source || sourceFaceSize == 0 || sourceMipLevels == 0) {
+        return output;
+    }
+
+    SourceChain chain;
+    chain.data = source;
+    chain.mipLevels = sourceMipLevels;
+    size_t offset = 0;
+    for (uint32_t mip = 0; mip < sourceMipLevels; ++mip) {
+        uint32_t size = std::max(sourceFaceSize >> mip, 1u);
+        chain.levelOffsets.push_back(offset);
+        chain.levelSizes.push_back(size);
+        offset += static_cast<size_t>(size) * size * 4 * 6;
+    }
+
+    size_t outputOffset = 0;
+    for (uint32_t mip = 0; mip < settings.mipLevels; ++mip) {
+        uint32_t size = std::max(settings.faceSize >> mip, 1u);
+        float roughness = settings.mipLevels > 1 ? static_cast<float>(mip) / (settings.mipLevels - 1) : 0.0f;
+        PrefilterSampleTable table = buildSampleTable(roughness, getSampleCount(settings, mip),
+                                                      sourceFaceSize, sourceMipLevels, size);
+
+        float* mipData = output.data() + outputOffset;
+        ThreadPool::getInstance().parallelFor(static_cast<size_t>(size) * 6, [&](size_t row) {
+            uint32_t face = static_cast<uint32_t>(row / size);
+            uint32_t y = static_cast<uint32_t>(row % size);
+            float* out = mipData + row * size * 4;
+            for (uint32_t x = 0; x < size; x += 4) {
+                filterTexels(chain, table, face, y, x, std::min(4u, size - x), size, out + x * 4);
+            }
+        });
+
+        outputOffset += static_cast<size_t>(size) * size * 4 * 6;
+    }
+    return output;
+}
+
+} // namespace MiEngine
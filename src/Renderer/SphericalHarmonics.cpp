@@ -0,0 +1,154 @@
+#include "Renderer/SphericalHarmonics.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MiEngine {
+
+namespace {
+
+constexpr float PI = 3.14159265358979323846f;
+
+// Same limit CubemapData::sample applies, so a visible sun disc cannot blow up the ringing
+constexpr float MAX_RADIANCE = 100.0f;
+
+} // anonymous namespace
+
+std::array<float, 9> SphericalHarmonics::evaluateBasis(const glm::vec3& d) {
+    return {
+        0.282095f,
+        0.488603f * d.y,
+        0.488603f * d.z,
+        0.488603f * d.x,
+        1.092548f * d.x * d.y,
+        1.092548f * d.y * d.z,
+        0.315392f * (3.0f * d.z * d.z - 1.0f),
+        1.092548f * d.x * d.z,
+        0.546274f * (d.x * d.x - d.y * d.y)
+    };
+}
+
+glm::vec3 SphericalHarmonics::faceDirection(uint32_t face, float u, float v) {
+    glm::vec3 direction;
+    switch (face) {
+        case 0: direction = glm::vec3(1.0f, -v, -u); break;
+        case 1: direction = glm::vec3(-1.0f, -v, u); break;
+        case 2: direction = glm::vec3(u, 1.0f, v); break;
+        case 3: direction = glm::vec3(u, -1.0f, -v); break;
+        case 4: direction = glm::vec3(u, -v, 1.0f); break;
+        default: direction = glm::vec3(-u, -v, -1.0f); break;
+    }
+    return glm::normalize(direction);
+}
+
+SHL2 SphericalHarmonics::projectCubemap(const float* faces, uint32_t faceSize) {
+    SHL2 result;
+    if (!faces || faceSize == 0) {
+        return result;
+    }
+
+    // One partial sum per row keeps the reduction deterministic
+    const uint32_t rowCount = faceSize * 6;
+    std::vector<SHL2> rowSums(rowCount);
+    std::vector<float> rowWeights(rowCount, 0.0f);
+    const float texelSize = 2.0f / faceSize;
+
+    ThreadPool::getInstance().parallelFor(rowCount, [&](size_t row) {
+        uint32_t face = static_cast<uint32_t>(row / faceSize);
+        uint32_t y = static_cast<uint32_t>(row % faceSize);
+        float v = (y + 0.5f) * texelSize - 1.0f;
+        const float* texel = faces + row * faceSize * 4;
+
+        SHL2& sum = rowSums[row];
+        float weightSum = 0.0f;
+        for (uint32_t x = 0; x < faceSize; ++x, texel += 4) {
+            float u = (x + 0.5f) * texelSize - 1.0f;
+
+            // Solid angle of the texel: dA / (1 + u^2 + v^2)^(3/2)
+            float lengthSq = 1.0f + u * u + v * v;
+            float weight = texelSize * texelSize / (lengthSq * std::sqrt(lengthSq));
+
+            glm::vec3 radiance(std::clamp(texel[0], 0.0f, MAX_RADIANCE),
+                               std::clamp(texel[1], 0.0f, MAX_RADIANCE),
+                               std::clamp(texel[2], 0.0f, MAX_RADIANCE));
+            std::array<float, 9> basis = evaluateBasis(faceDirection(face, u, v));
+            for (uint32_t i = 0; i < 9; ++i) {
+                sum.coefficients[i] += radiance * (basis[i] * weight);
+            }
+            weightSum += weight;
+        }
+        rowWeights[row] = weightSum;
+    }, 8);
+
+    float totalWeight = 0.0f;
+    for (uint32_t row = 0; row < rowCount; ++row) {
+        for (uint32_t i = 0; i < 9; ++i) {
+            result.coefficients[i] += rowSums[row].coefficients[i];
+        }
+        totalWeight += rowWeights[row];
+    }
+
+    // The per-texel solid angles are approximate; rescale so the sphere integrates to 4 PI
+    float normalization = 4.0f * PI / totalWeight;
+    for (auto& coefficient : result.coefficients) {
+        coefficient *= normalization;
+    }
+    return result;
+}
+
+SHL2 SphericalHarmonics::convolveIrradiance(const SHL2& radiance) {
+    // Clamped cosine lobe per band (PI, 2PI/3, PI/4), divided by PI
+    static const float bandScale[9] = {
+        1.0f,
+        2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+        0.25f, 0.25f, 0.25f, 0.25f, 0.25f
+    };
+
+    SHL2 irradiance;
+    for (uint32_t i = 0; i < 9; ++i) {
+        irradiance.coefficients[i] = radiance.coefficients[i] * bandScale[i];
+    }
+    return irradiance;
+}
+
+glm::vec3 SphericalHarmonics::evaluate(const SHL2& sh, const glm::vec3& direction) {
+    std::array<float, 9> basis = evaluateBasis(direction);
+    glm::vec3 result(0.0f);
+    for (uint32_t i = 0; i < 9; ++i) {
+        result += sh.coefficients[i] * basis[i];
+    }
+    return glm::max(result, glm::vec3(0.0f));
+}
+
+std::vector<float> SphericalHarmonics::rasterizeCubemap(const SHL2& sh, uint32_t faceSize) {
+    std::vector<float> faces(static_cast<size_t>(faceSize) * faceSize * 4 * 6);
+    const uint32_t rowCount = faceSize * 6;
+
+    ThreadPool::getInstance().parallelFor(rowCount, [&](size_t row) {
+        uint32_t face = static_cast<uint32_t>(row / faceSize);
+        uint32_t y = static_cast<uint32_t>(row % faceSize);
+        float v = 2.0f * (y + 0.5f) / faceSize - 1.0f;
+        float* texel = faces.data() + row * faceSize * 4;
+
+        for (uint32_t x = 0; x < faceSize; ++x, texel += 4) {
+            float u = 2.0f * (x + 0.5f) / faceSize - 1.0f;
+            glm::vec3 value = evaluate(sh, faceDirection(face, u, v));
+            texel[0] = value.x;
+            texel[1] = value.y;
+            texel[2] = value.z;
+            texel[3] = 1.0f;
+        }
+    }, 16);
+    return faces;
+}
+
+IrradianceSHUniform SphericalHarmonics::toUniform(const SHL2& irradiance, bool enabled) {
+    IrradianceSHUniform uniform{};
+    for (uint32_t i = 0; i < 9; ++i) {
+        uniform.coefficients[i] = glm::vec4(irradiance.coefficients[i], 0.0f);
+    }
+    uniform.enabled = enabled ? 1 : 0;
+    return uniform;
+}
+
+} // namespace MiEngine
@@ -1,6 +1,14 @@
 ﻿#include "Utils/TextureUtils.h"
+#include "texture/MipGenerator.h"
+#include "Renderer/SpecularPrefilter.h"
+#include "Renderer/EquirectConverter.h"
+#include "Renderer/BRDFIntegrator.h"
+#include "core/ThreadPool.h"
+#include "project/ProjectManager.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <stb_image.h>
@@ -16,56 +24,31 @@
 namespace fs = std::filesystem;
 
 
-struct CacheHeader {
-    uint32_t width;
-    uint32_t height;
-    uint32_t mipLevels;
-    uint32_t faceCount;
-    size_t dataSize;
-};
-
-// Derive a cache filename based on the input name and type
-std::string getCachePath(const std::string& key, const std::string& suffix) {
-    if (!fs::exists("cache")) {
-        fs::create_directory("cache");
-    }
-    // Simple hash of the key to keep filenames clean
-    std::hash<std::string> hasher;
-    size_t hash = hasher(key);
-    return "cache/" + std::to_string(hash) + "_" + suffix + ".bin";
+// Contents hash of an HDR for its IBL cache keys (0 = no file, don't cache)
+uint64_t hashHDR(const std::string& hdrPath) {
+    return hdrPath.empty() ? 0 : MiEngine::IBLCache::hashFile(hdrPath);
 }
 
-bool saveTextureCache(const std::string& filepath, const std::vector<float>& data, uint32_t w, uint32_t h, uint32_t mips) {
-    std::ofstream file(filepath, std::ios::binary);
-    if (!file.is_open()) return false;
-
-    CacheHeader header = {w, h, mips, 6, data.size() * sizeof(float)};
-    file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
-    file.write(reinterpret_cast<const char*>(data.data()), header.dataSize);
-    return true;
+// IBL cache identity of a cubemap generated under config from the HDR with hashHDR() == sourceHash
+MiEngine::IBLCacheKey makeIBLCacheKey(MiEngine::IBLCacheKind kind, uint64_t sourceHash,
+                                      const TextureUtils::IBLConfig& config, uint32_t faceSize, uint32_t mipLevels) {
+    MiEngine::IBLCacheKey key;
+    key.kind = kind;
+    key.sourceHash = sourceHash;
+    key.faceSize = faceSize;
+    key.mipLevels = mipLevels;
+
+    // The prefilter map is filtered from the environment map, so it depends on both
+    key.settings.environmentMapSize = config.environmentMapSize;
+    key.settings.environmentMipFilter = static_cast<uint32_t>(config.environmentMipFilter);
+    if (kind == MiEngine::IBLCacheKind::PrefilterMap) {
+        key.settings.prefilterMapSize = config.prefilterMapSize;
+        key.settings.prefilterMipLevels = config.prefilterMipLevels;
+        key.settings.prefilterBaseSamples = config.prefilterBaseSamples;
+    }
+    return key;
 }
 
-bool loadTextureCache(const std::string& filepath, std::vector<float>& outData, uint32_t& w, uint32_t& h, uint32_t& mips) {
-    if (!fs::exists(filepath)) return false;
-
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) return false;
-
-    CacheHeader header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader));
-
-    // Sanity check
-    if (header.width == 0 || header.height == 0 || header.dataSize == 0) return false;
-
-    w = header.width;
-    h = header.height;
-    mips = header.mipLevels;
-
-    outData.resize(header.dataSize / sizeof(float));
-    file.read(reinterpret_cast<char*>(outData.data()), header.dataSize);
-
-    return true;
-}
 TextureUtils::IBLConfig TextureUtils::iblConfig;  
 
 static std::shared_ptr<CubemapData> g_currentEnvironmentData = nullptr;
@@ -393,10 +376,13 @@ std::shared_ptr<CubemapData> TextureUtils::readCubemapFromGPU(
     return cubemapData;
 }
 
-// Cache environment map data
+// Cache environment map data (nullptr data drops the entry of a released map)
 void TextureUtils::cacheEnvironmentMap(std::shared_ptr<Texture> environmentMap, std::shared_ptr<CubemapData> data) {
-    if (environmentMap && data) {
+    if (!environmentMap) return;
+    if (data) {
         g_cubemapCache[environmentMap.get()] = data;
+    } else {
+        g_cubemapCache.erase(environmentMap.get());
     }
 }
 
@@ -448,83 +434,6 @@ glm::vec3 sampleCubemapDirection(const glm::vec3& direction) {
 void TextureUtils::setCurrentEnvironmentData(std::shared_ptr<CubemapData> data) {
     g_currentEnvironmentData = data;
 }
-// Van Der Corput sequence for quasi-random sampling
-float RadicalInverse_VdC(uint32_t bits) {
-    bits = (bits << 16u) | (bits >> 16u);
-    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
-    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
-    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
-    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
-    return float(bits) * 2.3283064365386963e-10f; // / 0x100000000
-}
-
-// Hammersley sequence for quasi-random 2D sampling
-glm::vec2 Hammersley(uint32_t i, uint32_t N) {
-    return glm::vec2(float(i) / float(N), RadicalInverse_VdC(i));
-}
-
-// GGX Normal Distribution Function
-float DistributionGGX(glm::vec3 N, glm::vec3 H, float roughness) {
-    float a = roughness * roughness;
-    float a2 = a * a;
-    float NdotH = std::max(glm::dot(N, H), 0.0f);
-    float NdotH2 = NdotH * NdotH;
-    
-    float num = a2;
-    float denom = (NdotH2 * (a2 - 1.0f) + 1.0f);
-    denom = glm::pi<float>() * denom * denom;
-    
-    return num / denom;
-}
-
-// Geometry function for IBL
-float GeometrySchlickGGX_IBL(float NdotV, float roughness) {
-    float a = roughness;
-    float k = (a * a) / 2.0f; // Note: Different k for IBL vs direct lighting
-    
-    float num = NdotV;
-    float denom = NdotV * (1.0f - k) + k;
-    
-    return num / denom;
-}
-
-float GeometrySmith_IBL(glm::vec3 N, glm::vec3 V, glm::vec3 L, float roughness) {
-    float NdotV = std::max(glm::dot(N, V), 0.0f);
-    float NdotL = std::max(glm::dot(N, L), 0.0f);
-    float ggx2 = GeometrySchlickGGX_IBL(NdotV, roughness);
-    float ggx1 = GeometrySchlickGGX_IBL(NdotL, roughness);
-    
-    return ggx1 * ggx2;
-}
-
-// Importance sample GGX distribution
-glm::vec3 ImportanceSampleGGX(glm::vec2 Xi, glm::vec3 N, float roughness) {
-    float a = roughness * roughness;
-    
-    float phi = 2.0f * glm::pi<float>() * Xi.x;
-    float cosTheta = std::sqrt((1.0f - Xi.y) / (1.0f + (a*a - 1.0f) * Xi.y));
-    float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
-    
-    // From spherical coordinates to cartesian coordinates (in tangent space)
-    glm::vec3 H;
-    H.x = std::cos(phi) * sinTheta;
-    H.y = std::sin(phi) * sinTheta;
-    H.z = cosTheta;
-    
-    // From tangent-space H to world-space sample vector
-    glm::vec3 up = std::abs(N.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
-    glm::vec3 tangent = glm::normalize(glm::cross(up, N));
-    glm::vec3 bitangent = glm::cross(N, tangent);
-    
-    glm::vec3 sampleVec = tangent * H.x + bitangent * H.y + N * H.z;
-    return glm::normalize(sampleVec);
-}
-
-// Replace the createPrefilterMap function with this complete implementation:
-// In TextureUtils.cpp, replace the face sampling loop in createPrefilterMap:
-
-// In TextureUtils.cpp, replace the face sampling loop in createPrefilterMap with this:
-
 
 std::shared_ptr<Texture> TextureUtils::createPrefilterMap(
     VkDevice device,
@@ -533,7 +442,8 @@ std::shared_ptr<Texture> TextureUtils::createPrefilterMap(
     VkQueue graphicsQueue,
     std::shared_ptr<Texture> environmentMap,
     const std::string& cacheKey,
-    const IBLConfig* customConfig)
+    const IBLConfig* customConfig,
+    std::future<std::vector<float>>* refinedData)
 {
     const IBLConfig& config = customConfig ? *customConfig : iblConfig;
     const uint32_t prefilterSize = config.prefilterMapSize;
@@ -541,23 +451,34 @@ std::shared_ptr<Texture> TextureUtils::createPrefilterMap(
 
     // Container for ALL data (all mips, all faces)
     std::vector<float> allMipData;
-    uint32_t cachedW, cachedH, cachedMips;
-    bool loadedFromCache = false;
-
-    // 1. Try to load from Cache
-    if (!cacheKey.empty()) {
-        std::string cachePath = getCachePath(cacheKey, "prefilter_" + std::to_string(prefilterSize));
-        if (loadTextureCache(cachePath, allMipData, cachedW, cachedH, cachedMips)) {
-            if (cachedW == prefilterSize && cachedMips == mipLevels) {
-                std::cout << "Loaded Prefilter Map from cache: " << cachePath << std::endl;
-                loadedFromCache = true;
-            } else {
-                allMipData.clear(); 
-            }
+
+    // 1. Try to load from Cache (cacheKey is the source HDR path)
+    const MiEngine::IBLCacheKey iblCacheKey = makeIBLCacheKey(MiEngine::IBLCacheKind::PrefilterMap, hashHDR(cacheKey),
+                                                              config, prefilterSize, mipLevels);
+    const fs::path cachePath = MiEngine::IBLCache::getCachePath(cacheKey, iblCacheKey.kind, prefilterSize);
+    const bool canCache = iblCacheKey.sourceHash != 0;
+
+    MiEngine::IBLCacheFile cacheFile;
+    bool loadedFromCache = canCache && MiEngine::IBLCache::open(cachePath, iblCacheKey, cacheFile);
+    if (loadedFromCache) {
+        std::cout << "Loaded Prefilter Map from cache: " << cachePath.string() << std::endl;
+    }
+
+    // 2. Filter on the CPU (the environment data is normally cached by IBLSystem already)
+    if (!loadedFromCache) {
+        auto envCubemapData = getCachedEnvironmentData(environmentMap);
+        if (!envCubemapData) {
+            envCubemapData = readCubemapFromGPU(device, physicalDevice, commandPool, graphicsQueue, environmentMap);
         }
+        if (!envCubemapData) {
+            std::cerr << "Prefilter map: failed to read the environment map" << std::endl;
+            return nullptr;
+        }
+
+        allMipData = filterPrefilterChain(envCubemapData, config, iblCacheKey, cachePath, refinedData);
     }
 
-    // 2. Create Vulkan Image
+    // 3. Create Vulkan Image
     VkImage prefilterImage;
     VkDeviceMemory prefilterMemory;
     VkFormat format = VK_FORMAT_R32G32B32A32_SFLOAT;
@@ -591,223 +512,19 @@ std::shared_ptr<Texture> TextureUtils::createPrefilterMap(
     if (vkAllocateMemory(device, &allocInfo, nullptr, &prefilterMemory) != VK_SUCCESS) return nullptr;
     vkBindImageMemory(device, prefilterImage, prefilterMemory, 0);
 
+    // 4. Upload every mip in one submission (cache hits decode straight into the staging buffer)
     transitionImageLayout(device, commandPool, graphicsQueue, prefilterImage, format,
                         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                         0, 6, 0, mipLevels);
 
-    // 3. Generate or Upload
-    if (loadedFromCache) {
-        // Upload cached data
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        createBuffer(device, physicalDevice, allMipData.size() * sizeof(float), 
-                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    stagingBuffer, stagingBufferMemory);
-
-        void* data;
-        vkMapMemory(device, stagingBufferMemory, 0, allMipData.size() * sizeof(float), 0, &data);
-        memcpy(data, allMipData.data(), allMipData.size() * sizeof(float));
-        vkUnmapMemory(device, stagingBufferMemory);
-
-        size_t currentBufferOffset = 0;
-        for (uint32_t mip = 0; mip < mipLevels; mip++) {
-            uint32_t mipSize = prefilterSize >> mip;
-            if (mipSize < 1) mipSize = 1;
-            size_t faceSize = mipSize * mipSize * 4 * sizeof(float);
-
-            for (uint32_t face = 0; face < 6; face++) {
-                VkBufferImageCopy region{};
-                region.bufferOffset = currentBufferOffset;
-                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                region.imageSubresource.mipLevel = mip;
-                region.imageSubresource.baseArrayLayer = face;
-                region.imageSubresource.layerCount = 1;
-                region.imageExtent = {mipSize, mipSize, 1};
-
-                VkCommandBufferAllocateInfo cmdAllocInfo{};
-                cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-                cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-                cmdAllocInfo.commandPool = commandPool;
-                cmdAllocInfo.commandBufferCount = 1;
-                VkCommandBuffer cmd;
-                vkAllocateCommandBuffers(device, &cmdAllocInfo, &cmd);
-                VkCommandBufferBeginInfo begin{};
-                begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-                begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-                vkBeginCommandBuffer(cmd, &begin);
-                vkCmdCopyBufferToImage(cmd, stagingBuffer, prefilterImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-                vkEndCommandBuffer(cmd);
-                VkSubmitInfo submit{};
-                submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submit.commandBufferCount = 1;
-                submit.pCommandBuffers = &cmd;
-                vkQueueSubmit(graphicsQueue, 1, &submit, VK_NULL_HANDLE);
-                vkQueueWaitIdle(graphicsQueue);
-                vkFreeCommandBuffers(device, commandPool, 1, &cmd);
-
-                currentBufferOffset += faceSize;
-            }
-        }
-        vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
-
-    } else {
-        // --- High Quality Generation Logic with Mip Filtering ---
-        std::cout << "Generating Prefilter Map (High Quality)..." << std::endl;
-
-        // Read source environment map (which has mips!)
-        auto envCubemapData = readCubemapFromGPU(device, physicalDevice, commandPool, graphicsQueue, environmentMap);
-        
-        for (uint32_t mip = 0; mip < mipLevels; mip++) {
-            uint32_t mipSize = prefilterSize >> mip;
-            if (mipSize < 1) mipSize = 1;
-            
-            // Linear roughness parameter
-            float roughness = static_cast<float>(mip) / static_cast<float>(mipLevels - 1);
-            
-            // High sample count for quality
-            uint32_t sampleCount = (mip == 0) ? 1 : 512 + (mip * 256);
-            
-            std::cout << "  Mip " << mip << " (Roughness: " << roughness << ", Samples: " << sampleCount << ")" << std::endl;
-
-            size_t faceFloatCount = mipSize * mipSize * 4;
-            std::vector<float> mipData(faceFloatCount * 6);
-
-            for (uint32_t face = 0; face < 6; face++) {
-                #pragma omp parallel for collapse(2)
-                for (uint32_t y = 0; y < mipSize; y++) {
-                    for (uint32_t x = 0; x < mipSize; x++) {
-                        float u = (2.0f * (x + 0.5f) / float(mipSize)) - 1.0f;
-                        float v = (2.0f * (y + 0.5f) / float(mipSize)) - 1.0f;
-                        
-                        glm::vec3 direction;
-                        switch (face) {
-                            case 0: direction = glm::normalize(glm::vec3( 1.0f, -v, -u)); break;
-                            case 1: direction = glm::normalize(glm::vec3(-1.0f, -v,  u)); break;
-                            case 2: direction = glm::normalize(glm::vec3( u,  1.0f,  v)); break;
-                            case 3: direction = glm::normalize(glm::vec3( u, -1.0f, -v)); break;
-                            case 4: direction = glm::normalize(glm::vec3( u, -v,  1.0f)); break;
-                            case 5: direction = glm::normalize(glm::vec3(-u, -v, -1.0f)); break;
-                        }
-                        
-                        glm::vec3 color(0.0f);
-                        
-                        if (mip == 0) {
-                            color = envCubemapData->sample(direction, 0);
-                        } else {
-                            glm::vec3 N = direction;
-                            glm::vec3 V = N;
-                            glm::vec3 totalColor(0.0f);
-                            float totalWeight = 0.0f;
-                            
-                            // Calculate source resolution to determine solid angles
-                            float envMapRes = static_cast<float>(envCubemapData->faceSize);
-                            
-                            for (uint32_t i = 0; i < sampleCount; ++i) {
-                                glm::vec2 Xi = Hammersley(i, sampleCount);
-                                glm::vec3 H = ImportanceSampleGGX(Xi, N, roughness);
-                                glm::vec3 L = glm::normalize(2.0f * glm::dot(V, H) * H - V);
-                                float NdotL = glm::max(glm::dot(N, L), 0.0f);
-                                
-                                if (NdotL > 0.0f) {
-                                    // --- FIX FOR WHITE DOTS (FILTERING) ---
-                                    // Calculate PDF and Solid Angle to determine which Mip of the *Source* to sample
-                                    float D = DistributionGGX(N, H, roughness);
-                                    float NdotH = std::max(glm::dot(N, H), 0.0f);
-                                    float HdotV = std::max(glm::dot(H, V), 0.0f);
-                                    float pdf = D * NdotH / (4.0f * HdotV) + 0.0001f; 
-
-                                    float saTexel = 4.0f * glm::pi<float>() / (6.0f * envMapRes * envMapRes);
-                                    float saSample = 1.0f / (float(sampleCount) * pdf + 0.0001f);
-
-                                    float mipLevel = 0.5f * std::log2(saSample / saTexel); 
-                                    mipLevel = std::clamp(mipLevel, 0.0f, float(envCubemapData->mipLevels - 1));
-
-                                    // Manual Trilinear Filtering
-                                    uint32_t mip1 = static_cast<uint32_t>(mipLevel);
-                                    uint32_t mip2 = std::min(mip1 + 1, envCubemapData->mipLevels - 1);
-                                    float frac = mipLevel - mip1;
-
-                                    glm::vec3 c1 = envCubemapData->sample(L, mip1);
-                                    glm::vec3 c2 = envCubemapData->sample(L, mip2);
-                                    glm::vec3 sampleColor = glm::mix(c1, c2, frac);
-
-                                    float weight = NdotL;
-                                    totalColor += sampleColor * weight;
-                                    totalWeight += weight;
-                                }
-                            }
-                            color = (totalWeight > 0.0f) ? (totalColor / totalWeight) : glm::vec3(0.0f);
-                        }
-                        
-                        size_t idx = (face * faceFloatCount) + ((y * mipSize + x) * 4);
-                        mipData[idx + 0] = color.r;
-                        mipData[idx + 1] = color.g;
-                        mipData[idx + 2] = color.b;
-                        mipData[idx + 3] = 1.0f;
-                    }
-                }
-            }
-
-            allMipData.insert(allMipData.end(), mipData.begin(), mipData.end());
-
-            // Upload this mip immediately
-            VkBuffer stagingBuffer;
-            VkDeviceMemory stagingBufferMemory;
-            createBuffer(device, physicalDevice, mipData.size() * sizeof(float),
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         stagingBuffer, stagingBufferMemory);
-            
-            void* data;
-            vkMapMemory(device, stagingBufferMemory, 0, mipData.size() * sizeof(float), 0, &data);
-            memcpy(data, mipData.data(), mipData.size() * sizeof(float));
-            vkUnmapMemory(device, stagingBufferMemory);
-
-            // Upload logic
-            size_t faceBytes = mipSize * mipSize * 4 * sizeof(float);
-            
-            VkCommandBufferAllocateInfo cmdAllocInfo{};
-            cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-            cmdAllocInfo.commandPool = commandPool;
-            cmdAllocInfo.commandBufferCount = 1;
-            VkCommandBuffer cmd;
-            vkAllocateCommandBuffers(device, &cmdAllocInfo, &cmd);
-            VkCommandBufferBeginInfo begin{};
-            begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-            begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-            vkBeginCommandBuffer(cmd, &begin);
-
-            for(int f=0; f<6; f++) {
-                VkBufferImageCopy region{};
-                region.bufferOffset = f * faceBytes; // Correct offset for this mip's buffer
-                region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                region.imageSubresource.mipLevel = mip;
-                region.imageSubresource.baseArrayLayer = f;
-                region.imageSubresource.layerCount = 1;
-                region.imageExtent = {mipSize, mipSize, 1};
-                vkCmdCopyBufferToImage(cmd, stagingBuffer, prefilterImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-            }
-            vkEndCommandBuffer(cmd);
-            VkSubmitInfo submit{};
-            submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submit.commandBufferCount = 1;
-            submit.pCommandBuffers = &cmd;
-            vkQueueSubmit(graphicsQueue, 1, &submit, VK_NULL_HANDLE);
-            vkQueueWaitIdle(graphicsQueue);
-            vkFreeCommandBuffers(device, commandPool, 1, &cmd);
-
-            vkDestroyBuffer(device, stagingBuffer, nullptr);
-            vkFreeMemory(device, stagingBufferMemory, nullptr);
-        } 
-
-        if (!cacheKey.empty()) {
-             std::string cachePath = getCachePath(cacheKey, "prefilter_" + std::to_string(prefilterSize));
-             saveTextureCache(cachePath, allMipData, prefilterSize, prefilterSize, mipLevels);
+    uploadCubemapChain(device, physicalDevice, commandPool, graphicsQueue, prefilterImage,
+                       prefilterSize, mipLevels, [&](float* staging) {
+        if (loadedFromCache) {
+            cacheFile.decode(staging);
+        } else {
+            memcpy(staging, allMipData.data(), allMipData.size() * sizeof(float));
         }
-    }
+    });
 
     transitionImageLayout(device, commandPool, graphicsQueue, prefilterImage, format,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
@@ -819,161 +536,413 @@ std::shared_ptr<Texture> TextureUtils::createPrefilterMap(
     return texture;
 }
 
+std::vector<float> TextureUtils::filterPrefilterChain(
+    const std::shared_ptr<CubemapData>& environment,
+    const IBLConfig& config,
+    const MiEngine::IBLCacheKey& cacheKey,
+    const fs::path& cachePath,
+    std::future<std::vector<float>>* refinedData)
+{
+    MiEngine::PrefilterSettings settings;
+    settings.faceSize = cacheKey.faceSize;
+    settings.mipLevels = cacheKey.mipLevels;
+    settings.baseSamples = config.prefilterBaseSamples;
+
+    const bool progressive = refinedData && config.prefilterPreviewDivisor > 1;
+    if (progressive) {
+        settings.sampleDivisor = config.prefilterPreviewDivisor;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::vector<float> chain = MiEngine::SpecularPrefilter::prefilter(environment->data.data(), environment->faceSize,
+                                                                      environment->mipLevels, settings);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << "Generated Prefilter Map " << (progressive ? "preview " : "") << "(" << settings.faceSize << "x"
+              << settings.faceSize << ", " << settings.mipLevels << " mips) in "
+              << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms" << std::endl;
+
+    const bool canCache = cacheKey.sourceHash != 0;
+    const MiEngine::IBLCacheEncoding encoding = config.cacheEncoding;
+    if (progressive) {
+        // Full sample counts on the ThreadPool; only the refined result is cached
+        settings.sampleDivisor = 1;
+        *refinedData = MiEngine::ThreadPool::getInstance().submit(
+            [environment, settings, canCache, cachePath, cacheKey, encoding]() {
+                auto refineStart = std::chrono::high_resolution_clock::now();
+                std::vector<float> refined = MiEngine::SpecularPrefilter::prefilter(
+                    environment->data.data(), environment->faceSize, environment->mipLevels, settings);
+                std::cout << "Refined Prefilter Map in "
+                          << std::chrono::duration<double, std::milli>(
+                                 std::chrono::high_resolution_clock::now() - refineStart).count()
+                          << " ms" << std::endl;
+
+                if (canCache) {
+                    MiEngine::IBLCache::save(cachePath, cacheKey, encoding, refined.data(), refined.size());
+                }
+                return refined;
+            });
+    } else if (canCache) {
+        MiEngine::IBLCache::save(cachePath, cacheKey, encoding, chain.data(), chain.size());
+    }
+    return chain;
+}
 
+// One region per face per mip, in the order the IBL cache layout packs them
+static void appendCubemapRegions(std::vector<VkBufferImageCopy>& regions, uint32_t faceSize, uint32_t mipLevels,
+                                 VkDeviceSize bufferOffset) {
+    for (uint32_t mip = 0; mip < mipLevels; mip++) {
+        uint32_t mipSize = std::max(faceSize >> mip, 1u);
+        for (uint32_t face = 0; face < 6; face++) {
+            VkBufferImageCopy region{};
+            region.bufferOffset = bufferOffset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = mip;
+            region.imageSubresource.baseArrayLayer = face;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = {mipSize, mipSize, 1};
+            regions.push_back(region);
 
-std::shared_ptr<Texture> TextureUtils::createBRDFLookUpTexture(
-    VkDevice device, 
+            bufferOffset += static_cast<VkDeviceSize>(mipSize) * mipSize * 4 * sizeof(float);
+        }
+    }
+}
+
+std::vector<std::shared_ptr<Texture>> TextureUtils::submitCubemapUploads(
+    VkDevice device,
     VkPhysicalDevice physicalDevice,
     VkCommandPool commandPool,
     VkQueue graphicsQueue,
-    uint32_t resolution)  // 0 means use config
+    const std::vector<CubemapUpload>& uploads,
+    UploadSubmission& submission)
 {
-    // 1. Determine Resolution
-    if (resolution == 0) {
-        resolution = iblConfig.brdfLutResolution;
-    }
-    
-    // Cap resolution for safety (optional, but good practice)
-    //TODO: uncap it 
-    const uint32_t maxResolution = 2048;
-    resolution = std::min(resolution, maxResolution);
-    
-    // 2. Prepare Memory for texture data (RGBA8)
-    // We store the final dithered 8-bit data in the cache, not the intermediate floats
-    std::vector<unsigned char> pixelData(resolution * resolution * 4);
-    size_t dataSize = pixelData.size();
+    const VkFormat format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    std::vector<std::shared_ptr<Texture>> textures(uploads.size());
+    std::vector<VkImage> images(uploads.size(), VK_NULL_HANDLE);
+    std::vector<VkDeviceMemory> memories(uploads.size(), VK_NULL_HANDLE);
+    std::vector<VkDeviceSize> offsets(uploads.size(), 0);
+
+    // Targets must match their chain; new cubemaps get an image now and a view once recorded
+    VkDeviceSize stagingSize = 0;
+    for (size_t i = 0; i < uploads.size(); i++) {
+        const CubemapUpload& upload = uploads[i];
+        if (!upload.data || upload.faceSize == 0 || upload.mipLevels == 0) continue;
+
+        if (upload.target) {
+            if (upload.target->getWidth() != upload.faceSize || upload.target->getMipLevels() != upload.mipLevels) {
+                std::cerr << "Cubemap upload: data does not match the " << upload.target->getWidth() << "x"
+                          << upload.target->getWidth() << " map with " << upload.target->getMipLevels()
+                          << " mips" << std::endl;
+                continue;
+            }
+            images[i] = upload.target->getImage();
+        } else {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent.width = upload.faceSize;
+            imageInfo.extent.height = upload.faceSize;
+            imageInfo.extent.depth = 1;
+            imageInfo.mipLevels = upload.mipLevels;
+            imageInfo.arrayLayers = 6;
+            imageInfo.format = format;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+
+            if (vkCreateImage(device, &imageInfo, nullptr, &images[i]) != VK_SUCCESS) {
+                images[i] = VK_NULL_HANDLE;
+                continue;
+            }
 
-    // 3. Check Disk Cache
-    std::string cacheDir = "cache";
-    std::string cachePath = cacheDir + "/brdf_lut_" + std::to_string(resolution) + ".bin";
-    bool loadedFromCache = false;
+            VkMemoryRequirements memRequirements;
+            vkGetImageMemoryRequirements(device, images[i], &memRequirements);
 
-    // Ensure cache directory exists
-    if (!fs::exists(cacheDir)) {
-        fs::create_directory(cacheDir);
-    }
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = memRequirements.size;
+            allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    if (fs::exists(cachePath)) {
-        std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
-        if (file.is_open()) {
-            std::streamsize fileSize = file.tellg();
-            if (static_cast<size_t>(fileSize) == dataSize) {
-                file.seekg(0, std::ios::beg);
-                file.read(reinterpret_cast<char*>(pixelData.data()), dataSize);
-                if (file.good()) {
-                    loadedFromCache = true;
-                    std::cout << "Loaded BRDF LUT from cache: " << cachePath << std::endl;
-                }
+            if (vkAllocateMemory(device, &allocInfo, nullptr, &memories[i]) != VK_SUCCESS) {
+                vkDestroyImage(device, images[i], nullptr);
+                images[i] = VK_NULL_HANDLE;
+                memories[i] = VK_NULL_HANDLE;
+                continue;
             }
-            file.close();
+            vkBindImageMemory(device, images[i], memories[i], 0);
         }
+
+        offsets[i] = stagingSize;
+        stagingSize += MiEngine::IBLCache::getTexelCount(upload.faceSize, upload.mipLevels) * 4 * sizeof(float);
     }
 
-    // 4. Generate if not cached
-    if (!loadedFromCache) {
-        std::cout << "Generating BRDF LUT (" << resolution << "x" << resolution << ")..." << std::endl;
-        
-        // Intermediate float buffer for calculation
-        std::vector<float> lutData(resolution * resolution * 4);
-        const uint32_t SAMPLE_COUNT = iblConfig.brdfLutSamples; // Uses full quality settings
-        
-        std::cout << "  Using " << SAMPLE_COUNT << " samples for BRDF integration" << std::endl;
-        
-        #pragma omp parallel for collapse(2)
-        for (uint32_t y = 0; y < resolution; y++) {
-            for (uint32_t x = 0; x < resolution; x++) {
-                float NdotV = float(x) / float(resolution - 1);
-                float roughness = float(y) / float(resolution - 1);
-
-                // Match shader min roughness
-                roughness = std::max(0.001f, std::min(1.0f, roughness));
-                NdotV = std::max(0.0f, std::min(1.0f, NdotV));
-
-                glm::vec3 V;
-                V.x = std::sqrt(std::max(0.0f, 1.0f - NdotV * NdotV));
-                V.y = 0.0f;
-                V.z = std::max(0.001f, NdotV); 
-
-                float A = 0.0f;
-                float B = 0.0f;
-
-                glm::vec3 N(0.0f, 0.0f, 1.0f);
-
-                // Use more samples for low roughness to get accurate results
-                uint32_t sampleCount = roughness < 0.1f ? SAMPLE_COUNT * 4 : SAMPLE_COUNT;
-
-                for (uint32_t i = 0; i < sampleCount; ++i) {
-                    glm::vec2 Xi = Hammersley(i, sampleCount);
-                    glm::vec3 H = ImportanceSampleGGX(Xi, N, roughness);
-                    glm::vec3 L = glm::normalize(2.0f * glm::dot(V, H) * H - V);
-
-                    float NdotL = std::max(L.z, 0.0f);
-                    float NdotH = std::max(H.z, 0.0f);
-                    float VdotH = std::max(glm::dot(V, H), 0.0f);
-
-                    if (NdotL > 0.0f && VdotH > 0.0f) {
-                        float G = GeometrySmith_IBL(N, V, L, roughness);
-                        
-                        // G_Vis = (G * VdotH) / (NdotH * NdotV)
-                        float actualNdotV = std::max(NdotV, 0.001f);
-                        float G_Vis = (G * VdotH) / (NdotH * actualNdotV);
-                        float Fc = pow(1.0f - VdotH, 5.0f);
-
-                        A += (1.0f - Fc) * G_Vis;
-                        B += Fc * G_Vis;
-                    }
-                }
+    if (stagingSize == 0) {
+        return textures;
+    }
 
-                A /= float(sampleCount);
-                B /= float(sampleCount);
+    createBuffer(device, physicalDevice, stagingSize,
+                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 submission.stagingBuffer, submission.stagingMemory);
 
-                // Clamp
-                A = std::max(0.0f, std::min(1.0f, A));
-                B = std::max(0.0f, std::min(1.0f, B));
+    void* mapped;
+    vkMapMemory(device, submission.stagingMemory, 0, stagingSize, 0, &mapped);
+    MiEngine::ThreadPool::getInstance().parallelFor(uploads.size(), [&](size_t i) {
+        if (images[i] == VK_NULL_HANDLE) return;
+        memcpy(static_cast<char*>(mapped) + offsets[i], uploads[i].data,
+               MiEngine::IBLCache::getTexelCount(uploads[i].faceSize, uploads[i].mipLevels) * 4 * sizeof(float));
+    });
+    vkUnmapMemory(device, submission.stagingMemory);
 
-                uint32_t idx = (y * resolution + x) * 4;
-                lutData[idx + 0] = A;
-                lutData[idx + 1] = B;
-                lutData[idx + 2] = 0.0f;
-                lutData[idx + 3] = 1.0f;
-            }
-        }
-        
-        // Convert to unsigned char with dithering
-        for (uint32_t y = 0; y < resolution; y++) {
-            for (uint32_t x = 0; x < resolution; x++) {
-                uint32_t idx = (y * resolution + x) * 4;
+    VkCommandBufferAllocateInfo cmdAllocInfo{};
+    cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdAllocInfo.commandPool = commandPool;
+    cmdAllocInfo.commandBufferCount = 1;
+    vkAllocateCommandBuffers(device, &cmdAllocInfo, &submission.commandBuffer);
+    VkCommandBufferBeginInfo begin{};
+    begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(submission.commandBuffer, &begin);
+
+    // Targets may still be sampled by frames in flight: wait for their reads, and make
+    // the new contents visible to anything submitted after this
+    std::vector<VkImageMemoryBarrier> toTransfer;
+    std::vector<VkImageMemoryBarrier> toShaderRead;
+    for (size_t i = 0; i < uploads.size(); i++) {
+        if (images[i] == VK_NULL_HANDLE) continue;
 
-                for (int c = 0; c < 4; c++) {
-                    float value = lutData[idx + c];
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = images[i];
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, uploads[i].mipLevels, 0, 6};
 
-                    // Ordered dithering (Bayer matrix 2x2) to prevent banding in 8-bit
-                    float threshold = ((x % 2) + (y % 2) * 2) / 4.0f - 0.375f;
-                    float dithered = value + threshold / 255.0f;
+        barrier.oldLayout = uploads[i].target ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcAccessMask = uploads[i].target ? VK_ACCESS_SHADER_READ_BIT : 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toTransfer.push_back(barrier);
 
-                    pixelData[idx + c] = static_cast<unsigned char>(std::max(0.0f, std::min(dithered * 255.0f, 255.0f)));
-                }
-            }
-        }
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        toShaderRead.push_back(barrier);
+    }
 
-        // 5. Save to Cache
-        std::cout << "Saving BRDF LUT to cache: " << cachePath << std::endl;
-        std::ofstream outFile(cachePath, std::ios::binary);
-        if (outFile.is_open()) {
-            outFile.write(reinterpret_cast<const char*>(pixelData.data()), dataSize);
-            outFile.close();
-        } else {
-            std::cerr << "Warning: Failed to save cache file " << cachePath << std::endl;
+    vkCmdPipelineBarrier(submission.commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(toTransfer.size()), toTransfer.data());
+
+    std::vector<VkBufferImageCopy> regions;
+    for (size_t i = 0; i < uploads.size(); i++) {
+        if (images[i] == VK_NULL_HANDLE) continue;
+
+        regions.clear();
+        appendCubemapRegions(regions, uploads[i].faceSize, uploads[i].mipLevels, offsets[i]);
+        vkCmdCopyBufferToImage(submission.commandBuffer, submission.stagingBuffer, images[i],
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()),
+                               regions.data());
+    }
+
+    vkCmdPipelineBarrier(submission.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(toShaderRead.size()), toShaderRead.data());
+    vkEndCommandBuffer(submission.commandBuffer);
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    vkCreateFence(device, &fenceInfo, nullptr, &submission.fence);
+
+    VkSubmitInfo submit{};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &submission.commandBuffer;
+    vkQueueSubmit(graphicsQueue, 1, &submit, submission.fence);
+
+    // Views and samplers don't need the contents, so new textures are usable as soon as the fence signals
+    for (size_t i = 0; i < uploads.size(); i++) {
+        if (images[i] == VK_NULL_HANDLE) continue;
+
+        if (uploads[i].target) {
+            textures[i] = uploads[i].target;
+            continue;
         }
+
+        auto texture = std::make_shared<Texture>(device, physicalDevice);
+        texture->initWithExistingImage(images[i], memories[i], format, uploads[i].faceSize, uploads[i].faceSize,
+                                       uploads[i].mipLevels, 6, VK_IMAGE_VIEW_TYPE_CUBE,
+                                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        textures[i] = texture;
     }
+    return textures;
+}
 
-    // 6. Create GPU Texture
-    auto texture = std::make_shared<Texture>(device, physicalDevice);
-    texture->createFromPixels(pixelData.data(), resolution, resolution, 4, commandPool, graphicsQueue);
+bool TextureUtils::isUploadComplete(VkDevice device, const UploadSubmission& submission) {
+    return submission.fence == VK_NULL_HANDLE || vkGetFenceStatus(device, submission.fence) == VK_SUCCESS;
+}
 
-    if (!loadedFromCache) {
-        std::cout << "BRDF LUT generated and cached successfully" << std::endl;
+void TextureUtils::releaseUpload(VkDevice device, VkCommandPool commandPool, UploadSubmission& submission) {
+    if (submission.fence != VK_NULL_HANDLE) {
+        vkWaitForFences(device, 1, &submission.fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(device, submission.fence, nullptr);
+    }
+    if (submission.commandBuffer != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(device, commandPool, 1, &submission.commandBuffer);
     }
+    if (submission.stagingBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, submission.stagingBuffer, nullptr);
+    }
+    if (submission.stagingMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(device, submission.stagingMemory, nullptr);
+    }
+    submission = {};
+}
+
+void TextureUtils::uploadCubemapChain(
+    VkDevice device,
+    VkPhysicalDevice physicalDevice,
+    VkCommandPool commandPool,
+    VkQueue graphicsQueue,
+    VkImage image,
+    uint32_t faceSize,
+    uint32_t mipLevels,
+    const std::function<void(float*)>& writeChain)
+{
+    VkDeviceSize bufferSize = MiEngine::IBLCache::getTexelCount(faceSize, mipLevels) * 4 * sizeof(float);
+
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+    createBuffer(device, physicalDevice, bufferSize,
+                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 stagingBuffer, stagingBufferMemory);
+
+    void* mapped;
+    vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &mapped);
+    writeChain(static_cast<float*>(mapped));
+    vkUnmapMemory(device, stagingBufferMemory);
+
+    std::vector<VkBufferImageCopy> regions;
+    regions.reserve(static_cast<size_t>(mipLevels) * 6);
+    appendCubemapRegions(regions, faceSize, mipLevels, 0);
+
+    VkCommandBufferAllocateInfo cmdAllocInfo{};
+    cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdAllocInfo.commandPool = commandPool;
+    cmdAllocInfo.commandBufferCount = 1;
+    VkCommandBuffer cmd;
+    vkAllocateCommandBuffers(device, &cmdAllocInfo, &cmd);
+    VkCommandBufferBeginInfo begin{};
+    begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(cmd, &begin);
+    vkCmdCopyBufferToImage(cmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
+    vkEndCommandBuffer(cmd);
+    VkSubmitInfo submit{};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &cmd;
+    vkQueueSubmit(graphicsQueue, 1, &submit, VK_NULL_HANDLE);
+    vkQueueWaitIdle(graphicsQueue);
+    vkFreeCommandBuffers(device, commandPool, 1, &cmd);
+
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingBufferMemory, nullptr);
+}
+
+
+
+std::shared_ptr<Texture> TextureUtils::createBRDFLookUpTexture(
+    VkDevice device, 
+    VkPhysicalDevice physicalDevice,
+    VkCommandPool commandPool,
+    VkQueue graphicsQueue,
+    uint32_t resolution)  // 0 means use config
+{
+    // 1. Determine Resolution
+    if (resolution == 0) {
+        resolution = iblConfig.brdfLutResolution;
+    }
+    
+    // Cap resolution for safety (optional, but good practice)
+    //TODO: uncap it 
+    const uint32_t maxResolution = 2048;
+    resolution = std::min(resolution, maxResolution);
+    
+    // 2. Load the RGBA16F LUT from the engine cache (integrated on first use for this resolution and
+    //    sample count); it doesn't depend on the project, so every project shares it
+    MiEngine::BRDFLutSettings settings;
+    settings.resolution = resolution;
+    settings.sampleCount = iblConfig.brdfLutSamples;
+    std::vector<uint16_t> texels =
+        MiEngine::BRDFIntegrator::load(settings, ProjectManager::getInstance().getEngineCachePath());
+    
+    // 3. Create GPU Texture (one mip: the LUT is sampled by NdotV/roughness, never minified)
+    VkImage lutImage;
+    VkDeviceMemory lutMemory;
+    VkFormat format = VK_FORMAT_R16G16B16A16_SFLOAT;
+    
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = resolution;
+    imageInfo.extent.height = resolution;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    
+    if (vkCreateImage(device, &imageInfo, nullptr, &lutImage) != VK_SUCCESS) return nullptr;
+    
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(device, lutImage, &memRequirements);
+    
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &lutMemory) != VK_SUCCESS) {
+        vkDestroyImage(device, lutImage, nullptr);
+        return nullptr;
+    }
+    vkBindImageMemory(device, lutImage, lutMemory, 0);
+    
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+    VkDeviceSize bufferSize = texels.size() * sizeof(uint16_t);
+    createBuffer(device, physicalDevice, bufferSize,
+                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 stagingBuffer, stagingBufferMemory);
+    
+    void* data;
+    vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+    memcpy(data, texels.data(), bufferSize);
+    vkUnmapMemory(device, stagingBufferMemory);
+    
+    transitionImageLayout(device, commandPool, graphicsQueue, lutImage, format,
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    copyBufferToImage(device, commandPool, graphicsQueue, stagingBuffer, lutImage, resolution, resolution);
+    transitionImageLayout(device, commandPool, graphicsQueue, lutImage, format,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingBufferMemory, nullptr);
+    
+    auto texture = std::make_shared<Texture>(device, physicalDevice);
+    texture->initWithExistingImage(lutImage, lutMemory, format, resolution, resolution,
+                                 1, 1, VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     return texture;
 }
 
@@ -1158,21 +1127,16 @@ std::shared_ptr<Texture> TextureUtils::createEnvironmentCubemap(
     const uint32_t cubemapSize = config.environmentMapSize;
     const uint32_t numMipLevels = static_cast<uint32_t>(std::floor(std::log2(cubemapSize))) + 1;
 
-    // 1. Check Cache
-    // We use the filename + size as the unique key
-    std::string cacheKey = hdrFilePath + "_" + std::to_string(cubemapSize);
-    // Hash the complex key to get a clean filename
-    std::string cachePath = getCachePath(std::to_string(std::hash<std::string>{}(cacheKey)), "env_cubemap");
-    
-    std::vector<float> faceData;
-    uint32_t cachedW, cachedH, cachedMips;
-    bool loadedFromCache = false;
+    // 1. Check Cache (validated against the HDR contents and the IBLConfig)
+    const MiEngine::IBLCacheKey iblCacheKey = makeIBLCacheKey(MiEngine::IBLCacheKind::EnvironmentMap,
+                                                              hashHDR(hdrFilePath), config, cubemapSize, numMipLevels);
+    const fs::path cachePath = MiEngine::IBLCache::getCachePath(hdrFilePath, iblCacheKey.kind, cubemapSize);
 
-    if (loadTextureCache(cachePath, faceData, cachedW, cachedH, cachedMips)) {
-        if (cachedW == cubemapSize) {
-            std::cout << "Loaded Environment Cubemap from cache: " << cachePath << std::endl;
-            loadedFromCache = true;
-        }
+    std::vector<float> faceData;
+    MiEngine::IBLCacheFile cacheFile;
+    bool loadedFromCache = MiEngine::IBLCache::open(cachePath, iblCacheKey, cacheFile);
+    if (loadedFromCache) {
+        std::cout << "Loaded Environment Cubemap from cache: " << cachePath.string() << std::endl;
     }
 
     // 2. Create Vulkan Image
@@ -1216,221 +1180,173 @@ std::shared_ptr<Texture> TextureUtils::createEnvironmentCubemap(
 
     // 3. Prepare Data (Load from Disk or Generate from HDR)
     if (!loadedFromCache) {
-        std::cout << "Generating Environment Cubemap (CPU)..." << std::endl;
-        int width, height, channels;
-        float* hdrData = stbi_loadf(hdrFilePath.c_str(), &width, &height, &channels, 0);
-        
-        if (!hdrData) {
-            std::cerr << "Failed to load HDR image: " << hdrFilePath << std::endl;
-            // Cleanup and return default... (omitted for brevity, assume success)
-            return nullptr; 
+        faceData = convertEquirectHDR(hdrFilePath, config, cubemapSize, numMipLevels);
+        if (faceData.empty()) {
+            vkDestroyImage(device, cubemapImage, nullptr);
+            vkFreeMemory(device, cubemapMemory, nullptr);
+            return nullptr;
         }
 
-        // Resize to hold 6 faces
-        faceData.resize(cubemapSize * cubemapSize * 4 * 6);
-
-        // Convert Equirectangular to Cubemap (The slow part)
-        // Parallelize for speed on first run
-        #pragma omp parallel for
-        for (int face = 0; face < 6; face++) {
-            // Calculate pointer offset for this face
-            float* facePtr = &faceData[face * (cubemapSize * cubemapSize * 4)];
-            equirectangularToCubemapFace(hdrData, width, height, channels, facePtr, cubemapSize, face);
-        }
-
-        stbi_image_free(hdrData);
-
         // Save to Cache
-        saveTextureCache(cachePath, faceData, cubemapSize, cubemapSize, 1); // We cache Mip 0 only
+        MiEngine::IBLCache::save(cachePath, iblCacheKey, config.cacheEncoding, faceData.data(), faceData.size());
     }
 
-    // 4. Upload to GPU
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    VkDeviceSize bufferSize = faceData.size() * sizeof(float);
-
-    createBuffer(device, physicalDevice, bufferSize, 
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 
-                stagingBuffer, stagingBufferMemory);
-
-    void* data;
-    vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, faceData.data(), bufferSize);
-    vkUnmapMemory(device, stagingBufferMemory);
-
-    // Transition to Transfer Dst
+    // 4. Upload to GPU (cache hits decode straight into the staging buffer)
     transitionImageLayout(device, commandPool, graphicsQueue, cubemapImage, format,
                         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                         0, 6, 0, numMipLevels);
 
-    // Copy all 6 faces (Mip 0)
-    VkCommandBufferAllocateInfo cmdAllocInfo{};
-    cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cmdAllocInfo.commandPool = commandPool;
-    cmdAllocInfo.commandBufferCount = 1;
-    VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(device, &cmdAllocInfo, &cmd);
-    
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
-
-    size_t faceSizeBytes = cubemapSize * cubemapSize * 4 * sizeof(float);
-    for (uint32_t face = 0; face < 6; face++) {
-        VkBufferImageCopy region{};
-        region.bufferOffset = face * faceSizeBytes;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = face;
-        region.imageSubresource.layerCount = 1;
-        region.imageExtent = {cubemapSize, cubemapSize, 1};
-        
-        vkCmdCopyBufferToImage(cmd, stagingBuffer, cubemapImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    }
-    vkEndCommandBuffer(cmd);
-    
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue);
-    vkFreeCommandBuffers(device, commandPool, 1, &cmd);
+    uploadCubemapChain(device, physicalDevice, commandPool, graphicsQueue, cubemapImage,
+                       cubemapSize, numMipLevels, [&](float* staging) {
+        if (loadedFromCache) {
+            cacheFile.decode(staging);
+        } else {
+            memcpy(staging, faceData.data(), faceData.size() * sizeof(float));
+        }
+    });
 
-    vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingBufferMemory, nullptr);
+    transitionImageLayout(device, commandPool, graphicsQueue, cubemapImage, format,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        0, 6, 0, numMipLevels);
 
-    // 5. Generate Mipmaps (GPU Blit) - This stays the same
-    // We reuse the logic you already had which transitions to SHADER_READ_ONLY at the end
-    {
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = commandPool;
-        allocInfo.commandBufferCount = 1;
+    auto texture = std::make_shared<Texture>(device, physicalDevice);
+    texture->initWithExistingImage(cubemapImage, cubemapMemory, format, cubemapSize, cubemapSize, 
+                                 numMipLevels, 6, VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    return texture;
+}
 
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
 
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+std::vector<float> TextureUtils::convertEquirectHDR(const std::string& hdrFilePath, const IBLConfig& config,
+                                                   uint32_t faceSize, uint32_t mipLevels) {
+    std::cout << "Generating Environment Cubemap (CPU)..." << std::endl;
+    int width, height, channels;
+    float* hdrData = stbi_loadf(hdrFilePath.c_str(), &width, &height, &channels, 0);
+    if (!hdrData) {
+        std::cerr << "Failed to load HDR image: " << hdrFilePath << std::endl;
+        return {};
+    }
 
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.image = cubemapImage;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.layerCount = 6;
-
-        int32_t mipWidth = cubemapSize;
-        int32_t mipHeight = cubemapSize;
-
-        for (uint32_t i = 1; i < numMipLevels; i++) {
-            barrier.subresourceRange.baseMipLevel = i - 1;
-            barrier.subresourceRange.levelCount = 1;
-            barrier.subresourceRange.baseArrayLayer = 0;
-            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-
-            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-            for (uint32_t face = 0; face < 6; face++) {
-                VkImageBlit blit{};
-                blit.srcOffsets[0] = {0, 0, 0};
-                blit.srcOffsets[1] = {mipWidth, mipHeight, 1};
-                blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                blit.srcSubresource.mipLevel = i - 1;
-                blit.srcSubresource.baseArrayLayer = face;
-                blit.srcSubresource.layerCount = 1;
-                blit.dstOffsets[0] = {0, 0, 0};
-                blit.dstOffsets[1] = {mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1};
-                blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                blit.dstSubresource.mipLevel = i;
-                blit.dstSubresource.baseArrayLayer = face;
-                blit.dstSubresource.layerCount = 1;
-
-                vkCmdBlitImage(commandBuffer, cubemapImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, cubemapImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
-            }
+    // Convert to the full mip chain on the CPU so the cache holds every level
+    // (direction tables are shared with the previous HDR of this size)
+    MiEngine::EquirectSettings equirectSettings;
+    equirectSettings.faceSize = faceSize;
+    equirectSettings.mipLevels = mipLevels;
+    equirectSettings.mipFilter = config.environmentMipFilter;
+    auto convertStart = std::chrono::high_resolution_clock::now();
+    std::vector<float> chain = MiEngine::EquirectConverter::convert(hdrData, width, height, channels, equirectSettings);
+    stbi_image_free(hdrData);
+    std::cout << "Equirect conversion: " << std::chrono::duration<double, std::milli>(
+                     std::chrono::high_resolution_clock::now() - convertStart).count() << " ms" << std::endl;
+
+    if (chain.empty()) {
+        std::cerr << "Unsupported HDR layout (" << channels << " channels): " << hdrFilePath << std::endl;
+    }
+    return chain;
+}
 
-            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+std::shared_ptr<CubemapData> TextureUtils::loadEnvironmentData(const std::string& hdrFilePath, const IBLConfig& config) {
+    auto data = std::make_shared<CubemapData>();
+    data->faceSize = config.environmentMapSize;
+    data->mipLevels = static_cast<uint32_t>(std::floor(std::log2(data->faceSize))) + 1;
+
+    data->sourceHash = hashHDR(hdrFilePath);
+    const MiEngine::IBLCacheKey iblCacheKey = makeIBLCacheKey(MiEngine::IBLCacheKind::EnvironmentMap, data->sourceHash,
+                                                              config, data->faceSize, data->mipLevels);
+    const fs::path cachePath = MiEngine::IBLCache::getCachePath(hdrFilePath, iblCacheKey.kind, data->faceSize);
+
+    MiEngine::IBLCacheFile cacheFile;
+    if (MiEngine::IBLCache::open(cachePath, iblCacheKey, cacheFile)) {
+        data->data.resize(cacheFile.getFloatCount());
+        cacheFile.decode(data->data.data());
+        std::cout << "Loaded Environment Cubemap from cache: " << cachePath.string() << std::endl;
+        return data;
+    }
 
-            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    data->data = convertEquirectHDR(hdrFilePath, config, data->faceSize, data->mipLevels);
+    if (data->data.empty()) {
+        return nullptr;
+    }
+    MiEngine::IBLCache::save(cachePath, iblCacheKey, config.cacheEncoding, data->data.data(), data->data.size());
+    return data;
+}
 
-            if (mipWidth > 1) mipWidth /= 2;
-            if (mipHeight > 1) mipHeight /= 2;
+std::shared_ptr<TextureUtils::EnvironmentData> TextureUtils::buildEnvironmentData(
+    const std::string& hdrFilePath,
+    const IBLConfig& config,
+    std::shared_ptr<CubemapData> environment)
+{
+    if (!environment) {
+        environment = loadEnvironmentData(hdrFilePath, config);
+        if (!environment) {
+            return nullptr;
         }
-
-        barrier.subresourceRange.baseMipLevel = numMipLevels - 1;
-        barrier.subresourceRange.levelCount = 1;
-        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-        vkEndCommandBuffer(commandBuffer);
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
-        vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(graphicsQueue);
-        vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
     }
 
-    auto texture = std::make_shared<Texture>(device, physicalDevice);
-    texture->initWithExistingImage(cubemapImage, cubemapMemory, format, cubemapSize, cubemapSize, 
-                                 numMipLevels, 6, VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-    return texture;
+    auto result = std::make_shared<EnvironmentData>();
+    result->hdrPath = hdrFilePath;
+    result->environment = environment;
+
+    // Shaders evaluating the SH only need a 1x1 irradiance cubemap bound
+    result->irradianceSH = computeIrradianceSH(*environment);
+    result->useIrradianceSH = config.useIrradianceSH;
+    result->irradianceSize = config.useIrradianceSH ? 1 : config.irradianceMapSize;
+    result->irradiance = MiEngine::SphericalHarmonics::rasterizeCubemap(result->irradianceSH, result->irradianceSize);
+
+    result->prefilterSize = config.prefilterMapSize;
+    result->prefilterMipLevels = config.prefilterMipLevels;
+    // The environment was hashed when it was loaded; don't read the HDR again
+    const uint64_t sourceHash = environment->sourceHash != 0 ? environment->sourceHash : hashHDR(hdrFilePath);
+    const MiEngine::IBLCacheKey iblCacheKey = makeIBLCacheKey(MiEngine::IBLCacheKind::PrefilterMap, sourceHash,
+                                                              config, result->prefilterSize, result->prefilterMipLevels);
+    const fs::path cachePath = MiEngine::IBLCache::getCachePath(hdrFilePath, iblCacheKey.kind, result->prefilterSize);
+
+    MiEngine::IBLCacheFile cacheFile;
+    if (iblCacheKey.sourceHash != 0 && MiEngine::IBLCache::open(cachePath, iblCacheKey, cacheFile)) {
+        result->prefilter.resize(cacheFile.getFloatCount());
+        cacheFile.decode(result->prefilter.data());
+        std::cout << "Loaded Prefilter Map from cache: " << cachePath.string() << std::endl;
+    } else {
+        result->prefilter = filterPrefilterChain(environment, config, iblCacheKey, cachePath,
+                                                 &result->prefilterRefinement);
+    }
+    return result;
 }
 
+// Project the environment onto L2 SH for diffuse IBL
+MiEngine::SHL2 TextureUtils::computeIrradianceSH(const CubemapData& environment) {
+    // Irradiance only has low frequencies, so a small mip gives the same coefficients
+    const uint32_t maxProjectionSize = 128;
+    uint32_t mipLevel = 0;
+    while (mipLevel + 1 < environment.mipLevels && (environment.faceSize >> mipLevel) > maxProjectionSize) {
+        ++mipLevel;
+    }
+    uint32_t faceSize = std::max(environment.faceSize >> mipLevel, 1u);
 
-// Generate irradiance cubemap from environment map for diffuse IBL
-// Generate irradiance cubemap from environment map for diffuse IBL
-
+    auto startTime = std::chrono::high_resolution_clock::now();
+    MiEngine::SHL2 radiance = MiEngine::SphericalHarmonics::projectCubemap(environment.getFaceData(0, mipLevel), faceSize);
+    MiEngine::SHL2 irradiance = MiEngine::SphericalHarmonics::convolveIrradiance(radiance);
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
 
-// In TextureUtils.cpp
+    std::cout << "Projected irradiance SH from " << faceSize << "x" << faceSize << "x6 faces in "
+              << elapsedMs << " ms" << std::endl;
+    return irradiance;
+}
 
+// Rasterize irradiance SH into a cubemap for diffuse IBL
 std::shared_ptr<Texture> TextureUtils::createIrradianceMap(
     VkDevice device,
     VkPhysicalDevice physicalDevice,
     VkCommandPool commandPool,
     VkQueue graphicsQueue,
-    std::shared_ptr<Texture> environmentMap,
-    const std::string& cacheKey, // <--- Added parameter
+    const MiEngine::SHL2& irradianceSH,
     const IBLConfig* customConfig)
 {
-    if (!environmentMap) return nullptr;
-    
     const IBLConfig& config = customConfig ? *customConfig : iblConfig;
-    const uint32_t irradianceSize = config.irradianceMapSize;
-    
-    // Try to load from cache
-    std::vector<float> allPixelData;
-    uint32_t cachedW, cachedH, cachedMips;
-    bool loadedFromCache = false;
-
-    if (!cacheKey.empty()) {
-        std::string cachePath = getCachePath(cacheKey, "irradiance_" + std::to_string(irradianceSize));
-        if (loadTextureCache(cachePath, allPixelData, cachedW, cachedH, cachedMips)) {
-            if (cachedW == irradianceSize) {
-                std::cout << "Loaded Irradiance Map from cache: " << cachePath << std::endl;
-                loadedFromCache = true;
-            }
-        }
-    }
+
+    // Shaders evaluating the SH only need something bound here
+    const uint32_t irradianceSize = config.useIrradianceSH ? 1 : config.irradianceMapSize;
+    std::vector<float> allPixelData = MiEngine::SphericalHarmonics::rasterizeCubemap(irradianceSH, irradianceSize);
 
     // Setup Vulkan Image
     VkImage irradianceImage;
@@ -1463,55 +1379,16 @@ std::shared_ptr<Texture> TextureUtils::createIrradianceMap(
     allocInfo.allocationSize = memRequirements.size;
     allocInfo.memoryTypeIndex = findMemoryType(physicalDevice, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &irradianceMemory) != VK_SUCCESS) return nullptr;
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &irradianceMemory) != VK_SUCCESS) {
+        vkDestroyImage(device, irradianceImage, nullptr);
+        return nullptr;
+    }
     vkBindImageMemory(device, irradianceImage, irradianceMemory, 0);
 
     transitionImageLayout(device, commandPool, graphicsQueue, irradianceImage, format,
                         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                         0, 6, 0, 1);
 
-    // --- CPU Generation Logic ---
-    if (!loadedFromCache) {
-        std::cout << "Generating Irradiance Map (High Quality)..." << std::endl;
-        size_t faceSize = irradianceSize * irradianceSize * 4; // 4 floats per pixel
-        allPixelData.resize(faceSize * 6);
-
-        for (uint32_t face = 0; face < 6; face++) {
-            #pragma omp parallel for
-            for (uint32_t y = 0; y < irradianceSize; y++) {
-                for (uint32_t x = 0; x < irradianceSize; x++) {
-                    float u = (2.0f * (x + 0.5f) / irradianceSize) - 1.0f;
-                    float v = (2.0f * (y + 0.5f) / irradianceSize) - 1.0f;
-                    
-                    glm::vec3 direction;
-                    switch (face) {
-                        case 0: direction = glm::normalize(glm::vec3(1.0f, -v, -u)); break;
-                        case 1: direction = glm::normalize(glm::vec3(-1.0f, -v, u)); break;
-                        case 2: direction = glm::normalize(glm::vec3(u, 1.0f, v)); break;
-                        case 3: direction = glm::normalize(glm::vec3(u, -1.0f, -v)); break;
-                        case 4: direction = glm::normalize(glm::vec3(u, -v, 1.0f)); break;
-                        case 5: direction = glm::normalize(glm::vec3(-u, -v, -1.0f)); break;
-                    }
-                    
-                    // Keep high quality sample count
-                    glm::vec3 irradiance = diffuseConvolution(environmentMap, direction, 128); // 128 samples
-                    
-                    size_t pixelIdx = (face * irradianceSize * irradianceSize + y * irradianceSize + x) * 4;
-                    allPixelData[pixelIdx + 0] = irradiance.r;
-                    allPixelData[pixelIdx + 1] = irradiance.g;
-                    allPixelData[pixelIdx + 2] = irradiance.b;
-                    allPixelData[pixelIdx + 3] = 1.0f;
-                }
-            }
-        }
-
-        // Save to cache
-        if (!cacheKey.empty()) {
-            std::string cachePath = getCachePath(cacheKey, "irradiance_" + std::to_string(irradianceSize));
-            saveTextureCache(cachePath, allPixelData, irradianceSize, irradianceSize, 1);
-        }
-    }
-
     // --- Upload to GPU ---
     VkBuffer stagingBuffer;
     VkDeviceMemory stagingBufferMemory;
@@ -1527,41 +1404,41 @@ std::shared_ptr<Texture> TextureUtils::createIrradianceMap(
     memcpy(data, allPixelData.data(), bufferSize);
     vkUnmapMemory(device, stagingBufferMemory);
 
+    // All six faces in one submission
+    std::array<VkBufferImageCopy, 6> regions{};
     size_t faceStride = irradianceSize * irradianceSize * 4 * sizeof(float);
     for (uint32_t face = 0; face < 6; face++) {
-        VkBufferImageCopy region{};
+        VkBufferImageCopy& region = regions[face];
         region.bufferOffset = face * faceStride;
         region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         region.imageSubresource.mipLevel = 0;
         region.imageSubresource.baseArrayLayer = face;
         region.imageSubresource.layerCount = 1;
         region.imageExtent = {irradianceSize, irradianceSize, 1};
-        
-        // We need to manually submit copy commands here since copyBufferToImage helper assumes bufferOffset 0
-        // Or modify copyBufferToImage. For brevity, let's assume a manual submit:
-        
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = commandPool;
-        allocInfo.commandBufferCount = 1;
-        VkCommandBuffer cmd;
-        vkAllocateCommandBuffers(device, &allocInfo, &cmd);
-        VkCommandBufferBeginInfo begin{};
-        begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(cmd, &begin);
-        vkCmdCopyBufferToImage(cmd, stagingBuffer, irradianceImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-        vkEndCommandBuffer(cmd);
-        VkSubmitInfo submit{};
-        submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit.commandBufferCount = 1;
-        submit.pCommandBuffers = &cmd;
-        vkQueueSubmit(graphicsQueue, 1, &submit, VK_NULL_HANDLE);
-        vkQueueWaitIdle(graphicsQueue);
-        vkFreeCommandBuffers(device, commandPool, 1, &cmd);
     }
 
+    VkCommandBufferAllocateInfo cmdAllocInfo{};
+    cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdAllocInfo.commandPool = commandPool;
+    cmdAllocInfo.commandBufferCount = 1;
+    VkCommandBuffer cmd;
+    vkAllocateCommandBuffers(device, &cmdAllocInfo, &cmd);
+    VkCommandBufferBeginInfo begin{};
+    begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(cmd, &begin);
+    vkCmdCopyBufferToImage(cmd, stagingBuffer, irradianceImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
+    vkEndCommandBuffer(cmd);
+    VkSubmitInfo submit{};
+    submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit.commandBufferCount = 1;
+    submit.pCommandBuffers = &cmd;
+    vkQueueSubmit(graphicsQueue, 1, &submit, VK_NULL_HANDLE);
+    vkQueueWaitIdle(graphicsQueue);
+    vkFreeCommandBuffers(device, commandPool, 1, &cmd);
+
     transitionImageLayout(device, commandPool, graphicsQueue, irradianceImage, format,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                         0, 6, 0, 1);
@@ -1580,180 +1457,6 @@ std::shared_ptr<Texture> TextureUtils::createIrradianceMap(
 
 
 
-// Helper function to convert equirectangular projection to a cubemap face
-// In TextureUtils.cpp - Replace the equirectangularToCubemapFace function
-
-void TextureUtils::equirectangularToCubemapFace(
-    float* equirectangularData, int equiWidth, int equiHeight, int channels,
-    float* faceData, int faceSize, int faceIndex)
-{
-    // For each pixel in the cubemap face
-    for (int y = 0; y < faceSize; y++) {
-        for (int x = 0; x < faceSize; x++) {
-            // Convert pixel coordinates to [-1, 1] range
-            float u = 2.0f * (x + 0.5f) / faceSize - 1.0f;
-            float v = 2.0f * (y + 0.5f) / faceSize - 1.0f;
-            
-            // Calculate the 3D direction vector for this pixel on the cube face
-            glm::vec3 dir;
-            
-            switch (faceIndex) {
-                case 0: // +X (Right)
-                    dir = glm::vec3(1.0f, -v, -u);
-                    break;
-                case 1: // -X (Left)  
-                    dir = glm::vec3(-1.0f, -v, u);
-                    break;
-                case 2: // +Y (Top)
-                    dir = glm::vec3(u, 1.0f, v);
-                    break;
-                case 3: // -Y (Bottom)
-                    dir = glm::vec3(u, -1.0f, -v);
-                    break;
-                case 4: // +Z (Front)
-                    dir = glm::vec3(u, -v, 1.0f);
-                    break;
-                case 5: // -Z (Back)
-                    dir = glm::vec3(-u, -v, -1.0f);
-                    break;
-            }
-            
-            // Normalize the direction vector
-            dir = glm::normalize(dir);
-            
-            // Convert the 3D direction to spherical coordinates
-            // Theta (azimuthal angle): angle from +X axis in XZ plane
-            float theta = std::atan2(dir.z, dir.x);
-            // Phi (polar angle): angle from +Y axis
-            float phi = std::acos(glm::clamp(dir.y, -1.0f, 1.0f));
-            
-            // Convert spherical coordinates to equirectangular UV coordinates
-            float eqU = (theta + glm::pi<float>()) / (2.0f * glm::pi<float>());
-            float eqV = phi / glm::pi<float>();
-            
-            // Wrap UV coordinates
-            eqU = glm::fract(eqU);
-            eqV = glm::clamp(eqV, 0.0f, 1.0f);
-            
-            // Sample from the equirectangular image using bilinear interpolation
-            float fX = eqU * (equiWidth - 1);
-            float fY = eqV * (equiHeight - 1);
-            
-            int x0 = (int)std::floor(fX);
-            int y0 = (int)std::floor(fY);
-            int x1 = std::min(x0 + 1, equiWidth - 1);
-            int y1 = std::min(y0 + 1, equiHeight - 1);
-            
-            float dx = fX - x0;
-            float dy = fY - y0;
-            
-            // Ensure x coordinates wrap around
-            x0 = x0 % equiWidth;
-            x1 = x1 % equiWidth;
-            
-            // Bilinear interpolation
-            int faceIdx = (y * faceSize + x) * 4;
-            
-            for (int c = 0; c < std::min(channels, 3); c++) {
-                float v00 = equirectangularData[(y0 * equiWidth + x0) * channels + c];
-                float v10 = equirectangularData[(y0 * equiWidth + x1) * channels + c];
-                float v01 = equirectangularData[(y1 * equiWidth + x0) * channels + c];
-                float v11 = equirectangularData[(y1 * equiWidth + x1) * channels + c];
-                
-                float v0 = v00 * (1.0f - dx) + v10 * dx;
-                float v1 = v01 * (1.0f - dx) + v11 * dx;
-                float value = v0 * (1.0f - dy) + v1 * dy;
-                
-                faceData[faceIdx + c] = value;
-            }
-            
-            // Fill remaining channels if needed
-            for (int c = channels; c < 3; c++) {
-                faceData[faceIdx + c] = faceData[faceIdx]; // Use R channel
-            }
-            
-            // Set alpha to 1.0
-            faceData[faceIdx + 3] = 1.0f;
-        }
-    }
-}
-
-// Helper function for diffuse convolution
-glm::vec3 TextureUtils::diffuseConvolution(std::shared_ptr<Texture> envMap, const glm::vec3& normal, int sampleCount) {
-    // In a real implementation, we would sample a hemisphere around the normal
-    // and perform proper convolution. This is a simplified approximation.
-    
-    // Generate a set of hemisphere samples
-    std::vector<glm::vec3> samples = generateHemisphereSamples(normal, sampleCount);
-    
-    // Sample the environment map and accumulate the results
-    glm::vec3 irradiance(0.0f);
-    float weight = 0.0f;
-    
-    for (const auto& sample : samples) {
-        // Calculate the angle between the normal and the sample direction
-        float cosTheta = glm::dot(normal, sample);
-        
-        // Only consider samples in the hemisphere (cosTheta > 0)
-        if (cosTheta > 0.0f) {
-            // Sample the environment map
-            glm::vec3 color = sampleEnvironmentMap(envMap, sample);
-            
-            // Weight by the cosine term and solid angle
-            irradiance += color * cosTheta;
-            weight += cosTheta;
-        }
-    }
-    
-    // Normalize the result
-    if (weight > 0.0f) {
-        irradiance /= weight;
-    }
-    
-    return irradiance;
-}
-
-// Helper function for specular convolution
-glm::vec3 TextureUtils::specularConvolution(std::shared_ptr<Texture> envMap, const glm::vec3& reflection, 
-                                           float roughness, int sampleCount) {
-    // In a real implementation, we would use importance sampling
-    
-    // Determine the lobe width based on roughness
-    float alphaSquared = roughness * roughness;
-    
-    // Generate a set of samples around the reflection vector based on roughness
-    std::vector<glm::vec3> samples = generateImportanceSamples(reflection, roughness, sampleCount);
-    
-    // Sample the environment map and accumulate the results
-    glm::vec3 prefilteredColor(0.0f);
-    float totalWeight = 0.0f;
-    
-    for (const auto& sample : samples) {
-        // Calculate the angle between the reflection and the sample direction
-        float NoS = glm::dot(reflection, sample);
-        
-        // Only consider samples that are visible from the reflection direction
-        if (NoS > 0.0f) {
-            // Sample the environment map
-            glm::vec3 color = sampleEnvironmentMap(envMap, sample);
-            
-            // Apply importance sampling weight
-            float D = distributionGGX(NoS, alphaSquared);
-            float weight = D * NoS;
-            
-            prefilteredColor += color * weight;
-            totalWeight += weight;
-        }
-    }
-    
-    // Normalize the result
-    if (totalWeight > 0.0f) {
-        prefilteredColor /= totalWeight;
-    }
-    
-    return prefilteredColor;
-}
-
 bool Texture::initWithExistingImage(
     VkImage image, 
     VkDeviceMemory memory,
@@ -1977,6 +1680,14 @@ void TextureUtils::transitionImageLayout(
         sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
         destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     }
+    else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        // Re-uploading a texture that earlier frames sampled
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
     else {
         throw std::runtime_error("Unsupported layout transition!");
     }
@@ -2071,6 +1782,42 @@ void TextureUtils::copyBufferToImage(
     vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
 }
 
+std::shared_ptr<CubemapData> TextureUtils::createDefaultEnvironmentData(uint32_t faceSize) {
+    auto data = std::make_shared<CubemapData>();
+    data->faceSize = faceSize;
+    data->mipLevels = MiEngine::MipGenerator::getMipLevelCount(faceSize, faceSize);
+    data->data.resize(static_cast<size_t>(faceSize) * faceSize * 4 * 6);
+
+    // The same face gradients as createDefaultEnvironmentCubemap
+    for (uint32_t face = 0; face < 6; face++) {
+        for (uint32_t y = 0; y < faceSize; y++) {
+            for (uint32_t x = 0; x < faceSize; x++) {
+                float u = (x / (float)std::max(faceSize - 1, 1u)) * 2.0f - 1.0f;
+                float v = (y / (float)std::max(faceSize - 1, 1u)) * 2.0f - 1.0f;
+
+                glm::vec3 color;
+                switch (face) {
+                    case 0: color = glm::vec3(0.8f, 0.2f + 0.2f * v, 0.2f + 0.2f * u); break;
+                    case 1: color = glm::vec3(0.2f, 0.8f - 0.2f * v, 0.8f - 0.2f * u); break;
+                    case 2: color = glm::vec3(0.2f + 0.2f * u, 0.2f + 0.2f * v, 0.8f); break;
+                    case 3: color = glm::vec3(0.8f - 0.2f * u, 0.8f - 0.2f * v, 0.2f); break;
+                    case 4: color = glm::vec3(0.2f + 0.2f * u, 0.8f, 0.2f + 0.2f * v); break;
+                    default: color = glm::vec3(0.8f - 0.2f * u, 0.2f, 0.8f - 0.2f * v); break;
+                }
+
+                float* texel = data->data.data() + (static_cast<size_t>(face) * faceSize * faceSize + y * faceSize + x) * 4;
+                texel[0] = color.x;
+                texel[1] = color.y;
+                texel[2] = color.z;
+                texel[3] = 1.0f;
+            }
+        }
+    }
+
+    MiEngine::MipGenerator::generateCubemap(data->data, faceSize, data->mipLevels, MiEngine::MipSettings{});
+    return data;
+}
+
 std::shared_ptr<Texture> TextureUtils::createDefaultEnvironmentCubemap(
     VkDevice device, 
     VkPhysicalDevice physicalDevice,
@@ -2131,89 +1878,6 @@ std::shared_ptr<Texture> TextureUtils::createDefaultEnvironmentCubemap(
     return texture;
 }
 
-std::vector<glm::vec3> TextureUtils::generateHemisphereSamples(const glm::vec3& normal, int sampleCount) {
-    std::vector<glm::vec3> samples;
-    samples.reserve(sampleCount);
-    
-    // Create a simple basis with the normal
-    glm::vec3 tangent;
-    if (std::abs(normal.x) > std::abs(normal.z)) {
-        tangent = glm::vec3(-normal.y, normal.x, 0.0f);
-    } else {
-        tangent = glm::vec3(0.0f, -normal.z, normal.y);
-    }
-    tangent = glm::normalize(tangent);
-    glm::vec3 bitangent = glm::cross(normal, tangent);
-    
-    // Generate samples in hemisphere
-    for (int i = 0; i < sampleCount; i++) {
-        // Use Hammersley sequence for uniform sampling
-        float u = static_cast<float>(i) / static_cast<float>(sampleCount);
-        float v = float(((i * 16807) % 2147483647) / 2147483647.0f);
-        
-        // Convert to spherical coordinates (hemisphere)
-        float phi = 2.0f * glm::pi<float>() * u;
-        float theta = std::acos(v);
-        
-        // Convert to cartesian coordinates
-        float x = std::sin(theta) * std::cos(phi);
-        float y = std::sin(theta) * std::sin(phi);
-        float z = std::cos(theta);
-        
-        // Transform to world space using the normal's basis
-        glm::vec3 sample = tangent * x + bitangent * y + normal * z;
-        samples.push_back(glm::normalize(sample));
-    }
-    
-    return samples;
-}
-
-std::vector<glm::vec3> TextureUtils::generateImportanceSamples(
-    const glm::vec3& reflection, 
-    float roughness, 
-    int sampleCount) 
-{
-    std::vector<glm::vec3> samples;
-    samples.reserve(sampleCount);
-    
-    // Create basis vectors
-    glm::vec3 N = reflection;
-    glm::vec3 tangent;
-    if (std::abs(N.x) > std::abs(N.z)) {
-        tangent = glm::vec3(-N.y, N.x, 0.0f);
-    } else {
-        tangent = glm::vec3(0.0f, -N.z, N.y);
-    }
-    tangent = glm::normalize(tangent);
-    glm::vec3 bitangent = glm::cross(N, tangent);
-    
-    // The alpha parameter for GGX distribution
-    float alpha = roughness * roughness;
-    
-    // Generate samples
-    for (int i = 0; i < sampleCount; i++) {
-        // Use Hammersley sequence for uniform sampling
-        float u = static_cast<float>(i) / static_cast<float>(sampleCount);
-        float v = float(((i * 16807) % 2147483647) / 2147483647.0f);
-        
-        // GGX importance sampling (corrected formula)
-        float phi = 2.0f * glm::pi<float>() * u;
-        float cosTheta = std::sqrt((1.0f - v) / (1.0f + (alpha*alpha - 1.0f) * v));
-        float theta = std::acos(cosTheta);
-        
-        // Convert to cartesian coordinates (in tangent space)
-        float x = std::sin(theta) * std::cos(phi);
-        float y = std::sin(theta) * std::sin(phi);
-        float z = std::cos(theta);
-        
-        // Transform to world space
-        glm::vec3 sample = tangent * x + bitangent * y + N * z;
-        samples.push_back(glm::normalize(sample));
-    }
-    
-    return samples;
-}
-
 glm::vec3 TextureUtils::sampleEnvironmentMap(std::shared_ptr<Texture> envMap, const glm::vec3& direction) {
     // This is a placeholder function that would sample the environment map at a given direction
     // In a real implementation, you would need to convert the direction to texture coordinates
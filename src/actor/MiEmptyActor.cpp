@@ -10,6 +10,6 @@ MiEmptyActor::MiEmptyActor()
 }
 
 // Register the type
-MI_REGISTER_TYPE(MiEmptyActor)
+MI_REGISTER_TYPE_WITH_PARENT(MiEmptyActor, MiActor)
 
 } // namespace MiEngine
@@ -12,6 +12,11 @@ MiStaticMeshActor::MiStaticMeshActor()
 }
 
 void MiStaticMeshActor::createDefaultComponents() {
+    // Already created (a recycled actor keeps its components)
+    if (m_MeshComponent) {
+        return;
+    }
+
     // Create the mesh component as both root and mesh
     m_MeshComponent = addComponent<MiStaticMeshComponent>();
     m_MeshComponent->setName("StaticMeshComponent");
@@ -32,7 +37,7 @@ void MiStaticMeshActor::setMesh(std::shared_ptr<Mesh> mesh) {
 
 void MiStaticMeshActor::setMesh(const std::string& assetPath) {
     if (m_MeshComponent) {
-        m_MeshComponent->setMeshByPath(assetPath);
+        m_MeshComponent->setMeshByPath(MiName(assetPath));
     }
 }
 
@@ -125,6 +130,6 @@ void MiStaticMeshActor::deserialize(const JsonReader& reader) {
 }
 
 // Register the type
-MI_REGISTER_TYPE(MiStaticMeshActor)
+MI_REGISTER_TYPE_WITH_PARENT(MiStaticMeshActor, MiActor)
 
 } // namespace MiEngine
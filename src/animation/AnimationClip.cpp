@@ -142,7 +142,7 @@ AnimationClip::AnimationClip(const std::string& name, float duration, float tick
     , m_ticksPerSecond(ticksPerSecond) {
 }
 
-BoneAnimationTrack& AnimationClip::addTrack(const std::string& boneName) {
+BoneAnimationTrack& AnimationClip::addTrack(MiName boneName) {
     // Check if track already exists
     for (auto& track : m_tracks) {
         if (track.boneName == boneName) {
@@ -155,7 +155,7 @@ BoneAnimationTrack& AnimationClip::addTrack(const std::string& boneName) {
     return m_tracks.back();
 }
 
-BoneAnimationTrack* AnimationClip::getTrack(const std::string& boneName) {
+BoneAnimationTrack* AnimationClip::getTrack(MiName boneName) {
     for (auto& track : m_tracks) {
         if (track.boneName == boneName) {
             return &track;
@@ -164,7 +164,7 @@ BoneAnimationTrack* AnimationClip::getTrack(const std::string& boneName) {
     return nullptr;
 }
 
-const BoneAnimationTrack* AnimationClip::getTrack(const std::string& boneName) const {
+const BoneAnimationTrack* AnimationClip::getTrack(MiName boneName) const {
     for (const auto& track : m_tracks) {
         if (track.boneName == boneName) {
             return &track;
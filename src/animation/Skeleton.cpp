@@ -5,7 +5,7 @@
 
 namespace MiEngine {
 
-uint32_t Skeleton::addBone(const std::string& name, int32_t parentIndex,
+uint32_t Skeleton::addBone(MiName name, int32_t parentIndex,
                            const glm::mat4& inverseBindPose,
                            const glm::mat4& localBindPose) {
     if (m_bones.size() >= MAX_BONES) {
@@ -14,7 +14,7 @@ uint32_t Skeleton::addBone(const std::string& name, int32_t parentIndex,
     }
 
     if (m_boneNameToIndex.find(name) != m_boneNameToIndex.end()) {
-        throw std::runtime_error("Skeleton::addBone: Bone '" + name + "' already exists");
+        throw std::runtime_error("Skeleton::addBone: Bone '" + name.toString() + "' already exists");
     }
 
     if (parentIndex >= static_cast<int32_t>(m_bones.size())) {
@@ -42,7 +42,7 @@ uint32_t Skeleton::addBone(const std::string& name, int32_t parentIndex,
     return index;
 }
 
-int32_t Skeleton::getBoneIndex(const std::string& name) const {
+int32_t Skeleton::getBoneIndex(MiName name) const {
     auto it = m_boneNameToIndex.find(name);
     if (it != m_boneNameToIndex.end()) {
         return static_cast<int32_t>(it->second);
@@ -50,7 +50,7 @@ int32_t Skeleton::getBoneIndex(const std::string& name) const {
     return -1;
 }
 
-bool Skeleton::hasBone(const std::string& name) const {
+bool Skeleton::hasBone(MiName name) const {
     return m_boneNameToIndex.find(name) != m_boneNameToIndex.end();
 }
 
@@ -60,6 +60,10 @@ void AssetBrowserWindow::drawMenuBar() {
             if (ImGui::MenuItem("Refresh", "F5")) {
                 handleRefresh();
             }
+            if (ImGui::MenuItem("Export Registry JSON")) {
+                auto& registry = AssetRegistry::getInstance();
+                registry.exportJson(registry.getLegacyJsonPath());
+            }
             ImGui::EndMenu();
         }
 
@@ -246,7 +250,7 @@ void AssetBrowserWindow::drawAssetList() {
 void AssetBrowserWindow::drawFooter() {
     ImGui::Separator();
 
-    const AssetEntry* selected = nullptr;
+    std::optional<AssetEntry> selected;
     if (!m_selectedUuid.empty()) {
         selected = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
     }
@@ -292,7 +296,7 @@ void AssetBrowserWindow::handleAddToScene() {
         return;
     }
 
-    const AssetEntry* entry = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
+    std::optional<AssetEntry> entry = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
     if (!entry) {
         return;
     }
@@ -343,12 +347,10 @@ void AssetBrowserWindow::handleRefresh() {
 void AssetBrowserWindow::refreshAssetList() {
     m_displayedAssets.clear();
 
-    const auto& allAssets = AssetRegistry::getInstance().getAssets();
-
-    for (const auto& entry : allAssets) {
+    AssetRegistry::getInstance().forEachAsset([this](const AssetEntry& entry) {
         // Filter by type
         if (m_filterType != AssetType::Unknown && entry.type != m_filterType) {
-            continue;
+            return;
         }
 
         // Filter by search query
@@ -359,12 +361,12 @@ void AssetBrowserWindow::refreshAssetList() {
             std::transform(queryLower.begin(), queryLower.end(), queryLower.begin(), ::tolower);
 
             if (nameLower.find(queryLower) == std::string::npos) {
-                continue;
+                return;
             }
         }
 
         m_displayedAssets.push_back(entry);
-    }
+    });
 
     // Sort by name
     std::sort(m_displayedAssets.begin(), m_displayedAssets.end(),
@@ -392,7 +394,7 @@ void AssetBrowserWindow::handleGenerateClusteredMesh() {
         return;
     }
 
-    const AssetEntry* entry = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
+    std::optional<AssetEntry> entry = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
     if (!entry) {
         return;
     }
@@ -419,7 +421,7 @@ void AssetBrowserWindow::drawClusteringPopup() {
     ImGui::SetNextWindowSize(ImVec2(400, 300), ImGuiCond_Appearing);
 
     if (ImGui::BeginPopupModal("Generate Clustered Mesh", &m_showClusteringPopup, ImGuiWindowFlags_AlwaysAutoResize)) {
-        const AssetEntry* entry = AssetRegistry::getInstance().findByUuid(m_clusteringAssetUuid);
+        std::optional<AssetEntry> entry = AssetRegistry::getInstance().findByUuid(m_clusteringAssetUuid);
         if (!entry) {
             ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Error: Asset not found");
             if (ImGui::Button("Close", ImVec2(120, 0))) {
@@ -572,7 +574,7 @@ void AssetBrowserWindow::drawClusteredMeshInfoPopup() {
     ImGui::SetNextWindowSize(ImVec2(450, 400), ImGuiCond_Appearing);
 
     if (ImGui::BeginPopupModal("Clustered Mesh Info", &m_showClusteredMeshInfo, ImGuiWindowFlags_AlwaysAutoResize)) {
-        const AssetEntry* entry = AssetRegistry::getInstance().findByUuid(m_clusteredMeshInfoUuid);
+        std::optional<AssetEntry> entry = AssetRegistry::getInstance().findByUuid(m_clusteredMeshInfoUuid);
         if (!entry) {
             ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Error: Asset not found");
             if (ImGui::Button("Close", ImVec2(120, 0))) {
@@ -680,7 +682,7 @@ void AssetBrowserWindow::handleLoadClusteredMesh() {
         return;
     }
 
-    const AssetEntry* entry = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
+    std::optional<AssetEntry> entry = AssetRegistry::getInstance().findByUuid(m_selectedUuid);
     if (!entry) {
         return;
     }
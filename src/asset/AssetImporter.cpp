@@ -1,8 +1,12 @@
 #include "asset/AssetImporter.h"
 #include "asset/AssetRegistry.h"
 #include "asset/MeshCache.h"
+#include "asset/TextureCache.h"
 #include "loader/ModelLoader.h"
+#include "loader/GltfLoader.h"
+#include "loader/ObjLoader.h"
 #include "project/ProjectManager.h"
+#include "core/ThreadPool.h"
 #include <iostream>
 #include <chrono>
 #include <algorithm>
@@ -41,8 +45,12 @@ bool AssetImporter::isSupportedFormat(const fs::path& filePath) {
     std::string ext = filePath.extension().string();
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
-    // Currently only FBX models are fully supported
-    return ext == ".fbx";
+    // FBX (via the FBX SDK), glTF 2.0 and OBJ (native loaders)
+#ifdef MIENGINE_NO_FBX
+    return ext == ".gltf" || ext == ".glb" || ext == ".obj";
+#else
+    return ext == ".fbx" || ext == ".gltf" || ext == ".glb" || ext == ".obj";
+#endif
 }
 
 bool AssetImporter::copyToProject(const fs::path& source, const fs::path& destination) {
@@ -82,6 +90,10 @@ bool AssetImporter::generateCache(const AssetEntry& entry) {
     sourcePath = sourcePath.make_preferred();
     cachePath = cachePath.make_preferred();
 
+    return bakeCache(entry.type, sourcePath, cachePath);
+}
+
+bool AssetImporter::bakeCache(AssetType type, const fs::path& sourcePath, const fs::path& cachePath) {
     std::cout << "AssetImporter: Generating cache for " << sourcePath << std::endl;
     std::cout << "AssetImporter: Cache path: " << cachePath << std::endl;
 
@@ -94,9 +106,25 @@ bool AssetImporter::generateCache(const AssetEntry& entry) {
     // Ensure cache directory exists
     fs::create_directories(cachePath.parent_path());
 
+    if (type == AssetType::Texture) {
+        TextureBakeStats stats;
+        if (!TextureCache::bake(sourcePath, cachePath, TextureCache::guessTextureType(sourcePath), &stats)) {
+            std::cerr << "AssetImporter: Failed to bake texture: " << sourcePath << std::endl;
+            return false;
+        }
+        std::cout << "AssetImporter: Cache generated successfully" << std::endl;
+        return true;
+    }
+
+    // Reimports run on the ThreadPool next to MeshLibrary's worker decodes; glTF and OBJ
+    // are thread-safe, FBX goes through the SDK lock
+    std::unique_lock<std::mutex> fbxLock(ModelLoader::GetFbxMutex(), std::defer_lock);
+    if (!GltfLoader::isGltfFile(sourcePath) && !ObjLoader::isObjFile(sourcePath)) {
+        fbxLock.lock();
+    }
     ModelLoader loader;
 
-    if (entry.type == AssetType::SkeletalMesh) {
+    if (type == AssetType::SkeletalMesh) {
         SkeletalModelData modelData;
         if (!loader.LoadSkeletalModel(sourcePath.string(), modelData)) {
             std::cerr << "AssetImporter: Failed to load skeletal model: " << sourcePath << std::endl;
@@ -154,6 +182,16 @@ std::string AssetImporter::importModel(const fs::path& sourceFile) {
         return "";
     }
 
+    // .gltf files reference their buffers/textures by relative path; keep the layout
+    if (GltfLoader::isGltfFile(sourceFile)) {
+        for (const auto& dependency : GltfLoader::getExternalDependencies(sourceFile)) {
+            fs::path relative = fs::relative(dependency, sourceFile.parent_path());
+            if (fs::exists(dependency) && !copyToProject(dependency, destDir / relative)) {
+                std::cerr << "AssetImporter: Failed to copy dependency: " << dependency << std::endl;
+            }
+        }
+    }
+
     // Create asset entry
     AssetEntry entry;
     entry.uuid = AssetRegistry::generateUuid();
@@ -164,12 +202,21 @@ std::string AssetImporter::importModel(const fs::path& sourceFile) {
     // Detect if skeletal (need to actually parse to know for sure)
     // Normalize destination path for FBX loader
     fs::path normalizedDest = destFile.make_preferred();
-    ModelLoader loader;
-    SkeletalModelData skeletalData;
-    if (loader.LoadSkeletalModel(normalizedDest.string(), skeletalData) && skeletalData.hasSkeleton) {
-        entry.type = AssetType::SkeletalMesh;
-    } else {
+    if (GltfLoader::isGltfFile(normalizedDest)) {
+        // glTF declares skins in the JSON; no need to decode geometry twice
+        entry.type = GltfLoader::hasSkin(normalizedDest) ? AssetType::SkeletalMesh : AssetType::StaticMesh;
+    } else if (ObjLoader::isObjFile(normalizedDest)) {
+        // OBJ has no skinning
         entry.type = AssetType::StaticMesh;
+    } else {
+        std::lock_guard<std::mutex> lock(ModelLoader::GetFbxMutex());
+        ModelLoader loader;
+        SkeletalModelData skeletalData;
+        if (loader.LoadSkeletalModel(normalizedDest.string(), skeletalData) && skeletalData.hasSkeleton) {
+            entry.type = AssetType::SkeletalMesh;
+        } else {
+            entry.type = AssetType::StaticMesh;
+        }
     }
 
     // Set timestamps
@@ -194,6 +241,56 @@ std::string AssetImporter::importModel(const fs::path& sourceFile) {
     return entry.uuid;
 }
 
+std::string AssetImporter::importTexture(const fs::path& sourceFile) {
+    if (!fs::exists(sourceFile)) {
+        std::cerr << "AssetImporter: Source file not found: " << sourceFile << std::endl;
+        return "";
+    }
+
+    if (detectAssetType(sourceFile) != AssetType::Texture) {
+        std::cerr << "AssetImporter: Unsupported texture format: " << sourceFile.extension() << std::endl;
+        return "";
+    }
+
+    auto& pm = ProjectManager::getInstance();
+    if (!pm.hasProject()) {
+        std::cerr << "AssetImporter: No project open" << std::endl;
+        return "";
+    }
+
+    auto& registry = AssetRegistry::getInstance();
+    fs::path projectPath = pm.getCurrentProject()->getProjectPath();
+
+    fs::path destFile = projectPath / "Assets" / "Textures" / sourceFile.filename();
+    if (!copyToProject(sourceFile, destFile)) {
+        return "";
+    }
+
+    AssetEntry entry;
+    entry.uuid = AssetRegistry::generateUuid();
+    entry.name = sourceFile.stem().string();
+    entry.type = AssetType::Texture;
+    entry.projectPath = "Textures/" + sourceFile.filename().string();
+    // Same name Scene::requestTexture looks for, so imported textures are already baked at load
+    fs::path cacheFile = TextureCache::getCachePath(destFile, TextureCache::getDefaultCacheDir(),
+                                                    TextureCache::guessTextureType(destFile));
+    entry.cachePath = fs::relative(cacheFile, registry.getCachePath()).generic_string();
+
+    auto now = std::chrono::system_clock::now();
+    entry.importTime = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
+    entry.sourceModTime = MeshCache::getSourceModTime(destFile);
+    entry.cacheValid = generateCache(entry);
+
+    registry.addAsset(entry);
+    registry.save();
+
+    std::cout << "AssetImporter: Imported " << entry.name << " as "
+              << assetTypeToString(entry.type) << std::endl;
+
+    return entry.uuid;
+}
+
 void AssetImporter::importModelAsync(const fs::path& sourceFile, ImportCallback callback) {
     // For now, just call synchronous version
     // Future: run in separate thread
@@ -204,38 +301,67 @@ void AssetImporter::importModelAsync(const fs::path& sourceFile, ImportCallback
 }
 
 bool AssetImporter::reimport(const std::string& uuid) {
+    PendingReimport pending = beginReimport(uuid);
+    return finishReimport(pending);
+}
+
+AssetImporter::PendingReimport AssetImporter::beginReimport(const std::string& uuid) {
     auto& registry = AssetRegistry::getInstance();
-    const AssetEntry* entry = registry.findByUuid(uuid);
+    std::optional<AssetEntry> entry = registry.findByUuid(uuid);
 
+    PendingReimport pending;
     if (!entry) {
         std::cerr << "AssetImporter: Asset not found: " << uuid << std::endl;
+        return pending;
+    }
+    if (registry.getProjectPath().empty()) {
+        std::cerr << "AssetImporter: Registry project path not set!" << std::endl;
+        return pending;
+    }
+
+    // Update modification time
+    pending.entry = *entry;
+    fs::path sourcePath = registry.resolveAssetPath(entry->projectPath).make_preferred();
+    fs::path cachePath = registry.resolveCachePath(entry->cachePath).make_preferred();
+    pending.entry.sourceModTime = MeshCache::getSourceModTime(sourcePath);
+
+    // Regenerate cache off the main thread; only the paths cross over
+    AssetType type = entry->type;
+    pending.result = ThreadPool::getInstance().submit([type, sourcePath, cachePath]() {
+        return bakeCache(type, sourcePath, cachePath);
+    });
+    return pending;
+}
+
+bool AssetImporter::finishReimport(PendingReimport& pending) {
+    if (!pending.result.valid()) {
         return false;
     }
 
-    // Make a copy since we'll modify it
-    AssetEntry updatedEntry = *entry;
+    auto& registry = AssetRegistry::getInstance();
+    bool baked = pending.result.get();
 
-    // Update modification time
-    fs::path sourcePath = registry.resolveAssetPath(entry->projectPath);
-    updatedEntry.sourceModTime = MeshCache::getSourceModTime(sourcePath);
+    // Deleted while the bake was running
+    if (!registry.findByUuid(pending.entry.uuid)) {
+        return false;
+    }
 
-    // Regenerate cache
-    if (generateCache(updatedEntry)) {
-        updatedEntry.cacheValid = true;
-        registry.updateAsset(updatedEntry);
+    if (baked) {
+        pending.entry.cacheValid = true;
+        registry.updateAsset(pending.entry);
         registry.save();
-        std::cout << "AssetImporter: Reimported " << entry->name << std::endl;
+        std::cout << "AssetImporter: Reimported " << pending.entry.name << std::endl;
         return true;
     }
 
-    registry.invalidateCache(uuid);
+    registry.invalidateCache(pending.entry.uuid);
     registry.save();
     return false;
 }
 
 bool AssetImporter::deleteAsset(const std::string& uuid) {
     auto& registry = AssetRegistry::getInstance();
-    const AssetEntry* entry = registry.findByUuid(uuid);
+    std::optional<AssetEntry> entry = registry.findByUuid(uuid);
 
     if (!entry) {
         std::cerr << "AssetImporter: Asset not found: " << uuid << std::endl;
@@ -278,7 +404,7 @@ std::string AssetImporter::showImportDialog() {
 
     OPENFILENAMEW ofn = {};
     ofn.lStructSize = sizeof(ofn);
-    ofn.lpstrFilter = L"FBX Models (*.fbx)\0*.fbx\0All Files (*.*)\0*.*\0";
+    ofn.lpstrFilter = L"Models (*.fbx;*.gltf;*.glb;*.obj)\0*.fbx;*.gltf;*.glb;*.obj\0Textures (*.png;*.jpg;*.jpeg;*.tga;*.bmp)\0*.png;*.jpg;*.jpeg;*.tga;*.bmp\0FBX Models (*.fbx)\0*.fbx\0glTF Models (*.gltf;*.glb)\0*.gltf;*.glb\0OBJ Models (*.obj)\0*.obj\0All Files (*.*)\0*.*\0";
     ofn.lpstrFile = filename;
     ofn.nMaxFile = MAX_PATH;
     ofn.lpstrTitle = L"Import Model";
@@ -291,6 +417,9 @@ std::string AssetImporter::showImportDialog() {
         std::string result(size - 1, 0);
         WideCharToMultiByte(CP_UTF8, 0, filename, -1, &result[0], size, nullptr, nullptr);
 
+        if (detectAssetType(result) == AssetType::Texture) {
+            return importTexture(result);
+        }
         return importModel(result);
     }
 #endif
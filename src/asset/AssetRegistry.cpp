@@ -1,10 +1,18 @@
 #include "asset/AssetRegistry.h"
 #include "asset/MeshCache.h"
+#include "asset/TextureCache.h"
+#include "core/Hash.h"
+#include "core/MappedFile.h"
+#include "core/ThreadPool.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <random>
 #include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <limits>
 
 namespace MiEngine {
 
@@ -122,87 +130,532 @@ namespace {
         }
         return result;
     }
+
+    bool parseJsonAssets(const std::string& json, std::vector<AssetEntry>& outEntries) {
+        // Find assets array
+        size_t assetsPos = json.find("\"assets\"");
+        if (assetsPos == std::string::npos) {
+            return false;
+        }
+
+        size_t arrayStart = json.find('[', assetsPos);
+        size_t arrayEnd = json.find_last_of(']');
+        if (arrayStart == std::string::npos || arrayEnd == std::string::npos) {
+            return false;
+        }
+
+        std::string assetsArray = json.substr(arrayStart, arrayEnd - arrayStart + 1);
+        auto assetObjects = extractJsonArray(assetsArray);
+
+        for (const auto& obj : assetObjects) {
+            AssetEntry entry;
+            entry.uuid = extractJsonValue(obj, "uuid");
+            entry.name = extractJsonValue(obj, "name");
+            entry.projectPath = extractJsonValue(obj, "projectPath");
+            entry.cachePath = extractJsonValue(obj, "cachePath");
+            entry.type = stringToAssetType(extractJsonValue(obj, "type"));
+
+            std::string importTimeStr = extractJsonValue(obj, "importTime");
+            entry.importTime = importTimeStr.empty() ? 0 : std::stoull(importTimeStr);
+
+            std::string modTimeStr = extractJsonValue(obj, "sourceModTime");
+            entry.sourceModTime = modTimeStr.empty() ? 0 : std::stoull(modTimeStr);
+
+            std::string cacheValidStr = extractJsonValue(obj, "cacheValid");
+            entry.cacheValid = (cacheValidStr == "true");
+
+            if (!entry.uuid.empty()) {
+                outEntries.push_back(entry);
+            }
+        }
+        return true;
+    }
+
+    // Binary helpers for the registry file and journal
+    constexpr uint32_t RECORD_FLAG_CACHE_VALID = 1u << 0;
+
+    // Journal is folded into the registry file once it holds more records than
+    // max(JOURNAL_MIN_COMPACT, assetCount / JOURNAL_COMPACT_DIVISOR)
+    constexpr size_t JOURNAL_MIN_COMPACT = 256;
+    constexpr size_t JOURNAL_COMPACT_DIVISOR = 4;
+
+    // Quiet period before a changed file is validated (editors write in several steps)
+    constexpr std::chrono::milliseconds FILE_CHANGE_DEBOUNCE(300);
+
+    void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(value));
+    }
+
+    void appendU64(std::vector<uint8_t>& out, uint64_t value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(value));
+    }
+
+    void appendString(std::vector<uint8_t>& out, const std::string& str) {
+        appendU32(out, static_cast<uint32_t>(str.size()));
+        out.insert(out.end(), str.begin(), str.end());
+    }
+
+    // Bounds-checked reader over a journal payload
+    struct ByteReader {
+        const uint8_t* cursor;
+        const uint8_t* end;
+
+        template<typename T>
+        bool read(T& value) {
+            if (static_cast<size_t>(end - cursor) < sizeof(T)) return false;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return true;
+        }
+
+        bool readString(std::string& str) {
+            uint32_t length = 0;
+            if (!read(length) || static_cast<size_t>(end - cursor) < length) return false;
+            str.assign(reinterpret_cast<const char*>(cursor), length);
+            cursor += length;
+            return true;
+        }
+    };
+
+    void encodeEntry(std::vector<uint8_t>& out, const AssetEntry& entry) {
+        appendString(out, entry.uuid);
+        appendString(out, entry.name);
+        appendString(out, entry.projectPath);
+        appendString(out, entry.cachePath);
+        appendU32(out, static_cast<uint32_t>(entry.type));
+        appendU32(out, entry.cacheValid ? RECORD_FLAG_CACHE_VALID : 0);
+        appendU64(out, entry.importTime);
+        appendU64(out, entry.sourceModTime);
+    }
+
+    bool decodeEntry(ByteReader& reader, AssetEntry& entry) {
+        uint32_t type = 0;
+        uint32_t flags = 0;
+        if (!reader.readString(entry.uuid) || !reader.readString(entry.name) ||
+            !reader.readString(entry.projectPath) || !reader.readString(entry.cachePath) ||
+            !reader.read(type) || !reader.read(flags) ||
+            !reader.read(entry.importTime) || !reader.read(entry.sourceModTime)) {
+            return false;
+        }
+        entry.type = static_cast<AssetType>(type);
+        entry.cacheValid = (flags & RECORD_FLAG_CACHE_VALID) != 0;
+        return true;
+    }
 }
 
 void AssetRegistry::loadFromProject(const fs::path& projectPath) {
     clear();
     m_projectPath = projectPath;
 
+    // Caches are trusted as recorded; the watcher picks up edits from here on
+    restartWatcher();
+
     fs::path registryFile = getRegistryFilePath();
-    if (!fs::exists(registryFile)) {
-        std::cout << "AssetRegistry: No registry file found, starting fresh" << std::endl;
+    if (fs::exists(registryFile) && mapRegistry(registryFile)) {
+        m_assetCount = m_recordCount;
+        size_t replayed = replayJournal(getJournalFilePath());
+        std::cout << "AssetRegistry: Loaded " << m_assetCount << " assets";
+        if (replayed > 0) {
+            std::cout << " (" << replayed << " journal changes)";
+        }
+        std::cout << std::endl;
         return;
     }
 
-    std::ifstream file(registryFile);
-    if (!file.is_open()) {
-        std::cerr << "AssetRegistry: Failed to open registry file" << std::endl;
+    // Legacy projects only have the JSON registry; convert on next save
+    fs::path legacyFile = getLegacyJsonPath();
+    if (fs::exists(legacyFile)) {
+        if (importJson(legacyFile)) {
+            std::cout << "AssetRegistry: Loaded " << m_assetCount
+                      << " assets from legacy JSON registry" << std::endl;
+        }
         return;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string json = buffer.str();
+    std::cout << "AssetRegistry: No registry file found, starting fresh" << std::endl;
+}
+
+void AssetRegistry::save() {
+    if (m_projectPath.empty()) {
+        std::cerr << "AssetRegistry: No project path set" << std::endl;
+        return;
+    }
+
+    size_t journalLimit = std::max(JOURNAL_MIN_COMPACT, m_assetCount / JOURNAL_COMPACT_DIVISOR);
+    if (m_needsFullWrite || m_journalRecordCount + m_pendingChanges.size() > journalLimit) {
+        compact();
+        return;
+    }
+
+    if (m_pendingChanges.empty()) {
+        m_dirty = false;
+        return;
+    }
+
+    if (!appendJournal(m_pendingChanges)) {
+        std::cerr << "AssetRegistry: Journal append failed, rewriting registry" << std::endl;
+        compact();
+        return;
+    }
+
+    m_journalRecordCount += m_pendingChanges.size();
+    std::cout << "AssetRegistry: Journaled " << m_pendingChanges.size() << " changes" << std::endl;
+    m_pendingChanges.clear();
+    m_dirty = false;
+}
+
+void AssetRegistry::compact() {
+    if (m_projectPath.empty()) {
+        std::cerr << "AssetRegistry: No project path set" << std::endl;
+        return;
+    }
 
-    // Find assets array
-    size_t assetsPos = json.find("\"assets\"");
-    if (assetsPos == std::string::npos) {
+    std::vector<AssetEntry> entries;
+    entries.reserve(m_assetCount);
+    forEachAsset([&entries](const AssetEntry& entry) { entries.push_back(entry); });
+
+    // Write to a temp file and swap it in so a crash never leaves a half-written registry.
+    // The journal is reset afterwards; if we die in between, its stale generation makes it ignored.
+    uint64_t newGeneration = m_generation + 1;
+    fs::path registryFile = getRegistryFilePath();
+    fs::path tempFile = registryFile;
+    tempFile += ".tmp";
+
+    if (!writeBinary(tempFile, entries, newGeneration)) {
+        std::cerr << "AssetRegistry: Failed to create registry file" << std::endl;
         return;
     }
 
-    size_t arrayStart = json.find('[', assetsPos);
-    size_t arrayEnd = json.find_last_of(']');
-    if (arrayStart == std::string::npos || arrayEnd == std::string::npos) {
+    // Windows can't replace a mapped file, so drop the mapping first. If the new file can't
+    // be mapped after all, every entry goes into the overlay and the write is retried on next save.
+    auto keepInOverlay = [this, &entries]() {
+        unmapRegistry();
+        m_overrides.clear();
+        m_overridePaths.clear();
+        m_assetCount = 0;
+        for (const auto& entry : entries) {
+            setOverride(entry.uuid, entry);
+        }
+        m_needsFullWrite = true;
+    };
+
+    unmapRegistry();
+    try {
+        fs::rename(tempFile, registryFile);
+    } catch (const std::exception& e) {
+        std::cerr << "AssetRegistry: Failed to replace registry file: " << e.what() << std::endl;
+        keepInOverlay();
         return;
     }
 
-    std::string assetsArray = json.substr(arrayStart, arrayEnd - arrayStart + 1);
-    auto assetObjects = extractJsonArray(assetsArray);
+    if (!mapRegistry(registryFile)) {
+        std::cerr << "AssetRegistry: Failed to map rewritten registry file" << std::endl;
+        keepInOverlay();
+        return;
+    }
+
+    m_overrides.clear();
+    m_overridePaths.clear();
+    m_assetCount = m_recordCount;
+    m_generation = newGeneration;
+    m_journalRecordCount = 0;
+    m_pendingChanges.clear();
+    m_needsFullWrite = !resetJournal(newGeneration);
+    m_dirty = false;
+    std::cout << "AssetRegistry: Saved " << m_assetCount << " assets" << std::endl;
+}
+
+void AssetRegistry::clear() {
+    unmapRegistry();
+    m_overrides.clear();
+    m_overridePaths.clear();
+    m_assetCount = 0;
+    m_pendingChanges.clear();
+    m_generation = 0;
+    m_journalRecordCount = 0;
+    m_needsFullWrite = true;
+    m_dirty = false;
+}
+
+bool AssetRegistry::mapRegistry(const fs::path& registryFile) {
+    unmapRegistry();
+    if (!m_file.open(registryFile)) {
+        std::cerr << "AssetRegistry: Failed to open registry file" << std::endl;
+        return false;
+    }
+
+    const AssetRegistryHeader* header = m_file.at<AssetRegistryHeader>(0);
+    if (!header || std::strncmp(header->magic, REGISTRY_MAGIC, 8) != 0 ||
+        header->version < 1 || header->version > REGISTRY_VERSION) {
+        std::cerr << "AssetRegistry: Invalid registry file header" << std::endl;
+        unmapRegistry();
+        return false;
+    }
+
+    uint32_t count = header->entryCount;
+    bool hasPathTable = header->version >= 2;
+    size_t recordsOffset = sizeof(AssetRegistryHeader);
+    size_t pathOrderOffset = recordsOffset + sizeof(AssetRegistryRecord) * count;
+    size_t poolOffset = pathOrderOffset + (hasPathTable ? sizeof(uint32_t) * count : 0);
+    const AssetRegistryRecord* records = m_file.at<AssetRegistryRecord>(recordsOffset, count);
+    const uint32_t* pathOrder = hasPathTable ? m_file.at<uint32_t>(pathOrderOffset, count) : nullptr;
+    const char* pool = m_file.at<char>(poolOffset, header->stringPoolSize);
+    if (!records || (hasPathTable && !pathOrder) || (header->stringPoolSize > 0 && !pool)) {
+        std::cerr << "AssetRegistry: Truncated registry file" << std::endl;
+        unmapRegistry();
+        return false;
+    }
+
+    // Check every reference once so lookups can trust the table
+    uint64_t poolSize = header->stringPoolSize;
+    auto inPool = [poolSize](uint32_t offset, uint32_t length) {
+        return static_cast<uint64_t>(offset) + length <= poolSize;
+    };
+    for (uint32_t i = 0; i < count; ++i) {
+        const AssetRegistryRecord& record = records[i];
+        if (!inPool(record.uuidOffset, record.uuidLength) || !inPool(record.nameOffset, record.nameLength) ||
+            !inPool(record.projectPathOffset, record.projectPathLength) ||
+            !inPool(record.cachePathOffset, record.cachePathLength) || (pathOrder && pathOrder[i] >= count)) {
+            std::cerr << "AssetRegistry: Corrupt string pool reference in registry file" << std::endl;
+            unmapRegistry();
+            return false;
+        }
+    }
+
+    m_records = records;
+    m_pool = pool;
+    m_recordCount = count;
+    m_pathOrder = pathOrder;
+    m_generation = header->generation;
+    m_needsFullWrite = false;
+
+    if (!hasPathTable) {
+        // Version 1: sort the path order here and upgrade the file on next save
+        m_pathOrderStorage.resize(count);
+        std::iota(m_pathOrderStorage.begin(), m_pathOrderStorage.end(), 0u);
+        std::sort(m_pathOrderStorage.begin(), m_pathOrderStorage.end(), [this](uint32_t a, uint32_t b) {
+            return recordString(m_records[a].projectPathOffset, m_records[a].projectPathLength) <
+                   recordString(m_records[b].projectPathOffset, m_records[b].projectPathLength);
+        });
+        m_pathOrder = m_pathOrderStorage.data();
+        m_needsFullWrite = true;
+    }
+    return true;
+}
+
+void AssetRegistry::unmapRegistry() {
+    m_file.close();
+    m_records = nullptr;
+    m_pathOrder = nullptr;
+    m_pathOrderStorage.clear();
+    m_pool = nullptr;
+    m_recordCount = 0;
+}
+
+bool AssetRegistry::writeBinary(const fs::path& registryFile, const std::vector<AssetEntry>& entries,
+                                uint64_t generation) const {
+    // Records are sorted by uuid and the path table by projectPath so both can be binary searched in place
+    std::vector<size_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&entries](size_t a, size_t b) {
+        return entries[a].uuid < entries[b].uuid;
+    });
+
+    std::vector<uint32_t> pathOrder(entries.size());
+    std::iota(pathOrder.begin(), pathOrder.end(), 0u);
+    std::sort(pathOrder.begin(), pathOrder.end(), [&entries, &order](uint32_t a, uint32_t b) {
+        return entries[order[a]].projectPath < entries[order[b]].projectPath;
+    });
+
+    std::vector<AssetRegistryRecord> records;
+    records.reserve(entries.size());
+    std::string pool;
+
+    auto addString = [&pool](const std::string& str, uint32_t& offset, uint32_t& length) {
+        offset = static_cast<uint32_t>(pool.size());
+        length = static_cast<uint32_t>(str.size());
+        pool += str;
+    };
+
+    for (size_t idx : order) {
+        const AssetEntry& entry = entries[idx];
+        AssetRegistryRecord record{};
+        addString(entry.uuid, record.uuidOffset, record.uuidLength);
+        addString(entry.name, record.nameOffset, record.nameLength);
+        addString(entry.projectPath, record.projectPathOffset, record.projectPathLength);
+        addString(entry.cachePath, record.cachePathOffset, record.cachePathLength);
+        record.type = static_cast<uint32_t>(entry.type);
+        record.flags = entry.cacheValid ? RECORD_FLAG_CACHE_VALID : 0;
+        record.importTime = entry.importTime;
+        record.sourceModTime = entry.sourceModTime;
+        records.push_back(record);
+    }
+
+    if (pool.size() > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "AssetRegistry: String pool exceeds 4GB" << std::endl;
+        return false;
+    }
+
+    AssetRegistryHeader header{};
+    std::memcpy(header.magic, REGISTRY_MAGIC, 8);
+    header.version = REGISTRY_VERSION;
+    header.entryCount = static_cast<uint32_t>(records.size());
+    header.generation = generation;
+    header.stringPoolSize = pool.size();
 
-    for (const auto& obj : assetObjects) {
+    std::ofstream file(registryFile, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!records.empty()) {
+        file.write(reinterpret_cast<const char*>(records.data()),
+                   records.size() * sizeof(AssetRegistryRecord));
+        file.write(reinterpret_cast<const char*>(pathOrder.data()), pathOrder.size() * sizeof(uint32_t));
+    }
+    file.write(pool.data(), pool.size());
+    return file.good();
+}
+
+size_t AssetRegistry::replayJournal(const fs::path& journalFile) {
+    if (!fs::exists(journalFile)) {
+        return 0;
+    }
+
+    MappedFile file(journalFile);
+    const AssetJournalHeader* header = file.at<AssetJournalHeader>(0);
+    if (!header || std::strncmp(header->magic, JOURNAL_MAGIC, 8) != 0 ||
+        header->version != JOURNAL_VERSION) {
+        std::cerr << "AssetRegistry: Ignoring invalid journal file" << std::endl;
+        m_needsFullWrite = true;
+        return 0;
+    }
+
+    // Journal left over from before the last full write - its changes are already in the registry
+    if (header->generation != m_generation) {
+        m_needsFullWrite = true;
+        return 0;
+    }
+
+    size_t offset = sizeof(AssetJournalHeader);
+    size_t replayed = 0;
+
+    while (offset < file.size()) {
+        const AssetJournalRecordHeader* record = file.at<AssetJournalRecordHeader>(offset);
+        const uint8_t* payload = record
+            ? file.at<uint8_t>(offset + sizeof(AssetJournalRecordHeader), record->payloadSize)
+            : nullptr;
+        if (!payload || fnv1a32(payload, record->payloadSize) != record->checksum) {
+            // Torn append from a crash - drop the tail and rewrite on next save
+            std::cerr << "AssetRegistry: Journal truncated after " << replayed << " records" << std::endl;
+            m_needsFullWrite = true;
+            break;
+        }
+
+        ByteReader reader{ payload, payload + record->payloadSize };
         AssetEntry entry;
-        entry.uuid = extractJsonValue(obj, "uuid");
-        entry.name = extractJsonValue(obj, "name");
-        entry.projectPath = extractJsonValue(obj, "projectPath");
-        entry.cachePath = extractJsonValue(obj, "cachePath");
-        entry.type = stringToAssetType(extractJsonValue(obj, "type"));
+        auto op = static_cast<AssetJournalOp>(record->op);
+        bool decoded = (op == AssetJournalOp::Remove) ? reader.readString(entry.uuid)
+                                                      : decodeEntry(reader, entry);
+        if (!decoded) {
+            m_needsFullWrite = true;
+            break;
+        }
 
-        std::string importTimeStr = extractJsonValue(obj, "importTime");
-        entry.importTime = importTimeStr.empty() ? 0 : std::stoull(importTimeStr);
+        switch (op) {
+            case AssetJournalOp::Add:
+            case AssetJournalOp::Update: {
+                std::string uuid = entry.uuid;
+                setOverride(uuid, std::move(entry));
+                break;
+            }
+            case AssetJournalOp::Remove:
+                if (contains(entry.uuid)) {
+                    setOverride(entry.uuid, std::nullopt);
+                }
+                break;
+            default:
+                m_needsFullWrite = true;
+                break;
+        }
+
+        offset += sizeof(AssetJournalRecordHeader) + record->payloadSize;
+        ++replayed;
+    }
 
-        std::string modTimeStr = extractJsonValue(obj, "sourceModTime");
-        entry.sourceModTime = modTimeStr.empty() ? 0 : std::stoull(modTimeStr);
+    m_journalRecordCount = replayed;
+    return replayed;
+}
 
-        std::string cacheValidStr = extractJsonValue(obj, "cacheValid");
-        entry.cacheValid = (cacheValidStr == "true");
+bool AssetRegistry::appendJournal(const std::vector<JournalEntry>& changes) {
+    fs::path journalFile = getJournalFilePath();
+    if (!fs::exists(journalFile) && !resetJournal(m_generation)) {
+        return false;
+    }
 
-        if (!entry.uuid.empty()) {
-            m_assets.push_back(entry);
+    // Encode everything first so the append is a single write
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> payload;
+    for (const auto& change : changes) {
+        payload.clear();
+        if (change.op == AssetJournalOp::Remove) {
+            appendString(payload, change.entry.uuid);
+        } else {
+            encodeEntry(payload, change.entry);
         }
+
+        AssetJournalRecordHeader record{};
+        record.op = static_cast<uint32_t>(change.op);
+        record.payloadSize = static_cast<uint32_t>(payload.size());
+        record.checksum = fnv1a32(payload.data(), payload.size());
+
+        const uint8_t* recordBytes = reinterpret_cast<const uint8_t*>(&record);
+        buffer.insert(buffer.end(), recordBytes, recordBytes + sizeof(record));
+        buffer.insert(buffer.end(), payload.begin(), payload.end());
     }
 
-    rebuildIndex();
-    std::cout << "AssetRegistry: Loaded " << m_assets.size() << " assets" << std::endl;
+    std::ofstream file(journalFile, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    file.flush();
+    return file.good();
 }
 
-void AssetRegistry::save() {
-    if (m_projectPath.empty()) {
-        std::cerr << "AssetRegistry: No project path set" << std::endl;
-        return;
+bool AssetRegistry::resetJournal(uint64_t generation) {
+    AssetJournalHeader header{};
+    std::memcpy(header.magic, JOURNAL_MAGIC, 8);
+    header.version = JOURNAL_VERSION;
+    header.generation = generation;
+
+    std::ofstream file(getJournalFilePath(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "AssetRegistry: Failed to reset journal file" << std::endl;
+        return false;
     }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return file.good();
+}
 
-    std::ofstream file(getRegistryFilePath());
+bool AssetRegistry::exportJson(const fs::path& jsonPath) const {
+    std::ofstream file(jsonPath);
     if (!file.is_open()) {
-        std::cerr << "AssetRegistry: Failed to create registry file" << std::endl;
-        return;
+        std::cerr << "AssetRegistry: Failed to create JSON file: " << jsonPath << std::endl;
+        return false;
     }
 
     file << "{\n";
     file << "  \"version\": 1,\n";
-    file << "  \"assets\": [\n";
+    file << "  \"assets\": [";
 
-    for (size_t i = 0; i < m_assets.size(); ++i) {
-        const auto& entry = m_assets[i];
+    bool first = true;
+    forEachAsset([&file, &first](const AssetEntry& entry) {
+        file << (first ? "\n" : ",\n");
+        first = false;
         file << "    {\n";
         file << "      \"uuid\": \"" << escapeJson(entry.uuid) << "\",\n";
         file << "      \"name\": \"" << escapeJson(entry.name) << "\",\n";
@@ -213,136 +666,318 @@ void AssetRegistry::save() {
         file << "      \"sourceModTime\": " << entry.sourceModTime << ",\n";
         file << "      \"cacheValid\": " << (entry.cacheValid ? "true" : "false") << "\n";
         file << "    }";
-        if (i < m_assets.size() - 1) file << ",";
-        file << "\n";
-    }
+    });
 
-    file << "  ]\n";
+    file << "\n  ]\n";
     file << "}\n";
 
-    m_dirty = false;
-    std::cout << "AssetRegistry: Saved " << m_assets.size() << " assets" << std::endl;
+    std::cout << "AssetRegistry: Exported " << m_assetCount << " assets to " << jsonPath << std::endl;
+    return file.good();
 }
 
-void AssetRegistry::clear() {
-    m_assets.clear();
-    m_uuidIndex.clear();
-    m_pathIndex.clear();
-    m_dirty = false;
-}
+bool AssetRegistry::importJson(const fs::path& jsonPath) {
+    std::ifstream file(jsonPath);
+    if (!file.is_open()) {
+        std::cerr << "AssetRegistry: Failed to open JSON file: " << jsonPath << std::endl;
+        return false;
+    }
 
-void AssetRegistry::rebuildIndex() {
-    m_uuidIndex.clear();
-    m_pathIndex.clear();
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    std::vector<AssetEntry> entries;
+    if (!parseJsonAssets(buffer.str(), entries)) {
+        return false;
+    }
 
-    for (size_t i = 0; i < m_assets.size(); ++i) {
-        m_uuidIndex[m_assets[i].uuid] = i;
-        m_pathIndex[m_assets[i].projectPath] = i;
+    // Replaces the whole registry: everything lives in the overlay until the next full write
+    unmapRegistry();
+    m_overrides.clear();
+    m_overridePaths.clear();
+    m_assetCount = 0;
+    m_pendingChanges.clear();
+
+    m_overrides.reserve(entries.size());
+    m_overridePaths.reserve(entries.size());
+    for (auto& entry : entries) {
+        if (m_overrides.count(entry.uuid) == 0) {
+            std::string uuid = entry.uuid;
+            setOverride(uuid, std::move(entry));
+        }
     }
+
+    m_needsFullWrite = true;
+    m_dirty = true;
+    return true;
 }
 
-const AssetEntry* AssetRegistry::findByUuid(const std::string& uuid) const {
-    auto it = m_uuidIndex.find(uuid);
-    if (it != m_uuidIndex.end()) {
-        return &m_assets[it->second];
+const AssetRegistryRecord* AssetRegistry::findRecord(std::string_view uuid) const {
+    const AssetRegistryRecord* end = m_records + m_recordCount;
+    const AssetRegistryRecord* it = std::lower_bound(m_records, end, uuid,
+        [this](const AssetRegistryRecord& record, std::string_view key) {
+            return recordString(record.uuidOffset, record.uuidLength) < key;
+        });
+    if (it != end && recordString(it->uuidOffset, it->uuidLength) == uuid) {
+        return it;
     }
     return nullptr;
 }
 
-const AssetEntry* AssetRegistry::findByPath(const std::string& projectPath) const {
-    auto it = m_pathIndex.find(projectPath);
-    if (it != m_pathIndex.end()) {
-        return &m_assets[it->second];
+AssetEntry AssetRegistry::decodeRecord(const AssetRegistryRecord& record) const {
+    AssetEntry entry;
+    entry.uuid = recordString(record.uuidOffset, record.uuidLength);
+    entry.name = recordString(record.nameOffset, record.nameLength);
+    entry.projectPath = recordString(record.projectPathOffset, record.projectPathLength);
+    entry.cachePath = recordString(record.cachePathOffset, record.cachePathLength);
+    entry.type = static_cast<AssetType>(record.type);
+    entry.importTime = record.importTime;
+    entry.sourceModTime = record.sourceModTime;
+    entry.cacheValid = (record.flags & RECORD_FLAG_CACHE_VALID) != 0;
+    return entry;
+}
+
+bool AssetRegistry::contains(const std::string& uuid) const {
+    auto it = m_overrides.find(uuid);
+    if (it != m_overrides.end()) {
+        return it->second.has_value();
     }
-    return nullptr;
+    return findRecord(uuid) != nullptr;
+}
+
+void AssetRegistry::setOverride(const std::string& uuidRef, std::optional<AssetEntry> entry) {
+    // Copy first - uuidRef may alias the override being replaced
+    std::string uuid = uuidRef;
+    bool existed = contains(uuid);
+
+    auto it = m_overrides.find(uuid);
+    if (it != m_overrides.end() && it->second) {
+        auto pathIt = m_overridePaths.find(it->second->projectPath);
+        if (pathIt != m_overridePaths.end() && pathIt->second == uuid) {
+            m_overridePaths.erase(pathIt);
+        }
+    }
+
+    if (entry) {
+        m_overridePaths[entry->projectPath] = uuid;
+        m_assetCount += existed ? 0 : 1;
+    } else if (existed) {
+        --m_assetCount;
+    }
+
+    if (!entry && !findRecord(uuid)) {
+        // Nothing mapped to shadow
+        if (it != m_overrides.end()) {
+            m_overrides.erase(it);
+        }
+        return;
+    }
+    m_overrides[uuid] = std::move(entry);
+}
+
+void AssetRegistry::recordChange(AssetJournalOp op, const AssetEntry& entry) {
+    if (op == AssetJournalOp::Remove) {
+        AssetEntry removed;
+        removed.uuid = entry.uuid;
+        m_pendingChanges.push_back({ op, std::move(removed) });
+    } else {
+        m_pendingChanges.push_back({ op, entry });
+    }
+    m_dirty = true;
+}
+
+void AssetRegistry::forEachAsset(const std::function<void(const AssetEntry&)>& callback) const {
+    for (uint32_t i = 0; i < m_recordCount; ++i) {
+        const AssetRegistryRecord& record = m_records[i];
+        if (m_overrides.empty() ||
+            m_overrides.count(std::string(recordString(record.uuidOffset, record.uuidLength))) == 0) {
+            callback(decodeRecord(record));
+        }
+    }
+    for (const auto& [uuid, entry] : m_overrides) {
+        if (entry) {
+            callback(*entry);
+        }
+    }
+}
+
+std::optional<AssetEntry> AssetRegistry::findByUuid(const std::string& uuid) const {
+    auto it = m_overrides.find(uuid);
+    if (it != m_overrides.end()) {
+        return it->second;
+    }
+    if (const AssetRegistryRecord* record = findRecord(uuid)) {
+        return decodeRecord(*record);
+    }
+    return std::nullopt;
+}
+
+std::optional<AssetEntry> AssetRegistry::findByPath(const std::string& projectPath) const {
+    auto pathIt = m_overridePaths.find(projectPath);
+    if (pathIt != m_overridePaths.end()) {
+        return m_overrides.at(pathIt->second);
+    }
+
+    auto pathOf = [this](uint32_t index) {
+        const AssetRegistryRecord& record = m_records[index];
+        return recordString(record.projectPathOffset, record.projectPathLength);
+    };
+    const uint32_t* end = m_pathOrder + m_recordCount;
+    const uint32_t* it = std::lower_bound(m_pathOrder, end, std::string_view(projectPath),
+        [&pathOf](uint32_t index, std::string_view key) { return pathOf(index) < key; });
+
+    // Skip records whose uuid was changed or removed since the file was written
+    for (; it != end && pathOf(*it) == projectPath; ++it) {
+        const AssetRegistryRecord& record = m_records[*it];
+        if (m_overrides.count(std::string(recordString(record.uuidOffset, record.uuidLength))) == 0) {
+            return decodeRecord(record);
+        }
+    }
+    return std::nullopt;
 }
 
 std::vector<AssetEntry> AssetRegistry::getAssetsByType(AssetType type) const {
     std::vector<AssetEntry> result;
-    for (const auto& entry : m_assets) {
+    forEachAsset([&result, type](const AssetEntry& entry) {
         if (entry.type == type) {
             result.push_back(entry);
         }
-    }
+    });
     return result;
 }
 
 void AssetRegistry::addAsset(const AssetEntry& entry) {
     // Check for duplicate
-    if (m_uuidIndex.count(entry.uuid) > 0) {
+    if (contains(entry.uuid)) {
         std::cerr << "AssetRegistry: Asset with UUID already exists: " << entry.uuid << std::endl;
         return;
     }
 
-    m_assets.push_back(entry);
-    size_t idx = m_assets.size() - 1;
-    m_uuidIndex[entry.uuid] = idx;
-    m_pathIndex[entry.projectPath] = idx;
-    m_dirty = true;
+    setOverride(entry.uuid, entry);
+    recordChange(AssetJournalOp::Add, entry);
 }
 
 void AssetRegistry::updateAsset(const AssetEntry& entry) {
-    auto it = m_uuidIndex.find(entry.uuid);
-    if (it != m_uuidIndex.end()) {
-        // Update path index if path changed
-        const std::string& oldPath = m_assets[it->second].projectPath;
-        if (oldPath != entry.projectPath) {
-            m_pathIndex.erase(oldPath);
-            m_pathIndex[entry.projectPath] = it->second;
-        }
-
-        m_assets[it->second] = entry;
-        m_dirty = true;
+    if (contains(entry.uuid)) {
+        setOverride(entry.uuid, entry);
+        recordChange(AssetJournalOp::Update, entry);
     }
 }
 
 void AssetRegistry::removeAsset(const std::string& uuid) {
-    auto it = m_uuidIndex.find(uuid);
-    if (it == m_uuidIndex.end()) {
+    if (!contains(uuid)) {
         return;
     }
 
-    size_t idx = it->second;
-    const std::string& path = m_assets[idx].projectPath;
-
-    m_pathIndex.erase(path);
-    m_uuidIndex.erase(uuid);
-
-    // Remove from vector (swap with last and pop)
-    if (idx < m_assets.size() - 1) {
-        m_assets[idx] = std::move(m_assets.back());
-        // Update indices for moved element
-        m_uuidIndex[m_assets[idx].uuid] = idx;
-        m_pathIndex[m_assets[idx].projectPath] = idx;
-    }
-    m_assets.pop_back();
-    m_dirty = true;
+    AssetEntry removed;
+    removed.uuid = uuid;
+    setOverride(removed.uuid, std::nullopt);
+    recordChange(AssetJournalOp::Remove, removed);
 }
 
 void AssetRegistry::invalidateCache(const std::string& uuid) {
-    auto it = m_uuidIndex.find(uuid);
-    if (it != m_uuidIndex.end()) {
-        m_assets[it->second].cacheValid = false;
-        m_dirty = true;
+    std::optional<AssetEntry> entry = findByUuid(uuid);
+    if (entry && entry->cacheValid) {
+        entry->cacheValid = false;
+        setOverride(uuid, entry);
+        recordChange(AssetJournalOp::Update, *entry);
     }
 }
 
 void AssetRegistry::validateCache(const std::string& uuid) {
-    auto it = m_uuidIndex.find(uuid);
-    if (it != m_uuidIndex.end()) {
-        m_assets[it->second].cacheValid = true;
-        m_dirty = true;
+    std::optional<AssetEntry> entry = findByUuid(uuid);
+    if (entry && !entry->cacheValid) {
+        entry->cacheValid = true;
+        setOverride(uuid, entry);
+        recordChange(AssetJournalOp::Update, *entry);
     }
 }
 
 void AssetRegistry::refreshAll() {
-    for (auto& entry : m_assets) {
+    std::vector<AssetEntry> entries;
+    entries.reserve(m_assetCount);
+    forEachAsset([&entries](const AssetEntry& entry) { entries.push_back(entry); });
+
+    std::vector<uint8_t> valid = validateEntries(entries);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        AssetEntry& entry = entries[i];
+        if ((valid[i] != 0) != entry.cacheValid) {
+            entry.cacheValid = valid[i] != 0;
+            setOverride(entry.uuid, entry);
+            recordChange(AssetJournalOp::Update, entry);
+        }
+    }
+}
+
+std::vector<uint8_t> AssetRegistry::validateEntries(const std::vector<AssetEntry>& entries) const {
+    // Each check stats the source and reads the cache header - I/O bound, so spread it out
+    std::vector<uint8_t> valid(entries.size(), 0);
+    ThreadPool::getInstance().parallelFor(entries.size(), [&](size_t i) {
+        const AssetEntry& entry = entries[i];
         fs::path sourcePath = resolveAssetPath(entry.projectPath);
         fs::path cachePath = resolveCachePath(entry.cachePath);
+        if (entry.type == AssetType::Texture) {
+            valid[i] = TextureCache::isValid(cachePath, sourcePath, TextureCache::guessTextureType(sourcePath)) ? 1 : 0;
+        } else {
+            valid[i] = MeshCache::isValid(cachePath, sourcePath) ? 1 : 0;
+        }
+    }, 16);
+    return valid;
+}
+
+void AssetRegistry::setFileWatchingEnabled(bool enabled) {
+    m_fileWatchingEnabled = enabled;
+    restartWatcher();
+}
 
-        entry.cacheValid = MeshCache::isValid(cachePath, sourcePath);
+void AssetRegistry::restartWatcher() {
+    if (m_watcher) {
+        m_watcher->stop();
     }
-    m_dirty = true;
+
+    if (!m_fileWatchingEnabled || m_projectPath.empty() || !fs::exists(getAssetsPath())) {
+        return;
+    }
+
+    if (!m_watcher) {
+        m_watcher = std::make_unique<AssetWatcher>();
+    }
+    m_watcher->start(getAssetsPath());
+}
+
+std::vector<std::string> AssetRegistry::processFileChanges() {
+    std::vector<std::string> staleUuids;
+    if (!isFileWatching()) {
+        return staleUuids;
+    }
+
+    std::vector<std::string> changedPaths = m_watcher->pollChanges(FILE_CHANGE_DEBOUNCE);
+    if (changedPaths.empty()) {
+        return staleUuids;
+    }
+
+    // Only registered sources matter; new files still go through the importer
+    std::vector<AssetEntry> entries;
+    for (const auto& path : changedPaths) {
+        if (std::optional<AssetEntry> entry = findByPath(path)) {
+            entries.push_back(std::move(*entry));
+        }
+    }
+
+    std::vector<uint8_t> valid = validateEntries(entries);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        AssetEntry& entry = entries[i];
+        if (valid[i]) {
+            continue;
+        }
+        staleUuids.push_back(entry.uuid);
+        if (entry.cacheValid) {
+            entry.cacheValid = false;
+            setOverride(entry.uuid, entry);
+            recordChange(AssetJournalOp::Update, entry);
+        }
+    }
+
+    return staleUuids;
 }
 
 fs::path AssetRegistry::resolveAssetPath(const std::string& projectPath) const {
@@ -0,0 +1,197 @@
+#include "asset/AssetWatcher.h"
+#include <iostream>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+namespace MiEngine {
+
+AssetWatcher::~AssetWatcher() {
+    stop();
+}
+
+bool AssetWatcher::isSupported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool AssetWatcher::start(const fs::path& rootPath) {
+    stop();
+
+#ifdef __linux__
+    if (!fs::is_directory(rootPath)) {
+        std::cerr << "AssetWatcher: Not a directory: " << rootPath << std::endl;
+        return false;
+    }
+
+    m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_InotifyFd < 0) {
+        std::cerr << "AssetWatcher: inotify_init1 failed" << std::endl;
+        return false;
+    }
+
+    m_WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_WakeFd < 0) {
+        close(m_InotifyFd);
+        m_InotifyFd = -1;
+        return false;
+    }
+
+    m_RootPath = rootPath;
+    addWatchRecursive(rootPath);
+
+    m_Running = true;
+    m_Thread = std::thread([this]() { threadMain(); });
+
+    std::cout << "AssetWatcher: Watching " << rootPath << " (" << m_WatchDirs.size()
+              << " directories)" << std::endl;
+    return true;
+#else
+    (void)rootPath;
+    return false;
+#endif
+}
+
+void AssetWatcher::stop() {
+    if (!m_Running.exchange(false)) {
+        return;
+    }
+
+#ifdef __linux__
+    uint64_t wake = 1;
+    if (write(m_WakeFd, &wake, sizeof(wake)) < 0) {
+        // Thread still exits on its next poll timeout
+    }
+#endif
+
+    if (m_Thread.joinable()) {
+        m_Thread.join();
+    }
+
+#ifdef __linux__
+    close(m_InotifyFd);
+    close(m_WakeFd);
+    m_InotifyFd = -1;
+    m_WakeFd = -1;
+    m_WatchDirs.clear();
+#endif
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_PendingChanges.clear();
+}
+
+std::vector<std::string> AssetWatcher::pollChanges(std::chrono::milliseconds debounce) {
+    std::vector<std::string> ready;
+    auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto it = m_PendingChanges.begin(); it != m_PendingChanges.end(); ) {
+        if (now - it->second >= debounce) {
+            ready.push_back(it->first);
+            it = m_PendingChanges.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return ready;
+}
+
+void AssetWatcher::queueChange(const std::string& relativePath) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_PendingChanges[relativePath] = Clock::now();
+}
+
+#ifdef __linux__
+
+void AssetWatcher::addWatchRecursive(const fs::path& dir) {
+    constexpr uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                              IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+
+    int wd = inotify_add_watch(m_InotifyFd, dir.c_str(), mask);
+    if (wd < 0) {
+        std::cerr << "AssetWatcher: Failed to watch " << dir << std::endl;
+        return;
+    }
+    m_WatchDirs[wd] = dir;
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+            addWatchRecursive(entry.path());
+        }
+    }
+}
+
+void AssetWatcher::threadMain() {
+    alignas(struct inotify_event) char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+
+    pollfd fds[2];
+    fds[0].fd = m_InotifyFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_WakeFd;
+    fds[1].events = POLLIN;
+
+    while (m_Running.load()) {
+        if (poll(fds, 2, 500) <= 0 || (fds[1].revents & POLLIN)) {
+            continue;
+        }
+
+        ssize_t length;
+        while ((length = read(m_InotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length; ) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                ptr += sizeof(struct inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    std::cerr << "AssetWatcher: Event queue overflow, some changes were missed" << std::endl;
+                    continue;
+                }
+
+                auto dirIt = m_WatchDirs.find(event->wd);
+                if (dirIt == m_WatchDirs.end()) {
+                    continue;
+                }
+
+                if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                    m_WatchDirs.erase(dirIt);
+                    continue;
+                }
+
+                if (event->len == 0) {
+                    continue;
+                }
+
+                fs::path fullPath = dirIt->second / event->name;
+
+                // New directories need their own watch; files copied into them arrive later
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        addWatchRecursive(fullPath);
+                    }
+                    continue;
+                }
+
+                std::string relative = fs::relative(fullPath, m_RootPath).generic_string();
+                queueChange(relative);
+            }
+        }
+    }
+}
+
+#else
+
+void AssetWatcher::threadMain() {
+}
+
+#endif
+
+} // namespace MiEngine
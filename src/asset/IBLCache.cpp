@@ -0,0 +1,297 @@
+#include "asset/IBLCache.h"
+#include "core/Hash.h"
+#include "core/ThreadPool.h"
+#include "texture/MipGenerator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace MiEngine {
+
+namespace {
+
+struct IBLCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t encoding;
+    uint32_t faceSize;
+    uint32_t mipLevels;
+    uint64_t sourceHash;
+    IBLCacheSettings settings;
+    uint64_t payloadSize;
+};
+
+static_assert(sizeof(IBLCacheSettings) == 24, "IBLCacheSettings is stored verbatim");
+static_assert(sizeof(IBLCacheHeader) == 64, "IBL cache header is 64 bytes");
+
+constexpr int RGB9E5_MANTISSA_BITS = 9;
+constexpr int RGB9E5_EXPONENT_BIAS = 15;
+constexpr float RGB9E5_MAX = 511.0f / 512.0f * 65536.0f;
+constexpr float HALF_MAX = 65504.0f;
+
+// Texels per decode/encode task
+constexpr size_t TEXEL_BLOCK = 16384;
+
+// FNV-1a over 8-byte words (bytes for the tail), so hashing an HDR runs near memory speed
+uint64_t hashBytes(const uint8_t* data, size_t size) {
+    uint64_t hash = FNV1A64_OFFSET;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * FNV1A64_PRIME;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV1A64_PRIME;
+    }
+    hash ^= size;
+    // Final mix so every input bit reaches the low bits used in file names
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+const std::array<float, 32>& rgb9e5Scales() {
+    static const std::array<float, 32> scales = [] {
+        std::array<float, 32> table{};
+        for (int e = 0; e < 32; ++e) {
+            table[e] = std::ldexp(1.0f, e - RGB9E5_EXPONENT_BIAS - RGB9E5_MANTISSA_BITS);
+        }
+        return table;
+    }();
+    return scales;
+}
+
+const char* kindName(IBLCacheKind kind) {
+    return kind == IBLCacheKind::PrefilterMap ? "prefilter" : "environment";
+}
+
+} // anonymous namespace
+
+size_t IBLCacheFile::getFloatCount() const {
+    return IBLCache::getTexelCount(faceSize, mipLevels) * 4;
+}
+
+void IBLCacheFile::decode(float* dst) const {
+    const size_t texelCount = IBLCache::getTexelCount(faceSize, mipLevels);
+    const size_t blockCount = (texelCount + TEXEL_BLOCK - 1) / TEXEL_BLOCK;
+
+    ThreadPool::getInstance().parallelFor(blockCount, [&](size_t block) {
+        size_t begin = block * TEXEL_BLOCK;
+        size_t end = std::min(begin + TEXEL_BLOCK, texelCount);
+        float* out = dst + begin * 4;
+
+        if (encoding == IBLCacheEncoding::RGB9E5) {
+            const auto& scales = rgb9e5Scales();
+            const uint8_t* in = payload + begin * sizeof(uint32_t);
+            for (size_t i = begin; i < end; ++i, in += sizeof(uint32_t), out += 4) {
+                uint32_t packed;
+                std::memcpy(&packed, in, sizeof(packed));
+                float scale = scales[packed >> 27];
+                out[0] = static_cast<float>(packed & 0x1FFu) * scale;
+                out[1] = static_cast<float>((packed >> 9) & 0x1FFu) * scale;
+                out[2] = static_cast<float>((packed >> 18) & 0x1FFu) * scale;
+                out[3] = 1.0f;
+            }
+        } else {
+            const uint8_t* in = payload + begin * 4 * sizeof(uint16_t);
+            for (size_t i = begin * 4; i < end * 4; ++i, in += sizeof(uint16_t), ++out) {
+                uint16_t half;
+                std::memcpy(&half, in, sizeof(half));
+                *out = MipGenerator::halfToFloat(half);
+            }
+        }
+    });
+}
+
+uint32_t IBLCache::encodeRGB9E5(float r, float g, float b) {
+    // NaN and negatives become 0
+    auto clampChannel = [](float c) { return c > 0.0f ? std::min(c, RGB9E5_MAX) : 0.0f; };
+    r = clampChannel(r);
+    g = clampChannel(g);
+    b = clampChannel(b);
+
+    float maxChannel = std::max(r, std::max(g, b));
+    if (maxChannel <= 0.0f) {
+        return 0;
+    }
+
+    // floor(log2(maxChannel)) = exponent - 1 for frexp's [0.5, 1) mantissa
+    int exponent;
+    std::frexp(maxChannel, &exponent);
+    int sharedExponent = std::max(-RGB9E5_EXPONENT_BIAS - 1, exponent - 1) + 1 + RGB9E5_EXPONENT_BIAS;
+
+    float scale = std::ldexp(1.0f, RGB9E5_EXPONENT_BIAS + RGB9E5_MANTISSA_BITS - sharedExponent);
+    if (static_cast<uint32_t>(std::floor(maxChannel * scale + 0.5f)) == (1u << RGB9E5_MANTISSA_BITS)) {
+        ++sharedExponent;
+        scale *= 0.5f;
+    }
+
+    uint32_t red = static_cast<uint32_t>(std::floor(r * scale + 0.5f));
+    uint32_t green = static_cast<uint32_t>(std::floor(g * scale + 0.5f));
+    uint32_t blue = static_cast<uint32_t>(std::floor(b * scale + 0.5f));
+    return red | (green << 9) | (blue << 18) | (static_cast<uint32_t>(sharedExponent) << 27);
+}
+
+void IBLCache::decodeRGB9E5(uint32_t packed, float* rgb) {
+    float scale = rgb9e5Scales()[packed >> 27];
+    rgb[0] = static_cast<float>(packed & 0x1FFu) * scale;
+    rgb[1] = static_cast<float>((packed >> 9) & 0x1FFu) * scale;
+    rgb[2] = static_cast<float>((packed >> 18) & 0x1FFu) * scale;
+}
+
+size_t IBLCache::getTexelCount(uint32_t faceSize, uint32_t mipLevels) {
+    size_t total = 0;
+    for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+        size_t size = std::max(faceSize >> mip, 1u);
+        total += size * size * 6;
+    }
+    return total;
+}
+
+size_t IBLCache::getBytesPerTexel(IBLCacheEncoding encoding) {
+    return encoding == IBLCacheEncoding::RGB9E5 ? sizeof(uint32_t) : 4 * sizeof(uint16_t);
+}
+
+uint64_t IBLCache::hashFile(const fs::path& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return 0;
+    }
+    return hashBytes(file.data(), file.size());
+}
+
+fs::path IBLCache::getCachePath(const fs::path& sourcePath, IBLCacheKind kind, uint32_t faceSize) {
+    // Stable across relative/absolute spellings and toolchains (unlike std::hash)
+    std::error_code ec;
+    fs::path absolute = fs::absolute(sourcePath, ec);
+    std::string key = (ec ? sourcePath : absolute.lexically_normal()).generic_string();
+    uint64_t pathHash = hashBytes(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << pathHash << std::dec
+         << "_" << kindName(kind) << "_" << faceSize << ".mibl";
+    return fs::path("cache") / "ibl" / name.str();
+}
+
+bool IBLCache::save(const fs::path& cachePath, const IBLCacheKey& key, IBLCacheEncoding encoding,
+                    const float* data, size_t floatCount) {
+    const size_t texelCount = getTexelCount(key.faceSize, key.mipLevels);
+    if (!data || floatCount != texelCount * 4) {
+        std::cerr << "IBLCache: Data does not match a " << key.faceSize << "x" << key.faceSize << " chain with "
+                  << key.mipLevels << " mips" << std::endl;
+        return false;
+    }
+
+    const size_t bytesPerTexel = getBytesPerTexel(encoding);
+    std::vector<uint8_t> file(sizeof(IBLCacheHeader) + texelCount * bytesPerTexel);
+
+    IBLCacheHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.kind = static_cast<uint32_t>(key.kind);
+    header.encoding = static_cast<uint32_t>(encoding);
+    header.faceSize = key.faceSize;
+    header.mipLevels = key.mipLevels;
+    header.sourceHash = key.sourceHash;
+    header.settings = key.settings;
+    header.payloadSize = texelCount * bytesPerTexel;
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    uint8_t* payload = file.data() + sizeof(IBLCacheHeader);
+    const size_t blockCount = (texelCount + TEXEL_BLOCK - 1) / TEXEL_BLOCK;
+    ThreadPool::getInstance().parallelFor(blockCount, [&](size_t block) {
+        size_t begin = block * TEXEL_BLOCK;
+        size_t end = std::min(begin + TEXEL_BLOCK, texelCount);
+        for (size_t i = begin; i < end; ++i) {
+            const float* texel = data + i * 4;
+            if (encoding == IBLCacheEncoding::RGB9E5) {
+                uint32_t packed = encodeRGB9E5(texel[0], texel[1], texel[2]);
+                std::memcpy(payload + i * sizeof(uint32_t), &packed, sizeof(packed));
+            } else {
+                uint16_t halves[4];
+                for (int c = 0; c < 4; ++c) {
+                    halves[c] = MipGenerator::floatToHalf(std::clamp(texel[c], -HALF_MAX, HALF_MAX));
+                }
+                std::memcpy(payload + i * sizeof(halves), halves, sizeof(halves));
+            }
+        }
+    });
+
+    // Write to a temporary file first so readers never map a partial cache
+    std::error_code ec;
+    fs::create_directories(cachePath.parent_path(), ec);
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "IBLCache: Failed to create " << tempPath << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        if (!out.good()) {
+            std::cerr << "IBLCache: Failed to write " << tempPath << std::endl;
+            return false;
+        }
+    }
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "IBLCache: Failed to replace " << cachePath << ": " << ec.message() << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool IBLCache::open(const fs::path& cachePath, const IBLCacheKey& key, IBLCacheFile& outFile) {
+    std::error_code ec;
+    if (key.sourceHash == 0 || !fs::exists(cachePath, ec)) {
+        return false;
+    }
+
+    IBLCacheFile cache;
+    if (!cache.file.open(cachePath)) {
+        return false;
+    }
+
+    const IBLCacheHeader* header = cache.file.at<IBLCacheHeader>(0);
+    if (!header || header->magic != MAGIC || header->version != VERSION) {
+        std::cout << "IBLCache: Ignoring " << cachePath << " (not a version " << VERSION << " IBL cache)" << std::endl;
+        return false;
+    }
+    if (header->kind != static_cast<uint32_t>(key.kind) || header->faceSize != key.faceSize ||
+        header->mipLevels != key.mipLevels || header->sourceHash != key.sourceHash ||
+        std::memcmp(&header->settings, &key.settings, sizeof(IBLCacheSettings)) != 0) {
+        std::cout << "IBLCache: " << cachePath << " is stale (source or IBLConfig changed)" << std::endl;
+        return false;
+    }
+
+    IBLCacheEncoding encoding = static_cast<IBLCacheEncoding>(header->encoding);
+    if (encoding != IBLCacheEncoding::RGB9E5 && encoding != IBLCacheEncoding::RGBA16F) {
+        return false;
+    }
+    const size_t payloadSize = getTexelCount(key.faceSize, key.mipLevels) * getBytesPerTexel(encoding);
+    cache.payload = cache.file.at<uint8_t>(sizeof(IBLCacheHeader), payloadSize);
+    if (header->payloadSize != payloadSize || !cache.payload) {
+        std::cerr << "IBLCache: " << cachePath << " is truncated" << std::endl;
+        return false;
+    }
+
+    cache.encoding = encoding;
+    cache.faceSize = key.faceSize;
+    cache.mipLevels = key.mipLevels;
+    outFile = std::move(cache);
+    return true;
+}
+
+} // namespace MiEngine
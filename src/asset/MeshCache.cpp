@@ -156,15 +156,16 @@ bool MeshCache::writeBones(std::ofstream& file, const Skeleton& skeleton) {
     for (uint32_t i = 0; i < skeleton.getBoneCount(); ++i) {
         const Bone& bone = skeleton.getBone(i);
 
+        const std::string& boneName = bone.name.toString();
         BoneChunkHeader boneHeader{};
-        boneHeader.nameLength = static_cast<uint32_t>(bone.name.length());
+        boneHeader.nameLength = static_cast<uint32_t>(boneName.length());
         boneHeader.parentIndex = bone.parentIndex;
 
         file.write(reinterpret_cast<const char*>(&boneHeader), sizeof(boneHeader));
 
         // Write bone name
         if (boneHeader.nameLength > 0) {
-            file.write(bone.name.data(), boneHeader.nameLength);
+            file.write(boneName.data(), boneHeader.nameLength);
         }
 
         // Write matrices and vectors
@@ -197,8 +198,9 @@ bool MeshCache::writeAnimations(std::ofstream& file,
 
         // Write tracks
         for (const auto& track : anim->getTracks()) {
+            const std::string& boneName = track.boneName.toString();
             TrackChunkHeader trackHeader{};
-            trackHeader.boneNameLength = static_cast<uint32_t>(track.boneName.length());
+            trackHeader.boneNameLength = static_cast<uint32_t>(boneName.length());
             trackHeader.boneIndex = track.boneIndex;
             trackHeader.positionKeyCount = static_cast<uint32_t>(track.positionKeys.size());
             trackHeader.rotationKeyCount = static_cast<uint32_t>(track.rotationKeys.size());
@@ -209,7 +211,7 @@ bool MeshCache::writeAnimations(std::ofstream& file,
 
             // Write bone name
             if (trackHeader.boneNameLength > 0) {
-                file.write(track.boneName.data(), trackHeader.boneNameLength);
+                file.write(boneName.data(), trackHeader.boneNameLength);
             }
 
             // Write keyframes (time + value)
@@ -415,7 +417,7 @@ bool MeshCache::readBones(std::ifstream& file, uint32_t boneCount,
         if (!file.good()) return false;
 
         // Add bone to skeleton
-        uint32_t boneIndex = skeleton->addBone(boneName, boneHeader.parentIndex,
+        uint32_t boneIndex = skeleton->addBone(MiName(boneName), boneHeader.parentIndex,
                                                 inverseBindPose, localBindPose);
 
         // Set decomposed bind pose
@@ -459,7 +461,7 @@ bool MeshCache::readAnimations(std::ifstream& file, uint32_t animCount,
                 file.read(&boneName[0], trackHeader.boneNameLength);
             }
 
-            BoneAnimationTrack& track = clip->addTrack(boneName);
+            BoneAnimationTrack& track = clip->addTrack(MiName(boneName));
             track.boneIndex = trackHeader.boneIndex;
 
             // Read position keys
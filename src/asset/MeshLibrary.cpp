@@ -4,235 +4,471 @@
 #include "mesh/Mesh.h"
 #include "mesh/SkeletalMesh.h"
 #include "loader/ModelLoader.h"
+#include "loader/GltfLoader.h"
+#include "loader/ObjLoader.h"
 #include "VulkanRenderer.h"
 #include "project/ProjectManager.h"
+#include "core/ThreadPool.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <future>
+#include <mutex>
 
 namespace MiEngine {
 
+// Everything a worker needs to decode a mesh without touching registry/project state
+struct MeshLibrary::MeshSource {
+    fs::path sourcePath;
+    fs::path cachePath;     // Empty if the registry has no valid cache
+};
+
+struct MeshLibrary::PendingStaticLoad {
+    MiName assetPath;
+    std::future<std::vector<MeshData>> decode;
+    std::shared_ptr<StaticMeshHandle::State> state;
+    std::vector<ReadyCallback<::Mesh>> callbacks;
+};
+
+struct MeshLibrary::PendingSkeletalLoad {
+    MiName assetPath;
+    std::future<SkeletalModelData> decode;
+    std::shared_ptr<SkeletalMeshHandle::State> state;
+    std::vector<ReadyCallback<SkeletalMesh>> callbacks;
+};
+
+namespace {
+    // The library hands out one GPU mesh per asset path, so multi-mesh assets are merged
+    // into a single vertex/index buffer (submeshes carry no material of their own)
+    template<typename TMeshData>
+    void mergeSubmeshes(std::vector<TMeshData>& meshes) {
+        if (meshes.size() <= 1) {
+            return;
+        }
+
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        for (const auto& mesh : meshes) {
+            vertexCount += mesh.vertices.size();
+            indexCount += mesh.indices.size();
+        }
+
+        TMeshData& merged = meshes[0];
+        merged.vertices.reserve(vertexCount);
+        merged.indices.reserve(indexCount);
+        for (size_t i = 1; i < meshes.size(); ++i) {
+            unsigned int baseVertex = static_cast<unsigned int>(merged.vertices.size());
+            merged.vertices.insert(merged.vertices.end(), meshes[i].vertices.begin(), meshes[i].vertices.end());
+            for (unsigned int index : meshes[i].indices) {
+                merged.indices.push_back(baseVertex + index);
+            }
+        }
+        meshes.erase(meshes.begin() + 1, meshes.end());
+    }
+
+    std::vector<MeshData> loadStaticMeshData(const std::string& assetPath,
+                                             const fs::path& sourcePath, const fs::path& cachePath) {
+        std::vector<MeshData> meshDataList;
+
+        if (!cachePath.empty() && MeshCache::isValid(cachePath, sourcePath)) {
+            if (MeshCache::load(cachePath, meshDataList)) {
+                std::cout << "MeshLibrary: Loaded from cache: " << assetPath << std::endl;
+            }
+        }
+
+        // If cache miss, load from source. glTF and OBJ decoding are thread-safe.
+        if (meshDataList.empty() && GltfLoader::isGltfFile(sourcePath)) {
+            if (!GltfLoader::load(sourcePath, meshDataList)) {
+                std::cerr << "MeshLibrary: Failed to load model: " << sourcePath << std::endl;
+                return {};
+            }
+            std::cout << "MeshLibrary: Loaded from glTF: " << assetPath << std::endl;
+        }
+        if (meshDataList.empty() && ObjLoader::isObjFile(sourcePath)) {
+            if (!ObjLoader::load(sourcePath, meshDataList)) {
+                std::cerr << "MeshLibrary: Failed to load model: " << sourcePath << std::endl;
+                return {};
+            }
+            std::cout << "MeshLibrary: Loaded from OBJ: " << assetPath << std::endl;
+        }
+
+        // The FBX SDK is not thread-safe; cache reads run in parallel, FBX fallbacks one at a time
+        if (meshDataList.empty()) {
+            std::lock_guard<std::mutex> lock(ModelLoader::GetFbxMutex());
+            ModelLoader loader;
+            if (!loader.LoadModel(sourcePath.string())) {
+                std::cerr << "MeshLibrary: Failed to load model: " << sourcePath << std::endl;
+                return {};
+            }
+            meshDataList = loader.GetMeshData();
+            std::cout << "MeshLibrary: Loaded from FBX: " << assetPath << std::endl;
+        }
+
+        return meshDataList;
+    }
+
+    SkeletalModelData loadSkeletalModelData(const std::string& assetPath,
+                                            const fs::path& sourcePath, const fs::path& cachePath) {
+        SkeletalModelData modelData;
+
+        if (!cachePath.empty() && MeshCache::isValid(cachePath, sourcePath)) {
+            if (MeshCache::loadSkeletal(cachePath, modelData)) {
+                std::cout << "MeshLibrary: Loaded skeletal from cache: " << assetPath << std::endl;
+                return modelData;
+            }
+            modelData = SkeletalModelData();
+        }
+
+        // If cache miss, load from source. glTF decoding is thread-safe.
+        if (GltfLoader::isGltfFile(sourcePath)) {
+            if (!GltfLoader::loadSkeletal(sourcePath, modelData)) {
+                std::cerr << "MeshLibrary: Failed to load skeletal model: " << sourcePath << std::endl;
+                return SkeletalModelData();
+            }
+            std::cout << "MeshLibrary: Loaded skeletal from glTF: " << assetPath << std::endl;
+            return modelData;
+        }
+
+        std::lock_guard<std::mutex> lock(ModelLoader::GetFbxMutex());
+        ModelLoader loader;
+        if (!loader.LoadSkeletalModel(sourcePath.string(), modelData)) {
+            std::cerr << "MeshLibrary: Failed to load skeletal model: " << sourcePath << std::endl;
+            return SkeletalModelData();
+        }
+        std::cout << "MeshLibrary: Loaded skeletal from FBX: " << assetPath << std::endl;
+        return modelData;
+    }
+
+    // Worker-side decode: load, then merge submeshes so finishLoad() only uploads
+    std::vector<MeshData> decodeStaticMesh(const std::string& assetPath,
+                                           const fs::path& sourcePath, const fs::path& cachePath) {
+        std::vector<MeshData> meshDataList = loadStaticMeshData(assetPath, sourcePath, cachePath);
+        mergeSubmeshes(meshDataList);
+        return meshDataList;
+    }
+
+    SkeletalModelData decodeSkeletalMesh(const std::string& assetPath,
+                                         const fs::path& sourcePath, const fs::path& cachePath) {
+        SkeletalModelData modelData = loadSkeletalModelData(assetPath, sourcePath, cachePath);
+        mergeSubmeshes(modelData.meshes);
+        return modelData;
+    }
+}
+
 MeshLibrary::MeshLibrary(VulkanRenderer* renderer)
     : m_renderer(renderer) {
 }
 
-std::shared_ptr<::Mesh> MeshLibrary::getMesh(const std::string& assetPath) {
-    // Check if already cached and still alive
+MeshLibrary::~MeshLibrary() {
+    clear();
+}
+
+std::shared_ptr<::Mesh> MeshLibrary::getMesh(MiName assetPath) {
+    // Check if already cached
     auto it = m_meshCache.find(assetPath);
     if (it != m_meshCache.end()) {
-        auto mesh = it->second.lock();
-        if (mesh) {
-            return mesh;
-        }
-        // Expired, will reload below
+        it->second.lastUsedFrame = m_frameIndex;
+        return it->second.mesh;
+    }
+
+    // Already requested asynchronously - finish that load instead of starting another
+    auto pendingIt = m_pendingMeshes.find(assetPath);
+    if (pendingIt != m_pendingMeshes.end()) {
+        auto pending = pendingIt->second;
+        m_pendingMeshes.erase(pendingIt);
+        finishLoad(*pending);
+        return pending->state->mesh;
     }
 
     // Load and cache
     auto mesh = loadMeshInternal(assetPath);
     if (mesh) {
-        m_meshCache[assetPath] = mesh;
+        m_meshCache[assetPath] = { mesh, m_frameIndex };
     }
     return mesh;
 }
 
-std::shared_ptr<SkeletalMesh> MeshLibrary::getSkeletalMesh(const std::string& assetPath) {
-    // Check if already cached and still alive
+std::shared_ptr<SkeletalMesh> MeshLibrary::getSkeletalMesh(MiName assetPath) {
+    // Check if already cached
     auto it = m_skeletalMeshCache.find(assetPath);
     if (it != m_skeletalMeshCache.end()) {
-        auto mesh = it->second.lock();
-        if (mesh) {
-            return mesh;
-        }
+        it->second.lastUsedFrame = m_frameIndex;
+        return it->second.mesh;
+    }
+
+    auto pendingIt = m_pendingSkeletalMeshes.find(assetPath);
+    if (pendingIt != m_pendingSkeletalMeshes.end()) {
+        auto pending = pendingIt->second;
+        m_pendingSkeletalMeshes.erase(pendingIt);
+        finishLoad(*pending);
+        return pending->state->mesh;
     }
 
     // Load and cache
     auto mesh = loadSkeletalMeshInternal(assetPath);
     if (mesh) {
-        m_skeletalMeshCache[assetPath] = mesh;
+        m_skeletalMeshCache[assetPath] = { mesh, m_frameIndex };
     }
     return mesh;
 }
 
-bool MeshLibrary::isMeshLoaded(const std::string& assetPath) const {
+StaticMeshHandle MeshLibrary::requestMesh(MiName assetPath, ReadyCallback<::Mesh> onReady) {
+    StaticMeshHandle handle;
+
+    // Already resident
     auto it = m_meshCache.find(assetPath);
     if (it != m_meshCache.end()) {
-        return !it->second.expired();
+        it->second.lastUsedFrame = m_frameIndex;
+        handle.m_State = std::make_shared<StaticMeshHandle::State>();
+        handle.m_State->mesh = it->second.mesh;
+        handle.m_State->status = MeshLoadStatus::Ready;
+        if (onReady) onReady(it->second.mesh);
+        return handle;
+    }
+
+    // Coalesce with an in-flight load
+    auto pendingIt = m_pendingMeshes.find(assetPath);
+    if (pendingIt != m_pendingMeshes.end()) {
+        if (onReady) pendingIt->second->callbacks.push_back(std::move(onReady));
+        handle.m_State = pendingIt->second->state;
+        return handle;
+    }
+
+    handle.m_State = std::make_shared<StaticMeshHandle::State>();
+
+    // Primitives are generated, not decoded - cheap enough to do inline
+    if (m_renderer) {
+        if (auto primitive = createPrimitiveMesh(assetPath.toString())) {
+            m_meshCache[assetPath] = { primitive, m_frameIndex };
+            handle.m_State->mesh = primitive;
+            handle.m_State->status = MeshLoadStatus::Ready;
+            if (onReady) onReady(primitive);
+            return handle;
+        }
+    }
+
+    MeshSource source;
+    if (!m_renderer || !resolveSource(assetPath.toString(), source)) {
+        handle.m_State->status = MeshLoadStatus::Failed;
+        if (onReady) onReady(nullptr);
+        return handle;
     }
-    return false;
+
+    auto pending = std::make_shared<PendingStaticLoad>();
+    pending->assetPath = assetPath;
+    pending->state = handle.m_State;
+    if (onReady) pending->callbacks.push_back(std::move(onReady));
+    pending->decode = ThreadPool::getInstance().submit([assetPath, source]() {
+        return decodeStaticMesh(assetPath.toString(), source.sourcePath, source.cachePath);
+    });
+
+    m_pendingMeshes[assetPath] = pending;
+    return handle;
 }
 
-bool MeshLibrary::isSkeletalMeshLoaded(const std::string& assetPath) const {
+SkeletalMeshHandle MeshLibrary::requestSkeletalMesh(MiName assetPath,
+                                                    ReadyCallback<SkeletalMesh> onReady) {
+    SkeletalMeshHandle handle;
+
+    // Already resident
     auto it = m_skeletalMeshCache.find(assetPath);
     if (it != m_skeletalMeshCache.end()) {
-        return !it->second.expired();
+        it->second.lastUsedFrame = m_frameIndex;
+        handle.m_State = std::make_shared<SkeletalMeshHandle::State>();
+        handle.m_State->mesh = it->second.mesh;
+        handle.m_State->status = MeshLoadStatus::Ready;
+        if (onReady) onReady(it->second.mesh);
+        return handle;
     }
-    return false;
-}
 
-std::shared_ptr<::Mesh> MeshLibrary::reloadMesh(const std::string& assetPath) {
-    m_meshCache.erase(assetPath);
-    return getMesh(assetPath);
-}
+    // Coalesce with an in-flight load
+    auto pendingIt = m_pendingSkeletalMeshes.find(assetPath);
+    if (pendingIt != m_pendingSkeletalMeshes.end()) {
+        if (onReady) pendingIt->second->callbacks.push_back(std::move(onReady));
+        handle.m_State = pendingIt->second->state;
+        return handle;
+    }
 
-std::shared_ptr<SkeletalMesh> MeshLibrary::reloadSkeletalMesh(const std::string& assetPath) {
-    m_skeletalMeshCache.erase(assetPath);
-    return getSkeletalMesh(assetPath);
+    handle.m_State = std::make_shared<SkeletalMeshHandle::State>();
+
+    MeshSource source;
+    if (!m_renderer || !resolveSource(assetPath.toString(), source)) {
+        handle.m_State->status = MeshLoadStatus::Failed;
+        if (onReady) onReady(nullptr);
+        return handle;
+    }
+
+    auto pending = std::make_shared<PendingSkeletalLoad>();
+    pending->assetPath = assetPath;
+    pending->state = handle.m_State;
+    if (onReady) pending->callbacks.push_back(std::move(onReady));
+    pending->decode = ThreadPool::getInstance().submit([assetPath, source]() {
+        return decodeSkeletalMesh(assetPath.toString(), source.sourcePath, source.cachePath);
+    });
+
+    m_pendingSkeletalMeshes[assetPath] = pending;
+    return handle;
 }
 
-void MeshLibrary::collectGarbage() {
-    // Remove expired entries from mesh cache
-    for (auto it = m_meshCache.begin(); it != m_meshCache.end(); ) {
-        if (it->second.expired()) {
-            it = m_meshCache.erase(it);
-        } else {
+void MeshLibrary::update() {
+    // Upload finished decodes, bounded per frame so a burst of requests doesn't spike one frame
+    uint32_t uploads = 0;
+
+    for (auto it = m_pendingMeshes.begin(); it != m_pendingMeshes.end() && uploads < m_maxUploadsPerFrame; ) {
+        if (it->second->decode.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
             ++it;
+            continue;
         }
+        auto pending = it->second;
+        it = m_pendingMeshes.erase(it);
+        finishLoad(*pending);
+        ++uploads;
     }
 
-    // Remove expired entries from skeletal mesh cache
-    for (auto it = m_skeletalMeshCache.begin(); it != m_skeletalMeshCache.end(); ) {
-        if (it->second.expired()) {
-            it = m_skeletalMeshCache.erase(it);
-        } else {
+    for (auto it = m_pendingSkeletalMeshes.begin();
+         it != m_pendingSkeletalMeshes.end() && uploads < m_maxUploadsPerFrame; ) {
+        if (it->second->decode.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
             ++it;
+            continue;
         }
+        auto pending = it->second;
+        it = m_pendingSkeletalMeshes.erase(it);
+        finishLoad(*pending);
+        ++uploads;
     }
-}
 
-void MeshLibrary::clear() {
-    m_meshCache.clear();
-    m_skeletalMeshCache.clear();
+    collectGarbage();
 }
 
-size_t MeshLibrary::getLoadedMeshCount() const {
-    size_t count = 0;
-    for (const auto& pair : m_meshCache) {
-        if (!pair.second.expired()) {
-            ++count;
-        }
+void MeshLibrary::finishLoad(PendingStaticLoad& pending) {
+    std::vector<MeshData> meshDataList = pending.decode.get();
+
+    std::shared_ptr<::Mesh> mesh;
+    if (meshDataList.empty()) {
+        std::cerr << "MeshLibrary: No mesh data in: " << pending.assetPath << std::endl;
+    } else {
+        // Submeshes were merged into meshDataList[0] on the decoding thread
+        mesh = std::make_shared<::Mesh>(m_renderer->getDevice(), m_renderer->getPhysicalDevice(),
+                                        meshDataList[0]);
+        mesh->createBuffers(m_renderer->getCommandPool(), m_renderer->getGraphicsQueue());
+        m_meshCache[pending.assetPath] = { mesh, m_frameIndex };
     }
-    return count;
-}
 
-size_t MeshLibrary::getLoadedSkeletalMeshCount() const {
-    size_t count = 0;
-    for (const auto& pair : m_skeletalMeshCache) {
-        if (!pair.second.expired()) {
-            ++count;
-        }
+    pending.state->mesh = mesh;
+    pending.state->status = mesh ? MeshLoadStatus::Ready : MeshLoadStatus::Failed;
+    for (auto& callback : pending.callbacks) {
+        callback(mesh);
     }
-    return count;
+    pending.callbacks.clear();
 }
 
-size_t MeshLibrary::getTotalLoadedCount() const {
-    return getLoadedMeshCount() + getLoadedSkeletalMeshCount();
-}
+void MeshLibrary::finishLoad(PendingSkeletalLoad& pending) {
+    SkeletalModelData modelData = pending.decode.get();
 
-std::shared_ptr<::Mesh> MeshLibrary::loadMeshInternal(const std::string& assetPath) {
-    if (!m_renderer) {
-        std::cerr << "MeshLibrary: No renderer set" << std::endl;
-        return nullptr;
+    std::shared_ptr<SkeletalMesh> mesh;
+    if (modelData.meshes.empty()) {
+        std::cerr << "MeshLibrary: No skeletal mesh data in: " << pending.assetPath << std::endl;
+    } else {
+        // Submeshes were merged into meshes[0] on the decoding thread
+        mesh = std::make_shared<SkeletalMesh>(m_renderer->getDevice(), m_renderer->getPhysicalDevice(),
+                                              modelData.meshes[0]);
+        mesh->createBuffers(m_renderer->getCommandPool(), m_renderer->getGraphicsQueue());
+        m_skeletalMeshCache[pending.assetPath] = { mesh, m_frameIndex };
     }
 
-    // Check for primitive mesh types first
-    std::shared_ptr<::Mesh> primitiveMesh = createPrimitiveMesh(assetPath);
-    if (primitiveMesh) {
-        return primitiveMesh;
+    pending.state->mesh = mesh;
+    pending.state->status = mesh ? MeshLoadStatus::Ready : MeshLoadStatus::Failed;
+    for (auto& callback : pending.callbacks) {
+        callback(mesh);
     }
+    pending.callbacks.clear();
+}
 
-    // Resolve path - first check if it's an absolute path
-    fs::path sourcePath;
-    if (fs::path(assetPath).is_absolute() && fs::exists(assetPath)) {
-        sourcePath = assetPath;
-    } else {
-        auto& pm = ProjectManager::getInstance();
-
-        // Try multiple resolution strategies:
-        // 1. Direct path under Assets folder (e.g., "Models/test.fbx" -> "Assets/Models/test.fbx")
-        if (pm.hasProject()) {
-            fs::path directPath = pm.getCurrentProject()->getAssetsPath() / assetPath;
-            if (fs::exists(directPath)) {
-                sourcePath = directPath;
-            }
-        }
+bool MeshLibrary::isMeshLoaded(MiName assetPath) const {
+    return m_meshCache.count(assetPath) > 0;
+}
 
-        // 2. Try resolveModelPath (looks in Assets/Models)
-        if (sourcePath.empty()) {
-            auto resolved = pm.resolveModelPath(assetPath);
-            if (resolved) {
-                sourcePath = *resolved;
-            }
-        }
+bool MeshLibrary::isSkeletalMeshLoaded(MiName assetPath) const {
+    return m_skeletalMeshCache.count(assetPath) > 0;
+}
 
-        // 3. Strip "Models/" prefix if present and try again
-        if (sourcePath.empty() && assetPath.find("Models/") == 0) {
-            std::string stripped = assetPath.substr(7); // Remove "Models/"
-            auto resolved = pm.resolveModelPath(stripped);
-            if (resolved) {
-                sourcePath = *resolved;
-            }
-        }
+std::shared_ptr<::Mesh> MeshLibrary::reloadMesh(MiName assetPath) {
+    // Let an in-flight load land first so it can't overwrite the fresh one later
+    auto pendingIt = m_pendingMeshes.find(assetPath);
+    if (pendingIt != m_pendingMeshes.end()) {
+        auto pending = pendingIt->second;
+        m_pendingMeshes.erase(pendingIt);
+        finishLoad(*pending);
+    }
 
-        // 4. Try as relative path from current directory
-        if (sourcePath.empty() && fs::exists(assetPath)) {
-            sourcePath = assetPath;
-        }
+    m_meshCache.erase(assetPath);
+    return getMesh(assetPath);
+}
 
-        if (sourcePath.empty()) {
-            std::cerr << "MeshLibrary: Model not found: " << assetPath << std::endl;
-            return nullptr;
-        }
+std::shared_ptr<SkeletalMesh> MeshLibrary::reloadSkeletalMesh(MiName assetPath) {
+    auto pendingIt = m_pendingSkeletalMeshes.find(assetPath);
+    if (pendingIt != m_pendingSkeletalMeshes.end()) {
+        auto pending = pendingIt->second;
+        m_pendingSkeletalMeshes.erase(pendingIt);
+        finishLoad(*pending);
     }
 
-    // Check for cached binary first
-    auto& registry = AssetRegistry::getInstance();
-    const AssetEntry* entry = registry.findByPath(assetPath);
-
-    std::vector<MeshData> meshDataList;
+    m_skeletalMeshCache.erase(assetPath);
+    return getSkeletalMesh(assetPath);
+}
 
-    if (entry && entry->cacheValid) {
-        fs::path cachePath = registry.resolveCachePath(entry->cachePath);
-        if (MeshCache::isValid(cachePath, sourcePath)) {
-            if (MeshCache::load(cachePath, meshDataList)) {
-                std::cout << "MeshLibrary: Loaded from cache: " << assetPath << std::endl;
+void MeshLibrary::collectGarbage() {
+    ++m_frameIndex;
+
+    // A use_count of 1 means only the library holds the mesh. Keep it for
+    // m_retainFrames frames after the last outside reference went away.
+    auto sweep = [this](auto& cache) {
+        for (auto it = cache.begin(); it != cache.end(); ) {
+            if (it->second.mesh.use_count() > 1) {
+                it->second.lastUsedFrame = m_frameIndex;
+                ++it;
+            } else if (m_frameIndex - it->second.lastUsedFrame > m_retainFrames) {
+                it = cache.erase(it);
+            } else {
+                ++it;
             }
         }
-    }
+    };
 
-    // If cache miss, load from FBX
-    if (meshDataList.empty()) {
-        ModelLoader loader;
-        if (!loader.LoadModel(sourcePath.string())) {
-            std::cerr << "MeshLibrary: Failed to load model: " << sourcePath << std::endl;
-            return nullptr;
-        }
-        meshDataList = loader.GetMeshData();
-        std::cout << "MeshLibrary: Loaded from FBX: " << assetPath << std::endl;
-    }
+    sweep(m_meshCache);
+    sweep(m_skeletalMeshCache);
+}
 
-    if (meshDataList.empty()) {
-        std::cerr << "MeshLibrary: No mesh data in: " << assetPath << std::endl;
-        return nullptr;
+void MeshLibrary::clear() {
+    // Decodes can't be cancelled; wait so workers never outlive the library's data
+    for (auto& pair : m_pendingMeshes) {
+        pair.second->decode.wait();
+        pair.second->state->status = MeshLoadStatus::Failed;
     }
+    for (auto& pair : m_pendingSkeletalMeshes) {
+        pair.second->decode.wait();
+        pair.second->state->status = MeshLoadStatus::Failed;
+    }
+    m_pendingMeshes.clear();
+    m_pendingSkeletalMeshes.clear();
 
-    // Create GPU mesh from first submesh (TODO: support multiple submeshes)
-    VkDevice device = m_renderer->getDevice();
-    VkPhysicalDevice physicalDevice = m_renderer->getPhysicalDevice();
-    VkCommandPool commandPool = m_renderer->getCommandPool();
-    VkQueue graphicsQueue = m_renderer->getGraphicsQueue();
+    m_meshCache.clear();
+    m_skeletalMeshCache.clear();
+}
 
-    auto mesh = std::make_shared<::Mesh>(device, physicalDevice, meshDataList[0]);
-    mesh->createBuffers(commandPool, graphicsQueue);
+size_t MeshLibrary::getLoadedMeshCount() const {
+    return m_meshCache.size();
+}
 
-    return mesh;
+size_t MeshLibrary::getLoadedSkeletalMeshCount() const {
+    return m_skeletalMeshCache.size();
 }
 
-std::shared_ptr<SkeletalMesh> MeshLibrary::loadSkeletalMeshInternal(const std::string& assetPath) {
-    if (!m_renderer) {
-        std::cerr << "MeshLibrary: No renderer set" << std::endl;
-        return nullptr;
-    }
+size_t MeshLibrary::getTotalLoadedCount() const {
+    return getLoadedMeshCount() + getLoadedSkeletalMeshCount();
+}
 
+bool MeshLibrary::resolveSource(const std::string& assetPath, MeshSource& outSource) const {
     // Resolve path - first check if it's an absolute path
     fs::path sourcePath;
     if (fs::path(assetPath).is_absolute() && fs::exists(assetPath)) {
@@ -272,53 +508,74 @@ std::shared_ptr<SkeletalMesh> MeshLibrary::loadSkeletalMeshInternal(const std::s
         }
 
         if (sourcePath.empty()) {
-            std::cerr << "MeshLibrary: Skeletal model not found: " << assetPath << std::endl;
-            return nullptr;
+            std::cerr << "MeshLibrary: Model not found: " << assetPath << std::endl;
+            return false;
         }
     }
 
-    // Check for cached binary first
+    outSource.sourcePath = sourcePath;
+    outSource.cachePath.clear();
+
+    // Check for cached binary
     auto& registry = AssetRegistry::getInstance();
-    const AssetEntry* entry = registry.findByPath(assetPath);
+    std::optional<AssetEntry> entry = registry.findByPath(assetPath);
+    if (entry && entry->cacheValid) {
+        outSource.cachePath = registry.resolveCachePath(entry->cachePath);
+    }
+    return true;
+}
 
-    SkeletalModelData modelData;
-    bool loadedFromCache = false;
+std::shared_ptr<::Mesh> MeshLibrary::loadMeshInternal(MiName assetName) {
+    if (!m_renderer) {
+        std::cerr << "MeshLibrary: No renderer set" << std::endl;
+        return nullptr;
+    }
+    const std::string& assetPath = assetName.toString();
 
-    if (entry && entry->cacheValid) {
-        fs::path cachePath = registry.resolveCachePath(entry->cachePath);
-        if (MeshCache::isValid(cachePath, sourcePath)) {
-            if (MeshCache::loadSkeletal(cachePath, modelData)) {
-                std::cout << "MeshLibrary: Loaded skeletal from cache: " << assetPath << std::endl;
-                loadedFromCache = true;
-            }
-        }
+    // Check for primitive mesh types first
+    std::shared_ptr<::Mesh> primitiveMesh = createPrimitiveMesh(assetPath);
+    if (primitiveMesh) {
+        return primitiveMesh;
     }
 
-    // If cache miss, load from FBX
-    if (!loadedFromCache) {
-        ModelLoader loader;
-        if (!loader.LoadSkeletalModel(sourcePath.string(), modelData)) {
-            std::cerr << "MeshLibrary: Failed to load skeletal model: " << sourcePath << std::endl;
-            return nullptr;
-        }
-        std::cout << "MeshLibrary: Loaded skeletal from FBX: " << assetPath << std::endl;
+    MeshSource source;
+    if (!resolveSource(assetPath, source)) {
+        return nullptr;
     }
 
-    if (modelData.meshes.empty()) {
-        std::cerr << "MeshLibrary: No skeletal mesh data in: " << assetPath << std::endl;
+    // Same decode + upload path as async requests, just on this thread
+    PendingStaticLoad pending;
+    pending.assetPath = assetName;
+    pending.state = std::make_shared<StaticMeshHandle::State>();
+    std::promise<std::vector<MeshData>> decoded;
+    decoded.set_value(decodeStaticMesh(assetPath, source.sourcePath, source.cachePath));
+    pending.decode = decoded.get_future();
+
+    finishLoad(pending);
+    return pending.state->mesh;
+}
+
+std::shared_ptr<SkeletalMesh> MeshLibrary::loadSkeletalMeshInternal(MiName assetName) {
+    if (!m_renderer) {
+        std::cerr << "MeshLibrary: No renderer set" << std::endl;
         return nullptr;
     }
+    const std::string& assetPath = assetName.toString();
 
-    // Create GPU skeletal mesh from first submesh
-    VkDevice device = m_renderer->getDevice();
-    VkPhysicalDevice physicalDevice = m_renderer->getPhysicalDevice();
-    VkCommandPool commandPool = m_renderer->getCommandPool();
-    VkQueue graphicsQueue = m_renderer->getGraphicsQueue();
+    MeshSource source;
+    if (!resolveSource(assetPath, source)) {
+        return nullptr;
+    }
 
-    auto mesh = std::make_shared<SkeletalMesh>(device, physicalDevice, modelData.meshes[0]);
-    mesh->createBuffers(commandPool, graphicsQueue);
+    PendingSkeletalLoad pending;
+    pending.assetPath = assetName;
+    pending.state = std::make_shared<SkeletalMeshHandle::State>();
+    std::promise<SkeletalModelData> decoded;
+    decoded.set_value(decodeSkeletalMesh(assetPath, source.sourcePath, source.cachePath));
+    pending.decode = decoded.get_future();
 
-    return mesh;
+    finishLoad(pending);
+    return pending.state->mesh;
 }
 
 std::shared_ptr<::Mesh> MeshLibrary::createPrimitiveMesh(const std::string& primitiveType) {
@@ -0,0 +1,510 @@
+#include "asset/TextureCache.h"
+#include "asset/MeshCache.h"
+#include "texture/MipGenerator.h"
+#include "project/ProjectManager.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace MiEngine {
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr char SOURCE_KEY[] = "MiEngine.source";
+constexpr char WRITER_KEY[] = "KTXwriter";
+constexpr char WRITER_VALUE[] = "MiEngine TextureCache";
+
+#pragma pack(push, 1)
+// KTX2 header followed by the index section
+struct Ktx2Header {
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+struct Ktx2LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// Value of the MiEngine.source key
+struct TextureCacheSource {
+    uint32_t version;
+    uint32_t textureType;
+    uint64_t sourceFileHash;
+    uint64_t sourceModTime;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Ktx2Header) == 80, "KTX2 header + index is 80 bytes");
+
+// Stable across relative/absolute spellings of the same file
+uint64_t computeSourceHash(const fs::path& sourcePath) {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(sourcePath, ec);
+    return MeshCache::computeSourceHash(ec ? sourcePath : absolute.lexically_normal());
+}
+
+uint32_t blockBytesForVkFormat(uint32_t vkFormat) {
+    switch (vkFormat) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC4_SNORM_BLOCK:
+            return 8;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+const char* formatName(BlockFormat format) {
+    switch (format) {
+        case BlockFormat::BC1: return "BC1";
+        case BlockFormat::BC4: return "BC4";
+        case BlockFormat::BC5: return "BC5";
+        case BlockFormat::BC7: return "BC7";
+    }
+    return "?";
+}
+
+const char* textureTypeName(TextureType type) {
+    switch (type) {
+        case TextureType::Diffuse: return "diffuse";
+        case TextureType::Normal: return "normal";
+        case TextureType::Metallic: return "metallic";
+        case TextureType::Roughness: return "roughness";
+        case TextureType::MetallicRoughness: return "metallicroughness";
+        case TextureType::AmbientOcclusion: return "ao";
+        case TextureType::Emissive: return "emissive";
+        case TextureType::Height: return "height";
+        case TextureType::Specular: return "specular";
+        default: return "texture";
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Writing
+// ----------------------------------------------------------------------------
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void alignTo(std::vector<uint8_t>& out, size_t alignment) {
+    out.resize((out.size() + alignment - 1) / alignment * alignment, 0);
+}
+
+// Basic data format descriptor (Khronos Data Format spec, block-compressed models)
+std::vector<uint8_t> buildDfd(BlockFormat format, bool srgb) {
+    struct Sample { uint16_t bitOffset; uint8_t bitLength; uint8_t channel; };
+    std::vector<Sample> samples;
+    uint8_t colorModel = 0;
+    switch (format) {
+        case BlockFormat::BC1: colorModel = 128; samples = { { 0, 63, 0 } }; break;
+        case BlockFormat::BC4: colorModel = 131; samples = { { 0, 63, 0 } }; break;
+        case BlockFormat::BC5: colorModel = 132; samples = { { 0, 63, 0 }, { 64, 63, 1 } }; break;
+        case BlockFormat::BC7: colorModel = 134; samples = { { 0, 127, 0 } }; break;
+    }
+
+    uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+    std::vector<uint8_t> dfd;
+    append(dfd, static_cast<uint32_t>(4 + blockSize));             // dfdTotalSize
+    append(dfd, static_cast<uint32_t>(0));                         // vendorId 0, descriptorType 0
+    append(dfd, static_cast<uint32_t>(2 | (blockSize << 16)));     // versionNumber 2, descriptorBlockSize
+    append(dfd, colorModel);
+    append(dfd, static_cast<uint8_t>(1));                          // BT.709 primaries
+    append(dfd, static_cast<uint8_t>(srgb ? 2 : 1));               // sRGB / linear transfer
+    append(dfd, static_cast<uint8_t>(0));                          // Straight alpha
+    const uint8_t texelBlockDimension[4] = { 3, 3, 0, 0 };         // 4x4x1x1
+    dfd.insert(dfd.end(), texelBlockDimension, texelBlockDimension + 4);
+    uint8_t bytesPlane[8] = {};
+    bytesPlane[0] = static_cast<uint8_t>(BlockCompression::getBlockBytes(format));
+    dfd.insert(dfd.end(), bytesPlane, bytesPlane + 8);
+
+    for (const Sample& sample : samples) {
+        append(dfd, sample.bitOffset);
+        append(dfd, sample.bitLength);
+        append(dfd, sample.channel);
+        append(dfd, static_cast<uint32_t>(0));                     // samplePosition
+        append(dfd, static_cast<uint32_t>(0));                     // sampleLower
+        append(dfd, static_cast<uint32_t>(0xFFFFFFFFu));           // sampleUpper
+    }
+    return dfd;
+}
+
+void appendKeyValue(std::vector<uint8_t>& kvd, const char* key, const void* value, size_t valueSize) {
+    size_t keyLength = std::strlen(key) + 1;
+    append(kvd, static_cast<uint32_t>(keyLength + valueSize));
+    kvd.insert(kvd.end(), key, key + keyLength);
+    const uint8_t* bytes = static_cast<const uint8_t*>(value);
+    kvd.insert(kvd.end(), bytes, bytes + valueSize);
+    alignTo(kvd, 4);
+}
+
+// ----------------------------------------------------------------------------
+// Reading
+// ----------------------------------------------------------------------------
+
+const Ktx2Header* readHeader(const MappedFile& file) {
+    const Ktx2Header* header = file.at<Ktx2Header>(0);
+    if (!header || std::memcmp(header->identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        return nullptr;
+    }
+    if (header->supercompressionScheme != 0 || header->pixelDepth > 1 || header->layerCount > 1 ||
+        header->faceCount != 1 || header->levelCount == 0 || header->levelCount > 16) {
+        return nullptr;
+    }
+    return header;
+}
+
+const TextureCacheSource* findSource(const MappedFile& file, const Ktx2Header& header) {
+    const uint8_t* kvd = file.at<uint8_t>(header.kvdByteOffset, header.kvdByteLength);
+    if (!kvd) {
+        return nullptr;
+    }
+    size_t offset = 0;
+    size_t keyLength = sizeof(SOURCE_KEY);
+    while (offset + 4 <= header.kvdByteLength) {
+        uint32_t length;
+        std::memcpy(&length, kvd + offset, 4);
+        offset += 4;
+        if (length > header.kvdByteLength - offset) {
+            return nullptr;
+        }
+        if (length == keyLength + sizeof(TextureCacheSource) && std::memcmp(kvd + offset, SOURCE_KEY, keyLength) == 0) {
+            return file.at<TextureCacheSource>(header.kvdByteOffset + offset + keyLength);
+        }
+        offset += (length + 3) & ~size_t(3);
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+BlockFormat TextureCache::getBlockFormat(TextureType type) {
+    switch (type) {
+        case TextureType::Normal:
+            return BlockFormat::BC5;
+        case TextureType::Metallic:
+        case TextureType::Roughness:
+        case TextureType::AmbientOcclusion:
+        case TextureType::Height:
+            return BlockFormat::BC4;
+        case TextureType::MetallicRoughness:
+        case TextureType::Specular:
+            return BlockFormat::BC1;
+        default:
+            return BlockFormat::BC7;
+    }
+}
+
+bool TextureCache::isSrgb(TextureType type) {
+    return type == TextureType::Diffuse || type == TextureType::Emissive || type == TextureType::Specular;
+}
+
+VkFormat TextureCache::getVkFormat(BlockFormat format, bool srgb) {
+    switch (format) {
+        case BlockFormat::BC1: return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        case BlockFormat::BC4: return VK_FORMAT_BC4_UNORM_BLOCK;
+        case BlockFormat::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case BlockFormat::BC7: return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+TextureType TextureCache::guessTextureType(const fs::path& sourcePath) {
+    std::string name = sourcePath.stem().string();
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    auto has = [&](const char* token) { return name.find(token) != std::string::npos; };
+    auto endsWith = [&](const char* suffix) {
+        size_t length = std::strlen(suffix);
+        return name.size() >= length && name.compare(name.size() - length, length, suffix) == 0;
+    };
+
+    if (has("normal") || has("_nrm") || has("_nor") || endsWith("_n")) return TextureType::Normal;
+    if ((has("metal") && has("rough")) || endsWith("_mr") || endsWith("_orm")) return TextureType::MetallicRoughness;
+    if (has("rough")) return TextureType::Roughness;
+    if (has("metal")) return TextureType::Metallic;
+    if (has("occlusion") || endsWith("_ao") || has("_ao_")) return TextureType::AmbientOcclusion;
+    if (has("emiss") || has("emit")) return TextureType::Emissive;
+    if (has("height") || has("disp") || has("bump")) return TextureType::Height;
+    if (has("spec")) return TextureType::Specular;
+    return TextureType::Diffuse;
+}
+
+fs::path TextureCache::getCachePath(const fs::path& sourcePath, const fs::path& cacheDir, TextureType type) {
+    // Textures often share stems (albedo.png per model folder); the path hash keeps them apart
+    std::ostringstream name;
+    name << sourcePath.stem().string() << "_" << std::hex << std::setw(8) << std::setfill('0')
+         << static_cast<uint32_t>(computeSourceHash(sourcePath)) << "_" << textureTypeName(type) << ".ktx2";
+    return cacheDir / name.str();
+}
+
+fs::path TextureCache::getDefaultCacheDir() {
+    auto& pm = ProjectManager::getInstance();
+    if (pm.hasProject()) {
+        return pm.getCurrentProject()->getCachePath() / "Textures";
+    }
+    return fs::path("cache") / "textures";
+}
+
+bool TextureCache::bake(const fs::path& sourcePath, const fs::path& cachePath, TextureType type,
+                        TextureBakeStats* outStats) {
+    auto startTime = Clock::now();
+
+    int width, height, channels;
+    stbi_uc* pixels = stbi_load(sourcePath.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        std::cerr << "TextureCache: Failed to decode " << sourcePath << std::endl;
+        return false;
+    }
+    double decodeMs = elapsedMs(startTime);
+
+    TextureBakeStats stats;
+    bool result = bakePixels(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                             cachePath, sourcePath, type, &stats);
+    stbi_image_free(pixels);
+
+    stats.decodeMs = decodeMs;
+    stats.totalMs = elapsedMs(startTime);
+    if (result) {
+        std::cout << "TextureCache: Baked " << sourcePath.filename() << " (" << stats.width << "x" << stats.height
+                  << ", " << stats.mipLevels << " mips, " << formatName(stats.format) << ") in "
+                  << static_cast<uint64_t>(stats.totalMs) << "ms [decode " << static_cast<uint64_t>(stats.decodeMs)
+                  << "ms, mips " << static_cast<uint64_t>(stats.mipMs) << "ms, encode "
+                  << static_cast<uint64_t>(stats.encodeMs) << "ms], "
+                  << std::fixed << std::setprecision(1) << stats.uncompressedBytes / 1048576.0 << " MB -> "
+                  << stats.bakedBytes / 1048576.0 << " MB ("
+                  << 100.0 * (1.0 - static_cast<double>(stats.bakedBytes) / stats.uncompressedBytes)
+                  << "% smaller)" << std::defaultfloat << std::endl;
+    }
+    if (outStats) {
+        *outStats = stats;
+    }
+    return result;
+}
+
+bool TextureCache::bakePixels(const uint8_t* rgba, uint32_t width, uint32_t height,
+                              const fs::path& cachePath, const fs::path& sourcePath, TextureType type,
+                              TextureBakeStats* outStats) {
+    if (!rgba || width == 0 || height == 0) {
+        return false;
+    }
+
+    TextureBakeStats stats;
+    const BlockFormat format = getBlockFormat(type);
+    const bool srgb = isSrgb(type);
+    const uint32_t mipLevels = MipGenerator::getMipLevelCount(width, height);
+
+    stats.width = width;
+    stats.height = height;
+    stats.mipLevels = mipLevels;
+    stats.format = format;
+
+    // Mip chain; level 0 aliases the input. Bakes are offline, so use the sharper Kaiser filter.
+    auto mipStart = Clock::now();
+    auto bakeStart = mipStart;
+    MipSettings mipSettings;
+    mipSettings.filter = MipFilter::Kaiser;
+    mipSettings.normalMap = type == TextureType::Normal;
+    mipSettings.wrap = true;                // Material samplers repeat
+    std::vector<std::vector<uint8_t>> chain;
+    MipGenerator::generate(rgba, width, height, srgb ? MipPixelFormat::RGBA8_SRGB : MipPixelFormat::RGBA8,
+                           mipSettings, chain);
+    std::vector<const uint8_t*> levelPixels(mipLevels);
+    levelPixels[0] = rgba;
+    for (uint32_t level = 1; level < mipLevels; ++level) {
+        levelPixels[level] = chain[level - 1].data();
+    }
+    stats.mipMs = elapsedMs(mipStart);
+
+    // Encode every level (each level is parallel across block rows)
+    auto encodeStart = Clock::now();
+    std::vector<std::vector<uint8_t>> blocks(mipLevels);
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        uint32_t levelWidth = std::max(width >> level, 1u);
+        uint32_t levelHeight = std::max(height >> level, 1u);
+        BlockCompression::compress(levelPixels[level], levelWidth, levelHeight, format, blocks[level]);
+        stats.uncompressedBytes += static_cast<uint64_t>(levelWidth) * levelHeight * 4;
+        stats.bakedBytes += blocks[level].size();
+    }
+    stats.encodeMs = elapsedMs(encodeStart);
+
+    // Assemble the KTX2 file
+    std::vector<uint8_t> dfd = buildDfd(format, srgb);
+    std::vector<uint8_t> kvd;
+    appendKeyValue(kvd, WRITER_KEY, WRITER_VALUE, sizeof(WRITER_VALUE));
+    TextureCacheSource source{};
+    source.version = VERSION;
+    source.textureType = static_cast<uint32_t>(type);
+    source.sourceFileHash = computeSourceHash(sourcePath);
+    source.sourceModTime = MeshCache::getSourceModTime(sourcePath);
+    appendKeyValue(kvd, SOURCE_KEY, &source, sizeof(source));
+
+    Ktx2Header header{};
+    std::memcpy(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    header.vkFormat = getVkFormat(format, srgb);
+    header.typeSize = 1;
+    header.pixelWidth = width;
+    header.pixelHeight = height;
+    header.faceCount = 1;
+    header.levelCount = mipLevels;
+    header.dfdByteOffset = static_cast<uint32_t>(sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * mipLevels);
+    header.dfdByteLength = static_cast<uint32_t>(dfd.size());
+    header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+    header.kvdByteLength = static_cast<uint32_t>(kvd.size());
+
+    std::vector<uint8_t> file;
+    file.resize(header.dfdByteOffset);
+    file.insert(file.end(), dfd.begin(), dfd.end());
+    file.insert(file.end(), kvd.begin(), kvd.end());
+
+    // Level data, smallest mip first, each aligned to the block size
+    std::vector<Ktx2LevelIndex> levelIndex(mipLevels);
+    const size_t alignment = BlockCompression::getBlockBytes(format);
+    for (uint32_t level = mipLevels; level-- > 0;) {
+        alignTo(file, alignment);
+        levelIndex[level].byteOffset = file.size();
+        levelIndex[level].byteLength = blocks[level].size();
+        levelIndex[level].uncompressedByteLength = blocks[level].size();
+        file.insert(file.end(), blocks[level].begin(), blocks[level].end());
+    }
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), levelIndex.data(), sizeof(Ktx2LevelIndex) * mipLevels);
+
+    // Write to a temporary file first so readers never map a partial bake
+    std::error_code ec;
+    fs::create_directories(cachePath.parent_path(), ec);
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "TextureCache: Failed to create " << tempPath << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        if (!out.good()) {
+            std::cerr << "TextureCache: Failed to write " << tempPath << std::endl;
+            return false;
+        }
+    }
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "TextureCache: Failed to replace " << cachePath << ": " << ec.message() << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    stats.totalMs = elapsedMs(bakeStart);
+    if (outStats) {
+        *outStats = stats;
+    }
+    return true;
+}
+
+bool TextureCache::isValid(const fs::path& cachePath, const fs::path& sourcePath, TextureType type) {
+    if (!fs::exists(cachePath) || !fs::exists(sourcePath)) {
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(cachePath)) {
+        return false;
+    }
+    const Ktx2Header* header = readHeader(file);
+    const TextureCacheSource* source = header ? findSource(file, *header) : nullptr;
+    if (!source) {
+        return false;
+    }
+
+    return source->version == VERSION &&
+           source->textureType == static_cast<uint32_t>(type) &&
+           source->sourceFileHash == computeSourceHash(sourcePath) &&
+           source->sourceModTime == MeshCache::getSourceModTime(sourcePath);
+}
+
+bool TextureCache::load(const fs::path& cachePath, BakedTexture& outTexture) {
+    BakedTexture texture;
+    if (!texture.file.open(cachePath)) {
+        std::cerr << "TextureCache: Failed to open " << cachePath << std::endl;
+        return false;
+    }
+
+    const Ktx2Header* header = readHeader(texture.file);
+    uint32_t blockBytes = header ? blockBytesForVkFormat(header->vkFormat) : 0;
+    if (!header || blockBytes == 0 || header->pixelWidth == 0 || header->pixelHeight == 0) {
+        std::cerr << "TextureCache: Unsupported KTX2 file " << cachePath << std::endl;
+        return false;
+    }
+
+    const Ktx2LevelIndex* levelIndex = texture.file.at<Ktx2LevelIndex>(sizeof(Ktx2Header), header->levelCount);
+    if (!levelIndex) {
+        std::cerr << "TextureCache: Truncated KTX2 file " << cachePath << std::endl;
+        return false;
+    }
+
+    texture.format = static_cast<VkFormat>(header->vkFormat);
+    texture.width = header->pixelWidth;
+    texture.height = header->pixelHeight;
+    texture.levels.resize(header->levelCount);
+    for (uint32_t level = 0; level < header->levelCount; ++level) {
+        auto& out = texture.levels[level];
+        out.width = std::max(texture.width >> level, 1u);
+        out.height = std::max(texture.height >> level, 1u);
+        size_t expected = static_cast<size_t>((out.width + 3) / 4) * ((out.height + 3) / 4) * blockBytes;
+        out.size = static_cast<size_t>(levelIndex[level].byteLength);
+        out.data = texture.file.at<uint8_t>(static_cast<size_t>(levelIndex[level].byteOffset), out.size);
+        if (!out.data || out.size < expected) {
+            std::cerr << "TextureCache: Bad mip level " << level << " in " << cachePath << std::endl;
+            return false;
+        }
+    }
+
+    outTexture = std::move(texture);
+    return true;
+}
+
+} // namespace MiEngine
@@ -12,7 +12,7 @@ namespace MiEngine {
 MiStaticMeshComponent::MiStaticMeshComponent()
     : MiSceneComponent()
     , m_Mesh(nullptr)
-    , m_MeshAssetPath("")
+    , m_MeshAssetPath()
     , m_CastShadows(true)
     , m_ReceiveShadows(true)
     , m_LocalBoundsMin(-0.5f)
@@ -31,7 +31,7 @@ void MiStaticMeshComponent::setMesh(std::shared_ptr<Mesh> mesh) {
     markDirty();
 }
 
-void MiStaticMeshComponent::setMeshByPath(const std::string& assetPath) {
+void MiStaticMeshComponent::setMeshByPath(MiName assetPath) {
     m_MeshAssetPath = assetPath;
 
     // If already registered to world, load immediately
@@ -47,13 +47,13 @@ void MiStaticMeshComponent::onRegister() {
     MiSceneComponent::onRegister();
 
     // Load mesh if path is set but mesh isn't loaded
-    if (!m_Mesh && !m_MeshAssetPath.empty()) {
+    if (!m_Mesh && !m_MeshAssetPath.isNone()) {
         loadMeshFromPath();
     }
 }
 
 void MiStaticMeshComponent::loadMeshFromPath() {
-    if (m_MeshAssetPath.empty()) return;
+    if (m_MeshAssetPath.isNone()) return;
 
     MiActor* owner = getOwner();
     if (!owner) return;
@@ -64,12 +64,18 @@ void MiStaticMeshComponent::loadMeshFromPath() {
     VulkanRenderer* renderer = world->getRenderer();
     if (!renderer) return;
 
+    // Decoded on worker threads; the mesh shows up once MeshLibrary::update() uploads it
+    std::weak_ptr<MiObject> weakSelf = weak_from_this();
+    MiName requestedPath = m_MeshAssetPath;
     MeshLibrary& meshLib = renderer->getMeshLibrary();
-    m_Mesh = meshLib.getMesh(m_MeshAssetPath);
-
-    if (m_Mesh) {
-        updateBoundsFromMesh();
-    }
+    meshLib.requestMesh(m_MeshAssetPath, [weakSelf, requestedPath](std::shared_ptr<Mesh> mesh) {
+        auto self = std::static_pointer_cast<MiStaticMeshComponent>(weakSelf.lock());
+        if (!self || !mesh || self->m_MeshAssetPath != requestedPath) {
+            return;  // Component gone or path changed while loading
+        }
+        self->m_Mesh = mesh;
+        self->updateBoundsFromMesh();
+    });
 }
 
 void MiStaticMeshComponent::updateBoundsFromMesh() {
@@ -129,7 +135,7 @@ void MiStaticMeshComponent::serialize(JsonWriter& writer) const {
     MiSceneComponent::serialize(writer);
 
     // Mesh asset path
-    writer.writeString("meshAsset", m_MeshAssetPath);
+    writer.writeString("meshAsset", m_MeshAssetPath.toString());
 
     // Shadow settings
     writer.writeBool("castShadows", m_CastShadows);
@@ -148,8 +154,8 @@ void MiStaticMeshComponent::deserialize(const JsonReader& reader) {
     MiSceneComponent::deserialize(reader);
 
     // Mesh asset path
-    m_MeshAssetPath = reader.getString("meshAsset", "");
-    if (!m_MeshAssetPath.empty()) {
+    m_MeshAssetPath = MiName(reader.getString("meshAsset", ""));
+    if (!m_MeshAssetPath.isNone()) {
         // If already registered to world (loading after spawn), load mesh immediately
         if (getOwner() && getOwner()->getWorld()) {
             loadMeshFromPath();
@@ -171,6 +177,6 @@ void MiStaticMeshComponent::deserialize(const JsonReader& reader) {
 }
 
 // Register the type
-MI_REGISTER_TYPE(MiStaticMeshComponent)
+MI_REGISTER_TYPE_WITH_PARENT(MiStaticMeshComponent, MiSceneComponent)
 
 } // namespace MiEngine
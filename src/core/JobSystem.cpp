@@ -0,0 +1,494 @@
+#include "core/JobSystem.h"
+#include <algorithm>
+
+namespace MiEngine {
+
+struct Job {
+    JobSystem::JobFunction func;
+    const char* name = nullptr;
+    JobAffinity affinity = JobAffinity::Any;
+    JobCounterRef counter;
+};
+
+namespace {
+
+// Calling thread's slot in the system it belongs to (main thread or worker)
+thread_local const JobSystem* t_System = nullptr;
+thread_local uint32_t t_ThreadIndex = JobSystem::EXTERNAL_THREAD_INDEX;
+
+constexpr uint32_t IDLE_SPINS = 64;     // yields before a worker goes to sleep
+
+} // anonymous namespace
+
+// ============================================================================
+// Work-stealing deque (Chase-Lev, fixed capacity)
+// ============================================================================
+
+/**
+ * The owner pushes and pops at the bottom, thieves take from the top. Only
+ * the last job races between the owner and thieves, settled by a CAS on top.
+ * A full deque rejects the push and the job goes to the injection queue.
+ */
+class JobSystem::WorkStealingDeque {
+public:
+    static constexpr int64_t CAPACITY = 4096;
+
+    bool push(Job* job) {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= CAPACITY) {
+            return false;
+        }
+        m_Buffer[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Job* pop() {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last job: a thief may be taking it
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* steal() {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Job* job = m_Buffer[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> m_Top{ 0 };
+    alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+    std::atomic<Job*> m_Buffer[CAPACITY];
+};
+
+struct alignas(64) JobSystem::ThreadState {
+    WorkStealingDeque deque;
+    uint32_t stealSeed = 1;                     // xorshift state for picking victims
+
+    // Written by the owning thread only
+    std::atomic<uint64_t> executed{ 0 };
+    std::atomic<uint64_t> stolen{ 0 };
+    std::atomic<uint64_t> mainThreadJobs{ 0 };
+};
+
+// ============================================================================
+// JobSystem
+// ============================================================================
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    if (workerCount == DEFAULT_WORKER_COUNT) {
+        uint32_t hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+
+    m_ThreadCount = workerCount + 1;
+    m_Threads.reserve(m_ThreadCount);
+    for (uint32_t i = 0; i < m_ThreadCount; ++i) {
+        m_Threads.push_back(std::make_unique<ThreadState>());
+        m_Threads.back()->stealSeed = 0x9E3779B9u * (i + 1);
+    }
+
+    m_MainThreadId = std::this_thread::get_id();
+    t_System = this;
+    t_ThreadIndex = 0;
+
+    m_Workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        m_Workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Stopping.store(true);
+    }
+    m_WakeCondition.notify_all();
+
+    for (auto& worker : m_Workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    m_Workers.clear();
+
+    // Workers finish their current job only; whatever is still queued runs here,
+    // MainThread jobs included, so no counter is left waiting on a dropped job.
+    // Jobs released or scheduled meanwhile are picked up by the same loop.
+    uint32_t threadIndex = getCurrentThreadIndex();
+    while (true) {
+        bool stolen = false;
+        Job* job = popFront(m_MainThreadMutex, m_MainThreadQueue, m_MainThreadSize);
+        if (!job) {
+            job = findJob(threadIndex, stolen);
+        }
+        if (!job) {
+            break;
+        }
+        execute(job, threadIndex, stolen);
+    }
+
+    if (t_System == this) {
+        t_System = nullptr;
+        t_ThreadIndex = EXTERNAL_THREAD_INDEX;
+    }
+}
+
+uint32_t JobSystem::getCurrentThreadIndex() const {
+    return t_System == this ? t_ThreadIndex : EXTERNAL_THREAD_INDEX;
+}
+
+bool JobSystem::isMainThread() const {
+    return std::this_thread::get_id() == m_MainThreadId;
+}
+
+JobCounterRef JobSystem::schedule(JobFunction func, const JobDesc& desc, JobCounterRef counter) {
+    if (!counter) {
+        counter = std::make_shared<JobCounter>();
+    }
+    counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+    Job* job = new Job{ std::move(func), desc.name, desc.affinity, counter };
+
+    if (desc.dependency) {
+        std::lock_guard<std::mutex> lock(desc.dependency->m_Mutex);
+        if (desc.dependency->m_Pending.load(std::memory_order_acquire) != 0) {
+            desc.dependency->m_Waiters.push_back(job);
+            return counter;
+        }
+    }
+
+    enqueue(job);
+    return counter;
+}
+
+void JobSystem::enqueue(Job* job) {
+    if (job->affinity == JobAffinity::MainThread) {
+        std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+        m_MainThreadQueue.push_back(job);
+        m_MainThreadSize.store(static_cast<uint32_t>(m_MainThreadQueue.size()), std::memory_order_release);
+        return;
+    }
+
+    uint32_t threadIndex = getCurrentThreadIndex();
+    if (job->affinity == JobAffinity::Background) {
+        std::lock_guard<std::mutex> lock(m_BackgroundMutex);
+        m_BackgroundQueue.push_back(job);
+        m_BackgroundSize.store(static_cast<uint32_t>(m_BackgroundQueue.size()), std::memory_order_release);
+    } else if (threadIndex == EXTERNAL_THREAD_INDEX || !m_Threads[threadIndex]->deque.push(job)) {
+        std::lock_guard<std::mutex> lock(m_InjectMutex);
+        m_InjectQueue.push_back(job);
+        m_InjectSize.store(static_cast<uint32_t>(m_InjectQueue.size()), std::memory_order_release);
+    }
+
+    m_QueuedJobs.fetch_add(1);
+    wakeWorkers(1);
+}
+
+void JobSystem::wakeWorkers(uint32_t count) {
+    // Pairs with the sleeper count in workerLoop: either the worker sees the
+    // queued job, or we see it sleeping and notify under the mutex
+    if (m_SleepingWorkers.load() == 0) {
+        return;
+    }
+    { std::lock_guard<std::mutex> lock(m_WakeMutex); }
+    if (count == 1) {
+        m_WakeCondition.notify_one();
+    } else {
+        m_WakeCondition.notify_all();
+    }
+}
+
+Job* JobSystem::findJob(uint32_t threadIndex, bool& stolen) {
+    stolen = false;
+    Job* job = nullptr;
+
+    if (threadIndex != EXTERNAL_THREAD_INDEX) {
+        job = m_Threads[threadIndex]->deque.pop();
+    }
+
+    if (!job) {
+        job = popFront(m_InjectMutex, m_InjectQueue, m_InjectSize);
+    }
+
+    if (!job && m_ThreadCount > 1) {
+        // Start at a random victim so thieves spread over the deques
+        uint32_t start = 0;
+        if (threadIndex != EXTERNAL_THREAD_INDEX) {
+            uint32_t& seed = m_Threads[threadIndex]->stealSeed;
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            start = seed % m_ThreadCount;
+        }
+        for (uint32_t i = 0; i < m_ThreadCount && !job; ++i) {
+            uint32_t victim = (start + i) % m_ThreadCount;
+            if (victim != threadIndex) {
+                job = m_Threads[victim]->deque.steal();
+                stolen = job != nullptr;
+            }
+        }
+    }
+
+    // Background work last, and never on the main thread while workers exist:
+    // a wait there must not pick up a seconds-long asset load
+    if (!job && (!isMainThread() || m_Workers.empty())) {
+        job = popFront(m_BackgroundMutex, m_BackgroundQueue, m_BackgroundSize);
+    }
+
+    if (job) {
+        m_QueuedJobs.fetch_sub(1);
+    }
+    return job;
+}
+
+Job* JobSystem::popFront(std::mutex& mutex, std::deque<Job*>& queue, std::atomic<uint32_t>& size) {
+    if (size.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) {
+        return nullptr;
+    }
+    Job* job = queue.front();
+    queue.pop_front();
+    size.store(static_cast<uint32_t>(queue.size()), std::memory_order_release);
+    return job;
+}
+
+bool JobSystem::runOneJob() {
+    uint32_t threadIndex = getCurrentThreadIndex();
+
+    if (isMainThread()) {
+        if (Job* job = popFront(m_MainThreadMutex, m_MainThreadQueue, m_MainThreadSize)) {
+            execute(job, threadIndex, false);
+            return true;
+        }
+    }
+
+    bool stolen = false;
+    Job* job = findJob(threadIndex, stolen);
+    if (!job) {
+        return false;
+    }
+    execute(job, threadIndex, stolen);
+    return true;
+}
+
+void JobSystem::execute(Job* job, uint32_t threadIndex, bool stolen) {
+    if (m_Instrumentation.onJobBegin || m_Instrumentation.onJobEnd) {
+        JobEvent event;
+        event.name = job->name;
+        event.threadIndex = threadIndex;
+        event.stolen = stolen;
+        event.start = std::chrono::high_resolution_clock::now();
+        if (m_Instrumentation.onJobBegin) {
+            m_Instrumentation.onJobBegin(event);
+        }
+
+        job->func();
+
+        event.end = std::chrono::high_resolution_clock::now();
+        if (m_Instrumentation.onJobEnd) {
+            m_Instrumentation.onJobEnd(event);
+        }
+    } else {
+        job->func();
+    }
+
+    if (threadIndex == EXTERNAL_THREAD_INDEX) {
+        m_ExternalExecuted.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        ThreadState& state = *m_Threads[threadIndex];
+        state.executed.store(state.executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (stolen) {
+            state.stolen.store(state.stolen.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        if (job->affinity == JobAffinity::MainThread) {
+            state.mainThreadJobs.store(state.mainThreadJobs.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+        }
+    }
+
+    finish(job);
+}
+
+void JobSystem::finish(Job* job) {
+    JobCounterRef counter = std::move(job->counter);
+    delete job;
+
+    if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // Counter reached zero: release the jobs that depend on it. Re-checked under
+    // the lock, since the counter may have been reused by a new schedule() meanwhile.
+    std::vector<Job*> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_Mutex);
+        if (counter->m_Pending.load(std::memory_order_acquire) == 0) {
+            ready.swap(counter->m_Waiters);
+        }
+    }
+    for (Job* waiter : ready) {
+        enqueue(waiter);
+    }
+}
+
+void JobSystem::workerLoop(uint32_t threadIndex) {
+    t_System = this;
+    t_ThreadIndex = threadIndex;
+
+    uint32_t idleSpins = 0;
+    while (!m_Stopping.load(std::memory_order_relaxed)) {
+        bool stolen = false;
+        Job* job = findJob(threadIndex, stolen);
+        if (job) {
+            execute(job, threadIndex, stolen);
+            idleSpins = 0;
+            continue;
+        }
+
+        if (++idleSpins < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        idleSpins = 0;
+        m_SleepingWorkers.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_WakeCondition.wait(lock, [this]() { return m_Stopping.load() || m_QueuedJobs.load() > 0; });
+        }
+        m_SleepingWorkers.fetch_sub(1);
+    }
+}
+
+void JobSystem::wait(const JobCounterRef& counter) {
+    if (!counter) {
+        return;
+    }
+
+    while (!counter->isDone()) {
+        if (!runOneJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t JobSystem::runMainThreadJobs() {
+    if (!isMainThread()) {
+        return 0;
+    }
+
+    // Only what is queued now; jobs these schedule run next frame
+    std::deque<Job*> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+        jobs.swap(m_MainThreadQueue);
+        m_MainThreadSize.store(0, std::memory_order_release);
+    }
+
+    uint32_t threadIndex = getCurrentThreadIndex();
+    for (Job* job : jobs) {
+        execute(job, threadIndex, false);
+    }
+    return static_cast<uint32_t>(jobs.size());
+}
+
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& func, size_t grainSize,
+                            const char* name) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount == 1 || m_Workers.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    // Helpers and the caller claim chunks until none are left. The caller waits
+    // for every helper job, so the state can live on this stack frame.
+    std::atomic<size_t> nextChunk{ 0 };
+    auto runChunks = [&nextChunk, &func, count, grainSize, chunkCount]() {
+        size_t chunk;
+        while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+            size_t begin = chunk * grainSize;
+            size_t end = std::min(begin + grainSize, count);
+            for (size_t i = begin; i < end; ++i) {
+                func(i);
+            }
+        }
+    };
+
+    JobDesc desc;
+    desc.name = name;
+    JobCounterRef counter = std::make_shared<JobCounter>();
+    size_t helperCount = std::min(chunkCount - 1, m_Workers.size());
+    for (size_t i = 0; i < helperCount; ++i) {
+        schedule(runChunks, desc, counter);
+    }
+
+    runChunks();
+    wait(counter);
+}
+
+JobSystemStats JobSystem::getStats() const {
+    JobSystemStats stats;
+    stats.executed = m_ExternalExecuted.load(std::memory_order_relaxed);
+    for (const auto& state : m_Threads) {
+        stats.executed += state->executed.load(std::memory_order_relaxed);
+        stats.stolen += state->stolen.load(std::memory_order_relaxed);
+        stats.mainThreadJobs += state->mainThreadJobs.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void JobSystem::resetStats() {
+    m_ExternalExecuted.store(0, std::memory_order_relaxed);
+    for (auto& state : m_Threads) {
+        state->executed.store(0, std::memory_order_relaxed);
+        state->stolen.store(0, std::memory_order_relaxed);
+        state->mainThreadJobs.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace MiEngine
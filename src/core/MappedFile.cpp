@@ -0,0 +1,138 @@
+#include "core/MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MiEngine {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+        m_IsOpen = std::exchange(other.m_IsOpen, false);
+#ifdef _WIN32
+        m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+        m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+#else
+        m_Fd = std::exchange(other.m_Fd, -1);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::filesystem::path& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_FileHandle = file;
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+    m_IsOpen = true;
+
+    if (m_Size == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return false;
+    }
+    m_MappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        close();
+        return false;
+    }
+    m_Data = static_cast<const uint8_t*>(view);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_Fd = fd;
+    m_Size = static_cast<size_t>(st.st_size);
+    m_IsOpen = true;
+
+    if (m_Size == 0) {
+        return true;
+    }
+
+    void* view = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        close();
+        return false;
+    }
+    m_Data = static_cast<const uint8_t*>(view);
+#endif
+
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (m_Data) {
+        UnmapViewOfFile(m_Data);
+    }
+    if (m_MappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+        m_MappingHandle = nullptr;
+    }
+    if (m_FileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_FileHandle));
+        m_FileHandle = nullptr;
+    }
+#else
+    if (m_Data) {
+        munmap(const_cast<uint8_t*>(m_Data), m_Size);
+    }
+    if (m_Fd >= 0) {
+        ::close(m_Fd);
+        m_Fd = -1;
+    }
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+    m_IsOpen = false;
+}
+
+} // namespace MiEngine
@@ -28,11 +28,18 @@ MiActor::~MiActor() {
     m_ComponentsByType.clear();
 }
 
+void MiActor::setName(const std::string& name) {
+    if (m_World && name != getName()) {
+        m_World->renameActor(getName(), name);
+    }
+    MiObject::setName(name);
+}
+
 // ============================================================================
 // Transform
 // ============================================================================
 
-const MiTransform& MiActor::getTransform() const {
+MiTransform MiActor::getTransform() const {
     if (m_RootComponent) {
         return m_RootComponent->getLocalTransform();
     }
@@ -139,10 +146,14 @@ void MiActor::registerComponent(const std::shared_ptr<MiComponent>& component) {
     m_Components.push_back(component);
 
     // Update type cache
-    m_ComponentsByType[typeid(*component)].push_back(m_Components.size() - 1);
+    m_ComponentsByType.add(component.get());
 
     // Call lifecycle
     component->onAttached();
+    markTickScheduleDirty();
+    if (m_World) {
+        m_World->indexComponent(component.get());
+    }
 
     // If we've already begun play, call beginPlay on the component
     if (m_HasBegunPlay) {
@@ -168,6 +179,10 @@ void MiActor::unregisterComponent(const std::shared_ptr<MiComponent>& component)
 
     // Remove from owner
     component->setOwner(nullptr);
+    markTickScheduleDirty();
+    if (m_World) {
+        m_World->unindexComponent(component.get());
+    }
 
     // Notify derived classes
     onComponentRemoved(component);
@@ -195,8 +210,8 @@ void MiActor::removeComponent(const std::shared_ptr<MiComponent>& component) {
 
 void MiActor::rebuildComponentTypeCache() {
     m_ComponentsByType.clear();
-    for (size_t i = 0; i < m_Components.size(); ++i) {
-        m_ComponentsByType[typeid(*m_Components[i])].push_back(i);
+    for (const auto& component : m_Components) {
+        m_ComponentsByType.add(component.get());
     }
 }
 
@@ -225,7 +240,7 @@ void MiActor::setRootComponent(std::shared_ptr<MiSceneComponent> root) {
 void MiActor::createDefaultComponents() {
     // Create a default root scene component if none exists
     if (!m_RootComponent) {
-        auto root = std::make_shared<MiSceneComponent>();
+        auto root = makePooled<MiSceneComponent>();
         root->setName("DefaultRoot");
         setRootComponent(root);
     }
@@ -281,6 +296,69 @@ void MiActor::tick(float deltaTime) {
     }
 }
 
+// ============================================================================
+// Tick Settings
+// ============================================================================
+
+void MiActor::setTickGroup(TickGroup group) {
+    if (group != m_TickGroup && group != TickGroup::Count) {
+        m_TickGroup = group;
+        markTickScheduleDirty();
+    }
+}
+
+void MiActor::setTickThreadSafe(bool threadSafe) {
+    if (threadSafe != m_TickThreadSafe) {
+        m_TickThreadSafe = threadSafe;
+        markTickScheduleDirty();
+    }
+}
+
+void MiActor::addTickPrerequisite(const std::shared_ptr<MiActor>& prerequisite) {
+    if (!prerequisite || prerequisite.get() == this) {
+        return;
+    }
+
+    for (const auto& existing : m_TickPrerequisites) {
+        if (existing.lock() == prerequisite) {
+            return;
+        }
+    }
+    m_TickPrerequisites.push_back(prerequisite);
+    markTickScheduleDirty();
+}
+
+void MiActor::removeTickPrerequisite(const std::shared_ptr<MiActor>& prerequisite) {
+    auto it = std::remove_if(m_TickPrerequisites.begin(), m_TickPrerequisites.end(),
+        [&prerequisite](const MiWeakActorPtr& existing) {
+            auto locked = existing.lock();
+            return !locked || locked == prerequisite;
+        });
+    if (it != m_TickPrerequisites.end()) {
+        m_TickPrerequisites.erase(it, m_TickPrerequisites.end());
+        markTickScheduleDirty();
+    }
+}
+
+bool MiActor::canTickInParallel() const {
+    if (!m_TickThreadSafe) {
+        return false;
+    }
+
+    for (const auto& component : m_Components) {
+        if (component->isTickable() && !component->isTickThreadSafe()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MiActor::markTickScheduleDirty() {
+    if (m_World) {
+        m_World->getTickScheduler().markDirty();
+    }
+}
+
 // ============================================================================
 // Flags
 // ============================================================================
@@ -305,14 +383,14 @@ void MiActor::setSelected(bool selected) {
 // Tags
 // ============================================================================
 
-void MiActor::addTag(const std::string& tag) {
-    if (!hasTag(tag)) {
+void MiActor::addTag(MiName tag) {
+    if (!tag.isNone() && !hasTag(tag)) {
         m_Tags.push_back(tag);
         markDirty();
     }
 }
 
-void MiActor::removeTag(const std::string& tag) {
+void MiActor::removeTag(MiName tag) {
     auto it = std::find(m_Tags.begin(), m_Tags.end(), tag);
     if (it != m_Tags.end()) {
         m_Tags.erase(it);
@@ -320,7 +398,7 @@ void MiActor::removeTag(const std::string& tag) {
     }
 }
 
-bool MiActor::hasTag(const std::string& tag) const {
+bool MiActor::hasTag(MiName tag) const {
     return std::find(m_Tags.begin(), m_Tags.end(), tag) != m_Tags.end();
 }
 
@@ -342,6 +420,25 @@ void MiActor::destroy() {
     }
 }
 
+// ============================================================================
+// Recycling
+// ============================================================================
+
+void MiActor::onRecycled() {
+    for (auto& component : m_Components) {
+        component->onRecycled();
+    }
+}
+
+void MiActor::resetForReuse() {
+    removeFlags(ActorFlags::Destroying | ActorFlags::Selected);
+    m_PendingDestroy = false;
+    m_TickPrerequisites.clear();
+    ++m_Generation;
+
+    onRecycled();
+}
+
 // ============================================================================
 // Serialization
 // ============================================================================
@@ -356,8 +453,8 @@ void MiActor::serialize(JsonWriter& writer) const {
 
     // Tags
     writer.beginArray("tags");
-    for (const auto& tag : m_Tags) {
-        writer.writeArrayString(tag);
+    for (MiName tag : m_Tags) {
+        writer.writeArrayString(tag.toString());
     }
     writer.endArray();
 
@@ -387,7 +484,10 @@ void MiActor::deserialize(const JsonReader& reader) {
     m_Layer = reader.getUInt("layer", 0);
 
     // Tags
-    m_Tags = reader.getStringArray("tags");
+    m_Tags.clear();
+    for (const std::string& tag : reader.getStringArray("tags")) {
+        addTag(MiName(tag));
+    }
 
     // Transform
     JsonReader transformReader = reader.getObject("transform");
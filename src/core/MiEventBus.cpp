@@ -0,0 +1,73 @@
+#include "core/MiEventBus.h"
+#include <chrono>
+
+namespace MiEngine {
+
+uint32_t MiEventBus::nextEventTypeIndex() {
+    static std::atomic<uint32_t> s_NextIndex{0};
+    return s_NextIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+MiEventQueueBase* MiEventBus::createQueue(uint32_t typeIndex, std::unique_ptr<MiEventQueueBase> queue) {
+    std::lock_guard<std::mutex> lock(m_CreateMutex);
+
+    // Another thread may have created it first
+    if (MiEventQueueBase* existing = m_QueuesByType[typeIndex].load(std::memory_order_acquire)) {
+        return existing;
+    }
+
+    uint32_t order = m_QueueCount.load(std::memory_order_relaxed);
+    MiEventQueueBase* created = queue.get();
+    m_Queues[order] = std::move(queue);
+    m_QueuesByType[typeIndex].store(created, std::memory_order_release);
+    m_QueueCount.store(order + 1, std::memory_order_release);
+    return created;
+}
+
+void MiEventBus::dispatch() {
+    // A listener dispatching again would deliver the batch being delivered
+    if (m_Dispatching) {
+        return;
+    }
+    m_Dispatching = true;
+
+    // Reset even when a listener throws, or every later dispatch would stop above
+    struct DispatchGuard {
+        bool& dispatching;
+        ~DispatchGuard() { dispatching = false; }
+    } guard{ m_Dispatching };
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Take every type's events first, so anything posted by listeners waits for the next dispatch
+    uint32_t queueCount = m_QueueCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < queueCount; ++i) {
+        m_Queues[i]->swapPending();
+    }
+
+    for (uint32_t i = 0; i < queueCount; ++i) {
+        size_t count = m_Queues[i]->deliver();
+        if (count > 0) {
+            m_FrameStats.eventCount += count;
+            ++m_FrameStats.batchCount;
+        }
+    }
+
+    ++m_FrameStats.dispatchCount;
+    m_FrameStats.dispatchMs +=
+        std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void MiEventBus::endFrame() {
+    m_LastFrameStats = m_FrameStats;
+    m_FrameStats = Stats();
+}
+
+void MiEventBus::clear() {
+    uint32_t queueCount = m_QueueCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < queueCount; ++i) {
+        m_Queues[i]->clear();
+    }
+}
+
+} // namespace MiEngine
@@ -0,0 +1,131 @@
+#include "core/MiName.h"
+#include "core/Hash.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace MiEngine {
+
+namespace {
+
+struct TextHash {
+    size_t operator()(std::string_view text) const noexcept { return fnv1a32(text); }
+};
+
+// Entries live in fixed-size chunks that never move, so toString() and
+// getHash() read them without a lock; only interning a new text takes the
+// exclusive lock. The table is never destroyed (names may be used during
+// static destruction).
+class NameTable {
+public:
+    static constexpr uint32_t CHUNK_SIZE = 4096;
+    static constexpr uint32_t MAX_CHUNKS = 1024;    // 4M names
+
+    struct Entry {
+        std::string text;
+        uint32_t hash = 0;
+    };
+
+    NameTable() {
+        // Index 0 is None
+        append(std::string_view());
+    }
+
+    uint32_t find(std::string_view text) const {
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+        auto it = m_Indices.find(text);
+        return it != m_Indices.end() ? it->second : 0;
+    }
+
+    uint32_t intern(std::string_view text) {
+        if (uint32_t index = find(text)) {
+            return index;
+        }
+        std::unique_lock<std::shared_mutex> lock(m_Mutex);
+        // Another thread may have added it between the locks
+        auto it = m_Indices.find(text);
+        if (it != m_Indices.end()) {
+            return it->second;
+        }
+        return append(text);
+    }
+
+    const Entry& get(uint32_t index) const {
+        Entry* chunk = m_Chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+        return chunk[index % CHUNK_SIZE];
+    }
+
+    size_t getCount() const {
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+        return m_Count;
+    }
+
+private:
+    // Caller holds the exclusive lock (or is the constructor)
+    uint32_t append(std::string_view text) {
+        uint32_t index = m_Count;
+        uint32_t chunkIndex = index / CHUNK_SIZE;
+        if (chunkIndex >= MAX_CHUNKS) {
+            throw std::runtime_error("MiName: name table full");
+        }
+
+        Entry* chunk = m_Chunks[chunkIndex].load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new Entry[CHUNK_SIZE];
+            m_Chunks[chunkIndex].store(chunk, std::memory_order_release);
+        }
+
+        Entry& entry = chunk[index % CHUNK_SIZE];
+        entry.text.assign(text.data(), text.size());
+        entry.hash = fnv1a32(text);
+        ++m_Count;
+
+        // Keyed by a view of the stored text
+        if (index != 0) {
+            m_Indices.emplace(std::string_view(entry.text), index);
+        }
+        return index;
+    }
+
+    mutable std::shared_mutex m_Mutex;
+    std::unordered_map<std::string_view, uint32_t, TextHash> m_Indices;
+    std::array<std::atomic<Entry*>, MAX_CHUNKS> m_Chunks{};
+    uint32_t m_Count = 0;
+};
+
+NameTable& nameTable() {
+    static NameTable* table = new NameTable();
+    return *table;
+}
+
+} // anonymous namespace
+
+MiName::MiName(std::string_view text)
+    : m_Index(text.empty() ? 0 : nameTable().intern(text)) {
+}
+
+MiName MiName::find(std::string_view text) {
+    return fromIndex(text.empty() ? 0 : nameTable().find(text));
+}
+
+uint32_t MiName::getHash() const {
+    return nameTable().get(m_Index).hash;
+}
+
+const std::string& MiName::toString() const {
+    return nameTable().get(m_Index).text;
+}
+
+size_t MiName::getNameCount() {
+    return nameTable().getCount();
+}
+
+std::ostream& operator<<(std::ostream& stream, const MiName& name) {
+    return stream << name.toString();
+}
+
+} // namespace MiEngine
@@ -1,36 +1,105 @@
 #include "core/MiObject.h"
+#include "core/Hash.h"
 #include "core/JsonIO.h"
+#include <chrono>
 #include <random>
-#include <sstream>
-#include <iomanip>
+#include <thread>
 
 namespace MiEngine {
 
-// Generate UUID v4 format string
-ObjectId generateObjectId() {
-    static std::random_device rd;
-    static std::mt19937_64 gen(rd());
-    static std::uniform_int_distribution<uint64_t> dis;
+namespace {
+
+// splitmix64: an add and two multiplies per 64 random bits
+uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t seedRandomState() {
+    std::random_device rd;
+    uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+
+    // random_device can be deterministic; the clock and thread keep threads apart anyway
+    seed ^= static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    seed ^= static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) * 0xD6E8FEB86659FD93ULL;
+    return seed;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // anonymous namespace
 
-    uint64_t ab = dis(gen);
-    uint64_t cd = dis(gen);
+// ============================================================================
+// ObjectId
+// ============================================================================
 
+ObjectId generateObjectId() {
+    thread_local uint64_t state = seedRandomState();
+
+    ObjectId id;
     // Set version to 4 (random UUID)
-    ab = (ab & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+    id.high = (nextRandom(state) & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
     // Set variant to RFC 4122
-    cd = (cd & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+    id.low = (nextRandom(state) & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+    return id;
+}
+
+std::string ObjectId::toString() const {
+    static constexpr char DIGITS[] = "0123456789abcdef";
 
-    std::ostringstream ss;
-    ss << std::hex << std::setfill('0');
-    ss << std::setw(8) << ((ab >> 32) & 0xFFFFFFFF) << "-";
-    ss << std::setw(4) << ((ab >> 16) & 0xFFFF) << "-";
-    ss << std::setw(4) << (ab & 0xFFFF) << "-";
-    ss << std::setw(4) << ((cd >> 48) & 0xFFFF) << "-";
-    ss << std::setw(12) << (cd & 0xFFFFFFFFFFFFULL);
+    std::string text(36, '-');
+    size_t pos = 0;
+    for (int nibble = 0; nibble < 32; ++nibble) {
+        if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+            ++pos;
+        }
+        uint64_t word = nibble < 16 ? high : low;
+        text[pos++] = DIGITS[(word >> (60 - 4 * (nibble % 16))) & 0xF];
+    }
+    return text;
+}
+
+ObjectId ObjectId::fromString(std::string_view text) {
+    ObjectId id;
+    if (text.empty()) {
+        return id;
+    }
 
-    return ss.str();
+    int digits = 0;
+    for (char c : text) {
+        if (c == '-') {
+            continue;
+        }
+        int value = hexValue(c);
+        if (value < 0 || digits == 32) {
+            digits = -1;
+            break;
+        }
+        uint64_t& word = digits < 16 ? id.high : id.low;
+        word = (word << 4) | static_cast<uint64_t>(value);
+        ++digits;
+    }
+    if (digits == 32) {
+        return id;
+    }
+
+    // Not a UUID: derive a stable id so references to it still match
+    id.high = fnv1a64(text);
+    id.low = fnv1a64(text, 0x84222325CBF29CE4ULL);
+    return id;
 }
 
+// ============================================================================
+// MiObject
+// ============================================================================
+
 MiObject::MiObject()
     : m_ObjectId(generateObjectId())
     , m_Name("Object")
@@ -40,13 +109,16 @@ MiObject::MiObject()
 }
 
 void MiObject::serialize(JsonWriter& writer) const {
-    writer.writeString("id", m_ObjectId);
+    writer.writeString("id", m_ObjectId.toString());
     writer.writeString("name", m_Name);
     writer.writeString("type", getTypeName());
 }
 
 void MiObject::deserialize(const JsonReader& reader) {
-    m_ObjectId = reader.getString("id", m_ObjectId);
+    std::string id = reader.getString("id", "");
+    if (!id.empty()) {
+        m_ObjectId = ObjectId::fromString(id);
+    }
     m_Name = reader.getString("name", m_Name);
     // Type is read by the factory, not here
 }
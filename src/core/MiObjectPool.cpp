@@ -0,0 +1,176 @@
+#include "core/MiObjectPool.h"
+#include "core/MiActor.h"
+#include <algorithm>
+#include <new>
+
+namespace MiEngine {
+
+namespace {
+
+std::mutex& poolListMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Pools are never destroyed, so the raw pointers stay valid
+std::vector<MiSlabPool*>& poolList() {
+    static std::vector<MiSlabPool*>* pools = new std::vector<MiSlabPool*>();
+    return *pools;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Slab Pool
+// ============================================================================
+
+MiSlabPool::MiSlabPool(const char* name, size_t blockSize, size_t blockAlign)
+    : m_Name(name)
+    , m_BlockAlign(std::max(blockAlign, alignof(FreeBlock))) {
+    // Free blocks hold the list link in place
+    m_BlockSize = std::max(blockSize, sizeof(FreeBlock));
+    m_BlockSize = (m_BlockSize + m_BlockAlign - 1) / m_BlockAlign * m_BlockAlign;
+    m_BlocksPerSlab = std::max<size_t>(1, SLAB_BYTES / m_BlockSize);
+
+    std::lock_guard<std::mutex> lock(poolListMutex());
+    poolList().push_back(this);
+}
+
+void* MiSlabPool::allocate() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (!m_FreeList) {
+        addSlab();
+    }
+    FreeBlock* block = m_FreeList;
+    m_FreeList = block->next;
+
+    ++m_LiveCount;
+    ++m_AllocationCount;
+    m_PeakCount = std::max(m_PeakCount, m_LiveCount);
+    return block;
+}
+
+void MiSlabPool::deallocate(void* block) {
+    if (!block) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // LIFO: the next allocation reuses this (still cached) block
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = m_FreeList;
+    m_FreeList = freeBlock;
+    --m_LiveCount;
+}
+
+void MiSlabPool::addSlab() {
+    char* slab = static_cast<char*>(::operator new(m_BlockSize * m_BlocksPerSlab, std::align_val_t(m_BlockAlign)));
+    m_Slabs.push_back(slab);
+
+    // Thread the blocks in address order so a fresh slab is handed out sequentially
+    for (size_t i = m_BlocksPerSlab; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * m_BlockSize);
+        block->next = m_FreeList;
+        m_FreeList = block;
+    }
+}
+
+MiSlabPool::Stats MiSlabPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    Stats stats;
+    stats.name = m_Name ? m_Name : "";
+    stats.blockSize = m_BlockSize;
+    stats.blocksPerSlab = m_BlocksPerSlab;
+    stats.slabCount = m_Slabs.size();
+    stats.liveCount = m_LiveCount;
+    stats.peakCount = m_PeakCount;
+    stats.allocationCount = m_AllocationCount;
+    return stats;
+}
+
+std::vector<MiSlabPool::Stats> MiSlabPool::getAllStats() {
+    std::vector<MiSlabPool*> pools;
+    {
+        std::lock_guard<std::mutex> lock(poolListMutex());
+        pools = poolList();
+    }
+
+    std::vector<Stats> stats;
+    stats.reserve(pools.size());
+    for (MiSlabPool* pool : pools) {
+        stats.push_back(pool->getStats());
+    }
+    return stats;
+}
+
+// ============================================================================
+// Recycle Bin
+// ============================================================================
+
+bool MiRecycleBin::recycle(std::shared_ptr<MiActor>& actor) {
+    // Anything else holding the actor would see it come back to life
+    if (!actor || !actor->isRecyclable() || actor.use_count() != 1 || actor->getWorld()) {
+        return false;
+    }
+
+    std::type_index type = typeid(*actor);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Bins.find(type);
+        if (it != m_Bins.end() && it->second.size() >= m_Capacity) {
+            return false;
+        }
+    }
+
+    actor->resetForReuse();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Bins[type].push_back(std::move(actor));
+    return true;
+}
+
+std::shared_ptr<MiActor> MiRecycleBin::takeByType(std::type_index type) {
+    std::shared_ptr<MiActor> actor;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Bins.find(type);
+        if (it == m_Bins.end() || it->second.empty()) {
+            return nullptr;
+        }
+        actor = std::move(it->second.back());
+        it->second.pop_back();
+        ++m_ReuseCount;
+    }
+
+    // A new actor as far as lookups and serialization are concerned
+    actor->setObjectId(generateObjectId());
+    return actor;
+}
+
+void MiRecycleBin::clear() {
+    std::unordered_map<std::type_index, std::vector<std::shared_ptr<MiActor>>> bins;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        bins.swap(m_Bins);
+    }
+    // Actors are destroyed outside the lock
+}
+
+size_t MiRecycleBin::getCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    size_t count = 0;
+    for (const auto& [type, actors] : m_Bins) {
+        count += actors.size();
+    }
+    return count;
+}
+
+uint64_t MiRecycleBin::getReuseCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_ReuseCount;
+}
+
+} // namespace MiEngine
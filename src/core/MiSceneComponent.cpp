@@ -6,47 +6,83 @@
 
 namespace MiEngine {
 
+namespace {
+
+MiTransformSystem& transforms() {
+    return MiTransformSystem::getInstance();
+}
+
+} // anonymous namespace
+
 MiSceneComponent::MiSceneComponent()
     : MiComponent()
-    , m_LocalTransform()
-    , m_CachedWorldTransform()
-    , m_WorldTransformDirty(true)
     , m_Parent(nullptr)
     , m_Visible(true)
 {
     setName("SceneComponent");
+    m_TransformSlot = transforms().allocate(this);
+}
+
+MiSceneComponent::~MiSceneComponent() {
+    // Children keep their place in the world; the slot must not outlive us
+    std::vector<MiSceneComponent*> children = m_Children;
+    for (auto* child : children) {
+        child->detachFromParent(true);
+    }
+    if (m_Parent) {
+        m_Parent->removeChild(this);
+    }
+    transforms().release(m_TransformSlot);
 }
 
 // ============================================================================
 // Local Transform
 // ============================================================================
 
+MiTransform MiSceneComponent::getLocalTransform() const {
+    return transforms().getLocalTransform(m_TransformSlot);
+}
+
+glm::vec3 MiSceneComponent::getLocalPosition() const {
+    return transforms().getLocalPosition(m_TransformSlot);
+}
+
+glm::quat MiSceneComponent::getLocalRotation() const {
+    return transforms().getLocalRotation(m_TransformSlot);
+}
+
+glm::vec3 MiSceneComponent::getLocalScale() const {
+    return transforms().getLocalScale(m_TransformSlot);
+}
+
 void MiSceneComponent::setLocalTransform(const MiTransform& transform) {
-    m_LocalTransform = transform;
+    transforms().setLocalTransform(m_TransformSlot, transform);
     markTransformDirty();
     onTransformChanged();
 }
 
 void MiSceneComponent::setLocalPosition(const glm::vec3& position) {
-    m_LocalTransform.position = position;
+    transforms().setLocalPosition(m_TransformSlot, position);
     markTransformDirty();
     onTransformChanged();
 }
 
 void MiSceneComponent::setLocalRotation(const glm::quat& rotation) {
-    m_LocalTransform.rotation = rotation;
+    transforms().setLocalRotation(m_TransformSlot, rotation);
     markTransformDirty();
     onTransformChanged();
 }
 
 void MiSceneComponent::setLocalScale(const glm::vec3& scale) {
-    m_LocalTransform.scale = scale;
+    transforms().setLocalScale(m_TransformSlot, scale);
     markTransformDirty();
     onTransformChanged();
 }
 
 void MiSceneComponent::setLocalEulerAngles(const glm::vec3& eulerRadians) {
-    m_LocalTransform.setEulerAngles(eulerRadians);
+    MiTransform local;
+    local.setEulerAngles(eulerRadians);
+    transforms().setLocalRotation(m_TransformSlot, local.rotation);
     markTransformDirty();
     onTransformChanged();
 }
@@ -55,30 +91,12 @@ void MiSceneComponent::setLocalEulerAngles(const glm::vec3& eulerRadians) {
 // World Transform
 // ============================================================================
 
-void MiSceneComponent::updateWorldTransform() const {
-    if (!m_WorldTransformDirty) {
-        return;
-    }
-
-    if (m_Parent) {
-        // Combine with parent's world transform
-        MiTransform parentWorld = m_Parent->getWorldTransform();
-        m_CachedWorldTransform = parentWorld * m_LocalTransform;
-    } else {
-        // No parent, local is world
-        m_CachedWorldTransform = m_LocalTransform;
-    }
-
-    m_WorldTransformDirty = false;
-}
-
 MiTransform MiSceneComponent::getWorldTransform() const {
-    updateWorldTransform();
-    return m_CachedWorldTransform;
+    return transforms().getWorldTransform(m_TransformSlot);
 }
 
 glm::mat4 MiSceneComponent::getWorldMatrix() const {
-    return getWorldTransform().getMatrix();
+    return transforms().getWorldMatrix(m_TransformSlot);
 }
 
 glm::vec3 MiSceneComponent::getWorldPosition() const {
@@ -97,9 +115,9 @@ void MiSceneComponent::setWorldPosition(const glm::vec3& position) {
     if (m_Parent) {
         // Convert world position to local
         MiTransform parentWorld = m_Parent->getWorldTransform();
-        m_LocalTransform.position = parentWorld.inverseTransformPoint(position);
+        transforms().setLocalPosition(m_TransformSlot, parentWorld.inverseTransformPoint(position));
     } else {
-        m_LocalTransform.position = position;
+        transforms().setLocalPosition(m_TransformSlot, position);
     }
     markTransformDirty();
     onTransformChanged();
@@ -109,9 +127,9 @@ void MiSceneComponent::setWorldRotation(const glm::quat& rotation) {
     if (m_Parent) {
         // Convert world rotation to local
         glm::quat parentWorldRot = m_Parent->getWorldRotation();
-        m_LocalTransform.rotation = glm::inverse(parentWorldRot) * rotation;
+        transforms().setLocalRotation(m_TransformSlot, glm::inverse(parentWorldRot) * rotation);
     } else {
-        m_LocalTransform.rotation = rotation;
+        transforms().setLocalRotation(m_TransformSlot, rotation);
     }
     markTransformDirty();
     onTransformChanged();
@@ -121,9 +139,9 @@ void MiSceneComponent::setWorldScale(const glm::vec3& scale) {
     if (m_Parent) {
         // Convert world scale to local
         glm::vec3 parentWorldScale = m_Parent->getWorldScale();
-        m_LocalTransform.scale = scale / parentWorldScale;
+        transforms().setLocalScale(m_TransformSlot, scale / parentWorldScale);
     } else {
-        m_LocalTransform.scale = scale;
+        transforms().setLocalScale(m_TransformSlot, scale);
     }
     markTransformDirty();
     onTransformChanged();
@@ -146,7 +164,7 @@ glm::vec3 MiSceneComponent::getUpVector() const {
 // ============================================================================
 
 void MiSceneComponent::addLocalOffset(const glm::vec3& offset) {
-    m_LocalTransform.position += offset;
+    transforms().setLocalPosition(m_TransformSlot, getLocalPosition() + offset);
     markTransformDirty();
     onTransformChanged();
 }
@@ -156,7 +174,7 @@ void MiSceneComponent::addWorldOffset(const glm::vec3& offset) {
 }
 
 void MiSceneComponent::addLocalRotation(const glm::quat& rotation) {
-    m_LocalTransform.rotation = m_LocalTransform.rotation * rotation;
+    transforms().setLocalRotation(m_TransformSlot, getLocalRotation() * rotation);
     markTransformDirty();
     onTransformChanged();
 }
@@ -212,11 +230,12 @@ void MiSceneComponent::attachTo(MiSceneComponent* parent, bool keepWorldTransfor
     if (m_Parent) {
         m_Parent->addChild(this);
     }
+    transforms().setParent(m_TransformSlot, m_Parent ? m_Parent->m_TransformSlot : MiTransformSystem::INVALID_SLOT);
 
     // Restore world transform if requested
     if (keepWorldTransform && m_Parent) {
         MiTransform parentWorld = m_Parent->getWorldTransform();
-        m_LocalTransform = parentWorld.inverse() * worldTransform;
+        transforms().setLocalTransform(m_TransformSlot, parentWorld.inverse() * worldTransform);
     }
 
     markTransformDirty();
@@ -234,9 +253,10 @@ void MiSceneComponent::detachFromParent(bool keepWorldTransform) {
 
     m_Parent->removeChild(this);
     m_Parent = nullptr;
+    transforms().setParent(m_TransformSlot, MiTransformSystem::INVALID_SLOT);
 
     if (keepWorldTransform) {
-        m_LocalTransform = worldTransform;
+        transforms().setLocalTransform(m_TransformSlot, worldTransform);
     }
 
     markTransformDirty();
@@ -331,13 +351,9 @@ void MiSceneComponent::getWorldBounds(glm::vec3& outMin, glm::vec3& outMax) cons
 // ============================================================================
 
 void MiSceneComponent::markTransformDirty() {
-    m_WorldTransformDirty = true;
+    // Children follow in the next propagate(); reads before that compose through us
+    transforms().markDirty(m_TransformSlot);
     markDirty();
-
-    // Mark all children as dirty too
-    for (auto* child : m_Children) {
-        child->markTransformDirty();
-    }
 }
 
 void MiSceneComponent::onTransformChanged() {
@@ -353,7 +369,7 @@ void MiSceneComponent::serialize(JsonWriter& writer) const {
     MiComponent::serialize(writer);
 
     writer.beginObject("transform");
-    m_LocalTransform.serialize(writer);
+    getLocalTransform().serialize(writer);
     writer.endObject();
 
     writer.writeBool("visible", m_Visible);
@@ -366,7 +382,9 @@ void MiSceneComponent::deserialize(const JsonReader& reader) {
 
     JsonReader transformReader = reader.getObject("transform");
     if (transformReader.isValid()) {
-        m_LocalTransform.deserialize(transformReader);
+        MiTransform local = getLocalTransform();
+        local.deserialize(transformReader);
+        transforms().setLocalTransform(m_TransformSlot, local);
     }
 
     m_Visible = reader.getBool("visible", true);
@@ -375,6 +393,6 @@ void MiSceneComponent::deserialize(const JsonReader& reader) {
 }
 
 // Register the type
-MI_REGISTER_TYPE(MiSceneComponent)
+MI_REGISTER_TYPE_WITH_PARENT(MiSceneComponent, MiComponent)
 
 } // namespace MiEngine
@@ -0,0 +1,145 @@
+#include "core/MiTickScheduler.h"
+#include "core/MiActor.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MiEngine {
+
+namespace {
+
+constexpr uint32_t LEVEL_VISITING = ~0u;
+
+inline void tickActor(MiActor* actor, float deltaTime) {
+    if (!actor->isPendingDestroy() && actor->hasBegunPlay()) {
+        actor->tick(deltaTime);
+    }
+}
+
+} // anonymous namespace
+
+const char* getTickGroupName(TickGroup group) {
+    switch (group) {
+        case TickGroup::PrePhysics: return "PrePhysics";
+        case TickGroup::DuringPhysics: return "DuringPhysics";
+        case TickGroup::PostPhysics: return "PostPhysics";
+        case TickGroup::PostUpdate: return "PostUpdate";
+        default: return "Unknown";
+    }
+}
+
+void MiTickScheduler::rebuild(const std::vector<std::shared_ptr<MiActor>>& actors) {
+    m_Dirty.store(false, std::memory_order_relaxed);
+    for (auto& levels : m_Groups) {
+        levels.clear();
+    }
+
+    std::unordered_map<MiActor*, uint32_t> levels;
+
+    for (const auto& actor : actors) {
+        // Most actors have no prerequisites and never enter the map
+        uint32_t level = actor->getTickPrerequisites().empty() ? 0 : resolveLevel(actor.get(), levels);
+
+        auto& group = m_Groups[static_cast<size_t>(actor->getTickGroup())];
+        if (group.size() <= level) {
+            group.resize(level + 1);
+        }
+        if (actor->canTickInParallel()) {
+            group[level].parallel.push_back(actor.get());
+        } else {
+            group[level].serial.push_back(actor.get());
+        }
+    }
+}
+
+uint32_t MiTickScheduler::resolveLevel(MiActor* actor, std::unordered_map<MiActor*, uint32_t>& levels) {
+    auto found = levels.find(actor);
+    if (found != levels.end()) {
+        return found->second;
+    }
+
+    // Depth first over prerequisites; the stack is the current path, so a
+    // prerequisite that is still being visited closes a cycle
+    std::vector<MiActor*> stack{ actor };
+    levels[actor] = LEVEL_VISITING;
+
+    while (!stack.empty()) {
+        MiActor* current = stack.back();
+        uint32_t level = 0;
+        bool descended = false;
+
+        for (const auto& weak : current->getTickPrerequisites()) {
+            auto prerequisite = weak.lock();
+            if (!prerequisite || prerequisite->getWorld() != current->getWorld() ||
+                prerequisite->getTickGroup() != current->getTickGroup()) {
+                continue;
+            }
+
+            if (prerequisite->getTickPrerequisites().empty()) {
+                level = std::max(level, 1u);
+                continue;
+            }
+
+            auto it = levels.find(prerequisite.get());
+            if (it == levels.end()) {
+                levels[prerequisite.get()] = LEVEL_VISITING;
+                stack.push_back(prerequisite.get());
+                descended = true;
+                break;
+            }
+            if (it->second == LEVEL_VISITING) {
+                // The cycle is the path from the prerequisite back to current
+                std::vector<ObjectId> cycle;
+                for (auto member = std::find(stack.begin(), stack.end(), prerequisite.get()); member != stack.end();
+                     ++member) {
+                    cycle.push_back((*member)->getObjectId());
+                }
+                std::sort(cycle.begin(), cycle.end());
+                if (m_ReportedCycles.insert(std::move(cycle)).second) {
+                    std::cerr << "MiTickScheduler: Tick prerequisite cycle between " << current->getName()
+                              << " and " << prerequisite->getName() << ", ignoring it" << std::endl;
+                }
+                continue;
+            }
+            level = std::max(level, it->second + 1);
+        }
+
+        if (!descended) {
+            levels[current] = level;
+            stack.pop_back();
+        }
+    }
+
+    return levels[actor];
+}
+
+void MiTickScheduler::tickGroup(TickGroup group, float deltaTime) {
+    JobSystem& jobSystem = JobSystem::getInstance();
+
+    for (const TickLevel& level : m_Groups[static_cast<size_t>(group)]) {
+        if (!level.parallel.empty()) {
+            m_TickingParallel.store(true, std::memory_order_release);
+            jobSystem.parallelFor(level.parallel.size(), [&level, deltaTime](size_t i) {
+                tickActor(level.parallel[i], deltaTime);
+            }, PARALLEL_GRAIN, "MiWorld::tick");
+            m_TickingParallel.store(false, std::memory_order_release);
+        }
+
+        for (MiActor* actor : level.serial) {
+            tickActor(actor, deltaTime);
+        }
+    }
+}
+
+MiTickScheduler::GroupStats MiTickScheduler::getGroupStats(TickGroup group) const {
+    GroupStats stats;
+    const auto& levels = m_Groups[static_cast<size_t>(group)];
+    stats.levelCount = static_cast<uint32_t>(levels.size());
+    for (const TickLevel& level : levels) {
+        stats.parallelCount += static_cast<uint32_t>(level.parallel.size());
+        stats.actorCount += static_cast<uint32_t>(level.parallel.size() + level.serial.size());
+    }
+    return stats;
+}
+
+} // namespace MiEngine
@@ -0,0 +1,719 @@
+#include "core/MiTransformSystem.h"
+#include "core/MiSceneComponent.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MI_TRANSFORM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MiEngine {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// One float for each of four transforms
+// ----------------------------------------------------------------------------
+
+#ifdef MI_TRANSFORM_SSE2
+struct Lanes { __m128 v; };
+inline Lanes lanes(float s) { return { _mm_set1_ps(s) }; }
+inline Lanes loadLanes(const float* p) { return { _mm_loadu_ps(p) }; }
+inline void storeLanes(float* p, Lanes a) { _mm_storeu_ps(p, a.v); }
+inline Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+#else
+struct Lanes { float v[4]; };
+template <typename Op>
+inline Lanes mapLanes(Lanes a, Lanes b, Op op) {
+    Lanes r;
+    for (int i = 0; i < 4; ++i) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+inline Lanes lanes(float s) { return { { s, s, s, s } }; }
+inline Lanes loadLanes(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void storeLanes(float* p, Lanes a) { std::memcpy(p, a.v, sizeof(a.v)); }
+inline Lanes operator+(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x + y; }); }
+inline Lanes operator-(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x - y; }); }
+inline Lanes operator*(Lanes a, Lanes b) { return mapLanes(a, b, [](float x, float y) { return x * y; }); }
+#endif
+
+constexpr float IDENTITY_CHANNELS[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+template <typename Channels>
+MiTransform readTransform(const Channels& channels, uint32_t i) {
+    return MiTransform(glm::vec3(channels[0][i], channels[1][i], channels[2][i]),
+                       glm::quat(channels[6][i], channels[3][i], channels[4][i], channels[5][i]),
+                       glm::vec3(channels[7][i], channels[8][i], channels[9][i]));
+}
+
+template <typename Channels>
+void writeTransform(Channels& channels, uint32_t i, const MiTransform& transform) {
+    const float values[] = {
+        transform.position.x, transform.position.y, transform.position.z,
+        transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+        transform.scale.x, transform.scale.y, transform.scale.z
+    };
+    for (uint32_t channel = 0; channel < 10; ++channel) {
+        channels[channel][i] = values[channel];
+    }
+}
+
+uint32_t alignToGroup(uint32_t slot) {
+    return (slot + 3u) & ~3u;
+}
+
+} // anonymous namespace
+
+MiTransformSystem& MiTransformSystem::getInstance() {
+    static MiTransformSystem instance;
+    return instance;
+}
+
+// ============================================================================
+// Slots
+// ============================================================================
+
+uint32_t MiTransformSystem::allocate(MiSceneComponent* owner) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // A root is valid in any level; its children will want the levels after it
+    uint32_t slot = takeSlot(0);
+
+    Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    for (uint32_t channel = 0; channel < CHANNEL_COUNT; ++channel) {
+        page.local[channel][i] = IDENTITY_CHANNELS[channel];
+        page.world[channel][i] = IDENTITY_CHANNELS[channel];
+    }
+    page.worldMatrix[i] = glm::mat4(1.0f);
+    page.owner[i] = owner;
+    page.dirty[i] = 1;
+
+    ++m_LiveCount;
+    m_AnyDirty.store(true, std::memory_order_relaxed);
+    return slot;
+}
+
+void MiTransformSystem::release(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    unlinkChild(slot);
+    Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    page.owner[i] = nullptr;
+    page.parent[i] = INVALID_SLOT;
+    page.dirty[i] = 0;
+
+    // The slot stays where it is, free for the next allocation that fits its level
+    m_FreeSlots[levelOf(slot)].push_back(slot);
+    --m_LiveCount;
+}
+
+void MiTransformSystem::setParent(uint32_t slot, uint32_t parentSlot) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    unlinkChild(slot);
+    if (parentSlot != INVALID_SLOT) {
+        linkChild(parentSlot, slot);
+        if (levelOf(parentSlot) >= levelOf(slot)) {
+            m_PendingMoves.push_back(slot);
+        }
+    }
+    markDirty(slot);
+}
+
+uint32_t MiTransformSystem::getParent(uint32_t slot) const {
+    return pageOf(slot).parent[slot % PAGE_SIZE];
+}
+
+uint32_t MiTransformSystem::levelOf(uint32_t slot) const {
+    // Empty levels share their start with the next one; upper_bound skips them
+    auto it = std::upper_bound(m_LevelStart.begin(), m_LevelStart.end(), slot);
+    return static_cast<uint32_t>(it - m_LevelStart.begin()) - 1;
+}
+
+uint32_t MiTransformSystem::takeSlot(uint32_t minLevel) {
+    if (m_LevelStart.empty()) {
+        addLevel();
+    }
+    for (uint32_t level = minLevel; level < m_FreeSlots.size(); ++level) {
+        auto& freeSlots = m_FreeSlots[level];
+        if (!freeSlots.empty()) {
+            uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+    }
+
+    // Only the last level can grow
+    while (m_FreeSlots.size() <= minLevel) {
+        addLevel();
+    }
+    appendSlot();
+    return m_SlotCount - 1;
+}
+
+void MiTransformSystem::appendSlot() {
+    if (m_SlotCount == PAGE_SIZE * MAX_PAGES) {
+        throw std::runtime_error("MiTransformSystem: out of transform slots");
+    }
+    uint32_t slot = m_SlotCount++;
+    auto& page = m_Pages[slot / PAGE_SIZE];
+    if (!page) {
+        page = std::make_unique<Page>();
+    }
+    uint32_t i = slot % PAGE_SIZE;
+    page->parent[i] = INVALID_SLOT;
+    page->firstChild[i] = INVALID_SLOT;
+    page->nextSibling[i] = INVALID_SLOT;
+    page->prevSibling[i] = INVALID_SLOT;
+    page->owner[i] = nullptr;
+    page->dirty[i] = 0;
+    m_LevelStart.back() = m_SlotCount;
+}
+
+void MiTransformSystem::addLevel() {
+    if (m_LevelStart.empty()) {
+        m_LevelStart = { m_SlotCount, m_SlotCount };
+        m_FreeSlots.resize(1);
+        return;
+    }
+
+    // Pad the current last level so the new one starts on a group of four
+    while (m_SlotCount % 4 != 0) {
+        appendSlot();
+        m_FreeSlots.back().push_back(m_SlotCount - 1);
+    }
+    m_LevelStart.push_back(m_SlotCount);
+    m_FreeSlots.emplace_back();
+}
+
+void MiTransformSystem::linkChild(uint32_t parent, uint32_t slot) {
+    Page& parentPage = pageOf(parent);
+    Page& page = pageOf(slot);
+    uint32_t p = parent % PAGE_SIZE;
+    uint32_t i = slot % PAGE_SIZE;
+    uint32_t next = parentPage.firstChild[p];
+    page.parent[i] = parent;
+    page.prevSibling[i] = INVALID_SLOT;
+    page.nextSibling[i] = next;
+    if (next != INVALID_SLOT) {
+        pageOf(next).prevSibling[next % PAGE_SIZE] = slot;
+    }
+    parentPage.firstChild[p] = slot;
+}
+
+void MiTransformSystem::unlinkChild(uint32_t slot) {
+    Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    uint32_t parent = page.parent[i];
+    if (parent == INVALID_SLOT) {
+        return;
+    }
+    uint32_t prev = page.prevSibling[i];
+    uint32_t next = page.nextSibling[i];
+    if (prev != INVALID_SLOT) {
+        pageOf(prev).nextSibling[prev % PAGE_SIZE] = next;
+    } else {
+        pageOf(parent).firstChild[parent % PAGE_SIZE] = next;
+    }
+    if (next != INVALID_SLOT) {
+        pageOf(next).prevSibling[next % PAGE_SIZE] = prev;
+    }
+    page.parent[i] = INVALID_SLOT;
+    page.prevSibling[i] = INVALID_SLOT;
+    page.nextSibling[i] = INVALID_SLOT;
+}
+
+// ============================================================================
+// Local Transform
+// ============================================================================
+
+MiTransform MiTransformSystem::getLocalTransform(uint32_t slot) const {
+    return readTransform(pageOf(slot).local, slot % PAGE_SIZE);
+}
+
+glm::vec3 MiTransformSystem::getLocalPosition(uint32_t slot) const {
+    const Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    return glm::vec3(page.local[POS_X][i], page.local[POS_Y][i], page.local[POS_Z][i]);
+}
+
+glm::quat MiTransformSystem::getLocalRotation(uint32_t slot) const {
+    const Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    return glm::quat(page.local[ROT_W][i], page.local[ROT_X][i], page.local[ROT_Y][i], page.local[ROT_Z][i]);
+}
+
+glm::vec3 MiTransformSystem::getLocalScale(uint32_t slot) const {
+    const Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    return glm::vec3(page.local[SCALE_X][i], page.local[SCALE_Y][i], page.local[SCALE_Z][i]);
+}
+
+void MiTransformSystem::setLocalTransform(uint32_t slot, const MiTransform& transform) {
+    writeTransform(pageOf(slot).local, slot % PAGE_SIZE, transform);
+}
+
+void MiTransformSystem::setLocalPosition(uint32_t slot, const glm::vec3& position) {
+    Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    page.local[POS_X][i] = position.x;
+    page.local[POS_Y][i] = position.y;
+    page.local[POS_Z][i] = position.z;
+}
+
+void MiTransformSystem::setLocalRotation(uint32_t slot, const glm::quat& rotation) {
+    Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    page.local[ROT_X][i] = rotation.x;
+    page.local[ROT_Y][i] = rotation.y;
+    page.local[ROT_Z][i] = rotation.z;
+    page.local[ROT_W][i] = rotation.w;
+}
+
+void MiTransformSystem::setLocalScale(uint32_t slot, const glm::vec3& scale) {
+    Page& page = pageOf(slot);
+    uint32_t i = slot % PAGE_SIZE;
+    page.local[SCALE_X][i] = scale.x;
+    page.local[SCALE_Y][i] = scale.y;
+    page.local[SCALE_Z][i] = scale.z;
+}
+
+void MiTransformSystem::markDirty(uint32_t slot) {
+    pageOf(slot).dirty[slot % PAGE_SIZE] = 1;
+    m_AnyDirty.store(true, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// World Transform
+// ============================================================================
+
+MiTransform MiTransformSystem::getWorldTransform(uint32_t slot) const {
+    if (m_AnyDirty.load(std::memory_order_relaxed)) {
+        // A change above slot that propagate() hasn't reached yet makes the cache stale
+        uint32_t top = INVALID_SLOT;
+        for (uint32_t current = slot; current != INVALID_SLOT; current = getParent(current)) {
+            if (pageOf(current).dirty[current % PAGE_SIZE]) {
+                top = current;
+            }
+        }
+        if (top != INVALID_SLOT) {
+            return composeWorld(slot, top);
+        }
+    }
+    return readTransform(pageOf(slot).world, slot % PAGE_SIZE);
+}
+
+glm::mat4 MiTransformSystem::getWorldMatrix(uint32_t slot) const {
+    if (m_AnyDirty.load(std::memory_order_relaxed)) {
+        for (uint32_t current = slot; current != INVALID_SLOT; current = getParent(current)) {
+            if (pageOf(current).dirty[current % PAGE_SIZE]) {
+                return getWorldTransform(slot).getMatrix();
+            }
+        }
+    }
+    return pageOf(slot).worldMatrix[slot % PAGE_SIZE];
+}
+
+MiTransform MiTransformSystem::composeWorld(uint32_t slot, uint32_t top) const {
+    uint32_t parent = getParent(slot);
+    MiTransform parentWorld;
+    if (slot != top) {
+        parentWorld = composeWorld(parent, top);
+    } else if (parent != INVALID_SLOT) {
+        parentWorld = readTransform(pageOf(parent).world, parent % PAGE_SIZE);
+    }
+    return parentWorld * getLocalTransform(slot);
+}
+
+// ============================================================================
+// Propagation
+// ============================================================================
+
+void MiTransformSystem::propagate() {
+    if (!m_AnyDirty.load(std::memory_order_acquire)) {
+        m_LastUpdatedCount = 0;
+        return;
+    }
+
+    m_LastMovedCount = 0;
+    if (!m_PendingMoves.empty()) {
+        moveReparented();
+    }
+    if (needsFullSort()) {
+        sortByDepth();
+    }
+
+    JobSystem& jobSystem = JobSystem::getInstance();
+    uint32_t updated = 0;
+
+    for (size_t level = 0; level + 1 < m_LevelStart.size(); ++level) {
+        uint32_t begin = m_LevelStart[level];
+        uint32_t end = m_LevelStart[level + 1];
+
+        if (!m_ParallelPropagation || end - begin < PARALLEL_MIN_SLOTS) {
+            updated += propagateRange(begin, end);
+            continue;
+        }
+
+        // Chunks are whole groups of four, so no two threads write the same group
+        std::atomic<uint32_t> levelUpdated{ 0 };
+        size_t chunkCount = (end - begin + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        jobSystem.parallelFor(chunkCount, [this, begin, end, &levelUpdated](size_t chunk) {
+            uint32_t chunkBegin = begin + static_cast<uint32_t>(chunk) * PARALLEL_GRAIN;
+            uint32_t chunkEnd = std::min(chunkBegin + PARALLEL_GRAIN, end);
+            levelUpdated.fetch_add(propagateRange(chunkBegin, chunkEnd), std::memory_order_relaxed);
+        }, 1, "MiTransformSystem::propagate");
+        updated += levelUpdated.load(std::memory_order_relaxed);
+    }
+
+    for (uint32_t first = 0; first < m_SlotCount; first += PAGE_SIZE) {
+        std::memset(pageOf(first).dirty, 0, std::min(PAGE_SIZE, m_SlotCount - first));
+    }
+
+    m_LastUpdatedCount = updated;
+    m_AnyDirty.store(false, std::memory_order_release);
+}
+
+uint32_t MiTransformSystem::propagateRange(uint32_t begin, uint32_t end) {
+    uint32_t updated = 0;
+
+    for (uint32_t group = begin; group < end; group += 4) {
+        Page& page = pageOf(group);
+        uint32_t i = group % PAGE_SIZE;
+
+        // Gather the parents' world transforms; a lane is written if it or its parent changed
+        alignas(16) float parentChannels[CHANNEL_COUNT][4];
+        bool write[4];
+        bool anyWrite = false;
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            uint32_t parent = page.parent[i + lane];
+            bool changed = page.dirty[i + lane] != 0;
+            if (parent == INVALID_SLOT) {
+                for (uint32_t channel = 0; channel < CHANNEL_COUNT; ++channel) {
+                    parentChannels[channel][lane] = IDENTITY_CHANNELS[channel];
+                }
+            } else {
+                const Page& parentPage = pageOf(parent);
+                uint32_t p = parent % PAGE_SIZE;
+                for (uint32_t channel = 0; channel < CHANNEL_COUNT; ++channel) {
+                    parentChannels[channel][lane] = parentPage.world[channel][p];
+                }
+                changed = changed || parentPage.dirty[p] != 0;
+            }
+            write[lane] = changed && page.owner[i + lane] != nullptr;
+            anyWrite = anyWrite || write[lane];
+        }
+        if (!anyWrite) {
+            continue;
+        }
+
+        Lanes ppx = loadLanes(parentChannels[POS_X]), ppy = loadLanes(parentChannels[POS_Y]), ppz = loadLanes(parentChannels[POS_Z]);
+        Lanes pqx = loadLanes(parentChannels[ROT_X]), pqy = loadLanes(parentChannels[ROT_Y]);
+        Lanes pqz = loadLanes(parentChannels[ROT_Z]), pqw = loadLanes(parentChannels[ROT_W]);
+        Lanes psx = loadLanes(parentChannels[SCALE_X]), psy = loadLanes(parentChannels[SCALE_Y]), psz = loadLanes(parentChannels[SCALE_Z]);
+
+        Lanes lpx = loadLanes(&page.local[POS_X][i]), lpy = loadLanes(&page.local[POS_Y][i]), lpz = loadLanes(&page.local[POS_Z][i]);
+        Lanes lqx = loadLanes(&page.local[ROT_X][i]), lqy = loadLanes(&page.local[ROT_Y][i]);
+        Lanes lqz = loadLanes(&page.local[ROT_Z][i]), lqw = loadLanes(&page.local[ROT_W][i]);
+        Lanes lsx = loadLanes(&page.local[SCALE_X][i]), lsy = loadLanes(&page.local[SCALE_Y][i]), lsz = loadLanes(&page.local[SCALE_Z][i]);
+
+        // world = parent * local, as MiTransform::operator*
+        Lanes sx = psx * lsx, sy = psy * lsy, sz = psz * lsz;
+
+        Lanes qw = pqw * lqw - pqx * lqx - pqy * lqy - pqz * lqz;
+        Lanes qx = pqw * lqx + pqx * lqw + pqy * lqz - pqz * lqy;
+        Lanes qy = pqw * lqy + pqy * lqw + pqz * lqx - pqx * lqz;
+        Lanes qz = pqw * lqz + pqz * lqw + pqx * lqy - pqy * lqx;
+
+        // Parent rotation applied to the parent-scaled local position (glm's quat * vec3)
+        Lanes vx = psx * lpx, vy = psy * lpy, vz = psz * lpz;
+        Lanes ux = pqy * vz - pqz * vy, uy = pqz * vx - pqx * vz, uz = pqx * vy - pqy * vx;
+        Lanes uux = pqy * uz - pqz * uy, uuy = pqz * ux - pqx * uz, uuz = pqx * uy - pqy * ux;
+        Lanes two = lanes(2.0f);
+        Lanes px = ppx + vx + (ux * pqw + uux) * two;
+        Lanes py = ppy + vy + (uy * pqw + uuy) * two;
+        Lanes pz = ppz + vz + (uz * pqw + uuz) * two;
+
+        // Columns of translate * mat4_cast(rotation) * scale
+        Lanes one = lanes(1.0f);
+        Lanes xx = qx * qx, yy = qy * qy, zz = qz * qz;
+        Lanes xy = qx * qy, xz = qx * qz, yz = qy * qz;
+        Lanes wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+        alignas(16) float world[CHANNEL_COUNT][4];
+        alignas(16) float basis[9][4];
+        storeLanes(world[POS_X], px);
+        storeLanes(world[POS_Y], py);
+        storeLanes(world[POS_Z], pz);
+        storeLanes(world[ROT_X], qx);
+        storeLanes(world[ROT_Y], qy);
+        storeLanes(world[ROT_Z], qz);
+        storeLanes(world[ROT_W], qw);
+        storeLanes(world[SCALE_X], sx);
+        storeLanes(world[SCALE_Y], sy);
+        storeLanes(world[SCALE_Z], sz);
+        storeLanes(basis[0], (one - two * (yy + zz)) * sx);
+        storeLanes(basis[1], two * (xy + wz) * sx);
+        storeLanes(basis[2], two * (xz - wy) * sx);
+        storeLanes(basis[3], two * (xy - wz) * sy);
+        storeLanes(basis[4], (one - two * (xx + zz)) * sy);
+        storeLanes(basis[5], two * (yz + wx) * sy);
+        storeLanes(basis[6], two * (xz + wy) * sz);
+        storeLanes(basis[7], two * (yz - wx) * sz);
+        storeLanes(basis[8], (one - two * (xx + yy)) * sz);
+
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if (!write[lane]) {
+                continue;
+            }
+            uint32_t slot = i + lane;
+            for (uint32_t channel = 0; channel < CHANNEL_COUNT; ++channel) {
+                page.world[channel][slot] = world[channel][lane];
+            }
+            glm::mat4& matrix = page.worldMatrix[slot];
+            matrix[0] = glm::vec4(basis[0][lane], basis[1][lane], basis[2][lane], 0.0f);
+            matrix[1] = glm::vec4(basis[3][lane], basis[4][lane], basis[5][lane], 0.0f);
+            matrix[2] = glm::vec4(basis[6][lane], basis[7][lane], basis[8][lane], 0.0f);
+            matrix[3] = glm::vec4(world[POS_X][lane], world[POS_Y][lane], world[POS_Z][lane], 1.0f);
+
+            // Children in the next level see this as a changed parent
+            page.dirty[slot] = 1;
+            ++updated;
+        }
+    }
+    return updated;
+}
+
+void MiTransformSystem::moveReparented() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    std::vector<uint32_t> pending = std::move(m_PendingMoves);
+    m_PendingMoves.clear();
+    std::vector<uint32_t> work;
+    for (uint32_t slot : pending) {
+        if (!pageOf(slot).owner[slot % PAGE_SIZE]) {
+            continue;
+        }
+
+        // Start at the topmost slot above it that is out of order, so every slot of
+        // the subtree moves once, after its parent
+        uint32_t top = slot;
+        for (uint32_t current = slot, parent = getParent(slot); parent != INVALID_SLOT;
+             current = parent, parent = getParent(parent)) {
+            if (levelOf(parent) >= levelOf(current)) {
+                top = current;
+            }
+        }
+
+        work.push_back(top);
+        while (!work.empty()) {
+            uint32_t current = work.back();
+            work.pop_back();
+            uint32_t parent = getParent(current);
+            if (parent == INVALID_SLOT || levelOf(parent) < levelOf(current)) {
+                continue;
+            }
+
+            uint32_t target = takeSlot(levelOf(parent) + 1);
+            moveSlot(current, target);
+            ++m_LastMovedCount;
+
+            for (uint32_t child = pageOf(target).firstChild[target % PAGE_SIZE]; child != INVALID_SLOT;
+                 child = pageOf(child).nextSibling[child % PAGE_SIZE]) {
+                work.push_back(child);
+            }
+        }
+    }
+}
+
+void MiTransformSystem::moveSlot(uint32_t from, uint32_t to) {
+    Page& source = pageOf(from);
+    Page& target = pageOf(to);
+    uint32_t i = from % PAGE_SIZE;
+    uint32_t t = to % PAGE_SIZE;
+
+    for (uint32_t channel = 0; channel < CHANNEL_COUNT; ++channel) {
+        target.local[channel][t] = source.local[channel][i];
+        target.world[channel][t] = source.world[channel][i];
+    }
+    target.worldMatrix[t] = source.worldMatrix[i];
+    target.owner[t] = source.owner[i];
+    target.dirty[t] = 1;    // Its parent changed
+    target.owner[t]->m_TransformSlot = to;
+
+    // Take over the old slot's place in its parent's list and its children
+    uint32_t parent = source.parent[i];
+    uint32_t prev = source.prevSibling[i];
+    uint32_t next = source.nextSibling[i];
+    target.parent[t] = parent;
+    target.prevSibling[t] = prev;
+    target.nextSibling[t] = next;
+    target.firstChild[t] = source.firstChild[i];
+    if (prev != INVALID_SLOT) {
+        pageOf(prev).nextSibling[prev % PAGE_SIZE] = to;
+    } else if (parent != INVALID_SLOT) {
+        pageOf(parent).firstChild[parent % PAGE_SIZE] = to;
+    }
+    if (next != INVALID_SLOT) {
+        pageOf(next).prevSibling[next % PAGE_SIZE] = to;
+    }
+    for (uint32_t child = target.firstChild[t]; child != INVALID_SLOT;
+         child = pageOf(child).nextSibling[child % PAGE_SIZE]) {
+        pageOf(child).parent[child % PAGE_SIZE] = to;
+    }
+
+    source.owner[i] = nullptr;
+    source.parent[i] = INVALID_SLOT;
+    source.firstChild[i] = INVALID_SLOT;
+    source.prevSibling[i] = INVALID_SLOT;
+    source.nextSibling[i] = INVALID_SLOT;
+    source.dirty[i] = 0;
+    m_FreeSlots[levelOf(from)].push_back(from);
+}
+
+bool MiTransformSystem::needsFullSort() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Moves only ever add levels, and freed slots stay behind as holes. Both cost
+    // propagate() time, so compact once they have doubled (amortized O(1) per change).
+    uint32_t levelCount = m_LevelStart.empty() ? 0 : static_cast<uint32_t>(m_LevelStart.size() - 1);
+    uint32_t freeCount = m_SlotCount - m_LiveCount;
+    return levelCount > 2 * m_SortedLevelCount + 4 || freeCount > m_LiveCount + PAGE_SIZE;
+}
+
+void MiTransformSystem::sortByDepth() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Depth of every live slot, walking up to the nearest slot already known
+    std::vector<uint32_t> depth(m_SlotCount, INVALID_SLOT);
+    std::vector<uint32_t> path;
+    uint32_t levelCount = 0;
+    for (uint32_t slot = 0; slot < m_SlotCount; ++slot) {
+        if (!pageOf(slot).owner[slot % PAGE_SIZE] || depth[slot] != INVALID_SLOT) {
+            continue;
+        }
+        uint32_t current = slot;
+        while (current != INVALID_SLOT && depth[current] == INVALID_SLOT) {
+            path.push_back(current);
+            current = getParent(current);
+        }
+        uint32_t base = current == INVALID_SLOT ? 0 : depth[current] + 1;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            depth[*it] = base++;
+        }
+        levelCount = std::max(levelCount, base);
+        path.clear();
+    }
+
+    // Level ranges, each starting on a group of four. A quarter of each level is
+    // left spare so subtrees attached later move next to their parent instead of
+    // growing new levels.
+    std::vector<uint32_t> levelSize(levelCount, 0);
+    for (uint32_t slot = 0; slot < m_SlotCount; ++slot) {
+        if (depth[slot] != INVALID_SLOT) {
+            ++levelSize[depth[slot]];
+        }
+    }
+    std::vector<uint32_t> levelStart(levelCount + 1, 0);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        levelStart[level + 1] = alignToGroup(levelStart[level] + levelSize[level] + levelSize[level] / 4);
+    }
+    uint32_t newCount = levelStart[levelCount];
+
+    // Keep the old order within a level
+    std::vector<uint32_t> newSlot(m_SlotCount, INVALID_SLOT);
+    std::vector<uint32_t> cursor(levelStart.begin(), levelStart.end() - 1);
+    for (uint32_t slot = 0; slot < m_SlotCount; ++slot) {
+        if (depth[slot] != INVALID_SLOT) {
+            newSlot[slot] = cursor[depth[slot]]++;
+        }
+    }
+
+    std::vector<std::unique_ptr<Page>> newPages((newCount + PAGE_SIZE - 1) / PAGE_SIZE);
+    for (auto& page : newPages) {
+        page = std::make_unique<Page>();
+        std::fill(std::begin(page->parent), std::end(page->parent), INVALID_SLOT);
+        std::fill(std::begin(page->firstChild), std::end(page->firstChild), INVALID_SLOT);
+        std::fill(std::begin(page->nextSibling), std::end(page->nextSibling), INVALID_SLOT);
+        std::fill(std::begin(page->prevSibling), std::end(page->prevSibling), INVALID_SLOT);
+    }
+
+    for (uint32_t slot = 0; slot < m_SlotCount; ++slot) {
+        uint32_t target = newSlot[slot];
+        if (target == INVALID_SLOT) {
+            continue;
+        }
+        const Page& from = pageOf(slot);
+        Page& to = *newPages[target / PAGE_SIZE];
+        uint32_t i = slot % PAGE_SIZE;
+        uint32_t t = target % PAGE_SIZE;
+        for (uint32_t channel = 0; channel < CHANNEL_COUNT; ++channel) {
+            to.local[channel][t] = from.local[channel][i];
+            to.world[channel][t] = from.world[channel][i];
+        }
+        to.worldMatrix[t] = from.worldMatrix[i];
+        to.parent[t] = from.parent[i] == INVALID_SLOT ? INVALID_SLOT : newSlot[from.parent[i]];
+        to.owner[t] = from.owner[i];
+        to.dirty[t] = from.dirty[i];
+        from.owner[i]->m_TransformSlot = target;
+    }
+
+    for (auto& page : m_Pages) {
+        page.reset();
+    }
+    for (size_t page = 0; page < newPages.size(); ++page) {
+        m_Pages[page] = std::move(newPages[page]);
+    }
+
+    m_SlotCount = newCount;
+    m_LevelStart = std::move(levelStart);
+    if (m_LevelStart.size() < 2) {
+        m_LevelStart = { 0, 0 };    // Keep level 0 so takeSlot() has somewhere to start
+    }
+
+    // Spare slots and padding are free in their level
+    m_FreeSlots.assign(m_LevelStart.size() - 1, {});
+    for (uint32_t level = 0; level + 1 < m_LevelStart.size(); ++level) {
+        for (uint32_t slot = m_LevelStart[level + 1]; slot-- > m_LevelStart[level];) {
+            if (!pageOf(slot).owner[slot % PAGE_SIZE]) {
+                m_FreeSlots[level].push_back(slot);
+            }
+        }
+    }
+
+    rebuildChildLists();
+    m_PendingMoves.clear();
+    m_SortedLevelCount = static_cast<uint32_t>(m_LevelStart.size() - 1);
+    ++m_FullSortCount;
+}
+
+void MiTransformSystem::rebuildChildLists() {
+    for (uint32_t slot = m_SlotCount; slot-- > 0;) {
+        uint32_t parent = pageOf(slot).parent[slot % PAGE_SIZE];
+        if (parent != INVALID_SLOT) {
+            linkChild(parent, slot);
+        }
+    }
+}
+
+MiTransformSystem::Stats MiTransformSystem::getStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Stats stats;
+    stats.transformCount = m_LiveCount;
+    stats.slotCount = m_SlotCount;
+    stats.levelCount = m_LevelStart.empty() ? 0 : static_cast<uint32_t>(m_LevelStart.size() - 1);
+    stats.updatedCount = m_LastUpdatedCount;
+    stats.movedCount = m_LastMovedCount;
+    stats.fullSortCount = m_FullSortCount;
+    return stats;
+}
+
+} // namespace MiEngine
@@ -0,0 +1,64 @@
+#include "core/MiTypeIndex.h"
+
+namespace MiEngine {
+
+void MiTypeIndexSet::add(MiObject* object) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_ObjectPositions.count(object)) {
+        return;
+    }
+    m_ObjectPositions[object] = static_cast<uint32_t>(m_Objects.size());
+    m_Objects.push_back(object);
+
+    for (MiTypeIndexBase* index : indicesOf(object)) {
+        index->add(object);
+    }
+}
+
+void MiTypeIndexSet::remove(MiObject* object) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_ObjectPositions.find(object);
+    if (it == m_ObjectPositions.end()) {
+        return;
+    }
+    uint32_t position = it->second;
+    m_ObjectPositions.erase(it);
+    if (position + 1 != m_Objects.size()) {
+        MiObject* moved = m_Objects.back();
+        m_Objects[position] = moved;
+        m_ObjectPositions[moved] = position;
+    }
+    m_Objects.pop_back();
+
+    for (MiTypeIndexBase* index : indicesOf(object)) {
+        index->remove(object);
+    }
+}
+
+void MiTypeIndexSet::clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Indices.clear();
+    m_Membership.clear();
+    m_Objects.clear();
+    m_ObjectPositions.clear();
+}
+
+const std::vector<MiTypeIndexBase*>& MiTypeIndexSet::indicesOf(MiObject* object) {
+    uint32_t type = object->getTypeId();
+    auto it = m_Membership.find(type);
+    if (it != m_Membership.end()) {
+        return it->second;
+    }
+
+    std::vector<MiTypeIndexBase*> indices;
+    for (auto& [queriedType, index] : m_Indices) {
+        if (index->matches(object)) {
+            indices.push_back(index.get());
+        }
+    }
+    return m_Membership.emplace(type, std::move(indices)).first->second;
+}
+
+} // namespace MiEngine
@@ -1,5 +1,9 @@
 #include "core/MiTypeRegistry.h"
 #include "core/MiObject.h"
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <set>
 
 namespace MiEngine {
 
@@ -59,9 +63,14 @@ std::vector<std::string> MiTypeRegistry::getRegisteredTypeNames() const {
 
 std::vector<std::string> MiTypeRegistry::getTypesDerivingFrom(uint32_t parentTypeId) const {
     std::vector<std::string> result;
-    for (const auto& pair : m_TypesByName) {
-        if (isDerivedFrom(pair.second.typeId, parentTypeId)) {
-            result.push_back(pair.first);
+    uint32_t parentIndex = getTypeIndex(parentTypeId);
+    if (parentIndex == InvalidTypeIndex) {
+        return result;
+    }
+
+    for (const TypeInfo* info : m_TypesByIndex) {
+        if (isDerivedFromIndex(info->typeIndex, parentIndex)) {
+            result.push_back(info->typeName);
         }
     }
     return result;
@@ -71,25 +80,78 @@ bool MiTypeRegistry::isDerivedFrom(uint32_t typeId, uint32_t parentTypeId) const
     if (typeId == parentTypeId) {
         return true;
     }
+    return isDerivedFromIndex(getTypeIndex(typeId), getTypeIndex(parentTypeId));
+}
 
+uint32_t MiTypeRegistry::getTypeIndex(uint32_t typeId) const {
     auto it = m_TypesById.find(typeId);
-    if (it == m_TypesById.end() || !it->second) {
-        return false;
+    if (it != m_TypesById.end() && it->second) {
+        return it->second->typeIndex;
     }
+    return InvalidTypeIndex;
+}
 
-    uint32_t currentParent = it->second->parentTypeId;
-    while (currentParent != 0) {
-        if (currentParent == parentTypeId) {
-            return true;
-        }
-        auto parentIt = m_TypesById.find(currentParent);
-        if (parentIt == m_TypesById.end() || !parentIt->second) {
-            break;
+void MiTypeRegistry::reportMissingParent(const char* objectType, const char* castType) {
+    static std::mutex s_Mutex;
+    static std::set<std::pair<std::string, std::string>> s_Reported;
+
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    if (s_Reported.emplace(objectType, castType).second) {
+        std::cerr << "MiTypeRegistry: " << objectType << " derives from " << castType
+                  << " but no registered parent links them (use MI_REGISTER_TYPE_WITH_PARENT)" << std::endl;
+    }
+}
+
+void MiTypeRegistry::addType(TypeInfo info) {
+    // Type ids are picked by hand. A reused one is rejected: casts, type indices and
+    // lookups by id all assume an id names one class, so the first registration keeps it
+    auto clash = m_TypesById.find(info.typeId);
+    if (clash != m_TypesById.end() && clash->second && clash->second->typeName != info.typeName) {
+        std::cerr << "MiTypeRegistry: " << info.typeName << " reuses type id " << info.typeId << " of "
+                  << clash->second->typeName << ", not registered" << std::endl;
+        assert(false && "MiTypeRegistry: duplicate type id");
+        return;
+    }
+
+    // Re-registering a name keeps its index (cached by typeIndexOf)
+    auto existing = m_TypesByName.find(info.typeName);
+    if (existing != m_TypesByName.end()) {
+        info.typeIndex = existing->second.typeIndex;
+        if (existing->second.typeId != info.typeId) {
+            m_TypesById.erase(existing->second.typeId);
         }
-        currentParent = parentIt->second->parentTypeId;
+        existing->second = std::move(info);
+        m_TypesById[existing->second.typeId] = &existing->second;
+    } else {
+        info.typeIndex = static_cast<uint32_t>(m_TypesByIndex.size());
+        TypeInfo& stored = m_TypesByName.emplace(info.typeName, std::move(info)).first->second;
+        m_TypesById[stored.typeId] = &stored;
+        m_TypesByIndex.push_back(&stored);
     }
 
-    return false;
+    // Parents may register after their children (static init order), so redo every type
+    rebuildAncestors();
+}
+
+void MiTypeRegistry::rebuildAncestors() {
+    size_t typeCount = m_TypesByIndex.size();
+    m_AncestorWords = (typeCount + 63) / 64;
+    m_Ancestors.assign(typeCount * m_AncestorWords, 0);
+
+    for (const TypeInfo* info : m_TypesByIndex) {
+        uint64_t* ancestors = &m_Ancestors[info->typeIndex * m_AncestorWords];
+
+        // Walk up the parent links (bounded, in case of a cycle)
+        const TypeInfo* current = info;
+        for (size_t depth = 0; current && depth < typeCount; ++depth) {
+            ancestors[current->typeIndex / 64] |= 1ull << (current->typeIndex % 64);
+            if (current->parentTypeId == 0) {
+                break;
+            }
+            auto parent = m_TypesById.find(current->parentTypeId);
+            current = parent != m_TypesById.end() ? parent->second : nullptr;
+        }
+    }
 }
 
 } // namespace MiEngine
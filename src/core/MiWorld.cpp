@@ -1,14 +1,10 @@
 #include "core/MiWorld.h"
 #include "core/MiActor.h"
+#include "core/MiComponent.h"
 #include "core/MiTypeRegistry.h"
+#include "core/MiTransformSystem.h"
 #include "core/JsonIO.h"
-#include "actor/MiStaticMeshActor.h"
-#include "component/MiStaticMeshComponent.h"
-#include "mesh/Mesh.h"
-#include "scene/Scene.h"
-#include "VulkanRenderer.h"
 #include <algorithm>
-#include <sstream>
 #include <iostream>
 
 namespace MiEngine {
@@ -78,6 +74,8 @@ void MiWorld::shutdown() {
     // Destroy all actors
     destroyAllActors();
     processDestroyQueue();
+    m_RecycleBin.clear();
+    m_EventBus.clear();
 
     // Clean up physics
     // m_PhysicsWorld.reset();
@@ -98,7 +96,7 @@ std::shared_ptr<MiActor> MiWorld::spawnActorByTypeName(const std::string& typeNa
         return nullptr;
     }
 
-    auto actor = std::dynamic_pointer_cast<MiActor>(obj);
+    auto actor = Cast<MiActor>(obj);
     if (!actor) {
         return nullptr;
     }
@@ -110,6 +108,7 @@ std::shared_ptr<MiActor> MiWorld::spawnActorByTypeName(const std::string& typeNa
     actor->createDefaultComponents();
 
     if (m_IsUpdating) {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
         m_SpawnQueue.push_back(actor);
     } else {
         registerActor(actor);
@@ -120,7 +119,10 @@ std::shared_ptr<MiActor> MiWorld::spawnActorByTypeName(const std::string& typeNa
     }
 
     actor->onCreated();
-    markDirty();
+
+    if (!m_IsUpdating) {
+        markDirty();
+    }
 
     return actor;
 }
@@ -130,11 +132,15 @@ void MiWorld::destroyActor(std::shared_ptr<MiActor> actor) {
         return;
     }
 
-    // Mark for destruction
-    actor->addFlags(ActorFlags::Destroying);
-    actor->markPendingDestroy();
+    // Other workers may be reading the actor's flags during a parallel tick;
+    // processDestroyQueue sets them instead
+    if (!m_TickScheduler.isTickingParallel()) {
+        actor->addFlags(ActorFlags::Destroying);
+        actor->markPendingDestroy();
+    }
 
     // Add to destroy queue
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
     m_DestroyQueue.push_back(actor);
 }
 
@@ -146,6 +152,7 @@ void MiWorld::destroyActor(const ObjectId& id) {
 }
 
 void MiWorld::destroyAllActors() {
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
     for (auto& actor : m_Actors) {
         actor->addFlags(ActorFlags::Destroying);
         actor->markPendingDestroy();
@@ -161,6 +168,18 @@ void MiWorld::registerActor(std::shared_ptr<MiActor> actor) {
     actor->setWorld(this);
     m_Actors.push_back(actor);
     m_ActorMap[actor->getObjectId()] = actor;
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        ++m_ActorNameCounts[actor->getName()];
+    }
+    m_TickScheduler.markDirty();
+
+    m_EventBus.post(ActorSpawnedEvent{actor->getObjectId(), actor->getTypeId()});
+
+    m_ActorIndex.add(actor.get());
+    for (const auto& component : actor->getAllComponents()) {
+        m_ComponentIndex.add(component.get());
+    }
 
     // Notify actor - good time for components to load resources
     actor->onRegister();
@@ -182,44 +201,108 @@ void MiWorld::unregisterActor(std::shared_ptr<MiActor> actor) {
     // Call onDestroyed
     actor->onDestroyed();
 
-    // Remove from map
+    m_EventBus.post(ActorDestroyedEvent{actor->getObjectId(), actor->getTypeId()});
+
+    // Remove from map and type indices
     m_ActorMap.erase(actor->getObjectId());
+    m_ActorIndex.remove(actor.get());
+    for (const auto& component : actor->getAllComponents()) {
+        m_ComponentIndex.remove(component.get());
+    }
 
-    // Remove from vector
-    auto it = std::find(m_Actors.begin(), m_Actors.end(), actor);
-    if (it != m_Actors.end()) {
-        m_Actors.erase(it);
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        auto it = m_ActorNameCounts.find(actor->getName());
+        if (it != m_ActorNameCounts.end() && --it->second == 0) {
+            m_ActorNameCounts.erase(it);
+        }
     }
 
+    // processDestroyQueue removes the batch from m_Actors in one pass
     actor->setWorld(nullptr);
+    m_TickScheduler.markDirty();
+}
+
+void MiWorld::indexComponent(MiComponent* component) {
+    m_ComponentIndex.add(component);
+}
+
+void MiWorld::unindexComponent(MiComponent* component) {
+    m_ComponentIndex.remove(component);
+}
+
+void MiWorld::renameActor(const std::string& oldName, const std::string& newName) {
+    // A thread-safe tick may rename its own actor from a worker
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    auto it = m_ActorNameCounts.find(oldName);
+    if (it != m_ActorNameCounts.end() && --it->second == 0) {
+        m_ActorNameCounts.erase(it);
+    }
+    ++m_ActorNameCounts[newName];
 }
 
 void MiWorld::processDestroyQueue() {
-    for (auto& actor : m_DestroyQueue) {
+    std::vector<std::shared_ptr<MiActor>> destroyQueue;
+    std::vector<std::shared_ptr<MiActor>> spawnQueue;
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        destroyQueue.swap(m_DestroyQueue);
+        spawnQueue.swap(m_SpawnQueue);
+    }
+
+    std::vector<std::shared_ptr<MiActor>> unregistered;
+    for (auto& actor : destroyQueue) {
+        // Flags of actors destroyed during a parallel tick are set here
+        actor->addFlags(ActorFlags::Destroying);
+        actor->markPendingDestroy();
+
+        // Queued twice, or spawned and destroyed in the same tick
+        if (actor->getWorld() != this) {
+            continue;
+        }
         unregisterActor(actor);
+        unregistered.push_back(std::move(actor));
+    }
+    destroyQueue.clear();
+
+    // One ordered pass instead of a search and shift per destroyed actor
+    if (!unregistered.empty()) {
+        m_Actors.erase(std::remove_if(m_Actors.begin(), m_Actors.end(),
+                                      [this](const std::shared_ptr<MiActor>& actor) { return actor->getWorld() != this; }),
+                       m_Actors.end());
+    }
+
+    // Keep them for the next spawn of their type if they opted in
+    for (auto& actor : unregistered) {
+        m_RecycleBin.recycle(actor);
     }
-    m_DestroyQueue.clear();
 
     // Process spawn queue
-    for (auto& actor : m_SpawnQueue) {
+    for (auto& actor : spawnQueue) {
+        if (actor->isPendingDestroy()) {
+            continue;
+        }
         registerActor(actor);
         if (m_IsPlaying) {
             actor->beginPlay();
         }
     }
-    m_SpawnQueue.clear();
+    if (!spawnQueue.empty()) {
+        markDirty();
+    }
 }
 
-std::string MiWorld::generateUniqueActorName(const std::string& baseName) const {
-    std::string name = baseName;
-    int counter = 1;
-
-    while (findActorByName(name) != nullptr) {
-        std::ostringstream ss;
-        ss << baseName << "_" << counter++;
-        name = ss.str();
+std::string MiWorld::generateUniqueActorName(const std::string& baseName) {
+    // Suffixes count up per base name, so a spawn normally checks one candidate
+    // instead of every suffix taken so far, and each check is a lookup in the
+    // name index rather than a scan of m_Actors. May run on a worker during parallel ticks.
+    std::lock_guard<std::mutex> lock(m_QueueMutex);
+    uint32_t& counter = m_NameCounters[baseName];
+    std::string name = counter == 0 ? baseName : baseName + "_" + std::to_string(counter);
+    while (m_ActorNameCounts.count(name) != 0) {
+        name = baseName + "_" + std::to_string(++counter);
     }
-
+    ++counter;
     return name;
 }
 
@@ -244,8 +327,11 @@ std::shared_ptr<MiActor> MiWorld::findActorByName(const std::string& name) const
     return nullptr;
 }
 
-std::vector<std::shared_ptr<MiActor>> MiWorld::findActorsByTag(const std::string& tag) const {
+std::vector<std::shared_ptr<MiActor>> MiWorld::findActorsByTag(MiName tag) const {
     std::vector<std::shared_ptr<MiActor>> result;
+    if (tag.isNone()) {
+        return result;
+    }
     for (const auto& actor : m_Actors) {
         if (actor->hasTag(tag)) {
             result.push_back(actor);
@@ -325,227 +411,40 @@ void MiWorld::tick(float deltaTime) {
 
     m_IsUpdating = true;
 
+    if (m_TickScheduler.isDirty()) {
+        m_TickScheduler.rebuild(m_Actors);
+    }
+
+    m_TickScheduler.tickGroup(TickGroup::PrePhysics, deltaTime);
+
     // Update physics (future)
     // if (m_Settings.enablePhysics && m_PhysicsWorld) {
     //     m_PhysicsWorld->update(deltaTime);
     // }
 
-    // Tick all actors
-    for (auto& actor : m_Actors) {
-        if (!actor->isPendingDestroy() && actor->hasBegunPlay()) {
-            actor->tick(deltaTime);
-        }
-    }
+    m_TickScheduler.tickGroup(TickGroup::DuringPhysics, deltaTime);
+    m_TickScheduler.tickGroup(TickGroup::PostPhysics, deltaTime);
+
+    // Collision and gameplay events from the physics groups; listeners may
+    // still move things before transforms are propagated
+    m_EventBus.dispatch();
+
+    // PostUpdate reads final world transforms
+    MiTransformSystem& transforms = MiTransformSystem::getInstance();
+    transforms.propagate();
+    m_TickScheduler.tickGroup(TickGroup::PostUpdate, deltaTime);
 
     m_IsUpdating = false;
 
     // Process deferred spawn/destroy
     processDestroyQueue();
-}
-
-// ============================================================================
-// Rendering
-// ============================================================================
 
-void MiWorld::draw(VkCommandBuffer commandBuffer, const glm::mat4& view, const glm::mat4& proj, uint32_t frameIndex) {
-    if (!m_Renderer || !m_Initialized) {
-        return;
-    }
-
-    // Check which pipeline to use
-    bool usePBR = m_Renderer->getRenderMode() == RenderMode::PBR ||
-                  m_Renderer->getRenderMode() == RenderMode::PBR_IBL;
-
-    // Find all static mesh actors
-    auto staticMeshActors = findActorsOfType<MiStaticMeshActor>();
-
-    for (auto& actor : staticMeshActors) {
-        if (actor->isPendingDestroy()) {
-            continue;
-        }
-
-        auto meshComponent = actor->getMeshComponent();
-        if (!meshComponent || !meshComponent->shouldRender()) {
-            continue;
-        }
-
-        auto mesh = meshComponent->getMesh();
-        if (!mesh) {
-            continue;
-        }
-
-        // Get material from component (not mesh - component has per-instance material)
-        Material& material = meshComponent->getMaterial();
-
-        // Create descriptor set for material if not exists
-        if (material.getDescriptorSet() == VK_NULL_HANDLE) {
-            VkDescriptorSet ds = m_Renderer->createMaterialDescriptorSet(material);
-            if (ds != VK_NULL_HANDLE) {
-                material.setDescriptorSet(ds);
-            } else {
-                std::cerr << "MiWorld: Failed to create material descriptor set for actor: "
-                          << actor->getName() << std::endl;
-                continue;
-            }
-        }
-
-        // Get the model matrix from actor transform
-        glm::mat4 model = actor->getTransform().getMatrix();
-
-        if (usePBR) {
-            // Push the model matrix as a push constant
-            PushConstant pushConstant = m_Renderer->createPushConstant(model, material);
-            vkCmdPushConstants(
-                commandBuffer,
-                m_Renderer->getPBRPipelineLayout(),
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                0,
-                sizeof(PushConstant),
-                &pushConstant
-            );
-
-            // Bind material descriptor set (set 1)
-            VkDescriptorSet materialDescriptorSet = material.getDescriptorSet();
-            if (materialDescriptorSet != VK_NULL_HANDLE) {
-                vkCmdBindDescriptorSets(
-                    commandBuffer,
-                    VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    m_Renderer->getPBRPipelineLayout(),
-                    1,  // Set index 1
-                    1,
-                    &materialDescriptorSet,
-                    0, nullptr
-                );
-            }
-
-            // Draw the mesh
-            mesh->bind(commandBuffer);
-            mesh->draw(commandBuffer);
-            m_Renderer->addDrawCall(0, mesh->indexCount);
-        } else {
-            // Standard pipeline
-            PushConstant pushConstant = m_Renderer->createPushConstant(model, material);
-            vkCmdPushConstants(
-                commandBuffer,
-                m_Renderer->getPipelineLayout(),
-                VK_SHADER_STAGE_VERTEX_BIT,
-                0,
-                sizeof(PushConstant),
-                &pushConstant
-            );
-
-            // Bind material descriptor set
-            VkDescriptorSet materialDescriptorSet = material.getDescriptorSet();
-            if (materialDescriptorSet != VK_NULL_HANDLE) {
-                vkCmdBindDescriptorSets(
-                    commandBuffer,
-                    VK_PIPELINE_BIND_POINT_GRAPHICS,
-                    m_Renderer->getPipelineLayout(),
-                    1,  // Set index 1
-                    1,
-                    &materialDescriptorSet,
-                    0, nullptr
-                );
-            }
-
-            // Draw the mesh
-            mesh->bind(commandBuffer);
-            mesh->draw(commandBuffer);
-            m_Renderer->addDrawCall(0, mesh->indexCount);
-        }
-    }
-}
-
-// ============================================================================
-// Lighting
-// ============================================================================
-
-void MiWorld::addLight(const glm::vec3& positionOrDirection, const glm::vec3& color,
-                       float intensity, float radius, float falloff, bool isDirectional) {
-    MiLight light;
-    light.position = positionOrDirection;
-    light.color = color;
-    light.intensity = intensity;
-    light.radius = radius;
-    light.falloff = falloff;
-    light.isDirectional = isDirectional;
-
-    m_Lights.push_back(light);
-
-    // Sync with renderer's legacy scene for now (lights are still managed there)
-    if (m_Renderer && m_Renderer->getScene()) {
-        m_Renderer->getScene()->addLight(positionOrDirection, color, intensity, radius, falloff, isDirectional);
-    }
-    //TODO: implement light system for Mi world
-
-    markDirty();
-}
-
-void MiWorld::addLight(const MiLight& light) {
-    addLight(light.position, light.color, light.intensity, light.radius, light.falloff, light.isDirectional);
-}
-
-void MiWorld::removeLight(size_t index) {
-    if (index < m_Lights.size()) {
-        m_Lights.erase(m_Lights.begin() + index);
-
-        // Sync with renderer's legacy scene
-        if (m_Renderer && m_Renderer->getScene()) {
-            m_Renderer->getScene()->removeLight(index);
-        }
-
-        markDirty();
-    }
-}
-
-void MiWorld::clearLights() {
-    m_Lights.clear();
-
-    // Sync with renderer's legacy scene
-    if (m_Renderer && m_Renderer->getScene()) {
-        m_Renderer->getScene()->clearLights();
-    }
-
-    markDirty();
-}
-
-void MiWorld::setupDefaultLighting() {
-    clearLights();
-
-    // Add a directional light (sun)
-    addLight(
-        glm::vec3(-0.5f, -1.0f, -0.3f),  // Direction
-        glm::vec3(1.0f, 0.95f, 0.9f),     // Warm sunlight
-        2.0f,                              // Intensity
-        0.0f,                              // Radius (0 for directional)
-        1.0f,                              // Falloff
-        true                               // isDirectional
-    );
-
-    // Add a soft fill light
-    addLight(
-        glm::vec3(0.3f, -0.5f, 0.5f),     // Direction (opposite side)
-        glm::vec3(0.6f, 0.7f, 0.9f),      // Cool blue-ish fill
-        0.5f,                              // Lower intensity
-        0.0f,
-        1.0f,
-        true
-    );
-}
-
-// ============================================================================
-// Environment
-// ============================================================================
-
-void MiWorld::setupEnvironment(const std::string& hdrPath) {
-    m_Settings.environmentHDR = hdrPath;
-
-    // Setup environment in renderer's legacy scene (IBL system is there)
-    if (m_Renderer && m_Renderer->getScene()) {
-        m_Renderer->getScene()->setupEnvironment(hdrPath);
-    }
+    // Events posted by PostUpdate and spawn/destroy
+    m_EventBus.dispatch();
+    m_EventBus.endFrame();
 
-    markDirty();
+    // Cache world matrices for rendering
+    transforms.propagate();
 }
 
 // ============================================================================
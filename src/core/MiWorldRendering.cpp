@@ -0,0 +1,216 @@
+// MiWorld rendering, lighting and environment
+// Kept apart from MiWorld.cpp so actor management links without the renderer
+
+#include "core/MiWorld.h"
+#include "actor/MiStaticMeshActor.h"
+#include "component/MiStaticMeshComponent.h"
+#include "mesh/Mesh.h"
+#include "scene/Scene.h"
+#include "VulkanRenderer.h"
+#include <iostream>
+
+namespace MiEngine {
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void MiWorld::draw(VkCommandBuffer commandBuffer, const glm::mat4& view, const glm::mat4& proj, uint32_t frameIndex) {
+    if (!m_Renderer || !m_Initialized) {
+        return;
+    }
+
+    // Check which pipeline to use
+    bool usePBR = m_Renderer->getRenderMode() == RenderMode::PBR ||
+                  m_Renderer->getRenderMode() == RenderMode::PBR_IBL;
+
+    for (MiStaticMeshActor* actor : getActorsOfType<MiStaticMeshActor>()) {
+        if (actor->isPendingDestroy()) {
+            continue;
+        }
+
+        auto meshComponent = actor->getMeshComponent();
+        if (!meshComponent || !meshComponent->shouldRender()) {
+            continue;
+        }
+
+        auto mesh = meshComponent->getMesh();
+        if (!mesh) {
+            continue;
+        }
+
+        // Get material from component (not mesh - component has per-instance material)
+        Material& material = meshComponent->getMaterial();
+
+        // Create descriptor set for material if not exists
+        if (material.getDescriptorSet() == VK_NULL_HANDLE) {
+            VkDescriptorSet ds = m_Renderer->createMaterialDescriptorSet(material);
+            if (ds != VK_NULL_HANDLE) {
+                material.setDescriptorSet(ds);
+            } else {
+                std::cerr << "MiWorld: Failed to create material descriptor set for actor: "
+                          << actor->getName() << std::endl;
+                continue;
+            }
+        }
+
+        // Cached world matrix of the mesh component
+        glm::mat4 model = meshComponent->getWorldMatrix();
+
+        if (usePBR) {
+            // Push the model matrix as a push constant
+            PushConstant pushConstant = m_Renderer->createPushConstant(model, material);
+            vkCmdPushConstants(
+                commandBuffer,
+                m_Renderer->getPBRPipelineLayout(),
+                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                0,
+                sizeof(PushConstant),
+                &pushConstant
+            );
+
+            // Bind material descriptor set (set 1)
+            VkDescriptorSet materialDescriptorSet = material.getDescriptorSet();
+            if (materialDescriptorSet != VK_NULL_HANDLE) {
+                vkCmdBindDescriptorSets(
+                    commandBuffer,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_Renderer->getPBRPipelineLayout(),
+                    1,  // Set index 1
+                    1,
+                    &materialDescriptorSet,
+                    0, nullptr
+                );
+            }
+
+            // Draw the mesh
+            mesh->bind(commandBuffer);
+            mesh->draw(commandBuffer);
+            m_Renderer->addDrawCall(0, mesh->indexCount);
+        } else {
+            // Standard pipeline
+            PushConstant pushConstant = m_Renderer->createPushConstant(model, material);
+            vkCmdPushConstants(
+                commandBuffer,
+                m_Renderer->getPipelineLayout(),
+                VK_SHADER_STAGE_VERTEX_BIT,
+                0,
+                sizeof(PushConstant),
+                &pushConstant
+            );
+
+            // Bind material descriptor set
+            VkDescriptorSet materialDescriptorSet = material.getDescriptorSet();
+            if (materialDescriptorSet != VK_NULL_HANDLE) {
+                vkCmdBindDescriptorSets(
+                    commandBuffer,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    m_Renderer->getPipelineLayout(),
+                    1,  // Set index 1
+                    1,
+                    &materialDescriptorSet,
+                    0, nullptr
+                );
+            }
+
+            // Draw the mesh
+            mesh->bind(commandBuffer);
+            mesh->draw(commandBuffer);
+            m_Renderer->addDrawCall(0, mesh->indexCount);
+        }
+    }
+}
+
+// ============================================================================
+// Lighting
+// ============================================================================
+
+void MiWorld::addLight(const glm::vec3& positionOrDirection, const glm::vec3& color,
+                       float intensity, float radius, float falloff, bool isDirectional) {
+    MiLight light;
+    light.position = positionOrDirection;
+    light.color = color;
+    light.intensity = intensity;
+    light.radius = radius;
+    light.falloff = falloff;
+    light.isDirectional = isDirectional;
+
+    m_Lights.push_back(light);
+
+    // Sync with renderer's legacy scene for now (lights are still managed there)
+    if (m_Renderer && m_Renderer->getScene()) {
+        m_Renderer->getScene()->addLight(positionOrDirection, color, intensity, radius, falloff, isDirectional);
+    }
+    //TODO: implement light system for Mi world
+
+    markDirty();
+}
+
+void MiWorld::addLight(const MiLight& light) {
+    addLight(light.position, light.color, light.intensity, light.radius, light.falloff, light.isDirectional);
+}
+
+void MiWorld::removeLight(size_t index) {
+    if (index < m_Lights.size()) {
+        m_Lights.erase(m_Lights.begin() + index);
+
+        // Sync with renderer's legacy scene
+        if (m_Renderer && m_Renderer->getScene()) {
+            m_Renderer->getScene()->removeLight(index);
+        }
+
+        markDirty();
+    }
+}
+
+void MiWorld::clearLights() {
+    m_Lights.clear();
+
+    // Sync with renderer's legacy scene
+    if (m_Renderer && m_Renderer->getScene()) {
+        m_Renderer->getScene()->clearLights();
+    }
+
+    markDirty();
+}
+
+void MiWorld::setupDefaultLighting() {
+    clearLights();
+
+    // Add a directional light (sun)
+    addLight(
+        glm::vec3(-0.5f, -1.0f, -0.3f),  // Direction
+        glm::vec3(1.0f, 0.95f, 0.9f),     // Warm sunlight
+        2.0f,                              // Intensity
+        0.0f,                              // Radius (0 for directional)
+        1.0f,                              // Falloff
+        true                               // isDirectional
+    );
+
+    // Add a soft fill light
+    addLight(
+        glm::vec3(0.3f, -0.5f, 0.5f),     // Direction (opposite side)
+        glm::vec3(0.6f, 0.7f, 0.9f),      // Cool blue-ish fill
+        0.5f,                              // Lower intensity
+        0.0f,
+        1.0f,
+        true
+    );
+}
+
+// ============================================================================
+// Environment
+// ============================================================================
+
+void MiWorld::setupEnvironment(const std::string& hdrPath) {
+    m_Settings.environmentHDR = hdrPath;
+
+    // Setup environment in renderer's legacy scene (IBL system is there)
+    if (m_Renderer && m_Renderer->getScene()) {
+        m_Renderer->getScene()->setupEnvironment(hdrPath);
+    }
+
+    markDirty();
+}
+
+} // namespace MiEngine
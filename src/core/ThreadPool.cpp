@@ -0,0 +1,31 @@
+#include "core/ThreadPool.h"
+
+namespace MiEngine {
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance(JobSystem::getInstance());
+    return instance;
+}
+
+ThreadPool::ThreadPool(JobSystem& jobs)
+    : m_Jobs(jobs) {
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    // Without workers nothing would take a Background job before the caller blocks on its future
+    if (m_Jobs.getWorkerCount() == 0) {
+        task();
+        return;
+    }
+
+    JobDesc desc;
+    desc.name = "ThreadPool::submit";
+    desc.affinity = JobAffinity::Background;
+    m_Jobs.schedule(std::move(task), desc);
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& func, size_t grainSize) {
+    m_Jobs.parallelFor(count, func, grainSize, "ThreadPool::parallelFor");
+}
+
+} // namespace MiEngine
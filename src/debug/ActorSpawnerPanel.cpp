@@ -243,15 +243,12 @@ void ActorSpawnerPanel::refreshActorTypes() {
 void ActorSpawnerPanel::refreshMeshList() {
     m_MeshPaths.clear();
 
-    auto& registry = AssetRegistry::getInstance();
-    const auto& assets = registry.getAssets();
-
-    for (const auto& entry : assets) {
+    AssetRegistry::getInstance().forEachAsset([this](const AssetEntry& entry) {
         // Only include mesh assets (static and skeletal)
         if (entry.type == AssetType::StaticMesh || entry.type == AssetType::SkeletalMesh) {
             m_MeshPaths.push_back(entry.projectPath);
         }
-    }
+    });
 
     // Sort alphabetically
     std::sort(m_MeshPaths.begin(), m_MeshPaths.end());
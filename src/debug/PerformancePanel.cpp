@@ -1,5 +1,6 @@
 ﻿#include "debug/PerformancePanel.h"
 #include "VulkanRenderer.h"
+#include "core/MiObjectPool.h"
 
 #include <imgui.h>
 
@@ -37,6 +38,10 @@ void PerformancePanel::draw() {
         drawStatistics();
         ImGui::Separator();
         drawRenderStats();
+        ImGui::Separator();
+        drawPoolStats();
+        ImGui::Separator();
+        drawEventStats();
     }
     ImGui::End();
 }
@@ -82,3 +87,40 @@ void PerformancePanel::drawRenderStats() {
 
     ImGui::Unindent();
 }
+
+void PerformancePanel::drawPoolStats() {
+    ImGui::Text("Object Pools:");
+    ImGui::Indent();
+
+    for (const auto& pool : MiEngine::MiSlabPool::getAllStats()) {
+        size_t capacity = pool.slabCount * pool.blocksPerSlab;
+        ImGui::Text("%s (%zu B): %zu / %zu live, peak %zu, %zu slabs",
+                    pool.name.c_str(), pool.blockSize, pool.liveCount, capacity,
+                    pool.peakCount, pool.slabCount);
+    }
+
+    if (MiEngine::MiWorld* world = renderer->getWorld()) {
+        const MiEngine::MiRecycleBin& recycleBin = world->getRecycleBin();
+        ImGui::Text("Recycled actors: %zu waiting, %llu reused", recycleBin.getCount(),
+                    static_cast<unsigned long long>(recycleBin.getReuseCount()));
+    }
+
+    ImGui::Unindent();
+}
+
+void PerformancePanel::drawEventStats() {
+    MiEngine::MiWorld* world = renderer->getWorld();
+    if (!world) {
+        return;
+    }
+
+    ImGui::Text("Events:");
+    ImGui::Indent();
+
+    const MiEngine::MiEventBus::Stats& stats = world->getEventBus().getLastFrameStats();
+    ImGui::Text("Events/Frame: %llu (%u batches)", static_cast<unsigned long long>(stats.eventCount),
+                stats.batchCount);
+    ImGui::Text("Dispatch Time: %.3f ms", stats.dispatchMs);
+
+    ImGui::Unindent();
+}
@@ -96,7 +96,7 @@ void SceneHierarchyPanel::drawActorList() {
 
         // Add type indicator
         std::string typeIndicator;
-        if (std::dynamic_pointer_cast<MiEngine::MiStaticMeshActor>(actor)) {
+        if (MiEngine::Cast<MiEngine::MiStaticMeshActor>(actor)) {
             typeIndicator = " [Mesh]";
         } else {
             typeIndicator = " [Empty]";
@@ -170,7 +170,7 @@ void SceneHierarchyPanel::drawActorProperties() {
     }
 
     // Material info for MiStaticMeshActor
-    auto meshActor = std::dynamic_pointer_cast<MiEngine::MiStaticMeshActor>(actor);
+    auto meshActor = MiEngine::Cast<MiEngine::MiStaticMeshActor>(actor);
     if (meshActor) {
         ImGui::Separator();
         ImGui::Text("Material:");
@@ -0,0 +1,1404 @@
+#include "loader/GltfLoader.h"
+#include "loader/ModelLoader.h"
+#include "animation/Skeleton.h"
+#include "animation/AnimationClip.h"
+#include "core/MappedFile.h"
+#include "core/ThreadPool.h"
+#include <iostream>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <unordered_set>
+#include <atomic>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
+
+namespace MiEngine {
+
+namespace {
+
+// ============================================================================
+// Minimal JSON DOM (glTF documents are small; geometry lives in the buffers)
+// ============================================================================
+
+struct JsonValue {
+    enum class Type : uint8_t { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    static const JsonValue& null() {
+        static const JsonValue value;
+        return value;
+    }
+
+    const JsonValue& operator[](std::string_view key) const {
+        if (type == Type::Object) {
+            for (const auto& member : object) {
+                if (member.first == key) {
+                    return member.second;
+                }
+            }
+        }
+        return null();
+    }
+
+    const JsonValue& operator[](size_t index) const {
+        return (type == Type::Array && index < array.size()) ? array[index] : null();
+    }
+
+    bool isNull() const { return type == Type::Null; }
+    size_t size() const { return type == Type::Array ? array.size() : 0; }
+    int64_t asInt(int64_t fallback = -1) const { return type == Type::Number ? static_cast<int64_t>(number) : fallback; }
+    double asNumber(double fallback = 0.0) const { return type == Type::Number ? number : fallback; }
+    bool asBool(bool fallback = false) const { return type == Type::Bool ? boolean : fallback; }
+    const std::string& asString() const { return string; }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : m_Text(text) {}
+
+    bool parse(JsonValue& out) {
+        skipWhitespace();
+        if (!parseValue(out, 0)) {
+            return false;
+        }
+        skipWhitespace();
+        return m_Pos == m_Text.size();
+    }
+
+    size_t getOffset() const { return m_Pos; }
+
+private:
+    static constexpr int MAX_DEPTH = 128;
+
+    void skipWhitespace() {
+        // GLB pads the JSON chunk with spaces, some exporters with NULs
+        while (m_Pos < m_Text.size()) {
+            char c = m_Text[m_Pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r' && c != '\0') {
+                break;
+            }
+            ++m_Pos;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (m_Pos < m_Text.size() && m_Text[m_Pos] == c) {
+            ++m_Pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > MAX_DEPTH || m_Pos >= m_Text.size()) {
+            return false;
+        }
+
+        char c = m_Text[m_Pos];
+        if (c == '{') {
+            ++m_Pos;
+            out.type = JsonValue::Type::Object;
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                skipWhitespace();
+                std::string key;
+                if (!parseString(key) || !consume(':')) {
+                    return false;
+                }
+                skipWhitespace();
+                out.object.emplace_back(std::move(key), JsonValue());
+                if (!parseValue(out.object.back().second, depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            ++m_Pos;
+            out.type = JsonValue::Type::Array;
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                skipWhitespace();
+                out.array.emplace_back();
+                if (!parseValue(out.array.back(), depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            out.type = JsonValue::Type::String;
+            return parseString(out.string);
+        }
+        if (c == 't' || c == 'f') {
+            out.type = JsonValue::Type::Bool;
+            out.boolean = (c == 't');
+            return parseLiteral(out.boolean ? "true" : "false");
+        }
+        if (c == 'n') {
+            out.type = JsonValue::Type::Null;
+            return parseLiteral("null");
+        }
+
+        out.type = JsonValue::Type::Number;
+        const char* begin = m_Text.data() + m_Pos;
+        const char* end = m_Text.data() + m_Text.size();
+        if (*begin == '+') {
+            return false;
+        }
+        auto result = std::from_chars(begin, end, out.number);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        m_Pos += static_cast<size_t>(result.ptr - begin);
+        return true;
+    }
+
+    bool parseLiteral(std::string_view literal) {
+        if (m_Text.substr(m_Pos, literal.size()) != literal) {
+            return false;
+        }
+        m_Pos += literal.size();
+        return true;
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool parseHex4(uint32_t& out) {
+        if (m_Pos + 4 > m_Text.size()) {
+            return false;
+        }
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            int v = hexValue(m_Text[m_Pos++]);
+            if (v < 0) {
+                return false;
+            }
+            out = (out << 4) | static_cast<uint32_t>(v);
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        if (m_Pos >= m_Text.size() || m_Text[m_Pos] != '"') {
+            return false;
+        }
+        ++m_Pos;
+
+        while (m_Pos < m_Text.size()) {
+            // Copy runs without escapes in one go
+            size_t runEnd = m_Pos;
+            while (runEnd < m_Text.size() && m_Text[runEnd] != '"' && m_Text[runEnd] != '\\') {
+                ++runEnd;
+            }
+            out.append(m_Text.data() + m_Pos, runEnd - m_Pos);
+            m_Pos = runEnd;
+            if (m_Pos >= m_Text.size()) {
+                return false;
+            }
+
+            char c = m_Text[m_Pos++];
+            if (c == '"') {
+                return true;
+            }
+            if (m_Pos >= m_Text.size()) {
+                return false;
+            }
+
+            char escape = m_Text[m_Pos++];
+            switch (escape) {
+                case '"':  out += '"';  break;
+                case '\\': out += '\\'; break;
+                case '/':  out += '/';  break;
+                case 'b':  out += '\b'; break;
+                case 'f':  out += '\f'; break;
+                case 'n':  out += '\n'; break;
+                case 'r':  out += '\r'; break;
+                case 't':  out += '\t'; break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!parseHex4(cp)) {
+                        return false;
+                    }
+                    // Surrogate pair
+                    if (cp >= 0xD800 && cp <= 0xDBFF && m_Text.substr(m_Pos, 2) == "\\u") {
+                        m_Pos += 2;
+                        uint32_t low;
+                        if (!parseHex4(low)) {
+                            return false;
+                        }
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    std::string_view m_Text;
+    size_t m_Pos = 0;
+};
+
+// ============================================================================
+// Document / buffers
+// ============================================================================
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+
+// Accessor component types
+constexpr uint32_t GL_BYTE = 5120;
+constexpr uint32_t GL_UNSIGNED_BYTE = 5121;
+constexpr uint32_t GL_SHORT = 5122;
+constexpr uint32_t GL_UNSIGNED_SHORT = 5123;
+constexpr uint32_t GL_UNSIGNED_INT = 5125;
+constexpr uint32_t GL_FLOAT = 5126;
+
+struct BufferSpan {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+std::string decodeUri(const std::string& uri) {
+    std::string result;
+    result.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size()) {
+            auto hex = [](char c) -> int {
+                if (c >= '0' && c <= '9') return c - '0';
+                if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+                if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+                return -1;
+            };
+            int hi = hex(uri[i + 1]);
+            int lo = hex(uri[i + 2]);
+            if (hi >= 0 && lo >= 0) {
+                result += static_cast<char>((hi << 4) | lo);
+                i += 2;
+                continue;
+            }
+        }
+        result += uri[i];
+    }
+    return result;
+}
+
+bool decodeBase64(std::string_view text, std::vector<uint8_t>& out) {
+    static const auto table = []() {
+        std::array<int8_t, 256> t{};
+        t.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i) {
+            t[static_cast<uint8_t>(alphabet[i])] = static_cast<int8_t>(i);
+        }
+        return t;
+    }();
+
+    out.clear();
+    out.reserve(text.size() / 4 * 3);
+
+    uint32_t accum = 0;
+    int bits = 0;
+    for (char c : text) {
+        if (c == '=') {
+            break;
+        }
+        int8_t v = table[static_cast<uint8_t>(c)];
+        if (v < 0) {
+            return false;
+        }
+        accum = (accum << 6) | static_cast<uint32_t>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>((accum >> bits) & 0xFF));
+        }
+    }
+    return true;
+}
+
+struct GltfDocument {
+    fs::path path;
+    MappedFile file;
+    JsonValue json;
+    BufferSpan binChunk;
+
+    std::vector<BufferSpan> buffers;
+    std::vector<std::unique_ptr<MappedFile>> externalFiles;
+    std::vector<std::vector<uint8_t>> decodedBuffers;   // data: URIs
+
+    bool open(const fs::path& filePath, bool loadBuffers);
+
+private:
+    bool loadBuffer(size_t index, BufferSpan& out);
+};
+
+bool GltfDocument::open(const fs::path& filePath, bool loadBuffers) {
+    path = filePath;
+    if (!file.open(filePath)) {
+        std::cerr << "GltfLoader: Failed to open " << filePath << std::endl;
+        return false;
+    }
+
+    std::string_view jsonText;
+    const uint32_t* magic = file.at<uint32_t>(0);
+
+    if (magic && *magic == GLB_MAGIC) {
+        const uint32_t* header = file.at<uint32_t>(0, 3);   // magic, version, length
+        if (!header || header[1] != 2 || header[2] > file.size()) {
+            std::cerr << "GltfLoader: Unsupported or truncated GLB: " << filePath << std::endl;
+            return false;
+        }
+
+        size_t offset = 12;
+        size_t end = header[2];
+        while (offset + 8 <= end) {
+            const uint32_t* chunk = file.at<uint32_t>(offset, 2);   // length, type
+            size_t dataOffset = offset + 8;
+            if (!chunk || chunk[0] > end - dataOffset) {
+                std::cerr << "GltfLoader: Corrupt GLB chunk in " << filePath << std::endl;
+                return false;
+            }
+
+            if (chunk[1] == GLB_CHUNK_JSON && jsonText.empty()) {
+                jsonText = std::string_view(reinterpret_cast<const char*>(file.data() + dataOffset), chunk[0]);
+            } else if (chunk[1] == GLB_CHUNK_BIN && !binChunk.data) {
+                binChunk.data = file.data() + dataOffset;
+                binChunk.size = chunk[0];
+            }
+            // Chunks are 4-byte aligned
+            offset = dataOffset + ((static_cast<size_t>(chunk[0]) + 3) & ~size_t(3));
+        }
+    } else if (file.data()) {
+        jsonText = std::string_view(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+
+    if (jsonText.empty()) {
+        std::cerr << "GltfLoader: No JSON content in " << filePath << std::endl;
+        return false;
+    }
+
+    // Skip UTF-8 BOM
+    if (jsonText.size() >= 3 && static_cast<uint8_t>(jsonText[0]) == 0xEF &&
+        static_cast<uint8_t>(jsonText[1]) == 0xBB && static_cast<uint8_t>(jsonText[2]) == 0xBF) {
+        jsonText.remove_prefix(3);
+    }
+
+    JsonParser parser(jsonText);
+    if (!parser.parse(json) || json.type != JsonValue::Type::Object) {
+        std::cerr << "GltfLoader: JSON parse error near offset " << parser.getOffset()
+                  << " in " << filePath << std::endl;
+        return false;
+    }
+
+    const std::string& version = json["asset"]["version"].asString();
+    if (!version.empty() && version[0] != '2') {
+        std::cerr << "GltfLoader: Unsupported glTF version " << version << " in " << filePath << std::endl;
+        return false;
+    }
+
+    // Material/texture extensions don't affect geometry; compressed geometry can't be read
+    for (const auto& extension : json["extensionsRequired"].array) {
+        const std::string& name = extension.asString();
+        if (name == "KHR_draco_mesh_compression" || name == "EXT_meshopt_compression") {
+            std::cerr << "GltfLoader: Required extension not supported: " << name
+                      << " (" << filePath.filename() << ")" << std::endl;
+            return false;
+        }
+    }
+
+    if (!loadBuffers) {
+        return true;
+    }
+
+    const JsonValue& bufferList = json["buffers"];
+    buffers.resize(bufferList.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        if (!loadBuffer(i, buffers[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GltfDocument::loadBuffer(size_t index, BufferSpan& out) {
+    const JsonValue& buffer = json["buffers"][index];
+    size_t byteLength = static_cast<size_t>(buffer["byteLength"].asInt(0));
+    const JsonValue& uriValue = buffer["uri"];
+
+    if (uriValue.isNull()) {
+        // GLB-stored buffer
+        if (index != 0 || !binChunk.data) {
+            std::cerr << "GltfLoader: Buffer " << index << " has no uri and no BIN chunk" << std::endl;
+            return false;
+        }
+        out = binChunk;
+    } else if (uriValue.asString().compare(0, 5, "data:") == 0) {
+        const std::string& uri = uriValue.asString();
+        size_t comma = uri.find(',');
+        if (comma == std::string::npos || uri.find(";base64") > comma) {
+            std::cerr << "GltfLoader: Unsupported data URI in buffer " << index << std::endl;
+            return false;
+        }
+        decodedBuffers.emplace_back();
+        if (!decodeBase64(std::string_view(uri).substr(comma + 1), decodedBuffers.back())) {
+            std::cerr << "GltfLoader: Invalid base64 in buffer " << index << std::endl;
+            return false;
+        }
+        out.data = decodedBuffers.back().data();
+        out.size = decodedBuffers.back().size();
+    } else {
+        fs::path bufferPath = path.parent_path() / fs::u8path(decodeUri(uriValue.asString()));
+        auto mapped = std::make_unique<MappedFile>();
+        if (!mapped->open(bufferPath)) {
+            std::cerr << "GltfLoader: Failed to open buffer " << bufferPath << std::endl;
+            return false;
+        }
+        out.data = mapped->data();
+        out.size = mapped->size();
+        externalFiles.push_back(std::move(mapped));
+    }
+
+    if (out.size < byteLength) {
+        std::cerr << "GltfLoader: Buffer " << index << " is shorter than its byteLength" << std::endl;
+        return false;
+    }
+    out.size = byteLength;
+    return true;
+}
+
+// ============================================================================
+// Accessors
+// ============================================================================
+
+// Strided view of an accessor inside a mapped buffer
+struct AccessorView {
+    const uint8_t* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    uint32_t componentType = 0;
+    uint32_t componentCount = 0;
+    bool normalized = false;
+};
+
+uint32_t componentSize(uint32_t componentType) {
+    switch (componentType) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:  return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT: return 2;
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT:          return 4;
+        default:                return 0;
+    }
+}
+
+uint32_t typeComponentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+bool getAccessor(const GltfDocument& doc, int64_t index, AccessorView& out) {
+    if (index < 0) {
+        return false;
+    }
+
+    const JsonValue& accessor = doc.json["accessors"][static_cast<size_t>(index)];
+    if (accessor.isNull()) {
+        return false;
+    }
+    if (!accessor["sparse"].isNull()) {
+        std::cerr << "GltfLoader: Sparse accessors are not supported (accessor " << index << ")" << std::endl;
+        return false;
+    }
+
+    int64_t viewIndex = accessor["bufferView"].asInt();
+    if (viewIndex < 0) {
+        std::cerr << "GltfLoader: Accessor " << index << " has no bufferView" << std::endl;
+        return false;
+    }
+
+    const JsonValue& view = doc.json["bufferViews"][static_cast<size_t>(viewIndex)];
+    int64_t bufferIndex = view["buffer"].asInt();
+    if (bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= doc.buffers.size()) {
+        return false;
+    }
+    const BufferSpan& buffer = doc.buffers[static_cast<size_t>(bufferIndex)];
+
+    out.componentType = static_cast<uint32_t>(accessor["componentType"].asInt(0));
+    out.componentCount = typeComponentCount(accessor["type"].asString());
+    out.normalized = accessor["normalized"].asBool();
+    out.count = static_cast<size_t>(accessor["count"].asInt(0));
+
+    size_t elementSize = static_cast<size_t>(componentSize(out.componentType)) * out.componentCount;
+    if (elementSize == 0) {
+        std::cerr << "GltfLoader: Accessor " << index << " has an invalid type" << std::endl;
+        return false;
+    }
+
+    size_t viewOffset = static_cast<size_t>(view["byteOffset"].asInt(0));
+    size_t viewLength = static_cast<size_t>(view["byteLength"].asInt(0));
+    size_t accessorOffset = static_cast<size_t>(accessor["byteOffset"].asInt(0));
+    out.stride = static_cast<size_t>(view["byteStride"].asInt(0));
+    if (out.stride == 0) {
+        out.stride = elementSize;
+    }
+
+    if (viewOffset > buffer.size || viewLength > buffer.size - viewOffset) {
+        std::cerr << "GltfLoader: bufferView " << viewIndex << " is out of range" << std::endl;
+        return false;
+    }
+    if (out.count > 0 &&
+        (accessorOffset > viewLength || elementSize > viewLength - accessorOffset ||
+         out.count - 1 > (viewLength - accessorOffset - elementSize) / out.stride)) {
+        std::cerr << "GltfLoader: Accessor " << index << " is out of range" << std::endl;
+        return false;
+    }
+
+    out.data = buffer.data + viewOffset + accessorOffset;
+    return true;
+}
+
+// Read up to n components of element i as float, applying normalization
+inline void readFloats(const AccessorView& accessor, size_t i, float* out, uint32_t n) {
+    const uint8_t* ptr = accessor.data + i * accessor.stride;
+    n = std::min(n, accessor.componentCount);
+
+    switch (accessor.componentType) {
+        case GL_FLOAT:
+            std::memcpy(out, ptr, n * sizeof(float));
+            break;
+        case GL_UNSIGNED_BYTE:
+            for (uint32_t c = 0; c < n; ++c) {
+                out[c] = accessor.normalized ? ptr[c] / 255.0f : static_cast<float>(ptr[c]);
+            }
+            break;
+        case GL_BYTE:
+            for (uint32_t c = 0; c < n; ++c) {
+                float v = static_cast<float>(static_cast<int8_t>(ptr[c]));
+                out[c] = accessor.normalized ? std::max(v / 127.0f, -1.0f) : v;
+            }
+            break;
+        case GL_UNSIGNED_SHORT:
+            for (uint32_t c = 0; c < n; ++c) {
+                uint16_t v;
+                std::memcpy(&v, ptr + c * 2, 2);
+                out[c] = accessor.normalized ? v / 65535.0f : static_cast<float>(v);
+            }
+            break;
+        case GL_SHORT:
+            for (uint32_t c = 0; c < n; ++c) {
+                int16_t v;
+                std::memcpy(&v, ptr + c * 2, 2);
+                out[c] = accessor.normalized ? std::max(v / 32767.0f, -1.0f) : static_cast<float>(v);
+            }
+            break;
+        case GL_UNSIGNED_INT:
+            for (uint32_t c = 0; c < n; ++c) {
+                uint32_t v;
+                std::memcpy(&v, ptr + c * 4, 4);
+                out[c] = static_cast<float>(v);
+            }
+            break;
+    }
+}
+
+inline uint32_t readUint(const AccessorView& accessor, size_t i, uint32_t component = 0) {
+    const uint8_t* ptr = accessor.data + i * accessor.stride;
+    switch (accessor.componentType) {
+        case GL_UNSIGNED_BYTE:
+            return ptr[component];
+        case GL_UNSIGNED_SHORT: {
+            uint16_t v;
+            std::memcpy(&v, ptr + component * 2, 2);
+            return v;
+        }
+        case GL_UNSIGNED_INT: {
+            uint32_t v;
+            std::memcpy(&v, ptr + component * 4, 4);
+            return v;
+        }
+        default:
+            return 0;
+    }
+}
+
+// ============================================================================
+// Nodes
+// ============================================================================
+
+struct NodeInfo {
+    std::string name;
+    int32_t parent = -1;
+    int32_t mesh = -1;
+    int32_t skin = -1;
+
+    glm::vec3 translation = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+    glm::mat4 local = glm::mat4(1.0f);
+    glm::mat4 world = glm::mat4(1.0f);
+};
+
+glm::mat4 composeTRS(const glm::vec3& t, const glm::quat& r, const glm::vec3& s) {
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), t);
+    transform = transform * glm::toMat4(r);
+    return glm::scale(transform, s);
+}
+
+// Parse all nodes and compute world matrices. outOrder receives the nodes of the
+// default scene in depth-first order (parents before children).
+std::vector<NodeInfo> buildNodes(const GltfDocument& doc, std::vector<int32_t>& outOrder) {
+    const JsonValue& nodeList = doc.json["nodes"];
+    std::vector<NodeInfo> nodes(nodeList.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const JsonValue& node = nodeList[i];
+        NodeInfo& info = nodes[i];
+        info.name = node["name"].asString();
+        info.mesh = static_cast<int32_t>(node["mesh"].asInt());
+        info.skin = static_cast<int32_t>(node["skin"].asInt());
+
+        const JsonValue& matrix = node["matrix"];
+        if (matrix.size() == 16) {
+            float values[16];
+            for (size_t k = 0; k < 16; ++k) {
+                values[k] = static_cast<float>(matrix[k].asNumber());
+            }
+            info.local = glm::make_mat4(values);   // Column-major, same as glm
+            glm::vec3 skew;
+            glm::vec4 perspective;
+            glm::decompose(info.local, info.scale, info.rotation, info.translation, skew, perspective);
+        } else {
+            const JsonValue& t = node["translation"];
+            const JsonValue& r = node["rotation"];
+            const JsonValue& s = node["scale"];
+            if (t.size() == 3) {
+                info.translation = glm::vec3(t[0].asNumber(), t[1].asNumber(), t[2].asNumber());
+            }
+            if (r.size() == 4) {
+                // glTF stores x, y, z, w
+                info.rotation = glm::quat(static_cast<float>(r[3].asNumber()), static_cast<float>(r[0].asNumber()),
+                                          static_cast<float>(r[1].asNumber()), static_cast<float>(r[2].asNumber()));
+            }
+            if (s.size() == 3) {
+                info.scale = glm::vec3(s[0].asNumber(1.0), s[1].asNumber(1.0), s[2].asNumber(1.0));
+            }
+            info.local = composeTRS(info.translation, info.rotation, info.scale);
+        }
+
+        for (const auto& child : node["children"].array) {
+            int64_t childIndex = child.asInt();
+            if (childIndex >= 0 && static_cast<size_t>(childIndex) < nodes.size()) {
+                nodes[static_cast<size_t>(childIndex)].parent = static_cast<int32_t>(i);
+            }
+        }
+    }
+
+    // Scene roots: default scene if present, otherwise every parentless node
+    std::vector<int32_t> roots;
+    const JsonValue& scenes = doc.json["scenes"];
+    if (scenes.size() > 0) {
+        int64_t sceneIndex = std::max<int64_t>(doc.json["scene"].asInt(0), 0);
+        for (const auto& root : scenes[static_cast<size_t>(sceneIndex)]["nodes"].array) {
+            roots.push_back(static_cast<int32_t>(root.asInt()));
+        }
+    } else {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].parent < 0) {
+                roots.push_back(static_cast<int32_t>(i));
+            }
+        }
+    }
+
+    std::vector<bool> visited(nodes.size(), false);
+    std::vector<int32_t> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        stack.pop_back();
+        if (index < 0 || static_cast<size_t>(index) >= nodes.size() || visited[index]) {
+            continue;
+        }
+        visited[index] = true;
+
+        NodeInfo& info = nodes[index];
+        info.world = info.parent >= 0 ? nodes[info.parent].world * info.local : info.local;
+        outOrder.push_back(index);
+
+        const auto& children = nodeList[static_cast<size_t>(index)]["children"].array;
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.push_back(static_cast<int32_t>(it->asInt()));
+        }
+    }
+
+    return nodes;
+}
+
+// ============================================================================
+// Geometry
+// ============================================================================
+
+// Decode positions/normals/UVs/colors/tangents and indices of one triangle primitive
+// directly into the output arrays. Vertices are transformed by `transform`.
+template<typename TVertex>
+bool decodeGeometry(const GltfDocument& doc, const JsonValue& primitive, const glm::mat4& transform,
+                    std::vector<TVertex>& vertices, std::vector<unsigned int>& indices,
+                    bool& outHasTangents) {
+    int64_t mode = primitive["mode"].asInt(4);
+    if (mode != 4) {
+        std::cerr << "GltfLoader: Skipping non-triangle primitive (mode " << mode << ")" << std::endl;
+        return false;
+    }
+
+    const JsonValue& attributes = primitive["attributes"];
+    AccessorView positions;
+    if (!getAccessor(doc, attributes["POSITION"].asInt(), positions) || positions.componentCount != 3) {
+        std::cerr << "GltfLoader: Primitive has no usable POSITION attribute" << std::endl;
+        return false;
+    }
+
+    const size_t vertexCount = positions.count;
+    AccessorView normals, texCoords, colors, tangents;
+    bool hasNormals = getAccessor(doc, attributes["NORMAL"].asInt(), normals) && normals.count == vertexCount;
+    bool hasTexCoords = getAccessor(doc, attributes["TEXCOORD_0"].asInt(), texCoords) && texCoords.count == vertexCount;
+    bool hasColors = getAccessor(doc, attributes["COLOR_0"].asInt(), colors) && colors.count == vertexCount;
+    bool hasTangents = getAccessor(doc, attributes["TANGENT"].asInt(), tangents) &&
+                       tangents.count == vertexCount && tangents.componentCount == 4;
+
+    const bool identity = (transform == glm::mat4(1.0f));
+    const glm::mat3 linear(transform);
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+    const bool mirrored = glm::determinant(linear) < 0.0f;
+
+    vertices.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        TVertex& vertex = vertices[i];
+
+        float p[3];
+        readFloats(positions, i, p, 3);
+        vertex.position = identity ? glm::vec3(p[0], p[1], p[2])
+                                   : glm::vec3(transform * glm::vec4(p[0], p[1], p[2], 1.0f));
+
+        if (hasNormals) {
+            float n[3];
+            readFloats(normals, i, n, 3);
+            glm::vec3 normal = identity ? glm::vec3(n[0], n[1], n[2]) : normalMatrix * glm::vec3(n[0], n[1], n[2]);
+            float length = glm::length(normal);
+            vertex.normal = length > 1e-8f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+
+        // glTF UVs already have a top-left origin, matching Vulkan
+        if (hasTexCoords) {
+            float uv[2];
+            readFloats(texCoords, i, uv, 2);
+            vertex.texCoord = glm::vec2(uv[0], uv[1]);
+        } else {
+            vertex.texCoord = glm::vec2(0.5f, 0.5f);
+        }
+
+        if (hasColors) {
+            float c[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            readFloats(colors, i, c, 3);
+            vertex.color = glm::vec3(c[0], c[1], c[2]);
+        } else {
+            vertex.color = glm::vec3(1.0f, 1.0f, 1.0f);
+        }
+
+        if (hasTangents) {
+            float t[4];
+            readFloats(tangents, i, t, 4);
+            glm::vec3 tangent = identity ? glm::vec3(t[0], t[1], t[2]) : linear * glm::vec3(t[0], t[1], t[2]);
+            float length = glm::length(tangent);
+            vertex.tangent = glm::vec4(length > 1e-8f ? tangent / length : glm::vec3(1.0f, 0.0f, 0.0f),
+                                       mirrored ? -t[3] : t[3]);
+        } else {
+            vertex.tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+    // Indices
+    AccessorView indexAccessor;
+    if (getAccessor(doc, primitive["indices"].asInt(), indexAccessor)) {
+        if (indexAccessor.componentCount != 1) {
+            return false;
+        }
+        indices.resize(indexAccessor.count - indexAccessor.count % 3);
+        if (indexAccessor.componentType == GL_UNSIGNED_INT && indexAccessor.stride == 4) {
+            std::memcpy(indices.data(), indexAccessor.data, indices.size() * sizeof(unsigned int));
+        } else {
+            for (size_t i = 0; i < indices.size(); ++i) {
+                indices[i] = readUint(indexAccessor, i);
+            }
+        }
+        for (unsigned int index : indices) {
+            if (index >= vertexCount) {
+                std::cerr << "GltfLoader: Index out of range in primitive" << std::endl;
+                return false;
+            }
+        }
+    } else {
+        indices.resize(vertexCount - vertexCount % 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<unsigned int>(i);
+        }
+    }
+
+    // Missing normals: accumulate area-weighted face normals (glTF triangles are CCW)
+    if (!hasNormals) {
+        for (auto& vertex : vertices) {
+            vertex.normal = glm::vec3(0.0f);
+        }
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            TVertex& v0 = vertices[indices[i]];
+            TVertex& v1 = vertices[indices[i + 1]];
+            TVertex& v2 = vertices[indices[i + 2]];
+            glm::vec3 faceNormal = glm::cross(v1.position - v0.position, v2.position - v0.position);
+            if (mirrored) {
+                faceNormal = -faceNormal;
+            }
+            v0.normal += faceNormal;
+            v1.normal += faceNormal;
+            v2.normal += faceNormal;
+        }
+        for (auto& vertex : vertices) {
+            float length = glm::length(vertex.normal);
+            vertex.normal = length > 1e-8f ? vertex.normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    // Reverse winding to match the FBX import convention (a mirroring transform
+    // has already flipped it)
+    if (!mirrored) {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            std::swap(indices[i], indices[i + 2]);
+        }
+    }
+
+    outHasTangents = hasTangents;
+    return true;
+}
+
+struct PrimitiveJob {
+    int32_t node;
+    size_t primitive;
+};
+
+std::vector<PrimitiveJob> collectPrimitiveJobs(const GltfDocument& doc, const std::vector<NodeInfo>& nodes,
+                                               const std::vector<int32_t>& order) {
+    std::vector<PrimitiveJob> jobs;
+    const JsonValue& meshes = doc.json["meshes"];
+    for (int32_t nodeIndex : order) {
+        int32_t meshIndex = nodes[nodeIndex].mesh;
+        if (meshIndex < 0) {
+            continue;
+        }
+        size_t primitiveCount = meshes[static_cast<size_t>(meshIndex)]["primitives"].size();
+        for (size_t p = 0; p < primitiveCount; ++p) {
+            jobs.push_back({ nodeIndex, p });
+        }
+    }
+    return jobs;
+}
+
+const JsonValue& getPrimitive(const GltfDocument& doc, const NodeInfo& node, size_t primitive) {
+    return doc.json["meshes"][static_cast<size_t>(node.mesh)]["primitives"][primitive];
+}
+
+// ============================================================================
+// Skeleton / animation
+// ============================================================================
+
+struct SkeletonMapping {
+    std::vector<int32_t> boneOfNode;                 // node -> bone index (-1 if not a joint)
+    std::vector<std::vector<int32_t>> skinJoints;    // skin -> (joint slot -> bone index)
+    std::vector<glm::mat4> correction;               // bone -> transform from non-joint ancestors
+};
+
+void buildSkeleton(const GltfDocument& doc, const std::vector<NodeInfo>& nodes,
+                   SkeletalModelData& outData, SkeletonMapping& mapping) {
+    outData.skeleton = std::make_shared<Skeleton>();
+    outData.hasSkeleton = false;
+    mapping.boneOfNode.assign(nodes.size(), -1);
+
+    const JsonValue& skins = doc.json["skins"];
+    mapping.skinJoints.resize(skins.size());
+
+    // Gather joints from all skins; the first skin listing a joint provides its inverse bind matrix
+    std::vector<int32_t> jointNodes;
+    std::vector<glm::mat4> inverseBind(nodes.size(), glm::mat4(1.0f));
+    std::vector<bool> isJoint(nodes.size(), false);
+
+    for (size_t s = 0; s < skins.size(); ++s) {
+        const JsonValue& skin = skins[s];
+        const JsonValue& joints = skin["joints"];
+
+        AccessorView matrices;
+        bool hasMatrices = getAccessor(doc, skin["inverseBindMatrices"].asInt(), matrices) &&
+                           matrices.componentCount == 16 && matrices.count >= joints.size();
+
+        for (size_t j = 0; j < joints.size(); ++j) {
+            int64_t nodeIndex = joints[j].asInt();
+            if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= nodes.size() || isJoint[nodeIndex]) {
+                continue;
+            }
+            isJoint[nodeIndex] = true;
+            jointNodes.push_back(static_cast<int32_t>(nodeIndex));
+            if (hasMatrices) {
+                float m[16];
+                readFloats(matrices, j, m, 16);
+                inverseBind[nodeIndex] = glm::make_mat4(m);
+            }
+        }
+    }
+
+    // Skeleton::addBone needs parents first: order by hierarchy depth
+    auto depthOf = [&nodes](int32_t index) {
+        int depth = 0;
+        for (int32_t p = nodes[index].parent; p >= 0 && depth <= static_cast<int>(nodes.size()); p = nodes[p].parent) {
+            ++depth;
+        }
+        return depth;
+    };
+    std::vector<std::pair<int, int32_t>> ordered;
+    ordered.reserve(jointNodes.size());
+    for (int32_t nodeIndex : jointNodes) {
+        ordered.push_back({ depthOf(nodeIndex), nodeIndex });
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    if (ordered.size() > Skeleton::MAX_BONES) {
+        std::cerr << "GltfLoader: " << ordered.size() << " joints exceed the bone limit ("
+                  << Skeleton::MAX_BONES << "), extra joints are ignored" << std::endl;
+        ordered.resize(Skeleton::MAX_BONES);
+    }
+
+    std::unordered_set<std::string> usedNames;
+    for (const auto& entry : ordered) {
+        int32_t nodeIndex = entry.second;
+        const NodeInfo& node = nodes[nodeIndex];
+
+        // Nearest joint ancestor becomes the parent bone; any non-joint nodes in
+        // between (e.g. an "Armature" root) are folded into the local bind pose.
+        int32_t jointAncestor = node.parent;
+        while (jointAncestor >= 0 && mapping.boneOfNode[jointAncestor] < 0) {
+            jointAncestor = nodes[jointAncestor].parent;
+        }
+
+        glm::mat4 correction(1.0f);
+        if (node.parent >= 0 && node.parent != jointAncestor) {
+            correction = jointAncestor >= 0
+                ? glm::inverse(nodes[jointAncestor].world) * nodes[node.parent].world
+                : nodes[node.parent].world;
+        }
+
+        std::string name = node.name.empty() ? "joint_" + std::to_string(nodeIndex) : node.name;
+        if (!usedNames.insert(name).second) {
+            name += "_" + std::to_string(nodeIndex);
+            usedNames.insert(name);
+        }
+
+        int32_t parentBone = jointAncestor >= 0 ? mapping.boneOfNode[jointAncestor] : -1;
+        uint32_t boneIndex = outData.skeleton->addBone(MiName(name), parentBone, inverseBind[nodeIndex],
+                                                       correction * node.local);
+        mapping.boneOfNode[nodeIndex] = static_cast<int32_t>(boneIndex);
+        mapping.correction.push_back(correction);
+        outData.hasSkeleton = true;
+    }
+
+    for (size_t s = 0; s < skins.size(); ++s) {
+        const JsonValue& joints = skins[s]["joints"];
+        auto& slots = mapping.skinJoints[s];
+        slots.resize(joints.size(), 0);
+        for (size_t j = 0; j < joints.size(); ++j) {
+            int64_t nodeIndex = joints[j].asInt();
+            if (nodeIndex >= 0 && static_cast<size_t>(nodeIndex) < nodes.size()) {
+                slots[j] = std::max(mapping.boneOfNode[nodeIndex], 0);
+            }
+        }
+    }
+}
+
+// Read a sampler's key times and values into keys, converting each output element with convert()
+template<typename TKey, typename Convert>
+void readChannelKeys(const AccessorView& input, const AccessorView& output, const std::string& interpolation,
+                     uint32_t components, std::vector<TKey>& keys, Convert convert) {
+    const bool cubic = (interpolation == "CUBICSPLINE");
+    const bool step = (interpolation == "STEP");
+    const size_t valuesPerKey = cubic ? 3 : 1;
+    const size_t keyCount = std::min(input.count, output.count / valuesPerKey);
+
+    keys.clear();
+    keys.reserve(step ? keyCount * 2 : keyCount);
+
+    for (size_t k = 0; k < keyCount; ++k) {
+        float time;
+        readFloats(input, k, &time, 1);
+
+        // Cubic spline outputs are (in-tangent, value, out-tangent); keep the value
+        float value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        readFloats(output, k * valuesPerKey + (cubic ? 1 : 0), value, components);
+
+        // STEP holds each value until just before the next key
+        if (step && !keys.empty()) {
+            float holdTime = std::max(keys.back().time, time - 1e-4f);
+            keys.push_back({ holdTime, keys.back().value });
+        }
+        keys.push_back({ time, convert(value) });
+    }
+}
+
+void buildAnimations(const GltfDocument& doc, const std::vector<NodeInfo>& nodes,
+                     const SkeletonMapping& mapping, SkeletalModelData& outData) {
+    const JsonValue& animations = doc.json["animations"];
+    const uint32_t boneCount = outData.skeleton->getBoneCount();
+    if (boneCount == 0) {
+        return;
+    }
+
+    // Node of each bone, for rest-pose defaults
+    std::vector<int32_t> nodeOfBone(boneCount, -1);
+    for (size_t n = 0; n < mapping.boneOfNode.size(); ++n) {
+        if (mapping.boneOfNode[n] >= 0) {
+            nodeOfBone[mapping.boneOfNode[n]] = static_cast<int32_t>(n);
+        }
+    }
+
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const JsonValue& animation = animations[a];
+        const JsonValue& samplers = animation["samplers"];
+
+        std::vector<BoneAnimationTrack> tracks(boneCount);
+        float duration = 0.0f;
+
+        for (const auto& channel : animation["channels"].array) {
+            int64_t nodeIndex = channel["target"]["node"].asInt();
+            if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= nodes.size() ||
+                mapping.boneOfNode[nodeIndex] < 0) {
+                continue;
+            }
+
+            const JsonValue& sampler = samplers[static_cast<size_t>(channel["sampler"].asInt(0))];
+            AccessorView input, output;
+            if (!getAccessor(doc, sampler["input"].asInt(), input) ||
+                !getAccessor(doc, sampler["output"].asInt(), output)) {
+                continue;
+            }
+            const std::string& interpolation = sampler["interpolation"].asString();
+
+            BoneAnimationTrack& track = tracks[mapping.boneOfNode[nodeIndex]];
+            const std::string& path = channel["target"]["path"].asString();
+            if (path == "translation") {
+                readChannelKeys(input, output, interpolation, 3, track.positionKeys,
+                                [](const float* v) { return glm::vec3(v[0], v[1], v[2]); });
+            } else if (path == "rotation") {
+                readChannelKeys(input, output, interpolation, 4, track.rotationKeys,
+                                [](const float* v) { return glm::normalize(glm::quat(v[3], v[0], v[1], v[2])); });
+            } else if (path == "scale") {
+                readChannelKeys(input, output, interpolation, 3, track.scaleKeys,
+                                [](const float* v) { return glm::vec3(v[0], v[1], v[2]); });
+            } else {
+                continue;   // Morph target weights
+            }
+
+            if (input.count > 0) {
+                float lastTime;
+                readFloats(input, input.count - 1, &lastTime, 1);
+                duration = std::max(duration, lastTime);
+            }
+        }
+
+        std::string name = animation["name"].asString();
+        if (name.empty()) {
+            name = "Animation_" + std::to_string(a);
+        }
+        auto clip = std::make_shared<AnimationClip>(name, duration, 30.0f);
+
+        for (uint32_t b = 0; b < boneCount; ++b) {
+            BoneAnimationTrack& track = tracks[b];
+            const NodeInfo& node = nodes[nodeOfBone[b]];
+
+            // Channels that are not animated hold the node's rest value
+            if (track.positionKeys.empty()) track.positionKeys.push_back({ 0.0f, node.translation });
+            if (track.rotationKeys.empty()) track.rotationKeys.push_back({ 0.0f, node.rotation });
+            if (track.scaleKeys.empty()) track.scaleKeys.push_back({ 0.0f, node.scale });
+
+            // Fold non-joint ancestors into the keys (exact for uniform ancestor scale)
+            const glm::mat4& correction = mapping.correction[b];
+            if (correction != glm::mat4(1.0f)) {
+                glm::vec3 t, s, skew;
+                glm::quat r;
+                glm::vec4 perspective;
+                glm::decompose(correction, s, r, t, skew, perspective);
+                for (auto& key : track.positionKeys) key.value = glm::vec3(correction * glm::vec4(key.value, 1.0f));
+                for (auto& key : track.rotationKeys) key.value = r * key.value;
+                for (auto& key : track.scaleKeys) key.value = s * key.value;
+            }
+
+            BoneAnimationTrack& clipTrack = clip->addTrack(outData.skeleton->getBone(b).name);
+            clipTrack.positionKeys = std::move(track.positionKeys);
+            clipTrack.rotationKeys = std::move(track.rotationKeys);
+            clipTrack.scaleKeys = std::move(track.scaleKeys);
+        }
+
+        clip->setUsesGlobalTransforms(false);
+        clip->bindToSkeleton(*outData.skeleton);
+        outData.animations.push_back(clip);
+    }
+}
+
+void decodeSkinning(const GltfDocument& doc, const JsonValue& primitive, const std::vector<int32_t>& jointSlots,
+                    std::vector<SkeletalVertex>& vertices) {
+    const JsonValue& attributes = primitive["attributes"];
+
+    for (int set = 0; set < 2; ++set) {
+        std::string suffix = std::to_string(set);
+        AccessorView joints, weights;
+        if (!getAccessor(doc, attributes["JOINTS_" + suffix].asInt(), joints) ||
+            !getAccessor(doc, attributes["WEIGHTS_" + suffix].asInt(), weights) ||
+            joints.count != vertices.size() || weights.count != vertices.size()) {
+            continue;
+        }
+
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            float w[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            readFloats(weights, i, w, 4);
+            for (uint32_t c = 0; c < 4; ++c) {
+                uint32_t slot = readUint(joints, i, c);
+                if (w[c] > 0.0001f && slot < jointSlots.size()) {
+                    vertices[i].addBoneInfluence(jointSlots[slot], w[c]);
+                }
+            }
+        }
+    }
+
+    for (auto& vertex : vertices) {
+        vertex.normalizeWeights();
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// GltfLoader
+// ============================================================================
+
+bool GltfLoader::isGltfFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".gltf" || ext == ".glb";
+}
+
+bool GltfLoader::load(const fs::path& path, std::vector<MeshData>& outMeshes) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    GltfDocument doc;
+    if (!doc.open(path, true)) {
+        return false;
+    }
+
+    std::vector<int32_t> order;
+    std::vector<NodeInfo> nodes = buildNodes(doc, order);
+    std::vector<PrimitiveJob> jobs = collectPrimitiveJobs(doc, nodes, order);
+
+    std::vector<MeshData> decoded(jobs.size());
+    ThreadPool::getInstance().parallelFor(jobs.size(), [&](size_t i) {
+        const NodeInfo& node = nodes[jobs[i].node];
+        MeshData& mesh = decoded[i];
+        bool hasTangents = false;
+        if (!decodeGeometry(doc, getPrimitive(doc, node, jobs[i].primitive), node.world,
+                            mesh.vertices, mesh.indices, hasTangents)) {
+            mesh = MeshData();
+            return;
+        }
+        if (!hasTangents) {
+            ModelLoader::CalculateTangents(mesh);
+        }
+    });
+
+    size_t firstNew = outMeshes.size();
+    for (auto& mesh : decoded) {
+        if (!mesh.indices.empty()) {
+            outMeshes.push_back(std::move(mesh));
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    std::cout << "GltfLoader: Loaded " << (outMeshes.size() - firstNew) << " meshes from "
+              << path.filename() << " in " << duration.count() << "ms" << std::endl;
+
+    return outMeshes.size() > firstNew;
+}
+
+bool GltfLoader::loadSkeletal(const fs::path& path, SkeletalModelData& outData) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    GltfDocument doc;
+    if (!doc.open(path, true)) {
+        return false;
+    }
+
+    std::vector<int32_t> order;
+    std::vector<NodeInfo> nodes = buildNodes(doc, order);
+
+    SkeletonMapping mapping;
+    try {
+        buildSkeleton(doc, nodes, outData, mapping);
+    } catch (const std::exception& e) {
+        std::cerr << "GltfLoader: " << e.what() << std::endl;
+        return false;
+    }
+
+    std::vector<PrimitiveJob> jobs = collectPrimitiveJobs(doc, nodes, order);
+    std::vector<SkeletalMeshData> decoded(jobs.size());
+
+    ThreadPool::getInstance().parallelFor(jobs.size(), [&](size_t i) {
+        const NodeInfo& node = nodes[jobs[i].node];
+        const JsonValue& primitive = getPrimitive(doc, node, jobs[i].primitive);
+        SkeletalMeshData& mesh = decoded[i];
+
+        // Skinned meshes stay in bind space (glTF ignores the node transform).
+        // Rigid meshes under a joint are attached to it; others get their world transform.
+        const bool skinned = node.skin >= 0 && static_cast<size_t>(node.skin) < mapping.skinJoints.size();
+        int32_t attachNode = -1;
+        glm::mat4 transform = node.world;
+        if (!skinned) {
+            for (int32_t n = jobs[i].node; n >= 0; n = nodes[n].parent) {
+                if (mapping.boneOfNode[n] >= 0) {
+                    attachNode = n;
+                    break;
+                }
+            }
+            if (attachNode >= 0) {
+                const Bone& bone = outData.skeleton->getBone(mapping.boneOfNode[attachNode]);
+                transform = glm::inverse(bone.inverseBindPose) * glm::inverse(nodes[attachNode].world) * node.world;
+            }
+        } else {
+            transform = glm::mat4(1.0f);
+        }
+
+        bool hasTangents = false;
+        if (!decodeGeometry(doc, primitive, transform, mesh.vertices, mesh.indices, hasTangents)) {
+            mesh = SkeletalMeshData();
+            return;
+        }
+
+        if (skinned) {
+            decodeSkinning(doc, primitive, mapping.skinJoints[node.skin], mesh.vertices);
+        } else {
+            // Rigid meshes follow their joint; anything else falls back to bone 0 like the FBX path
+            for (auto& vertex : mesh.vertices) {
+                if (attachNode >= 0) {
+                    vertex.addBoneInfluence(mapping.boneOfNode[attachNode], 1.0f);
+                }
+                vertex.normalizeWeights();
+            }
+        }
+
+        if (!hasTangents) {
+            ModelLoader::CalculateTangents(mesh);
+        }
+
+        const JsonValue& gltfMesh = doc.json["meshes"][static_cast<size_t>(node.mesh)];
+        mesh.name = gltfMesh["name"].asString();
+        if (mesh.name.empty()) {
+            mesh.name = node.name.empty() ? "unnamed" : node.name;
+        }
+        if (gltfMesh["primitives"].size() > 1) {
+            mesh.name += "_" + std::to_string(jobs[i].primitive);
+        }
+    });
+
+    for (auto& mesh : decoded) {
+        if (!mesh.indices.empty()) {
+            outData.meshes.push_back(std::move(mesh));
+        }
+    }
+
+    buildAnimations(doc, nodes, mapping, outData);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    std::cout << "GltfLoader: Loaded " << outData.meshes.size() << " skeletal meshes, "
+              << outData.skeleton->getBoneCount() << " bones, " << outData.animations.size()
+              << " animations from " << path.filename() << " in " << duration.count() << "ms" << std::endl;
+
+    return !outData.meshes.empty();
+}
+
+bool GltfLoader::hasSkin(const fs::path& path) {
+    GltfDocument doc;
+    return doc.open(path, false) && doc.json["skins"].size() > 0;
+}
+
+std::vector<fs::path> GltfLoader::getExternalDependencies(const fs::path& path) {
+    std::vector<fs::path> result;
+    GltfDocument doc;
+    if (!doc.open(path, false)) {
+        return result;
+    }
+
+    for (const char* listName : { "buffers", "images" }) {
+        for (const auto& item : doc.json[listName].array) {
+            const std::string& uri = item["uri"].asString();
+            if (uri.empty() || uri.compare(0, 5, "data:") == 0) {
+                continue;
+            }
+            result.push_back(path.parent_path() / fs::u8path(decodeUri(uri)));
+        }
+    }
+    return result;
+}
+
+} // namespace MiEngine
@@ -1,30 +1,24 @@
 #include "loader/ModelLoader.h"
+#include "loader/GltfLoader.h"
+#include "loader/ObjLoader.h"
+#ifndef MIENGINE_NO_FBX
 #include <fbxsdk.h>
+#endif
 #include <iostream>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/ext/quaternion_geometric.hpp>
 
 ModelLoader::ModelLoader() {
-    // Initialize the FBX Manager
-    fbxManager = FbxManager::Create();
-    if (!fbxManager) {
-        throw std::runtime_error("Error: Unable to create FBX Manager!");
-    }
-
-    // Create an IOSettings object.
-    FbxIOSettings* ios = FbxIOSettings::Create(fbxManager, IOSROOT);
-    fbxManager->SetIOSettings(ios);
+}
 
-    // Create the FBX scene.
-    fbxScene = FbxScene::Create(fbxManager, "MyScene");
-    if (!fbxScene) {
-        throw std::runtime_error("Error: Unable to create FBX Scene!");
-    }
-  
+std::mutex& ModelLoader::GetFbxMutex() {
+    static std::mutex mutex;
+    return mutex;
 }
 
 ModelLoader::~ModelLoader() {
+#ifndef MIENGINE_NO_FBX
     // Clean up the FBX objects
     if (fbxScene) {
         fbxScene->Destroy();
@@ -32,9 +26,27 @@ ModelLoader::~ModelLoader() {
     if (fbxManager) {
         fbxManager->Destroy();
     }
+#endif
 }
 
 bool ModelLoader::LoadModel(const std::string& filename) {
+    if (MiEngine::GltfLoader::isGltfFile(filename)) {
+        meshes.clear();
+        return MiEngine::GltfLoader::load(filename, meshes);
+    }
+    if (MiEngine::ObjLoader::isObjFile(filename)) {
+        meshes.clear();
+        return MiEngine::ObjLoader::load(filename, meshes);
+    }
+
+#ifdef MIENGINE_NO_FBX
+    std::cerr << "ModelLoader: Built without FBX SDK, cannot load " << filename << std::endl;
+    return false;
+#else
+    if (!EnsureFbxManager()) {
+        return false;
+    }
+
     // Create an importer using the FBX SDK.
     FbxImporter* importer = FbxImporter::Create(fbxManager, "");
     if (!importer->Initialize(filename.c_str(), -1, fbxManager->GetIOSettings())) {
@@ -75,6 +87,33 @@ bool ModelLoader::LoadModel(const std::string& filename) {
     }
     std::cout << "Total meshes loaded: " << meshes.size() << std::endl;
     return true;
+#endif
+}
+
+#ifndef MIENGINE_NO_FBX
+bool ModelLoader::EnsureFbxManager() {
+    if (fbxManager) {
+        return true;
+    }
+
+    // Initialize the FBX Manager
+    fbxManager = FbxManager::Create();
+    if (!fbxManager) {
+        std::cerr << "Error: Unable to create FBX Manager!" << std::endl;
+        return false;
+    }
+
+    // Create an IOSettings object.
+    FbxIOSettings* ios = FbxIOSettings::Create(fbxManager, IOSROOT);
+    fbxManager->SetIOSettings(ios);
+
+    // Create the FBX scene.
+    fbxScene = FbxScene::Create(fbxManager, "MyScene");
+    if (!fbxScene) {
+        std::cerr << "Error: Unable to create FBX Scene!" << std::endl;
+        return false;
+    }
+    return true;
 }
 
 void ModelLoader::ProcessNode(FbxNode* node, int indentLevel) {
@@ -199,6 +238,7 @@ void ModelLoader::ProcessMesh(FbxMesh* mesh, const FbxAMatrix& transform) {
               << vertices.size() << " vertices and "
               << indices.size() << " indices" << std::endl;
 }
+#endif // MIENGINE_NO_FBX
 
 
 
@@ -243,8 +283,10 @@ void ModelLoader::CalculateTangents(MeshData& meshData) {
         glm::vec2 deltaUV1 = uv1 - uv0;
         glm::vec2 deltaUV2 = uv2 - uv0;
         
-        // Calculate tangent
-        float f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
+        // Calculate tangent (skip faces with degenerate UVs, e.g. meshes without UVs)
+        float denom = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+        if (std::abs(denom) < 0.0001f) continue;
+        float f = 1.0f / denom;
         
         glm::vec3 tangent;
         tangent.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
@@ -268,8 +310,12 @@ void ModelLoader::CalculateTangents(MeshData& meshData) {
         glm::vec3 n = vertex.normal;
         glm::vec3 t = glm::vec3(vertex.tangent);
         
-        // Gram-Schmidt orthogonalize
-        t = glm::normalize(t - n * glm::dot(n, t));
+        // Gram-Schmidt orthogonalize (arbitrary tangent if no face contributed)
+        t = t - n * glm::dot(n, t);
+        if (glm::length(t) < 0.0001f) {
+            t = std::abs(n.y) < 0.9f ? glm::cross(n, glm::vec3(0, 1, 0)) : glm::cross(n, glm::vec3(1, 0, 0));
+        }
+        t = glm::normalize(t);
         
         // Calculate handedness (store in w component)
         glm::vec3 b = glm::cross(n, t);
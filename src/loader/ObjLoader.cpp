@@ -0,0 +1,690 @@
+#include "loader/ObjLoader.h"
+#include "loader/ModelLoader.h"
+#include "core/MappedFile.h"
+#include "core/ThreadPool.h"
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace MiEngine {
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+// Chunk size bounds; actual size scales with file size and thread count
+constexpr size_t MIN_CHUNK_BYTES = 1u << 20;
+constexpr size_t MAX_CHUNK_BYTES = 32u << 20;
+
+// Groups with more corners than this are welded by several shards in parallel
+constexpr size_t SHARDED_WELD_THRESHOLD = 1u << 20;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// One face corner, global 0-based indices (INVALID_INDEX if absent)
+struct Corner {
+    uint32_t v;
+    uint32_t t;
+    uint32_t n;
+};
+
+struct GroupMarker {
+    size_t corner;          // Corner index within the chunk where the group starts
+    std::string name;
+};
+
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    // Counting pass
+    uint32_t positionCount = 0;
+    uint32_t texCoordCount = 0;
+    uint32_t normalCount = 0;
+
+    // Global bases (prefix sums of the counts)
+    uint32_t positionBase = 0;
+    uint32_t texCoordBase = 0;
+    uint32_t normalBase = 0;
+
+    // Parse pass
+    std::vector<float> positions;     // xyz
+    std::vector<float> colors;        // rgb, empty unless a vertex carried a color
+    std::vector<float> texCoords;     // uv
+    std::vector<float> normals;       // xyz
+    std::vector<Corner> corners;      // Triangulated, 3 per triangle
+    std::vector<GroupMarker> groups;
+    uint64_t skippedFaces = 0;
+};
+
+struct Segment {
+    const Chunk* chunk;
+    size_t begin;
+    size_t end;
+};
+
+struct Group {
+    std::string name;
+    std::vector<Segment> segments;
+    size_t cornerCount = 0;
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+// Line without the trailing '\n' / '\r\n'
+inline const char* lineEnd(const char* p, const char* end, const char*& next) {
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    next = newline ? newline + 1 : end;
+    const char* last = newline ? newline : end;
+    if (last > p && last[-1] == '\r') {
+        --last;
+    }
+    return last;
+}
+
+inline const char* parseFloat(const char* p, const char* end, float& out) {
+    p = skipBlanks(p, end);
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    auto result = std::from_chars(p, end, out);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// Resolve a 1-based (or negative, relative) OBJ index to a global 0-based index
+inline bool resolveIndex(int64_t value, uint32_t base, uint32_t localCount, uint32_t total, uint32_t& out) {
+    int64_t resolved = value > 0 ? value - 1 : static_cast<int64_t>(base) + localCount + value;
+    if (value == 0 || resolved < 0 || resolved >= total) {
+        return false;
+    }
+    out = static_cast<uint32_t>(resolved);
+    return true;
+}
+
+void countChunk(Chunk& chunk) {
+    const char* next;
+    for (const char* p = chunk.begin; p < chunk.end; p = next) {
+        const char* end = lineEnd(p, chunk.end, next);
+        p = skipBlanks(p, end);
+        if (end - p < 2 || p[0] != 'v') {
+            continue;
+        }
+        if (isBlank(p[1])) {
+            ++chunk.positionCount;
+        } else if (end - p >= 3 && isBlank(p[2])) {
+            if (p[1] == 't') ++chunk.texCoordCount;
+            else if (p[1] == 'n') ++chunk.normalCount;
+        }
+    }
+}
+
+void parseChunk(Chunk& chunk, uint32_t totalPositions, uint32_t totalTexCoords, uint32_t totalNormals) {
+    chunk.positions.reserve(static_cast<size_t>(chunk.positionCount) * 3);
+    chunk.texCoords.reserve(static_cast<size_t>(chunk.texCoordCount) * 2);
+    chunk.normals.reserve(static_cast<size_t>(chunk.normalCount) * 3);
+
+    uint32_t localPositions = 0;
+    uint32_t localTexCoords = 0;
+    uint32_t localNormals = 0;
+    std::vector<Corner> polygon;
+
+    const char* next;
+    for (const char* p = chunk.begin; p < chunk.end; p = next) {
+        const char* end = lineEnd(p, chunk.end, next);
+        p = skipBlanks(p, end);
+        if (end - p < 2) {
+            continue;
+        }
+
+        if (p[0] == 'v') {
+            float values[6] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+            if (isBlank(p[1])) {
+                // v x y z [r g b]
+                const char* q = p + 1;
+                int count = 0;
+                while (count < 6) {
+                    const char* parsed = parseFloat(q, end, values[count]);
+                    if (!parsed) break;
+                    q = parsed;
+                    ++count;
+                }
+                chunk.positions.insert(chunk.positions.end(), values, values + 3);
+                if (count == 6) {
+                    if (chunk.colors.empty()) {
+                        chunk.colors.assign(static_cast<size_t>(localPositions) * 3, 1.0f);
+                    }
+                    chunk.colors.insert(chunk.colors.end(), values + 3, values + 6);
+                } else if (!chunk.colors.empty()) {
+                    chunk.colors.insert(chunk.colors.end(), { 1.0f, 1.0f, 1.0f });
+                }
+                ++localPositions;
+            } else if (p[1] == 't' && end - p >= 3 && isBlank(p[2])) {
+                const char* q = parseFloat(p + 2, end, values[0]);
+                if (q) q = parseFloat(q, end, values[1]);
+                chunk.texCoords.insert(chunk.texCoords.end(), values, values + 2);
+                ++localTexCoords;
+            } else if (p[1] == 'n' && end - p >= 3 && isBlank(p[2])) {
+                const char* q = parseFloat(p + 2, end, values[0]);
+                if (q) q = parseFloat(q, end, values[1]);
+                if (q) q = parseFloat(q, end, values[2]);
+                chunk.normals.insert(chunk.normals.end(), values, values + 3);
+                ++localNormals;
+            }
+        } else if (p[0] == 'f' && isBlank(p[1])) {
+            // f v[/vt][/vn] ... (fan-triangulated)
+            polygon.clear();
+            bool valid = true;
+            const char* q = skipBlanks(p + 1, end);
+            while (q < end && valid) {
+                Corner corner{ INVALID_INDEX, INVALID_INDEX, INVALID_INDEX };
+                int64_t value;
+                auto result = std::from_chars(q, end, value);
+                valid = result.ec == std::errc() &&
+                        resolveIndex(value, chunk.positionBase, localPositions, totalPositions, corner.v);
+                q = result.ptr;
+
+                if (valid && q < end && *q == '/') {
+                    ++q;
+                    if (q < end && *q != '/') {
+                        result = std::from_chars(q, end, value);
+                        valid = result.ec == std::errc() &&
+                                resolveIndex(value, chunk.texCoordBase, localTexCoords, totalTexCoords, corner.t);
+                        q = result.ptr;
+                    }
+                    if (valid && q < end && *q == '/') {
+                        ++q;
+                        result = std::from_chars(q, end, value);
+                        valid = result.ec == std::errc() &&
+                                resolveIndex(value, chunk.normalBase, localNormals, totalNormals, corner.n);
+                        q = result.ptr;
+                    }
+                }
+
+                polygon.push_back(corner);
+                q = skipBlanks(q, end);
+            }
+
+            if (!valid || polygon.size() < 3) {
+                ++chunk.skippedFaces;
+                continue;
+            }
+            for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                chunk.corners.push_back(polygon[0]);
+                chunk.corners.push_back(polygon[i]);
+                chunk.corners.push_back(polygon[i + 1]);
+            }
+        } else if ((p[0] == 'o' || p[0] == 'g') && isBlank(p[1])) {
+            const char* nameBegin = skipBlanks(p + 1, end);
+            const char* nameEnd = end;
+            while (nameEnd > nameBegin && isBlank(nameEnd[-1])) {
+                --nameEnd;
+            }
+            chunk.groups.push_back({ chunk.corners.size(), std::string(nameBegin, nameEnd) });
+        }
+        // Everything else (comments, usemtl, mtllib, s, l, p) is ignored
+    }
+}
+
+// Split the buffer into newline-aligned chunks of roughly targetBytes
+std::vector<Chunk> splitChunks(const char* data, size_t size, size_t targetBytes) {
+    std::vector<Chunk> chunks;
+    const char* end = data + size;
+    const char* p = data;
+    while (p < end) {
+        const char* chunkEnd = end;
+        if (static_cast<size_t>(end - p) > targetBytes) {
+            const char* newline = static_cast<const char*>(
+                std::memchr(p + targetBytes, '\n', static_cast<size_t>(end - p - targetBytes)));
+            chunkEnd = newline ? newline + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = p;
+        chunk.end = chunkEnd;
+        chunks.push_back(std::move(chunk));
+        p = chunkEnd;
+    }
+    return chunks;
+}
+
+// Stitch per-chunk group markers into global groups made of chunk segments
+std::vector<Group> buildGroups(const std::vector<Chunk>& chunks, const std::string& defaultName) {
+    std::vector<Group> groups;
+    groups.push_back({ defaultName, {}, 0 });
+
+    for (const auto& chunk : chunks) {
+        size_t segmentBegin = 0;
+        auto closeSegment = [&](size_t segmentEnd) {
+            if (segmentEnd > segmentBegin) {
+                groups.back().segments.push_back({ &chunk, segmentBegin, segmentEnd });
+                groups.back().cornerCount += segmentEnd - segmentBegin;
+            }
+            segmentBegin = segmentEnd;
+        };
+
+        for (const auto& marker : chunk.groups) {
+            closeSegment(marker.corner);
+            if (groups.back().cornerCount == 0) {
+                groups.back().name = marker.name;   // Reuse an empty group
+            } else {
+                groups.push_back({ marker.name, {}, 0 });
+            }
+        }
+        closeSegment(chunk.corners.size());
+    }
+
+    groups.erase(std::remove_if(groups.begin(), groups.end(),
+                                [](const Group& g) { return g.cornerCount == 0; }),
+                 groups.end());
+    return groups;
+}
+
+// Open-addressing map from a corner (v, vt, vn) to a welded vertex id
+class CornerMap {
+public:
+    explicit CornerMap(size_t expected) {
+        size_t capacity = 64;
+        while (capacity < expected * 2) {
+            capacity <<= 1;
+        }
+        m_Slots.assign(capacity, Slot{ {}, INVALID_INDEX });
+    }
+
+    // Returns the id for the corner, inserting it with id = size() if new
+    uint32_t insert(const Corner& corner) {
+        if ((m_Count + 1) * 2 > m_Slots.size()) {
+            grow();
+        }
+        size_t mask = m_Slots.size() - 1;
+        for (size_t i = hash(corner) & mask; ; i = (i + 1) & mask) {
+            Slot& slot = m_Slots[i];
+            if (slot.id == INVALID_INDEX) {
+                slot.corner = corner;
+                slot.id = static_cast<uint32_t>(m_Count++);
+                m_Unique.push_back(corner);
+                return slot.id;
+            }
+            if (slot.corner.v == corner.v && slot.corner.t == corner.t && slot.corner.n == corner.n) {
+                return slot.id;
+            }
+        }
+    }
+
+    // Unique corners in id order
+    const std::vector<Corner>& unique() const { return m_Unique; }
+
+private:
+    struct Slot {
+        Corner corner;
+        uint32_t id;
+    };
+
+    static size_t hash(const Corner& c) {
+        uint64_t h = c.v * 0x9E3779B97F4A7C15ull;
+        h ^= (c.t + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= (c.n + 0x85EBCA77C2B2AE63ull) * 0x165667B19E3779F9ull;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    void grow() {
+        std::vector<Slot> old = std::move(m_Slots);
+        m_Slots.assign(old.size() * 2, Slot{ {}, INVALID_INDEX });
+        size_t mask = m_Slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.id == INVALID_INDEX) {
+                continue;
+            }
+            size_t i = hash(slot.corner) & mask;
+            while (m_Slots[i].id != INVALID_INDEX) {
+                i = (i + 1) & mask;
+            }
+            m_Slots[i] = slot;
+        }
+    }
+
+    std::vector<Slot> m_Slots;
+    std::vector<Corner> m_Unique;
+    size_t m_Count = 0;
+};
+
+struct Attributes {
+    std::vector<float> positions;
+    std::vector<float> colors;
+    std::vector<float> texCoords;
+    std::vector<float> normals;
+};
+
+Vertex makeVertex(const Corner& corner, const Attributes& attributes) {
+    Vertex vertex{};
+    const float* p = &attributes.positions[static_cast<size_t>(corner.v) * 3];
+    vertex.position = glm::vec3(p[0], p[1], p[2]);
+
+    if (!attributes.colors.empty()) {
+        const float* c = &attributes.colors[static_cast<size_t>(corner.v) * 3];
+        vertex.color = glm::vec3(c[0], c[1], c[2]);
+    } else {
+        vertex.color = glm::vec3(1.0f, 1.0f, 1.0f);
+    }
+
+    if (corner.n != INVALID_INDEX) {
+        const float* n = &attributes.normals[static_cast<size_t>(corner.n) * 3];
+        glm::vec3 normal(n[0], n[1], n[2]);
+        float length = glm::length(normal);
+        vertex.normal = length > 1e-8f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    } else {
+        vertex.normal = glm::vec3(0.0f, 0.0f, 0.0f);
+    }
+
+    // Flip V for Vulkan, same as the FBX path
+    if (corner.t != INVALID_INDEX) {
+        const float* t = &attributes.texCoords[static_cast<size_t>(corner.t) * 2];
+        vertex.texCoord = glm::vec2(t[0], 1.0f - t[1]);
+    } else {
+        vertex.texCoord = glm::vec2(0.5f, 0.5f);
+    }
+
+    vertex.tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    return vertex;
+}
+
+// Welded vertices owned by one shard. Corners sharing a position are chained
+// through a per-position head table when the group's position range is dense,
+// otherwise they go through a hash map.
+class ShardVertices {
+public:
+    ShardVertices(uint32_t* heads, uint32_t minPosition, size_t expected)
+        : m_Heads(heads), m_MinPosition(minPosition) {
+        if (!m_Heads) {
+            m_Map = std::make_unique<CornerMap>(expected);
+        } else {
+            m_Unique.reserve(expected);
+            m_Next.reserve(expected);
+        }
+    }
+
+    uint32_t insert(const Corner& corner) {
+        if (m_Map) {
+            return m_Map->insert(corner);
+        }
+        uint32_t& head = m_Heads[corner.v - m_MinPosition];
+        for (uint32_t id = head; id != INVALID_INDEX; id = m_Next[id]) {
+            if (m_Unique[id].t == corner.t && m_Unique[id].n == corner.n) {
+                return id;
+            }
+        }
+        uint32_t id = static_cast<uint32_t>(m_Unique.size());
+        m_Unique.push_back(corner);
+        m_Next.push_back(head);
+        head = id;
+        return id;
+    }
+
+    const std::vector<Corner>& unique() const { return m_Map ? m_Map->unique() : m_Unique; }
+
+private:
+    uint32_t* m_Heads;
+    uint32_t m_MinPosition;
+    std::unique_ptr<CornerMap> m_Map;
+    std::vector<Corner> m_Unique;
+    std::vector<uint32_t> m_Next;
+};
+
+// Weld one group into indexed MeshData. Large groups are split into shards by
+// blocks of position indices; each shard owns a disjoint set of vertices.
+void weldGroup(const Group& group, const Attributes& attributes, MeshData& mesh) {
+    auto& pool = ThreadPool::getInstance();
+    const uint32_t shardCount = group.cornerCount > SHARDED_WELD_THRESHOLD
+        ? std::min<uint32_t>(pool.getThreadCount() + 1, 16)
+        : 1;
+
+    uint32_t minPosition = INVALID_INDEX;
+    uint32_t maxPosition = 0;
+    for (const Segment& segment : group.segments) {
+        const Corner* corners = segment.chunk->corners.data();
+        for (size_t c = segment.begin; c < segment.end; ++c) {
+            minPosition = std::min(minPosition, corners[c].v);
+            maxPosition = std::max(maxPosition, corners[c].v);
+        }
+    }
+    auto shardOf = [&](uint32_t v) { return ((v - minPosition) >> 12) % shardCount; };
+
+    // Position-indexed chain heads, unless the group only touches a sparse range
+    size_t positionRange = static_cast<size_t>(maxPosition - minPosition) + 1;
+    std::vector<uint32_t> heads;
+    if (positionRange <= group.cornerCount * 4 + 4096) {
+        heads.assign(positionRange, INVALID_INDEX);
+    }
+
+    mesh.indices.resize(group.cornerCount);
+
+    // Pass 1: each shard assigns local ids to its corners (written into indices)
+    std::vector<std::unique_ptr<ShardVertices>> shards(shardCount);
+    pool.parallelFor(shardCount, [&](size_t shard) {
+        shards[shard] = std::make_unique<ShardVertices>(heads.empty() ? nullptr : heads.data(), minPosition,
+                                                        group.cornerCount / shardCount / 4);
+        ShardVertices& vertices = *shards[shard];
+        size_t out = 0;
+        for (const Segment& segment : group.segments) {
+            const Corner* corners = segment.chunk->corners.data();
+            for (size_t c = segment.begin; c < segment.end; ++c, ++out) {
+                if (shardOf(corners[c].v) == shard) {
+                    mesh.indices[out] = vertices.insert(corners[c]);
+                }
+            }
+        }
+    });
+
+    // Pass 2: shard vertex ranges, then build vertices and rebase indices
+    std::vector<uint32_t> shardBase(shardCount + 1, 0);
+    for (uint32_t s = 0; s < shardCount; ++s) {
+        shardBase[s + 1] = shardBase[s] + static_cast<uint32_t>(shards[s]->unique().size());
+    }
+
+    mesh.vertices.resize(shardBase[shardCount]);
+    pool.parallelFor(shardCount, [&](size_t shard) {
+        const auto& unique = shards[shard]->unique();
+        Vertex* out = mesh.vertices.data() + shardBase[shard];
+        for (size_t i = 0; i < unique.size(); ++i) {
+            out[i] = makeVertex(unique[i], attributes);
+        }
+    });
+
+    if (shardCount > 1) {
+        size_t out = 0;
+        for (const Segment& segment : group.segments) {
+            const Corner* corners = segment.chunk->corners.data();
+            size_t count = segment.end - segment.begin;
+            unsigned int* indices = mesh.indices.data() + out;
+            pool.parallelFor((count + 65535) / 65536, [&](size_t block) {
+                size_t begin = block * 65536;
+                size_t end = std::min(begin + 65536, count);
+                for (size_t c = begin; c < end; ++c) {
+                    indices[c] += shardBase[shardOf(corners[segment.begin + c].v)];
+                }
+            });
+            out += count;
+        }
+    }
+}
+
+// Smooth normals for vertices without one, reverse winding, tangents
+void finalizeMesh(MeshData& mesh) {
+    bool missingNormals = false;
+    for (const auto& vertex : mesh.vertices) {
+        if (vertex.normal == glm::vec3(0.0f)) {
+            missingNormals = true;
+            break;
+        }
+    }
+
+    // OBJ faces are counter-clockwise
+    if (missingNormals) {
+        std::vector<glm::vec3> accumulated(mesh.vertices.size(), glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const glm::vec3& p0 = mesh.vertices[mesh.indices[i]].position;
+            const glm::vec3& p1 = mesh.vertices[mesh.indices[i + 1]].position;
+            const glm::vec3& p2 = mesh.vertices[mesh.indices[i + 2]].position;
+            glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+            accumulated[mesh.indices[i]] += faceNormal;
+            accumulated[mesh.indices[i + 1]] += faceNormal;
+            accumulated[mesh.indices[i + 2]] += faceNormal;
+        }
+        for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+            if (mesh.vertices[v].normal == glm::vec3(0.0f)) {
+                float length = glm::length(accumulated[v]);
+                mesh.vertices[v].normal = length > 1e-12f ? accumulated[v] / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        }
+    }
+
+    // Reverse winding to match the FBX import convention
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        std::swap(mesh.indices[i], mesh.indices[i + 2]);
+    }
+
+    ModelLoader::CalculateTangents(mesh);
+}
+
+} // anonymous namespace
+
+bool ObjLoader::isObjFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".obj";
+}
+
+bool ObjLoader::load(const fs::path& path, std::vector<MeshData>& outMeshes, Stats* outStats) {
+    auto startTime = Clock::now();
+    Stats stats;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "ObjLoader: Failed to open " << path << std::endl;
+        return false;
+    }
+    if (file.size() == 0) {
+        std::cerr << "ObjLoader: Empty file " << path << std::endl;
+        return false;
+    }
+    stats.fileBytes = file.size();
+
+    auto& pool = ThreadPool::getInstance();
+
+    // --- Parse ---------------------------------------------------------------
+    const char* text = reinterpret_cast<const char*>(file.data());
+    size_t targetBytes = std::clamp<size_t>(file.size() / ((pool.getThreadCount() + 1) * 4),
+                                            MIN_CHUNK_BYTES, MAX_CHUNK_BYTES);
+    std::vector<Chunk> chunks = splitChunks(text, file.size(), targetBytes);
+    stats.chunkCount = static_cast<uint32_t>(chunks.size());
+
+    pool.parallelFor(chunks.size(), [&](size_t i) { countChunk(chunks[i]); });
+
+    uint64_t totalPositions = 0, totalTexCoords = 0, totalNormals = 0;
+    for (auto& chunk : chunks) {
+        chunk.positionBase = static_cast<uint32_t>(totalPositions);
+        chunk.texCoordBase = static_cast<uint32_t>(totalTexCoords);
+        chunk.normalBase = static_cast<uint32_t>(totalNormals);
+        totalPositions += chunk.positionCount;
+        totalTexCoords += chunk.texCoordCount;
+        totalNormals += chunk.normalCount;
+    }
+    if (totalPositions >= INVALID_INDEX || totalTexCoords >= INVALID_INDEX || totalNormals >= INVALID_INDEX) {
+        std::cerr << "ObjLoader: Too many vertices in " << path << std::endl;
+        return false;
+    }
+
+    pool.parallelFor(chunks.size(), [&](size_t i) {
+        parseChunk(chunks[i], static_cast<uint32_t>(totalPositions),
+                   static_cast<uint32_t>(totalTexCoords), static_cast<uint32_t>(totalNormals));
+    });
+
+    // Merge attribute streams (each chunk copies into its own range)
+    Attributes attributes;
+    bool hasColors = std::any_of(chunks.begin(), chunks.end(), [](const Chunk& c) { return !c.colors.empty(); });
+    attributes.positions.resize(totalPositions * 3);
+    attributes.texCoords.resize(totalTexCoords * 2);
+    attributes.normals.resize(totalNormals * 3);
+    if (hasColors) {
+        attributes.colors.resize(totalPositions * 3, 1.0f);
+    }
+
+    uint64_t skippedFaces = 0;
+    pool.parallelFor(chunks.size(), [&](size_t i) {
+        Chunk& chunk = chunks[i];
+        std::copy(chunk.positions.begin(), chunk.positions.end(),
+                  attributes.positions.begin() + static_cast<size_t>(chunk.positionBase) * 3);
+        // attributes.colors is only sized when some chunk has colors; offsetting an
+        // iterator into the empty vector is undefined even for an empty copy
+        if (!chunk.colors.empty()) {
+            std::copy(chunk.colors.begin(), chunk.colors.end(),
+                      attributes.colors.begin() + static_cast<size_t>(chunk.positionBase) * 3);
+        }
+        std::copy(chunk.texCoords.begin(), chunk.texCoords.end(),
+                  attributes.texCoords.begin() + static_cast<size_t>(chunk.texCoordBase) * 2);
+        std::copy(chunk.normals.begin(), chunk.normals.end(),
+                  attributes.normals.begin() + static_cast<size_t>(chunk.normalBase) * 3);
+        std::vector<float>().swap(chunk.positions);
+        std::vector<float>().swap(chunk.colors);
+        std::vector<float>().swap(chunk.texCoords);
+        std::vector<float>().swap(chunk.normals);
+    });
+    for (const auto& chunk : chunks) {
+        skippedFaces += chunk.skippedFaces;
+    }
+
+    std::vector<Group> groups = buildGroups(chunks, path.stem().string());
+    stats.positionCount = totalPositions;
+    stats.parseMs = elapsedMs(startTime);
+
+    // --- Weld ----------------------------------------------------------------
+    auto weldStart = Clock::now();
+    std::vector<MeshData> meshes(groups.size());
+    pool.parallelFor(groups.size(), [&](size_t g) { weldGroup(groups[g], attributes, meshes[g]); });
+    stats.weldMs = elapsedMs(weldStart);
+
+    // Corners are no longer needed
+    chunks.clear();
+    chunks.shrink_to_fit();
+
+    auto finalizeStart = Clock::now();
+    pool.parallelFor(meshes.size(), [&](size_t m) { finalizeMesh(meshes[m]); });
+    stats.finalizeMs = elapsedMs(finalizeStart);
+
+    for (auto& mesh : meshes) {
+        stats.triangleCount += mesh.indices.size() / 3;
+        stats.vertexCount += mesh.vertices.size();
+        outMeshes.push_back(std::move(mesh));
+    }
+    stats.totalMs = elapsedMs(startTime);
+
+    if (skippedFaces > 0) {
+        std::cerr << "ObjLoader: Skipped " << skippedFaces << " invalid faces in " << path.filename() << std::endl;
+    }
+    std::cout << "ObjLoader: Loaded " << groups.size() << " meshes (" << stats.vertexCount << " vertices, "
+              << stats.triangleCount << " triangles) from " << path.filename() << " in "
+              << static_cast<uint64_t>(stats.totalMs) << "ms ("
+              << static_cast<uint64_t>(stats.fileBytes / 1048576.0 / std::max(stats.totalMs / 1000.0, 1e-3)) << " MB/s)" << std::endl;
+
+    if (outStats) {
+        *outStats = stats;
+    }
+    return !groups.empty();
+}
+
+} // namespace MiEngine
@@ -4,9 +4,12 @@
 // =====================================================
 
 #include "loader/ModelLoader.h"
+#include "loader/GltfLoader.h"
 #include "animation/Skeleton.h"
 #include "animation/AnimationClip.h"
+#ifndef MIENGINE_NO_FBX
 #include <fbxsdk.h>
+#endif
 #include <iostream>
 #include <functional>
 #define GLM_ENABLE_EXPERIMENTAL
@@ -17,6 +20,24 @@
 
 using namespace MiEngine;
 
+bool ModelLoader::LoadSkeletalModel(const std::string& filename, SkeletalModelData& outData) {
+    if (GltfLoader::isGltfFile(filename)) {
+        return GltfLoader::loadSkeletal(filename, outData);
+    }
+
+#ifdef MIENGINE_NO_FBX
+    std::cerr << "ModelLoader: Built without FBX SDK, cannot load " << filename << std::endl;
+    return false;
+#else
+    if (!EnsureFbxManager()) {
+        return false;
+    }
+    return LoadFbxSkeletalModel(filename, outData);
+#endif
+}
+
+#ifndef MIENGINE_NO_FBX
+
 // Helper: Convert FbxAMatrix to glm::mat4
 static glm::mat4 FbxMatrixToGlm(const FbxAMatrix& fbxMatrix) {
     glm::mat4 result;
@@ -39,7 +60,7 @@ static glm::quat FbxQuatToGlm(const FbxQuaternion& q) {
                      static_cast<float>(q[2])); // z
 }
 
-bool ModelLoader::LoadSkeletalModel(const std::string& filename, SkeletalModelData& outData) {
+bool ModelLoader::LoadFbxSkeletalModel(const std::string& filename, SkeletalModelData& outData) {
     // Create a new scene for skeletal loading
     FbxScene* skeletalScene = FbxScene::Create(fbxManager, "SkeletalScene");
     if (!skeletalScene) {
@@ -417,7 +438,7 @@ void ModelLoader::ProcessSkeletonNode(FbxNode* node, int parentIndex, SkeletalMo
     localBindPoseGlm = FbxMatrixToGlm(localBindPose);
 
     // Add bone to skeleton
-    uint32_t boneIndex = outData.skeleton->addBone(boneName, parentIndex, inverseBindPose, localBindPoseGlm);
+    uint32_t boneIndex = outData.skeleton->addBone(MiEngine::MiName(boneName), parentIndex, inverseBindPose, localBindPoseGlm);
     m_boneNameToIndex[boneName] = boneIndex;
     outData.hasSkeleton = true;
 
@@ -481,7 +502,7 @@ void ModelLoader::ExtractAnimationStack(FbxAnimStack* animStack, FbxScene* scene
         const MiEngine::Bone& bone = outData.skeleton->getBone(boneIdx);
 
         // Find the FBX node for this bone
-        FbxNode* boneNode = scene->FindNodeByName(bone.name.c_str());
+        FbxNode* boneNode = scene->FindNodeByName(bone.name.toString().c_str());
         if (!boneNode) continue;
 
         MiEngine::BoneAnimationTrack& track = clip->addTrack(bone.name);
@@ -511,6 +532,8 @@ void ModelLoader::ExtractAnimationStack(FbxAnimStack* animStack, FbxScene* scene
     outData.animations.push_back(clip);
 }
 
+#endif // MIENGINE_NO_FBX
+
 void ModelLoader::CalculateTangents(SkeletalMeshData& meshData) {
     if (meshData.vertices.empty() || meshData.indices.empty()) {
         return;
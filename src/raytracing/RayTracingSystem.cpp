@@ -510,6 +510,16 @@ void RayTracingSystem::traceRays(VkCommandBuffer commandBuffer,
         m_TLASDirty = false;
     }
 
+    // Environment switched in the background: this frame's set is no longer in use, move it over
+    if (m_IBLSystem && m_IBLSystem->isReady()) {
+        m_IBLFrameVersions.resize(m_Renderer->getMaxFramesInFlight(), 0);
+        if (frameIndex < m_IBLFrameVersions.size() &&
+            m_IBLFrameVersions[frameIndex] != m_IBLSystem->getEnvironmentVersion()) {
+            updateDescriptorSets(frameIndex);
+            m_IBLFrameVersions[frameIndex] = m_IBLSystem->getEnvironmentVersion();
+        }
+    }
+
     // Bind ray tracing pipeline
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, m_Pipeline);
 
@@ -2343,7 +2353,7 @@ void RayTracingSystem::updateWorld(MiWorld* world) {
         if (meshComp && meshComp->getMesh()) {
             MeshInstanceInfo info;
             info.mesh = meshComp->getMesh();
-            info.transform = actorPtr->getTransform().getMatrix();
+            info.transform = meshComp->getWorldMatrix();
 
             // Get material properties from the component (per-instance material)
             const Material& mat = meshComp->getMaterial();
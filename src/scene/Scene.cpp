@@ -1,7 +1,12 @@
 ﻿#include "scene/Scene.h"
 #include "VulkanRenderer.h"
+#include "texture/TextureDecoder.h"
+#include "texture/TextureStreamingUploader.h"
+#include "culling/FrustumCulling.h"
+#include <chrono>
 #include <iostream>
 #include <filesystem>
+#include <unordered_set>
 
 
 Scene::Scene(VulkanRenderer* renderer) : renderer(renderer) {
@@ -11,6 +16,10 @@ Scene::Scene(VulkanRenderer* renderer) : renderer(renderer) {
 
 Scene::~Scene() {
     meshInstances.clear();
+    pendingTextures.clear();
+    m_StreamedTextureIds.clear();
+    m_TextureStreamer.reset();
+    m_TextureUploader.reset();
     textureCache.clear();
 }
 
@@ -53,6 +62,11 @@ void Scene::createMeshesFromData(const std::vector<MeshData>& meshDataList,
 
 bool Scene::loadTexturedModel(const std::string& modelFilename, const std::string& textureFilename, 
                              const Transform& transform) {
+    // Decode the texture while the model is parsed
+    if (!textureFilename.empty()) {
+        requestTexture(textureFilename);
+    }
+
     if (!modelLoader.LoadModel(modelFilename)) {
         std::cerr << "Failed to load model: " << modelFilename << std::endl;
         return false;
@@ -116,6 +130,11 @@ if (!textureFilename.empty()) {
 bool Scene::loadTexturedModelPBR(const std::string& modelFilename, 
                                const MaterialTexturePaths& texturePaths,
                                const Transform& transform) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Decode textures on the pool while the model is parsed
+    requestTextures(texturePaths);
+
     if (!modelLoader.LoadModel(modelFilename)) {
         std::cerr << "Failed to load model: " << modelFilename << std::endl;
         return false;
@@ -130,34 +149,37 @@ bool Scene::loadTexturedModelPBR(const std::string& modelFilename,
     // Create material with multiple textures
     auto material = std::make_shared<Material>();
     
+    // Upload every texture in one batch; the loads below hit the cache
+    flushTextureRequests();
+    
     // Load textures
     if (!texturePaths.diffuse.empty()) {
-        auto texture = loadTexture(texturePaths.diffuse);
+        auto texture = loadTexture(texturePaths.diffuse, TextureType::Diffuse);
         if (texture) material->setTexture(TextureType::Diffuse, texture);
     }
     
     if (!texturePaths.normal.empty()) {
-        auto texture = loadTexture(texturePaths.normal);
+        auto texture = loadTexture(texturePaths.normal, TextureType::Normal);
         if (texture) material->setTexture(TextureType::Normal, texture);
     }
     
     if (!texturePaths.metallic.empty()) {
-        auto texture = loadTexture(texturePaths.metallic);
+        auto texture = loadTexture(texturePaths.metallic, TextureType::Metallic);
         if (texture) material->setTexture(TextureType::Metallic, texture);
     }
     
     if (!texturePaths.roughness.empty()) {
-        auto texture = loadTexture(texturePaths.roughness);
+        auto texture = loadTexture(texturePaths.roughness, TextureType::Roughness);
         if (texture) material->setTexture(TextureType::Roughness, texture);
     }
     
     if (!texturePaths.ambientOcclusion.empty()) {
-        auto texture = loadTexture(texturePaths.ambientOcclusion);
+        auto texture = loadTexture(texturePaths.ambientOcclusion, TextureType::AmbientOcclusion);
         if (texture) material->setTexture(TextureType::AmbientOcclusion, texture);
     }
     
     if (!texturePaths.emissive.empty()) {
-        auto texture = loadTexture(texturePaths.emissive);
+        auto texture = loadTexture(texturePaths.emissive, TextureType::Emissive);
         if (texture) material->setTexture(TextureType::Emissive, texture);
     }
 
@@ -166,11 +188,11 @@ bool Scene::loadTexturedModelPBR(const std::string& modelFilename,
     std::shared_ptr<Texture> roughnessTex = nullptr;
 
     if (!texturePaths.metallic.empty()) {
-        metallicTex = loadTexture(texturePaths.metallic);
+        metallicTex = loadTexture(texturePaths.metallic, TextureType::Metallic);
     }
     
     if (!texturePaths.roughness.empty()) {
-        roughnessTex = loadTexture(texturePaths.roughness);
+        roughnessTex = loadTexture(texturePaths.roughness, TextureType::Roughness);
     }
 
     // If we have separate textures, combine them
@@ -213,16 +235,22 @@ bool Scene::loadTexturedModelPBR(const std::string& modelFilename,
     // Create meshes with the material
     createMeshesFromData(meshDataList, transform, material);
     
-    std::cout << "PBR Model loaded: " << modelFilename << std::endl;
+    double loadMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    std::cout << "PBR Model loaded: " << modelFilename << " in " << loadMs << " ms" << std::endl;
     return true;
 }
 
 Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePaths) {
     Material material;
     
+    // Decode all maps in parallel and upload them together
+    requestTextures(texturePaths);
+    flushTextureRequests();
+    
     // Load diffuse/albedo texture if provided
     if (!texturePaths.diffuse.empty()) {
-        auto texture = loadTexture(texturePaths.diffuse);
+        auto texture = loadTexture(texturePaths.diffuse, TextureType::Diffuse);
         if (texture) {
             material.setTexture(TextureType::Diffuse, texture);
         }
@@ -230,7 +258,7 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load normal map if provided
     if (!texturePaths.normal.empty()) {
-        auto texture = loadTexture(texturePaths.normal);
+        auto texture = loadTexture(texturePaths.normal, TextureType::Normal);
         if (texture) {
             material.setTexture(TextureType::Normal, texture);
             
@@ -239,7 +267,7 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load metallic map if provided
     if (!texturePaths.metallic.empty()) {
-        auto texture = loadTexture(texturePaths.metallic);
+        auto texture = loadTexture(texturePaths.metallic, TextureType::Metallic);
         if (texture) {
             material.setTexture(TextureType::Metallic, texture);
         }
@@ -247,7 +275,7 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load roughness map if provided
     if (!texturePaths.roughness.empty()) {
-        auto texture = loadTexture(texturePaths.roughness);
+        auto texture = loadTexture(texturePaths.roughness, TextureType::Roughness);
         if (texture) {
             material.setTexture(TextureType::Roughness, texture);
         }
@@ -255,7 +283,7 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load ambient occlusion map if provided
     if (!texturePaths.ambientOcclusion.empty()) {
-        auto texture = loadTexture(texturePaths.ambientOcclusion);
+        auto texture = loadTexture(texturePaths.ambientOcclusion, TextureType::AmbientOcclusion);
         if (texture) {
             material.setTexture(TextureType::AmbientOcclusion, texture);
         }
@@ -263,7 +291,7 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load emissive map if provided
     if (!texturePaths.emissive.empty()) {
-        auto texture = loadTexture(texturePaths.emissive);
+        auto texture = loadTexture(texturePaths.emissive, TextureType::Emissive);
         if (texture) {
             material.setTexture(TextureType::Emissive, texture);
         }
@@ -271,7 +299,7 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load height/displacement map if provided
     if (!texturePaths.height.empty()) {
-        auto texture = loadTexture(texturePaths.height);
+        auto texture = loadTexture(texturePaths.height, TextureType::Height);
         if (texture) {
             material.setTexture(TextureType::Height, texture);
         }
@@ -279,41 +307,151 @@ Material Scene::createMaterialWithTextures(const MaterialTexturePaths& texturePa
     
     // Load specular map if provided
     if (!texturePaths.specular.empty()) {
-        auto texture = loadTexture(texturePaths.specular);
+        auto texture = loadTexture(texturePaths.specular, TextureType::Specular);
         if (texture) {
             material.setTexture(TextureType::Specular, texture);
         }
     }
     
+    // The caller owns this material, so its textures can't change size under it
+    for (uint32_t type = 0; type < static_cast<uint32_t>(TextureType::Count); ++type) {
+        stopStreaming(material.getTexture(static_cast<TextureType>(type)));
+    }
+    
     return material;
 }
 
-std::shared_ptr<Texture> Scene::loadTexture(const std::string& filename) {
+namespace {
+
+// Baked, fully mipped textures sampled directly by materials. Metallic and roughness
+// maps are only read once to build the combined map, so they stay complete.
+bool isStreamable(TextureType type, const MiEngine::DecodedTexture& decoded) {
+    return type != TextureType::Metallic && type != TextureType::Roughness &&
+           decoded.mipLevels > 1 && decoded.levels.size() == decoded.mipLevels;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<Texture> Scene::loadTexture(const std::string& filename, TextureType type) {
+    std::shared_future<std::shared_ptr<Texture>> texture = requestTexture(filename, type);
+    if (texture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        flushTextureRequests();
+    }
+    return texture.get();
+}
+
+std::shared_future<std::shared_ptr<Texture>> Scene::requestTexture(const std::string& filename, TextureType type) {
+    // Check if texture is already loaded or queued
+    std::string key = textureCacheKey(filename, type);
+    auto it = textureCache.find(key);
+    if (it != textureCache.end()) {
+        return it->second;
+    }
+    
     // Check if file exists
     if (!std::filesystem::exists(filename)) {
         std::cerr << "Texture file does not exist: " << filename << std::endl;
-        return nullptr;
+        std::promise<std::shared_ptr<Texture>> missing;
+        missing.set_value(nullptr);
+        return missing.get_future().share();
     }
     
-    // Check if texture is already loaded
-    auto it = textureCache.find(filename);
-    if (it != textureCache.end()) {
-        return it->second;
+    PendingTexture pending;
+    pending.filename = filename;
+    pending.type = type;
+    pending.decoded = MiEngine::TextureDecoder::decodeAsync(filename, type);
+    std::shared_future<std::shared_ptr<Texture>> texture = pending.texture.get_future().share();
+    pendingTextures.push_back(std::move(pending));
+    
+    textureCache[key] = texture;
+    return texture;
+}
+
+void Scene::requestTextures(const MaterialTexturePaths& texturePaths) {
+    const std::pair<const std::string*, TextureType> textures[] = {
+        { &texturePaths.diffuse, TextureType::Diffuse },
+        { &texturePaths.normal, TextureType::Normal },
+        { &texturePaths.metallic, TextureType::Metallic },
+        { &texturePaths.roughness, TextureType::Roughness },
+        { &texturePaths.ambientOcclusion, TextureType::AmbientOcclusion },
+        { &texturePaths.emissive, TextureType::Emissive },
+        { &texturePaths.height, TextureType::Height },
+        { &texturePaths.specular, TextureType::Specular },
+    };
+    for (const auto& [path, type] : textures) {
+        if (!path->empty()) {
+            requestTexture(*path, type);
+        }
+    }
+}
+
+void Scene::flushTextureRequests() {
+    if (pendingTextures.empty()) {
+        return;
     }
     
-    // Create new texture
-    auto texture = std::make_shared<Texture>(renderer->getDevice(), renderer->getPhysicalDevice());
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::vector<PendingTexture> pending = std::move(pendingTextures);
+    pendingTextures.clear();
+    
+    std::vector<std::shared_ptr<MiEngine::DecodedTexture>> decoded;
+    decoded.reserve(pending.size());
+    for (auto& request : pending) {
+        decoded.push_back(request.decoded.get());
+    }
+    auto decodedTime = std::chrono::high_resolution_clock::now();
     
-    // Load texture from file
-    if (!texture->loadFromFile(filename, renderer->getCommandPool(), renderer->getGraphicsQueue())) {
-        std::cerr << "Failed to load texture from file: " << filename << std::endl;
-        return nullptr;
+    // Streamed textures start with their tail mips; the streamer adds the rest as needed
+    std::vector<std::shared_ptr<MiEngine::DecodedTexture>> uploads = decoded;
+    std::vector<uint32_t> tailMips(pending.size(), MiEngine::TextureStreamer::INVALID_ID);
+    if (m_TextureStreamer) {
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (decoded[i] && isStreamable(pending[i].type, *decoded[i])) {
+                tailMips[i] = m_TextureStreamer->getTailMip(decoded[i]->width, decoded[i]->height, decoded[i]->mipLevels);
+                uploads[i] = MiEngine::TextureStreamingUploader::selectMips(*decoded[i], tailMips[i]);
+            }
+        }
     }
     
-    // Cache the texture
-    textureCache[filename] = texture;
+    std::vector<std::shared_ptr<Texture>> textures = Texture::uploadBatch(
+        renderer->getDevice(), renderer->getPhysicalDevice(),
+        renderer->getCommandPool(), renderer->getGraphicsQueue(), uploads);
+    auto uploadedTime = std::chrono::high_resolution_clock::now();
     
-    return texture;
+    size_t loaded = 0;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        std::shared_ptr<Texture> texture = textures[i];
+        
+        // The device can't sample the baked format; upload the source image instead
+        if (!texture && decoded[i]) {
+            texture = std::make_shared<Texture>(renderer->getDevice(), renderer->getPhysicalDevice());
+            if (!texture->loadFromFile(pending[i].filename, renderer->getCommandPool(), renderer->getGraphicsQueue())) {
+                texture = nullptr;
+            }
+        }
+        
+        if (texture) {
+            ++loaded;
+            if (textures[i] && tailMips[i] != MiEngine::TextureStreamer::INVALID_ID) {
+                std::vector<uint64_t> mipBytes;
+                for (const auto& level : decoded[i]->levels) {
+                    mipBytes.push_back(level.size);
+                }
+                uint32_t id = m_TextureStreamer->registerTexture(decoded[i]->width, decoded[i]->height,
+                                                                 mipBytes, tailMips[i]);
+                m_TextureUploader->addTexture(id, texture, decoded[i]);
+                m_StreamedTextureIds[texture.get()] = id;
+            }
+        } else {
+            std::cerr << "Failed to load texture from file: " << pending[i].filename << std::endl;
+            textureCache.erase(textureCacheKey(pending[i].filename, pending[i].type));
+        }
+        pending[i].texture.set_value(texture);
+    }
+    
+    std::cout << "Scene: Loaded " << loaded << "/" << pending.size() << " textures (decode wait "
+              << std::chrono::duration<double, std::milli>(decodedTime - startTime).count() << " ms, upload "
+              << std::chrono::duration<double, std::milli>(uploadedTime - decodedTime).count() << " ms)" << std::endl;
 }
 
 void Scene::createMeshesFromData(const std::vector<MeshData>& meshDataList, const Transform& transform,
@@ -343,6 +481,117 @@ void Scene::update(float deltaTime) {
             instance.skeletalMesh->update(deltaTime);
         }
     }
+
+    // Stream texture mips requested by the last draw
+    updateTextureStreaming();
+}
+
+void Scene::enableTextureStreaming(const MiEngine::TextureStreamingSettings& settings) {
+    if (m_TextureStreamer) {
+        m_TextureStreamer->setSettings(settings);
+        return;
+    }
+    m_TextureUploader = std::make_unique<MiEngine::TextureStreamingUploader>(
+        renderer->getDevice(), renderer->getPhysicalDevice(),
+        renderer->getCommandPool(), renderer->getGraphicsQueue());
+    m_TextureStreamer = std::make_unique<MiEngine::TextureStreamer>(*m_TextureUploader, settings);
+}
+
+void Scene::requestStreamedMips(const glm::mat4& view, const glm::mat4& proj) {
+    if (!m_TextureStreamer || m_StreamedTextureIds.empty()) {
+        return;
+    }
+
+    MiEngine::Frustum frustum;
+    frustum.extractFromViewProj(proj * view);
+    float viewportHeight = static_cast<float>(renderer->getSwapChainExtent().height);
+
+    for (const auto& instance : meshInstances) {
+        if (!instance.mesh || !instance.mesh->getMaterial()) {
+            continue;
+        }
+        const std::shared_ptr<Material>& material = instance.mesh->getMaterial();
+
+        // Meshes without bounds count as filling the screen
+        float screenSize = viewportHeight;
+        const AABB& bounds = instance.mesh->getBoundingBox();
+        if (bounds.min.x <= bounds.max.x) {
+            glm::mat4 model = instance.transform.getModelMatrix();
+            glm::vec3 center = glm::vec3(model * glm::vec4(bounds.getCenter(), 1.0f));
+            float scale = std::max(std::max(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1]))),
+                                   glm::length(glm::vec3(model[2])));
+            if (!frustum.testSphere(center, glm::length(bounds.getExtents()) * scale)) {
+                continue;
+            }
+            screenSize = MiEngine::TextureStreamer::computeScreenSize(bounds.min, bounds.max, model, view, proj,
+                                                                      viewportHeight);
+        }
+
+        for (uint32_t type = 0; type < static_cast<uint32_t>(TextureType::Count); ++type) {
+            std::shared_ptr<Texture> texture = material->getTexture(static_cast<TextureType>(type));
+            auto it = texture ? m_StreamedTextureIds.find(texture.get()) : m_StreamedTextureIds.end();
+            if (it != m_StreamedTextureIds.end()) {
+                m_TextureStreamer->requestScreenSize(it->second, screenSize);
+            }
+        }
+    }
+}
+
+void Scene::updateTextureStreaming() {
+    if (!m_TextureStreamer) {
+        return;
+    }
+
+    const std::vector<MiEngine::TextureResidencyChange>& changes = m_TextureStreamer->update();
+    if (changes.empty()) {
+        return;
+    }
+
+    std::vector<const Texture*> changedTextures;
+    for (const auto& change : changes) {
+        changedTextures.push_back(m_TextureUploader->getTexture(change.textureId).get());
+    }
+    refreshMaterialDescriptors(changedTextures);
+}
+
+void Scene::refreshMaterialDescriptors(const std::vector<const Texture*>& changedTextures) {
+    std::unordered_set<const Texture*> changed(changedTextures.begin(), changedTextures.end());
+    std::unordered_set<const Material*> visited;
+
+    // The upload waited for the queue to go idle, so the sets aren't in use
+    for (const auto& instance : meshInstances) {
+        if (!instance.mesh || !instance.mesh->getMaterial()) {
+            continue;
+        }
+        const std::shared_ptr<Material>& material = instance.mesh->getMaterial();
+        if (material->getDescriptorSet() == VK_NULL_HANDLE || !visited.insert(material.get()).second) {
+            continue;
+        }
+        for (uint32_t type = 0; type < static_cast<uint32_t>(TextureType::Count); ++type) {
+            if (changed.count(material->getTexture(static_cast<TextureType>(type)).get())) {
+                renderer->updateMaterialDescriptorSet(material->getDescriptorSet(), *material);
+                break;
+            }
+        }
+    }
+}
+
+void Scene::stopStreaming(const std::shared_ptr<Texture>& texture) {
+    auto it = texture ? m_StreamedTextureIds.find(texture.get()) : m_StreamedTextureIds.end();
+    if (it == m_StreamedTextureIds.end()) {
+        return;
+    }
+
+    uint32_t id = it->second;
+    std::vector<MiEngine::TextureResidencyChange> changes = { { id, m_TextureStreamer->getResidentMip(id), 0, true } };
+    if (changes[0].fromMip != 0) {
+        m_TextureUploader->applyResidency(changes);
+        refreshMaterialDescriptors({ texture.get() });
+    }
+
+    m_TextureStreamer->unregisterTexture(id);
+    m_TextureUploader->removeTexture(id);
+    m_StreamedTextureIds.erase(it);
 }
 
 void Scene::enablePhysics(size_t instanceIndex, RigidBodyType bodyType) {
@@ -420,6 +669,9 @@ void Scene::draw(VkCommandBuffer commandBuffer, const glm::mat4& view, const glm
     // Common setup - update view/projection matrices
     renderer->updateViewProjection(view, proj);
 
+    // Texture mips needed for this view; uploaded before the next frame is recorded
+    requestStreamedMips(view, proj);
+
     // Check which pipeline to use
     bool usePBR = renderer->getRenderMode() == RenderMode::PBR ||
                  renderer->getRenderMode() == RenderMode::PBR_IBL;
@@ -764,13 +1016,24 @@ Material Scene::createPBRMaterial(
     material.setPBRProperties(metallic, roughness);
     material.emissiveStrength = emissiveStrength;
     
+    // Decode every map in parallel and upload them together
+    MaterialTexturePaths texturePaths;
+    texturePaths.diffuse = albedoPath;
+    texturePaths.normal = normalPath;
+    texturePaths.metallic = metallicPath;
+    texturePaths.roughness = roughnessPath;
+    texturePaths.ambientOcclusion = aoPath;
+    texturePaths.emissive = emissivePath;
+    requestTextures(texturePaths);
+    flushTextureRequests();
+    
     // Load each texture if provided
-    std::shared_ptr<Texture> albedoTex = albedoPath.empty() ? nullptr : loadTexture(albedoPath);
-    std::shared_ptr<Texture> normalTex = normalPath.empty() ? nullptr : loadTexture(normalPath);
-    std::shared_ptr<Texture> metallicTex = metallicPath.empty() ? nullptr : loadTexture(metallicPath);
-    std::shared_ptr<Texture> roughnessTex = roughnessPath.empty() ? nullptr : loadTexture(roughnessPath);
-    std::shared_ptr<Texture> aoTex = aoPath.empty() ? nullptr : loadTexture(aoPath);
-    std::shared_ptr<Texture> emissiveTex = emissivePath.empty() ? nullptr : loadTexture(emissivePath);
+    std::shared_ptr<Texture> albedoTex = albedoPath.empty() ? nullptr : loadTexture(albedoPath, TextureType::Diffuse);
+    std::shared_ptr<Texture> normalTex = normalPath.empty() ? nullptr : loadTexture(normalPath, TextureType::Normal);
+    std::shared_ptr<Texture> metallicTex = metallicPath.empty() ? nullptr : loadTexture(metallicPath, TextureType::Metallic);
+    std::shared_ptr<Texture> roughnessTex = roughnessPath.empty() ? nullptr : loadTexture(roughnessPath, TextureType::Roughness);
+    std::shared_ptr<Texture> aoTex = aoPath.empty() ? nullptr : loadTexture(aoPath, TextureType::AmbientOcclusion);
+    std::shared_ptr<Texture> emissiveTex = emissivePath.empty() ? nullptr : loadTexture(emissivePath, TextureType::Emissive);
     
     // If both metallic and roughness are provided, we could combine them
     std::shared_ptr<Texture> metallicRoughnessTex = nullptr;
@@ -815,6 +1078,11 @@ Material Scene::createPBRMaterial(
         emissiveTex
     );
     
+    // The caller owns this material, so its textures can't change size under it
+    for (uint32_t type = 0; type < static_cast<uint32_t>(TextureType::Count); ++type) {
+        stopStreaming(material.getTexture(static_cast<TextureType>(type)));
+    }
+    
     // Create descriptor set
     VkDescriptorSet materialDescriptorSet = renderer->createMaterialDescriptorSet(material);
     if (materialDescriptorSet != VK_NULL_HANDLE) {
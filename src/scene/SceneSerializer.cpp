@@ -67,7 +67,7 @@ std::shared_ptr<MiActor> SceneSerializer::deserializeActor(MiWorld& world, const
         return nullptr;
     }
 
-    auto actor = std::dynamic_pointer_cast<MiActor>(obj);
+    auto actor = Cast<MiActor>(obj);
     if (!actor) {
         return nullptr;
     }
@@ -90,7 +90,7 @@ std::shared_ptr<MiActor> SceneSerializer::deserializeActor(MiWorld& world, const
             component->setOwner(actor.get());
 
             // If it's a scene component and matches the root, update it
-            if (auto sceneComp = std::dynamic_pointer_cast<MiSceneComponent>(component)) {
+            if (auto sceneComp = Cast<MiSceneComponent>(component)) {
                 auto rootComp = actor->getRootComponent();
                 if (rootComp && rootComp->getTypeName() == sceneComp->getTypeName()) {
                     // Update the existing root component instead of adding new
@@ -129,7 +129,7 @@ std::shared_ptr<MiComponent> SceneSerializer::deserializeComponent(const JsonRea
         return nullptr;
     }
 
-    auto component = std::dynamic_pointer_cast<MiComponent>(obj);
+    auto component = Cast<MiComponent>(obj);
     if (component) {
         component->deserialize(reader);
     }
@@ -264,7 +264,10 @@ SceneResult SceneSerializer::loadScene(MiWorld& world, const fs::path& filePath)
                 auto spawnedActor = world.spawnActorByTypeName(typeName);
                 if (spawnedActor) {
                     // Copy the ID to maintain references
-                    spawnedActor->setObjectId(actorReader.getString("id", spawnedActor->getObjectId()));
+                    std::string id = actorReader.getString("id", "");
+                    if (!id.empty()) {
+                        spawnedActor->setObjectId(ObjectId::fromString(id));
+                    }
                     spawnedActor->setName(actorReader.getString("name", spawnedActor->getName()));
 
                     // Deserialize the rest
@@ -6,6 +6,7 @@
 #include "animation/Skeleton.h"
 #include "animation/AnimationClip.h"
 #include "mesh/SkeletalMesh.h"
+#include <chrono>
 #include <iostream>
 #include <filesystem>
 
@@ -85,6 +86,11 @@ bool Scene::loadSkeletalModel(const std::string& filename, const Transform& tran
 bool Scene::loadSkeletalModelPBR(const std::string& modelFilename,
                                   const MaterialTexturePaths& texturePaths,
                                   const Transform& transform) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Decode textures on the pool while the model is parsed
+    requestTextures(texturePaths);
+
     SkeletalModelData modelData;
     if (!modelLoader.LoadSkeletalModel(modelFilename, modelData)) {
         std::cerr << "Failed to load skeletal model: " << modelFilename << std::endl;
@@ -102,14 +108,17 @@ bool Scene::loadSkeletalModelPBR(const std::string& modelFilename,
     // Create PBR material with textures
     auto material = std::make_shared<Material>();
 
+    // Upload every texture in one batch; the loads below hit the cache
+    flushTextureRequests();
+
     // Load textures
     if (!texturePaths.diffuse.empty()) {
-        auto texture = loadTexture(texturePaths.diffuse);
+        auto texture = loadTexture(texturePaths.diffuse, TextureType::Diffuse);
         if (texture) material->setTexture(TextureType::Diffuse, texture);
     }
 
     if (!texturePaths.normal.empty()) {
-        auto texture = loadTexture(texturePaths.normal);
+        auto texture = loadTexture(texturePaths.normal, TextureType::Normal);
         if (texture) material->setTexture(TextureType::Normal, texture);
     }
 
@@ -118,11 +127,11 @@ bool Scene::loadSkeletalModelPBR(const std::string& modelFilename,
     std::shared_ptr<Texture> roughnessTex = nullptr;
 
     if (!texturePaths.metallic.empty()) {
-        metallicTex = loadTexture(texturePaths.metallic);
+        metallicTex = loadTexture(texturePaths.metallic, TextureType::Metallic);
     }
 
     if (!texturePaths.roughness.empty()) {
-        roughnessTex = loadTexture(texturePaths.roughness);
+        roughnessTex = loadTexture(texturePaths.roughness, TextureType::Roughness);
     }
 
     if (metallicTex || roughnessTex) {
@@ -141,12 +150,12 @@ bool Scene::loadSkeletalModelPBR(const std::string& modelFilename,
     }
 
     if (!texturePaths.ambientOcclusion.empty()) {
-        auto texture = loadTexture(texturePaths.ambientOcclusion);
+        auto texture = loadTexture(texturePaths.ambientOcclusion, TextureType::AmbientOcclusion);
         if (texture) material->setTexture(TextureType::AmbientOcclusion, texture);
     }
 
     if (!texturePaths.emissive.empty()) {
-        auto texture = loadTexture(texturePaths.emissive);
+        auto texture = loadTexture(texturePaths.emissive, TextureType::Emissive);
         if (texture) material->setTexture(TextureType::Emissive, texture);
     }
 
@@ -187,6 +196,9 @@ bool Scene::loadSkeletalModelPBR(const std::string& modelFilename,
         meshInstances.push_back(std::move(instance));
     }
 
+    double loadMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    std::cout << "Skeletal PBR model loaded: " << modelFilename << " in " << loadMs << " ms" << std::endl;
     return true;
 }
 
@@ -0,0 +1,524 @@
+#include "texture/BlockCompression.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MI_BC_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace MiEngine {
+
+namespace {
+
+// 16 texels, channel-major so four pixels of one channel load as one vector
+struct BlockSoA {
+    alignas(16) float c[4][16];
+};
+
+void toSoA(const uint8_t pixels[64], BlockSoA& block) {
+    for (int i = 0; i < 16; ++i) {
+        for (int ch = 0; ch < 4; ++ch) {
+            block.c[ch][i] = static_cast<float>(pixels[i * 4 + ch]);
+        }
+    }
+}
+
+// Nearest palette entry for every texel over the first `channels` channels.
+// Returns the summed squared error.
+float selectIndices(const BlockSoA& block, int channels, const float (*palette)[4], int paletteSize,
+                    uint8_t indices[16]) {
+    float totalError = 0.0f;
+#ifdef MI_BC_SSE2
+    for (int group = 0; group < 16; group += 4) {
+        __m128 px[4];
+        for (int ch = 0; ch < channels; ++ch) {
+            px[ch] = _mm_load_ps(&block.c[ch][group]);
+        }
+
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIndex = _mm_setzero_si128();
+        for (int k = 0; k < paletteSize; ++k) {
+            __m128 diff = _mm_sub_ps(px[0], _mm_set1_ps(palette[k][0]));
+            __m128 dist = _mm_mul_ps(diff, diff);
+            for (int ch = 1; ch < channels; ++ch) {
+                diff = _mm_sub_ps(px[ch], _mm_set1_ps(palette[k][ch]));
+                dist = _mm_add_ps(dist, _mm_mul_ps(diff, diff));
+            }
+            __m128i closer = _mm_castps_si128(_mm_cmplt_ps(dist, best));
+            best = _mm_min_ps(dist, best);
+            bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(k)),
+                                     _mm_andnot_si128(closer, bestIndex));
+        }
+
+        alignas(16) int32_t lanes[4];
+        alignas(16) float errors[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), bestIndex);
+        _mm_store_ps(errors, best);
+        for (int i = 0; i < 4; ++i) {
+            indices[group + i] = static_cast<uint8_t>(lanes[i]);
+            totalError += errors[i];
+        }
+    }
+#else
+    for (int i = 0; i < 16; ++i) {
+        float best = std::numeric_limits<float>::max();
+        int bestIndex = 0;
+        for (int k = 0; k < paletteSize; ++k) {
+            float dist = 0.0f;
+            for (int ch = 0; ch < channels; ++ch) {
+                float diff = block.c[ch][i] - palette[k][ch];
+                dist += diff * diff;
+            }
+            if (dist < best) {
+                best = dist;
+                bestIndex = k;
+            }
+        }
+        indices[i] = static_cast<uint8_t>(bestIndex);
+        totalError += best;
+    }
+#endif
+    return totalError;
+}
+
+// Endpoints at the extremes of the block's principal axis
+void principalEndpoints(const BlockSoA& block, int channels, float e0[4], float e1[4]) {
+    float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int ch = 0; ch < channels; ++ch) {
+        for (int i = 0; i < 16; ++i) {
+            mean[ch] += block.c[ch][i];
+        }
+        mean[ch] /= 16.0f;
+    }
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i) {
+        for (int a = 0; a < channels; ++a) {
+            float da = block.c[a][i] - mean[a];
+            for (int b = a; b < channels; ++b) {
+                cov[a][b] += da * (block.c[b][i] - mean[b]);
+            }
+        }
+    }
+    for (int a = 0; a < channels; ++a) {
+        for (int b = 0; b < a; ++b) {
+            cov[a][b] = cov[b][a];
+        }
+    }
+
+    // Power iteration, seeded with the highest-variance channel
+    int seed = 0;
+    for (int ch = 1; ch < channels; ++ch) {
+        if (cov[ch][ch] > cov[seed][seed]) seed = ch;
+    }
+    float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int ch = 0; ch < channels; ++ch) {
+        axis[ch] = cov[seed][ch];
+    }
+    for (int iteration = 0; iteration < 6; ++iteration) {
+        float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float length = 0.0f;
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                next[a] += cov[a][b] * axis[b];
+            }
+            length = std::max(length, std::abs(next[a]));
+        }
+        if (length < 1e-12f) break;
+        for (int a = 0; a < channels; ++a) {
+            axis[a] = next[a] / length;
+        }
+    }
+
+    float length = 0.0f;
+    for (int ch = 0; ch < channels; ++ch) {
+        length += axis[ch] * axis[ch];
+    }
+    if (length < 1e-12f) {
+        for (int ch = 0; ch < 4; ++ch) {
+            e0[ch] = e1[ch] = mean[ch];
+        }
+        return;
+    }
+    length = std::sqrt(length);
+    for (int ch = 0; ch < channels; ++ch) {
+        axis[ch] /= length;
+    }
+
+    float tMin = std::numeric_limits<float>::max();
+    float tMax = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int ch = 0; ch < channels; ++ch) {
+            t += (block.c[ch][i] - mean[ch]) * axis[ch];
+        }
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    for (int ch = 0; ch < 4; ++ch) {
+        e0[ch] = ch < channels ? std::clamp(mean[ch] + tMin * axis[ch], 0.0f, 255.0f) : 255.0f;
+        e1[ch] = ch < channels ? std::clamp(mean[ch] + tMax * axis[ch], 0.0f, 255.0f) : 255.0f;
+    }
+}
+
+// Least-squares endpoints for fixed interpolation weights; false if singular
+bool refitEndpoints(const BlockSoA& block, int channels, const float weights[16], float e0[4], float e1[4]) {
+    float a = 0.0f, b = 0.0f, c = 0.0f;
+    float rhs0[4] = {}, rhs1[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        float w = weights[i];
+        float iw = 1.0f - w;
+        a += iw * iw;
+        b += iw * w;
+        c += w * w;
+        for (int ch = 0; ch < channels; ++ch) {
+            rhs0[ch] += iw * block.c[ch][i];
+            rhs1[ch] += w * block.c[ch][i];
+        }
+    }
+    float det = a * c - b * b;
+    if (std::abs(det) < 1e-6f) {
+        return false;
+    }
+    for (int ch = 0; ch < channels; ++ch) {
+        e0[ch] = std::clamp((c * rhs0[ch] - b * rhs1[ch]) / det, 0.0f, 255.0f);
+        e1[ch] = std::clamp((a * rhs1[ch] - b * rhs0[ch]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// Little-endian bit writer for 128-bit blocks
+struct BitWriter {
+    uint8_t* out;
+    uint32_t position = 0;
+
+    void write(uint32_t value, uint32_t bits) {
+        for (uint32_t i = 0; i < bits; ++i, ++position) {
+            if (value & (1u << i)) {
+                out[position >> 3] |= static_cast<uint8_t>(1u << (position & 7));
+            }
+        }
+    }
+};
+
+// ----------------------------------------------------------------------------
+// BC1
+// ----------------------------------------------------------------------------
+
+uint16_t packRgb565(const float color[4]) {
+    uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+    uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+    uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackRgb565(uint16_t packed, float color[4]) {
+    uint32_t r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = static_cast<float>((r << 3) | (r >> 2));
+    color[1] = static_cast<float>((g << 2) | (g >> 4));
+    color[2] = static_cast<float>((b << 3) | (b >> 2));
+    color[3] = 255.0f;
+}
+
+struct Bc1Candidate {
+    uint16_t c0 = 0, c1 = 0;
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+// Evaluate a pair of quantized endpoints in 4-color mode (c0 > c1)
+Bc1Candidate evaluateBc1(const BlockSoA& block, uint16_t c0, uint16_t c1) {
+    Bc1Candidate candidate;
+    if (c0 < c1) std::swap(c0, c1);
+    candidate.c0 = c0;
+    candidate.c1 = c1;
+    if (c0 == c1) {
+        // Equal endpoints select 3-color mode; index 0 is still c0
+        float palette[1][4];
+        unpackRgb565(c0, palette[0]);
+        candidate.error = selectIndices(block, 3, palette, 1, candidate.indices);
+        return candidate;
+    }
+
+    float palette[4][4];
+    unpackRgb565(c0, palette[0]);
+    unpackRgb565(c1, palette[1]);
+    for (int ch = 0; ch < 3; ++ch) {
+        palette[2][ch] = (2.0f * palette[0][ch] + palette[1][ch]) / 3.0f;
+        palette[3][ch] = (palette[0][ch] + 2.0f * palette[1][ch]) / 3.0f;
+    }
+    candidate.error = selectIndices(block, 3, palette, 4, candidate.indices);
+    return candidate;
+}
+
+// ----------------------------------------------------------------------------
+// BC4
+// ----------------------------------------------------------------------------
+
+struct Bc4Candidate {
+    uint8_t r0 = 0, r1 = 0;
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+// 8-value mode (r0 > r1): index 0 = r0, 1 = r1, 2..7 interpolate from r0 to r1
+Bc4Candidate evaluateBc4(const float values[16], uint8_t r0, uint8_t r1) {
+    Bc4Candidate candidate;
+    if (r0 < r1) std::swap(r0, r1);
+    candidate.r0 = r0;
+    candidate.r1 = r1;
+    candidate.error = 0.0f;
+
+    if (r0 == r1) {
+        for (int i = 0; i < 16; ++i) {
+            float diff = values[i] - r0;
+            candidate.error += diff * diff;
+        }
+        return candidate;
+    }
+
+    float range = static_cast<float>(r0 - r1);
+    for (int i = 0; i < 16; ++i) {
+        int step = static_cast<int>(std::lround((r0 - values[i]) * 7.0f / range));
+        step = std::clamp(step, 0, 7);
+        float decoded = ((7 - step) * r0 + step * r1) / 7.0f;
+        float diff = values[i] - decoded;
+        candidate.error += diff * diff;
+        candidate.indices[i] = static_cast<uint8_t>(step == 0 ? 0 : (step == 7 ? 1 : step + 1));
+    }
+    return candidate;
+}
+
+void encodeBc4Channel(const uint8_t pixels[64], uint32_t channel, uint8_t out[8]) {
+    float values[16];
+    float minValue = 255.0f, maxValue = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        values[i] = pixels[i * 4 + channel];
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+    }
+
+    Bc4Candidate best = evaluateBc4(values, static_cast<uint8_t>(maxValue), static_cast<uint8_t>(minValue));
+
+    // One least-squares refit on the ramp positions
+    if (best.r0 != best.r1) {
+        BlockSoA block;
+        float weights[16];
+        for (int i = 0; i < 16; ++i) {
+            block.c[0][i] = values[i];
+            uint8_t index = best.indices[i];
+            int step = index == 0 ? 0 : (index == 1 ? 7 : index - 1);
+            weights[i] = step / 7.0f;
+        }
+        float e0[4], e1[4];
+        if (refitEndpoints(block, 1, weights, e0, e1)) {
+            Bc4Candidate refit = evaluateBc4(values, static_cast<uint8_t>(std::lround(e0[0])),
+                                             static_cast<uint8_t>(std::lround(e1[0])));
+            if (refit.error < best.error) best = refit;
+        }
+    }
+
+    std::memset(out, 0, 8);
+    out[0] = best.r0;
+    out[1] = best.r1;
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= static_cast<uint64_t>(best.indices[i] & 7) << (3 * i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// BC7 mode 6: one subset, RGBA 7.7.7.7 endpoints + per-endpoint p-bit, 4-bit indices
+// ----------------------------------------------------------------------------
+
+constexpr int BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+struct Bc7Endpoint {
+    uint8_t value[4];   // 7-bit per channel
+    uint8_t pbit;
+};
+
+// Quantize to 7 bits + shared p-bit, picking the p-bit with the lower error
+Bc7Endpoint quantizeBc7(const float color[4]) {
+    Bc7Endpoint best{};
+    float bestError = std::numeric_limits<float>::max();
+    for (uint8_t p = 0; p < 2; ++p) {
+        Bc7Endpoint candidate{};
+        candidate.pbit = p;
+        float error = 0.0f;
+        for (int ch = 0; ch < 4; ++ch) {
+            int q = static_cast<int>(std::lround((color[ch] - p) / 2.0f));
+            q = std::clamp(q, 0, 127);
+            candidate.value[ch] = static_cast<uint8_t>(q);
+            float diff = static_cast<float>((q << 1) | p) - color[ch];
+            error += diff * diff;
+        }
+        if (error < bestError) {
+            bestError = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+struct Bc7Candidate {
+    Bc7Endpoint e0{}, e1{};
+    uint8_t indices[16] = {};
+    float error = std::numeric_limits<float>::max();
+};
+
+Bc7Candidate evaluateBc7(const BlockSoA& block, const Bc7Endpoint& e0, const Bc7Endpoint& e1) {
+    Bc7Candidate candidate;
+    candidate.e0 = e0;
+    candidate.e1 = e1;
+
+    int a[4], b[4];
+    for (int ch = 0; ch < 4; ++ch) {
+        a[ch] = (e0.value[ch] << 1) | e0.pbit;
+        b[ch] = (e1.value[ch] << 1) | e1.pbit;
+    }
+    float palette[16][4];
+    for (int k = 0; k < 16; ++k) {
+        for (int ch = 0; ch < 4; ++ch) {
+            palette[k][ch] = static_cast<float>(((64 - BC7_WEIGHTS4[k]) * a[ch] + BC7_WEIGHTS4[k] * b[ch] + 32) >> 6);
+        }
+    }
+    candidate.error = selectIndices(block, 4, palette, 16, candidate.indices);
+    return candidate;
+}
+
+} // anonymous namespace
+
+uint32_t BlockCompression::getBlockBytes(BlockFormat format) {
+    return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+}
+
+size_t BlockCompression::getCompressedSize(BlockFormat format, uint32_t width, uint32_t height) {
+    size_t blocksX = (std::max(width, 1u) + 3) / 4;
+    size_t blocksY = (std::max(height, 1u) + 3) / 4;
+    return blocksX * blocksY * getBlockBytes(format);
+}
+
+void BlockCompression::encodeBC1(const uint8_t pixels[64], uint8_t out[8]) {
+    BlockSoA block;
+    toSoA(pixels, block);
+
+    float e0[4], e1[4];
+    principalEndpoints(block, 3, e0, e1);
+    Bc1Candidate best = evaluateBc1(block, packRgb565(e0), packRgb565(e1));
+
+    for (int iteration = 0; iteration < 2 && best.c0 != best.c1; ++iteration) {
+        static constexpr float weightOf[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        float weights[16];
+        for (int i = 0; i < 16; ++i) {
+            weights[i] = weightOf[best.indices[i]];
+        }
+        if (!refitEndpoints(block, 3, weights, e0, e1)) break;
+        Bc1Candidate refit = evaluateBc1(block, packRgb565(e0), packRgb565(e1));
+        if (refit.error >= best.error) break;
+        best = refit;
+    }
+
+    out[0] = static_cast<uint8_t>(best.c0);
+    out[1] = static_cast<uint8_t>(best.c0 >> 8);
+    out[2] = static_cast<uint8_t>(best.c1);
+    out[3] = static_cast<uint8_t>(best.c1 >> 8);
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= static_cast<uint32_t>(best.indices[i] & 3) << (2 * i);
+    }
+    std::memcpy(out + 4, &bits, 4);
+}
+
+void BlockCompression::encodeBC4(const uint8_t pixels[64], uint32_t channel, uint8_t out[8]) {
+    encodeBc4Channel(pixels, channel, out);
+}
+
+void BlockCompression::encodeBC5(const uint8_t pixels[64], uint8_t out[16]) {
+    encodeBc4Channel(pixels, 0, out);
+    encodeBc4Channel(pixels, 1, out + 8);
+}
+
+void BlockCompression::encodeBC7(const uint8_t pixels[64], uint8_t out[16]) {
+    BlockSoA block;
+    toSoA(pixels, block);
+
+    float e0[4], e1[4];
+    principalEndpoints(block, 4, e0, e1);
+    Bc7Candidate best = evaluateBc7(block, quantizeBc7(e0), quantizeBc7(e1));
+
+    for (int iteration = 0; iteration < 2; ++iteration) {
+        float weights[16];
+        for (int i = 0; i < 16; ++i) {
+            weights[i] = BC7_WEIGHTS4[best.indices[i]] / 64.0f;
+        }
+        if (!refitEndpoints(block, 4, weights, e0, e1)) break;
+        Bc7Candidate refit = evaluateBc7(block, quantizeBc7(e0), quantizeBc7(e1));
+        if (refit.error >= best.error) break;
+        best = refit;
+    }
+
+    // The anchor (texel 0) index is stored with its top bit implied zero
+    if (best.indices[0] & 8) {
+        std::swap(best.e0, best.e1);
+        for (int i = 0; i < 16; ++i) {
+            best.indices[i] = static_cast<uint8_t>(15 - best.indices[i]);
+        }
+    }
+
+    std::memset(out, 0, 16);
+    BitWriter writer{ out };
+    writer.write(1u << 6, 7);                       // Mode 6
+    for (int ch = 0; ch < 4; ++ch) {
+        writer.write(best.e0.value[ch], 7);
+        writer.write(best.e1.value[ch], 7);
+    }
+    writer.write(best.e0.pbit, 1);
+    writer.write(best.e1.pbit, 1);
+    writer.write(best.indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.write(best.indices[i], 4);
+    }
+}
+
+void BlockCompression::compress(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                BlockFormat format, std::vector<uint8_t>& outBlocks) {
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const uint32_t blockBytes = getBlockBytes(format);
+    outBlocks.resize(getCompressedSize(format, width, height));
+
+    // Roughly 64 blocks per claimed chunk
+    size_t grain = std::max<size_t>(1, 64 / std::max(blocksX, 1u));
+
+    ThreadPool::getInstance().parallelFor(blocksY, [&](size_t by) {
+        uint8_t pixels[64];
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            // Gather the 4x4 block, replicating edges
+            for (uint32_t y = 0; y < 4; ++y) {
+                uint32_t sy = std::min<uint32_t>(static_cast<uint32_t>(by) * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; ++x) {
+                    uint32_t sx = std::min(bx * 4 + x, width - 1);
+                    std::memcpy(&pixels[(y * 4 + x) * 4], &rgba[(static_cast<size_t>(sy) * width + sx) * 4], 4);
+                }
+            }
+
+            uint8_t* out = &outBlocks[(by * blocksX + bx) * blockBytes];
+            switch (format) {
+                case BlockFormat::BC1: encodeBC1(pixels, out); break;
+                case BlockFormat::BC4: encodeBC4(pixels, 0, out); break;
+                case BlockFormat::BC5: encodeBC5(pixels, out); break;
+                case BlockFormat::BC7: encodeBC7(pixels, out); break;
+            }
+        }
+    }, grain);
+}
+
+} // namespace MiEngine
@@ -0,0 +1,488 @@
+#include "texture/MipGenerator.h"
+#include "core/ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MI_MIP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__F16C__) || defined(__AVX2__)
+#define MI_MIP_F16C 1
+#include <immintrin.h>
+#endif
+
+namespace MiEngine {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr uint32_t BAND_ROWS = 32;          // Destination rows per parallel band
+constexpr float KAISER_ALPHA = 4.0f;
+constexpr float WINDOWED_RADIUS = 3.0f;     // Kaiser / Lanczos support in destination texels
+
+// ----------------------------------------------------------------------------
+// One RGBA texel in a vector register
+// ----------------------------------------------------------------------------
+
+#ifdef MI_MIP_SSE2
+using Vec4 = __m128;
+inline Vec4 vzero() { return _mm_setzero_ps(); }
+inline Vec4 vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+inline Vec4 vmadd(Vec4 acc, Vec4 v, float w) { return _mm_add_ps(acc, _mm_mul_ps(v, _mm_set1_ps(w))); }
+#else
+struct Vec4 { float v[4]; };
+inline Vec4 vzero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+inline Vec4 vload(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void vstore(float* p, Vec4 v) { std::memcpy(p, v.v, sizeof(v.v)); }
+inline Vec4 vmadd(Vec4 acc, Vec4 v, float w) {
+    for (int i = 0; i < 4; ++i) {
+        acc.v[i] += v.v[i] * w;
+    }
+    return acc;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Filter kernels
+// ----------------------------------------------------------------------------
+
+float sinc(float x) {
+    if (std::fabs(x) < 1e-6f) {
+        return 1.0f;
+    }
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+// Modified Bessel function of the first kind, order 0
+float besselI0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    float halfX = x * 0.5f;
+    for (int k = 1; k < 32 && term > sum * 1e-8f; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+    }
+    return sum;
+}
+
+float evaluateKernel(MipFilter filter, float t) {
+    float a = std::fabs(t);
+    if (a >= WINDOWED_RADIUS) {
+        return 0.0f;
+    }
+    if (filter == MipFilter::Lanczos) {
+        return sinc(t) * sinc(t / WINDOWED_RADIUS);
+    }
+    float ratio = a / WINDOWED_RADIUS;
+    static const float i0Alpha = besselI0(KAISER_ALPHA);
+    return sinc(t) * besselI0(KAISER_ALPHA * std::sqrt(1.0f - ratio * ratio)) / i0Alpha;
+}
+
+// Per-destination-texel source taps along one axis (polyphase weights)
+struct FilterTaps {
+    std::vector<uint32_t> start;    // dstSize + 1 offsets into index/weight
+    std::vector<uint32_t> index;
+    std::vector<float> weight;
+};
+
+uint32_t resolveTexel(int64_t s, uint32_t size, bool wrap) {
+    int64_t n = static_cast<int64_t>(size);
+    if (wrap) {
+        return static_cast<uint32_t>(((s % n) + n) % n);
+    }
+    return static_cast<uint32_t>(std::clamp<int64_t>(s, 0, n - 1));
+}
+
+FilterTaps buildTaps(uint32_t srcSize, uint32_t dstSize, MipFilter filter, bool wrap) {
+    FilterTaps taps;
+    taps.start.reserve(dstSize + 1);
+    const float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+
+    for (uint32_t d = 0; d < dstSize; ++d) {
+        size_t first = taps.index.size();
+        taps.start.push_back(static_cast<uint32_t>(first));
+
+        if (srcSize == dstSize) {
+            taps.index.push_back(d);
+            taps.weight.push_back(1.0f);
+            continue;
+        }
+
+        if (filter == MipFilter::Box) {
+            // Exact coverage of the destination footprint, so odd sizes stay unbiased
+            float lo = d * scale;
+            float hi = lo + scale;
+            for (int64_t s = static_cast<int64_t>(std::floor(lo)); s < static_cast<int64_t>(std::ceil(hi)); ++s) {
+                float w = std::min(hi, static_cast<float>(s + 1)) - std::max(lo, static_cast<float>(s));
+                if (w > 0.0f) {
+                    taps.index.push_back(resolveTexel(s, srcSize, wrap));
+                    taps.weight.push_back(w);
+                }
+            }
+        } else {
+            float center = (d + 0.5f) * scale;
+            float radius = WINDOWED_RADIUS * scale;
+            int64_t lo = static_cast<int64_t>(std::floor(center - radius));
+            int64_t hi = static_cast<int64_t>(std::ceil(center + radius));
+            for (int64_t s = lo; s <= hi; ++s) {
+                float w = evaluateKernel(filter, (s + 0.5f - center) / scale);
+                if (w != 0.0f) {
+                    taps.index.push_back(resolveTexel(s, srcSize, wrap));
+                    taps.weight.push_back(w);
+                }
+            }
+        }
+
+        float sum = 0.0f;
+        for (size_t i = first; i < taps.weight.size(); ++i) {
+            sum += taps.weight[i];
+        }
+        for (size_t i = first; i < taps.weight.size(); ++i) {
+            taps.weight[i] /= sum;
+        }
+    }
+    taps.start.push_back(static_cast<uint32_t>(taps.index.size()));
+    return taps;
+}
+
+// ----------------------------------------------------------------------------
+// Format conversion (rows <-> linear float RGBA)
+// ----------------------------------------------------------------------------
+
+const std::array<float, 256>& srgbToLinearTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> t{};
+        for (int i = 0; i < 256; ++i) {
+            float c = i / 255.0f;
+            t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Linear value at which the rounded sRGB code steps from i to i + 1
+const std::array<float, 255>& srgbThresholds() {
+    static const std::array<float, 255> table = [] {
+        std::array<float, 255> t{};
+        for (int i = 0; i < 255; ++i) {
+            float c = (i + 0.5f) / 255.0f;
+            t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Coarse table gives the code at the bucket start; the thresholds finish the rounding exactly
+const std::array<uint8_t, 4096>& srgbBucketTable() {
+    static const std::array<uint8_t, 4096> table = [] {
+        const auto& thresholds = srgbThresholds();
+        std::array<uint8_t, 4096> t{};
+        for (int i = 0; i < 4096; ++i) {
+            float value = i / 4095.0f;
+            t[i] = static_cast<uint8_t>(std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin());
+        }
+        return t;
+    }();
+    return table;
+}
+
+uint8_t linearToSrgb(float value, const std::array<uint8_t, 4096>& buckets, const std::array<float, 255>& thresholds) {
+    value = std::clamp(value, 0.0f, 1.0f);
+    uint32_t code = buckets[static_cast<uint32_t>(value * 4095.0f)];
+    while (code < 255 && value >= thresholds[code]) {
+        ++code;
+    }
+    return static_cast<uint8_t>(code);
+}
+
+uint8_t toUnorm8(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+void decodeRow(const uint8_t* src, uint32_t width, MipPixelFormat format, float* out) {
+    switch (format) {
+        case MipPixelFormat::RGBA8:
+            for (uint32_t i = 0; i < width * 4; ++i) {
+                out[i] = src[i] * (1.0f / 255.0f);
+            }
+            break;
+        case MipPixelFormat::RGBA8_SRGB: {
+            const auto& toLinear = srgbToLinearTable();
+            for (uint32_t x = 0; x < width; ++x) {
+                out[x * 4 + 0] = toLinear[src[x * 4 + 0]];
+                out[x * 4 + 1] = toLinear[src[x * 4 + 1]];
+                out[x * 4 + 2] = toLinear[src[x * 4 + 2]];
+                out[x * 4 + 3] = src[x * 4 + 3] * (1.0f / 255.0f);
+            }
+            break;
+        }
+        case MipPixelFormat::RGBA16F: {
+            const uint16_t* halves = reinterpret_cast<const uint16_t*>(src);
+#ifdef MI_MIP_F16C
+            for (uint32_t x = 0; x < width; ++x) {
+                _mm_storeu_ps(&out[x * 4], _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&halves[x * 4]))));
+            }
+#else
+            for (uint32_t i = 0; i < width * 4; ++i) {
+                out[i] = MipGenerator::halfToFloat(halves[i]);
+            }
+#endif
+            break;
+        }
+        case MipPixelFormat::RGBA32F:
+            std::memcpy(out, src, static_cast<size_t>(width) * 4 * sizeof(float));
+            break;
+    }
+}
+
+void encodeRow(float* row, uint32_t width, MipPixelFormat format, bool normalMap, uint8_t* dst) {
+    const bool unorm = format == MipPixelFormat::RGBA8 || format == MipPixelFormat::RGBA8_SRGB;
+
+    for (uint32_t x = 0; x < width; ++x) {
+        float* p = &row[x * 4];
+        if (normalMap) {
+            float n[3];
+            for (int ch = 0; ch < 3; ++ch) {
+                n[ch] = unorm ? p[ch] * 2.0f - 1.0f : p[ch];
+            }
+            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length < 1e-6f) {
+                n[0] = 0.0f; n[1] = 0.0f; n[2] = 1.0f; length = 1.0f;
+            }
+            for (int ch = 0; ch < 3; ++ch) {
+                p[ch] = unorm ? n[ch] / length * 0.5f + 0.5f : n[ch] / length;
+            }
+        } else {
+            for (int ch = 0; ch < 3; ++ch) {
+                p[ch] = std::max(p[ch], 0.0f);
+            }
+        }
+        p[3] = std::max(p[3], 0.0f);
+    }
+
+    switch (format) {
+        case MipPixelFormat::RGBA8:
+            for (uint32_t i = 0; i < width * 4; ++i) {
+                dst[i] = toUnorm8(row[i]);
+            }
+            break;
+        case MipPixelFormat::RGBA8_SRGB: {
+            const auto& buckets = srgbBucketTable();
+            const auto& thresholds = srgbThresholds();
+            for (uint32_t x = 0; x < width; ++x) {
+                dst[x * 4 + 0] = linearToSrgb(row[x * 4 + 0], buckets, thresholds);
+                dst[x * 4 + 1] = linearToSrgb(row[x * 4 + 1], buckets, thresholds);
+                dst[x * 4 + 2] = linearToSrgb(row[x * 4 + 2], buckets, thresholds);
+                dst[x * 4 + 3] = toUnorm8(row[x * 4 + 3]);
+            }
+            break;
+        }
+        case MipPixelFormat::RGBA16F: {
+            uint16_t* halves = reinterpret_cast<uint16_t*>(dst);
+#ifdef MI_MIP_F16C
+            for (uint32_t x = 0; x < width; ++x) {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(&halves[x * 4]),
+                                 _mm_cvtps_ph(_mm_loadu_ps(&row[x * 4]), _MM_FROUND_TO_NEAREST_INT));
+            }
+#else
+            for (uint32_t i = 0; i < width * 4; ++i) {
+                halves[i] = MipGenerator::floatToHalf(row[i]);
+            }
+#endif
+            break;
+        }
+        case MipPixelFormat::RGBA32F:
+            std::memcpy(dst, row, static_cast<size_t>(width) * 4 * sizeof(float));
+            break;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Separable passes
+// ----------------------------------------------------------------------------
+
+void filterHorizontal(const float* src, const FilterTaps& taps, uint32_t dstWidth, float* dst) {
+    for (uint32_t x = 0; x < dstWidth; ++x) {
+        Vec4 acc = vzero();
+        for (uint32_t t = taps.start[x]; t < taps.start[x + 1]; ++t) {
+            acc = vmadd(acc, vload(&src[taps.index[t] * 4]), taps.weight[t]);
+        }
+        vstore(&dst[x * 4], acc);
+    }
+}
+
+void accumulateRow(const float* src, float weight, uint32_t width, float* dst) {
+    for (uint32_t x = 0; x < width; ++x) {
+        vstore(&dst[x * 4], vmadd(vload(&dst[x * 4]), vload(&src[x * 4]), weight));
+    }
+}
+
+} // anonymous namespace
+
+uint32_t MipGenerator::getMipLevelCount(uint32_t width, uint32_t height) {
+    return static_cast<uint32_t>(std::floor(std::log2(std::max({ width, height, 1u })))) + 1;
+}
+
+uint32_t MipGenerator::getBytesPerPixel(MipPixelFormat format) {
+    switch (format) {
+        case MipPixelFormat::RGBA16F: return 8;
+        case MipPixelFormat::RGBA32F: return 16;
+        default: return 4;
+    }
+}
+
+void MipGenerator::downsample(const void* src, uint32_t srcWidth, uint32_t srcHeight,
+                              void* dst, uint32_t dstWidth, uint32_t dstHeight,
+                              MipPixelFormat format, const MipSettings& settings) {
+    if (!src || !dst || srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+        return;
+    }
+
+    const FilterTaps horizontal = buildTaps(srcWidth, dstWidth, settings.filter, settings.wrap);
+    const FilterTaps vertical = buildTaps(srcHeight, dstHeight, settings.filter, settings.wrap);
+    const size_t bytesPerPixel = getBytesPerPixel(format);
+    const uint8_t* srcBytes = static_cast<const uint8_t*>(src);
+    uint8_t* dstBytes = static_cast<uint8_t*>(dst);
+    const uint32_t bandCount = (dstHeight + BAND_ROWS - 1) / BAND_ROWS;
+
+    ThreadPool::getInstance().parallelFor(bandCount, [&](size_t band) {
+        uint32_t y0 = static_cast<uint32_t>(band) * BAND_ROWS;
+        uint32_t y1 = std::min(y0 + BAND_ROWS, dstHeight);
+
+        // Horizontally filter each source row this band touches, once
+        std::vector<int32_t> slot(srcHeight, -1);
+        std::vector<uint32_t> rows;
+        for (uint32_t t = vertical.start[y0]; t < vertical.start[y1]; ++t) {
+            uint32_t row = vertical.index[t];
+            if (slot[row] < 0) {
+                slot[row] = static_cast<int32_t>(rows.size());
+                rows.push_back(row);
+            }
+        }
+
+        std::vector<float> decoded(static_cast<size_t>(srcWidth) * 4);
+        std::vector<float> filtered(rows.size() * dstWidth * 4);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            decodeRow(srcBytes + static_cast<size_t>(rows[i]) * srcWidth * bytesPerPixel, srcWidth, format, decoded.data());
+            filterHorizontal(decoded.data(), horizontal, dstWidth, &filtered[i * dstWidth * 4]);
+        }
+
+        std::vector<float> accum(static_cast<size_t>(dstWidth) * 4);
+        for (uint32_t y = y0; y < y1; ++y) {
+            std::fill(accum.begin(), accum.end(), 0.0f);
+            for (uint32_t t = vertical.start[y]; t < vertical.start[y + 1]; ++t) {
+                accumulateRow(&filtered[static_cast<size_t>(slot[vertical.index[t]]) * dstWidth * 4],
+                              vertical.weight[t], dstWidth, accum.data());
+            }
+            encodeRow(accum.data(), dstWidth, format, settings.normalMap,
+                      dstBytes + static_cast<size_t>(y) * dstWidth * bytesPerPixel);
+        }
+    }, 1);
+}
+
+void MipGenerator::generate(const void* level0, uint32_t width, uint32_t height,
+                            MipPixelFormat format, const MipSettings& settings,
+                            std::vector<std::vector<uint8_t>>& outLevels, uint32_t levelCount) {
+    uint32_t fullCount = getMipLevelCount(width, height);
+    levelCount = levelCount == 0 ? fullCount : std::min(levelCount, fullCount);
+    outLevels.assign(levelCount > 0 ? levelCount - 1 : 0, {});
+
+    const size_t bytesPerPixel = getBytesPerPixel(format);
+    const void* previous = level0;
+    for (uint32_t level = 1; level < levelCount; ++level) {
+        uint32_t srcWidth = std::max(width >> (level - 1), 1u);
+        uint32_t srcHeight = std::max(height >> (level - 1), 1u);
+        uint32_t dstWidth = std::max(width >> level, 1u);
+        uint32_t dstHeight = std::max(height >> level, 1u);
+
+        std::vector<uint8_t>& out = outLevels[level - 1];
+        out.resize(static_cast<size_t>(dstWidth) * dstHeight * bytesPerPixel);
+        downsample(previous, srcWidth, srcHeight, out.data(), dstWidth, dstHeight, format, settings);
+        previous = out.data();
+    }
+}
+
+void MipGenerator::generateCubemap(std::vector<float>& cubeData, uint32_t faceSize, uint32_t levelCount,
+                                   const MipSettings& settings) {
+    levelCount = std::min(levelCount, getMipLevelCount(faceSize, faceSize));
+
+    // Offsets (in floats) of each level; resize once so face pointers stay valid
+    std::vector<size_t> levelOffsets(levelCount);
+    size_t total = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        uint32_t size = std::max(faceSize >> level, 1u);
+        levelOffsets[level] = total;
+        total += static_cast<size_t>(size) * size * 4 * 6;
+    }
+    cubeData.resize(total);
+
+    MipSettings faceSettings = settings;
+    faceSettings.wrap = false;  // Faces are filtered independently; edges clamp
+
+    for (uint32_t level = 1; level < levelCount; ++level) {
+        uint32_t srcSize = std::max(faceSize >> (level - 1), 1u);
+        uint32_t dstSize = std::max(faceSize >> level, 1u);
+        size_t srcFaceFloats = static_cast<size_t>(srcSize) * srcSize * 4;
+        size_t dstFaceFloats = static_cast<size_t>(dstSize) * dstSize * 4;
+
+        ThreadPool::getInstance().parallelFor(6, [&](size_t face) {
+            downsample(&cubeData[levelOffsets[level - 1] + face * srcFaceFloats], srcSize, srcSize,
+                       &cubeData[levelOffsets[level] + face * dstFaceFloats], dstSize, dstSize,
+                       MipPixelFormat::RGBA32F, faceSettings);
+        }, 1);
+    }
+}
+
+float MipGenerator::halfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+
+    if (exponent == 0) {
+        // Zero / subnormal
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    uint32_t bits = exponent == 31
+        ? sign | 0x7F800000u | (mantissa << 13)
+        : sign | ((exponent + 112) << 23) | (mantissa << 13);
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint16_t MipGenerator::floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+    if (magnitude >= 0x7F800000u) {
+        // Inf / NaN
+        return sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x200u : 0u);
+    }
+    if (magnitude >= 0x477FF000u) {
+        // Rounds past 65504
+        return sign | 0x7C00u;
+    }
+    if (magnitude < 0x38800000u) {
+        // Below the smallest normal half: scale into the subnormal range
+        float absolute;
+        std::memcpy(&absolute, &magnitude, sizeof(absolute));
+        return sign | static_cast<uint16_t>(std::lrint(absolute * 16777216.0f));
+    }
+    // Round to nearest even, then rebias the exponent
+    uint32_t rounded = magnitude + 0xFFFu + ((magnitude >> 13) & 1u);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000u) >> 13);
+}
+
+} // namespace MiEngine
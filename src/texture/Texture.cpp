@@ -1,6 +1,11 @@
 ﻿#include "texture/Texture.h"
+#include "asset/TextureCache.h"
+#include "texture/TextureDecoder.h"
+#include "core/ThreadPool.h"
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
+#include <vector>
 
 // Include stb_image for texture loading
 #define STB_IMAGE_IMPLEMENTATION
@@ -37,6 +42,8 @@ bool Texture::loadFromFile(const std::string& filepath, VkCommandPool commandPoo
     
     // Calculate number of mip levels
     mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
+    width = static_cast<uint32_t>(texWidth);
+    height = static_cast<uint32_t>(texHeight);
     
     // Create the texture from the loaded pixels
     createTextureImage(pixels, texWidth, texHeight, 4, commandPool, graphicsQueue);
@@ -51,6 +58,367 @@ bool Texture::loadFromFile(const std::string& filepath, VkCommandPool commandPoo
     return true;
 }
 
+bool Texture::loadFromKtx2(const std::string& filepath, VkCommandPool commandPool, VkQueue graphicsQueue) {
+    MiEngine::BakedTexture baked;
+    if (!MiEngine::TextureCache::load(filepath, baked)) {
+        return false;
+    }
+
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, baked.format, &formatProperties);
+    if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+        std::cerr << "Texture format " << baked.format << " not supported by device: " << filepath << std::endl;
+        return false;
+    }
+
+    imageFormat = baked.format;
+    width = baked.width;
+    height = baked.height;
+    mipLevels = static_cast<uint32_t>(baked.levels.size());
+
+    // One staging buffer holding every level, 16-byte aligned for block copies
+    std::vector<VkDeviceSize> levelOffsets(mipLevels);
+    VkDeviceSize stagingSize = 0;
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        levelOffsets[level] = stagingSize;
+        stagingSize = (stagingSize + baked.levels[level].size + 15) & ~VkDeviceSize(15);
+    }
+
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = stagingSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &stagingBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create staging buffer for texture!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, stagingBuffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &stagingBufferMemory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate staging buffer memory for texture!");
+    }
+    vkBindBufferMemory(device, stagingBuffer, stagingBufferMemory, 0);
+
+    // Copy straight from the mapped file
+    void* data;
+    vkMapMemory(device, stagingBufferMemory, 0, stagingSize, 0, &data);
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        memcpy(static_cast<uint8_t*>(data) + levelOffsets[level], baked.levels[level].data, baked.levels[level].size);
+    }
+    vkUnmapMemory(device, stagingBufferMemory);
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent.width = width;
+    imageInfo.extent.height = height;
+    imageInfo.extent.depth = 1;
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = imageFormat;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+    if (vkCreateImage(device, &imageInfo, nullptr, &textureImage) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture image!");
+    }
+
+    vkGetImageMemoryRequirements(device, textureImage, &memRequirements);
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &textureImageMemory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate texture image memory!");
+    }
+    vkBindImageMemory(device, textureImage, textureImageMemory, 0);
+
+    // Transition, copy all levels and transition again in a single command buffer
+    VkCommandBuffer commandBuffer = beginSingleTimeCommands(commandPool);
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = textureImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &barrier);
+
+    std::vector<VkBufferImageCopy> regions(mipLevels);
+    for (uint32_t level = 0; level < mipLevels; ++level) {
+        VkBufferImageCopy& region = regions[level];
+        region = {};
+        region.bufferOffset = levelOffsets[level];
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { baked.levels[level].width, baked.levels[level].height, 1 };
+    }
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, textureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &barrier);
+
+    endSingleTimeCommands(commandBuffer, commandPool, graphicsQueue);
+
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingBufferMemory, nullptr);
+
+    imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    createTextureImageView();
+    createTextureSampler();
+    return true;
+}
+
+std::vector<std::shared_ptr<Texture>> Texture::uploadBatch(VkDevice device, VkPhysicalDevice physicalDevice,
+                                                           VkCommandPool commandPool, VkQueue graphicsQueue,
+                                                           const std::vector<std::shared_ptr<MiEngine::DecodedTexture>>& decoded) {
+    std::vector<std::shared_ptr<Texture>> textures(decoded.size());
+
+    // Where each level lands in the shared staging buffer
+    struct StagedLevel {
+        size_t texture;
+        uint32_t level;
+        VkDeviceSize offset;
+    };
+    std::vector<StagedLevel> stagedLevels;
+    VkDeviceSize stagingSize = 0;
+
+    for (size_t i = 0; i < decoded.size(); ++i) {
+        const auto& source = decoded[i];
+        if (!source || source->levels.empty()) {
+            continue;
+        }
+
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, source->format, &formatProperties);
+        if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+            std::cerr << "Texture format " << source->format << " not supported by device: " << source->path << std::endl;
+            continue;
+        }
+
+        auto texture = std::make_shared<Texture>(device, physicalDevice);
+        texture->imageFormat = source->format;
+        texture->width = source->width;
+        texture->height = source->height;
+        texture->mipLevels = source->mipLevels;
+
+        // Missing levels are blitted on the GPU, which needs linear filtering
+        if (source->levels.size() < source->mipLevels &&
+            !(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
+            texture->mipLevels = static_cast<uint32_t>(source->levels.size());
+        }
+
+        for (uint32_t level = 0; level < source->levels.size() && level < texture->mipLevels; ++level) {
+            stagedLevels.push_back({ i, level, stagingSize });
+            stagingSize = (stagingSize + source->levels[level].size + 15) & ~VkDeviceSize(15);
+        }
+        textures[i] = texture;
+    }
+
+    if (stagedLevels.empty()) {
+        return textures;
+    }
+
+    // Any texture can allocate; they share the device
+    Texture& allocator = *textures[stagedLevels.front().texture];
+
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = stagingSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &stagingBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create staging buffer for texture batch!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, stagingBuffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = allocator.findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &stagingBufferMemory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate staging buffer memory for texture batch!");
+    }
+    vkBindBufferMemory(device, stagingBuffer, stagingBufferMemory, 0);
+
+    // Fill the staging buffer from the pool; the copies are independent
+    void* data;
+    vkMapMemory(device, stagingBufferMemory, 0, stagingSize, 0, &data);
+    MiEngine::ThreadPool::getInstance().parallelFor(stagedLevels.size(), [&](size_t i) {
+        const StagedLevel& staged = stagedLevels[i];
+        const auto& level = decoded[staged.texture]->levels[staged.level];
+        memcpy(static_cast<uint8_t*>(data) + staged.offset, level.data, level.size);
+    });
+    vkUnmapMemory(device, stagingBufferMemory);
+
+    for (auto& texture : textures) {
+        if (!texture) {
+            continue;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = texture->width;
+        imageInfo.extent.height = texture->height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = texture->mipLevels;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = texture->imageFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+        if (vkCreateImage(device, &imageInfo, nullptr, &texture->textureImage) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create texture image!");
+        }
+
+        vkGetImageMemoryRequirements(device, texture->textureImage, &memRequirements);
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = texture->findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &texture->textureImageMemory) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate texture image memory!");
+        }
+        vkBindImageMemory(device, texture->textureImage, texture->textureImageMemory, 0);
+    }
+
+    // Every transition, copy and mip blit of the batch goes into one command buffer
+    VkCommandBuffer commandBuffer = allocator.beginSingleTimeCommands(commandPool);
+
+    std::vector<VkImageMemoryBarrier> barriers;
+    for (auto& texture : textures) {
+        if (!texture) {
+            continue;
+        }
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = texture->textureImage;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, texture->mipLevels, 0, 1 };
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barriers.push_back(barrier);
+    }
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    for (size_t begin = 0; begin < stagedLevels.size();) {
+        size_t index = stagedLevels[begin].texture;
+        std::vector<VkBufferImageCopy> regions;
+        for (; begin < stagedLevels.size() && stagedLevels[begin].texture == index; ++begin) {
+            const auto& level = decoded[index]->levels[stagedLevels[begin].level];
+            VkBufferImageCopy region{};
+            region.bufferOffset = stagedLevels[begin].offset;
+            region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, stagedLevels[begin].level, 0, 1 };
+            region.imageExtent = { level.width, level.height, 1 };
+            regions.push_back(region);
+        }
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, textures[index]->textureImage,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    barriers.clear();
+    for (size_t i = 0; i < textures.size(); ++i) {
+        auto& texture = textures[i];
+        if (!texture) {
+            continue;
+        }
+        if (decoded[i]->levels.size() < texture->mipLevels) {
+            // Leaves every level in SHADER_READ_ONLY_OPTIMAL
+            texture->recordMipmapBlits(commandBuffer, texture->textureImage, texture->width, texture->height,
+                                       texture->mipLevels);
+            continue;
+        }
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = texture->textureImage;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, texture->mipLevels, 0, 1 };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barriers.push_back(barrier);
+    }
+    if (!barriers.empty()) {
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                             0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+    }
+
+    allocator.endSingleTimeCommands(commandBuffer, commandPool, graphicsQueue);
+
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingBufferMemory, nullptr);
+
+    for (auto& texture : textures) {
+        if (texture) {
+            texture->imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            texture->createTextureImageView();
+            texture->createTextureSampler();
+        }
+    }
+    return textures;
+}
+
+void Texture::swapContents(Texture& other) {
+    std::swap(textureImage, other.textureImage);
+    std::swap(textureImageMemory, other.textureImageMemory);
+    std::swap(textureImageView, other.textureImageView);
+    std::swap(textureSampler, other.textureSampler);
+    std::swap(imageLayout, other.imageLayout);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+    std::swap(mipLevels, other.mipLevels);
+    std::swap(imageFormat, other.imageFormat);
+}
+
 bool Texture::createFromPixels(const unsigned char* pixels, uint32_t width, uint32_t height, 
                              uint32_t channels, VkCommandPool commandPool, VkQueue graphicsQueue) {
     // Calculate number of mip levels
@@ -215,6 +583,12 @@ void Texture::createTextureImageView() {
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
     
+    // Single-channel BC4 bakes keep the grayscale semantics of the RGBA8 path
+    if (imageFormat == VK_FORMAT_BC4_UNORM_BLOCK) {
+        viewInfo.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_R,
+                                VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_ONE };
+    }
+    
     if (vkCreateImageView(device, &viewInfo, nullptr, &textureImageView) != VK_SUCCESS) {
         throw std::runtime_error("failed to create texture image view!");
     }
@@ -348,7 +722,12 @@ void Texture::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWi
     }
     
     VkCommandBuffer commandBuffer = beginSingleTimeCommands(commandPool);
-    
+    recordMipmapBlits(commandBuffer, image, texWidth, texHeight, mipLevels);
+    endSingleTimeCommands(commandBuffer, commandPool, graphicsQueue);
+}
+
+void Texture::recordMipmapBlits(VkCommandBuffer commandBuffer, VkImage image, int32_t texWidth, int32_t texHeight,
+                                uint32_t mipLevels) {
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.image = image;
@@ -421,8 +800,17 @@ void Texture::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWi
         0, nullptr,
         0, nullptr,
         1, &barrier);
-        
-    endSingleTimeCommands(commandBuffer, commandPool, graphicsQueue);
+}
+
+uint32_t Texture::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    throw std::runtime_error("failed to find suitable memory type for texture!");
 }
 
 VkCommandBuffer Texture::beginSingleTimeCommands(VkCommandPool commandPool) {
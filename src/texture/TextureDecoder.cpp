@@ -0,0 +1,88 @@
+#include "texture/TextureDecoder.h"
+#include "core/ThreadPool.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <unordered_set>
+
+namespace MiEngine {
+
+namespace {
+
+// Bakes queued by this process; a second request for the same file must not race the first
+std::mutex g_bakeMutex;
+std::unordered_set<std::string> g_bakesInFlight;
+
+void queueBake(const std::shared_ptr<DecodedTexture>& decoded, const fs::path& cachePath, TextureType type) {
+    {
+        std::lock_guard<std::mutex> lock(g_bakeMutex);
+        if (!g_bakesInFlight.insert(cachePath.string()).second) {
+            return;
+        }
+    }
+
+    // The task holds the decoded pixels until the bake is written
+    ThreadPool::getInstance().submit([decoded, cachePath, type]() {
+        TextureCache::bakePixels(decoded->pixels.get(), decoded->width, decoded->height,
+                                 cachePath, decoded->path, type);
+        std::lock_guard<std::mutex> lock(g_bakeMutex);
+        g_bakesInFlight.erase(cachePath.string());
+    });
+}
+
+} // anonymous namespace
+
+std::shared_ptr<DecodedTexture> TextureDecoder::decode(const std::string& path, TextureType type, bool bakeOnMiss) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto decoded = std::make_shared<DecodedTexture>();
+    decoded->path = path;
+
+    // Prefer the baked, block-compressed mip chain
+    fs::path bakedPath = TextureCache::getCachePath(path, TextureCache::getDefaultCacheDir(), type);
+    if (TextureCache::isValid(bakedPath, path, type) && TextureCache::load(bakedPath, decoded->baked)) {
+        decoded->format = decoded->baked.format;
+        decoded->width = decoded->baked.width;
+        decoded->height = decoded->baked.height;
+        decoded->mipLevels = static_cast<uint32_t>(decoded->baked.levels.size());
+        for (const auto& level : decoded->baked.levels) {
+            decoded->levels.push_back({ level.data, level.size, level.width, level.height });
+        }
+    } else {
+        int width, height, channels;
+        stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (!pixels) {
+            std::cerr << "TextureDecoder: Failed to load texture image: " << path << std::endl;
+            return nullptr;
+        }
+
+        decoded->pixels = std::shared_ptr<uint8_t>(pixels, [](uint8_t* p) { stbi_image_free(p); });
+        // Same color space the bake will use, so a map looks the same before and after baking
+        decoded->format = TextureCache::isSrgb(type) ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+        decoded->width = static_cast<uint32_t>(width);
+        decoded->height = static_cast<uint32_t>(height);
+        decoded->mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+        decoded->levels.push_back({ pixels, static_cast<size_t>(width) * height * 4,
+                                    decoded->width, decoded->height });
+
+        // Bake in the background so the next run skips decoding and mip generation
+        if (bakeOnMiss) {
+            queueBake(decoded, bakedPath, type);
+        }
+    }
+
+    decoded->decodeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    return decoded;
+}
+
+std::shared_future<std::shared_ptr<DecodedTexture>> TextureDecoder::decodeAsync(const std::string& path, TextureType type,
+                                                                                bool bakeOnMiss) {
+    return ThreadPool::getInstance().submit([path, type, bakeOnMiss]() {
+        return decode(path, type, bakeOnMiss);
+    }).share();
+}
+
+} // namespace MiEngine
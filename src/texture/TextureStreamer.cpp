@@ -0,0 +1,304 @@
+#include "texture/TextureStreamer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MiEngine {
+
+TextureStreamer::TextureStreamer(TextureStreamingBackend& backend, const TextureStreamingSettings& settings)
+    : m_Backend(backend), m_Settings(settings) {
+}
+
+uint32_t TextureStreamer::registerTexture(uint32_t width, uint32_t height, const std::vector<uint64_t>& mipBytes,
+                                          uint32_t residentMip) {
+    if (mipBytes.empty()) {
+        return INVALID_ID;
+    }
+
+    uint32_t id;
+    if (!m_FreeIds.empty()) {
+        id = m_FreeIds.back();
+        m_FreeIds.pop_back();
+    } else {
+        id = static_cast<uint32_t>(m_Entries.size());
+        m_Entries.emplace_back();
+        m_ChangeIndex.push_back(INVALID_ID);
+    }
+
+    Entry& entry = m_Entries[id];
+    entry = Entry();
+    entry.alive = true;
+    entry.width = width;
+    entry.height = height;
+    entry.mipCount = static_cast<uint32_t>(mipBytes.size());
+    entry.tailMip = getTailMip(width, height, entry.mipCount);
+    entry.residentMip = std::min(residentMip, entry.mipCount - 1);
+    entry.wantedMip = entry.residentMip;
+    entry.lastUsedFrame = m_Frame;
+
+    entry.bytesFrom.assign(entry.mipCount + 1, 0);
+    for (uint32_t mip = entry.mipCount; mip-- > 0;) {
+        entry.bytesFrom[mip] = entry.bytesFrom[mip + 1] + mipBytes[mip];
+    }
+
+    m_ResidentBytes += bytesFrom(entry, entry.residentMip);
+    m_Stats.textureCount++;
+    return id;
+}
+
+void TextureStreamer::unregisterTexture(uint32_t id) {
+    if (id >= m_Entries.size() || !m_Entries[id].alive) {
+        return;
+    }
+    Entry& entry = m_Entries[id];
+    m_ResidentBytes -= bytesFrom(entry, entry.residentMip);
+    entry = Entry();
+    m_FreeIds.push_back(id);
+    m_Stats.textureCount--;
+}
+
+uint32_t TextureStreamer::getTailMip(uint32_t width, uint32_t height, uint32_t mipCount) const {
+    uint32_t mip = 0;
+    while (mip + 1 < mipCount && std::max(std::max(width >> mip, height >> mip), 1u) > m_Settings.tailSize) {
+        ++mip;
+    }
+    return mip;
+}
+
+float TextureStreamer::computeScreenSize(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& model,
+                                         const glm::mat4& view, const glm::mat4& proj, float viewportHeight) {
+    // Bounding sphere of the transformed box
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    float scale = std::max(std::max(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1]))),
+                           glm::length(glm::vec3(model[2])));
+    float radius = glm::length((boundsMax - boundsMin) * 0.5f) * scale;
+
+    glm::vec4 viewCenter = view * model * glm::vec4(center, 1.0f);
+    float depth = -viewCenter.z;
+    if (depth + radius <= 0.0f) {
+        return 0.0f;
+    }
+
+    // Inside or touching the sphere counts as filling the screen
+    depth = std::max(depth, radius);
+    if (depth <= 0.0f) {
+        return 0.0f;
+    }
+    return radius * std::abs(proj[1][1]) * viewportHeight / depth;
+}
+
+uint32_t TextureStreamer::computeRequiredMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenSize) const {
+    if (mipCount == 0) {
+        return 0;
+    }
+    if (screenSize <= 0.0f) {
+        return mipCount - 1;
+    }
+    float texels = static_cast<float>(std::max(width, height));
+    float mip = std::floor(std::log2(texels / screenSize) + m_Settings.mipBias);
+    return static_cast<uint32_t>(std::clamp(mip, 0.0f, static_cast<float>(mipCount - 1)));
+}
+
+void TextureStreamer::requestMip(uint32_t id, uint32_t mip) {
+    if (id >= m_Entries.size() || !m_Entries[id].alive) {
+        return;
+    }
+    Entry& entry = m_Entries[id];
+    entry.requestedMip = std::min(entry.requestedMip, std::min(mip, entry.mipCount - 1));
+}
+
+void TextureStreamer::requestScreenSize(uint32_t id, float screenSize) {
+    if (id >= m_Entries.size() || !m_Entries[id].alive) {
+        return;
+    }
+    const Entry& entry = m_Entries[id];
+    requestMip(id, computeRequiredMip(entry.width, entry.height, entry.mipCount, screenSize));
+}
+
+uint32_t TextureStreamer::evictionFloor(const Entry& entry, bool inUse) const {
+    // Textures in use keep what they need; the rest fall back to their tail
+    return entry.lastUsedFrame == m_Frame && !inUse ? entry.wantedMip : entry.tailMip;
+}
+
+uint64_t TextureStreamer::getEvictableBytes() const {
+    uint64_t bytes = 0;
+    for (const Entry& entry : m_Entries) {
+        if (entry.alive) {
+            uint32_t floor = evictionFloor(entry, false);
+            if (entry.residentMip < floor) {
+                bytes += bytesFrom(entry, entry.residentMip) - bytesFrom(entry, floor);
+            }
+        }
+    }
+    return bytes;
+}
+
+uint64_t TextureStreamer::evict(uint64_t needed, bool inUse) {
+    std::vector<uint32_t> victims;
+    for (uint32_t id = 0; id < m_Entries.size(); ++id) {
+        const Entry& entry = m_Entries[id];
+        if (entry.alive && entry.residentMip < evictionFloor(entry, inUse)) {
+            victims.push_back(id);
+        }
+    }
+
+    // Least recently used first; among equals, the one holding the most memory
+    std::sort(victims.begin(), victims.end(), [this](uint32_t a, uint32_t b) {
+        const Entry& ea = m_Entries[a];
+        const Entry& eb = m_Entries[b];
+        if (ea.lastUsedFrame != eb.lastUsedFrame) {
+            return ea.lastUsedFrame < eb.lastUsedFrame;
+        }
+        uint64_t sizeA = bytesFrom(ea, ea.residentMip);
+        uint64_t sizeB = bytesFrom(eb, eb.residentMip);
+        return sizeA != sizeB ? sizeA > sizeB : a < b;
+    });
+
+    uint64_t freed = 0;
+    for (uint32_t id : victims) {
+        if (freed >= needed) {
+            break;
+        }
+
+        // Drop only as many top mips as needed
+        const Entry& entry = m_Entries[id];
+        uint32_t floor = evictionFloor(entry, inUse);
+        uint32_t mip = entry.residentMip;
+        uint64_t before = bytesFrom(entry, mip);
+        while (mip < floor && freed + before - bytesFrom(entry, mip) < needed) {
+            ++mip;
+        }
+        freed += before - bytesFrom(entry, mip);
+        setResident(id, mip);
+        m_Stats.evictions++;
+    }
+    return freed;
+}
+
+void TextureStreamer::setResident(uint32_t id, uint32_t mip) {
+    Entry& entry = m_Entries[id];
+    if (m_ChangeIndex[id] == INVALID_ID) {
+        m_ChangeIndex[id] = static_cast<uint32_t>(m_Changes.size());
+        m_Changes.push_back({ id, entry.residentMip, mip, true });
+    } else {
+        m_Changes[m_ChangeIndex[id]].toMip = mip;
+    }
+
+    m_ResidentBytes = m_ResidentBytes - bytesFrom(entry, entry.residentMip) + bytesFrom(entry, mip);
+    entry.residentMip = mip;
+    m_Stats.uploadedBytes += bytesFrom(entry, mip);
+}
+
+const std::vector<TextureResidencyChange>& TextureStreamer::update() {
+    ++m_Frame;
+    for (const auto& change : m_Changes) {
+        m_ChangeIndex[change.textureId] = INVALID_ID;
+    }
+    m_Changes.clear();
+
+    uint32_t textureCount = m_Stats.textureCount;
+    m_Stats = TextureStreamingStats();
+    m_Stats.textureCount = textureCount;
+
+    // Fold this frame's requests in and collect textures that need more mips
+    std::vector<uint32_t> upgrades;
+    for (uint32_t id = 0; id < m_Entries.size(); ++id) {
+        Entry& entry = m_Entries[id];
+        if (!entry.alive) {
+            continue;
+        }
+        if (entry.requestedMip != INVALID_ID) {
+            entry.wantedMip = std::min(entry.requestedMip, entry.tailMip);
+            entry.requestedMip = INVALID_ID;
+            entry.lastUsedFrame = m_Frame;
+        }
+
+        bool used = entry.lastUsedFrame == m_Frame;
+        m_Stats.requiredBytes += bytesFrom(entry, used ? entry.wantedMip : entry.tailMip);
+        if (used && entry.wantedMip < entry.residentMip) {
+            upgrades.push_back(id);
+        }
+    }
+
+    // Most blurred first
+    std::sort(upgrades.begin(), upgrades.end(), [this](uint32_t a, uint32_t b) {
+        uint32_t missingA = m_Entries[a].residentMip - m_Entries[a].wantedMip;
+        uint32_t missingB = m_Entries[b].residentMip - m_Entries[b].wantedMip;
+        return missingA != missingB ? missingA > missingB : a < b;
+    });
+
+    uint64_t evictable = getEvictableBytes();
+    uint64_t upgradeBytes = 0;
+    for (uint32_t id : upgrades) {
+        const Entry& entry = m_Entries[id];
+        uint64_t residentSize = bytesFrom(entry, entry.residentMip);
+
+        // Sharpest level that fits the budget (after evicting) and the upload limit
+        uint32_t target = entry.residentMip;
+        for (uint32_t mip = entry.wantedMip; mip < entry.residentMip; ++mip) {
+            uint64_t growth = bytesFrom(entry, mip) - residentSize;
+            bool fitsBudget = m_ResidentBytes + growth <= m_Settings.budgetBytes + evictable;
+            bool fitsUpload = upgradeBytes == 0 ||
+                              upgradeBytes + bytesFrom(entry, mip) <= m_Settings.maxUploadBytesPerUpdate;
+            if (fitsBudget && fitsUpload) {
+                target = mip;
+                break;
+            }
+        }
+
+        if (target != entry.wantedMip) {
+            m_Stats.deferred++;
+        }
+        if (target == entry.residentMip) {
+            continue;
+        }
+
+        uint64_t growth = bytesFrom(entry, target) - residentSize;
+        if (m_ResidentBytes + growth > m_Settings.budgetBytes) {
+            evictable -= evict(m_ResidentBytes + growth - m_Settings.budgetBytes);
+        }
+        upgradeBytes += bytesFrom(entry, target);
+        setResident(id, target);
+        m_Stats.uploads++;
+    }
+
+    // The budget may have shrunk; if visible textures alone exceed it, they give up mips too
+    if (m_ResidentBytes > m_Settings.budgetBytes) {
+        evict(m_ResidentBytes - m_Settings.budgetBytes);
+    }
+    if (m_ResidentBytes > m_Settings.budgetBytes) {
+        evict(m_ResidentBytes - m_Settings.budgetBytes, true);
+    }
+
+    if (!m_Changes.empty()) {
+        m_Backend.applyResidency(m_Changes);
+
+        // Roll back what the backend couldn't do
+        for (const auto& change : m_Changes) {
+            if (!change.applied) {
+                Entry& entry = m_Entries[change.textureId];
+                m_ResidentBytes = m_ResidentBytes - bytesFrom(entry, change.toMip) + bytesFrom(entry, change.fromMip);
+                entry.residentMip = change.fromMip;
+                m_ChangeIndex[change.textureId] = INVALID_ID;
+            }
+        }
+        m_Changes.erase(std::remove_if(m_Changes.begin(), m_Changes.end(),
+                                       [](const TextureResidencyChange& change) { return !change.applied; }),
+                        m_Changes.end());
+        for (uint32_t i = 0; i < m_Changes.size(); ++i) {
+            m_ChangeIndex[m_Changes[i].textureId] = i;
+        }
+    }
+
+    m_Stats.residentBytes = m_ResidentBytes;
+    return m_Changes;
+}
+
+uint32_t TextureStreamer::getResidentMip(uint32_t id) const {
+    return id < m_Entries.size() && m_Entries[id].alive ? m_Entries[id].residentMip : INVALID_ID;
+}
+
+uint32_t TextureStreamer::getWantedMip(uint32_t id) const {
+    return id < m_Entries.size() && m_Entries[id].alive ? m_Entries[id].wantedMip : INVALID_ID;
+}
+
+} // namespace MiEngine
@@ -0,0 +1,73 @@
+#include "texture/TextureStreamingUploader.h"
+#include "texture/Texture.h"
+#include "texture/TextureDecoder.h"
+#include <algorithm>
+#include <iostream>
+
+namespace MiEngine {
+
+TextureStreamingUploader::TextureStreamingUploader(VkDevice device, VkPhysicalDevice physicalDevice,
+                                                   VkCommandPool commandPool, VkQueue graphicsQueue)
+    : m_Device(device), m_PhysicalDevice(physicalDevice), m_CommandPool(commandPool), m_GraphicsQueue(graphicsQueue) {
+}
+
+void TextureStreamingUploader::addTexture(uint32_t id, const std::shared_ptr<Texture>& texture,
+                                          const std::shared_ptr<DecodedTexture>& source) {
+    m_Textures[id] = { texture, source };
+}
+
+void TextureStreamingUploader::removeTexture(uint32_t id) {
+    m_Textures.erase(id);
+}
+
+std::shared_ptr<Texture> TextureStreamingUploader::getTexture(uint32_t id) const {
+    auto it = m_Textures.find(id);
+    return it != m_Textures.end() ? it->second.texture : nullptr;
+}
+
+std::shared_ptr<DecodedTexture> TextureStreamingUploader::selectMips(const DecodedTexture& source, uint32_t firstMip) {
+    auto selected = std::make_shared<DecodedTexture>();
+    selected->path = source.path;
+    selected->format = source.format;
+    firstMip = std::min(firstMip, static_cast<uint32_t>(source.levels.size()) - 1);
+    selected->levels.assign(source.levels.begin() + firstMip, source.levels.end());
+    selected->width = selected->levels.front().width;
+    selected->height = selected->levels.front().height;
+    selected->mipLevels = static_cast<uint32_t>(selected->levels.size());
+    return selected;
+}
+
+void TextureStreamingUploader::applyResidency(std::vector<TextureResidencyChange>& changes) {
+    std::vector<std::shared_ptr<DecodedTexture>> uploads;
+    std::vector<size_t> uploadChanges;
+    for (size_t i = 0; i < changes.size(); ++i) {
+        auto it = m_Textures.find(changes[i].textureId);
+        if (it == m_Textures.end()) {
+            changes[i].applied = false;
+            continue;
+        }
+        uploads.push_back(selectMips(*it->second.source, changes[i].toMip));
+        uploadChanges.push_back(i);
+    }
+    if (uploads.empty()) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<Texture>> images =
+        Texture::uploadBatch(m_Device, m_PhysicalDevice, m_CommandPool, m_GraphicsQueue, uploads);
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        TextureResidencyChange& change = changes[uploadChanges[i]];
+        if (!images[i]) {
+            std::cerr << "TextureStreamingUploader: Failed to stream " << uploads[i]->path << std::endl;
+            change.applied = false;
+            continue;
+        }
+
+        // uploadBatch waited for the queue, so no frame still samples the old image;
+        // it is released with images[i]
+        m_Textures[change.textureId].texture->swapContents(*images[i]);
+    }
+}
+
+} // namespace MiEngine